@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "ECS/Entity.h"
+#include "System/Types.h"
+
+/// @file Archetype.h
+/// @brief Defines the #lov::ECS::Archetype table storing every entity with the same set of components
+
+namespace lov {
+    namespace ECS {
+        /// @brief A fixed size block of an archetype's entities, holding one column per component
+        struct Chunk {
+            std::unique_ptr<std::byte[]> data;  ///< The columns, each an array of one component for every row
+            lov_uint count;                     ///< Rows in use
+        };
+
+        /// @brief A table of the entities that have exactly the same components
+        ///
+        /// Rows live in 16KB chunks. Each chunk starts with a column of entities, then one column per component, so a
+        /// system reading a few components streams through only those columns. Rows are kept dense by moving the
+        /// archetype's last row into any row that's freed, and chunks left empty are released.
+        class Archetype {
+        public:
+            /// @brief Size of each chunk in bytes
+            static constexpr size_t ChunkSize = 16 * 1024;
+
+            /// @brief Lay out the columns of an archetype
+            /// @param mask Its components
+            /// @throws #lov::Exceptions::EntityException if not even one row of the components fits in a chunk
+            explicit Archetype(ComponentMask mask);
+
+            Archetype(const Archetype&) = delete;
+            Archetype& operator=(const Archetype&) = delete;
+
+            /// @brief Get the components of this archetype
+            /// @return Their mask
+            ComponentMask getMask() const;
+
+            /// @brief Get the rows each chunk holds
+            /// @return The row count
+            lov_uint getChunkCapacity() const;
+
+            /// @brief Get the chunks of this archetype
+            /// @return The chunks, every one full except perhaps the last
+            std::span<const Chunk> getChunks() const;
+
+            /// @brief Get the number of entities in this archetype
+            /// @return The entity count
+            lov_uint getEntityCount() const;
+
+            /// @brief Get a component's column in a chunk
+            /// @param chunk The chunk
+            /// @param component The component's ID, which must be part of this archetype
+            /// @return The start of the column
+            std::byte* getColumn(const Chunk& chunk, lov_uint component) const;
+
+            /// @brief Get the column of entities in a chunk
+            /// @param chunk The chunk
+            /// @return The entities of its rows
+            Entity* getEntities(const Chunk& chunk) const;
+
+            /// @brief Get a component of a row
+            /// @param chunk Index of the row's chunk
+            /// @param row The row
+            /// @param component The component's ID, which must be part of this archetype
+            /// @return The component
+            std::byte* getComponent(lov_uint chunk, lov_uint row, lov_uint component) const;
+
+            /// @brief Add a row at the end, leaving its components uninitialized
+            /// @param entity The entity in the row
+            /// @param chunk Set to the index of the row's chunk
+            /// @param row Set to the row within the chunk
+            void allocate(Entity entity, lov_uint& chunk, lov_uint& row);
+
+            /// @brief Free a row by moving the last row into it
+            /// @param chunk Index of the row's chunk
+            /// @param row The row
+            /// @return The entity moved into the row, or the removed entity if it was the last row
+            Entity free(lov_uint chunk, lov_uint row);
+
+            /// @brief Get the archetype reached by adding a component, if it's been looked up before
+            /// @param component The component's ID
+            /// @return The archetype, or null
+            Archetype* getAddEdge(lov_uint component) const;
+
+            /// @brief Get the archetype reached by removing a component, if it's been looked up before
+            /// @param component The component's ID
+            /// @return The archetype, or null
+            Archetype* getRemoveEdge(lov_uint component) const;
+
+            /// @brief Remember the archetypes reached by adding or removing a component
+            /// @param component The component's ID
+            /// @param archetype The archetype with the component added or removed
+            /// @param adding Whether it's the archetype with the component added
+            void setEdge(lov_uint component, Archetype* archetype, bool adding);
+
+        private:
+            ComponentMask m_mask;                                       ///< Components of this archetype
+            lov_uint m_capacity;                                        ///< Rows per chunk
+            std::array<size_t, MaxComponentTypes> m_offsets;            ///< Offset of each component's column in a chunk
+            std::vector<Chunk> m_chunks;                                ///< The chunks, every one full except the last
+            std::array<Archetype*, MaxComponentTypes> m_addEdges;       ///< Archetypes found by adding each component
+            std::array<Archetype*, MaxComponentTypes> m_removeEdges;    ///< Archetypes found by removing each component
+        };
+    }
+}
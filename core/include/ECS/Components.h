@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/SceneGraph.h"
+#include "Graphics/Transform.h"
+#include "System/Types.h"
+
+/// @file Components.h
+/// @brief Defines the components the engine's own systems in ECS/Systems.h read and write
+
+namespace lov {
+    namespace ECS {
+        /// @brief An entity's position, rotation and scale
+        struct LocalTransform {
+            Graphics::NodeTransform value;  ///< The transform, applied as scale, then rotation, then translation
+        };
+
+        /// @brief An entity's #lov::ECS::LocalTransform as of the previous simulation step, written by
+        /// #lov::ECS::storePreviousTransforms, so its world transform can be interpolated between steps
+        struct PreviousTransform {
+            Graphics::NodeTransform value;  ///< The transform before the latest step
+        };
+
+        /// @brief An entity's model matrix, written by #lov::ECS::updateTransforms
+        struct WorldTransform {
+            Graphics::Transform value;      ///< The matrix
+        };
+
+        /// @brief The bounds of an entity's mesh, in model space
+        struct RenderBounds {
+            Graphics::BoundingBox local;    ///< The bounds before the world transform
+        };
+
+        /// @brief Whether an entity passed culling, written by #lov::ECS::cullEntities
+        struct Visible {
+            bool value;                     ///< Whether it's in the frustum
+        };
+
+        /// @brief What to draw an entity with, by GL name like #lov::Graphics::CommandBuffer records
+        struct RenderMesh {
+            lov_uint program;               ///< Shader program
+            lov_uint vertexArray;           ///< Vertex array, with its element buffer bound
+            lov_size indexCount;            ///< Indices to draw
+            lov_uint firstIndex;            ///< First index to draw
+        };
+    }
+}
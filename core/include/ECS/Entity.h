@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "System/Types.h"
+
+/// @file Entity.h
+/// @brief Defines the #lov::ECS::Entity handle and the registry that gives each component type its ID
+
+namespace lov {
+    namespace ECS {
+        /// @brief A handle to an entity of a #lov::ECS::World
+        ///
+        /// Indices are reused once entities are destroyed, so each reuse bumps the generation, and handles to the
+        /// destroyed entity stop being alive rather than referring to whatever took its place.
+        struct Entity {
+            lov_uint index;         ///< Index of the entity's record in its World
+            lov_uint generation;    ///< How many times the index had been reused when the entity was created
+
+            /// @brief Do both handles refer to the same entity?
+            /// @param other The other handle
+            /// @return Whether they're equal
+            bool operator==(const Entity& other) const = default;
+        };
+
+        /// @brief A set of component types, one bit per component ID
+        using ComponentMask = uint64_t;
+
+        /// @brief The most component types that can be registered, one per bit of a #ComponentMask
+        constexpr lov_uint MaxComponentTypes = 64;
+
+        /// @brief The size and alignment of a component type
+        struct ComponentInfo {
+            size_t size;        ///< sizeof the type
+            size_t alignment;   ///< alignof the type
+        };
+
+        /// @brief Give a component type the next ID
+        /// @param size The size of the type
+        /// @param alignment The alignment of the type
+        /// @return The ID
+        /// @throws #lov::Exceptions::EntityException if #MaxComponentTypes types are already registered
+        lov_uint registerComponent(size_t size, size_t alignment);
+
+        /// @brief Get the size and alignment of a registered component type
+        /// @param component The component's ID
+        /// @return Its info
+        const ComponentInfo& getComponentInfo(lov_uint component);
+
+        /// @brief Get the ID of a component type, registering it the first time
+        ///
+        /// Components are moved between chunks byte for byte and never destroyed, so they must be trivially copyable.
+        /// @tparam T The component type
+        /// @return Its ID
+        template <typename T>
+        inline lov_uint getComponentId() {
+            static_assert(std::is_trivially_copyable_v<T>, "Components are moved between chunks byte for byte");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Chunks are only aligned to max_align_t");
+
+            static const lov_uint id = registerComponent(sizeof(T), alignof(T));
+            return id;
+        }
+
+        /// @brief Get the mask of a set of component types
+        /// @tparam Ts The component types
+        /// @return The mask with each of their bits set
+        template <typename... Ts>
+        inline ComponentMask getComponentMask() {
+            return (ComponentMask(0) | ... | (ComponentMask(1) << getComponentId<Ts>()));
+        }
+    }
+}
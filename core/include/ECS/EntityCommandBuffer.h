@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ECS/Entity.h"
+#include "System/LinearAllocator.h"
+#include "System/Types.h"
+
+/// @file EntityCommandBuffer.h
+/// @brief Defines the #lov::ECS::EntityCommandBuffer that defers structural changes to a #lov::ECS::World
+
+namespace lov {
+    namespace ECS {
+        class World;
+
+        /// @brief Records creating and destroying entities and adding and removing components, to apply later
+        ///
+        /// Systems iterating a world can't change which archetype an entity is in, so they record the change here and
+        /// it's applied once they're done. Component data is copied into the buffer's own linear allocator, so give
+        /// each thread its own buffer, such as one per #lov::System::JobSystem::getThreadIndex, and apply them in turn.
+        /// Commands on entities that are no longer alive when applied are skipped, so two systems destroying the same
+        /// entity isn't an error.
+        class EntityCommandBuffer {
+        public:
+            /// @brief Construct an empty buffer
+            /// @param blockSize Size of each block of the buffer's allocator
+            explicit EntityCommandBuffer(size_t blockSize = 16 * 1024);
+
+            EntityCommandBuffer(EntityCommandBuffer&&) = default;
+            EntityCommandBuffer& operator=(EntityCommandBuffer&&) = default;
+
+            /// @brief Record creating an entity with no components
+            /// @return A placeholder for the entity, which later commands of this buffer can use until it's applied
+            Entity create();
+
+            /// @brief Record destroying an entity
+            /// @param entity The entity, or a placeholder from #create
+            void destroy(Entity entity);
+
+            /// @brief Record adding a component to an entity
+            /// @tparam T The component type
+            /// @param entity The entity, or a placeholder from #create
+            /// @param component The component, copied now
+            template <typename T>
+            inline void add(Entity entity, const T& component) {
+                addComponent(entity, getComponentId<T>(), &component);
+            }
+
+            /// @brief Record removing a component from an entity
+            /// @tparam T The component type
+            /// @param entity The entity, or a placeholder from #create
+            template <typename T>
+            inline void remove(Entity entity) {
+                removeComponent(entity, getComponentId<T>());
+            }
+
+            /// @brief Record adding a component to an entity by ID
+            /// @param entity The entity, or a placeholder from #create
+            /// @param component The component's ID
+            /// @param data The component, copied now
+            void addComponent(Entity entity, lov_uint component, const void* data);
+
+            /// @brief Record removing a component from an entity by ID
+            /// @param entity The entity, or a placeholder from #create
+            /// @param component The component's ID
+            void removeComponent(Entity entity, lov_uint component);
+
+            /// @brief Apply the commands in the order they were recorded, then clear them
+            /// @param world The world to change
+            void apply(World& world);
+
+            /// @brief Forget every command without applying them
+            void clear();
+
+            /// @brief Are there no commands?
+            /// @return Whether it's empty
+            bool isEmpty() const;
+
+        private:
+            /// @brief What a command does
+            enum class CommandType : uint8_t {
+                Create,     ///< Create an entity
+                Destroy,    ///< Destroy an entity
+                Add,        ///< Add a component
+                Remove      ///< Remove a component
+            };
+
+            /// @brief One recorded change
+            struct Command {
+                CommandType type;   ///< What it does
+                Entity entity;      ///< The entity, or a placeholder
+                lov_uint component; ///< The component's ID, for adding and removing
+                const void* data;   ///< The component to add, in the allocator
+            };
+
+            /// @brief The generation of placeholders from #create, which real entities never reach
+            static constexpr lov_uint PlaceholderGeneration = UINT32_MAX;
+
+            System::LinearAllocator m_allocator;    ///< Holds component data until applied
+            std::vector<Command> m_commands;        ///< The commands, in the order recorded
+            std::vector<Entity> m_created;          ///< Entity each placeholder became while applying
+            lov_uint m_placeholders;                ///< Placeholders given out since the last apply
+        };
+    }
+}
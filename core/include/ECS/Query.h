@@ -0,0 +1,102 @@
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "ECS/Archetype.h"
+#include "ECS/Entity.h"
+#include "System/JobSystem.h"
+#include "System/Types.h"
+
+/// @file Query.h
+/// @brief Defines the #lov::ECS::Query that iterates the chunks of every archetype with a set of components
+
+namespace lov {
+    namespace ECS {
+        /// @brief One chunk of rows, as seen by a system
+        class ChunkView {
+        public:
+            /// @brief View a chunk
+            /// @param archetype The chunk's archetype
+            /// @param chunk The chunk
+            ChunkView(const Archetype& archetype, const Chunk& chunk);
+
+            /// @brief Get the number of rows
+            /// @return The row count
+            lov_uint getCount() const;
+
+            /// @brief Get the entity of each row
+            /// @return The entities
+            std::span<const Entity> getEntities() const;
+
+            /// @brief Get a component's column
+            /// @tparam T The component type, which the archetype must have
+            /// @return The component of each row
+            template <typename T>
+            std::span<T> get() const;
+
+            /// @brief Does the chunk's archetype have a component?
+            /// @tparam T The component type
+            /// @return Whether it does
+            template <typename T>
+            bool has() const;
+
+        private:
+            const Archetype* m_archetype;   ///< The chunk's archetype
+            const Chunk* m_chunk;           ///< The chunk
+        };
+
+        /// @brief The archetypes that have every one of a set of components, kept up to date as archetypes are created
+        ///
+        /// Get queries from #lov::ECS::World::query, which caches them, so matching archetypes is only done once per
+        /// archetype rather than on every iteration. Iterating walks each matching archetype's chunks in order, so
+        /// systems read their columns linearly. Don't add or remove components or entities while iterating; record
+        /// them into a #lov::ECS::EntityCommandBuffer and apply it after.
+        class Query {
+        public:
+            /// @brief Construct a query that matches no archetypes yet
+            /// @param mask The components an archetype must have
+            explicit Query(ComponentMask mask);
+
+            /// @brief Get the components this query matches
+            /// @return Their mask
+            ComponentMask getMask() const;
+
+            /// @brief Add an archetype if it has every component of this query
+            /// @param archetype The archetype
+            void match(const Archetype& archetype);
+
+            /// @brief Get the archetypes this query matches
+            /// @return The archetypes
+            std::span<const Archetype* const> getArchetypes() const;
+
+            /// @brief Get the entities this query matches
+            /// @return The entity count
+            lov_uint getEntityCount() const;
+
+            /// @brief Call a function on each chunk
+            /// @param function Called with a #lov::ECS::ChunkView of each chunk
+            template <typename Function>
+            void forEachChunk(Function&& function) const;
+
+            /// @brief Call a function on each entity
+            /// @tparam Ts The component types to pass, which must be part of this query
+            /// @param function Called with each entity and a reference to each of its components
+            template <typename... Ts, typename Function>
+            void forEach(Function&& function) const;
+
+            /// @brief Call a function on each chunk, spread across a job system's threads, and wait for them all
+            /// @param jobs The job system
+            /// @param function Called with a #lov::ECS::ChunkView of each chunk, from any of the threads
+            template <typename Function>
+            void parallelForEachChunk(System::JobSystem& jobs, Function&& function) const;
+
+        private:
+            ComponentMask m_mask;                       ///< Components an archetype must have
+            std::vector<const Archetype*> m_archetypes; ///< Matching archetypes
+        };
+    }
+}
+
+#include "ECS/Query.inl"
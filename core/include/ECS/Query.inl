@@ -0,0 +1,49 @@
+namespace lov {
+    namespace ECS {
+        template <typename T>
+        std::span<T> ChunkView::get() const {
+            return std::span<T>(reinterpret_cast<T*>(m_archetype->getColumn(*m_chunk, getComponentId<T>())), m_chunk->count);
+        }
+
+        template <typename T>
+        bool ChunkView::has() const {
+            return (m_archetype->getMask() & getComponentMask<T>()) != 0;
+        }
+
+        template <typename Function>
+        void Query::forEachChunk(Function&& function) const {
+            for (const Archetype* archetype : m_archetypes) {
+                for (const Chunk& chunk : archetype->getChunks()) {
+                    function(ChunkView(*archetype, chunk));
+                }
+            }
+        }
+
+        template <typename... Ts, typename Function>
+        void Query::forEach(Function&& function) const {
+            forEachChunk([&function](const ChunkView& view) {
+                std::span<const Entity> entities = view.getEntities();
+                auto columns = std::make_tuple(view.get<Ts>().data()...);
+
+                for (lov_uint row = 0; row < view.getCount(); row++) {
+                    std::apply([&](Ts*... column) { function(entities[row], column[row]...); }, columns);
+                }
+            });
+        }
+
+        template <typename Function>
+        void Query::parallelForEachChunk(System::JobSystem& jobs, Function&& function) const {
+            // Index every chunk, so the job system can split them into ranges
+            std::vector<ChunkView> views;
+            forEachChunk([&views](const ChunkView& view) {
+                views.push_back(view);
+            });
+
+            jobs.parallelFor(static_cast<lov_size>(views.size()), [&](lov_size begin, lov_size end) {
+                for (lov_size i = begin; i < end; i++) {
+                    function(views[i]);
+                }
+            }, 1);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <span>
+
+#include "Graphics/CommandBuffer.h"
+#include "Graphics/Frustum.h"
+#include "System/JobSystem.h"
+#include "System/Types.h"
+
+/// @file Systems.h
+/// @brief Declares the engine's systems over the components in ECS/Components.h
+
+namespace lov {
+    namespace ECS {
+        class World;
+
+        /// @brief Copy each entity's #lov::ECS::LocalTransform into its #lov::ECS::PreviousTransform, before a step
+        /// changes it
+        /// @param world The world
+        /// @param jobs Job system to spread the chunks across, or null to run on this thread
+        void storePreviousTransforms(World& world, System::JobSystem* jobs = nullptr);
+
+        /// @brief Write each entity's #lov::ECS::WorldTransform from its #lov::ECS::LocalTransform
+        ///
+        /// Entities that also have a #lov::ECS::PreviousTransform are blended between it and their local transform,
+        /// so they move smoothly when frames fall between simulation steps.
+        /// @param world The world
+        /// @param jobs Job system to spread the chunks across, or null to run on this thread
+        /// @param alpha How far the frame is between the previous step and the latest, such as
+        /// #lov::System::FrameClock::getAlpha
+        void updateTransforms(World& world, System::JobSystem* jobs = nullptr, float alpha = 1.0f);
+
+        /// @brief Write each entity's #lov::ECS::Visible from whether its #lov::ECS::RenderBounds, moved by its
+        /// #lov::ECS::WorldTransform, intersect a frustum
+        /// @param world The world
+        /// @param frustum The frustum
+        /// @param jobs Job system to spread the chunks across, or null to run on this thread
+        void cullEntities(World& world, const Graphics::Frustum& frustum, System::JobSystem* jobs = nullptr);
+
+        /// @brief Record a draw of each visible entity with a #lov::ECS::RenderMesh, then sort each buffer
+        ///
+        /// Each draw is its own group keyed by program, then vertex array, so replaying the buffers in key order binds
+        /// each of them once. The entity's model matrix is set as a uniform block, so its shader declares one holding
+        /// just a mat4.
+        /// @param world The world
+        /// @param buffers Buffer to record into for each thread, indexed by #lov::System::JobSystem::getThreadIndex,
+        /// plus a last one shared by threads outside the job system that run chunks while waiting, so at least
+        /// #lov::System::JobSystem::getThreadCount + 1 of them, or just one without a job system
+        /// @param modelBinding Uniform block binding of the model matrix
+        /// @param jobs Job system to spread the chunks across, or null to run on this thread
+        void extractDraws(World& world, std::span<Graphics::CommandBuffer> buffers, lov_uint modelBinding, System::JobSystem* jobs = nullptr);
+    }
+}
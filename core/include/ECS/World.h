@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ECS/Archetype.h"
+#include "ECS/Entity.h"
+#include "ECS/Query.h"
+#include "System/Types.h"
+
+/// @file World.h
+/// @brief Defines the #lov::ECS::World that owns entities and stores their components by archetype
+
+namespace lov {
+    namespace ECS {
+        /// @brief Owns entities and their components, storing each entity in the archetype of its set of components
+        ///
+        /// Adding or removing a component moves the entity's row to another archetype, found through edges each
+        /// archetype caches, so only the first such move between two archetypes looks one up. None of this is
+        /// thread safe, and it invalidates iteration, so systems running in parallel record their changes into a
+        /// #lov::ECS::EntityCommandBuffer each and apply them once the systems are done.
+        class World {
+        public:
+            /// @brief Construct a world with no entities
+            World();
+
+            World(const World&) = delete;
+            World& operator=(const World&) = delete;
+
+            /// @brief Create an entity with no components
+            /// @return The entity
+            Entity create();
+
+            /// @brief Create an entity with components
+            /// @tparam Ts The component types, each different
+            /// @param components The components
+            /// @return The entity
+            template <typename... Ts>
+            Entity create(const Ts&... components);
+
+            /// @brief Destroy an entity and its components
+            /// @param entity The entity
+            /// @throws #lov::Exceptions::EntityException if the entity isn't alive
+            void destroy(Entity entity);
+
+            /// @brief Has an entity been created and not yet destroyed?
+            /// @param entity The entity
+            /// @return Whether it's alive
+            bool isAlive(Entity entity) const;
+
+            /// @brief Add a component to an entity, or replace it if the entity already has one
+            /// @tparam T The component type
+            /// @param entity The entity
+            /// @param component The component
+            /// @throws #lov::Exceptions::EntityException if the entity isn't alive
+            template <typename T>
+            void add(Entity entity, const T& component);
+
+            /// @brief Remove a component from an entity, if it has one
+            /// @tparam T The component type
+            /// @param entity The entity
+            /// @throws #lov::Exceptions::EntityException if the entity isn't alive
+            template <typename T>
+            void remove(Entity entity);
+
+            /// @brief Get a component of an entity
+            /// @tparam T The component type
+            /// @param entity The entity
+            /// @return The component, valid until the entity's components change, or null if it has none or isn't alive
+            template <typename T>
+            T* get(Entity entity) const;
+
+            /// @brief Does an entity have a component?
+            /// @tparam T The component type
+            /// @param entity The entity
+            /// @return Whether it's alive and has the component
+            template <typename T>
+            bool has(Entity entity) const;
+
+            /// @brief Get the query of every entity with a set of components, creating it the first time
+            /// @tparam Ts The component types
+            /// @return The query, owned by this World and kept up to date as archetypes are created
+            template <typename... Ts>
+            Query& query();
+
+            /// @brief Add a component to an entity by ID, or replace it if the entity already has one
+            /// @param entity The entity
+            /// @param component The component's ID
+            /// @param data The component, copied byte for byte
+            /// @throws #lov::Exceptions::EntityException if the entity isn't alive
+            void addComponent(Entity entity, lov_uint component, const void* data);
+
+            /// @brief Remove a component from an entity by ID, if it has one
+            /// @param entity The entity
+            /// @param component The component's ID
+            /// @throws #lov::Exceptions::EntityException if the entity isn't alive
+            void removeComponent(Entity entity, lov_uint component);
+
+            /// @brief Get a component of an entity by ID
+            /// @param entity The entity
+            /// @param component The component's ID
+            /// @return The component, or null if it has none or isn't alive
+            void* getComponent(Entity entity, lov_uint component) const;
+
+            /// @brief Get the query of every entity with a set of components by mask, creating it the first time
+            /// @param mask The components
+            /// @return The query
+            Query& query(ComponentMask mask);
+
+            /// @brief Get the number of entities alive
+            /// @return The entity count
+            lov_uint getEntityCount() const;
+
+            /// @brief Get the number of archetypes created
+            /// @return The archetype count
+            lov_uint getArchetypeCount() const;
+
+        private:
+            /// @brief Where an entity's row is
+            struct Record {
+                lov_uint generation;    ///< Generation of the entity using this index, or of the next one if it's free
+                Archetype* archetype;   ///< The entity's archetype, or null if the index is free
+                lov_uint chunk;         ///< Index of the row's chunk
+                lov_uint row;           ///< The row within the chunk
+            };
+
+            /// @brief Get the record of a live entity
+            /// @param entity The entity
+            /// @return Its record
+            /// @throws #lov::Exceptions::EntityException if the entity isn't alive
+            Record& getRecord(Entity entity);
+
+            /// @brief Get the archetype of a set of components, creating it and matching it to queries the first time
+            /// @param mask The components
+            /// @return The archetype
+            Archetype* getArchetype(ComponentMask mask);
+
+            /// @brief Allocate a row for a new entity
+            /// @param archetype The entity's archetype
+            /// @return The entity
+            Entity allocate(Archetype* archetype);
+
+            /// @brief Move an entity's row to another archetype, copying the components both share
+            /// @param entity The entity
+            /// @param record Its record
+            /// @param archetype The archetype to move to
+            void move(Entity entity, Record& record, Archetype* archetype);
+
+            std::vector<Record> m_records;                                          ///< Record of each entity index
+            std::vector<lov_uint> m_freeIndices;                                    ///< Indices of destroyed entities, to reuse
+            std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> m_archetypes; ///< Archetype of each set of components
+            std::unordered_map<ComponentMask, std::unique_ptr<Query>> m_queries;    ///< Query of each set of components
+            Archetype* m_empty;                                                     ///< Archetype of entities with no components
+            lov_uint m_entityCount;                                                 ///< Entities alive
+        };
+    }
+}
+
+#include "ECS/World.inl"
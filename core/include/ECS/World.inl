@@ -0,0 +1,39 @@
+namespace lov {
+    namespace ECS {
+        template <typename... Ts>
+        Entity World::create(const Ts&... components) {
+            static_assert(sizeof...(Ts) > 0, "Use create() for an entity with no components");
+            ComponentMask mask = getComponentMask<Ts...>();
+
+            // Copy each component straight into the new row, without moving through the archetypes in between
+            Entity entity = allocate(getArchetype(mask));
+            (std::memcpy(getComponent(entity, getComponentId<Ts>()), &components, sizeof(Ts)), ...);
+            return entity;
+        }
+
+        template <typename T>
+        void World::add(Entity entity, const T& component) {
+            addComponent(entity, getComponentId<T>(), &component);
+        }
+
+        template <typename T>
+        void World::remove(Entity entity) {
+            removeComponent(entity, getComponentId<T>());
+        }
+
+        template <typename T>
+        T* World::get(Entity entity) const {
+            return static_cast<T*>(getComponent(entity, getComponentId<T>()));
+        }
+
+        template <typename T>
+        bool World::has(Entity entity) const {
+            return get<T>(entity) != nullptr;
+        }
+
+        template <typename... Ts>
+        Query& World::query() {
+            return query(getComponentMask<Ts...>());
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+
+#include "Graphics/Mesh.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file AtlasPacker.h
+/// @brief Defines the #lov::Graphics::AtlasPacker that places small images into a shared atlas page
+
+namespace lov {
+    namespace Graphics {
+        /// @brief A rectangle of texels in an atlas page
+        struct AtlasRect {
+            lov_int x;      ///< Left edge in texels
+            lov_int y;      ///< Bottom edge in texels
+            lov_int width;  ///< Width in texels
+            lov_int height; ///< Height in texels
+        };
+
+        /// @brief Where an image ended up in an atlas, as a transform from its own texture coordinates
+        struct AtlasRegion {
+            Vector2f offset;    ///< Texture coordinates of the image's bottom left corner in the page
+            Vector2f scale;     ///< Size of the image in page texture coordinates
+            lov_int layer;      ///< The texture array layer of the page
+
+            /// @brief Describe a packed rectangle
+            /// @param rect The rectangle
+            /// @param pageWidth The width of the page
+            /// @param pageHeight The height of the page
+            /// @param layer The texture array layer of the page
+            /// @return The region
+            static AtlasRegion fromRect(const AtlasRect& rect, lov_int pageWidth, lov_int pageHeight, lov_int layer);
+
+            /// @brief Map texture coordinates of the image into the page
+            /// @param texCoords Coordinates from 0 to 1 across the image
+            /// @return The coordinates in the page
+            Vector2f remap(const Vector2f& texCoords) const;
+
+            /// @brief Map every texture coordinate of a mesh into the page. Coordinates outside 0 to 1 would sample
+            /// neighbouring images, so meshes that rely on repeat wrapping should use a whole texture array layer instead
+            /// @param mesh The mesh to remap
+            void remap(MeshData& mesh) const;
+        };
+
+        /// @brief Packs rectangles into a fixed size page with the skyline bottom left heuristic
+        ///
+        /// The skyline is the top edge of everything placed so far, kept as a list of horizontal segments. Each rectangle
+        /// goes where its top would be lowest, which wastes little space for the mixed sizes of UI and decal textures
+        /// while staying far cheaper than tracking every free rectangle.
+        class AtlasPacker {
+        public:
+            /// @brief Construct an empty AtlasPacker
+            /// @param width The width of the page
+            /// @param height The height of the page
+            /// @param padding Texels kept free around each rectangle so filtering and mips don't blend in neighbours
+            AtlasPacker(lov_int width, lov_int height, lov_int padding = 0);
+
+            /// @brief Place a rectangle
+            /// @param width The width of the rectangle
+            /// @param height The height of the rectangle
+            /// @param rect Set to where the rectangle was placed, excluding padding
+            /// @return Whether it fit
+            bool pack(lov_int width, lov_int height, AtlasRect& rect);
+
+            /// @brief Remove every placed rectangle
+            void clear();
+
+            /// @brief Get the fraction of the page covered by placed rectangles and their padding
+            /// @return The occupancy from 0 to 1
+            float getOccupancy() const;
+
+            /// @brief Get the width of the page
+            /// @return The width in texels
+            lov_int getWidth() const;
+
+            /// @brief Get the height of the page
+            /// @return The height in texels
+            lov_int getHeight() const;
+
+            /// @brief Get the padding around each rectangle
+            /// @return The padding in texels
+            lov_int getPadding() const;
+
+        private:
+            /// @brief One horizontal segment of the skyline
+            struct SkylineNode {
+                lov_int x;      ///< Left edge of the segment
+                lov_int y;      ///< Height of the skyline along the segment
+                lov_int width;  ///< Width of the segment
+            };
+
+            /// @brief Find how low a rectangle can sit with its left edge on a segment
+            /// @param node The index of the segment
+            /// @param width The width of the rectangle
+            /// @param height The height of the rectangle
+            /// @param y Set to the bottom of the rectangle
+            /// @return Whether it fits inside the page there
+            bool fit(size_t node, lov_int width, lov_int height, lov_int& y) const;
+
+            lov_int m_width;                    ///< Width of the page
+            lov_int m_height;                   ///< Height of the page
+            lov_int m_padding;                  ///< Free texels around each rectangle
+            std::vector<SkylineNode> m_skyline; ///< Segments from left to right, covering the whole width
+            lov_size m_usedArea;                ///< Texels covered by placed rectangles and their padding
+        };
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+/// @file BlockEncoder.h
+/// @brief Declares the core CPU encoders that compress 4x4 blocks of pixels, used by the TextureBaker tool and at runtime
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Encoders for one 4x4 block of RGBA8 pixels, given in rows of 4 pixels
+        ///
+        /// Each encoder searches for the endpoints with the least squared error rather than the fastest acceptable ones,
+        /// so encode at runtime on worker threads, or when loading, rather than every frame. They are thread safe.
+        namespace BlockEncoder {
+            /// @brief Encode opaque colour as BC1 in its four colour mode
+            /// @param pixels The 16 pixels
+            /// @param out The 8 byte block
+            void encodeBC1(const unsigned char* pixels, unsigned char* out);
+
+            /// @brief Encode colour and alpha as BC3, a BC4 alpha block followed by a four colour BC1 block
+            /// @param pixels The 16 pixels
+            /// @param out The 16 byte block
+            void encodeBC3(const unsigned char* pixels, unsigned char* out);
+
+            /// @brief Encode the red and green channels as BC5, two BC4 blocks
+            /// @param pixels The 16 pixels
+            /// @param out The 16 byte block
+            void encodeBC5(const unsigned char* pixels, unsigned char* out);
+
+            /// @brief Encode colour and alpha as BC7 mode 6, a single subset with 7 bit endpoints, p-bits and 4 bit indices
+            /// @param pixels The 16 pixels
+            /// @param out The 16 byte block
+            void encodeBC7(const unsigned char* pixels, unsigned char* out);
+
+            /// @brief Encode opaque colour as ETC2 RGB8 using its ETC1 compatible individual and differential modes
+            /// @param pixels The 16 pixels
+            /// @param out The 8 byte block
+            void encodeETC2(const unsigned char* pixels, unsigned char* out);
+
+            /// @brief Encode colour and alpha as ETC2 RGBA8, an EAC alpha block followed by an ETC2 RGB8 block
+            /// @param pixels The 16 pixels
+            /// @param out The 16 byte block
+            void encodeETC2Alpha(const unsigned char* pixels, unsigned char* out);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Graphics/Transform.h"
+#include "System/Vector.h"
+
+/// @file BoundingBox.h
+/// @brief Defines the #lov::Graphics::BoundingBox used to bound geometry for culling
+
+namespace lov {
+    namespace Graphics {
+        /// @brief An axis aligned bounding box
+        struct BoundingBox {
+            /// @brief Construct an empty BoundingBox that contains no points
+            BoundingBox();
+
+            /// @brief Construct this BoundingBox with the given corners
+            /// @param min The minimum corner of the box
+            /// @param max The maximum corner of the box
+            BoundingBox(const Vector3f& min, const Vector3f& max);
+
+            Vector3f min; ///< The minimum corner of this BoundingBox
+            Vector3f max; ///< The maximum corner of this BoundingBox
+
+            /// @brief Does this BoundingBox contain no points?
+            /// @return Whether this BoundingBox is empty
+            bool isEmpty() const;
+
+            /// @brief Grow this BoundingBox to contain the given point
+            /// @param point The point to contain
+            void expand(const Vector3f& point);
+
+            /// @brief Grow this BoundingBox to contain the given box
+            /// @param other The box to contain
+            void expand(const BoundingBox& other);
+
+            /// @brief Get the center of this BoundingBox
+            /// @return The center point
+            Vector3f getCenter() const;
+
+            /// @brief Get the half size of this BoundingBox along each axis
+            /// @return The half extents
+            Vector3f getExtents() const;
+
+            /// @brief Get the box that bounds this box after applying the given transform
+            /// @param transform The transform to apply
+            /// @return The transformed BoundingBox
+            BoundingBox transformed(const Transform& transform) const;
+        };
+    }
+}
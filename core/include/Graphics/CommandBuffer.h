@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "System/LinearAllocator.h"
+#include "System/Types.h"
+
+/// @file CommandBuffer.h
+/// @brief Defines the #lov::Graphics::CommandBuffer that any thread can record draws into for the render thread to replay
+
+namespace lov {
+    namespace Graphics {
+        /// @brief What a #lov::Graphics::RenderCommand does
+        enum class RenderCommandType : uint8_t {
+            BindProgram,        ///< Use a shader program
+            SetUniformBlock,    ///< Bind a copy of a uniform block's data to a binding point
+            BindVertexArray,    ///< Bind a vertex array
+            DrawElements        ///< Draw triangles from the bound vertex array's unsigned int indices
+        };
+
+        /// @brief One recorded command, chained to the next of its group. Refers to objects by ID, so recording needs no context
+        struct RenderCommand {
+            RenderCommandType type;         ///< What this command does, and so which member of the union is set
+            const RenderCommand* next;      ///< The next command of its group, or null
+
+            union {
+                /// @brief A #RenderCommandType::BindProgram, the ID from #lov::Graphics::Shader::getID
+                lov_uint program;
+
+                /// @brief A #RenderCommandType::BindVertexArray, the ID from #lov::Graphics::VertexArray::getID
+                lov_uint vertexArray;
+
+                /// @brief A #RenderCommandType::SetUniformBlock
+                struct {
+                    lov_uint binding;       ///< The binding point, see #lov::Graphics::Shader::bindUniformBlock
+                    lov_uint size;          ///< Size of the data in bytes
+                    const void* data;       ///< The data, copied into the buffer's allocator
+                } uniformBlock;
+
+                /// @brief A #RenderCommandType::DrawElements
+                struct {
+                    lov_size count;         ///< Number of indices
+                    lov_uint firstIndex;    ///< Index of the first index in the element buffer
+                    lov_int baseVertex;     ///< Added to each index
+                    lov_size instanceCount; ///< Number of instances
+                } draw;
+            };
+        };
+
+        /// @brief A group of commands that run together, in the order set by its key
+        struct RenderCommandGroup {
+            uint64_t key;                   ///< Lower keys run first
+            const RenderCommand* first;     ///< The group's first command, or null if it's empty
+        };
+
+        /// @brief Records draws on any thread, for a #lov::Graphics::CommandQueue to replay on the thread owning the context
+        ///
+        /// Each #begin starts a group of commands with a sort key, usually packing pass, then shader, then vertex array
+        /// and depth from most to least significant bits, so sorting groups by key also minimizes state changes.
+        /// Commands and uniform data come from the buffer's own linear allocator, so recording never locks or touches
+        /// the heap once warmed up. A buffer must only be recorded by one thread at a time; give each thread its own,
+        /// such as one per #lov::System::JobSystem::getThreadIndex.
+        class CommandBuffer {
+        public:
+            /// @brief Construct an empty buffer
+            /// @param blockSize Size of each block of the buffer's allocator
+            explicit CommandBuffer(size_t blockSize = 64 * 1024);
+
+            CommandBuffer(CommandBuffer&&) = default;
+            CommandBuffer& operator=(CommandBuffer&&) = default;
+
+            /// @brief Start a group of commands. Later commands belong to it until the next #begin or #sort, and
+            /// commands recorded outside any group start one with key 0
+            /// @param key Where the group sorts. Groups with equal keys keep the order they were recorded in
+            void begin(uint64_t key);
+
+            /// @brief Record using a shader program
+            /// @param program The ID of the shader, which must outlive the replay
+            void bindProgram(lov_uint program);
+
+            /// @brief Record binding a copy of a uniform block's data
+            /// @param binding The binding point
+            /// @param data The data, copied now
+            /// @param size The size of the data in bytes
+            void setUniformBlock(lov_uint binding, const void* data, lov_uint size);
+
+            /// @brief Record binding a copy of a uniform block's data
+            /// @tparam T The type of the block, laid out to match the shader's std140 block
+            /// @param binding The binding point
+            /// @param block The data, copied now
+            template <typename T>
+            inline void setUniformBlock(lov_uint binding, const T& block) {
+                static_assert(std::is_trivially_copyable_v<T>, "Uniform blocks are copied byte for byte");
+                setUniformBlock(binding, &block, static_cast<lov_uint>(sizeof(T)));
+            }
+
+            /// @brief Record binding a vertex array
+            /// @param vertexArray The ID of the vertex array, which must outlive the replay
+            void bindVertexArray(lov_uint vertexArray);
+
+            /// @brief Record drawing triangles from the bound vertex array's element buffer of unsigned ints
+            /// @param count Number of indices
+            /// @param firstIndex Index of the first index in the element buffer
+            /// @param baseVertex Added to each index
+            /// @param instanceCount Number of instances
+            void drawElements(lov_size count, lov_uint firstIndex = 0, lov_int baseVertex = 0, lov_size instanceCount = 1);
+
+            /// @brief Sort the groups by key. Do this on the recording thread, so the replay only has to merge buffers
+            void sort();
+
+            /// @brief Forget every command and free their memory for the next frame
+            void clear();
+
+            /// @brief Get the groups, sorted if #sort was called since the last one was recorded
+            /// @return The groups
+            std::span<const RenderCommandGroup> getGroups() const;
+
+            /// @brief Get the bytes of uniform data recorded
+            /// @return The size in bytes
+            size_t getUniformSize() const;
+
+            /// @brief Merge the groups of sorted buffers into one sorted list
+            /// @param buffers The buffers, each sorted. Groups with equal keys keep the order of the buffers
+            /// @param groups Set to every group in key order, reusing its storage
+            static void merge(std::span<const CommandBuffer> buffers, std::vector<const RenderCommandGroup*>& groups);
+
+        private:
+            /// @brief Append a command to the current group
+            /// @param type What the command does
+            /// @return The command to fill in
+            RenderCommand* append(RenderCommandType type);
+
+            System::LinearAllocator m_allocator;        ///< Holds commands and uniform data until #clear
+            std::vector<RenderCommandGroup> m_groups;   ///< Every group, in the order begun or sorted by key
+            bool m_open;                                ///< Is the last group of m_groups still being recorded?
+            RenderCommand* m_last;                      ///< Last command of that group, or null
+            size_t m_uniformSize;                       ///< Bytes of uniform data recorded
+        };
+    }
+}
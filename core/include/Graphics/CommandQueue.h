@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Graphics/CommandBuffer.h"
+#include "System/Types.h"
+
+/// @file CommandQueue.h
+/// @brief Defines the #lov::Graphics::CommandQueue that replays command buffers on the thread owning the context
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Counters from the latest #lov::Graphics::CommandQueue::execute
+        struct CommandQueueStats {
+            lov_uint groups;            ///< Groups replayed
+            lov_uint draws;             ///< Draw calls made
+            lov_uint programBinds;      ///< Programs bound, after skipping ones already bound
+            lov_uint vertexArrayBinds;  ///< Vertex arrays bound, after skipping ones already bound
+            lov_uint uniformBlocks;     ///< Uniform blocks bound
+            size_t uniformBytes;        ///< Bytes of uniform data uploaded, including alignment padding
+        };
+
+        /// @brief Merges command buffers recorded on other threads and replays them in key order
+        ///
+        /// Every uniform block of a replay is packed into one uniform buffer with a single upload, then each is bound
+        /// with glBindBufferRange, so setting a block costs no more than binding it. Binds of the program or vertex array
+        /// already bound are skipped, which sorting by key makes common.
+        class CommandQueue {
+        public:
+            /// @brief Generate the uniform buffer. Requires a current context
+            CommandQueue();
+
+            /// @brief Deallocate the uniform buffer
+            ~CommandQueue();
+
+            CommandQueue(const CommandQueue&) = delete;
+            CommandQueue& operator=(const CommandQueue&) = delete;
+
+            /// @brief Replay the commands of every buffer, merged by key
+            /// @param buffers The buffers, each sorted with #lov::Graphics::CommandBuffer::sort
+            void execute(std::span<const CommandBuffer> buffers);
+
+            /// @brief Get the counters of the latest #execute
+            /// @return The stats
+            CommandQueueStats getStats() const;
+
+        private:
+            lov_uint m_uniformBuffer;                           ///< ID of the buffer every uniform block is packed into
+            lov_size m_uniformCapacity;                         ///< Size of its storage in bytes
+            size_t m_uniformAlignment;                          ///< Alignment OpenGL requires of a bound range's offset
+            std::vector<std::byte> m_uniforms;                  ///< The packed uniform blocks, reused across replays
+            std::vector<const RenderCommandGroup*> m_groups;    ///< The merged groups, reused across replays
+            CommandQueueStats m_stats;                          ///< Counters reported by getStats
+        };
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/DrawIndirectBuffer.h"
+#include "Graphics/InstanceCulling.h"
+#include "Graphics/Shader.h"
+#include "Graphics/ShaderStorageBuffer.h"
+#include "Graphics/Transform.h"
+#include "Graphics/VertexArray.h"
+#include "System/Types.h"
+
+/// @file ComputeCuller.h
+/// @brief Defines the #lov::Graphics::ComputeCuller that culls instances on the GPU and writes the indirect draws
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Culls instances against the camera frustum and an optional depth pyramid in a compute shader (OpenGL 4.3)
+        ///
+        /// Each instance belongs to one draw command. The shader appends every visible instance's index to its command's
+        /// range of the visible instance buffer and counts it in the command's instanceCount, so the draws never return to the CPU.
+        /// Link the visible instance buffer as an instanced integer attribute with #linkVisibleInstances; each command's
+        /// baseInstance offsets into it.
+        class ComputeCuller {
+        public:
+            /// @brief Construct an empty ComputeCuller
+            ComputeCuller();
+
+            /// @brief Deallocate the depth pyramid texture of this ComputeCuller
+            ~ComputeCuller();
+
+            ComputeCuller(const ComputeCuller&) = delete;
+            ComputeCuller& operator=(const ComputeCuller&) = delete;
+
+            /// @brief Does the current context support GPU culling?
+            /// @return Whether compute shaders and indirect draws are available
+            static bool isSupported();
+
+            /// @brief Compile the culling compute shader
+            /// @param computeShaderPath Path to cull.comp
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compile(const std::string& computeShaderPath);
+
+            /// @brief Add a mesh that instances can be drawn with
+            /// @param indexCount The number of indices of the mesh
+            /// @param firstIndex The offset of the mesh's first index in the bound ElementBuffer
+            /// @param baseVertex The value added to each index of the mesh
+            /// @return The index of the draw command of the mesh
+            lov_uint addDraw(lov_uint indexCount, lov_uint firstIndex, lov_int baseVertex);
+
+            /// @brief Add an instance of a mesh
+            /// @param model The model transform of the instance
+            /// @param bounds The model space bounds of the mesh
+            /// @param draw The draw command returned by #addDraw
+            /// @return The index of the instance, as written into the visible instance buffer
+            lov_uint addInstance(const Transform& model, const BoundingBox& bounds, lov_uint draw);
+
+            /// @brief Update the model transform of an instance. Call #upload afterward
+            /// @param instance The index of the instance
+            /// @param model The new model transform
+            void setTransform(lov_uint instance, const Transform& model);
+
+            /// @brief Assign each draw its range of the visible instance buffer and upload the instances
+            void upload();
+
+            /// @brief Upload a depth pyramid to test occlusion against, or pass null to cull against the frustum only
+            /// @param pyramid The pyramid, which should come from the same view projection used by #cull
+            void setDepthPyramid(const DepthPyramid* pyramid);
+
+            /// @brief Dispatch the culling shader, leaving the draw commands ready for #draw
+            /// @param viewProjection The product of the projection and view transforms
+            void cull(const Transform& viewProjection);
+
+            /// @brief Draw every command written by the last #cull. Bind the VertexArray beforehand
+            void draw() const;
+
+            /// @brief Feed the visible instance indices to the given VertexArray as a per-instance unsigned int attribute
+            /// @param vao The VertexArray to link, which must be bound
+            /// @param location The attribute location of the instance index
+            void linkVisibleInstances(const VertexArray& vao, lov_uint location) const;
+
+            /// @brief Run the CPU reference implementation on the current instances
+            /// @param viewProjection The product of the projection and view transforms
+            /// @param commands Receives the commands the shader should write
+            /// @param visible Receives the visible instance buffer the shader should write, in CPU order
+            void cullReference(const Transform& viewProjection, std::vector<DrawElementsIndirectCommand>& commands, std::vector<lov_uint>& visible) const;
+
+            /// @brief Read back the results of the last #cull and compare them with the CPU reference. Stalls the pipeline, so only use for debugging
+            /// @param viewProjection The view projection passed to the last #cull
+            /// @return The number of draw commands whose visible instances differ from the reference
+            lov_size validate(const Transform& viewProjection) const;
+
+            /// @brief Get the instances of this ComputeCuller
+            /// @return The instances
+            const std::vector<CullInstance>& getInstances() const;
+
+        private:
+            Shader m_shader;                                ///< The culling compute shader
+            ShaderStorageBuffer m_instanceBuffer;           ///< Instances read by the shader
+            ShaderStorageBuffer m_visibleBuffer;            ///< Visible instance indices written by the shader
+            DrawIndirectBuffer m_commands;                  ///< Draw commands, reset by the CPU and filled by the shader
+
+            std::vector<CullInstance> m_instances;          ///< CPU copy of the instances
+            std::vector<DrawElementsIndirectCommand> m_draws;///< One command per mesh with its visible range assigned
+
+            lov_uint m_pyramidTexture;                      ///< R32F mip chain of the depth pyramid
+            lov_size m_pyramidLevels;                       ///< Number of levels of the depth pyramid, 0 if disabled
+            const DepthPyramid* m_pyramid;                  ///< The pyramid used by the CPU reference
+        };
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file DepthPyramid.h
+/// @brief Defines the #lov::Graphics::DepthPyramid, a hierarchical depth buffer used for occlusion culling
+
+namespace lov {
+    namespace Graphics {
+        /// @brief A mip chain of a depth buffer where each texel stores the farthest and nearest depths of the texels it covers
+        ///
+        /// Depths are window depths in [0, 1] with 1 farthest, and row 0 is the bottom of the screen as in OpenGL
+        class DepthPyramid {
+        public:
+            /// @brief Construct an empty DepthPyramid with no levels
+            DepthPyramid();
+
+            /// @brief Build every level from a full resolution depth buffer
+            /// @param depth The depth buffer, width * height values in row order from the bottom row
+            /// @param width The width of the depth buffer
+            /// @param height The height of the depth buffer
+            void build(const float* depth, lov_size width, lov_size height);
+
+            /// @brief Get the number of levels of this DepthPyramid
+            /// @return The level count, 0 if not built
+            lov_size getLevelCount() const;
+
+            /// @brief Get the width of a level
+            /// @param level The level
+            /// @return The width in texels
+            lov_size getWidth(lov_size level) const;
+
+            /// @brief Get the height of a level
+            /// @param level The level
+            /// @return The height in texels
+            lov_size getHeight(lov_size level) const;
+
+            /// @brief Get the farthest depth covered by a texel
+            /// @param level The level of the texel
+            /// @param x The column of the texel
+            /// @param y The row of the texel
+            /// @return The farthest depth
+            float getDepth(lov_size level, lov_size x, lov_size y) const;
+
+            /// @brief Get the nearest depth covered by a texel
+            /// @param level The level of the texel
+            /// @param x The column of the texel
+            /// @param y The row of the texel
+            /// @return The nearest depth
+            float getMinDepth(lov_size level, lov_size x, lov_size y) const;
+
+            /// @brief Get the texels of a level
+            /// @param level The level
+            /// @return The farthest depths of the level in row order
+            const std::vector<float>& getLevel(lov_size level) const;
+
+            /// @brief Is a screen rectangle whose nearest depth is the given depth hidden behind the stored depths?
+            ///
+            /// Picks the level where the rectangle covers at most 2x2 texels, matching the GPU culling shader
+            /// @param screenMin The minimum corner of the rectangle in level 0 pixels
+            /// @param screenMax The maximum corner of the rectangle in level 0 pixels
+            /// @param nearestDepth The nearest window depth of the object
+            /// @return Whether every covered texel is nearer than the object
+            bool isOccluded(const Vector2f& screenMin, const Vector2f& screenMax, float nearestDepth) const;
+
+            /// @brief Is every pixel of a rectangle nearer than the given depth?
+            ///
+            /// Walks down from the coarsest level, accepting as soon as a texel's nearest depth is behind the object and
+            /// only refining texels whose depth range straddles it, so the answer matches a test of every pixel
+            /// @param x0 The first column of the rectangle in level 0 pixels
+            /// @param y0 The first row of the rectangle in level 0 pixels
+            /// @param x1 The last column of the rectangle in level 0 pixels
+            /// @param y1 The last row of the rectangle in level 0 pixels
+            /// @param nearestDepth The nearest window depth of the object
+            /// @return Whether every pixel in the rectangle, clamped to the screen, is nearer than the object
+            bool isOccludedExact(lov_int x0, lov_int y0, lov_int x1, lov_int y1, float nearestDepth) const;
+
+        private:
+            /// @brief Test the texels of a level that overlap a rectangle, refining the ones that straddle the depth
+            /// @param level The level to test
+            /// @param x0 The first column of the rectangle in level 0 pixels
+            /// @param y0 The first row of the rectangle in level 0 pixels
+            /// @param x1 The last column of the rectangle in level 0 pixels
+            /// @param y1 The last row of the rectangle in level 0 pixels
+            /// @param nearestDepth The nearest window depth of the object
+            /// @return Whether every overlapped pixel is nearer than the object
+            bool isOccludedAt(lov_size level, lov_int x0, lov_int y0, lov_int x1, lov_int y1, float nearestDepth) const;
+
+            std::vector<std::vector<float>> m_levels;   ///< The farthest depths of each level
+            std::vector<std::vector<float>> m_minLevels;///< The nearest depths of each level
+            std::vector<lov_size> m_widths;             ///< The width of each level
+            std::vector<lov_size> m_heights;            ///< The height of each level
+        };
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "System/Types.h"
+
+/// @file DrawIndirectBuffer.h
+/// @brief Defines the #lov::Graphics::DrawIndirectBuffer used to submit many indexed draws with one call
+
+namespace lov {
+    namespace Graphics {
+        /// @brief The parameters of one indexed draw, laid out as OpenGL expects in a GL_DRAW_INDIRECT_BUFFER
+        struct DrawElementsIndirectCommand {
+            lov_uint count;         ///< The number of indices to draw
+            lov_uint instanceCount; ///< The number of instances to draw, 0 skips the draw
+            lov_uint firstIndex;    ///< The offset of the first index in the bound ElementBuffer
+            lov_int baseVertex;     ///< The value added to each index
+            lov_uint baseInstance;  ///< The first instance for instanced attributes
+        };
+
+        static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(lov_uint), "DrawElementsIndirectCommand must be tightly packed");
+
+        /// @brief A list of indexed draw commands mirrored into an OpenGL indirect buffer
+        class DrawIndirectBuffer {
+        public:
+            /// @brief Generate the OpenGL buffer for this DrawIndirectBuffer
+            DrawIndirectBuffer();
+
+            /// @brief Deallocate this DrawIndirectBuffer
+            ~DrawIndirectBuffer();
+
+            DrawIndirectBuffer(const DrawIndirectBuffer&) = delete;
+            DrawIndirectBuffer& operator=(const DrawIndirectBuffer&) = delete;
+
+            /// @brief Bind this DrawIndirectBuffer to GL_DRAW_INDIRECT_BUFFER
+            void bind() const;
+
+            /// @brief Unbind this DrawIndirectBuffer
+            void unbind() const;
+
+            /// @brief Append a command to the CPU side command list
+            /// @param command The command to append
+            /// @return The index of the command
+            lov_uint add(const DrawElementsIndirectCommand& command);
+
+            /// @brief Append commands to the CPU side command list, such as ones recorded on another thread
+            /// @param commands The commands to append
+            /// @return The index of the first command
+            lov_uint add(std::span<const DrawElementsIndirectCommand> commands);
+
+            /// @brief Remove every command from the CPU side command list, keeping its storage
+            void clear();
+
+            /// @brief Copy the CPU side command list into the OpenGL buffer, growing it if needed
+            void upload();
+
+            /// @brief Grow the OpenGL buffer to hold the given number of commands without uploading, so the GPU can write them
+            /// @param commandCount The number of commands to hold
+            void reserve(lov_size commandCount);
+
+            /// @brief Draw the uploaded commands as indexed triangles with unsigned int indices. Bind the VertexArray beforehand
+            ///
+            /// Uses one glMultiDrawElementsIndirect call when the context supports it, otherwise loops over the commands with
+            /// glDrawElementsIndirect, or with glDrawElementsInstancedBaseVertex on contexts without indirect draws
+            void draw() const;
+
+            /// @brief Draw a range of commands, which may have been written by the GPU
+            /// @param first The index of the first command
+            /// @param commandCount The number of commands
+            void draw(lov_size first, lov_size commandCount) const;
+
+            /// @brief Get the CPU side command list
+            /// @return The commands
+            const std::vector<DrawElementsIndirectCommand>& getCommands() const;
+
+            /// @brief Get the number of commands in the CPU side command list
+            /// @return The command count
+            lov_size getCommandCount() const;
+
+            /// @brief Get the OpenGL ID of this buffer, to bind it as a shader storage buffer
+            /// @return The ID of this buffer
+            lov_uint getID() const;
+
+        private:
+            lov_uint m_id;                                      ///< ID of this DrawIndirectBuffer
+            lov_size m_capacity;                                ///< Number of commands the OpenGL buffer can hold
+            std::vector<DrawElementsIndirectCommand> m_commands;///< CPU side command list
+        };
+    }
+}
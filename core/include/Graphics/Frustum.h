@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/Transform.h"
+#include "System/Vector.h"
+
+/// @file Frustum.h
+/// @brief Defines the #lov::Graphics::Frustum used to cull geometry outside of a camera's view
+
+namespace lov {
+    namespace Graphics {
+        /// @brief The six clip planes of a view projection, stored as (normal, distance) with normals facing inward
+        class Frustum {
+        public:
+            /// @brief Indices of the planes of this Frustum
+            enum Plane {
+                PLANE_LEFT      = 0,
+                PLANE_RIGHT     = 1,
+                PLANE_BOTTOM    = 2,
+                PLANE_TOP       = 3,
+                PLANE_NEAR      = 4,
+                PLANE_FAR       = 5
+            };
+
+            /// @brief Construct a Frustum that contains everything
+            Frustum();
+
+            /// @brief Extract the planes of the given view projection transform
+            /// @param viewProjection The product of the projection and view transforms
+            explicit Frustum(const Transform& viewProjection);
+
+            /// @brief Does the given bounding box intersect or lie inside this Frustum?
+            /// @param box The box to test
+            /// @return Whether any part of the box may be visible
+            bool intersects(const BoundingBox& box) const;
+
+            /// @brief Does the given sphere intersect or lie inside this Frustum?
+            /// @param center The center of the sphere
+            /// @param radius The radius of the sphere
+            /// @return Whether any part of the sphere may be visible
+            bool intersects(const Vector3f& center, float radius) const;
+
+            /// @brief Get a plane of this Frustum
+            /// @param plane The plane to get
+            /// @return The normalized plane as (normal.xyz, distance)
+            const Vector4f& getPlane(Plane plane) const;
+
+        private:
+            Vector4f m_planes[6]; ///< The normalized planes of this Frustum
+        };
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <glad/glad.h>
+
+/// @file GLExtensions.h
+/// @brief Loads OpenGL entry points newer than the 3.3 core profile generated by GLAD, when the context provides them
+
+// OpenGL 4.0 indirect draws
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+// OpenGL 4.3 compute shaders and shader storage buffers
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+
+#ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#endif
+
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+
+#ifndef GL_BUFFER_UPDATE_BARRIER_BIT
+#define GL_BUFFER_UPDATE_BARRIER_BIT 0x00000200
+#endif
+
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+
+// OpenGL 4.3 conservative occlusion queries
+#ifndef GL_ANY_SAMPLES_PASSED_CONSERVATIVE
+#define GL_ANY_SAMPLES_PASSED_CONSERVATIVE 0x8D6A
+#endif
+
+// EXT_texture_compression_s3tc and EXT_texture_sRGB block compressed formats
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+// OpenGL 4.2 BPTC block compressed formats
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+#ifndef GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+
+// OpenGL 4.3 ETC2 and EAC block compressed formats
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+
+#ifndef GL_COMPRESSED_SRGB8_ETC2
+#define GL_COMPRESSED_SRGB8_ETC2 0x9275
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#ifndef GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+#define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+#endif
+
+typedef void (APIENTRYP LOVPFNGLDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect);
+typedef void (APIENTRYP LOVPFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+typedef void (APIENTRYP LOVPFNGLTEXSTORAGE2DPROC)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRYP LOVPFNGLTEXSTORAGE3DPROC)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
+
+typedef void (APIENTRYP LOVPFNGLDISPATCHCOMPUTEPROC)(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+typedef void (APIENTRYP LOVPFNGLMEMORYBARRIERPROC)(GLbitfield barriers);
+
+extern LOVPFNGLDRAWELEMENTSINDIRECTPROC lov_glDrawElementsIndirect;
+extern LOVPFNGLMULTIDRAWELEMENTSINDIRECTPROC lov_glMultiDrawElementsIndirect;
+
+extern LOVPFNGLTEXSTORAGE2DPROC lov_glTexStorage2D;
+extern LOVPFNGLTEXSTORAGE3DPROC lov_glTexStorage3D;
+
+extern LOVPFNGLDISPATCHCOMPUTEPROC lov_glDispatchCompute;
+extern LOVPFNGLMEMORYBARRIERPROC lov_glMemoryBarrier;
+
+#define glDrawElementsIndirect lov_glDrawElementsIndirect
+#define glMultiDrawElementsIndirect lov_glMultiDrawElementsIndirect
+#define glTexStorage2D lov_glTexStorage2D
+#define glTexStorage3D lov_glTexStorage3D
+#define glDispatchCompute lov_glDispatchCompute
+#define glMemoryBarrier lov_glMemoryBarrier
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Runtime queries for the version and extensions of the current OpenGL context
+        namespace GLExtensions {
+            /// @brief Load the entry points declared in GLExtensions.h. Call once after GLAD has loaded
+            /// @param loader The function used to look up OpenGL entry points, such as glfwGetProcAddress
+            void load(GLADloadproc loader);
+
+            /// @brief Is the current context at least the given version?
+            /// @param major The required major version
+            /// @param minor The required minor version
+            /// @return Whether the context version is at least major.minor
+            bool hasVersion(int major, int minor);
+
+            /// @brief Does the current context advertise the given extension?
+            /// @param name The extension name, such as "GL_ARB_multi_draw_indirect"
+            /// @return Whether the extension is supported
+            bool hasExtension(const char* name);
+
+            /// @brief Can draws be sourced from a GL_DRAW_INDIRECT_BUFFER (OpenGL 4.0 or ARB_draw_indirect)?
+            /// @return Whether glDrawElementsIndirect is available
+            bool hasDrawIndirect();
+
+            /// @brief Can many indirect draws be submitted in one call (OpenGL 4.3 or ARB_multi_draw_indirect)?
+            /// @return Whether glMultiDrawElementsIndirect is available
+            bool hasMultiDrawIndirect();
+
+            /// @brief Can textures be allocated with immutable storage (OpenGL 4.2 or ARB_texture_storage)?
+            /// @return Whether glTexStorage2D and glTexStorage3D are available
+            bool hasTextureStorage();
+
+            /// @brief Can compute shaders read and write shader storage buffers (OpenGL 4.3 or ARB_compute_shader with ARB_shader_storage_buffer_object)?
+            /// @return Whether glDispatchCompute and shader storage buffers are available
+            bool hasComputeShaders();
+
+            /// @brief Can occlusion queries use GL_ANY_SAMPLES_PASSED_CONSERVATIVE (OpenGL 4.3 or ARB_ES3_compatibility)?
+            /// @return Whether conservative occlusion queries are available
+            bool hasConservativeOcclusionQueries();
+
+            /// @brief Can textures be uploaded in the given block compressed format?
+            ///
+            /// S3TC needs EXT_texture_compression_s3tc (and EXT_texture_sRGB for its sRGB variants), RGTC OpenGL 3.0,
+            /// BPTC OpenGL 4.2 or ARB_texture_compression_bptc, and ETC2 OpenGL 4.3 or ARB_ES3_compatibility
+            /// @param internalFormat The compressed internal format, such as GL_COMPRESSED_RGBA_BPTC_UNORM
+            /// @return Whether glCompressedTexImage2D accepts the format
+            bool hasCompressedFormat(GLenum internalFormat);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/DrawIndirectBuffer.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/Transform.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file InstanceCulling.h
+/// @brief Defines per-instance culling data shared with the GPU and the CPU reference implementation of the culling shader
+
+namespace lov {
+    namespace Graphics {
+        /// @brief One instance to cull, laid out to match the std430 CullInstance struct in cull.comp
+        struct CullInstance {
+            Transform model;        ///< The model transform of the instance
+            Vector4f center;        ///< The model space center of the instance's bounds, w unused
+            Vector4f extents;       ///< The model space half size of the instance's bounds, w unused
+            lov_uint command;       ///< The index of the draw command that renders this instance
+            lov_uint padding[3];    ///< Pads the struct to its std430 array stride
+        };
+
+        static_assert(sizeof(CullInstance) == 112, "CullInstance must match the std430 layout of cull.comp");
+
+        /// @brief CPU implementation of the GPU culling stage, used to validate it and on contexts without compute shaders
+        namespace InstanceCulling {
+            /// @brief Is the given instance inside the frustum and, if a pyramid is given, not hidden behind it?
+            /// @param instance The instance to test
+            /// @param frustum The frustum of viewProjection
+            /// @param viewProjection The product of the projection and view transforms
+            /// @param pyramid The optional depth pyramid to test occlusion against
+            /// @return Whether the instance may be visible
+            bool isVisible(const CullInstance& instance, const Frustum& frustum, const Transform& viewProjection, const DepthPyramid* pyramid);
+
+            /// @brief Cull every instance, writing the visible ones into the commands the same way the culling shader does
+            /// @param instances The instances to cull
+            /// @param draws One command per mesh, with baseInstance set to the start of its range in visible
+            /// @param viewProjection The product of the projection and view transforms
+            /// @param pyramid The optional depth pyramid to test occlusion against
+            /// @param commands Receives draws with instanceCount set to the number of visible instances
+            /// @param visible Receives the index of each visible instance at its command's baseInstance onward
+            void cull(const std::vector<CullInstance>& instances, const std::vector<DrawElementsIndirectCommand>& draws,
+                const Transform& viewProjection, const DepthPyramid* pyramid,
+                std::vector<DrawElementsIndirectCommand>& commands, std::vector<lov_uint>& visible);
+        }
+    }
+}
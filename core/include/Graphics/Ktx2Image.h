@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "System/Types.h"
+
+/// @file Ktx2Image.h
+/// @brief Defines the #lov::Graphics::Ktx2Image that reads and writes block compressed textures in the KTX2 container
+
+namespace lov {
+    namespace Graphics {
+        /// @brief A 2D texture and its mip chain in a block compressed format, as stored in a KTX2 file
+        ///
+        /// Only what the engine bakes is supported: a single layer and face, no supercompression, and the BC1, BC3, BC5,
+        /// BC7 and ETC2 formats. Rows are stored bottom first, matching OpenGL, which the file records as the "ru"
+        /// KTXorientation so other tools display it the right way up.
+        class Ktx2Image {
+        public:
+            /// @brief The Vulkan formats a Ktx2Image can hold. KTX2 identifies formats by these values
+            enum Format : lov_uint {
+                BC1_RGB_UNORM = 131,        ///< Opaque colour, 8 bytes per block
+                BC1_RGB_SRGB = 132,         ///< Opaque sRGB colour, 8 bytes per block
+                BC3_UNORM = 137,            ///< Colour with interpolated alpha, 16 bytes per block
+                BC3_SRGB = 138,             ///< sRGB colour with interpolated alpha, 16 bytes per block
+                BC5_UNORM = 141,            ///< Two independent channels such as a normal map's x and y, 16 bytes per block
+                BC7_UNORM = 145,            ///< High quality colour and alpha, 16 bytes per block
+                BC7_SRGB = 146,             ///< High quality sRGB colour and alpha, 16 bytes per block
+                ETC2_RGB_UNORM = 147,       ///< Opaque colour for mobile GPUs, 8 bytes per block
+                ETC2_RGB_SRGB = 148,        ///< Opaque sRGB colour for mobile GPUs, 8 bytes per block
+                ETC2_RGBA_UNORM = 151,      ///< Colour with EAC alpha for mobile GPUs, 16 bytes per block
+                ETC2_RGBA_SRGB = 152        ///< sRGB colour with EAC alpha for mobile GPUs, 16 bytes per block
+            };
+
+            /// @brief Construct an empty Ktx2Image
+            Ktx2Image();
+
+            /// @brief Construct a Ktx2Image without any levels
+            /// @param format The block compressed format of the levels
+            /// @param width The width of level 0 in pixels
+            /// @param height The height of level 0 in pixels
+            Ktx2Image(Format format, lov_int width, lov_int height);
+
+            /// @brief Parse a KTX2 file held in memory
+            /// @param data The file contents
+            /// @param size The size of the file in bytes
+            /// @return The image
+            /// @throws #lov::Exceptions::TextureException if the file is malformed or uses an unsupported feature
+            static Ktx2Image read(const unsigned char* data, size_t size);
+
+            /// @brief Read and parse a KTX2 file
+            /// @param path The file path
+            /// @return The image
+            /// @throws #lov::Exceptions::TextureException if the file can't be read or parsed
+            static Ktx2Image readFile(const std::string& path);
+
+            /// @brief Does the data start with the KTX2 file identifier?
+            /// @param data The file contents
+            /// @param size The size of the contents in bytes
+            /// @return Whether the data looks like a KTX2 file
+            static bool isKtx2(const unsigned char* data, size_t size);
+
+            /// @brief Serialize this image as a KTX2 file
+            /// @return The file contents
+            std::vector<unsigned char> write() const;
+
+            /// @brief Write this image to a KTX2 file
+            /// @param path The file path
+            /// @throws #lov::Exceptions::TextureException if the file can't be written
+            void writeFile(const std::string& path) const;
+
+            /// @brief Append the next mip level, which must be the size of the previous level halved
+            /// @param blocks The compressed blocks of the level, in rows from the bottom
+            void addLevel(std::vector<unsigned char> blocks);
+
+            /// @brief Get the format of this image
+            /// @return The format
+            Format getFormat() const;
+
+            /// @brief Get the width of level 0
+            /// @return The width in pixels
+            lov_int getWidth() const;
+
+            /// @brief Get the height of level 0
+            /// @return The height in pixels
+            lov_int getHeight() const;
+
+            /// @brief Get the number of mip levels
+            /// @return The level count
+            lov_size getLevelCount() const;
+
+            /// @brief Get the compressed blocks of a mip level
+            /// @param level The level, where 0 is the largest
+            /// @return The blocks
+            const std::vector<unsigned char>& getLevel(lov_size level) const;
+
+            /// @brief Get the total size of every level
+            /// @return The size in bytes
+            size_t getByteSize() const;
+
+            /// @brief Get the OpenGL internal format that matches this image's format
+            /// @return The format to pass to glCompressedTexImage2D
+            lov_uint getGLFormat() const;
+
+            /// @brief Get the size of one 4x4 block of a format
+            /// @param format The format
+            /// @return 8 or 16 bytes, or 0 if the format isn't supported
+            static lov_size getBlockSize(lov_uint format);
+
+            /// @brief Get the size of a mip level of a format
+            /// @param format The format
+            /// @param width The width of the level in pixels
+            /// @param height The height of the level in pixels
+            /// @return The size in bytes, counting partial blocks at the edges as whole blocks
+            static size_t getLevelSize(lov_uint format, lov_int width, lov_int height);
+
+        private:
+            Format m_format;                                ///< The format of every level
+            lov_int m_width;                                ///< Width of level 0 in pixels
+            lov_int m_height;                               ///< Height of level 0 in pixels
+            std::vector<std::vector<unsigned char>> m_levels; ///< Compressed blocks of each level, largest first
+        };
+    }
+}
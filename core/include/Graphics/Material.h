@@ -7,10 +7,22 @@
 
 namespace lov {
     namespace Graphics {
+        /// @brief The surface of an object, whose maps are layers of a #lov::Graphics::TextureArray
+        ///
+        /// Objects whose materials share a texture array only differ in per-vertex layers and shininess, so they can be
+        /// batched into the same draw.
         struct Material {
-            lov_uint diffuseMapID; ///< ID of a diffuse map texture for this material
-            lov_uint specularMapID; ///< ID of a specular map texture for this material
+            lov_uint textureArrayID; ///< ID of the texture array holding this material's maps
+            lov_int diffuseLayer; ///< Layer of the diffuse map in the texture array
+            lov_int specularLayer; ///< Layer of the specular map in the texture array
             float shininess; ///< Shininess of this material
         };
+
+        /// @brief The parts of a #lov::Graphics::Material that vary between objects in one batch, stored per vertex
+        struct MaterialVertex {
+            lov_int diffuseLayer;   ///< Diffuse layer at attribute location 4, with the specular layer
+            lov_int specularLayer;  ///< Specular layer, read with the diffuse layer as an ivec2
+            float shininess;        ///< Shininess at attribute location 5
+        };
     }
 }
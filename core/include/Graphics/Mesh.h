@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file Mesh.h
+/// @brief Defines the CPU side vertex layout and mesh data shared by the renderer and loaders
+
+namespace lov {
+    namespace Graphics {
+        /// @brief The interleaved vertex layout used by the engine's shaders
+        struct Vertex {
+            Vector3f position;  ///< Position at attribute location 0
+            Vector3f normal;    ///< Normal at attribute location 1
+            Vector2f texCoords; ///< Texture coordinates at attribute location 2
+        };
+
+        /// @brief Indexed triangle geometry held in CPU memory
+        struct MeshData {
+            std::vector<Vertex> vertices;   ///< The vertices of this mesh
+            std::vector<lov_uint> indices;  ///< Triangle list indices into vertices
+
+            /// @brief Build a mesh from a non-indexed array of interleaved position, normal and texture coordinate floats
+            /// @param data The interleaved floats, 8 per vertex
+            /// @param vertexCount The number of vertices in data
+            /// @return The mesh with one index per vertex
+            static MeshData fromInterleaved(const float* data, lov_size vertexCount);
+
+            /// @brief Calculate the bounds of the vertex positions of this mesh
+            /// @return The bounding box of this mesh
+            BoundingBox calculateBounds() const;
+        };
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Graphics/Mesh.h"
+#include "System/Types.h"
+
+/// @file MeshCache.h
+/// @brief Defines the #lov::Graphics::MeshCache binary format that meshes are loaded from without parsing
+
+namespace lov {
+    namespace Graphics {
+        /// @brief A view of cached mesh data, pointing straight into the cache's bytes
+        struct MeshView {
+            std::span<const Vertex> vertices;   ///< The vertices, in the layout of #lov::Graphics::Vertex
+            std::span<const lov_uint> indices;  ///< Triangle list indices into vertices
+        };
+
+        /// @brief Reads and writes meshes as their vertex and index arrays, exactly as they are in memory
+        ///
+        /// A cache is a #HEADER_SIZE byte header followed by the vertices and then the indices, so loading one is a
+        /// single read into the mesh's arrays, and a cache inside a memory mapped #lov::System::AssetPack can be viewed
+        /// and buffered without copying at all. Caches are in the byte order of the machine that wrote them, and are
+        /// rejected rather than misread anywhere the byte order or the layout of #lov::Graphics::Vertex differs.
+        class MeshCache {
+        public:
+            /// @brief Size of the header before the vertices
+            static constexpr size_t HEADER_SIZE = 32;
+
+            /// @brief Write a mesh into a cache in memory
+            /// @param mesh The mesh
+            /// @return The cache bytes
+            static std::vector<std::byte> serialize(const MeshData& mesh);
+
+            /// @brief View the arrays of a cache in memory without copying them
+            /// @param cache The cache bytes, aligned to at least 4 bytes, which must outlive the view
+            /// @return The view
+            /// @throws #lov::Exceptions::MeshException if the bytes aren't a valid cache or are misaligned
+            static MeshView view(std::span<const std::byte> cache);
+
+            /// @brief Copy the arrays of a cache in memory into a mesh
+            /// @param cache The cache bytes
+            /// @return The mesh
+            /// @throws #lov::Exceptions::MeshException if the bytes aren't a valid cache
+            static MeshData read(std::span<const std::byte> cache);
+
+            /// @brief Load a cache file, reading its arrays straight into the mesh
+            /// @param path The file path of the cache
+            /// @return The mesh
+            /// @throws #lov::Exceptions::IOException if the file can't be read
+            /// @throws #lov::Exceptions::MeshException if it isn't a valid cache
+            static MeshData load(const std::string& path);
+
+            /// @brief Write a mesh to a cache file
+            /// @param mesh The mesh
+            /// @param path The file path of the cache
+            /// @throws #lov::Exceptions::IOException if the file can't be written
+            static void write(const MeshData& mesh, const std::string& path);
+
+        private:
+            /// @brief Check a cache header and the size it implies
+            /// @param header The first #HEADER_SIZE bytes of the cache
+            /// @param size The size of the whole cache
+            /// @param vertexCount Set to the number of vertices
+            /// @param indexCount Set to the number of indices
+            /// @throws #lov::Exceptions::MeshException if the header is invalid or doesn't match the size
+            static void readHeader(const std::byte* header, size_t size, size_t& vertexCount, size_t& indexCount);
+        };
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "Graphics/Mesh.h"
+#include "System/ThreadPool.h"
+#include "System/Types.h"
+
+/// @file MeshLoader.h
+/// @brief Defines the #lov::Graphics::MeshLoader that parses OBJ and binary glTF models on a thread pool
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Loads models into #lov::Graphics::MeshData, ready to buffer into a VertexBuffer and ElementBuffer
+        ///
+        /// OBJ text is split into chunks at line breaks that are parsed in parallel, then vertices sharing a position,
+        /// texture coordinate and normal are welded into one. Binary glTF 2.0 (.glb) primitives of the default scene are
+        /// converted in parallel with their node transforms applied. Either way the result is one indexed triangle list,
+        /// with normals calculated where the model has none. #loadCached keeps a #lov::Graphics::MeshCache next to the
+        /// model so later loads skip parsing altogether.
+        class MeshLoader {
+        public:
+            /// @brief Construct a MeshLoader
+            /// @param pool The pool models are parsed on, which must outlive this MeshLoader
+            explicit MeshLoader(System::ThreadPool& pool);
+
+            /// @brief Load a model file, choosing the parser by its extension
+            /// @param path The file path of a .obj or .glb model
+            /// @return The mesh
+            /// @throws #lov::Exceptions::IOException if the file can't be read
+            /// @throws #lov::Exceptions::MeshException if the extension isn't supported or the model is malformed
+            MeshData load(const std::string& path) const;
+
+            /// @brief Load a model from its cache if the cache is newer, otherwise parse it and write the cache
+            /// @param path The file path of a .obj or .glb model
+            /// @param cachePath The file path of its #lov::Graphics::MeshCache
+            /// @return The mesh
+            /// @throws #lov::Exceptions::IOException if the model can't be read or the cache can't be written
+            /// @throws #lov::Exceptions::MeshException if the extension isn't supported or the model is malformed
+            MeshData loadCached(const std::string& path, const std::string& cachePath) const;
+
+            /// @brief Parse Wavefront OBJ text. Faces with more than 3 vertices are triangulated as fans
+            /// @param text The text, such as an #lov::System::AssetPack view
+            /// @return The mesh
+            /// @throws #lov::Exceptions::MeshException naming the line of a malformed statement or out of range index
+            MeshData loadObj(std::span<const std::byte> text) const;
+
+            /// @brief Parse binary glTF 2.0. Only triangle list primitives with float positions and normals are supported
+            /// @param data The .glb bytes, whose buffer must be embedded
+            /// @return Every triangle primitive of the default scene, in world space
+            /// @throws #lov::Exceptions::MeshException if the file is malformed or uses anything unsupported
+            MeshData loadGlb(std::span<const std::byte> data) const;
+
+        private:
+            System::ThreadPool& m_pool; ///< Parses chunks and primitives
+        };
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "System/Types.h"
+
+/// @file MipResidency.h
+/// @brief Defines the #lov::Graphics::MipResidency bookkeeping that decides which mip levels of streamed textures stay resident
+
+namespace lov {
+    namespace Graphics {
+        /// @brief A level to free, after which sampling is clamped to the next coarser level
+        struct MipEviction {
+            lov_uint texture;   ///< The texture
+            lov_int level;      ///< The level to free
+        };
+
+        /// @brief A range of levels to read
+        struct MipLoad {
+            lov_uint texture;   ///< The texture
+            lov_int firstLevel; ///< The finest level
+            lov_int lastLevel;  ///< The coarsest level
+        };
+
+        /// @brief What a frame's #lov::Graphics::MipResidency::update decided, in the order it was decided
+        struct MipPlan {
+            std::vector<MipEviction> evictions; ///< Levels to free, before any of the loads are read
+            std::vector<MipLoad> loads;         ///< Levels to read, each counted as pending until uploaded or failed
+        };
+
+        /// @brief Tracks the resident, wanted and loading mip levels of streamed textures and decides what to free and read
+        ///
+        /// This is the part of #lov::Graphics::TextureStreamer that doesn't touch OpenGL. Each texture's finest resident
+        /// level is also its GL_TEXTURE_BASE_LEVEL, so it is always complete. Levels finer than a texture wants are freed
+        /// least recently wanted first when the resident and pending levels exceed the budget, and the tail is never freed.
+        class MipResidency {
+        public:
+            /// @brief Construct an empty MipResidency
+            /// @param budgetBytes The GPU memory resident and pending levels may use
+            explicit MipResidency(size_t budgetBytes);
+
+            /// @brief Add a texture whose tail is being read, so its levels aren't known yet
+            /// @return The index of the texture
+            lov_uint add();
+
+            /// @brief Describe a texture's levels once its tail has been read, before any of them are uploaded
+            /// @param texture The index of the texture
+            /// @param levelSizes Bytes of every level of the chain
+            /// @param tailLevel Finest level of the tail, which is never freed
+            void setLevels(lov_uint texture, std::vector<size_t> levelSizes, lov_int tailLevel);
+
+            /// @brief Have a texture's levels been described yet?
+            /// @param texture The index of the texture
+            /// @return Whether #setLevels has been called for it
+            bool hasLevels(lov_uint texture) const;
+
+            /// @brief Ask for a level of a texture this frame. The finest request of the frame wins
+            /// @param texture The index of the texture
+            /// @param level The finest level needed
+            void request(lov_uint texture, lov_int level);
+
+            /// @brief Count a level as uploaded, making it the finest resident level
+            /// @param texture The index of the texture
+            /// @param level The level
+            /// @param tail Is the level part of the tail, which was never counted as pending?
+            void levelUploaded(lov_uint texture, lov_int level, bool tail);
+
+            /// @brief Mark a texture's load as done after its last level is uploaded
+            /// @param texture The index of the texture
+            void loadFinished(lov_uint texture);
+
+            /// @brief Forget a load that couldn't be read, along with whatever of it was still pending
+            /// @param texture The index of the texture
+            /// @param firstLevel The finest level of the load
+            /// @param tail Was the load the texture's tail?
+            void loadFailed(lov_uint texture, lov_int firstLevel, bool tail);
+
+            /// @brief Resolve this frame's requests into wanted levels, then decide which levels to free and which to read
+            ///
+            /// Missing detail is read biggest shortfall first, freeing unwanted levels to make room and settling for
+            /// coarser levels when even that doesn't fit the budget
+            /// @return The levels to free and read
+            MipPlan update();
+
+            /// @brief Change the GPU memory resident and pending levels may use. Levels over it are freed by the next #update
+            /// @param budgetBytes The new budget
+            void setBudget(size_t budgetBytes);
+
+            /// @brief Get the finest resident level of a texture, which is also the base level sampled
+            /// @param texture The index of the texture
+            /// @return The level, or the level count while nothing is uploaded
+            lov_int getResidentLevel(lov_uint texture) const;
+
+            /// @brief Get the finest level a texture needed as of the last #update
+            /// @param texture The index of the texture
+            /// @return The level, never finer than 0 or coarser than the tail
+            lov_int getWantedLevel(lov_uint texture) const;
+
+            /// @brief Is a read of a texture running or waiting for upload?
+            /// @param texture The index of the texture
+            /// @return Whether it's loading
+            bool isLoading(lov_uint texture) const;
+
+            /// @brief Get the number of textures being read or waiting for upload
+            /// @return The count
+            lov_size getLoadingCount() const;
+
+            /// @brief Get the GPU memory of every resident level
+            /// @return The size in bytes
+            size_t getResidentBytes() const;
+
+            /// @brief Get the GPU memory of levels being read
+            /// @return The size in bytes
+            size_t getPendingBytes() const;
+
+            /// @brief Get the GPU memory every texture would use at the level it wanted as of the last #update
+            /// @return The size in bytes
+            size_t getWantedBytes() const;
+
+        private:
+            /// @brief The levels of a streamed texture
+            struct Entry {
+                std::vector<size_t> levelSizes; ///< Bytes of each level, empty until the tail has been read
+                lov_int tailLevel;              ///< Finest level of the tail
+                lov_int residentLevel;          ///< Finest level that is uploaded
+                lov_int requestedLevel;         ///< Finest level requested this frame, or -1 for none
+                lov_int wantedLevel;            ///< Finest level needed as of the last update
+                lov_uint lastWanted;            ///< Frame the texture last wanted more than its tail
+                bool loading;                   ///< Is a read running or waiting for upload?
+            };
+
+            /// @brief Free levels finer than their texture wants, least recently wanted first, until the resident size fits
+            /// @param budgetBytes The size to fit within
+            /// @param evictions Receives the freed levels
+            void evict(size_t budgetBytes, std::vector<MipEviction>& evictions);
+
+            /// @brief Get the bytes of a range of levels
+            /// @param entry The entry
+            /// @param firstLevel The finest level
+            /// @param lastLevel The coarsest level
+            /// @return The total size
+            static size_t rangeBytes(const Entry& entry, lov_int firstLevel, lov_int lastLevel);
+
+            std::vector<Entry> m_entries;   ///< Every streamed texture
+            size_t m_budget;                ///< GPU memory resident and pending levels may use
+            lov_uint m_frame;               ///< Number of updates so far
+            size_t m_residentBytes;         ///< GPU memory of every resident level
+            size_t m_pendingBytes;          ///< GPU memory of levels being read
+            size_t m_wantedBytes;           ///< GPU memory of every texture at its wanted level
+        };
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/ElementBuffer.h"
+#include "Graphics/Shader.h"
+#include "Graphics/Transform.h"
+#include "Graphics/VertexArray.h"
+#include "Graphics/VertexBuffer.h"
+#include "System/Types.h"
+
+/// @file OcclusionQueries.h
+/// @brief Defines the #lov::Graphics::OcclusionQueries that test object bounds against the depth buffer on the GPU
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Issues a bounding box occlusion query per object and uses the results without waiting for them
+        ///
+        /// A frame looks like:
+        /// 1. #beginFrame collects whichever results have arrived since the last frame
+        /// 2. Draw the objects that #wasVisible, which fills the depth buffer with likely occluders
+        /// 3. #issue draws the bounds of every object into queries against that depth buffer
+        /// 4. Draw the remaining objects between #beginConditionalDraw and #endConditionalDraw, so the GPU skips the ones
+        ///    its new query found hidden while newly revealed objects still appear this frame
+        ///
+        /// The CPU never waits on a result. Query objects are created in batches and recycled when objects are removed,
+        /// so steady state frames allocate nothing.
+        class OcclusionQueries {
+        public:
+            /// @brief Construct an empty OcclusionQueries and the unit cube drawn for each query
+            OcclusionQueries();
+
+            /// @brief Deallocate every query object
+            ~OcclusionQueries();
+
+            OcclusionQueries(const OcclusionQueries&) = delete;
+            OcclusionQueries& operator=(const OcclusionQueries&) = delete;
+
+            /// @brief Compile the shader used to draw the bounds
+            /// @param vertexShaderPath Path to bounds.vs
+            /// @param fragmentShaderPath Path to bounds.fs
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compile(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
+
+            /// @brief Compile the shader used to draw the bounds from source held in memory
+            /// @param vertexShaderSource Source of bounds.vs
+            /// @param fragmentShaderSource Source of bounds.fs
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compile(std::span<const std::byte> vertexShaderSource, std::span<const std::byte> fragmentShaderSource);
+
+            /// @brief Add an object to query, which counts as visible until its first result arrives
+            /// @param bounds The world space bounds of the object
+            /// @return The id of the object
+            lov_uint addObject(const BoundingBox& bounds);
+
+            /// @brief Remove an object, returning its query to the pool
+            /// @param id The id returned by #addObject
+            void removeObject(lov_uint id);
+
+            /// @brief Update the bounds of a moving object
+            /// @param id The id of the object
+            /// @param bounds The new world space bounds
+            void setBounds(lov_uint id, const BoundingBox& bounds);
+
+            /// @brief Collect every result that is already available, without waiting for the rest
+            void beginFrame();
+
+            /// @brief Query the bounds of every object without a query in flight against the current depth buffer
+            ///
+            /// Colour and depth writes are disabled and the depth function is GL_LEQUAL while the bounds are drawn, then the
+            /// defaults are restored. Objects whose bounds cross the near plane are not queried, since their clipped boxes
+            /// could report them hidden, so their conditional draws always go ahead
+            /// @param viewProjection The product of the projection and view transforms
+            void issue(const Transform& viewProjection);
+
+            /// @brief Was the object visible according to its latest available result?
+            /// @param id The id of the object
+            /// @return Whether the object should be drawn before #issue
+            bool wasVisible(lov_uint id) const;
+
+            /// @brief Start skipping draws if the object's query in flight finds it hidden
+            /// @param id The id of the object
+            void beginConditionalDraw(lov_uint id) const;
+
+            /// @brief Stop the conditional rendering started by #beginConditionalDraw
+            /// @param id The id of the object
+            void endConditionalDraw(lov_uint id) const;
+
+            /// @brief Get the query target used for every query
+            /// @return GL_ANY_SAMPLES_PASSED_CONSERVATIVE where supported, otherwise GL_ANY_SAMPLES_PASSED
+            lov_uint getTarget() const;
+
+            /// @brief Get the number of query objects created so far
+            /// @return The size of the pool
+            lov_size getQueryCount() const;
+
+        private:
+            /// @brief An object tracked by this OcclusionQueries
+            struct Object {
+                BoundingBox bounds;     ///< World space bounds of the object
+                lov_uint query;         ///< The object's query, reused every time it is issued
+                bool inFlight;          ///< Has the query been issued without its result being read?
+                bool visible;           ///< The latest result
+                bool active;            ///< Is this slot in use?
+            };
+
+            /// @brief Take a query from the pool, creating a batch if it is empty
+            /// @return The query object
+            lov_uint acquireQuery();
+
+            Shader m_shader;                    ///< Draws the bounds
+            VertexArray m_vao;                  ///< Unit cube vertex array
+            VertexBuffer m_vbo;                 ///< Unit cube corners
+            ElementBuffer m_ebo;                ///< Unit cube triangles
+            lov_uint m_target;                  ///< The query target
+
+            std::vector<Object> m_objects;      ///< Object slots indexed by id
+            std::vector<lov_uint> m_freeObjects;///< Ids of removed objects
+            std::vector<lov_uint> m_queries;    ///< Every query object created
+            std::vector<lov_uint> m_freeQueries;///< Query objects not owned by an object
+        };
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/Transform.h"
+#include "System/ThreadPool.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file OcclusionRasterizer.h
+/// @brief Defines the #lov::Graphics::OcclusionRasterizer that culls bounding boxes against occluders drawn on the CPU
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Rasterizes a few occluder meshes into a small depth buffer on the CPU and tests bounding boxes against it
+        ///
+        /// The screen is split into tiles that worker threads fill in parallel, four pixels at a time with SSE when available.
+        /// A pixel is covered when its center is inside a triangle, so the results do not depend on the tiling or SIMD width.
+        /// Triangles crossing the near plane are skipped, which can only let more objects through.
+        /// The finished buffer is reduced into a min/max #lov::Graphics::DepthPyramid so most boxes are decided at a coarse level.
+        class OcclusionRasterizer {
+        public:
+            static constexpr lov_size TILE_WIDTH = 32;  ///< Width of a tile in pixels
+            static constexpr lov_size TILE_HEIGHT = 16; ///< Height of a tile in pixels
+
+            /// @brief Construct an OcclusionRasterizer with the given depth buffer resolution
+            /// @param width The width of the depth buffer in pixels
+            /// @param height The height of the depth buffer in pixels
+            /// @param pool The pool used to rasterize tiles and test boxes, or null to run on the calling thread
+            OcclusionRasterizer(lov_size width, lov_size height, System::ThreadPool* pool = nullptr);
+
+            /// @brief Was the rasterizer compiled with SIMD support?
+            /// @return Whether the SSE path is used
+            static bool hasSimd();
+
+            /// @brief Forget the last frame's occluders and start a new frame
+            /// @param viewProjection The product of the projection and view transforms
+            void beginFrame(const Transform& viewProjection);
+
+            /// @brief Add an occluder to the frame. The mesh must outlive #rasterize
+            /// @param mesh The occluder geometry, ideally a few simple triangles that sit inside the rendered mesh
+            /// @param model The model transform of the occluder
+            void addOccluder(const MeshData& mesh, const Transform& model);
+
+            /// @brief Rasterize every occluder of the frame and build the depth hierarchy
+            void rasterize();
+
+            /// @brief Might any part of a box be visible past the occluders?
+            ///
+            /// Boxes crossing the near plane or lying off the screen are reported visible and left to frustum culling
+            /// @param bounds The world space bounds to test
+            /// @return Whether the box is not hidden behind every pixel it touches
+            bool isVisible(const BoundingBox& bounds) const;
+
+            /// @brief Test many boxes in parallel
+            /// @param bounds The world space bounds to test
+            /// @param visible Receives the indices of the visible boxes in increasing order
+            void cull(const std::vector<BoundingBox>& bounds, std::vector<lov_uint>& visible) const;
+
+            /// @brief Get the width of the depth buffer
+            /// @return The width in pixels
+            lov_size getWidth() const;
+
+            /// @brief Get the height of the depth buffer
+            /// @return The height in pixels
+            lov_size getHeight() const;
+
+            /// @brief Get the number of triangles rasterized by the last #rasterize
+            /// @return The triangle count
+            lov_size getTriangleCount() const;
+
+            /// @brief Get the depth buffer written by the last #rasterize
+            /// @return Window depths in row order from the bottom row, 1 where nothing was drawn
+            const std::vector<float>& getDepthBuffer() const;
+
+            /// @brief Get the depth hierarchy built by the last #rasterize
+            /// @return The pyramid, which can also be given to #lov::Graphics::ComputeCuller
+            const DepthPyramid& getPyramid() const;
+
+        private:
+            /// @brief An occluder added to the current frame
+            struct Occluder {
+                const MeshData* mesh;   ///< The occluder geometry
+                Transform model;        ///< The model transform of the occluder
+            };
+
+            /// @brief A screen space triangle ready to rasterize
+            ///
+            /// Edge i is positive inside the triangle and evaluates as edgeA[i] * x + (edgeB[i] * y + edgeC[i])
+            struct Triangle {
+                float edgeA[3];     ///< x coefficients of the edge functions
+                float edgeB[3];     ///< y coefficients of the edge functions
+                float edgeC[3];     ///< Constants of the edge functions
+                float depthA;       ///< x coefficient of the depth plane
+                float depthB;       ///< y coefficient of the depth plane
+                float depthC;       ///< Constant of the depth plane
+                lov_int minX;       ///< First pixel column that may be covered
+                lov_int minY;       ///< First pixel row that may be covered
+                lov_int maxX;       ///< Last pixel column that may be covered
+                lov_int maxY;       ///< Last pixel row that may be covered
+            };
+
+            /// @brief Run a body over [0, count) on the pool if there is one
+            /// @param count The number of items
+            /// @param body Called with [begin, end) ranges
+            void forEach(lov_size count, const std::function<void(lov_size begin, lov_size end)>& body) const;
+
+            /// @brief Transform a range of vertices to screen space
+            /// @param mesh The mesh holding the vertices
+            /// @param modelViewProjection The transform to clip space
+            /// @param begin The first vertex
+            /// @param end One past the last vertex
+            void transformVertices(const MeshData& mesh, const Transform& modelViewProjection, lov_size begin, lov_size end);
+
+            /// @brief Set up a triangle from three screen space vertices
+            /// @param v0 The first vertex, with w set to 1 if it is in front of the near plane
+            /// @param v1 The second vertex
+            /// @param v2 The third vertex
+            /// @param triangle Receives the edge functions, depth plane and pixel bounds
+            /// @return Whether the triangle covers any pixel centers and can be drawn
+            bool setupTriangle(const Vector4f& v0, const Vector4f& v1, const Vector4f& v2, Triangle& triangle) const;
+
+            /// @brief Rasterize every triangle binned to a tile
+            /// @param tile The index of the tile
+            void rasterizeTile(lov_size tile);
+
+            lov_size m_width;                           ///< Width of the depth buffer
+            lov_size m_height;                          ///< Height of the depth buffer
+            lov_size m_tilesX;                          ///< Number of tile columns
+            lov_size m_tilesY;                          ///< Number of tile rows
+            System::ThreadPool* m_pool;                 ///< Pool used for tiles and box tests, may be null
+
+            Transform m_viewProjection;                 ///< The view projection of the frame
+            std::vector<Occluder> m_occluders;          ///< Occluders of the frame
+            std::vector<Vector4f> m_screenVertices;     ///< Screen x, y, window depth and a valid flag of the current occluder's vertices
+            std::vector<Triangle> m_triangles;          ///< Triangles of the frame
+            std::vector<std::vector<lov_uint>> m_bins;  ///< Indices of the triangles overlapping each tile
+
+            std::vector<float> m_depth;                 ///< The depth buffer
+            DepthPyramid m_pyramid;                     ///< Min/max hierarchy of the depth buffer
+        };
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Graphics/CommandBuffer.h"
+#include "Graphics/DrawIndirectBuffer.h"
+#include "Graphics/Transform.h"
+#include "Graphics/Window.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file RenderThread.h
+/// @brief Defines the #lov::Graphics::RenderThread that submits OpenGL work while the next frame is simulated
+
+namespace lov {
+    namespace Graphics {
+        /// @brief An asset to stream in for a frame, since only the thread owning the context can upload it
+        struct FrameAssetRequest {
+            lov_uint asset;     ///< The ID from #lov::System::AssetStreamer::add
+            float distance;     ///< Its distance from the camera
+        };
+
+        /// @brief Everything the render thread needs to draw a frame, built by the simulation thread and read only once submitted
+        struct FramePacket {
+            /// @brief Empty the lists of this packet, keeping their storage for the next frame
+            void clear();
+
+            lov_uint frame;                                     ///< Number of the frame, counting from 0
+            Transform view;                                     ///< The camera's view transform
+            Transform projection;                               ///< The camera's projection transform
+            Vector3f cameraPosition;                            ///< The camera's position
+            Vector3f cameraFront;                               ///< The direction the camera faces
+            std::vector<DrawElementsIndirectCommand> commands;  ///< Visible draws of every batch, one batch after another
+            std::vector<lov_size> batchStarts;                  ///< Index of each batch's first command, then the command count
+            CommandBuffer draws;                                ///< Objects drawn one at a time, for a #lov::Graphics::CommandQueue to replay
+            std::vector<FrameAssetRequest> assetRequests;       ///< Assets the frame wants streamed in
+        };
+
+        /// @brief Timings reported by a #lov::Graphics::RenderThread
+        struct RenderThreadStats {
+            lov_uint framesRendered;        ///< Frames rendered and swapped so far
+            double renderMilliseconds;      ///< Time the latest frame spent rendering and swapping
+            double waitMilliseconds;        ///< Time the latest #RenderThread::acquire waited for a free packet
+        };
+
+        /// @brief Owns a window's OpenGL context on a thread of its own, rendering frame packets in the order they're submitted
+        ///
+        /// The simulation thread #acquire s a packet, fills it and #submit s it, then goes on to the next frame while the
+        /// render thread draws this one and swaps buffers, so simulation and driver time overlap instead of adding up.
+        /// There's one packet per frame allowed in the queue plus the one being drawn, so the simulation can get at most
+        /// that many frames ahead before #acquire waits, which bounds the added latency. Keep polling events on the
+        /// thread that created the window.
+        class RenderThread {
+        public:
+            /// @brief Renders one packet, without swapping buffers. Runs on the render thread
+            using RenderFunction = std::function<void(const FramePacket& packet)>;
+
+            /// @brief Take the window's context from the calling thread and start the render thread
+            /// @param window The window, which must outlive this RenderThread
+            /// @param render Draws each packet
+            /// @param maxQueuedFrames The most frames waiting to be drawn, on top of the one being drawn
+            RenderThread(Window& window, RenderFunction render, lov_size maxQueuedFrames = 1);
+
+            /// @brief Draw the frames still queued, stop the render thread and give the context back to the calling thread
+            ~RenderThread();
+
+            RenderThread(const RenderThread&) = delete;
+            RenderThread& operator=(const RenderThread&) = delete;
+
+            /// @brief Get an empty packet to fill, waiting for one to be drawn if every packet is in use
+            /// @return The packet, which is the caller's until #submit
+            /// @throws Anything the render function threw since the last call
+            FramePacket& acquire();
+
+            /// @brief Queue the packet from #acquire to be drawn
+            void submit();
+
+            /// @brief Wait for every submitted frame to be drawn and swapped
+            /// @throws Anything the render function threw since the last call
+            void flush();
+
+            /// @brief Get the timings of this RenderThread
+            /// @return The stats
+            RenderThreadStats getStats() const;
+
+        private:
+            /// @brief Draw packets until stopped
+            void render();
+
+            /// @brief Rethrow what the render function threw, if anything. Call with m_mutex held
+            void rethrow();
+
+            Window& m_window;                                   ///< The window whose context this thread owns
+            RenderFunction m_render;                            ///< Draws each packet
+            std::vector<std::unique_ptr<FramePacket>> m_packets;///< Every packet, reused frame after frame
+            std::vector<FramePacket*> m_free;                   ///< Packets ready to acquire
+            std::deque<FramePacket*> m_queued;                  ///< Packets submitted and not yet drawn
+            FramePacket* m_acquired;                            ///< Packet being filled, or null
+            bool m_drawing;                                     ///< Is the render thread drawing a packet?
+            lov_uint m_nextFrame;                               ///< Number of the next frame acquired
+
+            mutable std::mutex m_mutex;                         ///< Guards everything the two threads share
+            std::condition_variable m_changed;                  ///< Signalled when a packet is queued or drawn, or on stopping
+            bool m_stopping;                                    ///< Has the render thread been asked to stop?
+            std::exception_ptr m_exception;                     ///< What the render function threw, until rethrown
+            RenderThreadStats m_stats;                          ///< Timings reported by getStats
+
+            std::thread m_thread;                               ///< The render thread, started last
+        };
+    }
+}
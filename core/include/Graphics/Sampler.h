@@ -0,0 +1,46 @@
+#pragma once
+
+#include "System/Types.h"
+
+/// @file Sampler.h
+/// @brief Defines the #lov::Graphics::SamplerDesc of texture filtering and wrapping state, and the cache of sampler objects that hold it
+
+namespace lov {
+    namespace Graphics {
+        /// @brief How a texture is filtered and wrapped when sampled
+        struct SamplerDesc {
+            lov_uint minFilter = GL_LINEAR_MIPMAP_LINEAR;   ///< Filter used when minifying
+            lov_uint magFilter = GL_LINEAR;                 ///< Filter used when magnifying
+            lov_uint wrapS = GL_REPEAT;                     ///< Wrapping of the s coordinate
+            lov_uint wrapT = GL_REPEAT;                     ///< Wrapping of the t coordinate
+
+            /// @brief Is this state the same as another?
+            /// @param other The state to compare with
+            /// @return Whether every field matches
+            bool operator==(const SamplerDesc& other) const;
+        };
+
+        /// @brief Sampler objects shared by every texture sampled with the same state
+        ///
+        /// Binding a sampler to a unit overrides the filtering and wrapping of whichever texture is bound there, so textures
+        /// don't each carry that state and the driver doesn't revalidate it when they are rebound. Use from the GL thread only.
+        namespace SamplerCache {
+            /// @brief Get the sampler object for some state, creating it the first time the state is used
+            /// @param desc The state
+            /// @return The ID of the sampler object
+            lov_uint get(const SamplerDesc& desc);
+
+            /// @brief Bind the sampler object for some state to a texture unit
+            /// @param unit The texture unit
+            /// @param desc The state
+            void bind(lov_uint unit, const SamplerDesc& desc);
+
+            /// @brief Get the number of distinct sampler objects created
+            /// @return The size of the cache
+            lov_size getCount();
+
+            /// @brief Delete every sampler object. #lov::Graphics::Window calls this before it destroys its context
+            void clear();
+        }
+    }
+}
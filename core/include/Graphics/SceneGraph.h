@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Graphics/Transform.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file SceneGraph.h
+/// @brief Defines the #lov::Graphics::SceneGraph that keeps nodes' world transforms up to date with their parents'
+
+namespace lov {
+    namespace System {
+        class JobSystem;
+    }
+
+    namespace Graphics {
+        /// @brief A node's transform relative to its parent, applied as scale, then rotation, then translation
+        struct NodeTransform {
+            Vector3f position = Vector3f(0.0f, 0.0f, 0.0f);     ///< Translation from the parent's origin
+            Vector3f rotationAxis = Vector3f(0.0f, 1.0f, 0.0f); ///< Axis to rotate about, which needn't be normalized
+            float rotationAngle = 0.0f;                         ///< Angle to rotate by, in radians
+            Vector3f scale = Vector3f(1.0f, 1.0f, 1.0f);        ///< Scale along each axis
+
+            /// @brief Build the matrix of this NodeTransform
+            /// @return The transform
+            Transform toTransform() const;
+
+            /// @brief Blend between two transforms, such as the states before and after a simulation step
+            ///
+            /// Position, angle and scale are blended linearly, using the axis of the later transform, which is exact
+            /// while the axis doesn't change between the two.
+            /// @param from The earlier transform
+            /// @param to The later transform
+            /// @param alpha How far to blend, from 0 at from to 1 at to
+            /// @return The blended transform
+            static NodeTransform interpolate(const NodeTransform& from, const NodeTransform& to, float alpha);
+        };
+
+        /// @brief Counters from the latest #lov::Graphics::SceneGraph::update
+        struct SceneGraphStats {
+            lov_uint nodes;     ///< Nodes in the graph
+            lov_uint levels;    ///< Depths with at least one node
+            lov_uint updated;   ///< World transforms recomputed
+        };
+
+        /// @brief A hierarchy of nodes whose world transforms are cached and only recomputed when they or a parent change
+        ///
+        /// Nodes are stored in contiguous arrays sorted by depth, so every parent comes before its children and
+        /// #update is one linear sweep, level by level. Nodes of a level only read the level above, so each level can
+        /// be split across a #lov::System::JobSystem. Setting a node's transform marks it dirty; the sweep recomputes
+        /// dirty nodes and the children of nodes it recomputed, and skips levels with neither, so a static scene costs
+        /// nothing after its first update. Nodes are referred to by IDs that stay the same as the arrays are reordered.
+        /// Adding and removing nodes is cheap; the arrays are re-sorted once by the next #update.
+        class SceneGraph {
+        public:
+            /// @brief The parent of root nodes
+            static constexpr lov_uint None = UINT32_MAX;
+
+            /// @brief Construct an empty graph
+            SceneGraph();
+
+            /// @brief Add a node
+            /// @param local Its transform relative to its parent
+            /// @param parent Its parent's ID, or #None for a root node
+            /// @return The node's ID
+            lov_uint add(const NodeTransform& local = NodeTransform(), lov_uint parent = None);
+
+            /// @brief Remove a node and all its descendants. Takes time linear in the size of the graph
+            /// @param node The node's ID, which may be reused by later nodes
+            void remove(lov_uint node);
+
+            /// @brief Set a node's transform relative to its parent, recomputing its world transform in the next #update
+            /// @param node The node's ID
+            /// @param local Its new transform
+            void setLocal(lov_uint node, const NodeTransform& local);
+
+            /// @brief Get a node's transform relative to its parent
+            /// @param node The node's ID
+            /// @return Its transform
+            const NodeTransform& getLocal(lov_uint node) const;
+
+            /// @brief Get a node's world transform, as of the latest #update
+            /// @param node The node's ID
+            /// @return Its world transform
+            const Transform& getWorld(lov_uint node) const;
+
+            /// @brief Get a node's parent
+            /// @param node The node's ID
+            /// @return Its parent's ID, or #None for a root node
+            lov_uint getParent(lov_uint node) const;
+
+            /// @brief Recompute the world transforms of changed nodes and their descendants
+            /// @param jobs Splits large levels across its threads, or null to update on the calling thread
+            void update(System::JobSystem* jobs = nullptr);
+
+            /// @brief Get the counters of the latest #update
+            /// @return The stats
+            SceneGraphStats getStats() const;
+
+        private:
+            /// @brief Sort the nodes by depth, keeping their order within each level
+            void sort();
+
+            /// @brief Recompute the world transforms of a range of one level's nodes that need it
+            /// @param begin The first slot
+            /// @param end One past the last slot
+            /// @return The number recomputed
+            lov_uint sweep(lov_uint begin, lov_uint end);
+
+            /// @brief Mark a node dirty, counting it in its level if it wasn't already
+            /// @param slot The node's slot
+            void markDirty(lov_uint slot);
+
+            // Arrays indexed by slot, sorted by depth after each update
+            std::vector<lov_uint> m_ids;                ///< ID of the node in each slot
+            std::vector<lov_uint> m_parents;            ///< Slot of each node's parent, or None
+            std::vector<lov_uint> m_depths;             ///< Depth of each node, 0 for roots
+            std::vector<NodeTransform> m_locals;        ///< Each node's transform relative to its parent
+            std::vector<Transform> m_worlds;            ///< Each node's cached world transform
+            std::vector<uint8_t> m_dirty;               ///< Has each node's transform been set since it was last swept?
+            std::vector<uint32_t> m_updateFrames;       ///< The update each node's world transform was last recomputed in
+
+            std::vector<lov_uint> m_slots;              ///< Slot of each ID, or None if the ID is free
+            std::vector<lov_uint> m_freeIds;            ///< IDs of removed nodes, to reuse
+            std::vector<lov_uint> m_levelStarts;        ///< First slot of each level, then the node count
+            std::vector<lov_uint> m_levelDirty;         ///< Dirty nodes in each level
+            bool m_sorted;                              ///< Are the slots sorted by depth, and m_levelStarts current?
+            uint32_t m_frame;                           ///< Number of the latest update
+            SceneGraphStats m_stats;                    ///< Counters reported by getStats
+        };
+    }
+}
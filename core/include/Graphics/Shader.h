@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
 #include <string>
 
 #include "Graphics/Transform.h"
@@ -13,6 +15,9 @@ namespace lov {
         /// @brief An OpenGL shader that can be loaded with strings or files
         class Shader {
         public:
+            /// @brief Construct this Shader without a program, see the compile functions
+            Shader();
+
             /// @brief Deallocate resources from this Shader
             ~Shader();
 
@@ -34,6 +39,22 @@ namespace lov {
             /// @throws #lov::Exceptions::ShaderException if compile or linking fails
             void compileFromFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
 
+            /// @brief Load a shader from source held in memory, such as an #lov::System::AssetPack view
+            /// @param vertexShaderSource The source code of the vertex shader, which needn't be null terminated
+            /// @param fragmentShaderSource The source code of the fragment shader, which needn't be null terminated
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compileFromMemory(std::span<const std::byte> vertexShaderSource, std::span<const std::byte> fragmentShaderSource);
+
+            /// @brief Load a compute shader from text. Requires a context with compute shader support
+            /// @param computeShaderSource The source code of the compute shader
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compileComputeFromText(const char* computeShaderSource);
+
+            /// @brief Load a compute shader from a file. Requires a context with compute shader support
+            /// @param computeShaderPath Path to the compute shader source
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compileComputeFromFile(const std::string& computeShaderPath);
+
             /// @brief Undefined but prevents ambiguity with setUniform overloads
             /// @tparam T The type of uniform to set
             /// @param name Name of the uniform
@@ -61,12 +82,34 @@ namespace lov {
             /// @param value Value to set
             void setUniform(const std::string& name, const Vector3f& value);
 
+            /// @brief Set a uniform Vector4f with the given name and value
+            /// @param name Name of the uniform
+            /// @param value Value to set
+            void setUniform(const std::string& name, const Vector4f& value);
+
             /// @brief Set a uniform transform with the given name and value
             /// @param name Name of the uniform
             /// @param value Value to set
             void setUniform(const std::string& name, const Transform& value);
 
+            /// @brief Read a uniform block from the buffer range bound to a binding point, see #lov::Graphics::CommandQueue
+            /// @param name Name of the uniform block
+            /// @param binding The binding point
+            void bindUniformBlock(const std::string& name, lov_uint binding);
+
+            /// @brief Get the OpenGL ID of this shader program
+            /// @return The ID of this shader program
+            lov_uint getID() const;
+
         private:
+            /// @brief Compile and link a vertex and fragment shader
+            /// @param vertexShaderSource The source code of the vertex shader
+            /// @param vertexShaderLength The length of the vertex shader source, or -1 if it's null terminated
+            /// @param fragmentShaderSource The source code of the fragment shader
+            /// @param fragmentShaderLength The length of the fragment shader source, or -1 if it's null terminated
+            /// @throws #lov::Exceptions::ShaderException if compile or linking fails
+            void compile(const char* vertexShaderSource, int vertexShaderLength, const char* fragmentShaderSource, int fragmentShaderLength);
+
             /// @brief ID for this shader program
             lov_uint m_id;
         };
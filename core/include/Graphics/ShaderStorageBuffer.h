@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Graphics/GLExtensions.h"
+#include "System/Types.h"
+
+/// @file ShaderStorageBuffer.h
+/// @brief High level abstraction of OpenGL shader storage buffers
+
+namespace lov {
+    namespace Graphics {
+        /// @brief A shader storage buffer object that compute and vertex shaders can read and write
+        class ShaderStorageBuffer {
+        public:
+            /// @brief Generate the OpenGL buffer for this ShaderStorageBuffer
+            ShaderStorageBuffer();
+
+            /// @brief Deallocate this ShaderStorageBuffer
+            ~ShaderStorageBuffer();
+
+            ShaderStorageBuffer(const ShaderStorageBuffer&) = delete;
+            ShaderStorageBuffer& operator=(const ShaderStorageBuffer&) = delete;
+
+            /// @brief Sends the given data to the OpenGL buffer, replacing its storage
+            /// @tparam T The type of data to buffer
+            /// @param data The data to buffer, or null to allocate uninitialized storage
+            /// @param size The size of the data to buffer
+            template <typename T>
+            inline void bufferData(const T* data, lov_size size) {
+                bind();
+                glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, GL_DYNAMIC_DRAW);
+                m_size = size;
+            }
+
+            /// @brief Bind this ShaderStorageBuffer to GL_SHADER_STORAGE_BUFFER
+            void bind() const;
+
+            /// @brief Unbind this ShaderStorageBuffer
+            void unbind() const;
+
+            /// @brief Bind this ShaderStorageBuffer to the given binding point of the shader's buffer blocks
+            /// @param index The binding point declared with layout(binding = index)
+            void bindBase(lov_uint index) const;
+
+            /// @brief Get the size of the storage of this ShaderStorageBuffer
+            /// @return The size in bytes
+            lov_size getSize() const;
+
+            /// @brief Get the OpenGL ID of this buffer
+            /// @return The ID of this buffer
+            lov_uint getID() const;
+
+        private:
+            lov_uint m_id;      ///< ID of this ShaderStorageBuffer
+            lov_size m_size;    ///< Size of the storage of this ShaderStorageBuffer
+        };
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/DrawIndirectBuffer.h"
+#include "Graphics/ElementBuffer.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/Material.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/Transform.h"
+#include "Graphics/VertexArray.h"
+#include "Graphics/VertexBuffer.h"
+#include "System/Types.h"
+
+/// @file StaticBatcher.h
+/// @brief Defines the #lov::Graphics::StaticBatcher used to merge static geometry into a few large draws
+
+namespace lov {
+    namespace Graphics {
+        /// @brief The range of indices belonging to one object in a baked batch
+        struct StaticBatchRange {
+            lov_uint objectID;      ///< The ID returned when the object was added to the #lov::Graphics::StaticBatcher
+            lov_uint firstIndex;    ///< The offset of the object's first index in the batch
+            lov_uint indexCount;    ///< The number of indices belonging to the object
+            BoundingBox bounds;     ///< The world space bounds of the object
+        };
+
+        /// @brief Baked world space geometry for every object whose material uses one texture array
+        struct StaticBatchData {
+            lov_uint textureArrayID;                ///< The texture array shared by every object in this batch
+            std::vector<Vertex> vertices;           ///< World space vertices of every object
+            std::vector<MaterialVertex> materials;  ///< The material of each vertex, parallel to vertices
+            std::vector<lov_uint> indices;          ///< Indices of every object, offset into the shared vertices
+            std::vector<StaticBatchRange> ranges;   ///< The index range of each object, in index order
+            BoundingBox bounds;                     ///< The world space bounds of the whole batch
+        };
+
+        /// @brief Collects static objects and bakes them into world space batches grouped by material texture array
+        class StaticBatcher {
+        public:
+            /// @brief Add a static object to be baked. The mesh must outlive the call to #bake
+            /// @param mesh The geometry of the object in model space
+            /// @param material The material of the object
+            /// @param model The model transform placing the object in the world
+            /// @return The ID of the object, reported in #lov::Graphics::StaticBatchRange::objectID
+            lov_uint add(const MeshData& mesh, const Material& material, const Transform& model);
+
+            /// @brief Bake every added object into world space, merging objects whose materials share a texture array
+            /// @return One batch per distinct texture array, in the order each was first added
+            std::vector<StaticBatchData> bake() const;
+
+            /// @brief Remove every added object
+            void clear();
+
+            /// @brief Get the number of objects added to this StaticBatcher
+            /// @return The object count
+            lov_size getObjectCount() const;
+
+        private:
+            /// @brief An object waiting to be baked
+            struct Instance {
+                const MeshData* mesh;   ///< The geometry of this object
+                Material material;      ///< The material of this object
+                Transform model;        ///< The model transform of this object
+            };
+
+            std::vector<Instance> m_instances; ///< Every object added to this StaticBatcher
+        };
+
+        /// @brief A baked batch uploaded to a shared VertexBuffer and ElementBuffer
+        class StaticBatch {
+        public:
+            /// @brief Upload the given baked data, leaving the VertexArray unbound
+            /// @param data The baked batch
+            explicit StaticBatch(const StaticBatchData& data);
+
+            StaticBatch(const StaticBatch&) = delete;
+            StaticBatch& operator=(const StaticBatch&) = delete;
+
+            /// @brief Draw every object in this batch with one draw call. Set the model transform to identity beforehand
+            void draw() const;
+
+            /// @brief Draw the objects of this batch that intersect the given frustum, merging neighbouring visible objects into one range
+            /// @param frustum The frustum to cull against
+            /// @return The number of objects drawn
+            lov_size draw(const Frustum& frustum) const;
+
+            /// @brief Append an indirect command for each run of neighbouring objects that intersect the given frustum
+            /// @param frustum The frustum to cull against
+            /// @param commands The command list to append to
+            /// @return The number of objects recorded
+            lov_size record(const Frustum& frustum, DrawIndirectBuffer& commands) const;
+
+            /// @brief Append an indirect command for each run of neighbouring objects that intersect the given frustum,
+            /// without touching OpenGL so any thread can record
+            /// @param frustum The frustum to cull against
+            /// @param commands The command list to append to
+            /// @return The number of objects recorded
+            lov_size record(const Frustum& frustum, std::vector<DrawElementsIndirectCommand>& commands) const;
+
+            /// @brief Bind the VertexArray of this batch, to draw commands recorded with #record
+            void bind() const;
+
+            /// @brief Get the texture array to bind when drawing this batch
+            /// @return The ID of the texture array shared by the materials of this batch
+            lov_uint getTextureArrayID() const;
+
+            /// @brief Get the index range of each object in this batch
+            /// @return The object ranges
+            const std::vector<StaticBatchRange>& getRanges() const;
+
+            /// @brief Get the world space bounds of this batch
+            /// @return The bounds of this batch
+            const BoundingBox& getBounds() const;
+
+        private:
+            VertexArray m_vao;      ///< The vertex layout of this batch
+            VertexBuffer m_vbo;         ///< The baked vertices
+            VertexBuffer m_materialVbo; ///< The material of each baked vertex
+            ElementBuffer m_ebo;        ///< The baked indices
+
+            lov_uint m_textureArrayID;              ///< The texture array shared by this batch
+            std::vector<StaticBatchRange> m_ranges; ///< The index range of each object
+            BoundingBox m_bounds;                   ///< The bounds of this batch
+            lov_size m_indexCount;                  ///< The total number of indices
+
+            mutable std::vector<lov_size> m_drawCounts;     ///< Scratch index counts reused by culled draws
+            mutable std::vector<const void*> m_drawOffsets; ///< Scratch index offsets reused by culled draws
+            mutable std::vector<DrawElementsIndirectCommand> m_recorded; ///< Scratch commands reused by recording into a DrawIndirectBuffer
+        };
+    }
+}
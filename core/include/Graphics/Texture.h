@@ -3,18 +3,99 @@
 /// @file Texture.h
 /// @brief Defines the #lov::Graphics::Texture class that allows OpenGL textures to be created
 
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "Graphics/Sampler.h"
 #include "System/Types.h"
 
 namespace lov {
     namespace Graphics {
+        class Ktx2Image;
+
+        /// @brief Sized internal formats that uncompressed textures are allocated with
+        enum class TextureFormat : lov_uint {
+            R8 = GL_R8,                     ///< One 8 bit channel
+            RG8 = GL_RG8,                   ///< Two 8 bit channels
+            RGBA8 = GL_RGBA8,               ///< Four 8 bit channels
+            SRGB8_ALPHA8 = GL_SRGB8_ALPHA8  ///< sRGB encoded colour with linear alpha, decoded to linear when sampled
+        };
+
+        /// @brief Describes the storage of a texture, which can't change once allocated
+        struct TextureDesc {
+            lov_int width = 0;                          ///< Width of level 0 in pixels
+            lov_int height = 0;                         ///< Height of level 0 in pixels
+            TextureFormat format = TextureFormat::RGBA8;///< The sized internal format
+            lov_int levels = 0;                         ///< Mip levels to allocate, or 0 for every level down to 1x1
+            SamplerDesc sampler;                        ///< How the texture is filtered and wrapped
+
+            /// @brief Get the number of mip levels this describes
+            /// @return The levels, with 0 resolved to the full chain
+            lov_int getLevelCount() const;
+
+            /// @brief Get the bytes per pixel uploads to this format must provide
+            /// @return 1, 2 or 4
+            lov_int getChannels() const;
+
+            /// @brief Get the pixel format uploads to this format use
+            /// @return GL_RED, GL_RG or GL_RGBA
+            lov_uint getPixelFormat() const;
+
+            /// @brief Describe the texture for an 8 bit image
+            ///
+            /// Three channel images are stored as RGBA8, since rows of 3 byte pixels are often misaligned and drivers expand
+            /// them to four channels anyway. Callers must pad their pixels to match, such as by asking stb_image for 4 channels
+            /// @param width The width of the image
+            /// @param height The height of the image
+            /// @param channels The channels of the image
+            /// @param srgb Is colour sRGB encoded? Only used for three and four channel images
+            /// @return The description
+            static TextureDesc forImage(lov_int width, lov_int height, lov_int channels, bool srgb = false);
+        };
+
         /// @brief OpenGL texture that can be bound to the OpenGL state
+        ///
+        /// Storage is immutable where the context supports glTexStorage2D, so the driver never revalidates it, and filtering
+        /// and wrapping come from a shared sampler object bound alongside the texture.
         class Texture {
         public:
             /// @brief Load this Texture with the given file path
+            ///
+            /// KTX2 files written by the TextureBaker tool are uploaded as they are with glCompressedTexImage2D. Any other
+            /// image is decoded with stb_image, flipped and mipmapped on the GPU
             /// @param path The file path of the texture
+            /// @throws #lov::Exceptions::TextureException if the image can't be loaded or its format isn't supported by the context
             Texture(const char* path);
 
-            /// @brief Bind this Texture to the OpenGL state
+            /// @brief Load this Texture from the contents of an image file held in memory, such as an #lov::System::AssetPack view
+            /// @param contents The file contents, in any format the path constructor accepts
+            /// @throws #lov::Exceptions::TextureException if the image can't be decoded or its format isn't supported by the context
+            explicit Texture(std::span<const std::byte> contents);
+
+            /// @brief Allocate an empty Texture
+            /// @param desc The size, format and sampling of the texture
+            explicit Texture(const TextureDesc& desc);
+
+            /// @brief Deallocate this Texture. The placeholder of a texture that never finished loading is left alone
+            ~Texture();
+
+            Texture(const Texture&) = delete;
+            Texture& operator=(const Texture&) = delete;
+
+            /// @brief Fill a mip level of a Texture constructed from a #lov::Graphics::TextureDesc
+            /// @param level The mip level
+            /// @param pixels Tightly packed rows from the bottom, with TextureDesc::getChannels bytes per pixel
+            void upload(lov_int level, const void* pixels);
+
+            /// @brief Fill every level below level 0 from level 0 on the GPU
+            void generateMipmaps();
+
+            /// @brief Change how this Texture is filtered and wrapped
+            /// @param sampler The new state
+            void setSampler(const SamplerDesc& sampler);
+
+            /// @brief Bind this Texture and its sampler to the OpenGL state
             /// @param unit Optionally set the texture unit to activate when binding this texture. Default is GL_TEXTURE0
             void bind(lov_uint unit = 0) const;
 
@@ -25,9 +106,73 @@ namespace lov {
             /// @return The ID of this texture
             lov_uint getID() const;
 
+            /// @brief Get the sized internal format of this texture, which may be a compressed format
+            /// @return The format, or 0 while a #lov::Graphics::TextureLoader is still loading it
+            lov_uint getInternalFormat() const;
+
+            /// @brief Get the width of level 0
+            /// @return The width in pixels
+            lov_int getWidth() const;
+
+            /// @brief Get the height of level 0
+            /// @return The height in pixels
+            lov_int getHeight() const;
+
+            /// @brief Get the number of mip levels
+            /// @return The level count
+            lov_int getLevelCount() const;
+
+            /// @brief Has the image of this Texture been uploaded?
+            /// @return False while a #lov::Graphics::TextureLoader is still loading it and the placeholder is bound instead
+            bool isReady() const;
+
         private:
-            /// @brief The ID of this Texture
-            lov_uint m_id;
+            friend class TextureLoader;
+            friend class TextureStreamer;
+
+            /// @brief Construct a Texture that shows a placeholder until its image is loaded
+            /// @param placeholderID The ID of the placeholder texture
+            explicit Texture(lov_uint placeholderID);
+
+            /// @brief Generate this texture and fill it from the contents of an image file
+            /// @param data The file contents
+            /// @param size The size of the contents in bytes
+            /// @param name The path or description of the image used in errors
+            /// @throws #lov::Exceptions::TextureException if the image can't be decoded or its format isn't supported by the context
+            void load(const unsigned char* data, size_t size, const std::string& name);
+
+            /// @brief Upload the levels of a baked image to the bound texture
+            /// @param image The image
+            /// @throws #lov::Exceptions::TextureException if the context doesn't support the image's format
+            void uploadCompressed(const Ktx2Image& image);
+
+            /// @brief Allocate the levels of the bound texture, immutably where the context supports it
+            /// @param internalFormat The sized internal format, which may be compressed
+            /// @param width The width of level 0
+            /// @param height The height of level 0
+            /// @param levels The number of levels
+            static void allocate(lov_uint internalFormat, lov_int width, lov_int height, lov_int levels);
+
+            /// @brief Fill a level of the bound texture allocated by #allocate
+            /// @param internalFormat The format the texture was allocated with
+            /// @param level The mip level
+            /// @param width The width of the level
+            /// @param height The height of the level
+            /// @param data The pixels or compressed blocks, or an offset into the bound pixel unpack buffer
+            /// @param compressedSize The size of the compressed blocks, or 0 for an uncompressed format
+            static void uploadLevel(lov_uint internalFormat, lov_int level, lov_int width, lov_int height, const void* data, lov_size compressedSize);
+
+            /// @brief Show a one or two channel image of the bound texture as grey, or grey and alpha, rather than red and green
+            /// @param channels The channels of the image
+            static void swizzleGrey(lov_int channels);
+
+            lov_uint m_id;              ///< The ID of this Texture
+            bool m_ready;               ///< Has the image been uploaded?
+            lov_uint m_internalFormat;  ///< The sized internal format
+            lov_int m_width;            ///< Width of level 0
+            lov_int m_height;           ///< Height of level 0
+            lov_int m_levels;           ///< Number of mip levels
+            lov_uint m_sampler;         ///< The shared sampler object bound with this texture
         };
     }
 }
@@ -0,0 +1,106 @@
+#pragma once
+
+/// @file TextureArray.h
+/// @brief Defines the #lov::Graphics::TextureArray of same sized layers bound as one texture
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "Graphics/AtlasPacker.h"
+#include "Graphics/Texture.h"
+#include "System/Types.h"
+
+namespace lov {
+    namespace Graphics {
+        /// @brief An OpenGL 2D array texture whose layers share one size and format
+        ///
+        /// Materials refer to their maps by layer, so objects with different materials sample the same bound texture and
+        /// can be drawn together without rebinding texture units between them.
+        class TextureArray {
+        public:
+            /// @brief Allocate an empty TextureArray
+            /// @param desc The size, format and sampling of every layer
+            /// @param layers The number of layers
+            TextureArray(const TextureDesc& desc, lov_int layers);
+
+            /// @brief Deallocate this TextureArray
+            ~TextureArray();
+
+            TextureArray(const TextureArray&) = delete;
+            TextureArray& operator=(const TextureArray&) = delete;
+
+            /// @brief Fill a mip level of a layer
+            /// @param layer The layer
+            /// @param level The mip level
+            /// @param pixels Tightly packed rows from the bottom, with TextureDesc::getChannels bytes per pixel
+            void upload(lov_int layer, lov_int level, const void* pixels);
+
+            /// @brief Fill part of level 0 of a layer
+            /// @param layer The layer
+            /// @param rect The texels to fill
+            /// @param pixels Tightly packed rows from the bottom, with TextureDesc::getChannels bytes per pixel
+            void upload(lov_int layer, const AtlasRect& rect, const void* pixels);
+
+            /// @brief Fill level 0 of a layer from an image file, converted to the channels of this array
+            /// @param layer The layer
+            /// @param path The file path of the image
+            /// @throws #lov::Exceptions::TextureException if the image can't be loaded or isn't the size of a layer
+            void loadLayer(lov_int layer, const char* path);
+
+            /// @brief Fill level 0 of a layer from the contents of an image file held in memory, such as an #lov::System::AssetPack view
+            /// @param layer The layer
+            /// @param contents The file contents
+            /// @throws #lov::Exceptions::TextureException if the image can't be decoded or isn't the size of a layer
+            void loadLayer(lov_int layer, std::span<const std::byte> contents);
+
+            /// @brief Fill every level below level 0 of every layer from level 0 on the GPU
+            void generateMipmaps();
+
+            /// @brief Change how every layer is filtered and wrapped
+            /// @param sampler The new state
+            void setSampler(const SamplerDesc& sampler);
+
+            /// @brief Bind this TextureArray and its sampler to the OpenGL state
+            /// @param unit Optionally set the texture unit to activate when binding this texture. Default is GL_TEXTURE0
+            void bind(lov_uint unit = 0) const;
+
+            /// @brief Unbind this TextureArray from the OpenGL state
+            void unbind() const;
+
+            /// @brief Get the OpenGL ID of this texture
+            /// @return The ID of this texture
+            lov_uint getID() const;
+
+            /// @brief Get the description every layer was allocated with
+            /// @return The description, with the level count resolved
+            const TextureDesc& getDesc() const;
+
+            /// @brief Get the number of layers
+            /// @return The layer count
+            lov_int getLayerCount() const;
+
+        private:
+            /// @brief Fill level 0 of a layer with a decoded image, then free it
+            /// @param layer The layer
+            /// @param data The pixels from stb_image, or null if decoding failed
+            /// @param width The width of the image
+            /// @param height The height of the image
+            /// @param name The path or description of the image used in errors
+            /// @throws #lov::Exceptions::TextureException if decoding failed or the image isn't the size of a layer
+            void loadDecoded(lov_int layer, unsigned char* data, int width, int height, const std::string& name);
+
+            /// @brief Upload a rectangle of pixels to the bound array
+            /// @param layer The layer
+            /// @param level The mip level
+            /// @param rect The texels to fill
+            /// @param pixels The pixels
+            void uploadRect(lov_int layer, lov_int level, const AtlasRect& rect, const void* pixels);
+
+            lov_uint m_id;      ///< The ID of this TextureArray
+            TextureDesc m_desc; ///< The size, format and sampling of every layer
+            lov_int m_layers;   ///< The number of layers
+            lov_uint m_sampler; ///< The shared sampler object bound with this texture
+        };
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "Graphics/AtlasPacker.h"
+#include "Graphics/TextureArray.h"
+#include "System/Types.h"
+
+/// @file TextureAtlas.h
+/// @brief Defines the #lov::Graphics::TextureAtlas that packs small images into the layers of a texture array
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Packs small images into pages that are layers of one #lov::Graphics::TextureArray
+        ///
+        /// Images too small to deserve a layer of their own share a page, and meshes sampling them have their texture
+        /// coordinates remapped with the returned #lov::Graphics::AtlasRegion. Each image's edge texels are repeated into
+        /// its padding, so bilinear filtering at its border doesn't pick up its neighbours. Mip levels below log2 of the
+        /// padding will still blend neighbours, so limit TextureDesc::levels accordingly.
+        class TextureAtlas {
+        public:
+            /// @brief Allocate an empty TextureAtlas
+            /// @param pageDesc The size, format and sampling of each page. Clamp to edge wrapping suits atlases best
+            /// @param pageCount The number of pages
+            /// @param padding Texels around each image filled with its edges
+            TextureAtlas(const TextureDesc& pageDesc, lov_int pageCount, lov_int padding = 2);
+
+            /// @brief Pack an image into the first page with room for it and upload it
+            /// @param width The width of the image
+            /// @param height The height of the image
+            /// @param pixels Tightly packed rows from the bottom, with TextureDesc::getChannels bytes per pixel
+            /// @param region Set to where the image was placed
+            /// @return Whether any page had room
+            bool add(lov_int width, lov_int height, const void* pixels, AtlasRegion& region);
+
+            /// @brief Pack an image file, converted to the channels of the pages
+            /// @param path The file path of the image
+            /// @param region Set to where the image was placed
+            /// @return Whether any page had room
+            /// @throws #lov::Exceptions::TextureException if the image can't be loaded
+            bool addFile(const char* path, AtlasRegion& region);
+
+            /// @brief Fill the mip levels of every page. Call once the images are added
+            void generateMipmaps();
+
+            /// @brief Get the texture array holding the pages
+            /// @return The texture array
+            const TextureArray& getTexture() const;
+
+        private:
+            TextureArray m_pages;               ///< Every page as a layer
+            std::vector<AtlasPacker> m_packers; ///< The packer of each page
+        };
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Graphics/Texture.h"
+#include "System/ThreadPool.h"
+#include "System/Types.h"
+
+/// @file TextureLoader.h
+/// @brief Defines the #lov::Graphics::TextureLoader that decodes textures on worker threads and uploads them in time slices
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Loads textures without blocking the GL thread
+        ///
+        /// Images are decoded and their mip chains built on a thread pool, while baked KTX2 files are only read there. Each
+        /// frame, #update copies decoded pixels into a pixel buffer object on the GL thread and uploads mip levels from it
+        /// until its time budget runs out, so the driver can copy them asynchronously. Until then every loading texture is bound as a 1x1 grey placeholder, so callers can
+        /// bind it right away.
+        class TextureLoader {
+        public:
+            /// @brief Construct a TextureLoader and its placeholder texture. Requires a current OpenGL context
+            /// @param pool The pool that decodes images, which must outlive this TextureLoader
+            /// @param pixelBufferCount The number of pixel buffer objects uploads cycle through
+            explicit TextureLoader(System::ThreadPool& pool, lov_size pixelBufferCount = 2);
+
+            /// @brief Wait for pending decodes and deallocate the pixel buffers and placeholder
+            ~TextureLoader();
+
+            TextureLoader(const TextureLoader&) = delete;
+            TextureLoader& operator=(const TextureLoader&) = delete;
+
+            /// @brief Start loading a texture
+            /// @param path The file path of the texture
+            /// @return The texture, which shows the placeholder until #update finishes uploading it
+            std::shared_ptr<Texture> load(const std::string& path);
+
+            /// @brief Start loading a texture from file contents already read, so the file isn't read again
+            /// @param path The file path of the texture, used in errors
+            /// @param contents The file contents
+            /// @return The texture, which shows the placeholder until #update finishes uploading it
+            std::shared_ptr<Texture> load(const std::string& path, std::vector<unsigned char> contents);
+
+            /// @brief Create a texture that shows the placeholder and is never loaded, to stand in until a load starts
+            /// @return The texture
+            std::shared_ptr<Texture> createPlaceholder() const;
+
+            /// @brief Continue uploading decoded textures on the GL thread for at most the given time
+            /// @param budgetMilliseconds The time this call may spend copying and uploading
+            /// @throws #lov::Exceptions::TextureException if a texture could not be decoded. It keeps the placeholder
+            void update(double budgetMilliseconds);
+
+            /// @brief Get the number of textures still decoding or uploading
+            /// @return The pending count
+            lov_size getPendingCount() const;
+
+            /// @brief Get the OpenGL ID of the placeholder texture
+            /// @return The ID bound by textures that are not ready
+            lov_uint getPlaceholderID() const;
+
+            /// @brief Get the pool that decodes images, to run other work on the same threads
+            /// @return The pool
+            System::ThreadPool& getPool() const;
+
+            /// @brief Append the box filtered mip levels below level 0 of an uncompressed image
+            /// @param pixels Level 0 on input, followed by every other level down to 1x1 on output. Reserve room to avoid copies
+            /// @param levelOffsets {0} on input, with the offset of each appended level added
+            /// @param width The width of level 0
+            /// @param height The height of level 0
+            /// @param channels The bytes per pixel
+            static void buildMipChain(std::vector<unsigned char>& pixels, std::vector<lov_size>& levelOffsets, lov_int width, lov_int height, lov_int channels);
+
+        private:
+            /// @brief An image decoded by a worker
+            struct DecodedImage {
+                std::shared_ptr<Texture> texture;   ///< The texture to fill
+                std::string path;                   ///< The file the image came from
+                std::vector<unsigned char> pixels;  ///< Every mip level, each in rows from the bottom. Empty if decoding failed
+                std::vector<lov_size> levelOffsets; ///< Byte offset of each mip level within pixels
+                lov_int width;                      ///< Width of level 0 in pixels
+                lov_int height;                     ///< Height of level 0 in pixels
+                lov_int channels;                   ///< Channels per pixel of an uncompressed image, with RGB padded to RGBA
+                lov_uint compressedFormat;          ///< OpenGL format of a baked KTX2 image's blocks, or 0 for raw pixels
+            };
+
+            /// @brief Decode an image on a worker thread and queue it for upload
+            /// @param texture The texture to fill
+            /// @param path The file path of the image
+            /// @param contents The contents of the file
+            void decode(std::shared_ptr<Texture> texture, const std::string& path, const std::vector<unsigned char>& contents);
+
+            /// @brief Start copying the next decoded image into a pixel buffer
+            /// @return Whether there was an image to start
+            bool beginUpload();
+
+            /// @brief Upload the next mip level from the filled pixel buffer, handing the texture over after the last one
+            void uploadLevel();
+
+            /// @brief Get the sized internal format a decoded image is stored with
+            /// @param image The image
+            /// @return The compressed format of a baked image, or the #lov::Graphics::TextureFormat of its channels
+            static lov_uint internalFormatOf(const DecodedImage& image);
+
+            System::ThreadPool& m_pool;                     ///< Decodes images
+            lov_uint m_placeholder;                         ///< 1x1 texture bound while loading
+            std::vector<lov_uint> m_pixelBuffers;           ///< Pixel unpack buffers uploads cycle through
+            lov_size m_nextPixelBuffer;                     ///< The buffer the next upload uses
+
+            mutable std::mutex m_mutex;                     ///< Guards m_decoded
+            std::deque<DecodedImage> m_decoded;             ///< Images waiting for upload
+            std::vector<std::future<void>> m_decoding;      ///< Decodes still running or not yet collected
+
+            std::unique_ptr<DecodedImage> m_upload;         ///< The image being copied into a pixel buffer
+            unsigned char* m_mapped;                        ///< The mapped pixel buffer of the current upload
+            lov_size m_bytesCopied;                         ///< Bytes of the current upload copied so far
+            lov_uint m_uploadTexture;                       ///< The texture the current upload fills, 0 before its first level
+            lov_size m_uploadLevel;                         ///< The next mip level of the current upload
+        };
+    }
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Graphics/Texture.h"
+#include "Graphics/TextureLoader.h"
+#include "System/Types.h"
+
+/// @file TextureManager.h
+/// @brief Defines the #lov::Graphics::TextureManager that shares textures between everything that loads the same image
+
+namespace lov {
+    namespace Graphics {
+        class TextureManager;
+
+        /// @brief A counted reference to a texture owned by a #lov::Graphics::TextureManager
+        ///
+        /// Copying a handle adds a reference and destroying one removes it. Handles must not outlive their manager
+        class TextureHandle {
+        public:
+            /// @brief Construct a handle that refers to no texture
+            TextureHandle();
+
+            /// @brief Release this handle's reference
+            ~TextureHandle();
+
+            /// @brief Add a reference to the other handle's texture
+            /// @param other The handle to copy
+            TextureHandle(const TextureHandle& other);
+
+            /// @brief Take the other handle's reference, leaving it empty
+            /// @param other The handle to move
+            TextureHandle(TextureHandle&& other) noexcept;
+
+            /// @brief Release this handle's reference and add one to the other handle's texture
+            /// @param other The handle to copy
+            /// @return This handle
+            TextureHandle& operator=(const TextureHandle& other);
+
+            /// @brief Release this handle's reference and take the other handle's
+            /// @param other The handle to move
+            /// @return This handle
+            TextureHandle& operator=(TextureHandle&& other) noexcept;
+
+            /// @brief Get the texture of this handle
+            /// @return The texture, or null for an empty handle
+            Texture* get() const;
+
+            /// @brief Access the texture of this handle
+            /// @return The texture
+            Texture* operator->() const;
+
+            /// @brief Does this handle refer to a texture?
+            /// @return Whether this handle is not empty
+            explicit operator bool() const;
+
+        private:
+            friend class TextureManager;
+
+            /// @brief Construct a handle that has already been counted by the manager
+            /// @param manager The owning manager
+            /// @param entry The manager's index of the texture
+            TextureHandle(TextureManager* manager, lov_uint entry);
+
+            /// @brief Drop this handle's reference, if any
+            void release();
+
+            TextureManager* m_manager;  ///< The owning manager, null for an empty handle
+            lov_uint m_entry;           ///< The manager's index of the texture
+        };
+
+        /// @brief Counters reported by a #lov::Graphics::TextureManager
+        struct TextureManagerStats {
+            lov_size textureCount;      ///< Textures currently resident, referenced or not
+            lov_size unreferencedCount; ///< Resident textures no handle refers to
+            size_t residentBytes;       ///< Estimated GPU memory of the resident textures, including mips
+            size_t dedupedBytes;        ///< Total bytes of every load served by an existing texture instead of a new copy
+            lov_size pathHits;          ///< Loads that matched the normalized path of a resident texture
+            lov_size contentHits;       ///< Loads of a new path whose file contents matched a resident texture
+            lov_size evictions;         ///< Unreferenced textures freed to stay within the budget
+            lov_size pendingCount;      ///< Loads whose file contents are still being read
+        };
+
+        /// @brief Interns textures by normalized path and file contents and hands out counted handles to them
+        ///
+        /// A texture nothing refers to stays resident so it can be reacquired for free, until the resident total exceeds the
+        /// budget and the least recently released textures are freed. Contents only match when their bytes are equal, so a
+        /// hash collision never shares the wrong texture. With a loader, a new path's file is read, hashed and compared on
+        /// the loader's pool, and the handle shows the placeholder until #update shares a match or starts decoding the
+        /// contents already read. Use from the GL thread only.
+        class TextureManager {
+        public:
+            /// @brief Construct an empty TextureManager
+            /// @param loader Loads new textures asynchronously, or null to load them synchronously from the file contents
+            /// @param budgetBytes The resident size above which unreferenced textures are freed
+            explicit TextureManager(TextureLoader* loader = nullptr, size_t budgetBytes = 256 * 1024 * 1024);
+
+            /// @brief Wait for files still being read
+            ~TextureManager();
+
+            TextureManager(const TextureManager&) = delete;
+            TextureManager& operator=(const TextureManager&) = delete;
+
+            /// @brief Get a handle to the texture at a path, loading it only if neither its path nor its contents are resident
+            /// @param path The file path of the texture
+            /// @return A handle to the shared texture
+            /// @throws #lov::Exceptions::TextureException without a loader, if the image can't be loaded
+            TextureHandle acquire(const std::string& path);
+
+            /// @brief Get a handle to the texture of an image file already in memory, such as an #lov::System::AssetPack view
+            ///
+            /// The name is matched as given rather than normalized, so it should not be an absolute path. The contents are
+            /// compared against later loads, so they must stay valid and unchanged for as long as this manager is used.
+            /// @param name The name of the texture
+            /// @param contents The file contents
+            /// @return A handle to the shared texture
+            /// @throws #lov::Exceptions::TextureException if the contents are empty, or without a loader if the image can't be decoded
+            TextureHandle acquire(const std::string& name, std::span<const std::byte> contents);
+
+            /// @brief Share or start loading the textures whose files have been read. Call once a frame, alongside
+            /// #lov::Graphics::TextureLoader::update
+            void update();
+
+            /// @brief Change the budget, freeing unreferenced textures if the resident size is now over it
+            /// @param budgetBytes The new budget. 0 frees textures as soon as their last handle is released
+            void setBudget(size_t budgetBytes);
+
+            /// @brief Free every unreferenced texture regardless of the budget
+            void trim();
+
+            /// @brief Get the counters of this TextureManager
+            /// @return The stats
+            TextureManagerStats getStats() const;
+
+            /// @brief Make a path absolute and remove ".", ".." and redundant separators, resolving symlinks where the file exists
+            /// @param path The path to normalize
+            /// @return The normalized path
+            static std::string normalizePath(const std::string& path);
+
+            /// @brief Hash file contents with 64 bit FNV-1a
+            /// @param data The contents
+            /// @param size The size of the contents in bytes
+            /// @return The hash
+            static std::uint64_t hashContent(const void* data, size_t size);
+
+        private:
+            friend class TextureHandle;
+
+            /// @brief Index of no entry
+            static constexpr lov_uint NoEntry = UINT32_MAX;
+
+            /// @brief A resident texture
+            struct Entry {
+                std::shared_ptr<Texture> texture;           ///< The texture, null once freed
+                std::vector<std::string> paths;             ///< Every normalized path that resolved to this texture
+                std::uint64_t contentHash;                  ///< Hash of the file contents
+                size_t contentSize;                         ///< Size of the file in bytes
+                size_t bytes;                               ///< Estimated GPU memory of the texture, 0 if it shares another's
+                lov_uint references;                        ///< Number of handles
+                std::list<lov_uint>::iterator unreferenced; ///< Position in the unreferenced list while references is 0
+                std::uint64_t load;                         ///< Which load filled this slot, so reads for a freed slot are ignored
+                bool pending;                               ///< Is the file still being read?
+                lov_uint shared;                            ///< The entry whose texture this one shares and references, or NoEntry
+                lov_size pendingHits;                       ///< Path hits while pending, counted as deduped once the size is known
+                std::span<const std::byte> source;          ///< Contents held in memory by the caller, empty if read from a file
+            };
+
+            /// @brief A resident texture a new file's contents are compared against
+            struct Candidate {
+                lov_uint entry;         ///< The index of the entry
+                std::uint64_t load;     ///< The load that filled the entry
+                std::uint64_t hash;     ///< Hash of the entry's file contents
+                size_t size;            ///< Size of the entry's file in bytes
+                std::string path;       ///< One of the entry's paths, to compare the bytes of
+                std::span<const std::byte> source;  ///< The entry's contents in memory, compared instead of its file when not empty
+            };
+
+            /// @brief A file read for a new entry
+            struct ReadContents {
+                lov_uint entry;                     ///< The index of the entry
+                std::uint64_t load;                 ///< The load that filled the entry
+                std::vector<unsigned char> contents;///< The file contents
+                std::uint64_t hash;                 ///< Hash of the contents
+                size_t bytes;                       ///< Estimated GPU memory of the decoded image
+                lov_uint duplicate;                 ///< A candidate with the same bytes, or NoEntry
+                std::uint64_t duplicateLoad;        ///< The load that filled the duplicate
+            };
+
+            /// @brief Read and hash a file, and find a candidate whose file has the same bytes. Safe on any thread
+            /// @param path The normalized path of the file
+            /// @param source The contents already in memory, or empty to read the file at the path
+            /// @param candidates The resident textures to compare against
+            /// @param read Receives the contents, hash, estimated size and duplicate
+            static void readContents(const std::string& path, std::span<const std::byte> source, const std::vector<Candidate>& candidates, ReadContents& read);
+
+            /// @brief Estimate the GPU memory of an image from its file header, adding a third for the mip chain
+            /// @param contents The file contents
+            /// @return The estimate, or 0 if the header can't be read
+            static size_t estimateBytes(const std::vector<unsigned char>& contents);
+
+            /// @brief Get a handle to the texture under a key, loading it only if neither its key nor its contents are resident
+            /// @param key The normalized path or name of the texture
+            /// @param source The contents already in memory, or empty to read the file at the key
+            /// @return A handle to the shared texture
+            TextureHandle acquireEntry(const std::string& key, std::span<const std::byte> source);
+
+            /// @brief Get the estimated GPU memory of the texture an entry refers to, whether its own or one it shares
+            /// @param entry The index of the entry
+            /// @return The size in bytes
+            size_t getTextureBytes(lov_uint entry) const;
+
+            /// @brief Get every resident texture that new contents could match
+            /// @return The candidates
+            std::vector<Candidate> getCandidates() const;
+
+            /// @brief Store an entry in a free slot
+            /// @param entry The entry
+            /// @return The index of the entry
+            lov_uint insert(Entry&& entry);
+
+            /// @brief Count a new handle to an entry
+            /// @param entry The index of the entry
+            void addReference(lov_uint entry);
+
+            /// @brief Drop a handle to an entry, moving it to the unreferenced list at zero
+            /// @param entry The index of the entry
+            void removeReference(lov_uint entry);
+
+            /// @brief Drop a reference to an entry without freeing anything to fit the budget
+            /// @param entry The index of the entry
+            void dropReference(lov_uint entry);
+
+            /// @brief Free unreferenced entries, least recently released first, until the resident size fits the budget
+            /// @param budgetBytes The size to fit within
+            void evict(size_t budgetBytes);
+
+            /// @brief Free an unreferenced entry and forget its paths and contents
+            /// @param entry The index of the entry
+            void free(lov_uint entry);
+
+            TextureLoader* m_loader;                                    ///< Loads textures asynchronously, may be null
+            size_t m_budget;                                            ///< Resident size above which unreferenced textures go
+
+            std::vector<Entry> m_entries;                               ///< Entry slots, reused after entries are freed
+            std::vector<lov_uint> m_freeEntries;                        ///< Indices of freed slots
+            std::unordered_map<std::string, lov_uint> m_byPath;         ///< Entries by normalized path
+            std::unordered_multimap<std::uint64_t, lov_uint> m_byContent;///< Entries by content hash
+            std::list<lov_uint> m_unreferenced;                         ///< Unreferenced entries, least recently released first
+            std::uint64_t m_loads;                                      ///< Loads started, numbering each entry's load
+
+            std::mutex m_mutex;                                         ///< Guards m_read
+            std::deque<ReadContents> m_read;                            ///< Files read by workers, waiting for #update
+            std::vector<std::future<void>> m_reading;                   ///< Reads still running or not yet collected
+
+            TextureManagerStats m_stats;                                ///< Counters reported by getStats
+        };
+    }
+}
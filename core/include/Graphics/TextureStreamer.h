@@ -0,0 +1,184 @@
+#pragma once
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/MipResidency.h"
+#include "Graphics/Texture.h"
+#include "System/ThreadPool.h"
+#include "System/Types.h"
+#include "System/Vector.h"
+
+/// @file TextureStreamer.h
+/// @brief Defines the #lov::Graphics::TextureStreamer that keeps only the mip levels each texture needs on screen resident
+
+namespace lov {
+    namespace Graphics {
+        /// @brief Counters reported by a #lov::Graphics::TextureStreamer
+        struct TextureStreamerStats {
+            lov_size textureCount;  ///< Textures added to the streamer
+            size_t residentBytes;   ///< GPU memory of every resident level
+            size_t wantedBytes;     ///< GPU memory every texture would use at the level it was last asked for
+            lov_size pendingLoads;  ///< Reads still running on worker threads or waiting for upload
+            lov_size levelsLoaded;  ///< Levels uploaded so far
+            lov_size levelsEvicted; ///< Levels freed to make room for others
+        };
+
+        /// @brief Streams mip levels in and out of textures depending on how large they appear on screen
+        ///
+        /// Each texture starts with only its small tail levels, read on the thread pool. Every frame callers #request the
+        /// detail each visible texture needs, and #update reads the missing finer levels on the pool and uploads them.
+        /// Sampling is clamped to the resident levels with GL_TEXTURE_BASE_LEVEL, so a texture is always complete and just
+        /// looks blurrier until its detail arrives. When the resident levels would exceed the budget, levels finer than
+        /// their texture currently needs are freed, least recently needed first, as decided by a
+        /// #lov::Graphics::MipResidency. Use from the GL thread only.
+        ///
+        /// Textures use mutable storage so levels can be freed one at a time, which glTexStorage2D doesn't allow. KTX2
+        /// files are read again for each range of levels, copying out only those. Other images are decoded and mipmapped
+        /// once when their tail is read, and the chain is kept in memory for later levels to be copied from.
+        class TextureStreamer {
+        public:
+            /// @brief Construct an empty TextureStreamer
+            /// @param pool The pool that reads and decodes levels, which must outlive this TextureStreamer
+            /// @param budgetBytes The GPU memory resident levels may use
+            /// @param tailSize Levels no larger than this are loaded up front and never freed
+            explicit TextureStreamer(System::ThreadPool& pool, size_t budgetBytes = 256 * 1024 * 1024, lov_int tailSize = 64);
+
+            /// @brief Wait for pending reads and deallocate the placeholder. Textures keep the levels they have
+            ~TextureStreamer();
+
+            TextureStreamer(const TextureStreamer&) = delete;
+            TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+            /// @brief Start streaming a texture
+            /// @param path The file path of the texture
+            /// @return The ID used to request detail for the texture
+            lov_uint add(const std::string& path);
+
+            /// @brief Get a streamed texture, which binds a 1x1 placeholder until its tail levels are uploaded
+            /// @param texture The ID returned by #add
+            /// @return The texture
+            const std::shared_ptr<Texture>& getTexture(lov_uint texture) const;
+
+            /// @brief Ask for enough detail to draw an object with a texture this frame. The largest request of the frame wins
+            /// @param texture The ID returned by #add
+            /// @param screenSize The size of the object on screen in pixels, such as from #projectedSize
+            /// @param uvDensity How many times the texture repeats across the object. 1 if it's mapped across it once
+            void request(lov_uint texture, float screenSize, float uvDensity = 1.0f);
+
+            /// @brief Upload finished levels for at most the given time, then free and read levels to match this frame's requests
+            /// @param budgetMilliseconds The time this call may spend uploading
+            /// @throws #lov::Exceptions::TextureException once this frame's levels have been freed and read, if a texture
+            /// could not be read. It keeps the levels it had
+            void update(double budgetMilliseconds);
+
+            /// @brief Change the GPU memory resident levels may use. Levels over it are freed by the next #update
+            /// @param budgetBytes The new budget
+            void setBudget(size_t budgetBytes);
+
+            /// @brief Get the finest level of a texture that can be sampled
+            /// @param texture The ID returned by #add
+            /// @return The level, or -1 until the tail levels are uploaded
+            lov_int getResidentLevel(lov_uint texture) const;
+
+            /// @brief Get the counters of this TextureStreamer
+            /// @return The stats
+            TextureStreamerStats getStats() const;
+
+            /// @brief Get the finest mip level worth sampling for an object on screen
+            ///
+            /// A level is needed once one of its texels would cover more than one pixel, so the level is log2 of the texels
+            /// across the object divided by its size on screen
+            /// @param width The width of level 0
+            /// @param height The height of level 0
+            /// @param screenSize The size of the object on screen in pixels
+            /// @param uvDensity How many times the texture repeats across the object
+            /// @return The level, from 0 to the last level of the chain
+            static lov_int computeMipLevel(lov_int width, lov_int height, float screenSize, float uvDensity);
+
+            /// @brief Estimate the size of a box on screen from the diameter of its bounding sphere
+            /// @param bounds The world space bounds
+            /// @param cameraPosition The position of the camera
+            /// @param fovY The vertical field of view in radians
+            /// @param viewportHeight The height of the viewport in pixels
+            /// @return The diameter in pixels, or the viewport height if the camera is inside the sphere
+            static float projectedSize(const BoundingBox& bounds, const Vector3f& cameraPosition, float fovY, lov_int viewportHeight);
+
+        private:
+            /// @brief A streamed texture
+            struct Entry {
+                std::shared_ptr<Texture> texture;   ///< The texture handed out by getTexture
+                std::string path;                   ///< The file the levels come from
+                lov_uint id;                        ///< The OpenGL texture, 0 until the tail arrives
+                lov_uint internalFormat;            ///< Sized internal format of the levels
+                lov_uint pixelFormat;               ///< Pixel format of uncompressed levels, or 0 for compressed levels
+                lov_int width;                      ///< Width of level 0
+                lov_int height;                     ///< Height of level 0
+                lov_int levelCount;                 ///< Levels in the full chain
+            };
+
+            /// @brief The decoded mip chain of an image that isn't KTX2, kept so its levels aren't decoded again
+            struct DecodedImage {
+                lov_uint internalFormat;            ///< Sized internal format of the levels
+                lov_int width;                      ///< Width of level 0
+                lov_int height;                     ///< Height of level 0
+                lov_int channels;                   ///< Channels of each texel, with RGB padded to RGBA
+                std::vector<unsigned char> pixels;  ///< Every level, finest first
+                std::vector<lov_size> levelOffsets; ///< Offset of each level in pixels
+            };
+
+            /// @brief Levels read by a worker
+            struct LoadedLevels {
+                lov_uint entry;                             ///< The index of the entry
+                bool tail;                                  ///< Are these the first levels of the texture?
+                bool failed;                                ///< Could the file not be read?
+                lov_uint internalFormat;                    ///< Sized internal format of the levels
+                lov_int width;                              ///< Width of level 0
+                lov_int height;                             ///< Height of level 0
+                lov_int channels;                           ///< Channels of an uncompressed image
+                lov_int firstLevel;                         ///< The finest level read
+                std::vector<std::vector<unsigned char>> levels; ///< Pixels or blocks of each level read, finest first
+                std::vector<size_t> levelSizes;             ///< Bytes of every level of the chain
+            };
+
+            /// @brief Read levels of a file on a worker thread and queue them for upload, copying them from the decoded chain
+            /// once an image that isn't KTX2 has been decoded
+            /// @param entry The index of the entry
+            /// @param path The file path
+            /// @param firstLevel The finest level to read, or -1 for the tail
+            /// @param lastLevel The coarsest level to read, or -1 for the tail
+            void read(lov_uint entry, const std::string& path, lov_int firstLevel, lov_int lastLevel);
+
+            /// @brief Upload one level from the front of the loaded queue, finishing the load after its last level
+            /// @param failures Receives the path of a texture whose levels couldn't be read, instead of uploading them
+            /// @return Whether anything was uploaded or failed
+            bool uploadNext(std::vector<std::string>& failures);
+
+            /// @brief Free a level of a texture, clamping sampling to the next coarser level first
+            /// @param entry The entry
+            /// @param level The finest resident level
+            void evictLevel(Entry& entry, lov_int level);
+
+            System::ThreadPool& m_pool;                 ///< Reads and decodes levels
+            lov_int m_tailSize;                         ///< Largest level loaded up front
+            lov_uint m_placeholder;                     ///< 1x1 texture bound until tails arrive
+
+            std::vector<Entry> m_entries;               ///< Every streamed texture
+            MipResidency m_residency;                   ///< Which levels of each texture are resident, wanted and loading
+
+            mutable std::mutex m_mutex;                 ///< Guards m_loaded and m_decoded
+            std::deque<LoadedLevels> m_loaded;          ///< Levels waiting for upload
+            std::unordered_map<lov_uint, std::shared_ptr<const DecodedImage>> m_decoded;   ///< Decoded chains by entry
+            std::vector<std::future<void>> m_reading;   ///< Reads still running or not yet collected
+            lov_size m_uploadedLevels;                  ///< Levels of the front of m_loaded uploaded so far
+
+            TextureStreamerStats m_stats;               ///< Counters reported by getStats
+        };
+    }
+}
@@ -27,12 +27,29 @@ namespace lov {
             /// @param offset The offset of the attribute in the VertexBuffer
             void linkAttribute(lov_uint location, lov_uint componentCount, LovelyType type, lov_size stride, lov_size offset) const;
 
+            /// @brief Link an integer attribute to this VertexArray, which the shader reads without conversion to float
+            /// @param location The layout location for this attribute in the shader
+            /// @param componentCount The number of "LovelyType" components for this attribute
+            /// @param type The enumerated integer type for this attribute
+            /// @param stride The stride for this attribute in the VertexBuffer
+            /// @param offset The offset of the attribute in the VertexBuffer
+            void linkIntegerAttribute(lov_uint location, lov_uint componentCount, LovelyType type, lov_size stride, lov_size offset) const;
+
+            /// @brief Set how often an attribute advances, 0 for every vertex or N to advance once every N instances
+            /// @param location The layout location of the attribute
+            /// @param divisor The number of instances per attribute value
+            void setAttributeDivisor(lov_uint location, lov_uint divisor) const;
+
             /// @brief Bind this VertexArray to the OpenGL state
             void bind() const;
 
             /// @brief Unbind this VertexArray from the OpenGL state
             void unbind() const;
 
+            /// @brief Get the OpenGL ID of this VertexArray
+            /// @return The ID of this VertexArray
+            lov_uint getID() const;
+
         private:
             /// @brief The ID for this VertexArray
             lov_uint m_id;
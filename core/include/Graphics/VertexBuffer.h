@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
@@ -28,6 +31,12 @@ namespace lov {
                 glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
             }
 
+            /// @brief Sends a view of raw vertex data to the OpenGL buffer, such as an #lov::System::AssetPack view
+            /// @param data The data to buffer
+            inline void bufferData(std::span<const std::byte> data) {
+                glBufferData(GL_ARRAY_BUFFER, data.size(), data.data(), GL_STATIC_DRAW);
+            }
+
             /// @brief Bind this VertexBuffer to the OpenGL state
             void bind() const;
 
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <string>
+#include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "Input/InputQueue.h"
 #include "Input/Keyboard.h"
+#include "System/FrameClock.h"
+#include "System/Types.h"
 #include "System/Vector.h"
 
 /// @file Window.h
@@ -13,14 +19,44 @@
 
 namespace lov {
     namespace Graphics {
+        /// @brief Time the latest frames spent waiting to be paced
+        struct FramePacingStats {
+            double limiterMilliseconds; ///< Time the latest #lov::Graphics::Window::waitForNextFrame slept
+            double fenceMilliseconds;   ///< Time the latest #lov::Graphics::Window::swapBuffers waited on the GPU
+            lov_uint framesInFlight;    ///< Frames swapped that the GPU hadn't finished, after that wait
+        };
+
+        /// @brief Counters of how much a #lov::Graphics::Window in low power mode drew and waited
+        struct IdleStats {
+            uint64_t framesDrawn;               ///< Frames #lov::Graphics::Window::needsRedraw allowed
+            uint64_t waits;                     ///< Times #lov::Graphics::Window::pollEvents waited for events
+            std::chrono::nanoseconds lastWait;  ///< Time the latest #lov::Graphics::Window::pollEvents waited
+            double framesPerSecond;             ///< Frames drawn per second, over the latest second measured
+            double frameMilliseconds;           ///< Average time spent on each frame drawn, not counting waits
+            double cpuUsage;                    ///< Fraction of one core the process used, over the latest second
+        };
+
+        /// @brief Where a #lov::Graphics::Window draws
+        enum class WindowMode {
+            Windowed,   ///< A window on screen
+            Headless    ///< An offscreen framebuffer with no window, for benchmarks and tests run unattended
+        };
+
         /// @brief A window that encapsulates the window and OpenGL context
+        ///
+        /// A headless window draws into a framebuffer of its own, bound in place of the default one, so rendering code
+        /// doesn't need to know the difference. When the engine is built with EGL, its context is surfaceless and
+        /// needs no display server, such as on a CI machine running Mesa's llvmpipe; otherwise it's the context of a
+        /// GLFW window that's never shown. It has no input, and is open until #close is called.
         class Window {
         public:
             /// @brief Create and open a new window
             /// @param width The width of the window
             /// @param height The height of the window
             /// @param title The name dispalyed at the top of the window
-            Window(unsigned int width, unsigned int height, const std::string& title);
+            /// @param mode Whether to show the window or draw offscreen
+            /// @throws #lov::Exceptions::WindowException if no context could be created
+            Window(unsigned int width, unsigned int height, const std::string& title, WindowMode mode = WindowMode::Windowed);
 
             /// @brief Terminate OpenGL and the window context
             ~Window();
@@ -28,6 +64,9 @@ namespace lov {
             /// @brief Set this window's context as the current context
             void makeCurrent();
 
+            /// @brief Detach this window's context from the calling thread, so another thread can make it current
+            void releaseCurrent();
+
             /// @brief Should the cursor be hidden, keeping it at the center of the window?
             /// @param hide Whether the cursor should be hidden
             void hideCursor(bool hide);
@@ -46,14 +85,76 @@ namespace lov {
             /// @param alpha The optional alpha component
             void setClearColor(float red, float green, float blue, float alpha = 1.0f);
 
-            /// @brief Clear this windows buffer
+            /// @brief Clear this windows buffer, first resizing the viewport if the framebuffer was resized
             void clear();
 
-            /// @brief Swap buffers and and poll events for this window
+            /// @brief Swap buffers, wait for the next frame and poll events for this window
             void update();
 
+            /// @brief Swap buffers, on the thread the context is current on
+            ///
+            /// Then waits until no more than the maximum frames in flight are left unfinished on the GPU, so the CPU
+            /// can't queue frames far ahead of what's shown, each one adding to the delay between input and display.
+            void swapBuffers();
+
+            /// @brief Sleep until the next frame should start under the frame rate limit, on the thread that polls events
+            ///
+            /// Call it right before #pollEvents, as #update does, so input is sampled after the wait rather than
+            /// before it, as close as possible to when the frame is drawn.
+            void waitForNextFrame();
+
+            /// @brief Poll events, on the thread that created this window
+            ///
+            /// In low power mode, when no redraw is needed, waits for an event instead, up to the idle timeout.
+            void pollEvents();
+
+            /// @brief Should events be waited for rather than polled when nothing needs drawing?
+            ///
+            /// For tools and editors, whose view only changes on input, so an idle window uses next to no CPU.
+            /// Input, resizes and #requestRedraw wake the wait; the timeout bounds how long anything else that
+            /// doesn't request a redraw can go unnoticed.
+            /// @param enabled Whether to use low power mode
+            /// @param timeoutSeconds The longest to wait for an event
+            void setLowPowerMode(bool enabled, double timeoutSeconds = 1.0);
+
+            /// @brief Ask for another frame to be drawn, such as while something animates or after an asset loads.
+            /// Any thread may call this, and it wakes a #pollEvents that's waiting
+            void requestRedraw();
+
+            /// @brief Should a frame be drawn? Always true outside of low power mode
+            /// @return Whether input, a resize or #requestRedraw happened since the previous call
+            bool needsRedraw();
+
+            /// @brief Get the counters of drawing and waiting
+            /// @return The stats
+            IdleStats getIdleStats() const;
+
+            /// @brief Set the name displayed at the top of the window
+            /// @param title The title
+            void setTitle(const std::string& title);
+
+            /// @brief Set the number of vertical blanks to wait for before swapping, on the thread the context is current on
+            /// @param interval 0 to swap immediately, 1 to sync to every refresh, 2 to every other, and so on
+            /// @param adaptive Swap immediately rather than wait for the next blank when a frame misses one, to avoid
+            /// halving the frame rate. Only used if the driver supports it
+            /// @return Whether adaptive sync is in use
+            bool setSwapInterval(int interval, bool adaptive = false);
+
+            /// @brief Set the most frames per second #waitForNextFrame allows
+            /// @param framesPerSecond The limit, or 0 for none
+            void setFrameRateLimit(double framesPerSecond);
+
+            /// @brief Set the most frames #swapBuffers lets the GPU have unfinished
+            /// @param frames The limit, where 1 lets the GPU draw one frame while the next is recorded, or 0 for none
+            void setMaxFramesInFlight(lov_uint frames);
+
+            /// @brief Get the time the latest frames spent being paced
+            /// @return The stats
+            FramePacingStats getPacingStats() const;
+
             /// @brief Gets the difference in time between this call and the previous call of this function
             /// @return The time difference in seconds
+            /// @see #lov::System::FrameClock for fixed simulation steps measured with a steady clock
             float getDeltaTime();
 
             /// @brief Get the state of a key for this window
@@ -69,10 +170,62 @@ namespace lov {
             /// @return The difference between the current cursor position and the previous
             Vector2f getCursorOffset();
 
+            /// @brief Get the queue every key, mouse button, cursor and scroll event of this window is recorded into
+            ///
+            /// Events are pushed while #pollEvents runs, so call #lov::Input::InputQueue::update once a frame on the
+            /// thread reading input to apply them.
+            /// @return The queue
+            Input::InputQueue& getInput();
+
+            /// @brief Should cursor motion be read unscaled and unaccelerated, while the cursor is hidden?
+            /// @param raw Whether to use raw motion
+            /// @return Whether raw motion is in use, which needs the cursor hidden and platform support
+            bool setRawMouseMotion(bool raw);
+
+            /// @brief Is this window drawing offscreen?
+            /// @return Whether it was created with #lov::Graphics::WindowMode::Headless
+            bool isHeadless() const;
+
+            /// @brief Read back what's been drawn, on the thread the context is current on
+            ///
+            /// Reads the back buffer of a window on screen, so call it before #swapBuffers.
+            /// @return The framebuffer's pixels as RGBA bytes, row by row from the bottom
+            std::vector<uint8_t> readPixels() const;
+
         private:
-            ///Internal pointer to GLFW window
+            /// @brief Create a context with no window through EGL, leaving it current
+            /// @throws #lov::Exceptions::WindowException if EGL can't create one
+            void createSurfacelessContext();
+
+            /// @brief Delete the cached sampler objects, then destroy the context along with the EGL display or GLFW window it was made with
+            void destroyContext();
+
+            /// @brief Create the offscreen framebuffer of a headless window and bind it in place of the default one
+            /// @param width The width of the framebuffer
+            /// @param height The height of the framebuffer
+            /// @throws #lov::Exceptions::WindowException if the framebuffer isn't complete
+            void createOffscreenFramebuffer(unsigned int width, unsigned int height);
+
+            ///Internal pointer to GLFW window, or null for a headless window created through EGL
             GLFWwindow* m_window;
 
+            // Whether to show the window or draw offscreen
+            WindowMode m_mode;
+
+            // EGL display of a surfaceless context, held as the EGLDisplay handle it is so EGL stays out of this header
+            void* m_eglDisplay;
+
+            // EGL context with no window
+            void* m_eglContext;
+
+            // Has a headless window without a GLFW window been closed?
+            bool m_closed;
+
+            // Offscreen framebuffer of a headless window, and its color and depth renderbuffers
+            GLuint m_framebuffer;
+            GLuint m_colorBuffer;
+            GLuint m_depthBuffer;
+
             // Mouse cursor position
             Vector2f m_mousePos;
 
@@ -85,8 +238,65 @@ namespace lov {
             // Has the mouse moved yet?
             bool m_mouseMoved;
 
-            // Time of the most recent frame
-            float m_recentFrameTime;
+            // Time of the most recent frame, from a steady clock so it stays precise however long the window is open
+            System::FrameClock::Clock::time_point m_recentFrameTime;
+
+            // Framebuffer width from the latest resize, applied by the thread the context is current on
+            std::atomic<int> m_framebufferWidth;
+
+            // Framebuffer height from the latest resize
+            std::atomic<int> m_framebufferHeight;
+
+            // Has the framebuffer been resized since the viewport was last set?
+            std::atomic<bool> m_resized;
+
+            // Time between frames under the frame rate limit, or zero for no limit
+            std::chrono::nanoseconds m_framePeriod;
+
+            // When the next frame may start under the frame rate limit
+            System::FrameClock::Clock::time_point m_nextFrame;
+
+            // Most frames the GPU may have unfinished, or 0 for no limit. Set from any thread, read by the context's
+            std::atomic<lov_uint> m_maxFramesInFlight;
+
+            // A fence after each swapped frame the GPU may not have finished, oldest first, used by the context's thread
+            std::deque<GLsync> m_frameFences;
+
+            // Time the latest limiter wait took
+            std::atomic<double> m_limiterMilliseconds;
+
+            // Time the latest fence wait took
+            std::atomic<double> m_fenceMilliseconds;
+
+            // Frames in flight after the latest fence wait
+            std::atomic<lov_uint> m_framesInFlight;
+
+            // Every input event, pushed by the callbacks as events are polled
+            Input::InputQueue m_input;
+
+            // Should events be waited for when nothing needs drawing?
+            bool m_lowPower;
+
+            // Longest to wait for an event in low power mode
+            double m_idleTimeout;
+
+            // Has something happened that needs a frame drawn?
+            std::atomic<bool> m_redraw;
+
+            // Counters of drawing and waiting
+            IdleStats m_idleStats;
+
+            // When the current second of idle stats started measuring
+            System::FrameClock::Clock::time_point m_idleMeasureStart;
+
+            // Process CPU time when the current second started measuring
+            std::chrono::nanoseconds m_idleMeasureCpu;
+
+            // Frames drawn in the current second
+            uint64_t m_idleMeasureFrames;
+
+            // Time waited in the current second
+            std::chrono::nanoseconds m_idleMeasureWaited;
         };
     }
 }
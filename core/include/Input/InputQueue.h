@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include "System/FrameClock.h"
+#include "System/SpscQueue.h"
+#include "System/Vector.h"
+
+/// @file InputQueue.h
+/// @brief Defines the #lov::Input::InputQueue that records input events as they happen and snapshots them per frame
+
+namespace lov {
+    namespace Input {
+        /// @brief What an #lov::Input::InputEvent records
+        enum class InputEventType : uint8_t {
+            KeyPress,       ///< A key went down
+            KeyRelease,     ///< A key went up
+            ButtonPress,    ///< A mouse button went down
+            ButtonRelease,  ///< A mouse button went up
+            CursorMove,     ///< The cursor moved, unaccelerated if raw mouse motion is on
+            Scroll          ///< The scroll wheel or touchpad scrolled
+        };
+
+        /// @brief One input event, stamped with when it was received
+        struct InputEvent {
+            InputEventType type;                        ///< What happened
+            int code;                                   ///< The #lov::Input::KeyCode or #lov::Input::MouseButton
+            Vector2f value;                             ///< The cursor position, or the scroll offset
+            System::FrameClock::Clock::time_point time; ///< When the event was received
+        };
+
+        /// @brief Counters of an #lov::Input::InputQueue
+        struct InputQueueStats {
+            uint64_t events;    ///< Events consumed by #lov::Input::InputQueue::update
+            uint64_t dropped;   ///< Events dropped because the queue was full
+        };
+
+        /// @brief Records every input event with a timestamp and turns them into a snapshot of each frame's input
+        ///
+        /// The thread polling window events pushes into a lock-free ring, and the thread running the frame pops
+        /// them all in #update. Every event is applied in order, so a key pressed and released within one frame
+        /// still reads as pressed that frame, and every cursor move adds to the frame's motion rather than only the
+        /// last position counting. The events themselves are kept until the next #update for anything that wants
+        /// their exact timing. Reading key state is then a bit test rather than a call into the windowing library.
+        class InputQueue {
+        public:
+            /// @brief Construct a queue with nothing pressed
+            /// @param capacity Events held between updates before new ones are dropped
+            explicit InputQueue(uint64_t capacity = 1024);
+
+            /// @brief Record an event. Only the thread polling events may call this
+            /// @param event The event
+            void push(const InputEvent& event);
+
+            /// @brief Apply every event pushed since the last update, replacing the previous frame's snapshot. Only the
+            /// thread reading input may call this
+            void update();
+
+            /// @brief Is a key down?
+            /// @param key The key
+            /// @return Whether it was down at the end of the latest update
+            bool isDown(KeyCode key) const;
+
+            /// @brief Was a key pressed during the latest update, even if it's since been released?
+            /// @param key The key
+            /// @return Whether it was pressed
+            bool wasPressed(KeyCode key) const;
+
+            /// @brief Was a key released during the latest update?
+            /// @param key The key
+            /// @return Whether it was released
+            bool wasReleased(KeyCode key) const;
+
+            /// @brief Is a mouse button down?
+            /// @param button The button
+            /// @return Whether it was down at the end of the latest update
+            bool isDown(MouseButton button) const;
+
+            /// @brief Was a mouse button pressed during the latest update, even if it's since been released?
+            /// @param button The button
+            /// @return Whether it was pressed
+            bool wasPressed(MouseButton button) const;
+
+            /// @brief Was a mouse button released during the latest update?
+            /// @param button The button
+            /// @return Whether it was released
+            bool wasReleased(MouseButton button) const;
+
+            /// @brief Get where the cursor was at the end of the latest update
+            /// @return The position in screen space
+            Vector2f getCursorPosition() const;
+
+            /// @brief Get how far the cursor moved during the latest update, adding every move
+            /// @return The motion in screen space, where y grows downwards
+            Vector2f getCursorDelta() const;
+
+            /// @brief Get how far the wheel scrolled during the latest update
+            /// @return The scroll offset
+            Vector2f getScrollDelta() const;
+
+            /// @brief Get the events the latest update applied
+            /// @return The events, oldest first
+            std::span<const InputEvent> getEvents() const;
+
+            /// @brief Get the counters
+            /// @return The counters
+            InputQueueStats getStats() const;
+
+        private:
+            /// @brief Is a key code one the bitsets have room for?
+            /// @param code The code
+            /// @return Whether it is
+            static bool isKey(int code);
+
+            /// @brief Is a button code one the bitsets have room for?
+            /// @param code The code
+            /// @return Whether it is
+            static bool isButton(int code);
+
+            System::SpscQueue<InputEvent> m_queue;          ///< Events not yet applied
+            std::atomic<uint64_t> m_dropped;                ///< Events the producer dropped
+            std::vector<InputEvent> m_events;               ///< Events the latest update applied
+
+            std::bitset<KEY_LAST + 1> m_keysDown;           ///< Keys down
+            std::bitset<KEY_LAST + 1> m_keysPressed;        ///< Keys pressed during the latest update
+            std::bitset<KEY_LAST + 1> m_keysReleased;       ///< Keys released during the latest update
+            std::bitset<MOUSE_BUTTON_LAST + 1> m_buttonsDown;       ///< Buttons down
+            std::bitset<MOUSE_BUTTON_LAST + 1> m_buttonsPressed;    ///< Buttons pressed during the latest update
+            std::bitset<MOUSE_BUTTON_LAST + 1> m_buttonsReleased;   ///< Buttons released during the latest update
+
+            Vector2f m_cursorPosition;                      ///< Latest cursor position
+            Vector2f m_cursorDelta;                         ///< Cursor motion during the latest update
+            Vector2f m_scrollDelta;                         ///< Scrolling during the latest update
+            bool m_cursorKnown;                             ///< Has the cursor moved yet, so motion can be measured?
+            uint64_t m_eventCount;                          ///< Events applied
+        };
+    }
+}
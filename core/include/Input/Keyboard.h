@@ -1,7 +1,5 @@
 #pragma once
 
-#include "Graphics/Window.h"
-
 /// @file Keyboard.h
 /// @brief Defines enumerations for reading keyboard state
 /// @see See #lov::Input::KeyState for available key states
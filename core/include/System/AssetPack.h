@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "System/Types.h"
+
+/// @file AssetPack.h
+/// @brief Defines the #lov::System::AssetPack archive of resources that is memory mapped instead of read file by file
+
+namespace lov {
+    namespace System {
+        /// @brief A read only archive of resources, memory mapped so each asset is a view straight into the page cache
+        ///
+        /// The file starts with a header, then an open addressing hash table of names, then the names, then every asset's
+        /// bytes aligned to #ALIGNMENT. Looking an asset up hashes its name and probes the table, so nothing is opened,
+        /// read or copied per asset, and processes mapping the same pack share its pages. Integers are little endian.
+        /// Names are paths relative to the packed directory with forward slashes, such as "Shaders/basic.vs".
+        class AssetPack {
+        public:
+            /// @brief Alignment of every asset's bytes within the file
+            static constexpr size_t ALIGNMENT = 64;
+
+            /// @brief Map a pack file
+            /// @param path The file path of the pack
+            /// @throws #lov::Exceptions::AssetException if the file can't be mapped or isn't a valid pack
+            explicit AssetPack(const std::string& path);
+
+            /// @brief Unmap the pack. Views returned by #find and #get become invalid
+            ~AssetPack();
+
+            AssetPack(const AssetPack&) = delete;
+            AssetPack& operator=(const AssetPack&) = delete;
+
+            /// @brief Look up an asset
+            /// @param name The name of the asset
+            /// @return A view of its bytes, or an empty view if the pack doesn't hold it
+            std::span<const std::byte> find(std::string_view name) const;
+
+            /// @brief Look up an asset that must exist
+            /// @param name The name of the asset
+            /// @return A view of its bytes
+            /// @throws #lov::Exceptions::AssetException if the pack doesn't hold it
+            std::span<const std::byte> get(std::string_view name) const;
+
+            /// @brief Does the pack hold an asset?
+            /// @param name The name of the asset
+            /// @return Whether it's in the pack
+            bool contains(std::string_view name) const;
+
+            /// @brief Get the number of assets in the pack
+            /// @return The count
+            lov_size getAssetCount() const;
+
+            /// @brief Hash an asset name for the directory, using 64 bit FNV-1a
+            /// @param name The name
+            /// @return The hash
+            static std::uint64_t hashName(std::string_view name);
+
+        private:
+            /// @brief Find the directory slot of an asset
+            /// @param name The name of the asset
+            /// @return The slot index, or the slot count if it isn't in the pack
+            lov_uint findSlot(std::string_view name) const;
+
+            /// @brief Check the header and every directory slot lie within the file, so lookups never have to
+            /// @throws #lov::Exceptions::AssetException if anything is out of bounds
+            void validate();
+
+            /// @brief Release the mapping
+            void unmap();
+
+            const std::byte* m_data;    ///< Start of the mapping
+            size_t m_size;              ///< Size of the mapping
+            lov_uint m_assetCount;      ///< Assets in the pack
+            lov_uint m_slotCount;       ///< Slots in the directory, a power of two
+            void* m_file;               ///< Windows file handle, unused elsewhere
+            void* m_mapping;            ///< Windows file mapping handle, unused elsewhere
+        };
+
+        /// @brief Collects assets and writes them as an #lov::System::AssetPack file
+        class AssetPackWriter {
+        public:
+            /// @brief Add an asset
+            /// @param name The name the asset is looked up by
+            /// @param contents The bytes of the asset
+            /// @throws #lov::Exceptions::AssetException if the name is empty or already added
+            void add(const std::string& name, std::vector<std::byte> contents);
+
+            /// @brief Add the contents of a file as an asset
+            /// @param name The name the asset is looked up by
+            /// @param path The file path
+            /// @throws #lov::Exceptions::AssetException if the file can't be read or the name is taken
+            void addFile(const std::string& name, const std::string& path);
+
+            /// @brief Serialize the assets as a pack
+            /// @return The file contents
+            std::vector<std::byte> write() const;
+
+            /// @brief Write the assets to a pack file
+            /// @param path The file path
+            /// @throws #lov::Exceptions::AssetException if the file can't be written
+            void writeFile(const std::string& path) const;
+
+            /// @brief Get the number of assets added
+            /// @return The count
+            lov_size getAssetCount() const;
+
+        private:
+            /// @brief An asset waiting to be written
+            struct Asset {
+                std::string name;                   ///< The name it's looked up by
+                std::vector<std::byte> contents;    ///< Its bytes
+            };
+
+            std::vector<Asset> m_assets;            ///< Assets in the order they were added
+        };
+    }
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "System/AsyncIO.h"
+#include "System/Task.h"
+#include "System/ThreadPool.h"
+#include "System/Types.h"
+
+/// @file AssetStreamer.h
+/// @brief Defines the #lov::System::AssetStreamer that loads assets as they're needed, nearest first, within memory budgets
+
+namespace lov {
+    namespace System {
+        /// @brief The kinds of asset that have their own memory budget
+        enum class AssetType {
+            Texture,    ///< Images and texture layers
+            Mesh,       ///< Vertex and index buffers
+            Count       ///< The number of types
+        };
+
+        /// @brief How an #lov::System::AssetStreamer turns an asset's bytes into a live resource and back
+        struct AssetCallbacks {
+            /// @brief Optional. Runs on a worker with the asset's bytes and returns what #load is given, such as decoded
+            /// pixels. Throw #lov::Exceptions::Exception to fail the load
+            std::function<std::vector<std::byte>(std::span<const std::byte> bytes)> decode;
+
+            /// @brief Runs inside #AssetStreamer::update on its thread with the decoded bytes, or the asset's own bytes
+            /// without #decode. Creates the resource, swaps it into whatever renders it, and returns its size in bytes
+            /// against the budget of its type. Throw #lov::Exceptions::Exception to fail the load
+            std::function<size_t(std::span<const std::byte> data)> load;
+
+            /// @brief Runs inside #AssetStreamer::update when the resource is evicted or removed, to release it and swap
+            /// a fallback back in
+            std::function<void()> evict;
+        };
+
+        /// @brief Counters reported by an #lov::System::AssetStreamer
+        struct AssetStreamerStats {
+            lov_size assetCount;                                                ///< Assets added and not removed
+            lov_size residentCount;                                             ///< Assets loaded
+            lov_size inFlightCount;                                             ///< Assets being read or decoded
+            lov_size waitingCount;                                              ///< Requested assets waiting for a free slot
+            std::array<size_t, static_cast<size_t>(AssetType::Count)> residentBytes; ///< Loaded bytes of each type
+            lov_size loads;                                                     ///< Assets loaded so far
+            lov_size evictions;                                                 ///< Assets evicted to stay within budget
+            lov_size cancellations;                                             ///< Loads cancelled before they finished
+            lov_size failures;                                                  ///< Loads that couldn't be read, decoded or loaded
+        };
+
+        /// @brief Streams assets in as they're requested and out when their type is over budget
+        ///
+        /// Assets are added up front with nothing read, so adding them costs the same however large they are. Each frame
+        /// callers #request the assets they're about to draw with their distance from the camera, and #update starts
+        /// the nearest missing ones, up to a limit in flight at once. Files are read with #lov::System::AsyncIO and
+        /// decoded on the thread pool, while assets in a memory mapped #lov::System::AssetPack skip the read. Finished
+        /// assets are handed to their load callback inside #update, so render components can swap them in on the GL thread.
+        ///
+        /// When every slot is taken, a waiting request cancels an in-flight load nobody requested this frame to take its
+        /// slot. When a type's loaded bytes exceed its budget, the assets of that type requested least recently are
+        /// evicted, except those requested this frame, and no more of that type are started. Use from one thread only.
+        class AssetStreamer {
+        public:
+            /// @brief Construct an empty AssetStreamer
+            /// @param io Reads asset files, which must outlive this AssetStreamer
+            /// @param pool Decodes assets, which must outlive this AssetStreamer
+            /// @param maxInFlight The most assets read or decoded at once
+            explicit AssetStreamer(AsyncIO& io, ThreadPool& pool, lov_size maxInFlight = 8);
+
+            /// @brief Wait for decodes in progress. Loaded assets are left as they are, without their evict callbacks
+            ~AssetStreamer();
+
+            AssetStreamer(const AssetStreamer&) = delete;
+            AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+            /// @brief Add an asset read from a file when it's needed
+            /// @param path The file path
+            /// @param type The budget it counts against
+            /// @param callbacks How it's loaded and evicted
+            /// @return The ID used to request it
+            lov_uint add(const std::string& path, AssetType type, AssetCallbacks callbacks);
+
+            /// @brief Add an asset already in memory, such as an #lov::System::AssetPack view, decoded when it's needed
+            /// @param bytes The asset's bytes, which must outlive the asset
+            /// @param type The budget it counts against
+            /// @param callbacks How it's loaded and evicted
+            /// @return The ID used to request it
+            lov_uint add(std::span<const std::byte> bytes, AssetType type, AssetCallbacks callbacks);
+
+            /// @brief Evict an asset if it's loaded, cancel it if it's loading, and forget it. Its ID may be reused
+            /// @param asset The ID returned by #add
+            void remove(lov_uint asset);
+
+            /// @brief Ask for an asset to be loaded, or kept loaded, this frame. The nearest request of the frame wins
+            /// @param asset The ID returned by #add
+            /// @param distance Its distance from the camera. Nearer assets load first
+            void request(lov_uint asset, float distance);
+
+            /// @brief Stop loading an asset. It loads again if it's requested again
+            /// @param asset The ID returned by #add
+            void cancel(lov_uint asset);
+
+            /// @brief Hand finished assets to their load callbacks for at most the given time, start loading the nearest
+            /// requested assets, evict assets over budget, and begin the next frame
+            /// @param budgetMilliseconds The time this call may spend in load callbacks
+            /// @throws #lov::Exceptions::AssetException naming the first asset that failed this update. Failed assets
+            /// aren't loaded again until they're removed and added again
+            void update(double budgetMilliseconds);
+
+            /// @brief Change the memory the loaded assets of a type may use. Assets over it are evicted by the next #update
+            /// @param type The type
+            /// @param budgetBytes The new budget
+            void setBudget(AssetType type, size_t budgetBytes);
+
+            /// @brief Change the most assets read or decoded at once
+            /// @param maxInFlight The new limit
+            void setMaxInFlight(lov_size maxInFlight);
+
+            /// @brief Is an asset loaded?
+            /// @param asset The ID returned by #add
+            /// @return Whether its load callback has run and it hasn't been evicted since
+            bool isResident(lov_uint asset) const;
+
+            /// @brief Get the counters of this AssetStreamer
+            /// @return The stats
+            AssetStreamerStats getStats() const;
+
+        private:
+            /// @brief Where an asset is in its life
+            enum class State {
+                Unloaded,   ///< Not loaded or loading
+                Loading,    ///< Being read or decoded, or waiting for its load callback
+                Resident,   ///< Loaded
+                Failed      ///< Couldn't be loaded
+            };
+
+            /// @brief An asset being read or decoded, shared with the coroutine and worker doing it
+            struct Load {
+                lov_uint asset;                 ///< The ID of the asset
+                std::atomic<bool> cancelled;    ///< Was the asset cancelled or removed since?
+                std::vector<std::byte> data;    ///< The bytes read, then decoded
+                std::string error;              ///< Why the load failed, or empty
+            };
+
+            /// @brief An added asset
+            struct Entry {
+                std::string path;                   ///< The file path, or empty for an asset in memory
+                std::span<const std::byte> bytes;   ///< The asset's bytes if it's in memory
+                AssetType type;                     ///< The budget it counts against
+                AssetCallbacks callbacks;           ///< How it's loaded and evicted
+                State state;                        ///< Where it is in its life
+                size_t residentBytes;               ///< The size its load callback returned
+                bool requested;                     ///< Was it requested this frame?
+                float distance;                     ///< Nearest distance requested this frame
+                lov_uint lastRequested;             ///< Frame it was last requested, 0 if never
+                std::shared_ptr<Load> load;         ///< The load in progress while Loading
+                Task task;                          ///< The coroutine reading its file while Loading
+            };
+
+            /// @brief Add an asset to a free slot
+            /// @param entry The asset
+            /// @return Its ID
+            lov_uint addEntry(Entry entry);
+
+            /// @brief Start loading an asset
+            /// @param asset The ID of the asset
+            void start(lov_uint asset);
+
+            /// @brief Read an asset's file, then decode it or queue it for its load callback
+            /// @param load The load
+            /// @param path The file path
+            /// @return The coroutine, which finishes once the file is read
+            Task read(std::shared_ptr<Load> load, std::string path);
+
+            /// @brief Decode an asset's bytes on the thread pool, then queue it for its load callback
+            /// @param load The load
+            /// @param bytes The bytes to decode, which must outlive the decode
+            void decode(std::shared_ptr<Load> load, std::span<const std::byte> bytes);
+
+            /// @brief Queue a load for its load callback. May be called from any thread
+            /// @param load The load
+            void finish(std::shared_ptr<Load> load);
+
+            /// @brief Hand the next finished load to its load callback
+            /// @param error Set to why the asset failed, if it did and error is empty
+            /// @return Whether there was a load to hand over
+            bool loadNext(std::string& error);
+
+            /// @brief Stop an asset's load in progress
+            /// @param entry The asset, which must be Loading
+            void stop(Entry& entry);
+
+            /// @brief Evict the least recently requested assets of a type, other than those requested this frame, until
+            /// it fits its budget
+            /// @param type The type
+            void evict(AssetType type);
+
+            /// @brief Release a resident asset
+            /// @param entry The asset
+            void evictEntry(Entry& entry);
+
+            AsyncIO& m_io;                                                  ///< Reads asset files
+            ThreadPool& m_pool;                                             ///< Decodes assets
+            lov_size m_maxInFlight;                                         ///< Most assets read or decoded at once
+            std::array<size_t, static_cast<size_t>(AssetType::Count)> m_budgets; ///< Memory each type may use
+            lov_uint m_frame;                                               ///< Number of updates so far, plus one
+
+            std::vector<Entry> m_entries;                                   ///< Asset slots, reused after assets are removed
+            std::vector<lov_uint> m_freeEntries;                            ///< IDs of removed slots
+            std::vector<lov_uint> m_requested;                              ///< Assets requested this frame
+            lov_size m_inFlight;                                            ///< Loads being read or decoded, or waiting for their load callback
+
+            std::mutex m_mutex;                                             ///< Guards m_finished
+            std::deque<std::shared_ptr<Load>> m_finished;                   ///< Loads waiting for their load callback
+            std::vector<std::future<void>> m_decoding;                      ///< Decodes still running or not yet collected
+
+            AssetStreamerStats m_stats;                                     ///< Counters reported by getStats
+        };
+    }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "System/ThreadPool.h"
+#include "System/Types.h"
+
+/// @file AsyncIO.h
+/// @brief Defines the #lov::System::AsyncIO file reader that coroutines await instead of blocking on each file
+
+namespace lov {
+    namespace System {
+        /// @brief Reads whole files asynchronously for coroutines such as #lov::System::Task
+        ///
+        /// A coroutine writes `std::vector<std::byte> source = co_await io.read(path);` and is suspended until the file
+        /// has been read, so hundreds of reads can be in flight at once instead of each blocking in turn. On Linux reads
+        /// are submitted to an io_uring, so the kernel services them without a thread each. Reads are queued as they're
+        /// awaited and handed to the kernel together by #flush, #poll or #wait, so a frame's reads cost one system call. Elsewhere, or where the kernel
+        /// doesn't allow io_uring, each read runs on the thread pool instead. Either way, finished reads only resume their
+        /// coroutines inside #poll or #wait, on the thread calling it, so a coroutine that loads a texture can upload it
+        /// straight after the read if that's the GL thread. Use from one thread only.
+        ///
+        /// Destroying a coroutine suspended on a read, such as by destroying its Task, cancels its resumption, and the
+        /// read finishes into memory this AsyncIO keeps alive until then.
+        class AsyncIO {
+        public:
+            /// @brief How reads are carried out
+            enum class Backend {
+                IoUring,    ///< Submitted to a Linux io_uring
+                ThreadPool  ///< Read on the thread pool with blocking calls
+            };
+
+        private:
+            struct Request;
+
+            /// @brief Counts the reads a suspended coroutine is waiting for
+            struct Waiter {
+                std::coroutine_handle<> handle; ///< The coroutine to resume, or null once resumed
+                size_t remaining;               ///< Reads still to finish
+            };
+
+        public:
+            /// @brief Awaitable read of one file, returned by #read
+            class ReadOperation {
+            public:
+                /// @brief Prepare a read that starts when awaited
+                /// @param io The AsyncIO that carries it out
+                /// @param path The file path
+                ReadOperation(AsyncIO& io, std::string path);
+
+                /// @brief Always suspend, since the read only starts when awaited
+                /// @return False
+                bool await_ready() const noexcept;
+
+                /// @brief Submit the read, resuming the coroutine once it finishes
+                /// @param handle The awaiting coroutine
+                void await_suspend(std::coroutine_handle<> handle);
+
+                /// @brief Hand the contents to the coroutine
+                /// @return The contents of the file
+                /// @throws #lov::Exceptions::IOException if the file couldn't be read
+                std::vector<std::byte> await_resume();
+
+                /// @brief Stop the read from resuming the coroutine, if it's destroyed while the read is in flight
+                ~ReadOperation();
+
+                ReadOperation(const ReadOperation&) = delete;
+                ReadOperation& operator=(const ReadOperation&) = delete;
+
+            private:
+                AsyncIO& m_io;                      ///< Carries out the read
+                std::shared_ptr<Request> m_request; ///< The read
+                Waiter m_waiter;                    ///< The awaiting coroutine
+            };
+
+            /// @brief Awaitable read of many files at once, returned by #readAll
+            class BatchReadOperation {
+            public:
+                /// @brief Prepare reads that start when awaited
+                /// @param io The AsyncIO that carries them out
+                /// @param paths The file paths
+                BatchReadOperation(AsyncIO& io, const std::vector<std::string>& paths);
+
+                /// @brief Only suspend if there is anything to read
+                /// @return Whether there are no paths
+                bool await_ready() const noexcept;
+
+                /// @brief Submit every read, resuming the coroutine once the last finishes
+                /// @param handle The awaiting coroutine
+                void await_suspend(std::coroutine_handle<> handle);
+
+                /// @brief Hand the contents to the coroutine
+                /// @return The contents of each file, in the order of the paths
+                /// @throws #lov::Exceptions::IOException naming the first file that couldn't be read
+                std::vector<std::vector<std::byte>> await_resume();
+
+                /// @brief Stop the reads from resuming the coroutine, if it's destroyed while they're in flight
+                ~BatchReadOperation();
+
+                BatchReadOperation(const BatchReadOperation&) = delete;
+                BatchReadOperation& operator=(const BatchReadOperation&) = delete;
+
+            private:
+                AsyncIO& m_io;                                      ///< Carries out the reads
+                std::vector<std::shared_ptr<Request>> m_requests;   ///< The reads
+                Waiter m_waiter;                                    ///< The awaiting coroutine
+            };
+
+            /// @brief Start the backend
+            /// @param pool The pool reads run on when io_uring isn't used, which must outlive this AsyncIO
+            /// @param queueDepth The most reads submitted to the kernel at once. More are queued until there is room
+            /// @param backend The preferred backend. io_uring falls back to the thread pool if it's unavailable
+            explicit AsyncIO(ThreadPool& pool, lov_uint queueDepth = 256, Backend backend = Backend::IoUring);
+
+            /// @brief Wait for reads in flight, since they write into their coroutines. Their coroutines aren't resumed
+            ~AsyncIO();
+
+            AsyncIO(const AsyncIO&) = delete;
+            AsyncIO& operator=(const AsyncIO&) = delete;
+
+            /// @brief Read a whole file. Once awaited, the read is queued until the next #flush, #poll or #wait
+            /// @param path The file path
+            /// @return An awaitable that produces the contents of the file
+            ReadOperation read(std::string path);
+
+            /// @brief Read many whole files, all in flight at once. Awaiting them submits them together straight away
+            /// @param paths The file paths
+            /// @return An awaitable that produces the contents of each file
+            BatchReadOperation readAll(const std::vector<std::string>& paths);
+
+            /// @brief Hand every queued read that fits in the ring to the kernel with one system call
+            void flush();
+
+            /// @brief Resume the coroutines whose reads have finished, without blocking
+            /// @return The number of coroutines resumed
+            lov_size poll();
+
+            /// @brief Block until every read has finished, resuming coroutines as they do, including any reads they start
+            void wait();
+
+            /// @brief Get the number of reads not yet finished
+            /// @return The pending count
+            lov_size getPendingCount() const;
+
+            /// @brief Get the number of system calls made to submit reads to the kernel
+            /// @return The count, which stays 0 without io_uring
+            lov_size getSubmitCount() const;
+
+            /// @brief Get how reads are carried out
+            /// @return The backend in use
+            Backend getBackend() const;
+
+        private:
+            /// @brief A read of one file
+            struct Request {
+                std::string path;               ///< The file path
+                std::vector<std::byte> data;    ///< The contents read so far, sized to the file
+                size_t offset;                  ///< Bytes read so far
+                int file;                       ///< Open file descriptor while io_uring reads it, otherwise -1
+                std::string error;              ///< Why the read failed, or empty
+                Waiter* waiter;                 ///< The coroutine waiting for it, or null if it was destroyed
+                std::shared_ptr<Request> self;  ///< Keeps the read alive while it's in flight
+            };
+
+            struct Ring;
+
+            /// @brief Start a read
+            /// @param requestPointer The read
+            void submit(const std::shared_ptr<Request>& requestPointer);
+
+            /// @brief Create a read of a file
+            /// @param path The file path
+            /// @return The read
+            static std::shared_ptr<Request> makeRequest(std::string path);
+
+            /// @brief Read a file with blocking calls on a worker
+            /// @param request The read
+            void readOnWorker(Request* request);
+
+            /// @brief Queue as many waiting reads to the ring as fit, and tell the kernel about them with one io_uring_enter
+            void submitToRing();
+
+            /// @brief Handle every read completion the kernel has posted
+            void reapRing();
+
+            /// @brief Record a read as finished, readying its coroutine once it has nothing else to wait for
+            /// @param request The read, released by this AsyncIO
+            void finish(Request* request);
+
+            /// @brief Stop a destroyed coroutine that's queued to resume from being resumed
+            /// @param waiter The waiter of the destroyed operation
+            void cancel(Waiter* waiter);
+
+            /// @brief Collect reads finished by workers
+            void collectFinished();
+
+            ThreadPool& m_pool;                         ///< Runs reads without io_uring
+            std::unique_ptr<Ring> m_ring;               ///< The io_uring, or null
+            std::deque<Request*> m_waiting;             ///< Reads waiting for room in the ring
+            std::deque<Waiter*> m_ready;                ///< Coroutines whose reads have all finished
+            lov_size m_pending;                         ///< Reads not yet finished
+            lov_size m_submitCount;                     ///< System calls made to submit reads
+
+            std::mutex m_mutex;                         ///< Guards m_finished
+            std::condition_variable m_condition;        ///< Signalled when a worker finishes a read
+            std::vector<Request*> m_finished;           ///< Reads finished by workers
+        };
+    }
+}
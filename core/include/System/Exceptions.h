@@ -51,5 +51,65 @@ namespace lov {
             /// @param message The message of this exception
             explicit WindowException(const std::string& message);
         };
+
+        /// @brief Exception involving textures
+        class TextureException : public Exception {
+        public:
+            /// @brief Set the message of this exception with a const char*
+            /// @param message The message of this exception
+            explicit TextureException(const char* message);
+
+            /// @brief Set the message of this exception with a string
+            /// @param message The message of this exception
+            explicit TextureException(const std::string& message);
+        };
+
+        /// @brief Exception involving asset packs
+        class AssetException : public Exception {
+        public:
+            /// @brief Set the message of this exception with a const char*
+            /// @param message The message of this exception
+            explicit AssetException(const char* message);
+
+            /// @brief Set the message of this exception with a string
+            /// @param message The message of this exception
+            explicit AssetException(const std::string& message);
+        };
+
+        /// @brief Exception involving file input and output
+        class IOException : public Exception {
+        public:
+            /// @brief Set the message of this exception with a const char*
+            /// @param message The message of this exception
+            explicit IOException(const char* message);
+
+            /// @brief Set the message of this exception with a string
+            /// @param message The message of this exception
+            explicit IOException(const std::string& message);
+        };
+
+        /// @brief Exception involving meshes
+        class MeshException : public Exception {
+        public:
+            /// @brief Set the message of this exception with a const char*
+            /// @param message The message of this exception
+            explicit MeshException(const char* message);
+
+            /// @brief Set the message of this exception with a string
+            /// @param message The message of this exception
+            explicit MeshException(const std::string& message);
+        };
+
+        /// @brief Exception involving entities and their components
+        class EntityException : public Exception {
+        public:
+            /// @brief Set the message of this exception with a const char*
+            /// @param message The message of this exception
+            explicit EntityException(const char* message);
+
+            /// @brief Set the message of this exception with a string
+            /// @param message The message of this exception
+            explicit EntityException(const std::string& message);
+        };
     }
 }
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "System/Types.h"
+
+/// @file FrameClock.h
+/// @brief Defines the #lov::System::FrameClock that schedules fixed simulation steps between variable rate frames
+
+namespace lov {
+    namespace System {
+        /// @brief Counters from the latest #lov::System::FrameClock::tick
+        struct FrameClockStats {
+            uint64_t frames;        ///< Frames ticked
+            uint64_t steps;         ///< Fixed steps run in total
+            uint64_t droppedSteps;  ///< Steps skipped because a frame fell too far behind
+            lov_uint frameSteps;    ///< Steps due this frame
+        };
+
+        /// @brief Measures frames with std::chrono::steady_clock and schedules a fixed simulation step between them
+        ///
+        /// Time is kept as integer nanoseconds, so it stays exact however long the program runs. Each #tick adds the
+        /// frame's time to an accumulator and returns how many fixed steps are due, so the simulation always advances
+        /// by the same step however fast frames are drawn and runs the same way every time. If a frame falls so far
+        /// behind that more than the maximum steps are due, the extra time is dropped rather than caught up, so one
+        /// slow frame can't make every following frame slower. What's left in the accumulator is how far the frame is
+        /// between the last two steps, so renderers interpolate between them with #getAlpha.
+        class FrameClock {
+        public:
+            /// @brief The clock frames are measured with
+            using Clock = std::chrono::steady_clock;
+
+            /// @brief Construct a clock whose first frame starts now
+            /// @param step The fixed step of the simulation
+            /// @param maxSteps The most steps a single frame may run
+            explicit FrameClock(std::chrono::nanoseconds step = std::chrono::nanoseconds(1000000000 / 60), lov_uint maxSteps = 8);
+
+            /// @brief End the current frame and start the next, measuring its time from the clock
+            /// @return The number of fixed steps to run this frame
+            lov_uint tick();
+
+            /// @brief End the current frame and start the next, which took the given time
+            /// @param elapsed The frame's time
+            /// @return The number of fixed steps to run this frame
+            lov_uint advance(std::chrono::nanoseconds elapsed);
+
+            /// @brief Leave time out of the current frame, such as time spent waiting for events while nothing moved,
+            /// so the next #tick doesn't simulate it
+            /// @param time The time to leave out, at most the time since the frame started
+            void skip(std::chrono::nanoseconds time);
+
+            /// @brief Get the time the latest frame took
+            /// @return The frame's time in seconds
+            double getDeltaTime() const;
+
+            /// @brief Get the fixed step
+            /// @return The step in seconds
+            float getStep() const;
+
+            /// @brief Get how far the frame is between the last two steps, to interpolate between their states
+            /// @return 0 at the last step, up to but not including 1 at the next
+            float getAlpha() const;
+
+            /// @brief Get the simulation time, as the number of steps run times the step
+            /// @return The time in seconds
+            double getTime() const;
+
+            /// @brief Get the counters from the latest #tick
+            /// @return The counters
+            FrameClockStats getStats() const;
+
+            /// @brief Wait until a time more precisely than sleeping alone, which can overshoot by a millisecond or more
+            ///
+            /// Sleeps until shortly before the deadline, then yields in a loop until it passes, so only the last
+            /// #SpinMargin of the wait keeps a core busy.
+            /// @param deadline The time to wait until
+            static void sleepUntil(Clock::time_point deadline);
+
+            /// @brief Get the CPU time every thread of this process has used, to measure CPU usage against wall time
+            /// @return The time used
+            static std::chrono::nanoseconds getProcessCpuTime();
+
+            /// @brief How long before a deadline #sleepUntil stops sleeping and spins
+            static constexpr std::chrono::nanoseconds SpinMargin = std::chrono::microseconds(2000);
+
+        private:
+            std::chrono::nanoseconds m_step;        ///< The fixed step
+            lov_uint m_maxSteps;                    ///< Most steps per frame
+            Clock::time_point m_frameStart;         ///< When the current frame started
+            std::chrono::nanoseconds m_frameTime;   ///< The latest frame's time
+            std::chrono::nanoseconds m_accumulator; ///< Time not yet simulated, less than one step after each tick
+            FrameClockStats m_stats;                ///< Counters
+        };
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "System/Types.h"
+#include "System/WorkStealingDeque.h"
+
+/// @file JobSystem.h
+/// @brief Defines the #lov::System::JobSystem that spreads engine work over every core by work stealing
+
+namespace lov {
+    namespace System {
+        class JobSystem;
+
+        /// @brief Counts the unfinished jobs of a group, so they can be waited on or run other jobs when they finish
+        ///
+        /// A counter must outlive its jobs and the jobs that depend on it, so wait on it before destroying it.
+        class JobCounter {
+        public:
+            /// @brief Construct a counter with no jobs
+            JobCounter();
+
+            JobCounter(const JobCounter&) = delete;
+            JobCounter& operator=(const JobCounter&) = delete;
+
+            /// @brief Have all of its jobs finished?
+            /// @return Whether none are queued or running
+            bool isDone() const;
+
+        private:
+            friend class JobSystem;
+
+            /// @brief A job and the counter it reports to
+            struct Job;
+
+            std::atomic<lov_size> m_count;              ///< Jobs queued, running or waiting on a dependency
+            mutable std::mutex m_mutex;                 ///< Guards m_continuations and m_exception, and each decrement of m_count
+            std::vector<Job*> m_continuations;          ///< Jobs to queue when the count reaches zero
+            std::exception_ptr m_exception;             ///< The first exception a job threw
+        };
+
+        /// @brief Runs jobs on a worker per core, each keeping its own deque and stealing from the others when it runs out
+        ///
+        /// The thread that constructs a JobSystem takes part too: jobs it queues go onto its own deque, and #wait and
+        /// #parallelFor run jobs on it rather than blocking. Jobs queued from any other thread go through a shared queue.
+        /// Idle workers sleep until jobs are queued. #parallelFor splits its range in half repeatedly, pushing one half
+        /// for thieves and keeping the other, so busy workers keep running and idle ones take the biggest pieces left.
+        class JobSystem {
+        public:
+            /// @brief Start the workers
+            /// @param threadCount The number of workers, or 0 for one less than the number of hardware threads, leaving
+            /// one for the constructing thread
+            explicit JobSystem(lov_size threadCount = 0);
+
+            /// @brief Finish queued jobs and join the workers. Jobs still waiting on a dependency never run
+            ~JobSystem();
+
+            JobSystem(const JobSystem&) = delete;
+            JobSystem& operator=(const JobSystem&) = delete;
+
+            /// @brief Queue a job
+            /// @param job The job. If it throws, the exception is rethrown by waiting on its counter, so jobs without
+            /// a counter must not throw
+            /// @param counter Counts the job until it finishes, or null
+            void run(std::function<void()> job, JobCounter* counter = nullptr);
+
+            /// @brief Queue a job once every job of another counter has finished
+            /// @param dependency The counter to wait for, which must outlive the job
+            /// @param job The job
+            /// @param counter Counts the job until it finishes, including while it waits, or null
+            void runAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr);
+
+            /// @brief Queue jobs that split [0, count) into ranges and run the body on each
+            /// @param count The number of items
+            /// @param body Called with [begin, end) ranges that together cover every item exactly once. The jobs share
+            /// ownership of it, so it may be a temporary
+            /// @param counter Counts the ranges until they've all run
+            /// @param grainSize The most items a range is left with, or 0 to choose from the count and number of threads
+            void parallelFor(lov_size count, std::function<void(lov_size begin, lov_size end)> body, JobCounter& counter, lov_size grainSize = 0);
+
+            /// @brief Split [0, count) into ranges, run the body on each, and wait for them all
+            /// @param count The number of items
+            /// @param body Called with [begin, end) ranges that together cover every item exactly once
+            /// @param grainSize The most items a range is left with, or 0 to choose from the count and number of threads
+            void parallelFor(lov_size count, const std::function<void(lov_size begin, lov_size end)>& body, lov_size grainSize = 0);
+
+            /// @brief Run queued jobs on this thread until every job of a counter has finished
+            /// @param counter The counter
+            /// @throws The first exception thrown by one of its jobs, which is then cleared
+            void wait(JobCounter& counter);
+
+            /// @brief Get the number of threads that run jobs
+            /// @return The workers plus the constructing thread
+            lov_size getThreadCount() const;
+
+            /// @brief Get the index of the calling thread, for keeping state per thread that jobs use without locking
+            /// @return 0 for the constructing thread, 1 to #getThreadCount - 1 for workers, or -1 if the thread isn't part
+            /// of this JobSystem
+            lov_int getThreadIndex() const;
+
+        private:
+            using Job = JobCounter::Job;
+
+            /// @brief Queue a job that's ready to run
+            /// @param job The job
+            void push(Job* job);
+
+            /// @brief Take a job from this thread's deque, the shared queue or another thread's deque
+            /// @param index This thread's deque, or -1 if it has none
+            /// @return The job, or null if none were found
+            Job* take(lov_int index);
+
+            /// @brief Run a job, report to its counter and queue the jobs that depended on it
+            /// @param job The job, which is deleted
+            void execute(Job* job);
+
+            /// @brief Queue the jobs that split a range
+            /// @param begin The first item
+            /// @param end One past the last item
+            /// @param body Called on each range, and kept alive by each job that splits off
+            /// @param counter Counts the ranges
+            /// @param grainSize The most items a range is left with
+            void split(lov_size begin, lov_size end, const std::shared_ptr<const std::function<void(lov_size begin, lov_size end)>>& body, JobCounter& counter, lov_size grainSize);
+
+            /// @brief Run jobs until the JobSystem stops
+            /// @param index The deque of this worker
+            void work(lov_int index);
+
+            std::vector<std::unique_ptr<WorkStealingDeque<Job*>>> m_deques;  ///< One per thread, the constructing thread's first
+            std::vector<std::thread> m_workers;                             ///< The worker threads
+
+            std::mutex m_sharedMutex;                                       ///< Guards m_shared
+            std::deque<Job*> m_shared;                                      ///< Jobs queued by threads without a deque
+
+            std::atomic<lov_size> m_queued;                                 ///< Jobs queued and not yet taken
+            std::atomic<lov_size> m_sleeping;                               ///< Workers asleep or about to be
+            std::mutex m_sleepMutex;                                        ///< Guards sleeping and waking
+            std::condition_variable m_wake;                                 ///< Wakes workers when jobs are queued or the JobSystem stops
+            std::atomic<bool> m_stopping;                                   ///< Has the JobSystem been asked to stop?
+
+            JobSystem* m_previous;                                          ///< JobSystem the constructing thread took part in before this one
+        };
+    }
+}
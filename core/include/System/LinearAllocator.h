@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// @file LinearAllocator.h
+/// @brief Defines the #lov::System::LinearAllocator used for memory that lives until the end of a frame
+
+namespace lov {
+    namespace System {
+        /// @brief Hands out memory by bumping an offset through large blocks, freeing it all at once with #reset
+        ///
+        /// Allocating is a few instructions and never locks, so give each thread its own allocator. Blocks are kept
+        /// across resets, so after the first few frames nothing is allocated from the heap at all. Destructors of
+        /// what's allocated never run, so only allocate trivially destructible types.
+        class LinearAllocator {
+        public:
+            /// @brief Construct an allocator with no blocks yet
+            /// @param blockSize The size of each block. Larger allocations get a block of their own
+            explicit LinearAllocator(size_t blockSize = 64 * 1024);
+
+            LinearAllocator(LinearAllocator&&) = default;
+            LinearAllocator& operator=(LinearAllocator&&) = default;
+
+            /// @brief Allocate uninitialized memory
+            /// @param size The size in bytes
+            /// @param alignment The alignment, a power of two
+            /// @return The memory, valid until #reset
+            void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+            /// @brief Allocate and construct an object
+            /// @tparam T The type, which must be trivially destructible
+            /// @param args Arguments for its constructor
+            /// @return The object, valid until #reset
+            template <typename T, typename... Args>
+            inline T* create(Args&&... args) {
+                static_assert(std::is_trivially_destructible_v<T>, "LinearAllocator never runs destructors");
+                return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            }
+
+            /// @brief Free everything allocated, keeping the blocks for reuse
+            void reset();
+
+            /// @brief Get the bytes handed out since the last #reset, including alignment padding
+            /// @return The size in bytes
+            size_t getUsed() const;
+
+            /// @brief Get the bytes held in blocks
+            /// @return The size in bytes
+            size_t getCapacity() const;
+
+        private:
+            /// @brief A block of memory
+            struct Block {
+                std::unique_ptr<std::byte[]> data;  ///< The memory
+                size_t size;                        ///< Its size in bytes
+            };
+
+            size_t m_blockSize;             ///< Size of each new block
+            std::vector<Block> m_blocks;    ///< Every block, in the order they're filled
+            size_t m_block;                 ///< Index of the block being filled
+            size_t m_offset;                ///< Offset of the next allocation in that block
+            size_t m_used;                  ///< Bytes handed out from the blocks before it
+        };
+    }
+}
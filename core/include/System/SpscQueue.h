@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/// @file SpscQueue.h
+/// @brief Defines the #lov::System::SpscQueue that passes items from one thread to another without locking
+
+namespace lov {
+    namespace System {
+        /// @brief A fixed size ring that one thread pushes to and one other thread pops from, without locks
+        ///
+        /// The producer only writes the tail and the consumer only writes the head, each on its own cache line, and
+        /// each keeps a copy of the other's position that it only reloads when the ring looks full or empty, so the
+        /// two threads rarely touch the same cache line. Pushing to a full ring fails rather than blocking or
+        /// growing, so the producer decides what to drop.
+        /// @tparam T The item type, copied in and out
+        template <typename T>
+        class SpscQueue {
+        public:
+            /// @brief Construct an empty queue
+            /// @param capacity The number of items it holds, rounded up to a power of two
+            explicit SpscQueue(uint64_t capacity = 1024);
+
+            SpscQueue(const SpscQueue&) = delete;
+            SpscQueue& operator=(const SpscQueue&) = delete;
+
+            /// @brief Push an item. Only the producing thread may call this
+            /// @param item The item
+            /// @return Whether it was pushed, or false if the queue is full
+            bool push(const T& item);
+
+            /// @brief Pop the item pushed longest ago. Only the consuming thread may call this
+            /// @param item Set to the item
+            /// @return Whether there was an item
+            bool pop(T& item);
+
+            /// @brief Get the number of items it holds
+            /// @return The capacity
+            uint64_t getCapacity() const;
+
+        private:
+            uint64_t m_capacity;                        ///< The number of slots, a power of two
+            std::unique_ptr<T[]> m_items;               ///< The slots
+            alignas(64) std::atomic<uint64_t> m_head;   ///< Position the consumer pops from, on its own cache line
+            uint64_t m_cachedTail;                      ///< The consumer's copy of the tail
+            alignas(64) std::atomic<uint64_t> m_tail;   ///< Position the producer pushes at
+            uint64_t m_cachedHead;                      ///< The producer's copy of the head
+        };
+    }
+}
+
+#include "System/SpscQueue.inl"
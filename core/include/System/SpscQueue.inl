@@ -0,0 +1,57 @@
+namespace lov {
+    namespace System {
+        template <typename T>
+        SpscQueue<T>::SpscQueue(uint64_t capacity):
+            m_capacity(1),
+            m_head(0),
+            m_cachedTail(0),
+            m_tail(0),
+            m_cachedHead(0)
+        {
+            while (m_capacity < capacity) {
+                m_capacity *= 2;
+            }
+
+            m_items = std::make_unique<T[]>(m_capacity);
+        }
+
+        template <typename T>
+        bool SpscQueue<T>::push(const T& item) {
+            uint64_t tail = m_tail.load(std::memory_order_relaxed);
+
+            // Only look at the consumer's position again once the ring seems full
+            if (tail - m_cachedHead == m_capacity) {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail - m_cachedHead == m_capacity) {
+                    return false;
+                }
+            }
+
+            m_items[tail & (m_capacity - 1)] = item;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename T>
+        bool SpscQueue<T>::pop(T& item) {
+            uint64_t head = m_head.load(std::memory_order_relaxed);
+
+            // Only look at the producer's position again once the ring seems empty
+            if (head == m_cachedTail) {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail) {
+                    return false;
+                }
+            }
+
+            item = m_items[head & (m_capacity - 1)];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename T>
+        uint64_t SpscQueue<T>::getCapacity() const {
+            return m_capacity;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+
+/// @file Task.h
+/// @brief Defines the #lov::System::Task coroutine type that engine code awaits asynchronous work in
+
+namespace lov {
+    namespace System {
+        /// @brief A coroutine that starts running as soon as it's called and can be polled or awaited for completion
+        ///
+        /// Write loaders as functions returning Task that co_await things like #lov::System::AsyncIO reads. The coroutine
+        /// runs until its first suspension before the call returns, and is resumed by whatever it awaits, such as
+        /// AsyncIO::poll on the thread that calls it. Awaiting a Task from another coroutine resumes the awaiter when it
+        /// finishes. Keep a Task alive until it's done, since destroying it destroys the suspended coroutine.
+        class Task {
+        public:
+            /// @brief The promise of a Task coroutine
+            struct promise_type {
+                /// @brief Awaited when the coroutine finishes, which resumes the awaiting coroutine if there is one
+                struct FinalAwaiter {
+                    /// @brief Always suspend, so the Task can still read the promise
+                    /// @return False
+                    bool await_ready() const noexcept;
+
+                    /// @brief Transfer to the awaiting coroutine, if there is one
+                    /// @param handle The finished coroutine
+                    /// @return The coroutine to resume
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+
+                    /// @brief Never resumed
+                    void await_resume() const noexcept;
+                };
+
+                /// @brief Wrap the coroutine in a Task
+                /// @return The Task
+                Task get_return_object();
+
+                /// @brief Run the coroutine straight away
+                /// @return An awaiter that doesn't suspend
+                std::suspend_never initial_suspend() const noexcept;
+
+                /// @brief Stay suspended at the end, resuming the awaiting coroutine
+                /// @return The awaiter
+                FinalAwaiter final_suspend() const noexcept;
+
+                /// @brief Nothing to store when the coroutine returns
+                void return_void() const noexcept;
+
+                /// @brief Keep what the coroutine threw for #rethrow
+                void unhandled_exception();
+
+                std::exception_ptr exception;           ///< Thrown out of the coroutine
+                std::coroutine_handle<> continuation;   ///< Coroutine awaiting this one
+            };
+
+            /// @brief Construct a Task without a coroutine, which counts as done
+            Task();
+
+            /// @brief Take the coroutine of another Task
+            /// @param other The Task to move from, left without a coroutine
+            Task(Task&& other) noexcept;
+
+            /// @brief Take the coroutine of another Task, destroying this one's
+            /// @param other The Task to move from, left without a coroutine
+            /// @return This Task
+            Task& operator=(Task&& other) noexcept;
+
+            /// @brief Destroy the coroutine
+            ~Task();
+
+            Task(const Task&) = delete;
+            Task& operator=(const Task&) = delete;
+
+            /// @brief Has the coroutine run to completion?
+            /// @return Whether it returned or threw
+            bool isDone() const;
+
+            /// @brief Rethrow anything the finished coroutine threw
+            void rethrow() const;
+
+            /// @brief Don't suspend an awaiting coroutine if this one is already done
+            /// @return Whether it's done
+            bool await_ready() const noexcept;
+
+            /// @brief Resume the awaiting coroutine when this one finishes
+            /// @param awaiting The awaiting coroutine
+            void await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+            /// @brief Rethrow into the awaiting coroutine anything this one threw
+            void await_resume() const;
+
+        private:
+            /// @brief Wrap a coroutine
+            /// @param handle The coroutine
+            explicit Task(std::coroutine_handle<promise_type> handle);
+
+            std::coroutine_handle<promise_type> m_handle;   ///< The coroutine, or null
+        };
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "System/Types.h"
+
+/// @file ThreadPool.h
+/// @brief Defines the #lov::System::ThreadPool used to run engine work on worker threads
+
+namespace lov {
+    namespace System {
+        /// @brief A fixed set of worker threads that run tasks from a shared queue
+        class ThreadPool {
+        public:
+            /// @brief Start the worker threads
+            /// @param threadCount The number of workers, or 0 for one less than the number of hardware threads
+            explicit ThreadPool(lov_size threadCount = 0);
+
+            /// @brief Finish queued tasks and join the worker threads
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /// @brief Queue a task to run on a worker thread
+            /// @param task The task to run
+            /// @return A future that becomes ready when the task finishes, rethrowing anything it threw
+            std::future<void> submit(std::function<void()> task);
+
+            /// @brief Split [0, count) into contiguous ranges and run the body on each, using the calling thread as well as the workers
+            /// @param count The number of items
+            /// @param body Called with [begin, end) ranges that together cover every item exactly once
+            /// @throws Whatever the first failing range threw, once every range has finished
+            void parallelFor(lov_size count, const std::function<void(lov_size begin, lov_size end)>& body);
+
+            /// @brief Get the number of worker threads
+            /// @return The worker count
+            lov_size getThreadCount() const;
+
+        private:
+            /// @brief Run tasks until the pool stops
+            void work();
+
+            std::vector<std::thread> m_workers;             ///< The worker threads
+            std::queue<std::packaged_task<void()>> m_tasks; ///< Tasks waiting for a worker
+            std::mutex m_mutex;                             ///< Guards m_tasks and m_stopping
+            std::condition_variable m_condition;            ///< Wakes workers when tasks arrive or the pool stops
+            bool m_stopping;                                ///< Has the pool been asked to stop?
+        };
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @file WorkStealingDeque.h
+/// @brief Defines the #lov::System::WorkStealingDeque that job system workers keep their jobs in
+
+namespace lov {
+    namespace System {
+        /// @brief A Chase-Lev deque of pointers that one thread pushes and pops at the bottom while others steal from the top
+        ///
+        /// The owning thread works through its own jobs newest first, which keeps the data they touch in its cache, while
+        /// idle threads steal the oldest, which in a job that splits itself are the biggest. Neither end takes a lock, and
+        /// the only contention is a compare and swap when the owner and a thief race for the last item. The ring grows
+        /// when full, keeping the old rings alive until the deque is destroyed since thieves may still be reading them.
+        /// Follows "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê, Pop, Cohen and Zappa Nardelli.
+        /// @tparam T The pointer type stored
+        template <typename T>
+        class WorkStealingDeque {
+        public:
+            /// @brief Construct an empty deque
+            /// @param capacity The number of items it holds before growing, rounded up to a power of two
+            explicit WorkStealingDeque(int64_t capacity = 1024);
+
+            WorkStealingDeque(const WorkStealingDeque&) = delete;
+            WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+            /// @brief Push an item onto the bottom. Only the owning thread may call this
+            /// @param item The item, which must not be null
+            void push(T item);
+
+            /// @brief Pop the item most recently pushed. Only the owning thread may call this
+            /// @return The item, or null if the deque is empty
+            T pop();
+
+            /// @brief Steal the item pushed longest ago. Any thread may call this
+            /// @return The item, or null if the deque is empty or another thread took it first
+            T steal();
+
+            /// @brief Is the deque empty? Only a hint while other threads use it
+            /// @return Whether there were no items when checked
+            bool isEmpty() const;
+
+        private:
+            /// @brief A ring of items, indexed by the unbounded top and bottom positions
+            struct Ring {
+                /// @brief Construct an empty ring
+                /// @param capacity The number of slots, a power of two
+                explicit Ring(int64_t capacity);
+
+                /// @brief Read the item at a position
+                /// @param position The position, wrapped onto the ring
+                /// @return The item
+                T get(int64_t position) const;
+
+                /// @brief Write the item at a position
+                /// @param position The position, wrapped onto the ring
+                /// @param item The item
+                void put(int64_t position, T item);
+
+                int64_t capacity;                           ///< The number of slots
+                std::unique_ptr<std::atomic<T>[]> items;    ///< The slots
+            };
+
+            /// @brief Copy the items between top and bottom into a ring twice the size
+            /// @param top The top position
+            /// @param bottom The bottom position
+            /// @return The new ring
+            Ring* grow(int64_t top, int64_t bottom);
+
+            alignas(64) std::atomic<int64_t> m_top;         ///< Position thieves steal from, on its own cache line
+            alignas(64) std::atomic<int64_t> m_bottom;      ///< Position the owner pushes and pops at
+            std::atomic<Ring*> m_ring;                      ///< The ring in use
+            std::vector<std::unique_ptr<Ring>> m_rings;     ///< Every ring made, kept until destruction
+        };
+    }
+}
+
+#include "System/WorkStealingDeque.inl"
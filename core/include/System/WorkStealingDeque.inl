@@ -0,0 +1,114 @@
+namespace lov {
+    namespace System {
+        template <typename T>
+        WorkStealingDeque<T>::Ring::Ring(int64_t capacity):
+            capacity(capacity),
+            items(new std::atomic<T>[capacity])
+        {}
+
+        template <typename T>
+        T WorkStealingDeque<T>::Ring::get(int64_t position) const {
+            return items[position & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        template <typename T>
+        void WorkStealingDeque<T>::Ring::put(int64_t position, T item) {
+            items[position & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        template <typename T>
+        WorkStealingDeque<T>::WorkStealingDeque(int64_t capacity):
+            m_top(0),
+            m_bottom(0)
+        {
+            int64_t rounded = 1;
+            while (rounded < capacity) {
+                rounded *= 2;
+            }
+
+            m_rings.push_back(std::make_unique<Ring>(rounded));
+            m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+        }
+
+        template <typename T>
+        void WorkStealingDeque<T>::push(T item) {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            Ring* ring = m_ring.load(std::memory_order_relaxed);
+
+            if (bottom - top > ring->capacity - 1) {
+                ring = grow(top, bottom);
+            }
+
+            // Publish the item with the bottom that makes it visible to thieves
+            ring->put(bottom, item);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        template <typename T>
+        T WorkStealingDeque<T>::pop() {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            Ring* ring = m_ring.load(std::memory_order_relaxed);
+
+            // Claim the bottom item before looking at the top, so a thief can't take it as well unnoticed
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T item = ring->get(bottom);
+            if (top == bottom) {
+                // The last item, which a thief may be stealing at the same time
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        template <typename T>
+        T WorkStealingDeque<T>::steal() {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) {
+                return nullptr;
+            }
+
+            // Read the item before claiming it, since the owner may reuse the slot once the top moves on
+            T item = m_ring.load(std::memory_order_acquire)->get(top);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+
+            return item;
+        }
+
+        template <typename T>
+        bool WorkStealingDeque<T>::isEmpty() const {
+            return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+        }
+
+        template <typename T>
+        typename WorkStealingDeque<T>::Ring* WorkStealingDeque<T>::grow(int64_t top, int64_t bottom) {
+            Ring* old = m_ring.load(std::memory_order_relaxed);
+            m_rings.push_back(std::make_unique<Ring>(old->capacity * 2));
+            Ring* ring = m_rings.back().get();
+
+            for (int64_t position = top; position < bottom; position++) {
+                ring->put(position, old->get(position));
+            }
+
+            m_ring.store(ring, std::memory_order_release);
+            return ring;
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include "ECS/Archetype.h"
+
+#include "System/Exceptions.h"
+
+#include <cstring>
+
+namespace {
+    /// @brief Round an offset up to an alignment
+    /// @param offset The offset
+    /// @param alignment The alignment, a power of two
+    /// @return The aligned offset
+    size_t alignUp(size_t offset, size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+lov::ECS::Archetype::Archetype(ComponentMask mask):
+    m_mask(mask),
+    m_capacity(0)
+{
+    m_offsets.fill(0);
+    m_addEdges.fill(nullptr);
+    m_removeEdges.fill(nullptr);
+
+    size_t rowSize = sizeof(Entity);
+    for (lov_uint component = 0; component < MaxComponentTypes; component++) {
+        if (mask & (ComponentMask(1) << component)) {
+            rowSize += getComponentInfo(component).size;
+        }
+    }
+
+    if (rowSize > ChunkSize) {
+        throw Exceptions::EntityException("Components of an entity don't fit in one chunk");
+    }
+
+    // Fit as many rows as the columns' alignment padding allows
+    for (m_capacity = static_cast<lov_uint>(ChunkSize / rowSize); m_capacity > 0; m_capacity--) {
+        size_t offset = sizeof(Entity) * m_capacity;
+        for (lov_uint component = 0; component < MaxComponentTypes; component++) {
+            if (mask & (ComponentMask(1) << component)) {
+                const ComponentInfo& info = getComponentInfo(component);
+                offset = alignUp(offset, info.alignment);
+                m_offsets[component] = offset;
+                offset += info.size * m_capacity;
+            }
+        }
+
+        if (offset <= ChunkSize) {
+            break;
+        }
+    }
+
+    // A row that only fits without its columns' alignment padding can't be stored either
+    if (m_capacity == 0) {
+        throw Exceptions::EntityException("Components of an entity don't fit in one chunk once aligned");
+    }
+}
+
+lov::ECS::ComponentMask lov::ECS::Archetype::getMask() const {
+    return m_mask;
+}
+
+lov::lov_uint lov::ECS::Archetype::getChunkCapacity() const {
+    return m_capacity;
+}
+
+std::span<const lov::ECS::Chunk> lov::ECS::Archetype::getChunks() const {
+    return m_chunks;
+}
+
+lov::lov_uint lov::ECS::Archetype::getEntityCount() const {
+    return m_chunks.empty() ? 0 : static_cast<lov_uint>(m_chunks.size() - 1) * m_capacity + m_chunks.back().count;
+}
+
+std::byte* lov::ECS::Archetype::getColumn(const Chunk& chunk, lov_uint component) const {
+    return chunk.data.get() + m_offsets[component];
+}
+
+lov::ECS::Entity* lov::ECS::Archetype::getEntities(const Chunk& chunk) const {
+    return reinterpret_cast<Entity*>(chunk.data.get());
+}
+
+std::byte* lov::ECS::Archetype::getComponent(lov_uint chunk, lov_uint row, lov_uint component) const {
+    return getColumn(m_chunks[chunk], component) + getComponentInfo(component).size * row;
+}
+
+void lov::ECS::Archetype::allocate(Entity entity, lov_uint& chunk, lov_uint& row) {
+    if (m_chunks.empty() || m_chunks.back().count == m_capacity) {
+        m_chunks.push_back({ std::make_unique_for_overwrite<std::byte[]>(ChunkSize), 0 });
+    }
+
+    Chunk& last = m_chunks.back();
+    chunk = static_cast<lov_uint>(m_chunks.size() - 1);
+    row = last.count++;
+    getEntities(last)[row] = entity;
+}
+
+lov::ECS::Entity lov::ECS::Archetype::free(lov_uint chunk, lov_uint row) {
+    Chunk& last = m_chunks.back();
+    lov_uint lastRow = last.count - 1;
+    Entity moved = getEntities(last)[lastRow];
+
+    // Fill the hole with the last row, column by column
+    if (chunk != m_chunks.size() - 1 || row != lastRow) {
+        getEntities(m_chunks[chunk])[row] = moved;
+
+        for (lov_uint component = 0; component < MaxComponentTypes; component++) {
+            if (m_mask & (ComponentMask(1) << component)) {
+                size_t size = getComponentInfo(component).size;
+                std::memcpy(getColumn(m_chunks[chunk], component) + size * row, getColumn(last, component) + size * lastRow, size);
+            }
+        }
+    }
+
+    if (--last.count == 0) {
+        m_chunks.pop_back();
+    }
+
+    return moved;
+}
+
+lov::ECS::Archetype* lov::ECS::Archetype::getAddEdge(lov_uint component) const {
+    return m_addEdges[component];
+}
+
+lov::ECS::Archetype* lov::ECS::Archetype::getRemoveEdge(lov_uint component) const {
+    return m_removeEdges[component];
+}
+
+void lov::ECS::Archetype::setEdge(lov_uint component, Archetype* archetype, bool adding) {
+    if (adding) {
+        m_addEdges[component] = archetype;
+    }
+    else {
+        m_removeEdges[component] = archetype;
+    }
+}
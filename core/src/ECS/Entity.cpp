@@ -0,0 +1,28 @@
+#include "ECS/Entity.h"
+
+#include "System/Exceptions.h"
+
+#include <array>
+#include <mutex>
+
+namespace {
+    std::mutex registryMutex;                                                   ///< Guards registering
+    std::array<lov::ECS::ComponentInfo, lov::ECS::MaxComponentTypes> registry;  ///< Info of each component ID
+    lov::lov_uint registered = 0;                                               ///< Number of IDs given out
+}
+
+lov::lov_uint lov::ECS::registerComponent(size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    if (registered == MaxComponentTypes) {
+        throw Exceptions::EntityException("Too many component types, the limit is " + std::to_string(MaxComponentTypes));
+    }
+
+    // A fixed array, so reading another type's info never races with registering a new one
+    registry[registered] = { size, alignment };
+    return registered++;
+}
+
+const lov::ECS::ComponentInfo& lov::ECS::getComponentInfo(lov_uint component) {
+    return registry[component];
+}
@@ -0,0 +1,79 @@
+#include "ECS/EntityCommandBuffer.h"
+
+#include "ECS/World.h"
+
+#include <cstring>
+
+lov::ECS::EntityCommandBuffer::EntityCommandBuffer(size_t blockSize):
+    m_allocator(blockSize),
+    m_placeholders(0)
+{}
+
+lov::ECS::Entity lov::ECS::EntityCommandBuffer::create() {
+    Entity placeholder = { m_placeholders++, PlaceholderGeneration };
+    m_commands.push_back({ CommandType::Create, placeholder, 0, nullptr });
+    return placeholder;
+}
+
+void lov::ECS::EntityCommandBuffer::destroy(Entity entity) {
+    m_commands.push_back({ CommandType::Destroy, entity, 0, nullptr });
+}
+
+void lov::ECS::EntityCommandBuffer::addComponent(Entity entity, lov_uint component, const void* data) {
+    const ComponentInfo& info = getComponentInfo(component);
+    void* copy = m_allocator.allocate(info.size, info.alignment);
+    std::memcpy(copy, data, info.size);
+
+    m_commands.push_back({ CommandType::Add, entity, component, copy });
+}
+
+void lov::ECS::EntityCommandBuffer::removeComponent(Entity entity, lov_uint component) {
+    m_commands.push_back({ CommandType::Remove, entity, component, nullptr });
+}
+
+void lov::ECS::EntityCommandBuffer::apply(World& world) {
+    m_created.assign(m_placeholders, Entity{ 0, PlaceholderGeneration });
+
+    for (const Command& command : m_commands) {
+        // Placeholders are numbered in the order they were created, which is also the order they're applied
+        Entity entity = command.entity.generation == PlaceholderGeneration ? m_created[command.entity.index] : command.entity;
+
+        if (command.type == CommandType::Create) {
+            m_created[command.entity.index] = world.create();
+            continue;
+        }
+
+        if (!world.isAlive(entity)) {
+            continue;
+        }
+
+        switch (command.type) {
+        case CommandType::Destroy:
+            world.destroy(entity);
+            break;
+
+        case CommandType::Add:
+            world.addComponent(entity, command.component, command.data);
+            break;
+
+        case CommandType::Remove:
+            world.removeComponent(entity, command.component);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    clear();
+}
+
+void lov::ECS::EntityCommandBuffer::clear() {
+    m_allocator.reset();
+    m_commands.clear();
+    m_placeholders = 0;
+}
+
+bool lov::ECS::EntityCommandBuffer::isEmpty() const {
+    return m_commands.empty();
+}
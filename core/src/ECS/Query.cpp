@@ -0,0 +1,41 @@
+#include "ECS/Query.h"
+
+lov::ECS::ChunkView::ChunkView(const Archetype& archetype, const Chunk& chunk):
+    m_archetype(&archetype),
+    m_chunk(&chunk)
+{}
+
+lov::lov_uint lov::ECS::ChunkView::getCount() const {
+    return m_chunk->count;
+}
+
+std::span<const lov::ECS::Entity> lov::ECS::ChunkView::getEntities() const {
+    return std::span<const Entity>(m_archetype->getEntities(*m_chunk), m_chunk->count);
+}
+
+lov::ECS::Query::Query(ComponentMask mask):
+    m_mask(mask)
+{}
+
+lov::ECS::ComponentMask lov::ECS::Query::getMask() const {
+    return m_mask;
+}
+
+void lov::ECS::Query::match(const Archetype& archetype) {
+    if ((archetype.getMask() & m_mask) == m_mask) {
+        m_archetypes.push_back(&archetype);
+    }
+}
+
+std::span<const lov::ECS::Archetype* const> lov::ECS::Query::getArchetypes() const {
+    return m_archetypes;
+}
+
+lov::lov_uint lov::ECS::Query::getEntityCount() const {
+    lov_uint count = 0;
+    for (const Archetype* archetype : m_archetypes) {
+        count += archetype->getEntityCount();
+    }
+
+    return count;
+}
@@ -0,0 +1,101 @@
+#include "ECS/Systems.h"
+
+#include "ECS/Components.h"
+#include "ECS/World.h"
+
+#include <mutex>
+
+namespace {
+    /// @brief Run a function on each chunk of a query, in parallel if there's a job system
+    template <typename Function>
+    void forEachChunk(lov::ECS::Query& query, lov::System::JobSystem* jobs, Function&& function) {
+        if (jobs) {
+            query.parallelForEachChunk(*jobs, function);
+        }
+        else {
+            query.forEachChunk(function);
+        }
+    }
+}
+
+void lov::ECS::storePreviousTransforms(World& world, System::JobSystem* jobs) {
+    forEachChunk(world.query<LocalTransform, PreviousTransform>(), jobs, [](const ChunkView& view) {
+        std::span<LocalTransform> locals = view.get<LocalTransform>();
+        std::span<PreviousTransform> previous = view.get<PreviousTransform>();
+
+        for (lov_uint i = 0; i < view.getCount(); i++) {
+            previous[i].value = locals[i].value;
+        }
+    });
+}
+
+void lov::ECS::updateTransforms(World& world, System::JobSystem* jobs, float alpha) {
+    forEachChunk(world.query<LocalTransform, WorldTransform>(), jobs, [alpha](const ChunkView& view) {
+        std::span<LocalTransform> locals = view.get<LocalTransform>();
+        std::span<WorldTransform> worlds = view.get<WorldTransform>();
+
+        if (!view.has<PreviousTransform>()) {
+            for (lov_uint i = 0; i < view.getCount(); i++) {
+                worlds[i].value = locals[i].value.toTransform();
+            }
+            return;
+        }
+
+        std::span<PreviousTransform> previous = view.get<PreviousTransform>();
+        for (lov_uint i = 0; i < view.getCount(); i++) {
+            worlds[i].value = Graphics::NodeTransform::interpolate(previous[i].value, locals[i].value, alpha).toTransform();
+        }
+    });
+}
+
+void lov::ECS::cullEntities(World& world, const Graphics::Frustum& frustum, System::JobSystem* jobs) {
+    forEachChunk(world.query<WorldTransform, RenderBounds, Visible>(), jobs, [&frustum](const ChunkView& view) {
+        std::span<WorldTransform> worlds = view.get<WorldTransform>();
+        std::span<RenderBounds> bounds = view.get<RenderBounds>();
+        std::span<Visible> visible = view.get<Visible>();
+
+        for (lov_uint i = 0; i < view.getCount(); i++) {
+            visible[i].value = frustum.intersects(bounds[i].local.transformed(worlds[i].value));
+        }
+    });
+}
+
+void lov::ECS::extractDraws(World& world, std::span<Graphics::CommandBuffer> buffers, lov_uint modelBinding, System::JobSystem* jobs) {
+    // Threads outside the job system run chunks while they wait, so they share the last buffer, one at a time
+    std::mutex outsideMutex;
+    forEachChunk(world.query<WorldTransform, RenderMesh>(), jobs, [&buffers, &outsideMutex, modelBinding, jobs](const ChunkView& view) {
+        lov_int index = jobs ? jobs->getThreadIndex() : 0;
+        std::unique_lock<std::mutex> outsideLock;
+        if (index < 0) {
+            outsideLock = std::unique_lock<std::mutex>(outsideMutex);
+            index = jobs->getThreadCount();
+        }
+
+        Graphics::CommandBuffer& buffer = buffers[index];
+        std::span<WorldTransform> worlds = view.get<WorldTransform>();
+        std::span<RenderMesh> meshes = view.get<RenderMesh>();
+
+        // Entities without a Visible component were never culled, so they're always drawn
+        std::span<Visible> visible;
+        if (view.has<Visible>()) {
+            visible = view.get<Visible>();
+        }
+
+        for (lov_uint i = 0; i < view.getCount(); i++) {
+            if (!visible.empty() && !visible[i].value) {
+                continue;
+            }
+
+            const RenderMesh& mesh = meshes[i];
+            buffer.begin(static_cast<uint64_t>(mesh.program) << 32 | mesh.vertexArray);
+            buffer.bindProgram(mesh.program);
+            buffer.bindVertexArray(mesh.vertexArray);
+            buffer.setUniformBlock(modelBinding, worlds[i].value);
+            buffer.drawElements(mesh.indexCount, mesh.firstIndex);
+        }
+    });
+
+    for (Graphics::CommandBuffer& buffer : buffers) {
+        buffer.sort();
+    }
+}
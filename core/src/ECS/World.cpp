@@ -0,0 +1,165 @@
+#include "ECS/World.h"
+
+#include "System/Exceptions.h"
+
+lov::ECS::World::World():
+    m_entityCount(0)
+{
+    m_empty = getArchetype(0);
+}
+
+lov::ECS::Entity lov::ECS::World::create() {
+    return allocate(m_empty);
+}
+
+void lov::ECS::World::destroy(Entity entity) {
+    Record& record = getRecord(entity);
+
+    // Whatever filled the row now lives where the destroyed entity did
+    Entity moved = record.archetype->free(record.chunk, record.row);
+    if (moved != entity) {
+        m_records[moved.index].chunk = record.chunk;
+        m_records[moved.index].row = record.row;
+    }
+
+    // Bump the generation now, so handles to this entity stop being alive
+    record.archetype = nullptr;
+    record.generation++;
+    m_freeIndices.push_back(entity.index);
+    m_entityCount--;
+}
+
+bool lov::ECS::World::isAlive(Entity entity) const {
+    return entity.index < m_records.size() && m_records[entity.index].archetype && m_records[entity.index].generation == entity.generation;
+}
+
+void lov::ECS::World::addComponent(Entity entity, lov_uint component, const void* data) {
+    Record& record = getRecord(entity);
+
+    if (!(record.archetype->getMask() & (ComponentMask(1) << component))) {
+        Archetype* archetype = record.archetype->getAddEdge(component);
+        if (!archetype) {
+            archetype = getArchetype(record.archetype->getMask() | (ComponentMask(1) << component));
+            record.archetype->setEdge(component, archetype, true);
+            archetype->setEdge(component, record.archetype, false);
+        }
+
+        move(entity, record, archetype);
+    }
+
+    std::memcpy(record.archetype->getComponent(record.chunk, record.row, component), data, getComponentInfo(component).size);
+}
+
+void lov::ECS::World::removeComponent(Entity entity, lov_uint component) {
+    Record& record = getRecord(entity);
+
+    if (record.archetype->getMask() & (ComponentMask(1) << component)) {
+        Archetype* archetype = record.archetype->getRemoveEdge(component);
+        if (!archetype) {
+            archetype = getArchetype(record.archetype->getMask() & ~(ComponentMask(1) << component));
+            record.archetype->setEdge(component, archetype, false);
+            archetype->setEdge(component, record.archetype, true);
+        }
+
+        move(entity, record, archetype);
+    }
+}
+
+void* lov::ECS::World::getComponent(Entity entity, lov_uint component) const {
+    if (!isAlive(entity)) {
+        return nullptr;
+    }
+
+    const Record& record = m_records[entity.index];
+    if (!(record.archetype->getMask() & (ComponentMask(1) << component))) {
+        return nullptr;
+    }
+
+    return record.archetype->getComponent(record.chunk, record.row, component);
+}
+
+lov::ECS::Query& lov::ECS::World::query(ComponentMask mask) {
+    std::unique_ptr<Query>& query = m_queries[mask];
+
+    // Match the archetypes that already exist once, and each new one as it's created
+    if (!query) {
+        query = std::make_unique<Query>(mask);
+        for (const auto& [archetypeMask, archetype] : m_archetypes) {
+            query->match(*archetype);
+        }
+    }
+
+    return *query;
+}
+
+lov::lov_uint lov::ECS::World::getEntityCount() const {
+    return m_entityCount;
+}
+
+lov::lov_uint lov::ECS::World::getArchetypeCount() const {
+    return static_cast<lov_uint>(m_archetypes.size());
+}
+
+lov::ECS::World::Record& lov::ECS::World::getRecord(Entity entity) {
+    if (!isAlive(entity)) {
+        throw Exceptions::EntityException("Entity " + std::to_string(entity.index) + " generation " + std::to_string(entity.generation) + " isn't alive");
+    }
+
+    return m_records[entity.index];
+}
+
+lov::ECS::Archetype* lov::ECS::World::getArchetype(ComponentMask mask) {
+    std::unique_ptr<Archetype>& archetype = m_archetypes[mask];
+
+    if (!archetype) {
+        archetype = std::make_unique<Archetype>(mask);
+        for (auto& [queryMask, query] : m_queries) {
+            query->match(*archetype);
+        }
+    }
+
+    return archetype.get();
+}
+
+lov::ECS::Entity lov::ECS::World::allocate(Archetype* archetype) {
+    lov_uint index;
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    }
+    else {
+        index = static_cast<lov_uint>(m_records.size());
+        m_records.push_back({ 0, nullptr, 0, 0 });
+    }
+
+    Record& record = m_records[index];
+    Entity entity = { index, record.generation };
+    record.archetype = archetype;
+    archetype->allocate(entity, record.chunk, record.row);
+    m_entityCount++;
+    return entity;
+}
+
+void lov::ECS::World::move(Entity entity, Record& record, Archetype* archetype) {
+    lov_uint chunk, row;
+    archetype->allocate(entity, chunk, row);
+
+    // Copy the components both archetypes have, leaving any new one for the caller to fill
+    ComponentMask shared = record.archetype->getMask() & archetype->getMask();
+    for (lov_uint component = 0; component < MaxComponentTypes; component++) {
+        if (shared & (ComponentMask(1) << component)) {
+            std::memcpy(archetype->getComponent(chunk, row, component),
+                record.archetype->getComponent(record.chunk, record.row, component), getComponentInfo(component).size);
+        }
+    }
+
+    Entity moved = record.archetype->free(record.chunk, record.row);
+    if (moved != entity) {
+        m_records[moved.index].chunk = record.chunk;
+        m_records[moved.index].row = record.row;
+    }
+
+    record.archetype = archetype;
+    record.chunk = chunk;
+    record.row = row;
+}
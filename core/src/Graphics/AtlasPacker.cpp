@@ -0,0 +1,133 @@
+#include "Graphics/AtlasPacker.h"
+
+#include <algorithm>
+#include <limits>
+
+lov::Graphics::AtlasRegion lov::Graphics::AtlasRegion::fromRect(const AtlasRect& rect, lov_int pageWidth, lov_int pageHeight, lov_int layer) {
+    AtlasRegion region;
+    region.offset = Vector2f(static_cast<float>(rect.x) / pageWidth, static_cast<float>(rect.y) / pageHeight);
+    region.scale = Vector2f(static_cast<float>(rect.width) / pageWidth, static_cast<float>(rect.height) / pageHeight);
+    region.layer = layer;
+    return region;
+}
+
+lov::Vector2f lov::Graphics::AtlasRegion::remap(const Vector2f& texCoords) const {
+    return Vector2f(offset.x + texCoords.x * scale.x, offset.y + texCoords.y * scale.y);
+}
+
+void lov::Graphics::AtlasRegion::remap(MeshData& mesh) const {
+    for (Vertex& vertex : mesh.vertices) {
+        vertex.texCoords = remap(vertex.texCoords);
+    }
+}
+
+lov::Graphics::AtlasPacker::AtlasPacker(lov_int width, lov_int height, lov_int padding):
+    m_width(width),
+    m_height(height),
+    m_padding(padding),
+    m_usedArea(0)
+{
+    clear();
+}
+
+bool lov::Graphics::AtlasPacker::pack(lov_int width, lov_int height, AtlasRect& rect) {
+    lov_int paddedWidth = width + m_padding * 2;
+    lov_int paddedHeight = height + m_padding * 2;
+
+    // Pick the segment where the rectangle's top is lowest, breaking ties with the narrowest segment to keep wide ones free
+    size_t best = m_skyline.size();
+    lov_int bestTop = std::numeric_limits<lov_int>::max();
+    lov_int bestWidth = std::numeric_limits<lov_int>::max();
+    lov_int bestY = 0;
+    for (size_t i = 0; i < m_skyline.size(); i++) {
+        lov_int y;
+        if (!fit(i, paddedWidth, paddedHeight, y)) {
+            continue;
+        }
+
+        if (y + paddedHeight < bestTop || (y + paddedHeight == bestTop && m_skyline[i].width < bestWidth)) {
+            best = i;
+            bestTop = y + paddedHeight;
+            bestWidth = m_skyline[i].width;
+            bestY = y;
+        }
+    }
+
+    if (best == m_skyline.size()) {
+        return false;
+    }
+
+    // Raise the skyline under the rectangle, trimming the segments it now covers
+    SkylineNode node = { m_skyline[best].x, bestTop, paddedWidth };
+    m_skyline.insert(m_skyline.begin() + best, node);
+
+    lov_int right = node.x + node.width;
+    size_t next = best + 1;
+    while (next < m_skyline.size() && m_skyline[next].x < right) {
+        lov_int overlap = right - m_skyline[next].x;
+        if (overlap >= m_skyline[next].width) {
+            m_skyline.erase(m_skyline.begin() + next);
+        }
+        else {
+            m_skyline[next].x += overlap;
+            m_skyline[next].width -= overlap;
+            break;
+        }
+    }
+
+    // Merge neighbours at the same height so later fits scan fewer segments
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else {
+            i++;
+        }
+    }
+
+    m_usedArea += static_cast<lov_size>(paddedWidth) * paddedHeight;
+    rect = { node.x + m_padding, bestY + m_padding, width, height };
+    return true;
+}
+
+void lov::Graphics::AtlasPacker::clear() {
+    m_skyline.assign(1, { 0, 0, m_width });
+    m_usedArea = 0;
+}
+
+float lov::Graphics::AtlasPacker::getOccupancy() const {
+    return static_cast<float>(m_usedArea) / (static_cast<float>(m_width) * m_height);
+}
+
+lov::lov_int lov::Graphics::AtlasPacker::getWidth() const {
+    return m_width;
+}
+
+lov::lov_int lov::Graphics::AtlasPacker::getHeight() const {
+    return m_height;
+}
+
+lov::lov_int lov::Graphics::AtlasPacker::getPadding() const {
+    return m_padding;
+}
+
+bool lov::Graphics::AtlasPacker::fit(size_t node, lov_int width, lov_int height, lov_int& y) const {
+    if (m_skyline[node].x + width > m_width) {
+        return false;
+    }
+
+    // The rectangle rests on the highest segment it spans
+    y = 0;
+    lov_int remaining = width;
+    for (size_t i = node; remaining > 0; i++) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) {
+            return false;
+        }
+
+        remaining -= m_skyline[i].width;
+    }
+
+    return true;
+}
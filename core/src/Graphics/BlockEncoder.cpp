@@ -0,0 +1,807 @@
+#include "Graphics/BlockEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+    /// @brief Number of pixels in a block
+    const int BLOCK_PIXELS = 16;
+
+    /// @brief Interpolation weights out of 64 of BC7's 4 bit indices
+    const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    /// @brief The small and large intensity modifiers of each ETC1/ETC2 table
+    const int ETC_MODIFIERS[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+    /// @brief The modifiers of each EAC alpha table, before the multiplier is applied
+    const int EAC_MODIFIERS[16][8] = {
+        { -3, -6, -9, -15, 2, 5, 8, 14 },
+        { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5, -8, -13, 1, 4, 7, 12 },
+        { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 },
+        { -3, -7, -9, -11, 2, 6, 8, 10 },
+        { -4, -7, -8, -11, 3, 6, 7, 10 },
+        { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 },
+        { -2, -5, -8, -10, 1, 4, 7, 9 },
+        { -2, -4, -8, -10, 1, 3, 7, 9 },
+        { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 },
+        { -1, -2, -3, -10, 0, 1, 2, 9 },
+        { -4, -6, -8, -9, 3, 5, 7, 8 },
+        { -3, -5, -7, -9, 2, 4, 6, 8 }
+    };
+
+    /// @brief Number of least squares passes that refit endpoints to the indices they produced
+    const int REFINE_ITERATIONS = 3;
+
+    /// @brief Copy a block into floats
+    /// @param pixels The 16 RGBA8 pixels
+    /// @param out The pixels as floats from 0 to 255
+    void toFloat(const unsigned char* pixels, float (*out)[4]) {
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            for (int c = 0; c < 4; c++) {
+                out[i][c] = pixels[i * 4 + c];
+            }
+        }
+    }
+
+    /// @brief Find the line through a block that its pixels lie closest to
+    /// @param pixels The pixels
+    /// @param channels The number of leading channels to consider, 3 or 4
+    /// @param mean Set to the mean pixel
+    /// @param axis Set to the unit direction of greatest variance
+    void principalAxis(const float (*pixels)[4], int channels, float* mean, float* axis) {
+        for (int c = 0; c < 4; c++) {
+            mean[c] = 0.0f;
+            axis[c] = 0.0f;
+        }
+
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            for (int c = 0; c < channels; c++) {
+                mean[c] += pixels[i][c] / BLOCK_PIXELS;
+            }
+        }
+
+        float covariance[4][4] = {};
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++) {
+                    covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+                }
+            }
+        }
+
+        // Power iteration from the diagonal, which converges to the largest eigenvector
+        for (int c = 0; c < channels; c++) {
+            axis[c] = covariance[c][c] + 1e-3f;
+        }
+
+        for (int iteration = 0; iteration < 8; iteration++) {
+            float next[4] = {};
+            float length = 0.0f;
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++) {
+                    next[a] += covariance[a][b] * axis[b];
+                }
+                length += next[a] * next[a];
+            }
+
+            // A flat block has no direction, so keep the previous guess
+            if (length < 1e-12f) {
+                break;
+            }
+
+            length = std::sqrt(length);
+            for (int c = 0; c < channels; c++) {
+                axis[c] = next[c] / length;
+            }
+        }
+
+        float length = 0.0f;
+        for (int c = 0; c < channels; c++) {
+            length += axis[c] * axis[c];
+        }
+
+        length = std::sqrt(length);
+        for (int c = 0; c < channels; c++) {
+            axis[c] /= length;
+        }
+    }
+
+    /// @brief Find the ends of the principal axis that cover every pixel
+    /// @param pixels The pixels
+    /// @param channels The number of leading channels to consider, 3 or 4
+    /// @param low Set to the endpoint at the low end of the axis
+    /// @param high Set to the endpoint at the high end of the axis
+    void axisEndpoints(const float (*pixels)[4], int channels, float* low, float* high) {
+        float mean[4], axis[4];
+        principalAxis(pixels, channels, mean, axis);
+
+        float minimum = std::numeric_limits<float>::max();
+        float maximum = -std::numeric_limits<float>::max();
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            float t = 0.0f;
+            for (int c = 0; c < channels; c++) {
+                t += (pixels[i][c] - mean[c]) * axis[c];
+            }
+
+            minimum = std::min(minimum, t);
+            maximum = std::max(maximum, t);
+        }
+
+        for (int c = 0; c < 4; c++) {
+            low[c] = mean[c] + axis[c] * minimum;
+            high[c] = mean[c] + axis[c] * maximum;
+        }
+    }
+
+    /// @brief Solve for the two endpoints that best reproduce the pixels with the given interpolation weights
+    /// @param pixels The pixels
+    /// @param channels The number of leading channels to solve for
+    /// @param weights How far each pixel lies from the first endpoint towards the second, from 0 to 1
+    /// @param first Set to the first endpoint
+    /// @param second Set to the second endpoint
+    /// @return False if every pixel used the same weight, leaving the endpoints unchanged
+    bool leastSquares(const float (*pixels)[4], int channels, const float* weights, float* first, float* second) {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ax[4] = {}, bx[4] = {};
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            float a = 1.0f - weights[i];
+            float b = weights[i];
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < channels; c++) {
+                ax[c] += a * pixels[i][c];
+                bx[c] += b * pixels[i][c];
+            }
+        }
+
+        float determinant = aa * bb - ab * ab;
+        if (std::fabs(determinant) < 1e-6f) {
+            return false;
+        }
+
+        for (int c = 0; c < channels; c++) {
+            first[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+            second[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+        }
+
+        return true;
+    }
+
+    /// @brief Quantize a colour to RGB565
+    /// @param color The colour from 0 to 255
+    /// @return The packed colour
+    std::uint16_t to565(const float* color) {
+        int r = std::clamp(static_cast<int>(std::lround(color[0] * 31.0f / 255.0f)), 0, 31);
+        int g = std::clamp(static_cast<int>(std::lround(color[1] * 63.0f / 255.0f)), 0, 63);
+        int b = std::clamp(static_cast<int>(std::lround(color[2] * 31.0f / 255.0f)), 0, 31);
+        return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    /// @brief Expand an RGB565 colour the way the GPU does
+    /// @param packed The packed colour
+    /// @param color Set to the colour from 0 to 255
+    void from565(std::uint16_t packed, float* color) {
+        int r = (packed >> 11) & 31;
+        int g = (packed >> 5) & 63;
+        int b = packed & 31;
+        color[0] = static_cast<float>((r << 3) | (r >> 2));
+        color[1] = static_cast<float>((g << 2) | (g >> 4));
+        color[2] = static_cast<float>((b << 3) | (b >> 2));
+    }
+
+    /// @brief Pick the BC1 four colour palette entry of each pixel
+    /// @param first The first endpoint, which must be greater than the second
+    /// @param second The second endpoint
+    /// @param pixels The pixels
+    /// @param indices Set to the index of each pixel
+    /// @return The squared error of the block
+    float fitBC1(std::uint16_t first, std::uint16_t second, const float (*pixels)[4], unsigned char* indices) {
+        float palette[4][3];
+        from565(first, palette[0]);
+        from565(second, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+            palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+        }
+
+        // Equal endpoints switch the GPU to three colour mode, where only the first entry is still safe
+        int entries = first == second ? 1 : 4;
+
+        float error = 0.0f;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            float best = std::numeric_limits<float>::max();
+            for (int entry = 0; entry < entries; entry++) {
+                float distance = 0.0f;
+                for (int c = 0; c < 3; c++) {
+                    float difference = palette[entry][c] - pixels[i][c];
+                    distance += difference * difference;
+                }
+
+                if (distance < best) {
+                    best = distance;
+                    indices[i] = static_cast<unsigned char>(entry);
+                }
+            }
+
+            error += best;
+        }
+
+        return error;
+    }
+
+    /// @brief Encode a block's colour as BC1 in four colour mode, which BC3 also requires
+    /// @param pixels The pixels
+    /// @param out The 8 byte block
+    void encodeColor(const float (*pixels)[4], unsigned char* out) {
+        const float weightOf[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+        float low[4], high[4];
+        axisEndpoints(pixels, 3, low, high);
+
+        std::uint16_t bestFirst = 0, bestSecond = 0;
+        unsigned char bestIndices[BLOCK_PIXELS] = {};
+        float bestError = std::numeric_limits<float>::max();
+
+        // Fit the axis ends, then refit the endpoints to the indices they chose
+        for (int iteration = 0; iteration <= REFINE_ITERATIONS; iteration++) {
+            std::uint16_t first = to565(high);
+            std::uint16_t second = to565(low);
+            if (first < second) {
+                std::swap(first, second);
+            }
+
+            unsigned char indices[BLOCK_PIXELS];
+            float error = fitBC1(first, second, pixels, indices);
+            if (error < bestError) {
+                bestError = error;
+                bestFirst = first;
+                bestSecond = second;
+                std::copy(indices, indices + BLOCK_PIXELS, bestIndices);
+            }
+
+            float weights[BLOCK_PIXELS];
+            for (int i = 0; i < BLOCK_PIXELS; i++) {
+                weights[i] = weightOf[indices[i]];
+            }
+
+            if (!leastSquares(pixels, 3, weights, high, low)) {
+                break;
+            }
+        }
+
+        std::uint32_t bits = 0;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            bits |= static_cast<std::uint32_t>(bestIndices[i]) << (i * 2);
+        }
+
+        out[0] = static_cast<unsigned char>(bestFirst);
+        out[1] = static_cast<unsigned char>(bestFirst >> 8);
+        out[2] = static_cast<unsigned char>(bestSecond);
+        out[3] = static_cast<unsigned char>(bestSecond >> 8);
+        for (int i = 0; i < 4; i++) {
+            out[4 + i] = static_cast<unsigned char>(bits >> (i * 8));
+        }
+    }
+
+    /// @brief Pick the BC4 palette entry of each value
+    /// @param first The first endpoint. Above the second it selects eight interpolated values, otherwise six plus 0 and 255
+    /// @param second The second endpoint
+    /// @param values The values
+    /// @param indices Set to the index of each value
+    /// @return The squared error of the block
+    float fitBC4(int first, int second, const float* values, unsigned char* indices) {
+        float palette[8];
+        palette[0] = static_cast<float>(first);
+        palette[1] = static_cast<float>(second);
+        if (first > second) {
+            for (int i = 2; i < 8; i++) {
+                palette[i] = ((8 - i) * first + (i - 1) * second) / 7.0f;
+            }
+        }
+        else {
+            for (int i = 2; i < 6; i++) {
+                palette[i] = ((6 - i) * first + (i - 1) * second) / 5.0f;
+            }
+            palette[6] = 0.0f;
+            palette[7] = 255.0f;
+        }
+
+        float error = 0.0f;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            float best = std::numeric_limits<float>::max();
+            for (int entry = 0; entry < 8; entry++) {
+                float distance = (palette[entry] - values[i]) * (palette[entry] - values[i]);
+                if (distance < best) {
+                    best = distance;
+                    indices[i] = static_cast<unsigned char>(entry);
+                }
+            }
+
+            error += best;
+        }
+
+        return error;
+    }
+
+    /// @brief Encode one channel of a block as BC4
+    /// @param pixels The pixels
+    /// @param channel The channel to encode
+    /// @param out The 8 byte block
+    void encodeBC4(const float (*pixels)[4], int channel, unsigned char* out) {
+        float values[BLOCK_PIXELS][4];
+        float minimum = 255.0f, maximum = 0.0f;
+        float innerMinimum = 255.0f, innerMaximum = 0.0f;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            float value = pixels[i][channel];
+            values[i][0] = value;
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+
+            // Six value mode gets 0 and 255 for free, so fit its endpoints to the rest
+            if (value > 0.0f && value < 255.0f) {
+                innerMinimum = std::min(innerMinimum, value);
+                innerMaximum = std::max(innerMaximum, value);
+            }
+        }
+
+        float flat[BLOCK_PIXELS];
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            flat[i] = values[i][0];
+        }
+
+        int bestFirst = 0, bestSecond = 0;
+        unsigned char bestIndices[BLOCK_PIXELS] = {};
+        float bestError = std::numeric_limits<float>::max();
+
+        auto tryEndpoints = [&](int first, int second, unsigned char* indices) {
+            float error = fitBC4(first, second, flat, indices);
+            if (error < bestError) {
+                bestError = error;
+                bestFirst = first;
+                bestSecond = second;
+                std::copy(indices, indices + BLOCK_PIXELS, bestIndices);
+            }
+        };
+
+        // Eight value mode, refitting the endpoints to the indices they chose
+        float high[4] = { maximum }, low[4] = { minimum };
+        for (int iteration = 0; iteration <= REFINE_ITERATIONS; iteration++) {
+            int first = std::clamp(static_cast<int>(std::lround(high[0])), 0, 255);
+            int second = std::clamp(static_cast<int>(std::lround(low[0])), 0, 255);
+            if (first < second) {
+                std::swap(first, second);
+            }
+
+            if (first == second) {
+                if (first < 255) {
+                    first++;
+                }
+                else {
+                    second--;
+                }
+            }
+
+            unsigned char indices[BLOCK_PIXELS];
+            tryEndpoints(first, second, indices);
+
+            float weights[BLOCK_PIXELS];
+            for (int i = 0; i < BLOCK_PIXELS; i++) {
+                weights[i] = indices[i] == 0 ? 0.0f : indices[i] == 1 ? 1.0f : (indices[i] - 1) / 7.0f;
+            }
+
+            if (!leastSquares(values, 1, weights, high, low)) {
+                break;
+            }
+        }
+
+        // Six value mode
+        unsigned char indices[BLOCK_PIXELS];
+        if (innerMinimum <= innerMaximum) {
+            tryEndpoints(static_cast<int>(innerMinimum), static_cast<int>(innerMaximum), indices);
+        }
+        else {
+            tryEndpoints(0, 255, indices);
+        }
+
+        std::uint64_t bits = 0;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            bits |= static_cast<std::uint64_t>(bestIndices[i]) << (i * 3);
+        }
+
+        out[0] = static_cast<unsigned char>(bestFirst);
+        out[1] = static_cast<unsigned char>(bestSecond);
+        for (int i = 0; i < 6; i++) {
+            out[2 + i] = static_cast<unsigned char>(bits >> (i * 8));
+        }
+    }
+
+    /// @brief Pick the BC7 palette entry of each pixel
+    /// @param endpoints The two 8 bit RGBA endpoints
+    /// @param pixels The pixels
+    /// @param indices Set to the index of each pixel
+    /// @return The squared error of the block
+    float fitBC7(const int (*endpoints)[4], const float (*pixels)[4], unsigned char* indices) {
+        float palette[16][4];
+        for (int entry = 0; entry < 16; entry++) {
+            for (int c = 0; c < 4; c++) {
+                palette[entry][c] = static_cast<float>(((64 - BC7_WEIGHTS[entry]) * endpoints[0][c] + BC7_WEIGHTS[entry] * endpoints[1][c] + 32) >> 6);
+            }
+        }
+
+        float error = 0.0f;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            float best = std::numeric_limits<float>::max();
+            for (int entry = 0; entry < 16; entry++) {
+                float distance = 0.0f;
+                for (int c = 0; c < 4; c++) {
+                    float difference = palette[entry][c] - pixels[i][c];
+                    distance += difference * difference;
+                }
+
+                if (distance < best) {
+                    best = distance;
+                    indices[i] = static_cast<unsigned char>(entry);
+                }
+            }
+
+            error += best;
+        }
+
+        return error;
+    }
+
+    /// @brief Writes fields into a block from the least significant bit up
+    struct BitWriter {
+        unsigned char* out; ///< The block, which must start zeroed
+        int position;       ///< The next bit to write
+
+        /// @brief Write a field
+        /// @param value The value of the field
+        /// @param bits The width of the field
+        void write(int value, int bits) {
+            for (int i = 0; i < bits; i++, position++) {
+                out[position / 8] |= static_cast<unsigned char>(((value >> i) & 1) << (position % 8));
+            }
+        }
+    };
+
+    /// @brief Find the ETC table and modifiers that best reproduce a subblock from a base colour
+    /// @param base The 8 bit base colour
+    /// @param pixels The pixels of the block
+    /// @param members The indices of the 8 pixels in the subblock
+    /// @param table Set to the best table
+    /// @param indices Set to the modifier index of each member
+    /// @return The squared error of the subblock
+    int fitETCSubblock(const int* base, const unsigned char* pixels, const int* members, int& table, unsigned char* indices) {
+        int bestError = std::numeric_limits<int>::max();
+        for (int candidate = 0; candidate < 8; candidate++) {
+            const int modifiers[4] = { ETC_MODIFIERS[candidate][0], ETC_MODIFIERS[candidate][1], -ETC_MODIFIERS[candidate][0], -ETC_MODIFIERS[candidate][1] };
+
+            int error = 0;
+            unsigned char candidateIndices[8];
+            for (int i = 0; i < 8 && error < bestError; i++) {
+                const unsigned char* pixel = pixels + members[i] * 4;
+                int best = std::numeric_limits<int>::max();
+                for (int entry = 0; entry < 4; entry++) {
+                    int distance = 0;
+                    for (int c = 0; c < 3; c++) {
+                        int difference = std::clamp(base[c] + modifiers[entry], 0, 255) - pixel[c];
+                        distance += difference * difference;
+                    }
+
+                    if (distance < best) {
+                        best = distance;
+                        candidateIndices[i] = static_cast<unsigned char>(entry);
+                    }
+                }
+
+                error += best;
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                table = candidate;
+                std::copy(candidateIndices, candidateIndices + 8, indices);
+            }
+        }
+
+        return bestError;
+    }
+
+    /// @brief A quantized base colour tried for an ETC subblock
+    struct ETCCandidate {
+        int color[3];               ///< The quantized base colour
+        int error;                  ///< Squared error of the subblock
+        int table;                  ///< Best table for the colour
+        unsigned char indices[8];   ///< Best modifier of each member
+    };
+
+    /// @brief Encode a block's colour as ETC2 RGB8 without the T, H and planar modes
+    /// @param pixels The 16 RGBA8 pixels
+    /// @param out The 8 byte block
+    void encodeETCColor(const unsigned char* pixels, unsigned char* out) {
+        int bestError = std::numeric_limits<int>::max();
+
+        for (int flip = 0; flip < 2; flip++) {
+            // Split into 2x4 halves side by side, or 4x2 halves on top of each other when flipped
+            int members[2][8];
+            int counts[2] = {};
+            float averages[2][3] = {};
+            for (int y = 0; y < 4; y++) {
+                for (int x = 0; x < 4; x++) {
+                    int subblock = flip ? (y >= 2) : (x >= 2);
+                    members[subblock][counts[subblock]++] = y * 4 + x;
+                    for (int c = 0; c < 3; c++) {
+                        averages[subblock][c] += pixels[(y * 4 + x) * 4 + c] / 8.0f;
+                    }
+                }
+            }
+
+            for (int differential = 0; differential < 2; differential++) {
+                int levels = differential ? 31 : 15;
+
+                // Try base colours around each half's average, since the modifiers aren't symmetric about it
+                std::vector<ETCCandidate> candidates[2];
+                for (int subblock = 0; subblock < 2; subblock++) {
+                    int center[3];
+                    for (int c = 0; c < 3; c++) {
+                        center[c] = static_cast<int>(std::lround(averages[subblock][c] * levels / 255.0f));
+                    }
+
+                    for (int dr = -1; dr <= 1; dr++) {
+                        for (int dg = -1; dg <= 1; dg++) {
+                            for (int db = -1; db <= 1; db++) {
+                                ETCCandidate candidate;
+                                candidate.color[0] = std::clamp(center[0] + dr, 0, levels);
+                                candidate.color[1] = std::clamp(center[1] + dg, 0, levels);
+                                candidate.color[2] = std::clamp(center[2] + db, 0, levels);
+
+                                int base[3];
+                                for (int c = 0; c < 3; c++) {
+                                    base[c] = differential ? (candidate.color[c] << 3) | (candidate.color[c] >> 2) : (candidate.color[c] << 4) | candidate.color[c];
+                                }
+
+                                candidate.error = fitETCSubblock(base, pixels, members[subblock], candidate.table, candidate.indices);
+                                candidates[subblock].push_back(candidate);
+                            }
+                        }
+                    }
+                }
+
+                // Pick the best pair, which in differential mode must be within the 3 bit offset range
+                const ETCCandidate* first = nullptr;
+                const ETCCandidate* second = nullptr;
+                int pairError = std::numeric_limits<int>::max();
+                for (const ETCCandidate& a : candidates[0]) {
+                    for (const ETCCandidate& b : candidates[1]) {
+                        if (a.error + b.error >= pairError) {
+                            continue;
+                        }
+
+                        bool valid = true;
+                        for (int c = 0; c < 3 && differential; c++) {
+                            int offset = b.color[c] - a.color[c];
+                            valid = valid && offset >= -4 && offset <= 3;
+                        }
+
+                        if (valid) {
+                            pairError = a.error + b.error;
+                            first = &a;
+                            second = &b;
+                        }
+                    }
+                }
+
+                if (!first || pairError >= bestError) {
+                    continue;
+                }
+
+                bestError = pairError;
+
+                for (int c = 0; c < 3; c++) {
+                    out[c] = differential ?
+                        static_cast<unsigned char>((first->color[c] << 3) | ((second->color[c] - first->color[c]) & 7)) :
+                        static_cast<unsigned char>((first->color[c] << 4) | second->color[c]);
+                }
+                out[3] = static_cast<unsigned char>((first->table << 5) | (second->table << 2) | (differential << 1) | flip);
+
+                // Pixel indices are stored column by column, most significant bits in the upper half
+                std::uint32_t bits = 0;
+                for (int subblock = 0; subblock < 2; subblock++) {
+                    const ETCCandidate* chosen = subblock == 0 ? first : second;
+                    for (int i = 0; i < 8; i++) {
+                        int pixel = members[subblock][i];
+                        int bit = (pixel % 4) * 4 + pixel / 4;
+                        bits |= static_cast<std::uint32_t>(chosen->indices[i] >> 1) << (16 + bit);
+                        bits |= static_cast<std::uint32_t>(chosen->indices[i] & 1) << bit;
+                    }
+                }
+
+                for (int i = 0; i < 4; i++) {
+                    out[4 + i] = static_cast<unsigned char>(bits >> (24 - i * 8));
+                }
+            }
+        }
+    }
+
+    /// @brief Encode a block's alpha as EAC
+    /// @param pixels The 16 RGBA8 pixels
+    /// @param out The 8 byte block
+    void encodeEAC(const unsigned char* pixels, unsigned char* out) {
+        int minimum = 255, maximum = 0;
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            minimum = std::min(minimum, static_cast<int>(pixels[i * 4 + 3]));
+            maximum = std::max(maximum, static_cast<int>(pixels[i * 4 + 3]));
+        }
+
+        // A flat block uses the table with a zero modifier
+        int bestBase = minimum, bestMultiplier = 1, bestTable = 13;
+        unsigned char bestIndices[BLOCK_PIXELS];
+        std::fill(bestIndices, bestIndices + BLOCK_PIXELS, 4);
+
+        if (minimum != maximum) {
+            int bestError = std::numeric_limits<int>::max();
+            for (int table = 0; table < 16; table++) {
+                for (int multiplier = 1; multiplier < 16; multiplier++) {
+                    // Centre the table's range on the block's range
+                    int span = (EAC_MODIFIERS[table][3] + EAC_MODIFIERS[table][7]) * multiplier;
+                    int center = static_cast<int>(std::lround((minimum + maximum - span) / 2.0f));
+
+                    for (int base = std::max(center - 1, 0); base <= std::min(center + 1, 255); base++) {
+                        int error = 0;
+                        unsigned char indices[BLOCK_PIXELS];
+                        for (int i = 0; i < BLOCK_PIXELS && error < bestError; i++) {
+                            int best = std::numeric_limits<int>::max();
+                            for (int entry = 0; entry < 8; entry++) {
+                                int difference = std::clamp(base + EAC_MODIFIERS[table][entry] * multiplier, 0, 255) - pixels[i * 4 + 3];
+                                if (difference * difference < best) {
+                                    best = difference * difference;
+                                    indices[i] = static_cast<unsigned char>(entry);
+                                }
+                            }
+
+                            error += best;
+                        }
+
+                        if (error < bestError) {
+                            bestError = error;
+                            bestBase = base;
+                            bestMultiplier = multiplier;
+                            bestTable = table;
+                            std::copy(indices, indices + BLOCK_PIXELS, bestIndices);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Indices are stored column by column from the most significant bit down
+        std::uint64_t bits = 0;
+        for (int x = 0; x < 4; x++) {
+            for (int y = 0; y < 4; y++) {
+                int bit = x * 4 + y;
+                bits |= static_cast<std::uint64_t>(bestIndices[y * 4 + x]) << (45 - bit * 3);
+            }
+        }
+
+        out[0] = static_cast<unsigned char>(bestBase);
+        out[1] = static_cast<unsigned char>((bestMultiplier << 4) | bestTable);
+        for (int i = 0; i < 6; i++) {
+            out[2 + i] = static_cast<unsigned char>(bits >> (40 - i * 8));
+        }
+    }
+}
+
+void lov::Graphics::BlockEncoder::encodeBC1(const unsigned char* pixels, unsigned char* out) {
+    float values[BLOCK_PIXELS][4];
+    toFloat(pixels, values);
+    encodeColor(values, out);
+}
+
+void lov::Graphics::BlockEncoder::encodeBC3(const unsigned char* pixels, unsigned char* out) {
+    float values[BLOCK_PIXELS][4];
+    toFloat(pixels, values);
+    encodeBC4(values, 3, out);
+    encodeColor(values, out + 8);
+}
+
+void lov::Graphics::BlockEncoder::encodeBC5(const unsigned char* pixels, unsigned char* out) {
+    float values[BLOCK_PIXELS][4];
+    toFloat(pixels, values);
+    encodeBC4(values, 0, out);
+    encodeBC4(values, 1, out + 8);
+}
+
+void lov::Graphics::BlockEncoder::encodeBC7(const unsigned char* pixels, unsigned char* out) {
+    float values[BLOCK_PIXELS][4];
+    toFloat(pixels, values);
+
+    float low[4], high[4];
+    axisEndpoints(values, 4, low, high);
+
+    int bestEndpoints[2][4] = {};
+    int bestQuantized[2][4] = {};
+    int bestParity[2] = {};
+    unsigned char bestIndices[BLOCK_PIXELS] = {};
+    float bestError = std::numeric_limits<float>::max();
+
+    for (int iteration = 0; iteration <= REFINE_ITERATIONS; iteration++) {
+        // Each endpoint is 7 bits per channel plus a p-bit shared by its channels, so try every p-bit pair
+        unsigned char indices[BLOCK_PIXELS];
+        for (int parity = 0; parity < 4; parity++) {
+            int endpoints[2][4], quantized[2][4];
+            int bits[2] = { parity & 1, parity >> 1 };
+            for (int c = 0; c < 4; c++) {
+                quantized[0][c] = std::clamp(static_cast<int>(std::lround((low[c] - bits[0]) / 2.0f)), 0, 127);
+                quantized[1][c] = std::clamp(static_cast<int>(std::lround((high[c] - bits[1]) / 2.0f)), 0, 127);
+                endpoints[0][c] = quantized[0][c] * 2 + bits[0];
+                endpoints[1][c] = quantized[1][c] * 2 + bits[1];
+            }
+
+            float error = fitBC7(endpoints, values, indices);
+            if (error < bestError) {
+                bestError = error;
+                std::copy(&endpoints[0][0], &endpoints[0][0] + 8, &bestEndpoints[0][0]);
+                std::copy(&quantized[0][0], &quantized[0][0] + 8, &bestQuantized[0][0]);
+                bestParity[0] = bits[0];
+                bestParity[1] = bits[1];
+                std::copy(indices, indices + BLOCK_PIXELS, bestIndices);
+            }
+        }
+
+        // Refit to the indices of the best block so far
+        float weights[BLOCK_PIXELS];
+        fitBC7(bestEndpoints, values, indices);
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+        }
+
+        if (!leastSquares(values, 4, weights, low, high)) {
+            break;
+        }
+    }
+
+    // The first pixel's index is stored without its top bit, so swap the endpoints if it needs one
+    if (bestIndices[0] >= 8) {
+        for (int c = 0; c < 4; c++) {
+            std::swap(bestQuantized[0][c], bestQuantized[1][c]);
+        }
+
+        std::swap(bestParity[0], bestParity[1]);
+        for (int i = 0; i < BLOCK_PIXELS; i++) {
+            bestIndices[i] = static_cast<unsigned char>(15 - bestIndices[i]);
+        }
+    }
+
+    std::fill(out, out + 16, 0);
+    BitWriter writer = { out, 0 };
+    writer.write(1 << 6, 7);
+    for (int c = 0; c < 4; c++) {
+        writer.write(bestQuantized[0][c], 7);
+        writer.write(bestQuantized[1][c], 7);
+    }
+
+    writer.write(bestParity[0], 1);
+    writer.write(bestParity[1], 1);
+    writer.write(bestIndices[0], 3);
+    for (int i = 1; i < BLOCK_PIXELS; i++) {
+        writer.write(bestIndices[i], 4);
+    }
+}
+
+void lov::Graphics::BlockEncoder::encodeETC2(const unsigned char* pixels, unsigned char* out) {
+    encodeETCColor(pixels, out);
+}
+
+void lov::Graphics::BlockEncoder::encodeETC2Alpha(const unsigned char* pixels, unsigned char* out) {
+    encodeEAC(pixels, out);
+    encodeETCColor(pixels, out + 8);
+}
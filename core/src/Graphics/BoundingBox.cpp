@@ -0,0 +1,63 @@
+#include "Graphics/BoundingBox.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+lov::Graphics::BoundingBox::BoundingBox():
+    min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+    max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest())
+{}
+
+lov::Graphics::BoundingBox::BoundingBox(const Vector3f& min, const Vector3f& max):
+    min(min),
+    max(max)
+{}
+
+bool lov::Graphics::BoundingBox::isEmpty() const {
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+void lov::Graphics::BoundingBox::expand(const Vector3f& point) {
+    // Grow each axis to include the point
+    for (int i = 0; i < 3; i++) {
+        min[i] = std::min(min[i], point[i]);
+        max[i] = std::max(max[i], point[i]);
+    }
+}
+
+void lov::Graphics::BoundingBox::expand(const BoundingBox& other) {
+    if (other.isEmpty()) {
+        return;
+    }
+
+    expand(other.min);
+    expand(other.max);
+}
+
+lov::Vector3f lov::Graphics::BoundingBox::getCenter() const {
+    return (min + max) * 0.5f;
+}
+
+lov::Vector3f lov::Graphics::BoundingBox::getExtents() const {
+    return (max - min) * 0.5f;
+}
+
+lov::Graphics::BoundingBox lov::Graphics::BoundingBox::transformed(const Transform& transform) const {
+    if (isEmpty()) {
+        return BoundingBox();
+    }
+
+    // Transform the center, then project the extents onto the absolute value of each basis, see Arvo's "Transforming Axis-Aligned Bounding Boxes"
+    Vector3f center = getCenter();
+    Vector3f extents = getExtents();
+    Vector4f worldCenter = transform * Vector4f(center.x, center.y, center.z, 1.0f);
+
+    Vector3f worldExtents(0.0f, 0.0f, 0.0f);
+    for (int row = 0; row < 3; row++) {
+        worldExtents[row] = fabsf(transform.x[row]) * extents.x + fabsf(transform.y[row]) * extents.y + fabsf(transform.z[row]) * extents.z;
+    }
+
+    Vector3f newCenter(worldCenter.x, worldCenter.y, worldCenter.z);
+    return BoundingBox(newCenter - worldExtents, newCenter + worldExtents);
+}
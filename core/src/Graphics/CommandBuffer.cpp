@@ -0,0 +1,132 @@
+#include "Graphics/CommandBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+lov::Graphics::CommandBuffer::CommandBuffer(size_t blockSize):
+    m_allocator(blockSize),
+    m_open(false),
+    m_last(nullptr),
+    m_uniformSize(0)
+{}
+
+void lov::Graphics::CommandBuffer::begin(uint64_t key) {
+    m_groups.push_back({ key, nullptr });
+    m_open = true;
+    m_last = nullptr;
+}
+
+void lov::Graphics::CommandBuffer::bindProgram(lov_uint program) {
+    append(RenderCommandType::BindProgram)->program = program;
+}
+
+void lov::Graphics::CommandBuffer::setUniformBlock(lov_uint binding, const void* data, lov_uint size) {
+    // Copy the data, since the caller's is usually on its stack
+    void* copy = m_allocator.allocate(size, 16);
+    std::memcpy(copy, data, size);
+
+    RenderCommand* command = append(RenderCommandType::SetUniformBlock);
+    command->uniformBlock.binding = binding;
+    command->uniformBlock.size = size;
+    command->uniformBlock.data = copy;
+    m_uniformSize += size;
+}
+
+void lov::Graphics::CommandBuffer::bindVertexArray(lov_uint vertexArray) {
+    append(RenderCommandType::BindVertexArray)->vertexArray = vertexArray;
+}
+
+void lov::Graphics::CommandBuffer::drawElements(lov_size count, lov_uint firstIndex, lov_int baseVertex, lov_size instanceCount) {
+    RenderCommand* command = append(RenderCommandType::DrawElements);
+    command->draw.count = count;
+    command->draw.firstIndex = firstIndex;
+    command->draw.baseVertex = baseVertex;
+    command->draw.instanceCount = instanceCount;
+}
+
+void lov::Graphics::CommandBuffer::sort() {
+    std::stable_sort(m_groups.begin(), m_groups.end(), [](const RenderCommandGroup& a, const RenderCommandGroup& b) {
+        return a.key < b.key;
+    });
+
+    m_open = false;
+    m_last = nullptr;
+}
+
+void lov::Graphics::CommandBuffer::clear() {
+    m_allocator.reset();
+    m_groups.clear();
+    m_open = false;
+    m_last = nullptr;
+    m_uniformSize = 0;
+}
+
+std::span<const lov::Graphics::RenderCommandGroup> lov::Graphics::CommandBuffer::getGroups() const {
+    return m_groups;
+}
+
+size_t lov::Graphics::CommandBuffer::getUniformSize() const {
+    return m_uniformSize;
+}
+
+void lov::Graphics::CommandBuffer::merge(std::span<const CommandBuffer> buffers, std::vector<const RenderCommandGroup*>& groups) {
+    groups.clear();
+
+    // The next group of each buffer, in a heap ordered by key and then buffer, smallest on top
+    struct Cursor {
+        const RenderCommandGroup* group;
+        const RenderCommandGroup* end;
+        size_t buffer;
+    };
+
+    auto after = [](const Cursor& a, const Cursor& b) {
+        return a.group->key != b.group->key ? a.group->key > b.group->key : a.buffer > b.buffer;
+    };
+
+    std::vector<Cursor> heap;
+    size_t total = 0;
+    for (size_t i = 0; i < buffers.size(); i++) {
+        std::span<const RenderCommandGroup> bufferGroups = buffers[i].getGroups();
+        if (!bufferGroups.empty()) {
+            heap.push_back({ bufferGroups.data(), bufferGroups.data() + bufferGroups.size(), i });
+            total += bufferGroups.size();
+        }
+    }
+
+    std::make_heap(heap.begin(), heap.end(), after);
+    groups.reserve(total);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), after);
+        Cursor& cursor = heap.back();
+        groups.push_back(cursor.group);
+
+        if (++cursor.group == cursor.end) {
+            heap.pop_back();
+        }
+        else {
+            std::push_heap(heap.begin(), heap.end(), after);
+        }
+    }
+}
+
+lov::Graphics::RenderCommand* lov::Graphics::CommandBuffer::append(RenderCommandType type) {
+    if (!m_open) {
+        begin(0);
+    }
+
+    RenderCommand* command = m_allocator.create<RenderCommand>();
+    command->type = type;
+    command->next = nullptr;
+
+    // Chain it after the group's last command, which may be anywhere in the allocator
+    if (m_last) {
+        m_last->next = command;
+    }
+    else {
+        m_groups.back().first = command;
+    }
+
+    m_last = command;
+    return command;
+}
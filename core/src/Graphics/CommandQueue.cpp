@@ -0,0 +1,101 @@
+#include "Graphics/CommandQueue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+lov::Graphics::CommandQueue::CommandQueue():
+    m_uniformCapacity(0),
+    m_stats()
+{
+    glGenBuffers(1, &m_uniformBuffer);
+
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    m_uniformAlignment = static_cast<size_t>(std::max(alignment, 1));
+}
+
+lov::Graphics::CommandQueue::~CommandQueue() {
+    glDeleteBuffers(1, &m_uniformBuffer);
+}
+
+void lov::Graphics::CommandQueue::execute(std::span<const CommandBuffer> buffers) {
+    m_stats = CommandQueueStats();
+    CommandBuffer::merge(buffers, m_groups);
+    m_stats.groups = static_cast<lov_uint>(m_groups.size());
+
+    // Pack every uniform block in replay order, each at an offset OpenGL can bind a range from
+    m_uniforms.clear();
+    for (const RenderCommandGroup* group : m_groups) {
+        for (const RenderCommand* command = group->first; command; command = command->next) {
+            if (command->type == RenderCommandType::SetUniformBlock) {
+                size_t offset = (m_uniforms.size() + m_uniformAlignment - 1) / m_uniformAlignment * m_uniformAlignment;
+                m_uniforms.resize(offset + command->uniformBlock.size);
+                std::memcpy(m_uniforms.data() + offset, command->uniformBlock.data, command->uniformBlock.size);
+            }
+        }
+    }
+
+    m_stats.uniformBytes = m_uniforms.size();
+    if (!m_uniforms.empty()) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_uniformBuffer);
+
+        // Orphan the old storage rather than wait for draws still reading it
+        lov_size size = static_cast<lov_size>(m_uniforms.size());
+        if (size > m_uniformCapacity) {
+            m_uniformCapacity = std::max(size, m_uniformCapacity * 2);
+        }
+
+        glBufferData(GL_UNIFORM_BUFFER, m_uniformCapacity, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, m_uniforms.data());
+    }
+
+    // Whatever was bound before is unknown, so the first bind of each kind always happens
+    bool programBound = false;
+    bool vertexArrayBound = false;
+    lov_uint program = 0;
+    lov_uint vertexArray = 0;
+    size_t uniformOffset = 0;
+
+    for (const RenderCommandGroup* group : m_groups) {
+        for (const RenderCommand* command = group->first; command; command = command->next) {
+            switch (command->type) {
+            case RenderCommandType::BindProgram:
+                if (!programBound || command->program != program) {
+                    programBound = true;
+                    program = command->program;
+                    glUseProgram(program);
+                    m_stats.programBinds++;
+                }
+                break;
+
+            case RenderCommandType::SetUniformBlock:
+                uniformOffset = (uniformOffset + m_uniformAlignment - 1) / m_uniformAlignment * m_uniformAlignment;
+                glBindBufferRange(GL_UNIFORM_BUFFER, command->uniformBlock.binding, m_uniformBuffer, uniformOffset, command->uniformBlock.size);
+                uniformOffset += command->uniformBlock.size;
+                m_stats.uniformBlocks++;
+                break;
+
+            case RenderCommandType::BindVertexArray:
+                if (!vertexArrayBound || command->vertexArray != vertexArray) {
+                    vertexArrayBound = true;
+                    vertexArray = command->vertexArray;
+                    glBindVertexArray(vertexArray);
+                    m_stats.vertexArrayBinds++;
+                }
+                break;
+
+            case RenderCommandType::DrawElements:
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command->draw.count, GL_UNSIGNED_INT,
+                    reinterpret_cast<const void*>(static_cast<uintptr_t>(command->draw.firstIndex) * sizeof(lov_uint)),
+                    command->draw.instanceCount, command->draw.baseVertex);
+                m_stats.draws++;
+                break;
+            }
+        }
+    }
+}
+
+lov::Graphics::CommandQueueStats lov::Graphics::CommandQueue::getStats() const {
+    return m_stats;
+}
@@ -0,0 +1,198 @@
+#include "Graphics/ComputeCuller.h"
+
+#include "Graphics/Frustum.h"
+#include "Graphics/GLExtensions.h"
+
+#include <algorithm>
+
+lov::Graphics::ComputeCuller::ComputeCuller():
+    m_pyramidTexture(0),
+    m_pyramidLevels(0),
+    m_pyramid(nullptr)
+{}
+
+lov::Graphics::ComputeCuller::~ComputeCuller() {
+    // Delete the depth pyramid texture
+    if (m_pyramidTexture != 0) {
+        glDeleteTextures(1, &m_pyramidTexture);
+    }
+}
+
+bool lov::Graphics::ComputeCuller::isSupported() {
+    return GLExtensions::hasComputeShaders() && GLExtensions::hasDrawIndirect();
+}
+
+void lov::Graphics::ComputeCuller::compile(const std::string& computeShaderPath) {
+    m_shader.compileComputeFromFile(computeShaderPath);
+}
+
+lov::lov_uint lov::Graphics::ComputeCuller::addDraw(lov_uint indexCount, lov_uint firstIndex, lov_int baseVertex) {
+    m_draws.push_back({ indexCount, 0, firstIndex, baseVertex, 0 });
+    return static_cast<lov_uint>(m_draws.size() - 1);
+}
+
+lov::lov_uint lov::Graphics::ComputeCuller::addInstance(const Transform& model, const BoundingBox& bounds, lov_uint draw) {
+    Vector3f center = bounds.getCenter();
+    Vector3f extents = bounds.getExtents();
+
+    CullInstance instance;
+    instance.model = model;
+    instance.center = { center.x, center.y, center.z, 0.0f };
+    instance.extents = { extents.x, extents.y, extents.z, 0.0f };
+    instance.command = draw;
+    instance.padding[0] = instance.padding[1] = instance.padding[2] = 0;
+
+    m_instances.push_back(instance);
+    return static_cast<lov_uint>(m_instances.size() - 1);
+}
+
+void lov::Graphics::ComputeCuller::setTransform(lov_uint instance, const Transform& model) {
+    m_instances[instance].model = model;
+}
+
+void lov::Graphics::ComputeCuller::upload() {
+    // Give each draw a range of the visible buffer large enough for all of its instances
+    std::vector<lov_uint> instanceCounts(m_draws.size(), 0);
+    for (const CullInstance& instance : m_instances) {
+        instanceCounts[instance.command]++;
+    }
+
+    lov_uint baseInstance = 0;
+    for (size_t i = 0; i < m_draws.size(); i++) {
+        m_draws[i].instanceCount = 0;
+        m_draws[i].baseInstance = baseInstance;
+        baseInstance += instanceCounts[i];
+    }
+
+    // Upload the instances and size the visible buffer
+    m_instanceBuffer.bufferData(m_instances.data(), static_cast<lov_size>(m_instances.size() * sizeof(CullInstance)));
+    m_visibleBuffer.bufferData<lov_uint>(nullptr, static_cast<lov_size>(std::max<size_t>(m_instances.size(), 1) * sizeof(lov_uint)));
+    m_visibleBuffer.unbind();
+
+    // The CPU copy of the commands holds the zeroed counts uploaded before each cull
+    m_commands.clear();
+    for (const DrawElementsIndirectCommand& draw : m_draws) {
+        m_commands.add(draw);
+    }
+    m_commands.reserve(m_commands.getCommandCount());
+}
+
+void lov::Graphics::ComputeCuller::setDepthPyramid(const DepthPyramid* pyramid) {
+    m_pyramid = pyramid;
+    m_pyramidLevels = pyramid ? pyramid->getLevelCount() : 0;
+
+    if (m_pyramidLevels == 0) {
+        return;
+    }
+
+    if (m_pyramidTexture == 0) {
+        glGenTextures(1, &m_pyramidTexture);
+    }
+
+    // Upload every level as a single channel float texture
+    glBindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_pyramidLevels - 1);
+
+    for (lov_size level = 0; level < m_pyramidLevels; level++) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_R32F, pyramid->getWidth(level), pyramid->getHeight(level), 0, GL_RED, GL_FLOAT, pyramid->getLevel(level).data());
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void lov::Graphics::ComputeCuller::cull(const Transform& viewProjection) {
+    if (m_instances.empty()) {
+        return;
+    }
+
+    // Reset the instance counts of every command
+    m_commands.upload();
+
+    // Bind the buffers to the blocks of cull.comp
+    m_instanceBuffer.bindBase(0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_commands.getID());
+    m_visibleBuffer.bindBase(2);
+
+    // Set the uniforms
+    Frustum frustum(viewProjection);
+    m_shader.bind();
+    m_shader.setUniform("instanceCount", static_cast<int>(m_instances.size()));
+    m_shader.setUniform("viewProjection", viewProjection);
+    for (int i = 0; i < 6; i++) {
+        m_shader.setUniform("planes[" + std::to_string(i) + "]", frustum.getPlane(static_cast<Frustum::Plane>(i)));
+    }
+
+    m_shader.setUniform("useDepthPyramid", m_pyramidLevels > 0);
+    if (m_pyramidLevels > 0) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+        m_shader.setUniform("depthPyramid", 0);
+        m_shader.setUniform("pyramidLevels", static_cast<int>(m_pyramidLevels));
+    }
+
+    // Cull 64 instances per work group
+    glDispatchCompute((static_cast<lov_uint>(m_instances.size()) + 63) / 64, 1, 1);
+
+    // Make the written commands and visible indices available to the draws
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void lov::Graphics::ComputeCuller::draw() const {
+    m_commands.draw();
+}
+
+void lov::Graphics::ComputeCuller::linkVisibleInstances(const VertexArray& vao, lov_uint location) const {
+    // Source the attribute from the visible buffer, advancing once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, m_visibleBuffer.getID());
+    vao.linkIntegerAttribute(location, 1, LOV_UNSIGNED_INT, sizeof(lov_uint), 0);
+    vao.setAttributeDivisor(location, 1);
+}
+
+void lov::Graphics::ComputeCuller::cullReference(const Transform& viewProjection, std::vector<DrawElementsIndirectCommand>& commands, std::vector<lov_uint>& visible) const {
+    InstanceCulling::cull(m_instances, m_draws, viewProjection, m_pyramid, commands, visible);
+}
+
+lov::lov_size lov::Graphics::ComputeCuller::validate(const Transform& viewProjection) const {
+    std::vector<DrawElementsIndirectCommand> expectedCommands;
+    std::vector<lov_uint> expectedVisible;
+    cullReference(viewProjection, expectedCommands, expectedVisible);
+
+    // Read back what the shader wrote
+    std::vector<DrawElementsIndirectCommand> commands(m_draws.size());
+    std::vector<lov_uint> visible(m_instances.size());
+
+    m_commands.bind();
+    glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+    m_visibleBuffer.bind();
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, visible.size() * sizeof(lov_uint), visible.data());
+    m_visibleBuffer.unbind();
+
+    // The shader appends in any order, so compare each command's instances as sorted sets
+    lov_size mismatches = 0;
+    for (size_t i = 0; i < commands.size(); i++) {
+        if (commands[i].instanceCount != expectedCommands[i].instanceCount) {
+            mismatches++;
+            continue;
+        }
+
+        auto begin = visible.begin() + commands[i].baseInstance;
+        auto expectedBegin = expectedVisible.begin() + expectedCommands[i].baseInstance;
+        std::sort(begin, begin + commands[i].instanceCount);
+        std::sort(expectedBegin, expectedBegin + expectedCommands[i].instanceCount);
+
+        if (!std::equal(begin, begin + commands[i].instanceCount, expectedBegin)) {
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+const std::vector<lov::Graphics::CullInstance>& lov::Graphics::ComputeCuller::getInstances() const {
+    return m_instances;
+}
@@ -0,0 +1,160 @@
+#include "Graphics/DepthPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+
+lov::Graphics::DepthPyramid::DepthPyramid() {}
+
+void lov::Graphics::DepthPyramid::build(const float* depth, lov_size width, lov_size height) {
+    m_levels.clear();
+    m_minLevels.clear();
+    m_widths.clear();
+    m_heights.clear();
+
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // Level 0 is a copy of the depth buffer
+    m_levels.emplace_back(depth, depth + width * height);
+    m_minLevels.push_back(m_levels.back());
+    m_widths.push_back(width);
+    m_heights.push_back(height);
+
+    // Halve each level, keeping the farthest and nearest depths. Odd edges fold into the last texel so nothing is lost
+    while (m_widths.back() > 1 || m_heights.back() > 1) {
+        const std::vector<float>& source = m_levels.back();
+        const std::vector<float>& minSource = m_minLevels.back();
+        lov_size sourceWidth = m_widths.back();
+        lov_size sourceHeight = m_heights.back();
+        lov_size levelWidth = std::max(sourceWidth / 2, 1);
+        lov_size levelHeight = std::max(sourceHeight / 2, 1);
+
+        std::vector<float> level(levelWidth * levelHeight, 0.0f);
+        std::vector<float> minLevel(levelWidth * levelHeight, 1.0f);
+        for (lov_size y = 0; y < sourceHeight; y++) {
+            lov_size ty = std::min(y / 2, levelHeight - 1);
+            for (lov_size x = 0; x < sourceWidth; x++) {
+                lov_size tx = std::min(x / 2, levelWidth - 1);
+                float& texel = level[ty * levelWidth + tx];
+                texel = std::max(texel, source[y * sourceWidth + x]);
+                float& minTexel = minLevel[ty * levelWidth + tx];
+                minTexel = std::min(minTexel, minSource[y * sourceWidth + x]);
+            }
+        }
+
+        m_levels.push_back(std::move(level));
+        m_minLevels.push_back(std::move(minLevel));
+        m_widths.push_back(levelWidth);
+        m_heights.push_back(levelHeight);
+    }
+}
+
+lov::lov_size lov::Graphics::DepthPyramid::getLevelCount() const {
+    return static_cast<lov_size>(m_levels.size());
+}
+
+lov::lov_size lov::Graphics::DepthPyramid::getWidth(lov_size level) const {
+    return m_widths[level];
+}
+
+lov::lov_size lov::Graphics::DepthPyramid::getHeight(lov_size level) const {
+    return m_heights[level];
+}
+
+float lov::Graphics::DepthPyramid::getDepth(lov_size level, lov_size x, lov_size y) const {
+    return m_levels[level][y * m_widths[level] + x];
+}
+
+float lov::Graphics::DepthPyramid::getMinDepth(lov_size level, lov_size x, lov_size y) const {
+    return m_minLevels[level][y * m_widths[level] + x];
+}
+
+const std::vector<float>& lov::Graphics::DepthPyramid::getLevel(lov_size level) const {
+    return m_levels[level];
+}
+
+bool lov::Graphics::DepthPyramid::isOccluded(const Vector2f& screenMin, const Vector2f& screenMax, float nearestDepth) const {
+    if (m_levels.empty()) {
+        return false;
+    }
+
+    // Clamp the rectangle to the screen
+    int maxX = m_widths[0] - 1;
+    int maxY = m_heights[0] - 1;
+    int x0 = std::clamp(static_cast<int>(floorf(screenMin.x)), 0, maxX);
+    int y0 = std::clamp(static_cast<int>(floorf(screenMin.y)), 0, maxY);
+    int x1 = std::clamp(static_cast<int>(floorf(screenMax.x)), 0, maxX);
+    int y1 = std::clamp(static_cast<int>(floorf(screenMax.y)), 0, maxY);
+
+    // Pick the level where the rectangle spans at most two texels on each axis
+    int size = std::max(x1 - x0, y1 - y0) + 1;
+    int level = 0;
+    while ((1 << level) < size) {
+        level++;
+    }
+    level = std::min(level, static_cast<int>(m_levels.size()) - 1);
+
+    int levelMaxX = m_widths[level] - 1;
+    int levelMaxY = m_heights[level] - 1;
+    int lx0 = std::min(x0 >> level, levelMaxX);
+    int ly0 = std::min(y0 >> level, levelMaxY);
+    int lx1 = std::min(x1 >> level, levelMaxX);
+    int ly1 = std::min(y1 >> level, levelMaxY);
+
+    // The object is hidden if it is behind the farthest depth of every covered texel
+    float farthest = std::max(
+        std::max(getDepth(level, lx0, ly0), getDepth(level, lx1, ly0)),
+        std::max(getDepth(level, lx0, ly1), getDepth(level, lx1, ly1))
+    );
+
+    return nearestDepth > farthest;
+}
+
+bool lov::Graphics::DepthPyramid::isOccludedExact(lov_int x0, lov_int y0, lov_int x1, lov_int y1, float nearestDepth) const {
+    if (m_levels.empty()) {
+        return false;
+    }
+
+    // Clamp the rectangle to the screen
+    x0 = std::clamp(x0, 0, m_widths[0] - 1);
+    y0 = std::clamp(y0, 0, m_heights[0] - 1);
+    x1 = std::clamp(x1, 0, m_widths[0] - 1);
+    y1 = std::clamp(y1, 0, m_heights[0] - 1);
+
+    return isOccludedAt(getLevelCount() - 1, x0, y0, x1, y1, nearestDepth);
+}
+
+bool lov::Graphics::DepthPyramid::isOccludedAt(lov_size level, lov_int x0, lov_int y0, lov_int x1, lov_int y1, float nearestDepth) const {
+    // The texels of this level overlapping the rectangle, where the last texel also covers any folded odd edge
+    lov_int lx0 = std::min(x0 >> level, m_widths[level] - 1);
+    lov_int ly0 = std::min(y0 >> level, m_heights[level] - 1);
+    lov_int lx1 = std::min(x1 >> level, m_widths[level] - 1);
+    lov_int ly1 = std::min(y1 >> level, m_heights[level] - 1);
+
+    for (lov_int ty = ly0; ty <= ly1; ty++) {
+        for (lov_int tx = lx0; tx <= lx1; tx++) {
+            // Every pixel under this texel is nearer than the object
+            if (nearestDepth > getDepth(level, tx, ty)) {
+                continue;
+            }
+
+            // Some pixel of the rectangle under this texel is at or behind the object
+            if (level == 0 || nearestDepth <= getMinDepth(level, tx, ty)) {
+                return false;
+            }
+
+            // Refine the part of the rectangle under this texel. The last texel of a level reaches the screen edge
+            lov_int px0 = std::max(x0, tx << level);
+            lov_int py0 = std::max(y0, ty << level);
+            lov_int px1 = tx == m_widths[level] - 1 ? x1 : std::min(x1, ((tx + 1) << level) - 1);
+            lov_int py1 = ty == m_heights[level] - 1 ? y1 : std::min(y1, ((ty + 1) << level) - 1);
+
+            if (!isOccludedAt(level - 1, px0, py0, px1, py1, nearestDepth)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
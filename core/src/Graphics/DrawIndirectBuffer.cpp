@@ -0,0 +1,114 @@
+#include "Graphics/DrawIndirectBuffer.h"
+
+#include "Graphics/GLExtensions.h"
+
+#include <algorithm>
+
+lov::Graphics::DrawIndirectBuffer::DrawIndirectBuffer():
+    m_capacity(0)
+{
+    // Generate the OpenGL buffer
+    glGenBuffers(1, &m_id);
+}
+
+lov::Graphics::DrawIndirectBuffer::~DrawIndirectBuffer() {
+    // Delete the OpenGL buffer
+    glDeleteBuffers(1, &m_id);
+}
+
+void lov::Graphics::DrawIndirectBuffer::bind() const {
+    // Bind this buffer
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_id);
+}
+
+void lov::Graphics::DrawIndirectBuffer::unbind() const {
+    // Unbind this buffer
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+lov::lov_uint lov::Graphics::DrawIndirectBuffer::add(const DrawElementsIndirectCommand& command) {
+    m_commands.push_back(command);
+    return static_cast<lov_uint>(m_commands.size() - 1);
+}
+
+lov::lov_uint lov::Graphics::DrawIndirectBuffer::add(std::span<const DrawElementsIndirectCommand> commands) {
+    lov_uint first = static_cast<lov_uint>(m_commands.size());
+    m_commands.insert(m_commands.end(), commands.begin(), commands.end());
+    return first;
+}
+
+void lov::Graphics::DrawIndirectBuffer::clear() {
+    m_commands.clear();
+}
+
+void lov::Graphics::DrawIndirectBuffer::reserve(lov_size commandCount) {
+    if (commandCount <= m_capacity || !GLExtensions::hasDrawIndirect()) {
+        return;
+    }
+
+    // Grow geometrically so a slowly growing command list doesn't reallocate every frame
+    m_capacity = std::max(commandCount, m_capacity * 2);
+
+    bind();
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, m_capacity * sizeof(DrawElementsIndirectCommand), NULL, GL_DYNAMIC_DRAW);
+}
+
+void lov::Graphics::DrawIndirectBuffer::upload() {
+    // Without indirect draws the commands are replayed from the CPU copy
+    if (!GLExtensions::hasDrawIndirect() || m_commands.empty()) {
+        return;
+    }
+
+    reserve(getCommandCount());
+
+    bind();
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, m_commands.size() * sizeof(DrawElementsIndirectCommand), m_commands.data());
+}
+
+void lov::Graphics::DrawIndirectBuffer::draw() const {
+    draw(0, getCommandCount());
+}
+
+void lov::Graphics::DrawIndirectBuffer::draw(lov_size first, lov_size commandCount) const {
+    if (commandCount <= 0) {
+        return;
+    }
+
+    if (GLExtensions::hasMultiDrawIndirect()) {
+        // Submit every command with one call
+        bind();
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(first * sizeof(DrawElementsIndirectCommand)), commandCount, 0);
+    }
+    else if (GLExtensions::hasDrawIndirect()) {
+        // Source each draw from the buffer so GPU written commands still work
+        bind();
+        for (lov_size i = first; i < first + commandCount; i++) {
+            glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(i * sizeof(DrawElementsIndirectCommand)));
+        }
+    }
+    else {
+        // Replay the CPU copy, which cannot honour baseInstance before OpenGL 4.2
+        lov_size last = std::min(first + commandCount, getCommandCount());
+        for (lov_size i = first; i < last; i++) {
+            const DrawElementsIndirectCommand& command = m_commands[i];
+            if (command.instanceCount == 0) {
+                continue;
+            }
+
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(static_cast<size_t>(command.firstIndex) * sizeof(lov_uint)), command.instanceCount, command.baseVertex);
+        }
+    }
+}
+
+const std::vector<lov::Graphics::DrawElementsIndirectCommand>& lov::Graphics::DrawIndirectBuffer::getCommands() const {
+    return m_commands;
+}
+
+lov::lov_size lov::Graphics::DrawIndirectBuffer::getCommandCount() const {
+    return static_cast<lov_size>(m_commands.size());
+}
+
+lov::lov_uint lov::Graphics::DrawIndirectBuffer::getID() const {
+    return m_id;
+}
@@ -0,0 +1,73 @@
+#include "Graphics/Frustum.h"
+
+#include <cmath>
+
+lov::Graphics::Frustum::Frustum() {
+    // Planes with no normal and positive distance accept every point
+    for (int i = 0; i < 6; i++) {
+        m_planes[i] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+}
+
+lov::Graphics::Frustum::Frustum(const Transform& viewProjection) {
+    // Rows of the column major matrix, see Gribb & Hartmann's "Fast Extraction of Viewing Frustum Planes"
+    Vector4f row0 = { viewProjection.x[0], viewProjection.y[0], viewProjection.z[0], viewProjection.w[0] };
+    Vector4f row1 = { viewProjection.x[1], viewProjection.y[1], viewProjection.z[1], viewProjection.w[1] };
+    Vector4f row2 = { viewProjection.x[2], viewProjection.y[2], viewProjection.z[2], viewProjection.w[2] };
+    Vector4f row3 = { viewProjection.x[3], viewProjection.y[3], viewProjection.z[3], viewProjection.w[3] };
+
+    m_planes[PLANE_LEFT] = row3 + row0;
+    m_planes[PLANE_RIGHT] = row3 - row0;
+    m_planes[PLANE_BOTTOM] = row3 + row1;
+    m_planes[PLANE_TOP] = row3 - row1;
+    m_planes[PLANE_NEAR] = row3 + row2;
+    m_planes[PLANE_FAR] = row3 - row2;
+
+    // Normalize so distances are in world units
+    for (int i = 0; i < 6; i++) {
+        float length = sqrtf(m_planes[i].x * m_planes[i].x + m_planes[i].y * m_planes[i].y + m_planes[i].z * m_planes[i].z);
+        if (length > 0.0f) {
+            m_planes[i] = m_planes[i] / length;
+        }
+    }
+}
+
+bool lov::Graphics::Frustum::intersects(const BoundingBox& box) const {
+    if (box.isEmpty()) {
+        return false;
+    }
+
+    Vector3f center = box.getCenter();
+    Vector3f extents = box.getExtents();
+
+    // Reject the box if it lies fully behind any plane
+    for (int i = 0; i < 6; i++) {
+        const Vector4f& plane = m_planes[i];
+        float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        float radius = fabsf(plane.x) * extents.x + fabsf(plane.y) * extents.y + fabsf(plane.z) * extents.z;
+
+        if (distance + radius < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool lov::Graphics::Frustum::intersects(const Vector3f& center, float radius) const {
+    // Reject the sphere if it lies fully behind any plane
+    for (int i = 0; i < 6; i++) {
+        const Vector4f& plane = m_planes[i];
+        float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+
+        if (distance + radius < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const lov::Vector4f& lov::Graphics::Frustum::getPlane(Plane plane) const {
+    return m_planes[plane];
+}
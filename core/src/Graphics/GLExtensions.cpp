@@ -0,0 +1,114 @@
+#include "Graphics/GLExtensions.h"
+
+#include <cstring>
+
+LOVPFNGLDRAWELEMENTSINDIRECTPROC lov_glDrawElementsIndirect = nullptr;
+LOVPFNGLMULTIDRAWELEMENTSINDIRECTPROC lov_glMultiDrawElementsIndirect = nullptr;
+LOVPFNGLTEXSTORAGE2DPROC lov_glTexStorage2D = nullptr;
+LOVPFNGLTEXSTORAGE3DPROC lov_glTexStorage3D = nullptr;
+LOVPFNGLDISPATCHCOMPUTEPROC lov_glDispatchCompute = nullptr;
+LOVPFNGLMEMORYBARRIERPROC lov_glMemoryBarrier = nullptr;
+
+namespace {
+    int contextMajor = 0; ///< Major version of the loaded context
+    int contextMinor = 0; ///< Minor version of the loaded context
+
+    bool drawIndirectSupported = false;         ///< Cached result of hasDrawIndirect
+    bool multiDrawIndirectSupported = false;    ///< Cached result of hasMultiDrawIndirect
+    bool textureStorageSupported = false;       ///< Cached result of hasTextureStorage
+    bool computeShadersSupported = false;       ///< Cached result of hasComputeShaders
+    bool conservativeQueriesSupported = false;  ///< Cached result of hasConservativeOcclusionQueries
+    bool s3tcSupported = false;                 ///< Can S3TC (BC1 to BC3) textures be uploaded?
+    bool s3tcSRGBSupported = false;             ///< Can sRGB S3TC textures be uploaded?
+    bool bptcSupported = false;                 ///< Can BPTC (BC7) textures be uploaded?
+    bool etc2Supported = false;                 ///< Can ETC2 and EAC textures be uploaded?
+}
+
+void lov::Graphics::GLExtensions::load(GLADloadproc loader) {
+    // Query the context version
+    glGetIntegerv(GL_MAJOR_VERSION, &contextMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &contextMinor);
+
+    // Look up the entry points, which stay null if the driver lacks them
+    lov_glDrawElementsIndirect = reinterpret_cast<LOVPFNGLDRAWELEMENTSINDIRECTPROC>(loader("glDrawElementsIndirect"));
+    lov_glMultiDrawElementsIndirect = reinterpret_cast<LOVPFNGLMULTIDRAWELEMENTSINDIRECTPROC>(loader("glMultiDrawElementsIndirect"));
+    lov_glTexStorage2D = reinterpret_cast<LOVPFNGLTEXSTORAGE2DPROC>(loader("glTexStorage2D"));
+    lov_glTexStorage3D = reinterpret_cast<LOVPFNGLTEXSTORAGE3DPROC>(loader("glTexStorage3D"));
+    lov_glDispatchCompute = reinterpret_cast<LOVPFNGLDISPATCHCOMPUTEPROC>(loader("glDispatchCompute"));
+    lov_glMemoryBarrier = reinterpret_cast<LOVPFNGLMEMORYBARRIERPROC>(loader("glMemoryBarrier"));
+
+    // Cache feature support so draw paths don't search the extension list
+    drawIndirectSupported = lov_glDrawElementsIndirect && (hasVersion(4, 0) || hasExtension("GL_ARB_draw_indirect"));
+    multiDrawIndirectSupported = lov_glMultiDrawElementsIndirect && (hasVersion(4, 3) || hasExtension("GL_ARB_multi_draw_indirect"));
+    textureStorageSupported = lov_glTexStorage2D && lov_glTexStorage3D && (hasVersion(4, 2) || hasExtension("GL_ARB_texture_storage"));
+    computeShadersSupported = lov_glDispatchCompute && lov_glMemoryBarrier && drawIndirectSupported &&
+        (hasVersion(4, 3) || (hasExtension("GL_ARB_compute_shader") && hasExtension("GL_ARB_shader_storage_buffer_object")));
+    conservativeQueriesSupported = hasVersion(4, 3) || hasExtension("GL_ARB_ES3_compatibility");
+    s3tcSupported = hasExtension("GL_EXT_texture_compression_s3tc");
+    s3tcSRGBSupported = s3tcSupported && (hasExtension("GL_EXT_texture_sRGB") || hasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+    bptcSupported = hasVersion(4, 2) || hasExtension("GL_ARB_texture_compression_bptc");
+    etc2Supported = hasVersion(4, 3) || hasExtension("GL_ARB_ES3_compatibility");
+}
+
+bool lov::Graphics::GLExtensions::hasVersion(int major, int minor) {
+    return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+}
+
+bool lov::Graphics::GLExtensions::hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    // Search the extension list of the context
+    for (GLint i = 0; i < count; i++) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool lov::Graphics::GLExtensions::hasDrawIndirect() {
+    return drawIndirectSupported;
+}
+
+bool lov::Graphics::GLExtensions::hasMultiDrawIndirect() {
+    return multiDrawIndirectSupported;
+}
+
+bool lov::Graphics::GLExtensions::hasTextureStorage() {
+    return textureStorageSupported;
+}
+
+bool lov::Graphics::GLExtensions::hasComputeShaders() {
+    return computeShadersSupported;
+}
+
+bool lov::Graphics::GLExtensions::hasConservativeOcclusionQueries() {
+    return conservativeQueriesSupported;
+}
+
+bool lov::Graphics::GLExtensions::hasCompressedFormat(GLenum internalFormat) {
+    switch (internalFormat) {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        return s3tcSupported;
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        return s3tcSRGBSupported;
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_RG_RGTC2:
+        return hasVersion(3, 0);
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        return bptcSupported;
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_SRGB8_ETC2:
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+    case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+        return etc2Supported;
+    default:
+        return false;
+    }
+}
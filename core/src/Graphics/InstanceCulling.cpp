@@ -0,0 +1,75 @@
+#include "Graphics/InstanceCulling.h"
+
+#include <algorithm>
+#include <limits>
+
+bool lov::Graphics::InstanceCulling::isVisible(const CullInstance& instance, const Frustum& frustum, const Transform& viewProjection, const DepthPyramid* pyramid) {
+    // Bound the instance in world space
+    Vector3f center(instance.center.x, instance.center.y, instance.center.z);
+    Vector3f extents(instance.extents.x, instance.extents.y, instance.extents.z);
+    BoundingBox bounds = BoundingBox(center - extents, center + extents).transformed(instance.model);
+
+    if (!frustum.intersects(bounds)) {
+        return false;
+    }
+
+    if (!pyramid || pyramid->getLevelCount() == 0) {
+        return true;
+    }
+
+    // Project the corners to find the screen rectangle and nearest depth
+    Vector2f screenMin(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    Vector2f screenMax(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+    float nearestDepth = 1.0f;
+
+    for (int corner = 0; corner < 8; corner++) {
+        Vector4f point(
+            (corner & 1) ? bounds.max.x : bounds.min.x,
+            (corner & 2) ? bounds.max.y : bounds.min.y,
+            (corner & 4) ? bounds.max.z : bounds.min.z,
+            1.0f
+        );
+        Vector4f clip = viewProjection * point;
+
+        // Boxes crossing the near plane can't be projected, so keep them
+        if (clip.w <= 0.0f) {
+            return true;
+        }
+
+        float x = (clip.x / clip.w * 0.5f + 0.5f) * pyramid->getWidth(0);
+        float y = (clip.y / clip.w * 0.5f + 0.5f) * pyramid->getHeight(0);
+        float depth = clip.z / clip.w * 0.5f + 0.5f;
+
+        screenMin = { std::min(screenMin.x, x), std::min(screenMin.y, y) };
+        screenMax = { std::max(screenMax.x, x), std::max(screenMax.y, y) };
+        nearestDepth = std::min(nearestDepth, depth);
+    }
+
+    return !pyramid->isOccluded(screenMin, screenMax, nearestDepth);
+}
+
+void lov::Graphics::InstanceCulling::cull(const std::vector<CullInstance>& instances, const std::vector<DrawElementsIndirectCommand>& draws,
+    const Transform& viewProjection, const DepthPyramid* pyramid,
+    std::vector<DrawElementsIndirectCommand>& commands, std::vector<lov_uint>& visible)
+{
+    Frustum frustum(viewProjection);
+
+    // Start every command with no instances
+    commands = draws;
+    for (DrawElementsIndirectCommand& command : commands) {
+        command.instanceCount = 0;
+    }
+
+    visible.assign(instances.size(), 0);
+
+    // Append each visible instance to its command's range
+    for (size_t i = 0; i < instances.size(); i++) {
+        if (!isVisible(instances[i], frustum, viewProjection, pyramid)) {
+            continue;
+        }
+
+        DrawElementsIndirectCommand& command = commands[instances[i].command];
+        visible[command.baseInstance + command.instanceCount] = static_cast<lov_uint>(i);
+        command.instanceCount++;
+    }
+}
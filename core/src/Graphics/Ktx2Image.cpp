@@ -0,0 +1,387 @@
+#include "Graphics/Ktx2Image.h"
+
+#include "Graphics/GLExtensions.h"
+#include "System/Exceptions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    /// @brief The 12 bytes every KTX2 file starts with
+    const unsigned char IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    /// @brief Size of the identifier, header and index that precede the level index
+    const size_t HEADER_SIZE = 80;
+
+    /// @brief Size of each level index entry
+    const size_t LEVEL_INDEX_SIZE = 24;
+
+    /// @brief Orientation recorded in the key/value data, since rows are stored bottom first
+    const char ORIENTATION[] = "ru";
+
+    /// @brief Writer recorded in the key/value data
+    const char WRITER[] = "LovelyEngine TextureBaker";
+
+    /// @brief Append a little endian integer
+    /// @param out The buffer to append to
+    /// @param value The value
+    /// @param bytes The number of bytes to write
+    void put(std::vector<unsigned char>& out, std::uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; i++) {
+            out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+        }
+    }
+
+    /// @brief Overwrite a little endian integer
+    /// @param out The buffer to write into
+    /// @param offset The byte offset of the integer
+    /// @param value The value
+    /// @param bytes The number of bytes to write
+    void putAt(std::vector<unsigned char>& out, size_t offset, std::uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; i++) {
+            out[offset + i] = static_cast<unsigned char>(value >> (i * 8));
+        }
+    }
+
+    /// @brief Read a little endian integer
+    /// @param data The buffer to read from
+    /// @param offset The byte offset of the integer
+    /// @param bytes The number of bytes to read
+    /// @return The value
+    std::uint64_t get(const unsigned char* data, size_t offset, size_t bytes) {
+        std::uint64_t value = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            value |= static_cast<std::uint64_t>(data[offset + i]) << (i * 8);
+        }
+
+        return value;
+    }
+
+    /// @brief Pad a buffer with zeros to a multiple of the alignment
+    /// @param out The buffer
+    /// @param alignment The alignment in bytes
+    void align(std::vector<unsigned char>& out, size_t alignment) {
+        while (out.size() % alignment != 0) {
+            out.push_back(0);
+        }
+    }
+
+    /// @brief Append a sample of a basic data format descriptor covering one channel of a block
+    /// @param out The buffer to append to
+    /// @param bitOffset The first bit of the channel within the block
+    /// @param bitLength The number of bits of the channel
+    /// @param channel The KHR_DF channel ID
+    void putSample(std::vector<unsigned char>& out, lov::lov_uint bitOffset, lov::lov_uint bitLength, lov::lov_uint channel) {
+        put(out, bitOffset, 2);
+        put(out, bitLength - 1, 1);
+        put(out, channel, 1);
+        put(out, 0, 4);
+        put(out, 0, 4);
+        put(out, 0xFFFFFFFF, 4);
+    }
+
+    /// @brief Append the data format descriptor of a format, which KTX2 requires alongside the Vulkan format
+    /// @param out The buffer to append to
+    /// @param format The format
+    void putDescriptor(std::vector<unsigned char>& out, lov::Graphics::Ktx2Image::Format format) {
+        using Format = lov::Graphics::Ktx2Image::Format;
+
+        // Colour model and the channels of each half of the block, from the Khronos data format specification
+        lov::lov_uint model = 0;
+        bool srgb = false;
+        std::vector<lov::lov_uint> channels;
+        switch (format) {
+        case Format::BC1_RGB_SRGB:
+            srgb = true;
+            [[fallthrough]];
+        case Format::BC1_RGB_UNORM:
+            model = 128;
+            channels = { 0 };
+            break;
+        case Format::BC3_SRGB:
+            srgb = true;
+            [[fallthrough]];
+        case Format::BC3_UNORM:
+            model = 130;
+            channels = { 15, 0 };
+            break;
+        case Format::BC5_UNORM:
+            model = 132;
+            channels = { 0, 1 };
+            break;
+        case Format::BC7_SRGB:
+            srgb = true;
+            [[fallthrough]];
+        case Format::BC7_UNORM:
+            model = 134;
+            channels = { 0 };
+            break;
+        case Format::ETC2_RGB_SRGB:
+            srgb = true;
+            [[fallthrough]];
+        case Format::ETC2_RGB_UNORM:
+            model = 161;
+            channels = { 2 };
+            break;
+        case Format::ETC2_RGBA_SRGB:
+            srgb = true;
+            [[fallthrough]];
+        case Format::ETC2_RGBA_UNORM:
+            model = 161;
+            channels = { 15, 2 };
+            break;
+        }
+
+        lov::lov_uint blockSize = lov::Graphics::Ktx2Image::getBlockSize(format);
+        lov::lov_uint sampleBits = blockSize * 8 / static_cast<lov::lov_uint>(channels.size());
+        lov::lov_uint blockLength = 24 + 16 * static_cast<lov::lov_uint>(channels.size());
+
+        put(out, 4 + blockLength, 4);   // Total size
+        put(out, 0, 4);                 // Khronos vendor, basic descriptor type
+        put(out, 2, 2);                 // Version
+        put(out, blockLength, 2);
+        put(out, model, 1);
+        put(out, 1, 1);                 // BT.709 primaries
+        put(out, srgb ? 2 : 1, 1);      // sRGB or linear transfer function
+        put(out, 0, 1);                 // Straight alpha
+        put(out, 3, 1);                 // 4x4x1x1 texel blocks
+        put(out, 3, 1);
+        put(out, 0, 1);
+        put(out, 0, 1);
+        put(out, blockSize, 1);         // One plane of whole blocks
+        put(out, 0, 7);
+
+        for (size_t i = 0; i < channels.size(); i++) {
+            putSample(out, static_cast<lov::lov_uint>(i) * sampleBits, sampleBits, channels[i]);
+        }
+    }
+
+    /// @brief Append a key/value pair, padded to 4 bytes
+    /// @param out The buffer to append to
+    /// @param key The key
+    /// @param value The value, including its terminating null
+    /// @param valueSize The size of the value in bytes
+    void putKeyValue(std::vector<unsigned char>& out, const char* key, const char* value, size_t valueSize) {
+        size_t keySize = strlen(key) + 1;
+        put(out, keySize + valueSize, 4);
+        out.insert(out.end(), key, key + keySize);
+        out.insert(out.end(), value, value + valueSize);
+        align(out, 4);
+    }
+}
+
+lov::Graphics::Ktx2Image::Ktx2Image():
+    m_format(Format::BC7_UNORM),
+    m_width(0),
+    m_height(0)
+{}
+
+lov::Graphics::Ktx2Image::Ktx2Image(Format format, lov_int width, lov_int height):
+    m_format(format),
+    m_width(width),
+    m_height(height)
+{}
+
+lov::Graphics::Ktx2Image lov::Graphics::Ktx2Image::read(const unsigned char* data, size_t size) {
+    if (!isKtx2(data, size) || size < HEADER_SIZE) {
+        throw Exceptions::TextureException("Not a KTX2 file");
+    }
+
+    // Check the header describes something the engine can upload
+    lov_uint format = static_cast<lov_uint>(get(data, 12, 4));
+    lov_int width = static_cast<lov_int>(get(data, 20, 4));
+    lov_int height = static_cast<lov_int>(get(data, 24, 4));
+    lov_uint depth = static_cast<lov_uint>(get(data, 28, 4));
+    lov_uint layers = static_cast<lov_uint>(get(data, 32, 4));
+    lov_uint faces = static_cast<lov_uint>(get(data, 36, 4));
+    std::uint64_t levels = std::max<std::uint64_t>(get(data, 40, 4), 1);
+    lov_uint supercompression = static_cast<lov_uint>(get(data, 44, 4));
+
+    if (getBlockSize(format) == 0) {
+        throw Exceptions::TextureException("Unsupported KTX2 format " + std::to_string(format));
+    }
+
+    if (width <= 0 || height <= 0 || depth > 1 || layers > 1 || faces != 1 || supercompression != 0) {
+        throw Exceptions::TextureException("Only single 2D KTX2 textures without supercompression are supported");
+    }
+
+    if (levels > 32 || HEADER_SIZE + levels * LEVEL_INDEX_SIZE > size) {
+        throw Exceptions::TextureException("KTX2 level index is truncated");
+    }
+
+    Ktx2Image image(static_cast<Format>(format), width, height);
+
+    // Copy each level out of the file, checking it has the size its dimensions imply
+    for (lov_uint level = 0; level < levels; level++) {
+        size_t entry = HEADER_SIZE + level * LEVEL_INDEX_SIZE;
+        std::uint64_t offset = get(data, entry, 8);
+        std::uint64_t length = get(data, entry + 8, 8);
+
+        size_t expected = getLevelSize(format, std::max(width >> level, 1), std::max(height >> level, 1));
+        if (length != expected || offset > size || length > size - offset) {
+            throw Exceptions::TextureException("KTX2 level " + std::to_string(level) + " is malformed");
+        }
+
+        image.m_levels.emplace_back(data + offset, data + offset + length);
+    }
+
+    return image;
+}
+
+lov::Graphics::Ktx2Image lov::Graphics::Ktx2Image::readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw Exceptions::TextureException("Failed to open " + path);
+    }
+
+    std::vector<unsigned char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return read(contents.data(), contents.size());
+}
+
+bool lov::Graphics::Ktx2Image::isKtx2(const unsigned char* data, size_t size) {
+    return size >= sizeof(IDENTIFIER) && memcmp(data, IDENTIFIER, sizeof(IDENTIFIER)) == 0;
+}
+
+std::vector<unsigned char> lov::Graphics::Ktx2Image::write() const {
+    std::vector<unsigned char> out(IDENTIFIER, IDENTIFIER + sizeof(IDENTIFIER));
+
+    // Header
+    put(out, m_format, 4);
+    put(out, 1, 4);         // Type size of block compressed formats
+    put(out, m_width, 4);
+    put(out, m_height, 4);
+    put(out, 0, 4);         // Depth
+    put(out, 0, 4);         // Layers
+    put(out, 1, 4);         // Faces
+    put(out, m_levels.size(), 4);
+    put(out, 0, 4);         // No supercompression
+
+    // Index, filled in once the sections are placed
+    out.resize(HEADER_SIZE + m_levels.size() * LEVEL_INDEX_SIZE, 0);
+
+    size_t descriptorOffset = out.size();
+    putDescriptor(out, m_format);
+    size_t descriptorLength = out.size() - descriptorOffset;
+
+    size_t keyValueOffset = out.size();
+    putKeyValue(out, "KTXorientation", ORIENTATION, sizeof(ORIENTATION));
+    putKeyValue(out, "KTXwriter", WRITER, sizeof(WRITER));
+    size_t keyValueLength = out.size() - keyValueOffset;
+
+    putAt(out, 48, descriptorOffset, 4);
+    putAt(out, 52, descriptorLength, 4);
+    putAt(out, 56, keyValueOffset, 4);
+    putAt(out, 60, keyValueLength, 4);
+
+    // Levels are stored smallest first, each aligned to a whole block
+    for (size_t level = m_levels.size(); level-- > 0;) {
+        align(out, getBlockSize(m_format));
+
+        size_t entry = HEADER_SIZE + level * LEVEL_INDEX_SIZE;
+        putAt(out, entry, out.size(), 8);
+        putAt(out, entry + 8, m_levels[level].size(), 8);
+        putAt(out, entry + 16, m_levels[level].size(), 8);
+
+        out.insert(out.end(), m_levels[level].begin(), m_levels[level].end());
+    }
+
+    return out;
+}
+
+void lov::Graphics::Ktx2Image::writeFile(const std::string& path) const {
+    std::vector<unsigned char> contents = write();
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(contents.data()), contents.size());
+    if (!file) {
+        throw Exceptions::TextureException("Failed to write " + path);
+    }
+}
+
+void lov::Graphics::Ktx2Image::addLevel(std::vector<unsigned char> blocks) {
+    m_levels.push_back(std::move(blocks));
+}
+
+lov::Graphics::Ktx2Image::Format lov::Graphics::Ktx2Image::getFormat() const {
+    return m_format;
+}
+
+lov::lov_int lov::Graphics::Ktx2Image::getWidth() const {
+    return m_width;
+}
+
+lov::lov_int lov::Graphics::Ktx2Image::getHeight() const {
+    return m_height;
+}
+
+lov::lov_size lov::Graphics::Ktx2Image::getLevelCount() const {
+    return static_cast<lov_size>(m_levels.size());
+}
+
+const std::vector<unsigned char>& lov::Graphics::Ktx2Image::getLevel(lov_size level) const {
+    return m_levels[level];
+}
+
+size_t lov::Graphics::Ktx2Image::getByteSize() const {
+    size_t size = 0;
+    for (const std::vector<unsigned char>& level : m_levels) {
+        size += level.size();
+    }
+
+    return size;
+}
+
+lov::lov_uint lov::Graphics::Ktx2Image::getGLFormat() const {
+    switch (m_format) {
+    case Format::BC1_RGB_UNORM:
+        return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case Format::BC1_RGB_SRGB:
+        return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+    case Format::BC3_UNORM:
+        return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case Format::BC3_SRGB:
+        return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case Format::BC5_UNORM:
+        return GL_COMPRESSED_RG_RGTC2;
+    case Format::BC7_UNORM:
+        return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case Format::BC7_SRGB:
+        return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    case Format::ETC2_RGB_UNORM:
+        return GL_COMPRESSED_RGB8_ETC2;
+    case Format::ETC2_RGB_SRGB:
+        return GL_COMPRESSED_SRGB8_ETC2;
+    case Format::ETC2_RGBA_UNORM:
+        return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    case Format::ETC2_RGBA_SRGB:
+        return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+    }
+
+    return 0;
+}
+
+lov::lov_size lov::Graphics::Ktx2Image::getBlockSize(lov_uint format) {
+    switch (format) {
+    case Format::BC1_RGB_UNORM:
+    case Format::BC1_RGB_SRGB:
+    case Format::ETC2_RGB_UNORM:
+    case Format::ETC2_RGB_SRGB:
+        return 8;
+    case Format::BC3_UNORM:
+    case Format::BC3_SRGB:
+    case Format::BC5_UNORM:
+    case Format::BC7_UNORM:
+    case Format::BC7_SRGB:
+    case Format::ETC2_RGBA_UNORM:
+    case Format::ETC2_RGBA_SRGB:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+size_t lov::Graphics::Ktx2Image::getLevelSize(lov_uint format, lov_int width, lov_int height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+}
@@ -0,0 +1,28 @@
+#include "Graphics/Mesh.h"
+
+lov::Graphics::MeshData lov::Graphics::MeshData::fromInterleaved(const float* data, lov_size vertexCount) {
+    MeshData mesh;
+    mesh.vertices.resize(vertexCount);
+    mesh.indices.resize(vertexCount);
+
+    // Unpack each vertex and give it its own index
+    for (lov_size i = 0; i < vertexCount; i++) {
+        const float* v = data + i * 8;
+        mesh.vertices[i].position = { v[0], v[1], v[2] };
+        mesh.vertices[i].normal = { v[3], v[4], v[5] };
+        mesh.vertices[i].texCoords = { v[6], v[7] };
+        mesh.indices[i] = i;
+    }
+
+    return mesh;
+}
+
+lov::Graphics::BoundingBox lov::Graphics::MeshData::calculateBounds() const {
+    BoundingBox bounds;
+
+    for (const Vertex& vertex : vertices) {
+        bounds.expand(vertex.position);
+    }
+
+    return bounds;
+}
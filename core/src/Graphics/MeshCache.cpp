@@ -0,0 +1,153 @@
+#include "Graphics/MeshCache.h"
+
+#include "System/Exceptions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    /// @brief The 8 bytes every cache starts with
+    const unsigned char IDENTIFIER[8] = { 'L', 'O', 'V', 'M', 'E', 'S', 'H', 0x1A };
+
+    /// @brief Version of the layout, stored in host byte order so caches from other byte orders are rejected
+    const std::uint32_t VERSION = 1;
+
+    /// @brief The header fields after the identifier, in host byte order
+    struct Header {
+        std::uint32_t version;      ///< #VERSION
+        std::uint32_t vertexSize;   ///< sizeof(Vertex) when written
+        std::uint64_t vertexCount;  ///< Number of vertices
+        std::uint64_t indexCount;   ///< Number of indices
+    };
+
+    static_assert(sizeof(IDENTIFIER) + sizeof(Header) == lov::Graphics::MeshCache::HEADER_SIZE, "Mesh cache header size mismatch");
+}
+
+std::vector<std::byte> lov::Graphics::MeshCache::serialize(const MeshData& mesh) {
+    size_t vertexBytes = mesh.vertices.size() * sizeof(Vertex);
+    size_t indexBytes = mesh.indices.size() * sizeof(lov_uint);
+    std::vector<std::byte> cache(HEADER_SIZE + vertexBytes + indexBytes);
+
+    Header header = { VERSION, sizeof(Vertex), mesh.vertices.size(), mesh.indices.size() };
+    memcpy(cache.data(), IDENTIFIER, sizeof(IDENTIFIER));
+    memcpy(cache.data() + sizeof(IDENTIFIER), &header, sizeof(header));
+
+    // The arrays are copied as they are, so reading them back is a copy too
+    if (vertexBytes > 0) {
+        memcpy(cache.data() + HEADER_SIZE, mesh.vertices.data(), vertexBytes);
+    }
+
+    if (indexBytes > 0) {
+        memcpy(cache.data() + HEADER_SIZE + vertexBytes, mesh.indices.data(), indexBytes);
+    }
+
+    return cache;
+}
+
+lov::Graphics::MeshView lov::Graphics::MeshCache::view(std::span<const std::byte> cache) {
+    size_t vertexCount;
+    size_t indexCount;
+    readHeader(cache.data(), cache.size(), vertexCount, indexCount);
+
+    // Vertices and indices are read in place, so they must be aligned for their floats and integers
+    if (reinterpret_cast<std::uintptr_t>(cache.data()) % alignof(Vertex) != 0) {
+        throw Exceptions::MeshException("Mesh cache is not aligned to " + std::to_string(alignof(Vertex)) + " bytes");
+    }
+
+    const Vertex* vertices = reinterpret_cast<const Vertex*>(cache.data() + HEADER_SIZE);
+    const lov_uint* indices = reinterpret_cast<const lov_uint*>(cache.data() + HEADER_SIZE + vertexCount * sizeof(Vertex));
+    return { { vertices, vertexCount }, { indices, indexCount } };
+}
+
+lov::Graphics::MeshData lov::Graphics::MeshCache::read(std::span<const std::byte> cache) {
+    size_t vertexCount;
+    size_t indexCount;
+    readHeader(cache.data(), cache.size(), vertexCount, indexCount);
+
+    MeshData mesh;
+    mesh.vertices.resize(vertexCount);
+    mesh.indices.resize(indexCount);
+
+    // Copy bytewise, since the cache may not be aligned
+    if (vertexCount > 0) {
+        memcpy(mesh.vertices.data(), cache.data() + HEADER_SIZE, vertexCount * sizeof(Vertex));
+    }
+
+    if (indexCount > 0) {
+        memcpy(mesh.indices.data(), cache.data() + HEADER_SIZE + vertexCount * sizeof(Vertex), indexCount * sizeof(lov_uint));
+    }
+
+    return mesh;
+}
+
+lov::Graphics::MeshData lov::Graphics::MeshCache::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw Exceptions::IOException("Failed to open mesh cache '" + path + "'");
+    }
+
+    size_t size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    std::byte header[HEADER_SIZE] = {};
+    if (size < HEADER_SIZE || !file.read(reinterpret_cast<char*>(header), HEADER_SIZE)) {
+        throw Exceptions::MeshException("Mesh cache '" + path + "' is truncated");
+    }
+
+    size_t vertexCount;
+    size_t indexCount;
+    readHeader(header, size, vertexCount, indexCount);
+
+    // Read the arrays straight into the mesh, so a cached load costs no more than reading the file
+    MeshData mesh;
+    mesh.vertices.resize(vertexCount);
+    mesh.indices.resize(indexCount);
+
+    file.read(reinterpret_cast<char*>(mesh.vertices.data()), vertexCount * sizeof(Vertex));
+    file.read(reinterpret_cast<char*>(mesh.indices.data()), indexCount * sizeof(lov_uint));
+    if (!file) {
+        throw Exceptions::IOException("Failed to read mesh cache '" + path + "'");
+    }
+
+    return mesh;
+}
+
+void lov::Graphics::MeshCache::write(const MeshData& mesh, const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw Exceptions::IOException("Failed to open '" + path + "' to write a mesh cache");
+    }
+
+    Header header = { VERSION, sizeof(Vertex), mesh.vertices.size(), mesh.indices.size() };
+    file.write(reinterpret_cast<const char*>(IDENTIFIER), sizeof(IDENTIFIER));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(mesh.vertices.data()), mesh.vertices.size() * sizeof(Vertex));
+    file.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(lov_uint));
+    if (!file.flush()) {
+        throw Exceptions::IOException("Failed to write mesh cache '" + path + "'");
+    }
+}
+
+void lov::Graphics::MeshCache::readHeader(const std::byte* header, size_t size, size_t& vertexCount, size_t& indexCount) {
+    if (size < HEADER_SIZE || memcmp(header, IDENTIFIER, sizeof(IDENTIFIER)) != 0) {
+        throw Exceptions::MeshException("Not a mesh cache");
+    }
+
+    Header fields;
+    memcpy(&fields, header + sizeof(IDENTIFIER), sizeof(fields));
+    if (fields.version != VERSION || fields.vertexSize != sizeof(Vertex)) {
+        throw Exceptions::MeshException("Mesh cache was written with a different version, byte order or vertex layout");
+    }
+
+    // Check the counts against the size without letting either multiplication overflow
+    size_t available = size - HEADER_SIZE;
+    if (fields.vertexCount > available / sizeof(Vertex) ||
+        fields.indexCount != (available - fields.vertexCount * sizeof(Vertex)) / sizeof(lov_uint) ||
+        (available - fields.vertexCount * sizeof(Vertex)) % sizeof(lov_uint) != 0) {
+        throw Exceptions::MeshException("Mesh cache size does not match its header");
+    }
+
+    vertexCount = static_cast<size_t>(fields.vertexCount);
+    indexCount = static_cast<size_t>(fields.indexCount);
+}
@@ -0,0 +1,1227 @@
+#include "Graphics/MeshLoader.h"
+
+#include "Graphics/MeshCache.h"
+#include "System/Exceptions.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /// @brief The least OBJ text worth parsing on its own thread
+    const size_t OBJ_CHUNK_SIZE = 1 << 16;
+
+    /// @brief The least number of face corners worth welding on more than one thread
+    const size_t OBJ_WELD_SHARD_SIZE = 1 << 16;
+
+    /// @brief Marks a face corner without a texture coordinate or normal
+    const lov::lov_int NO_INDEX = INT_MIN;
+
+    /// @brief Read a whole file
+    /// @param path The file path
+    /// @return The contents
+    /// @throws #lov::Exceptions::IOException if the file can't be read
+    std::vector<std::byte> readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw lov::Exceptions::IOException("Failed to open '" + path + "'");
+        }
+
+        std::vector<std::byte> data(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(data.data()), data.size())) {
+            throw lov::Exceptions::IOException("Failed to read '" + path + "'");
+        }
+
+        return data;
+    }
+
+    /// @brief A vertex of an OBJ face, as indices into the position, texture coordinate and normal lists
+    struct ObjCorner {
+        lov::lov_int position;  ///< Index of the position
+        lov::lov_int texCoord;  ///< Index of the texture coordinate, or #NO_INDEX
+        lov::lov_int normal;    ///< Index of the normal, or #NO_INDEX
+
+        bool operator==(const ObjCorner& other) const {
+            return position == other.position && texCoord == other.texCoord && normal == other.normal;
+        }
+    };
+
+    /// @brief A negative OBJ index, which counts back from the end of its list and so depends on earlier chunks
+    struct ObjFixup {
+        size_t corner;      ///< The corner within the chunk, or within its polygon until it's triangulated
+        size_t component;   ///< 0 for the position, 1 for the texture coordinate and 2 for the normal
+        lov::lov_int local; ///< The index relative to the start of the chunk's own list, negative if it's in an earlier chunk
+    };
+
+    /// @brief Get an index of a corner
+    /// @param corner The corner
+    /// @param component 0 for the position, 1 for the texture coordinate and 2 for the normal
+    /// @return The index
+    lov::lov_int& indexOf(ObjCorner& corner, size_t component) {
+        return component == 0 ? corner.position : component == 1 ? corner.texCoord : corner.normal;
+    }
+
+    /// @brief The statements parsed from one chunk of OBJ text
+    struct ObjChunk {
+        std::vector<lov::Vector3f> positions;   ///< Positions in the order they were declared
+        std::vector<lov::Vector2f> texCoords;   ///< Texture coordinates in the order they were declared
+        std::vector<lov::Vector3f> normals;     ///< Normals in the order they were declared
+        std::vector<ObjCorner> corners;         ///< Three corners per triangle, with absolute indices from the start of the file
+        std::vector<ObjFixup> fixups;           ///< Corners with negative indices, which are patched once chunks are merged
+        std::string error;                      ///< The first problem in the chunk, or empty
+        size_t errorOffset = 0;                 ///< Offset of the line with the problem from the start of the text
+    };
+
+    /// @brief Skip spaces, tabs and carriage returns
+    /// @param p The position to advance
+    /// @param end The end of the line
+    void skipSpaces(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+    }
+
+    /// @brief Parse a float after any spaces
+    /// @param p The position to advance past the float
+    /// @param end The end of the line
+    /// @param value Set to the float
+    /// @return Whether there was a float
+    bool parseFloat(const char*& p, const char* end, float& value) {
+        skipSpaces(p, end);
+        if (p < end && *p == '+') {
+            p++;
+        }
+
+        // from_chars is locale independent and exact, and is far faster than strtof
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+
+        p = result.ptr;
+        return true;
+    }
+
+    /// @brief Parse an integer
+    /// @param p The position to advance past the integer
+    /// @param end The end of the line
+    /// @param value Set to the integer
+    /// @return Whether there was an integer
+    bool parseInt(const char*& p, const char* end, lov::lov_int& value) {
+        // Faces are mostly indices, so a plain digit loop without from_chars' generality pays off
+        bool negative = p < end && *p == '-';
+        if (negative) {
+            p++;
+        }
+
+        const char* digits = p;
+        std::int64_t magnitude = 0;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10 && magnitude <= INT_MAX) {
+            magnitude = magnitude * 10 + (*p - '0');
+            p++;
+        }
+
+        if (p == digits || magnitude > INT_MAX) {
+            return false;
+        }
+
+        value = static_cast<lov::lov_int>(negative ? -magnitude : magnitude);
+        return true;
+    }
+
+    /// @brief Parse the statements of one chunk of OBJ text
+    /// @param text The whole text
+    /// @param begin Offset of the first line of the chunk
+    /// @param end Offset of the end of the chunk, just after a line break or at the end of the text
+    /// @param chunk Filled with the statements
+    void parseObjChunk(std::string_view text, size_t begin, size_t end, ObjChunk& chunk) {
+        std::vector<ObjCorner> polygon;
+        std::vector<ObjFixup> polygonFixups;
+        const char* p = text.data() + begin;
+        const char* chunkEnd = text.data() + end;
+
+        while (p < chunkEnd) {
+            // memchr finds line breaks many bytes at a time
+            const char* lineEnd = static_cast<const char*>(memchr(p, '\n', chunkEnd - p));
+            if (!lineEnd) {
+                lineEnd = chunkEnd;
+            }
+
+            const char* line = p;
+            p = lineEnd + 1;
+
+            skipSpaces(line, lineEnd);
+            if (lineEnd - line < 2 || line[0] == '#') {
+                continue;
+            }
+
+            bool valid = true;
+            if (line[0] == 'v' && (line[1] == ' ' || line[1] == '\t')) {
+                lov::Vector3f position;
+                line++;
+                valid = parseFloat(line, lineEnd, position.x) && parseFloat(line, lineEnd, position.y) && parseFloat(line, lineEnd, position.z);
+                chunk.positions.push_back(position);
+            }
+            else if (line[0] == 'v' && line[1] == 't') {
+                // The second coordinate is optional and defaults to 0
+                lov::Vector2f texCoords = { 0.0f, 0.0f };
+                line += 2;
+                valid = parseFloat(line, lineEnd, texCoords.x);
+                parseFloat(line, lineEnd, texCoords.y);
+                chunk.texCoords.push_back(texCoords);
+            }
+            else if (line[0] == 'v' && line[1] == 'n') {
+                lov::Vector3f normal;
+                line += 2;
+                valid = parseFloat(line, lineEnd, normal.x) && parseFloat(line, lineEnd, normal.y) && parseFloat(line, lineEnd, normal.z);
+                chunk.normals.push_back(normal);
+            }
+            else if (line[0] == 'f' && (line[1] == ' ' || line[1] == '\t')) {
+                polygon.clear();
+                polygonFixups.clear();
+                line++;
+                skipSpaces(line, lineEnd);
+
+                // Each corner is v, v/vt, v//vn or v/vt/vn
+                while (valid && line < lineEnd) {
+                    lov::lov_int indices[3] = { 0, NO_INDEX, NO_INDEX };
+                    valid = parseInt(line, lineEnd, indices[0]);
+                    if (valid && line < lineEnd && *line == '/') {
+                        line++;
+                        if (line < lineEnd && *line != '/') {
+                            valid = parseInt(line, lineEnd, indices[1]);
+                        }
+
+                        if (valid && line < lineEnd && *line == '/') {
+                            line++;
+                            valid = parseInt(line, lineEnd, indices[2]);
+                        }
+                    }
+
+                    // Positive indices count from 1 at the start of the file, negative ones back from the latest
+                    lov::lov_int counts[3] = {
+                        static_cast<lov::lov_int>(chunk.positions.size()),
+                        static_cast<lov::lov_int>(chunk.texCoords.size()),
+                        static_cast<lov::lov_int>(chunk.normals.size())
+                    };
+
+                    for (size_t i = 0; valid && i < 3; i++) {
+                        if (indices[i] == 0) {
+                            valid = false;
+                        }
+                        else if (indices[i] > 0) {
+                            indices[i]--;
+                        }
+                        else if (indices[i] != NO_INDEX) {
+                            polygonFixups.push_back({ polygon.size(), i, counts[i] + indices[i] });
+                        }
+                    }
+
+                    polygon.push_back({ indices[0], indices[1], indices[2] });
+                    skipSpaces(line, lineEnd);
+                }
+
+                if (valid && polygon.size() < 3) {
+                    valid = false;
+                }
+
+                // Triangulate as a fan around the first corner, moving fixups to wherever their corners land
+                if (valid) {
+                    for (size_t i = 1; i + 1 < polygon.size(); i++) {
+                        size_t triangle[3] = { 0, i, i + 1 };
+                        for (size_t corner : triangle) {
+                            for (const ObjFixup& fixup : polygonFixups) {
+                                if (fixup.corner == corner) {
+                                    chunk.fixups.push_back({ chunk.corners.size(), fixup.component, fixup.local });
+                                }
+                            }
+
+                            chunk.corners.push_back(polygon[corner]);
+                        }
+                    }
+                }
+            }
+
+            // Other statements such as groups, smoothing and materials don't affect the geometry
+            if (!valid && chunk.error.empty()) {
+                chunk.errorOffset = static_cast<size_t>(lineEnd - text.data());
+                while (chunk.errorOffset > begin && text[chunk.errorOffset - 1] != '\n') {
+                    chunk.errorOffset--;
+                }
+
+                chunk.error = "Malformed statement '" + std::string(text.substr(chunk.errorOffset, lineEnd - text.data() - chunk.errorOffset)) + "'";
+                return;
+            }
+        }
+    }
+
+    /// @brief Welds identical face corners into one vertex, with an open addressing table that grows at half full
+    class CornerTable {
+    public:
+        /// @brief Construct a table
+        /// @param expected The number of distinct corners expected, to size the table up front
+        explicit CornerTable(size_t expected) {
+            size_t capacity = 64;
+            while (capacity < expected * 2) {
+                capacity *= 2;
+            }
+
+            m_slots.resize(capacity, { { 0, 0, 0 }, UINT_MAX });
+        }
+
+        /// @brief Find the vertex of a corner, adding one if it's new
+        /// @param corner The corner
+        /// @return The index of its vertex among #keys
+        lov::lov_uint insert(const ObjCorner& corner) {
+            size_t mask = m_slots.size() - 1;
+            size_t slot = hash(corner) & mask;
+            while (m_slots[slot].vertex != UINT_MAX) {
+                if (m_slots[slot].corner == corner) {
+                    return m_slots[slot].vertex;
+                }
+
+                slot = (slot + 1) & mask;
+            }
+
+            lov::lov_uint vertex = static_cast<lov::lov_uint>(keys.size());
+            m_slots[slot] = { corner, vertex };
+            keys.push_back(corner);
+            if (keys.size() * 2 > m_slots.size()) {
+                grow();
+            }
+
+            return vertex;
+        }
+
+        std::vector<ObjCorner> keys;    ///< The corner of each vertex, in the order they were added
+
+    private:
+        /// @brief A corner and its vertex, stored together so probing touches one cache line
+        struct Slot {
+            ObjCorner corner;       ///< The corner
+            lov::lov_uint vertex;   ///< Its vertex, or UINT_MAX if the slot is empty
+        };
+
+        /// @brief Mix the indices of a corner
+        /// @param corner The corner
+        /// @return The hash
+        static size_t hash(const ObjCorner& corner) {
+            std::uint64_t hash = static_cast<std::uint32_t>(corner.position) * 0x9E3779B97F4A7C15ull;
+            hash ^= static_cast<std::uint32_t>(corner.texCoord) * 0xC2B2AE3D27D4EB4Full + (hash >> 29);
+            hash ^= static_cast<std::uint32_t>(corner.normal) * 0x165667B19E3779F9ull + (hash >> 32);
+            return static_cast<size_t>(hash ^ (hash >> 31));
+        }
+
+        /// @brief Double the table and reinsert every corner
+        void grow() {
+            m_slots.assign(m_slots.size() * 2, { { 0, 0, 0 }, UINT_MAX });
+            size_t mask = m_slots.size() - 1;
+            for (size_t vertex = 0; vertex < keys.size(); vertex++) {
+                size_t slot = hash(keys[vertex]) & mask;
+                while (m_slots[slot].vertex != UINT_MAX) {
+                    slot = (slot + 1) & mask;
+                }
+
+                m_slots[slot] = { keys[vertex], static_cast<lov::lov_uint>(vertex) };
+            }
+        }
+
+        std::vector<Slot> m_slots;  ///< The table, a power of two in size
+    };
+
+    /// @brief A column major 4x4 matrix used for glTF node transforms
+    using Matrix = std::array<float, 16>;
+
+    /// @brief The identity matrix
+    const Matrix IDENTITY = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+    /// @brief Multiply two matrices
+    /// @param left The left matrix
+    /// @param right The right matrix
+    /// @return left * right
+    Matrix multiply(const Matrix& left, const Matrix& right) {
+        Matrix result = {};
+        for (size_t column = 0; column < 4; column++) {
+            for (size_t row = 0; row < 4; row++) {
+                for (size_t k = 0; k < 4; k++) {
+                    result[column * 4 + row] += left[k * 4 + row] * right[column * 4 + k];
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /// @brief A parsed JSON value, as much of JSON as a glTF document needs
+    struct JsonValue {
+        /// @brief The kind of value
+        enum class Type { Null, Boolean, Number, String, Array, Object };
+
+        Type type = Type::Null;                 ///< The kind of value
+        bool boolean = false;                   ///< The value of a boolean
+        double number = 0.0;                    ///< The value of a number
+        std::string string;                     ///< The value of a string
+        std::vector<JsonValue> elements;        ///< The elements of an array, or the member values of an object
+        std::vector<std::string> names;         ///< The member names of an object
+
+        /// @brief Find a member of an object
+        /// @param name The member name
+        /// @return The member, or null if there isn't one or this isn't an object
+        const JsonValue* find(std::string_view name) const {
+            for (size_t i = 0; i < names.size(); i++) {
+                if (names[i] == name) {
+                    return &elements[i];
+                }
+            }
+
+            return nullptr;
+        }
+    };
+
+    /// @brief Parses JSON text into a #JsonValue
+    class JsonParser {
+    public:
+        /// @brief Prepare to parse
+        /// @param text The JSON text
+        explicit JsonParser(std::string_view text): m_text(text), m_position(0) {}
+
+        /// @brief Parse the whole text as one value
+        /// @return The value
+        /// @throws #lov::Exceptions::MeshException if the text isn't valid JSON
+        JsonValue parse() {
+            JsonValue value = parseValue(0);
+            skipSpace();
+            if (m_position != m_text.size()) {
+                fail("trailing characters");
+            }
+
+            return value;
+        }
+
+    private:
+        /// @brief Deepest nesting of arrays and objects allowed, so malicious files can't overflow the stack
+        static constexpr int MAX_DEPTH = 64;
+
+        JsonValue parseValue(int depth) {
+            if (depth > MAX_DEPTH) {
+                fail("nesting too deep");
+            }
+
+            skipSpace();
+            JsonValue value;
+            char c = peek();
+            if (c == '{') {
+                value.type = JsonValue::Type::Object;
+                m_position++;
+                skipSpace();
+                if (peek() == '}') {
+                    m_position++;
+                    return value;
+                }
+
+                do {
+                    skipSpace();
+                    value.names.push_back(parseString());
+                    skipSpace();
+                    expect(':');
+                    value.elements.push_back(parseValue(depth + 1));
+                    skipSpace();
+                } while (consume(','));
+
+                expect('}');
+            }
+            else if (c == '[') {
+                value.type = JsonValue::Type::Array;
+                m_position++;
+                skipSpace();
+                if (peek() == ']') {
+                    m_position++;
+                    return value;
+                }
+
+                do {
+                    value.elements.push_back(parseValue(depth + 1));
+                    skipSpace();
+                } while (consume(','));
+
+                expect(']');
+            }
+            else if (c == '"') {
+                value.type = JsonValue::Type::String;
+                value.string = parseString();
+            }
+            else if (m_text.substr(m_position, 4) == "true" || m_text.substr(m_position, 5) == "false") {
+                value.type = JsonValue::Type::Boolean;
+                value.boolean = c == 't';
+                m_position += value.boolean ? 4 : 5;
+            }
+            else if (m_text.substr(m_position, 4) == "null") {
+                m_position += 4;
+            }
+            else {
+                value.type = JsonValue::Type::Number;
+                std::from_chars_result result = std::from_chars(m_text.data() + m_position, m_text.data() + m_text.size(), value.number);
+                if (result.ec != std::errc()) {
+                    fail("expected a value");
+                }
+
+                m_position = result.ptr - m_text.data();
+            }
+
+            return value;
+        }
+
+        std::string parseString() {
+            expect('"');
+            std::string string;
+            while (true) {
+                char c = next();
+                if (c == '"') {
+                    return string;
+                }
+
+                if (c != '\\') {
+                    string.push_back(c);
+                    continue;
+                }
+
+                c = next();
+                switch (c) {
+                case 'b': string.push_back('\b'); break;
+                case 'f': string.push_back('\f'); break;
+                case 'n': string.push_back('\n'); break;
+                case 'r': string.push_back('\r'); break;
+                case 't': string.push_back('\t'); break;
+                case 'u': {
+                    // Names glTF looks up are ASCII, so code points are only kept well formed, not combined from surrogates
+                    unsigned codePoint = 0;
+                    for (int i = 0; i < 4; i++) {
+                        char digit = next();
+                        codePoint <<= 4;
+                        if (digit >= '0' && digit <= '9') codePoint |= digit - '0';
+                        else if (digit >= 'a' && digit <= 'f') codePoint |= digit - 'a' + 10;
+                        else if (digit >= 'A' && digit <= 'F') codePoint |= digit - 'A' + 10;
+                        else fail("bad escape");
+                    }
+
+                    if (codePoint < 0x80) {
+                        string.push_back(static_cast<char>(codePoint));
+                    }
+                    else if (codePoint < 0x800) {
+                        string.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                        string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    }
+                    else {
+                        string.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                        string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                        string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    }
+                    break;
+                }
+                default: string.push_back(c); break;
+                }
+            }
+        }
+
+        void skipSpace() {
+            while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t' || m_text[m_position] == '\n' || m_text[m_position] == '\r')) {
+                m_position++;
+            }
+        }
+
+        char peek() const {
+            return m_position < m_text.size() ? m_text[m_position] : '\0';
+        }
+
+        char next() {
+            if (m_position >= m_text.size()) {
+                fail("unexpected end");
+            }
+
+            return m_text[m_position++];
+        }
+
+        bool consume(char c) {
+            if (peek() == c) {
+                m_position++;
+                return true;
+            }
+
+            return false;
+        }
+
+        void expect(char c) {
+            if (!consume(c)) {
+                fail((std::string("expected '") + c + "'").c_str());
+            }
+        }
+
+        [[noreturn]] void fail(const char* problem) const {
+            throw lov::Exceptions::MeshException("Invalid glTF JSON at offset " + std::to_string(m_position) + ": " + problem);
+        }
+
+        std::string_view m_text;    ///< The JSON text
+        size_t m_position;          ///< Offset of the next character
+    };
+
+    /// @brief Convert a glTF value to a non-negative integer
+    /// @param value The value
+    /// @param name What the value is, for the exception
+    /// @return The integer
+    /// @throws #lov::Exceptions::MeshException if the value isn't a non-negative 32 bit integer
+    size_t toInteger(const JsonValue& value, std::string_view name) {
+        if (value.type != JsonValue::Type::Number || !(value.number >= 0.0 && value.number <= 4294967295.0) || value.number != std::floor(value.number)) {
+            throw lov::Exceptions::MeshException("glTF member '" + std::string(name) + "' is not a valid index or size");
+        }
+
+        return static_cast<size_t>(value.number);
+    }
+
+    /// @brief Get a non-negative integer member of a glTF object
+    /// @param object The object
+    /// @param name The member name
+    /// @param fallback The value if the member is missing
+    /// @return The value
+    /// @throws #lov::Exceptions::MeshException if the member isn't a non-negative integer
+    size_t integer(const JsonValue& object, std::string_view name, size_t fallback) {
+        const JsonValue* member = object.find(name);
+        return member ? toInteger(*member, name) : fallback;
+    }
+
+    /// @brief Get an element of a top level glTF array
+    /// @param document The glTF document
+    /// @param array The name of the array, such as "accessors"
+    /// @param index The element index
+    /// @return The element
+    /// @throws #lov::Exceptions::MeshException if it doesn't exist
+    const JsonValue& element(const JsonValue& document, std::string_view array, size_t index) {
+        const JsonValue* elements = document.find(array);
+        if (!elements || elements->type != JsonValue::Type::Array || index >= elements->elements.size() ||
+            elements->elements[index].type != JsonValue::Type::Object) {
+            throw lov::Exceptions::MeshException("glTF refers to missing " + std::string(array) + " " + std::to_string(index));
+        }
+
+        return elements->elements[index];
+    }
+
+    /// @brief Read a float array member of a glTF object
+    /// @param object The object
+    /// @param name The member name
+    /// @param values Filled with the values if the member exists
+    /// @return Whether the member exists
+    /// @throws #lov::Exceptions::MeshException if the member isn't an array of that many numbers
+    template <size_t N>
+    bool floats(const JsonValue& object, std::string_view name, std::array<float, N>& values) {
+        const JsonValue* member = object.find(name);
+        if (!member) {
+            return false;
+        }
+
+        if (member->type != JsonValue::Type::Array || member->elements.size() != N) {
+            throw lov::Exceptions::MeshException("glTF member '" + std::string(name) + "' must hold " + std::to_string(N) + " numbers");
+        }
+
+        for (size_t i = 0; i < N; i++) {
+            if (member->elements[i].type != JsonValue::Type::Number) {
+                throw lov::Exceptions::MeshException("glTF member '" + std::string(name) + "' must hold " + std::to_string(N) + " numbers");
+            }
+
+            values[i] = static_cast<float>(member->elements[i].number);
+        }
+
+        return true;
+    }
+
+    /// @brief glTF component types
+    enum ComponentType : size_t {
+        BYTE = 5120,
+        UNSIGNED_BYTE = 5121,
+        SHORT = 5122,
+        UNSIGNED_SHORT = 5123,
+        UNSIGNED_INT = 5125,
+        FLOAT = 5126
+    };
+
+    /// @brief A bounds checked view of a glTF accessor in the binary chunk
+    struct Accessor {
+        const std::byte* data = nullptr;    ///< The first element
+        size_t count = 0;                   ///< The number of elements
+        size_t stride = 0;                  ///< Bytes from one element to the next
+        size_t componentType = FLOAT;       ///< The #ComponentType of each component
+        bool normalized = false;            ///< Whether integer components map to [0, 1] or [-1, 1]
+
+        /// @brief Read a component as a float. glTF is little endian, like every platform the engine runs on
+        /// @param index The element
+        /// @param component The component within the element
+        /// @return The value
+        float get(size_t index, size_t component) const {
+            const std::byte* p = data + index * stride;
+            switch (componentType) {
+            case FLOAT: { float v; memcpy(&v, p + component * 4, 4); return v; }
+            case UNSIGNED_BYTE: return static_cast<float>(std::to_integer<std::uint8_t>(p[component])) / (normalized ? 255.0f : 1.0f);
+            case UNSIGNED_SHORT: { std::uint16_t v; memcpy(&v, p + component * 2, 2); return v / (normalized ? 65535.0f : 1.0f); }
+            default: return 0.0f;
+            }
+        }
+
+        /// @brief Read an element of an index accessor
+        /// @param index The element
+        /// @return The vertex index
+        std::uint32_t getIndex(size_t index) const {
+            const std::byte* p = data + index * stride;
+            switch (componentType) {
+            case UNSIGNED_BYTE: return std::to_integer<std::uint8_t>(p[0]);
+            case UNSIGNED_SHORT: { std::uint16_t v; memcpy(&v, p, 2); return v; }
+            default: { std::uint32_t v; memcpy(&v, p, 4); return v; }
+            }
+        }
+    };
+
+    /// @brief Resolve a glTF accessor into a view of the binary chunk, checking it lies within it
+    /// @param document The glTF document
+    /// @param binary The binary chunk
+    /// @param index The accessor index
+    /// @param type The required accessor type, such as "VEC3"
+    /// @param componentTypes The allowed component types
+    /// @return The view
+    /// @throws #lov::Exceptions::MeshException if the accessor is invalid or unsupported
+    Accessor resolveAccessor(const JsonValue& document, std::span<const std::byte> binary, size_t index, std::string_view type, std::initializer_list<size_t> componentTypes) {
+        const JsonValue& accessor = element(document, "accessors", index);
+        std::string name = "glTF accessor " + std::to_string(index);
+
+        const JsonValue* accessorType = accessor.find("type");
+        if (!accessorType || accessorType->string != type) {
+            throw lov::Exceptions::MeshException(name + " must be " + std::string(type));
+        }
+
+        Accessor view;
+        view.componentType = integer(accessor, "componentType", 0);
+        view.count = integer(accessor, "count", 0);
+        const JsonValue* normalized = accessor.find("normalized");
+        view.normalized = normalized && normalized->boolean;
+        if (std::find(componentTypes.begin(), componentTypes.end(), view.componentType) == componentTypes.end()) {
+            throw lov::Exceptions::MeshException(name + " has an unsupported component type");
+        }
+
+        if (accessor.find("sparse") || !accessor.find("bufferView")) {
+            throw lov::Exceptions::MeshException(name + " is sparse or has no buffer view, which aren't supported");
+        }
+
+        const JsonValue& bufferView = element(document, "bufferViews", integer(accessor, "bufferView", 0));
+        if (integer(bufferView, "buffer", 0) != 0) {
+            throw lov::Exceptions::MeshException(name + " isn't in the embedded buffer");
+        }
+
+        size_t componentSize = view.componentType == UNSIGNED_BYTE || view.componentType == BYTE ? 1 : view.componentType == FLOAT || view.componentType == UNSIGNED_INT ? 4 : 2;
+        size_t components = type == "SCALAR" ? 1 : type == "VEC2" ? 2 : type == "VEC3" ? 3 : 4;
+        size_t elementSize = componentSize * components;
+        size_t viewOffset = integer(bufferView, "byteOffset", 0);
+        size_t viewLength = integer(bufferView, "byteLength", 0);
+        size_t accessorOffset = integer(accessor, "byteOffset", 0);
+        view.stride = integer(bufferView, "byteStride", elementSize);
+
+        // Every element must lie within the view and the view within the chunk, checked without overflowing
+        bool outside = viewOffset > binary.size() || viewLength > binary.size() - viewOffset || view.stride < elementSize;
+        if (!outside && view.count > 0) {
+            outside = accessorOffset > viewLength || elementSize > viewLength - accessorOffset ||
+                view.count - 1 > (viewLength - accessorOffset - elementSize) / view.stride;
+        }
+
+        if (outside) {
+            throw lov::Exceptions::MeshException(name + " lies outside its buffer");
+        }
+
+        view.data = binary.data() + viewOffset + accessorOffset;
+        return view;
+    }
+
+    /// @brief A glTF triangle primitive placed in the scene, with where its output goes in the merged mesh
+    struct GlbPrimitive {
+        Accessor positions;         ///< VEC3 float positions
+        Accessor normals;           ///< VEC3 float normals, with count 0 if there are none
+        Accessor texCoords;         ///< VEC2 texture coordinates, with count 0 if there are none
+        Accessor indices;           ///< Scalar indices, with count 0 if the primitive isn't indexed
+        Matrix transform;           ///< World transform of the node
+        size_t vertexBase;          ///< First vertex in the merged mesh
+        size_t indexBase;           ///< First index in the merged mesh
+        size_t indexCount;          ///< Number of indices
+    };
+
+    /// @brief Calculate area weighted vertex normals from triangles
+    /// @param mesh The mesh, whose vertices in [vertexBegin, vertexEnd) get normals
+    /// @param vertexBegin The first vertex to calculate
+    /// @param vertexEnd One past the last vertex to calculate
+    /// @param indexBegin The first index of the triangles using them
+    /// @param indexEnd One past the last index of those triangles
+    /// @param shared Optional map from each vertex to the one whose normal it shares, such as one with the same position
+    void calculateNormals(lov::Graphics::MeshData& mesh, size_t vertexBegin, size_t vertexEnd, size_t indexBegin, size_t indexEnd, const std::vector<lov::lov_uint>* shared = nullptr) {
+        std::vector<lov::Vector3f> sums(vertexEnd - vertexBegin, lov::Vector3f(0.0f, 0.0f, 0.0f));
+        auto slot = [&](lov::lov_uint vertex) -> lov::Vector3f& {
+            return sums[(shared ? (*shared)[vertex] : vertex) - vertexBegin];
+        };
+
+        for (size_t i = indexBegin; i + 2 < indexEnd; i += 3) {
+            lov::Vector3f a = mesh.vertices[mesh.indices[i]].position;
+            lov::Vector3f b = mesh.vertices[mesh.indices[i + 1]].position;
+            lov::Vector3f c = mesh.vertices[mesh.indices[i + 2]].position;
+
+            // The cross product's length is twice the area, so larger faces count for more
+            lov::Vector3f face = lov::Vector::cross(b - a, c - a);
+            slot(mesh.indices[i]) += face;
+            slot(mesh.indices[i + 1]) += face;
+            slot(mesh.indices[i + 2]) += face;
+        }
+
+        for (size_t v = vertexBegin; v < vertexEnd; v++) {
+            lov::Vector3f sum = slot(static_cast<lov::lov_uint>(v));
+            float length = lov::Vector::length(sum);
+            mesh.vertices[v].normal = length > 0.0f ? sum / length : lov::Vector3f(0.0f, 1.0f, 0.0f);
+        }
+    }
+}
+
+lov::Graphics::MeshLoader::MeshLoader(System::ThreadPool& pool):
+    m_pool(pool)
+{}
+
+lov::Graphics::MeshData lov::Graphics::MeshLoader::load(const std::string& path) const {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (extension == ".obj") {
+        return loadObj(readFile(path));
+    }
+
+    if (extension == ".glb") {
+        return loadGlb(readFile(path));
+    }
+
+    throw Exceptions::MeshException("Unsupported model format '" + extension + "' of '" + path + "'");
+}
+
+lov::Graphics::MeshData lov::Graphics::MeshLoader::loadCached(const std::string& path, const std::string& cachePath) const {
+    // Use the cache unless the model was changed after it was written
+    std::error_code error;
+    std::filesystem::file_time_type cacheTime = std::filesystem::last_write_time(cachePath, error);
+    if (!error && cacheTime >= std::filesystem::last_write_time(path, error) && !error) {
+        try {
+            return MeshCache::load(cachePath);
+        }
+        catch (const Exceptions::Exception&) {
+            // A stale or corrupt cache is rebuilt below
+        }
+    }
+
+    MeshData mesh = load(path);
+    MeshCache::write(mesh, cachePath);
+    return mesh;
+}
+
+lov::Graphics::MeshData lov::Graphics::MeshLoader::loadObj(std::span<const std::byte> data) const {
+    std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+
+    // Split the text into chunks that each end with a line break, at least one per thread
+    size_t chunkCount = std::clamp(text.size() / OBJ_CHUNK_SIZE, static_cast<size_t>(1), static_cast<size_t>(m_pool.getThreadCount() + 1) * 4);
+    std::vector<size_t> bounds = { 0 };
+    for (size_t i = 1; i < chunkCount; i++) {
+        size_t bound = std::max(bounds.back(), text.size() * i / chunkCount);
+        size_t lineBreak = text.find('\n', bound);
+        bound = lineBreak == std::string_view::npos ? text.size() : lineBreak + 1;
+        if (bound > bounds.back() && bound < text.size()) {
+            bounds.push_back(bound);
+        }
+    }
+
+    bounds.push_back(text.size());
+
+    std::vector<ObjChunk> chunks(bounds.size() - 1);
+    m_pool.parallelFor(static_cast<lov_size>(chunks.size()), [&](lov_size begin, lov_size end) {
+        for (lov_size i = begin; i < end; i++) {
+            parseObjChunk(text, bounds[i], bounds[i + 1], chunks[i]);
+        }
+    });
+
+    for (const ObjChunk& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            size_t line = 1 + std::count(text.begin(), text.begin() + chunk.errorOffset, '\n');
+            throw Exceptions::MeshException("OBJ line " + std::to_string(line) + ": " + chunk.error);
+        }
+    }
+
+    // Each chunk's lists follow the previous chunk's, so offset negative indices by the counts before it
+    std::vector<std::array<size_t, 4>> bases(chunks.size() + 1, { 0, 0, 0, 0 });
+    for (size_t i = 0; i < chunks.size(); i++) {
+        bases[i + 1] = {
+            bases[i][0] + chunks[i].positions.size(),
+            bases[i][1] + chunks[i].texCoords.size(),
+            bases[i][2] + chunks[i].normals.size(),
+            bases[i][3] + chunks[i].corners.size()
+        };
+    }
+
+    const std::array<size_t, 4>& totals = bases.back();
+    if (totals[3] > UINT_MAX || totals[0] > INT_MAX || totals[1] > INT_MAX || totals[2] > INT_MAX) {
+        throw Exceptions::MeshException("OBJ is too large to index with 32 bits");
+    }
+
+    std::vector<Vector3f> positions(totals[0]);
+    std::vector<Vector2f> texCoords(totals[1]);
+    std::vector<Vector3f> normals(totals[2]);
+    std::vector<ObjCorner> corners(totals[3]);
+    std::vector<char> outOfRange(chunks.size(), 0);
+
+    m_pool.parallelFor(static_cast<lov_size>(chunks.size()), [&](lov_size begin, lov_size end) {
+        for (lov_size i = begin; i < end; i++) {
+            ObjChunk& chunk = chunks[i];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + bases[i][0]);
+            std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), texCoords.begin() + bases[i][1]);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + bases[i][2]);
+
+            for (const ObjFixup& fixup : chunk.fixups) {
+                indexOf(chunk.corners[fixup.corner], fixup.component) = static_cast<lov_int>(bases[i][fixup.component]) + fixup.local;
+            }
+
+            // Every index must now refer to an element of the merged lists
+            for (const ObjCorner& corner : chunk.corners) {
+                if (corner.position < 0 || static_cast<size_t>(corner.position) >= totals[0] ||
+                    (corner.texCoord != NO_INDEX && (corner.texCoord < 0 || static_cast<size_t>(corner.texCoord) >= totals[1])) ||
+                    (corner.normal != NO_INDEX && (corner.normal < 0 || static_cast<size_t>(corner.normal) >= totals[2]))) {
+                    outOfRange[i] = 1;
+                }
+            }
+
+            std::copy(chunk.corners.begin(), chunk.corners.end(), corners.begin() + bases[i][3]);
+            chunk = ObjChunk();
+        }
+    });
+
+    if (std::find(outOfRange.begin(), outOfRange.end(), 1) != outOfRange.end()) {
+        throw Exceptions::MeshException("OBJ face refers to a vertex, texture coordinate or normal that doesn't exist");
+    }
+
+    // Weld identical corners into one vertex. Corners are split between tables by the range their position lies in,
+    // so each table can be filled on its own thread and their vertices simply follow one another. Small models use
+    // one table, keeping vertices in the order they first appear
+    size_t shardCount = corners.size() < OBJ_WELD_SHARD_SIZE ? 1 : static_cast<size_t>(m_pool.getThreadCount() + 1);
+    lov_uint shardPositions = static_cast<lov_uint>((positions.size() + shardCount - 1) / shardCount);
+
+    MeshData mesh;
+    mesh.indices.resize(corners.size());
+    std::vector<CornerTable> tables;
+    for (size_t shard = 0; shard < shardCount; shard++) {
+        tables.emplace_back(positions.size() / shardCount + 1);
+    }
+
+    m_pool.parallelFor(static_cast<lov_size>(shardCount), [&](lov_size begin, lov_size end) {
+        for (lov_size shard = begin; shard < end; shard++) {
+            lov_uint first = static_cast<lov_uint>(shard) * shardPositions;
+            for (size_t i = 0; i < corners.size(); i++) {
+                if (static_cast<lov_uint>(corners[i].position) - first < shardPositions) {
+                    mesh.indices[i] = tables[shard].insert(corners[i]);
+                }
+            }
+        }
+    });
+
+    std::vector<lov_uint> shardBases(shardCount + 1, 0);
+    std::vector<ObjCorner> keys;
+    for (size_t shard = 0; shard < shardCount; shard++) {
+        shardBases[shard + 1] = shardBases[shard] + static_cast<lov_uint>(tables[shard].keys.size());
+        keys.insert(keys.end(), tables[shard].keys.begin(), tables[shard].keys.end());
+        tables[shard] = CornerTable(0);
+    }
+
+    if (shardCount > 1) {
+        m_pool.parallelFor(static_cast<lov_size>(corners.size()), [&](lov_size begin, lov_size end) {
+            for (lov_size i = begin; i < end; i++) {
+                mesh.indices[i] += shardBases[static_cast<lov_uint>(corners[i].position) / shardPositions];
+            }
+        });
+    }
+
+    mesh.vertices.resize(keys.size());
+    m_pool.parallelFor(static_cast<lov_size>(keys.size()), [&](lov_size begin, lov_size end) {
+        for (lov_size v = begin; v < end; v++) {
+            const ObjCorner& key = keys[v];
+            mesh.vertices[v].position = positions[key.position];
+            mesh.vertices[v].texCoords = key.texCoord != NO_INDEX ? texCoords[key.texCoord] : Vector2f(0.0f, 0.0f);
+            mesh.vertices[v].normal = key.normal != NO_INDEX ? normals[key.normal] : Vector3f(0.0f, 0.0f, 0.0f);
+        }
+    });
+
+    bool missingNormals = std::any_of(keys.begin(), keys.end(), [](const ObjCorner& key) { return key.normal == NO_INDEX; });
+
+    // Smooth over every vertex at the same position, so texture seams don't show as lighting seams
+    if (missingNormals) {
+        std::vector<lov_uint> firstAtPosition(positions.size(), UINT_MAX);
+        std::vector<lov_uint> shared(keys.size());
+        for (size_t v = 0; v < keys.size(); v++) {
+            lov_uint& first = firstAtPosition[keys[v].position];
+            if (first == UINT_MAX) {
+                first = static_cast<lov_uint>(v);
+            }
+
+            shared[v] = first;
+        }
+
+        std::vector<Vector3f> given(keys.size());
+        for (size_t v = 0; v < keys.size(); v++) {
+            given[v] = mesh.vertices[v].normal;
+        }
+
+        calculateNormals(mesh, 0, keys.size(), 0, mesh.indices.size(), &shared);
+        for (size_t v = 0; v < keys.size(); v++) {
+            if (keys[v].normal != NO_INDEX) {
+                mesh.vertices[v].normal = given[v];
+            }
+        }
+    }
+
+    return mesh;
+}
+
+lov::Graphics::MeshData lov::Graphics::MeshLoader::loadGlb(std::span<const std::byte> data) const {
+    auto readU32 = [&](size_t offset) {
+        std::uint32_t value = 0;
+        for (size_t i = 0; i < 4; i++) {
+            value |= static_cast<std::uint32_t>(data[offset + i]) << (i * 8);
+        }
+
+        return value;
+    };
+
+    // A 12 byte header, then a JSON chunk and an optional binary chunk, each with an 8 byte header
+    if (data.size() < 20 || readU32(0) != 0x46546C67) {
+        throw Exceptions::MeshException("Not a binary glTF file");
+    }
+
+    if (readU32(4) != 2) {
+        throw Exceptions::MeshException("Only glTF 2.0 is supported");
+    }
+
+    size_t length = std::min(static_cast<size_t>(readU32(8)), data.size());
+    size_t jsonLength = readU32(12);
+    if (readU32(16) != 0x4E4F534A || jsonLength > length - 20) {
+        throw Exceptions::MeshException("glTF JSON chunk is missing or truncated");
+    }
+
+    std::span<const std::byte> binary;
+    size_t binaryHeader = 20 + jsonLength;
+    if (binaryHeader + 8 <= length && readU32(binaryHeader + 4) == 0x004E4942) {
+        size_t binaryLength = readU32(binaryHeader);
+        if (binaryLength > length - binaryHeader - 8) {
+            throw Exceptions::MeshException("glTF binary chunk is truncated");
+        }
+
+        binary = data.subspan(binaryHeader + 8, binaryLength);
+    }
+
+    JsonValue document = JsonParser(std::string_view(reinterpret_cast<const char*>(data.data()) + 20, jsonLength)).parse();
+    if (document.type != JsonValue::Type::Object) {
+        throw Exceptions::MeshException("glTF JSON is not an object");
+    }
+
+    // Place every mesh of the default scene by walking its node trees. Without scenes, every mesh is used as it is
+    std::vector<std::pair<size_t, Matrix>> instances;
+    const JsonValue* scenes = document.find("scenes");
+    const JsonValue* meshes = document.find("meshes");
+    if (scenes && scenes->type == JsonValue::Type::Array && !scenes->elements.empty()) {
+        const JsonValue& scene = element(document, "scenes", integer(document, "scene", 0));
+        const JsonValue* nodesArray = document.find("nodes");
+        std::vector<char> visited(nodesArray ? nodesArray->elements.size() : 0, 0);
+        std::vector<std::pair<size_t, Matrix>> stack;
+
+        if (const JsonValue* roots = scene.find("nodes")) {
+            for (const JsonValue& root : roots->elements) {
+                stack.push_back({ toInteger(root, "nodes"), IDENTITY });
+            }
+        }
+
+        while (!stack.empty()) {
+            auto [nodeIndex, parent] = stack.back();
+            stack.pop_back();
+
+            const JsonValue& node = element(document, "nodes", nodeIndex);
+            if (visited[nodeIndex]) {
+                throw Exceptions::MeshException("glTF node " + std::to_string(nodeIndex) + " has more than one parent");
+            }
+
+            visited[nodeIndex] = 1;
+
+            // A node has either a matrix or a translation, rotation and scale, applied in reverse order
+            Matrix local = IDENTITY;
+            if (!floats(node, "matrix", local)) {
+                std::array<float, 3> t = { 0.0f, 0.0f, 0.0f };
+                std::array<float, 4> r = { 0.0f, 0.0f, 0.0f, 1.0f };
+                std::array<float, 3> s = { 1.0f, 1.0f, 1.0f };
+                floats(node, "translation", t);
+                floats(node, "rotation", r);
+                floats(node, "scale", s);
+
+                float x = r[0], y = r[1], z = r[2], w = r[3];
+                local = {
+                    (1 - 2 * (y * y + z * z)) * s[0], 2 * (x * y + z * w) * s[0], 2 * (x * z - y * w) * s[0], 0,
+                    2 * (x * y - z * w) * s[1], (1 - 2 * (x * x + z * z)) * s[1], 2 * (y * z + x * w) * s[1], 0,
+                    2 * (x * z + y * w) * s[2], 2 * (y * z - x * w) * s[2], (1 - 2 * (x * x + y * y)) * s[2], 0,
+                    t[0], t[1], t[2], 1
+                };
+            }
+
+            Matrix world = multiply(parent, local);
+            if (node.find("mesh")) {
+                instances.push_back({ integer(node, "mesh", 0), world });
+            }
+
+            if (const JsonValue* children = node.find("children")) {
+                for (const JsonValue& child : children->elements) {
+                    stack.push_back({ toInteger(child, "children"), world });
+                }
+            }
+        }
+    }
+    else if (meshes) {
+        for (size_t i = 0; i < meshes->elements.size(); i++) {
+            instances.push_back({ i, IDENTITY });
+        }
+    }
+
+    // Resolve and check every primitive up front, so the parallel conversion can't fail partway
+    std::vector<GlbPrimitive> primitives;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (const auto& [meshIndex, transform] : instances) {
+        const JsonValue* primitivesArray = element(document, "meshes", meshIndex).find("primitives");
+        if (!primitivesArray) {
+            continue;
+        }
+
+        for (const JsonValue& primitiveJson : primitivesArray->elements) {
+            if (integer(primitiveJson, "mode", 4) != 4) {
+                throw Exceptions::MeshException("Only glTF triangle list primitives are supported");
+            }
+
+            const JsonValue* attributes = primitiveJson.find("attributes");
+            if (!attributes || !attributes->find("POSITION")) {
+                throw Exceptions::MeshException("glTF primitive has no positions");
+            }
+
+            GlbPrimitive primitive = {};
+            primitive.transform = transform;
+            primitive.positions = resolveAccessor(document, binary, integer(*attributes, "POSITION", 0), "VEC3", { FLOAT });
+            if (attributes->find("NORMAL")) {
+                primitive.normals = resolveAccessor(document, binary, integer(*attributes, "NORMAL", 0), "VEC3", { FLOAT });
+            }
+
+            if (attributes->find("TEXCOORD_0")) {
+                primitive.texCoords = resolveAccessor(document, binary, integer(*attributes, "TEXCOORD_0", 0), "VEC2", { FLOAT, UNSIGNED_BYTE, UNSIGNED_SHORT });
+            }
+
+            if (primitiveJson.find("indices")) {
+                primitive.indices = resolveAccessor(document, binary, integer(primitiveJson, "indices", 0), "SCALAR", { UNSIGNED_BYTE, UNSIGNED_SHORT, UNSIGNED_INT });
+                primitive.indexCount = primitive.indices.count;
+            }
+            else {
+                primitive.indexCount = primitive.positions.count;
+            }
+
+            if ((primitive.normals.count != 0 && primitive.normals.count != primitive.positions.count) ||
+                (primitive.texCoords.count != 0 && primitive.texCoords.count != primitive.positions.count) || primitive.indexCount % 3 != 0) {
+                throw Exceptions::MeshException("glTF primitive attributes have mismatched counts");
+            }
+
+            primitive.vertexBase = vertexCount;
+            primitive.indexBase = indexCount;
+            vertexCount += primitive.positions.count;
+            indexCount += primitive.indexCount;
+            primitives.push_back(primitive);
+        }
+    }
+
+    if (vertexCount > UINT_MAX || indexCount > UINT_MAX) {
+        throw Exceptions::MeshException("glTF is too large to index with 32 bits");
+    }
+
+    MeshData mesh;
+    mesh.vertices.resize(vertexCount);
+    mesh.indices.resize(indexCount);
+    std::vector<char> outOfRange(primitives.size(), 0);
+
+    m_pool.parallelFor(static_cast<lov_size>(primitives.size()), [&](lov_size begin, lov_size end) {
+        for (lov_size p = begin; p < end; p++) {
+            const GlbPrimitive& primitive = primitives[p];
+            const Matrix& m = primitive.transform;
+
+            // Normals transform by the inverse transpose, which is the cofactor matrix up to scale. A mirroring
+            // transform negates it and reverses the winding
+            std::array<float, 9> cofactor = {
+                m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8],
+                m[2] * m[9] - m[1] * m[10], m[0] * m[10] - m[2] * m[8], m[1] * m[8] - m[0] * m[9],
+                m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4]
+            };
+            float determinant = m[0] * cofactor[0] + m[4] * cofactor[3] + m[8] * cofactor[6];
+            bool mirrored = determinant < 0.0f;
+
+            for (size_t v = 0; v < primitive.positions.count; v++) {
+                Vertex& vertex = mesh.vertices[primitive.vertexBase + v];
+                float x = primitive.positions.get(v, 0);
+                float y = primitive.positions.get(v, 1);
+                float z = primitive.positions.get(v, 2);
+                vertex.position = {
+                    m[0] * x + m[4] * y + m[8] * z + m[12],
+                    m[1] * x + m[5] * y + m[9] * z + m[13],
+                    m[2] * x + m[6] * y + m[10] * z + m[14]
+                };
+
+                if (primitive.normals.count > 0) {
+                    float nx = primitive.normals.get(v, 0);
+                    float ny = primitive.normals.get(v, 1);
+                    float nz = primitive.normals.get(v, 2);
+                    Vector3f normal = {
+                        cofactor[0] * nx + cofactor[3] * ny + cofactor[6] * nz,
+                        cofactor[1] * nx + cofactor[4] * ny + cofactor[7] * nz,
+                        cofactor[2] * nx + cofactor[5] * ny + cofactor[8] * nz
+                    };
+                    float length = Vector::length(normal) * (mirrored ? -1.0f : 1.0f);
+                    vertex.normal = length != 0.0f ? normal / length : Vector3f(0.0f, 1.0f, 0.0f);
+                }
+
+                // glTF puts the texture origin at the top left, but images are flipped on load to put it at the bottom
+                vertex.texCoords = primitive.texCoords.count > 0 ?
+                    Vector2f(primitive.texCoords.get(v, 0), 1.0f - primitive.texCoords.get(v, 1)) : Vector2f(0.0f, 0.0f);
+            }
+
+            for (size_t i = 0; i < primitive.indexCount; i++) {
+                size_t index = primitive.indices.count > 0 ? primitive.indices.getIndex(i) : i;
+                if (index >= primitive.positions.count) {
+                    outOfRange[p] = 1;
+                    index = 0;
+                }
+
+                // Swap the last two corners of each triangle if the transform mirrors it
+                size_t target = mirrored && i % 3 != 0 ? i - (i % 3) + 3 - (i % 3) : i;
+                mesh.indices[primitive.indexBase + target] = static_cast<lov_uint>(primitive.vertexBase + index);
+            }
+
+            if (primitive.normals.count == 0) {
+                calculateNormals(mesh, primitive.vertexBase, primitive.vertexBase + primitive.positions.count,
+                    primitive.indexBase, primitive.indexBase + primitive.indexCount);
+            }
+        }
+    });
+
+    if (std::find(outOfRange.begin(), outOfRange.end(), 1) != outOfRange.end()) {
+        throw Exceptions::MeshException("glTF primitive index refers to a vertex that doesn't exist");
+    }
+
+    return mesh;
+}
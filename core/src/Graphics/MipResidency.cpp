@@ -0,0 +1,189 @@
+#include "Graphics/MipResidency.h"
+
+#include <algorithm>
+
+lov::Graphics::MipResidency::MipResidency(size_t budgetBytes):
+    m_budget(budgetBytes),
+    m_frame(0),
+    m_residentBytes(0),
+    m_pendingBytes(0),
+    m_wantedBytes(0)
+{}
+
+lov::lov_uint lov::Graphics::MipResidency::add() {
+    Entry entry = {};
+    entry.requestedLevel = -1;
+    entry.loading = true;
+    m_entries.push_back(std::move(entry));
+    return static_cast<lov_uint>(m_entries.size() - 1);
+}
+
+void lov::Graphics::MipResidency::setLevels(lov_uint texture, std::vector<size_t> levelSizes, lov_int tailLevel) {
+    Entry& entry = m_entries[texture];
+    entry.levelSizes = std::move(levelSizes);
+    entry.tailLevel = tailLevel;
+    entry.residentLevel = static_cast<lov_int>(entry.levelSizes.size());
+    entry.wantedLevel = tailLevel;
+}
+
+bool lov::Graphics::MipResidency::hasLevels(lov_uint texture) const {
+    return !m_entries[texture].levelSizes.empty();
+}
+
+void lov::Graphics::MipResidency::request(lov_uint texture, lov_int level) {
+    Entry& entry = m_entries[texture];
+    entry.requestedLevel = entry.requestedLevel < 0 ? level : std::min(entry.requestedLevel, level);
+}
+
+void lov::Graphics::MipResidency::levelUploaded(lov_uint texture, lov_int level, bool tail) {
+    Entry& entry = m_entries[texture];
+    entry.residentLevel = level;
+    m_residentBytes += entry.levelSizes[level];
+    if (!tail) {
+        m_pendingBytes -= entry.levelSizes[level];
+    }
+}
+
+void lov::Graphics::MipResidency::loadFinished(lov_uint texture) {
+    m_entries[texture].loading = false;
+}
+
+void lov::Graphics::MipResidency::loadFailed(lov_uint texture, lov_int firstLevel, bool tail) {
+    Entry& entry = m_entries[texture];
+    if (!tail) {
+        m_pendingBytes -= rangeBytes(entry, firstLevel, entry.residentLevel - 1);
+    }
+
+    entry.loading = false;
+}
+
+lov::Graphics::MipPlan lov::Graphics::MipResidency::update() {
+    m_frame++;
+
+    // Resolve this frame's requests into the finest level each texture needs
+    m_wantedBytes = 0;
+    for (Entry& entry : m_entries) {
+        if (!entry.levelSizes.empty()) {
+            lov_int wanted = entry.requestedLevel >= 0 ? entry.requestedLevel : entry.tailLevel;
+            entry.wantedLevel = std::clamp(wanted, 0, entry.tailLevel);
+            if (entry.wantedLevel < entry.tailLevel) {
+                entry.lastWanted = m_frame;
+            }
+
+            m_wantedBytes += rangeBytes(entry, entry.wantedLevel, static_cast<lov_int>(entry.levelSizes.size()) - 1);
+        }
+
+        entry.requestedLevel = -1;
+    }
+
+    MipPlan plan;
+    evict(m_budget, plan.evictions);
+
+    // Read missing detail, biggest shortfall first, settling for coarser levels when the budget runs out
+    std::vector<lov_uint> wanting;
+    for (lov_uint i = 0; i < m_entries.size(); i++) {
+        if (!m_entries[i].levelSizes.empty() && !m_entries[i].loading && m_entries[i].wantedLevel < m_entries[i].residentLevel) {
+            wanting.push_back(i);
+        }
+    }
+
+    std::stable_sort(wanting.begin(), wanting.end(), [this](lov_uint left, lov_uint right) {
+        return m_entries[left].residentLevel - m_entries[left].wantedLevel > m_entries[right].residentLevel - m_entries[right].wantedLevel;
+    });
+
+    for (lov_uint index : wanting) {
+        Entry& entry = m_entries[index];
+        lov_int firstLevel = entry.wantedLevel;
+        lov_int lastLevel = entry.residentLevel - 1;
+
+        while (firstLevel <= lastLevel) {
+            size_t bytes = rangeBytes(entry, firstLevel, lastLevel);
+            if (bytes <= m_budget) {
+                evict(m_budget - bytes, plan.evictions);
+            }
+
+            if (m_residentBytes + m_pendingBytes + bytes <= m_budget) {
+                break;
+            }
+
+            firstLevel++;
+        }
+
+        if (firstLevel > lastLevel) {
+            continue;
+        }
+
+        entry.loading = true;
+        m_pendingBytes += rangeBytes(entry, firstLevel, lastLevel);
+        plan.loads.push_back({ index, firstLevel, lastLevel });
+    }
+
+    return plan;
+}
+
+void lov::Graphics::MipResidency::setBudget(size_t budgetBytes) {
+    m_budget = budgetBytes;
+}
+
+lov::lov_int lov::Graphics::MipResidency::getResidentLevel(lov_uint texture) const {
+    return m_entries[texture].residentLevel;
+}
+
+lov::lov_int lov::Graphics::MipResidency::getWantedLevel(lov_uint texture) const {
+    return m_entries[texture].wantedLevel;
+}
+
+bool lov::Graphics::MipResidency::isLoading(lov_uint texture) const {
+    return m_entries[texture].loading;
+}
+
+lov::lov_size lov::Graphics::MipResidency::getLoadingCount() const {
+    return static_cast<lov_size>(std::count_if(m_entries.begin(), m_entries.end(), [](const Entry& entry) { return entry.loading; }));
+}
+
+size_t lov::Graphics::MipResidency::getResidentBytes() const {
+    return m_residentBytes;
+}
+
+size_t lov::Graphics::MipResidency::getPendingBytes() const {
+    return m_pendingBytes;
+}
+
+size_t lov::Graphics::MipResidency::getWantedBytes() const {
+    return m_wantedBytes;
+}
+
+void lov::Graphics::MipResidency::evict(size_t budgetBytes, std::vector<MipEviction>& evictions) {
+    while (m_residentBytes + m_pendingBytes > budgetBytes) {
+        // Only free detail a texture no longer wants, starting with whichever wanted it least recently
+        Entry* victim = nullptr;
+        for (Entry& entry : m_entries) {
+            if (entry.levelSizes.empty() || entry.loading || entry.residentLevel >= entry.wantedLevel) {
+                continue;
+            }
+
+            if (!victim || entry.lastWanted < victim->lastWanted ||
+                (entry.lastWanted == victim->lastWanted && entry.levelSizes[entry.residentLevel] > victim->levelSizes[victim->residentLevel])) {
+                victim = &entry;
+            }
+        }
+
+        if (!victim) {
+            return;
+        }
+
+        // Sampling is clamped past the level before it's freed, so the texture stays complete
+        evictions.push_back({ static_cast<lov_uint>(victim - m_entries.data()), victim->residentLevel });
+        m_residentBytes -= victim->levelSizes[victim->residentLevel];
+        victim->residentLevel++;
+    }
+}
+
+size_t lov::Graphics::MipResidency::rangeBytes(const Entry& entry, lov_int firstLevel, lov_int lastLevel) {
+    size_t bytes = 0;
+    for (lov_int level = firstLevel; level <= lastLevel; level++) {
+        bytes += entry.levelSizes[level];
+    }
+
+    return bytes;
+}
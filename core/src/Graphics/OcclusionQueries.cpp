@@ -0,0 +1,188 @@
+#include "Graphics/OcclusionQueries.h"
+
+#include "Graphics/GLExtensions.h"
+
+namespace {
+    /// @brief Number of query objects created whenever the pool runs dry
+    const lov::lov_size QUERY_BATCH_SIZE = 32;
+
+    /// @brief Corners of a unit cube centered on the origin
+    const float cubeCorners[] = {
+        -0.5f, -0.5f, -0.5f,     0.5f, -0.5f, -0.5f,    -0.5f,  0.5f, -0.5f,     0.5f,  0.5f, -0.5f,
+        -0.5f, -0.5f,  0.5f,     0.5f, -0.5f,  0.5f,    -0.5f,  0.5f,  0.5f,     0.5f,  0.5f,  0.5f
+    };
+
+    /// @brief Triangles of the unit cube
+    const lov::lov_uint cubeIndices[] = {
+        0, 2, 1, 1, 2, 3,   4, 5, 6, 5, 7, 6,
+        0, 1, 4, 1, 5, 4,   2, 6, 3, 3, 6, 7,
+        0, 4, 2, 2, 4, 6,   1, 3, 5, 3, 7, 5
+    };
+}
+
+lov::Graphics::OcclusionQueries::OcclusionQueries():
+    m_target(GLExtensions::hasConservativeOcclusionQueries() ? GL_ANY_SAMPLES_PASSED_CONSERVATIVE : GL_ANY_SAMPLES_PASSED)
+{
+    // Upload the cube drawn for every query
+    m_vao.bind();
+
+    m_vbo.bind();
+    m_vbo.bufferData(cubeCorners, sizeof(cubeCorners));
+
+    m_ebo.bind();
+    m_ebo.bufferIndices(cubeIndices, sizeof(cubeIndices));
+
+    m_vao.linkAttribute(0, 3, LOV_FLOAT, 3 * sizeof(float), 0);
+
+    m_vao.unbind();
+}
+
+lov::Graphics::OcclusionQueries::~OcclusionQueries() {
+    // Delete every query object of the pool
+    if (!m_queries.empty()) {
+        glDeleteQueries(static_cast<lov_size>(m_queries.size()), m_queries.data());
+    }
+}
+
+void lov::Graphics::OcclusionQueries::compile(const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
+    m_shader.compileFromFiles(vertexShaderPath, fragmentShaderPath);
+}
+
+void lov::Graphics::OcclusionQueries::compile(std::span<const std::byte> vertexShaderSource, std::span<const std::byte> fragmentShaderSource) {
+    m_shader.compileFromMemory(vertexShaderSource, fragmentShaderSource);
+}
+
+lov::lov_uint lov::Graphics::OcclusionQueries::addObject(const BoundingBox& bounds) {
+    Object object = { bounds, acquireQuery(), false, true, true };
+
+    // Reuse the slot of a removed object if there is one
+    if (!m_freeObjects.empty()) {
+        lov_uint id = m_freeObjects.back();
+        m_freeObjects.pop_back();
+        m_objects[id] = object;
+        return id;
+    }
+
+    m_objects.push_back(object);
+    return static_cast<lov_uint>(m_objects.size() - 1);
+}
+
+void lov::Graphics::OcclusionQueries::removeObject(lov_uint id) {
+    Object& object = m_objects[id];
+    m_freeQueries.push_back(object.query);
+    m_freeObjects.push_back(id);
+    object.active = false;
+    object.inFlight = false;
+}
+
+void lov::Graphics::OcclusionQueries::setBounds(lov_uint id, const BoundingBox& bounds) {
+    m_objects[id].bounds = bounds;
+}
+
+void lov::Graphics::OcclusionQueries::beginFrame() {
+    for (Object& object : m_objects) {
+        if (!object.active || !object.inFlight) {
+            continue;
+        }
+
+        // Only read results the GPU has already finished
+        lov_uint available = 0;
+        glGetQueryObjectuiv(object.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+
+        lov_uint samplesPassed = 0;
+        glGetQueryObjectuiv(object.query, GL_QUERY_RESULT, &samplesPassed);
+        object.visible = samplesPassed != 0;
+        object.inFlight = false;
+    }
+}
+
+void lov::Graphics::OcclusionQueries::issue(const Transform& viewProjection) {
+    // Test the boxes against the depth buffer without changing it. Faces level with drawn geometry count as visible,
+    // so an object whose bounds hug its surface is not hidden by itself
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);
+
+    m_shader.bind();
+    m_shader.setUniform("viewProjection", viewProjection);
+    m_vao.bind();
+
+    for (Object& object : m_objects) {
+        if (!object.active || object.inFlight || object.bounds.isEmpty()) {
+            continue;
+        }
+
+        // A box crossing the near plane is clipped open, so its query could miss an object that surrounds the camera
+        bool crossesNearPlane = false;
+        for (int i = 0; i < 8 && !crossesNearPlane; i++) {
+            Vector4f clip = viewProjection * Vector4f(
+                (i & 1) ? object.bounds.max.x : object.bounds.min.x,
+                (i & 2) ? object.bounds.max.y : object.bounds.min.y,
+                (i & 4) ? object.bounds.max.z : object.bounds.min.z,
+                1.0f
+            );
+            crossesNearPlane = clip.w <= 0.0f || clip.z < -clip.w;
+        }
+
+        if (crossesNearPlane) {
+            continue;
+        }
+
+        Vector3f size = object.bounds.max - object.bounds.min;
+        m_shader.setUniform("model", Transform().translate(object.bounds.getCenter()).scale(size));
+
+        glBeginQuery(m_target, object.query);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        glEndQuery(m_target);
+
+        object.inFlight = true;
+    }
+
+    m_vao.unbind();
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+}
+
+bool lov::Graphics::OcclusionQueries::wasVisible(lov_uint id) const {
+    return m_objects[id].visible;
+}
+
+void lov::Graphics::OcclusionQueries::beginConditionalDraw(lov_uint id) const {
+    // The GPU waits on its own query, the CPU never does
+    if (m_objects[id].inFlight) {
+        glBeginConditionalRender(m_objects[id].query, GL_QUERY_WAIT);
+    }
+}
+
+void lov::Graphics::OcclusionQueries::endConditionalDraw(lov_uint id) const {
+    if (m_objects[id].inFlight) {
+        glEndConditionalRender();
+    }
+}
+
+lov::lov_uint lov::Graphics::OcclusionQueries::getTarget() const {
+    return m_target;
+}
+
+lov::lov_size lov::Graphics::OcclusionQueries::getQueryCount() const {
+    return static_cast<lov_size>(m_queries.size());
+}
+
+lov::lov_uint lov::Graphics::OcclusionQueries::acquireQuery() {
+    // Create a batch of queries at once rather than one per object
+    if (m_freeQueries.empty()) {
+        std::vector<lov_uint> batch(QUERY_BATCH_SIZE);
+        glGenQueries(QUERY_BATCH_SIZE, batch.data());
+        m_queries.insert(m_queries.end(), batch.begin(), batch.end());
+        m_freeQueries.insert(m_freeQueries.end(), batch.rbegin(), batch.rend());
+    }
+
+    lov_uint query = m_freeQueries.back();
+    m_freeQueries.pop_back();
+    return query;
+}
@@ -0,0 +1,341 @@
+#include "Graphics/OcclusionRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LOV_OCCLUSION_SSE 1
+#endif
+
+lov::Graphics::OcclusionRasterizer::OcclusionRasterizer(lov_size width, lov_size height, System::ThreadPool* pool):
+    m_width(width),
+    m_height(height),
+    m_tilesX((width + TILE_WIDTH - 1) / TILE_WIDTH),
+    m_tilesY((height + TILE_HEIGHT - 1) / TILE_HEIGHT),
+    m_pool(pool),
+    m_bins(m_tilesX * m_tilesY),
+    m_depth(width * height, 1.0f)
+{}
+
+bool lov::Graphics::OcclusionRasterizer::hasSimd() {
+#ifdef LOV_OCCLUSION_SSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void lov::Graphics::OcclusionRasterizer::beginFrame(const Transform& viewProjection) {
+    m_viewProjection = viewProjection;
+    m_occluders.clear();
+}
+
+void lov::Graphics::OcclusionRasterizer::addOccluder(const MeshData& mesh, const Transform& model) {
+    m_occluders.push_back({ &mesh, model });
+}
+
+void lov::Graphics::OcclusionRasterizer::rasterize() {
+    m_triangles.clear();
+    for (std::vector<lov_uint>& bin : m_bins) {
+        bin.clear();
+    }
+
+    // Set up every triangle in front of the near plane and bin it to the tiles its pixels overlap
+    for (const Occluder& occluder : m_occluders) {
+        const MeshData& mesh = *occluder.mesh;
+        Transform modelViewProjection = m_viewProjection * occluder.model;
+
+        m_screenVertices.resize(mesh.vertices.size());
+        forEach(static_cast<lov_size>(mesh.vertices.size()), [&](lov_size begin, lov_size end) {
+            transformVertices(mesh, modelViewProjection, begin, end);
+        });
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            Triangle triangle;
+            if (!setupTriangle(m_screenVertices[mesh.indices[i]], m_screenVertices[mesh.indices[i + 1]], m_screenVertices[mesh.indices[i + 2]], triangle)) {
+                continue;
+            }
+
+            lov_uint index = static_cast<lov_uint>(m_triangles.size());
+            m_triangles.push_back(triangle);
+
+            for (lov_int ty = triangle.minY / TILE_HEIGHT; ty <= triangle.maxY / TILE_HEIGHT; ty++) {
+                for (lov_int tx = triangle.minX / TILE_WIDTH; tx <= triangle.maxX / TILE_WIDTH; tx++) {
+                    m_bins[ty * m_tilesX + tx].push_back(index);
+                }
+            }
+        }
+    }
+
+    // Each tile owns its pixels, so tiles can be filled in parallel without locking
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    forEach(m_tilesX * m_tilesY, [this](lov_size begin, lov_size end) {
+        for (lov_size tile = begin; tile < end; tile++) {
+            rasterizeTile(tile);
+        }
+    });
+
+    m_pyramid.build(m_depth.data(), m_width, m_height);
+}
+
+bool lov::Graphics::OcclusionRasterizer::isVisible(const BoundingBox& bounds) const {
+    if (bounds.isEmpty()) {
+        return false;
+    }
+
+    // Project the corners, keeping the screen rectangle and nearest depth
+    Vector2f screenMin(1e30f, 1e30f);
+    Vector2f screenMax(-1e30f, -1e30f);
+    float nearestDepth = 1.0f;
+
+    for (int i = 0; i < 8; i++) {
+        Vector4f corner(
+            (i & 1) ? bounds.max.x : bounds.min.x,
+            (i & 2) ? bounds.max.y : bounds.min.y,
+            (i & 4) ? bounds.max.z : bounds.min.z,
+            1.0f
+        );
+        Vector4f clip = m_viewProjection * corner;
+
+        // Part of the box is behind the near plane, so it may cover the whole screen
+        if (clip.w <= 0.0f || clip.z < -clip.w) {
+            return true;
+        }
+
+        float x = (clip.x / clip.w * 0.5f + 0.5f) * m_width;
+        float y = (clip.y / clip.w * 0.5f + 0.5f) * m_height;
+        screenMin = { std::min(screenMin.x, x), std::min(screenMin.y, y) };
+        screenMax = { std::max(screenMax.x, x), std::max(screenMax.y, y) };
+        nearestDepth = std::min(nearestDepth, clip.z / clip.w * 0.5f + 0.5f);
+    }
+
+    // Leave boxes outside the screen to frustum culling
+    if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= m_width || screenMin.y >= m_height) {
+        return true;
+    }
+
+    // Test every pixel the rectangle touches
+    return !m_pyramid.isOccludedExact(
+        static_cast<lov_int>(floorf(std::max(screenMin.x, 0.0f))),
+        static_cast<lov_int>(floorf(std::max(screenMin.y, 0.0f))),
+        static_cast<lov_int>(floorf(std::min(screenMax.x, static_cast<float>(m_width)))),
+        static_cast<lov_int>(floorf(std::min(screenMax.y, static_cast<float>(m_height)))),
+        nearestDepth
+    );
+}
+
+void lov::Graphics::OcclusionRasterizer::cull(const std::vector<BoundingBox>& bounds, std::vector<lov_uint>& visible) const {
+    std::vector<unsigned char> results(bounds.size());
+    forEach(static_cast<lov_size>(bounds.size()), [&](lov_size begin, lov_size end) {
+        for (lov_size i = begin; i < end; i++) {
+            results[i] = isVisible(bounds[i]) ? 1 : 0;
+        }
+    });
+
+    visible.clear();
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i]) {
+            visible.push_back(static_cast<lov_uint>(i));
+        }
+    }
+}
+
+lov::lov_size lov::Graphics::OcclusionRasterizer::getWidth() const {
+    return m_width;
+}
+
+lov::lov_size lov::Graphics::OcclusionRasterizer::getHeight() const {
+    return m_height;
+}
+
+lov::lov_size lov::Graphics::OcclusionRasterizer::getTriangleCount() const {
+    return static_cast<lov_size>(m_triangles.size());
+}
+
+const std::vector<float>& lov::Graphics::OcclusionRasterizer::getDepthBuffer() const {
+    return m_depth;
+}
+
+const lov::Graphics::DepthPyramid& lov::Graphics::OcclusionRasterizer::getPyramid() const {
+    return m_pyramid;
+}
+
+void lov::Graphics::OcclusionRasterizer::forEach(lov_size count, const std::function<void(lov_size begin, lov_size end)>& body) const {
+    if (m_pool) {
+        m_pool->parallelFor(count, body);
+    } else if (count > 0) {
+        body(0, count);
+    }
+}
+
+void lov::Graphics::OcclusionRasterizer::transformVertices(const MeshData& mesh, const Transform& modelViewProjection, lov_size begin, lov_size end) {
+    const Transform& m = modelViewProjection;
+    lov_size i = begin;
+
+#ifdef LOV_OCCLUSION_SSE
+    // Transform four vertices at a time, adding the products in the same order as Transform * Vector4f
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 width = _mm_set1_ps(static_cast<float>(m_width));
+    const __m128 height = _mm_set1_ps(static_cast<float>(m_height));
+
+    for (; i + 4 <= end; i += 4) {
+        const Vertex* v = &mesh.vertices[i];
+        __m128 px = _mm_setr_ps(v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x);
+        __m128 py = _mm_setr_ps(v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y);
+        __m128 pz = _mm_setr_ps(v[0].position.z, v[1].position.z, v[2].position.z, v[3].position.z);
+
+        __m128 clip[4];
+        for (int row = 0; row < 4; row++) {
+            clip[row] = _mm_add_ps(
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.x[row]), px), _mm_mul_ps(_mm_set1_ps(m.y[row]), py)),
+                    _mm_mul_ps(_mm_set1_ps(m.z[row]), pz)
+                ),
+                _mm_set1_ps(m.w[row])
+            );
+        }
+
+        __m128 x = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_div_ps(clip[0], clip[3]), half), half), width);
+        __m128 y = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_div_ps(clip[1], clip[3]), half), half), height);
+        __m128 z = _mm_add_ps(_mm_mul_ps(_mm_div_ps(clip[2], clip[3]), half), half);
+        __m128 valid = _mm_and_ps(_mm_cmpgt_ps(clip[3], zero), _mm_cmpge_ps(clip[2], _mm_sub_ps(zero, clip[3])));
+        valid = _mm_and_ps(valid, _mm_set1_ps(1.0f));
+
+        // Transpose back into one Vector4f per vertex
+        _MM_TRANSPOSE4_PS(x, y, z, valid);
+        _mm_storeu_ps(&m_screenVertices[i].x, x);
+        _mm_storeu_ps(&m_screenVertices[i + 1].x, y);
+        _mm_storeu_ps(&m_screenVertices[i + 2].x, z);
+        _mm_storeu_ps(&m_screenVertices[i + 3].x, valid);
+    }
+#endif
+
+    for (; i < end; i++) {
+        const Vector3f& position = mesh.vertices[i].position;
+        Vector4f clip = m * Vector4f(position.x, position.y, position.z, 1.0f);
+
+        m_screenVertices[i] = {
+            (clip.x / clip.w * 0.5f + 0.5f) * m_width,
+            (clip.y / clip.w * 0.5f + 0.5f) * m_height,
+            clip.z / clip.w * 0.5f + 0.5f,
+            clip.w > 0.0f && clip.z >= -clip.w ? 1.0f : 0.0f
+        };
+    }
+}
+
+bool lov::Graphics::OcclusionRasterizer::setupTriangle(const Vector4f& v0, const Vector4f& v1, const Vector4f& v2, Triangle& triangle) const {
+    // Skip triangles that cross the near plane rather than clipping them
+    if (v0.w == 0.0f || v1.w == 0.0f || v2.w == 0.0f) {
+        return false;
+    }
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (area == 0.0f || !std::isfinite(area)) {
+        return false;
+    }
+
+    // Edge i runs from vertex i to vertex i + 1
+    const Vector4f* vertices[3] = { &v0, &v1, &v2 };
+    for (int i = 0; i < 3; i++) {
+        const Vector4f& from = *vertices[i];
+        const Vector4f& to = *vertices[(i + 1) % 3];
+        triangle.edgeA[i] = from.y - to.y;
+        triangle.edgeB[i] = to.x - from.x;
+        triangle.edgeC[i] = from.x * to.y - from.y * to.x;
+    }
+
+    // Each vertex is weighted by the edge opposite it
+    triangle.depthA = (triangle.edgeA[1] * v0.z + triangle.edgeA[2] * v1.z + triangle.edgeA[0] * v2.z) / area;
+    triangle.depthB = (triangle.edgeB[1] * v0.z + triangle.edgeB[2] * v1.z + triangle.edgeB[0] * v2.z) / area;
+    triangle.depthC = (triangle.edgeC[1] * v0.z + triangle.edgeC[2] * v1.z + triangle.edgeC[0] * v2.z) / area;
+
+    // Occluders are double sided, so flip clockwise triangles to keep the inside positive
+    if (area < 0.0f) {
+        for (int i = 0; i < 3; i++) {
+            triangle.edgeA[i] = -triangle.edgeA[i];
+            triangle.edgeB[i] = -triangle.edgeB[i];
+            triangle.edgeC[i] = -triangle.edgeC[i];
+        }
+    }
+
+    // The pixels whose centers can fall inside the triangle, clamped to the screen
+    float minX = std::min(std::min(v0.x, v1.x), v2.x);
+    float minY = std::min(std::min(v0.y, v1.y), v2.y);
+    float maxX = std::max(std::max(v0.x, v1.x), v2.x);
+    float maxY = std::max(std::max(v0.y, v1.y), v2.y);
+
+    triangle.minX = static_cast<lov_int>(ceilf(std::clamp(minX - 0.5f, 0.0f, static_cast<float>(m_width))));
+    triangle.minY = static_cast<lov_int>(ceilf(std::clamp(minY - 0.5f, 0.0f, static_cast<float>(m_height))));
+    triangle.maxX = static_cast<lov_int>(floorf(std::clamp(maxX - 0.5f, -1.0f, static_cast<float>(m_width - 1))));
+    triangle.maxY = static_cast<lov_int>(floorf(std::clamp(maxY - 0.5f, -1.0f, static_cast<float>(m_height - 1))));
+
+    return triangle.minX <= triangle.maxX && triangle.minY <= triangle.maxY;
+}
+
+void lov::Graphics::OcclusionRasterizer::rasterizeTile(lov_size tile) {
+    lov_int tileMinX = (tile % m_tilesX) * TILE_WIDTH;
+    lov_int tileMinY = (tile / m_tilesX) * TILE_HEIGHT;
+    lov_int tileMaxX = std::min(tileMinX + TILE_WIDTH, m_width) - 1;
+    lov_int tileMaxY = std::min(tileMinY + TILE_HEIGHT, m_height) - 1;
+
+    for (lov_uint index : m_bins[tile]) {
+        const Triangle& triangle = m_triangles[index];
+        lov_int minX = std::max(triangle.minX, tileMinX);
+        lov_int minY = std::max(triangle.minY, tileMinY);
+        lov_int maxX = std::min(triangle.maxX, tileMaxX);
+        lov_int maxY = std::min(triangle.maxY, tileMaxY);
+
+        for (lov_int y = minY; y <= maxY; y++) {
+            // Everything that only depends on the row is evaluated once
+            float centerY = y + 0.5f;
+            float row0 = triangle.edgeB[0] * centerY + triangle.edgeC[0];
+            float row1 = triangle.edgeB[1] * centerY + triangle.edgeC[1];
+            float row2 = triangle.edgeB[2] * centerY + triangle.edgeC[2];
+            float rowDepth = triangle.depthB * centerY + triangle.depthC;
+            float* line = &m_depth[y * m_width];
+            lov_int x = minX;
+
+#ifdef LOV_OCCLUSION_SSE
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 a0 = _mm_set1_ps(triangle.edgeA[0]);
+            const __m128 a1 = _mm_set1_ps(triangle.edgeA[1]);
+            const __m128 a2 = _mm_set1_ps(triangle.edgeA[2]);
+            const __m128 depthA = _mm_set1_ps(triangle.depthA);
+            const __m128 r0 = _mm_set1_ps(row0);
+            const __m128 r1 = _mm_set1_ps(row1);
+            const __m128 r2 = _mm_set1_ps(row2);
+            const __m128 rDepth = _mm_set1_ps(rowDepth);
+
+            // Test four pixel centers at a time and keep the nearest depth where all three edges pass
+            for (; x + 3 <= maxX; x += 4) {
+                __m128 centerX = _mm_add_ps(_mm_cvtepi32_ps(_mm_setr_epi32(x, x + 1, x + 2, x + 3)), _mm_set1_ps(0.5f));
+                __m128 inside = _mm_and_ps(
+                    _mm_and_ps(
+                        _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, centerX), r0), zero),
+                        _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, centerX), r1), zero)
+                    ),
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, centerX), r2), zero)
+                );
+
+                __m128 current = _mm_loadu_ps(line + x);
+                __m128 nearest = _mm_min_ps(_mm_add_ps(_mm_mul_ps(depthA, centerX), rDepth), current);
+                _mm_storeu_ps(line + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+#endif
+
+            for (; x <= maxX; x++) {
+                float centerX = x + 0.5f;
+                if (triangle.edgeA[0] * centerX + row0 >= 0.0f &&
+                    triangle.edgeA[1] * centerX + row1 >= 0.0f &&
+                    triangle.edgeA[2] * centerX + row2 >= 0.0f) {
+                    float depth = triangle.depthA * centerX + rowDepth;
+                    if (depth < line[x]) {
+                        line[x] = depth;
+                    }
+                }
+            }
+        }
+    }
+}
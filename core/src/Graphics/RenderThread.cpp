@@ -0,0 +1,147 @@
+#include "Graphics/RenderThread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+void lov::Graphics::FramePacket::clear() {
+    commands.clear();
+    batchStarts.clear();
+    draws.clear();
+    assetRequests.clear();
+}
+
+lov::Graphics::RenderThread::RenderThread(Window& window, RenderFunction render, lov_size maxQueuedFrames):
+    m_window(window),
+    m_render(std::move(render)),
+    m_acquired(nullptr),
+    m_drawing(false),
+    m_nextFrame(0),
+    m_stopping(false),
+    m_stats()
+{
+    // One packet per queued frame, plus the one being drawn
+    lov_size packetCount = std::max(maxQueuedFrames, 1) + 1;
+    for (lov_size i = 0; i < packetCount; i++) {
+        m_packets.push_back(std::make_unique<FramePacket>());
+        m_free.push_back(m_packets.back().get());
+    }
+
+    // A context can only be current on one thread at a time
+    m_window.releaseCurrent();
+    m_thread = std::thread(&RenderThread::render, this);
+}
+
+lov::Graphics::RenderThread::~RenderThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_changed.notify_all();
+    m_thread.join();
+
+    // Hand the context back, so the caller can destroy what it created
+    m_window.makeCurrent();
+}
+
+lov::Graphics::FramePacket& lov::Graphics::RenderThread::acquire() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    rethrow();
+
+    if (m_acquired) {
+        return *m_acquired;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    m_changed.wait(lock, [this]() { return !m_free.empty(); });
+    m_stats.waitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    m_acquired = m_free.back();
+    m_free.pop_back();
+    lock.unlock();
+
+    m_acquired->clear();
+    m_acquired->frame = m_nextFrame++;
+    return *m_acquired;
+}
+
+void lov::Graphics::RenderThread::submit() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_acquired) {
+            return;
+        }
+
+        m_queued.push_back(m_acquired);
+        m_acquired = nullptr;
+    }
+
+    m_changed.notify_all();
+}
+
+void lov::Graphics::RenderThread::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this]() { return m_queued.empty() && !m_drawing; });
+    rethrow();
+}
+
+lov::Graphics::RenderThreadStats lov::Graphics::RenderThread::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void lov::Graphics::RenderThread::render() {
+    m_window.makeCurrent();
+
+    while (true) {
+        FramePacket* packet;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this]() { return m_stopping || !m_queued.empty(); });
+
+            // Draw whatever was submitted before stopping
+            if (m_queued.empty()) {
+                break;
+            }
+
+            packet = m_queued.front();
+            m_queued.pop_front();
+            m_drawing = true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::exception_ptr exception;
+
+        try {
+            m_render(*packet);
+            m_window.swapBuffers();
+        }
+        catch (...) {
+            exception = std::current_exception();
+        }
+
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (exception && !m_exception) {
+                m_exception = exception;
+            }
+
+            m_free.push_back(packet);
+            m_drawing = false;
+            m_stats.framesRendered++;
+            m_stats.renderMilliseconds = milliseconds;
+        }
+
+        m_changed.notify_all();
+    }
+
+    m_window.releaseCurrent();
+}
+
+void lov::Graphics::RenderThread::rethrow() {
+    if (m_exception) {
+        std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+}
@@ -0,0 +1,53 @@
+#include "Graphics/Sampler.h"
+
+#include <vector>
+
+namespace {
+    /// @brief A cached sampler object
+    struct CachedSampler {
+        lov::Graphics::SamplerDesc desc;    ///< The state of the sampler
+        lov::lov_uint id;                   ///< The sampler object
+    };
+
+    /// @brief Every sampler object created. Programs only use a handful, so a linear search beats hashing
+    std::vector<CachedSampler> samplers;
+}
+
+bool lov::Graphics::SamplerDesc::operator==(const SamplerDesc& other) const {
+    return minFilter == other.minFilter && magFilter == other.magFilter && wrapS == other.wrapS && wrapT == other.wrapT;
+}
+
+lov::lov_uint lov::Graphics::SamplerCache::get(const SamplerDesc& desc) {
+    for (const CachedSampler& sampler : samplers) {
+        if (sampler.desc == desc) {
+            return sampler.id;
+        }
+    }
+
+    // Create a sampler object for the new state
+    lov_uint id;
+    glGenSamplers(1, &id);
+    glSamplerParameteri(id, GL_TEXTURE_MIN_FILTER, desc.minFilter);
+    glSamplerParameteri(id, GL_TEXTURE_MAG_FILTER, desc.magFilter);
+    glSamplerParameteri(id, GL_TEXTURE_WRAP_S, desc.wrapS);
+    glSamplerParameteri(id, GL_TEXTURE_WRAP_T, desc.wrapT);
+
+    samplers.push_back({ desc, id });
+    return id;
+}
+
+void lov::Graphics::SamplerCache::bind(lov_uint unit, const SamplerDesc& desc) {
+    glBindSampler(unit, get(desc));
+}
+
+lov::lov_size lov::Graphics::SamplerCache::getCount() {
+    return static_cast<lov_size>(samplers.size());
+}
+
+void lov::Graphics::SamplerCache::clear() {
+    for (const CachedSampler& sampler : samplers) {
+        glDeleteSamplers(1, &sampler.id);
+    }
+
+    samplers.clear();
+}
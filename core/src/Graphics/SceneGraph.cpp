@@ -0,0 +1,258 @@
+#include "Graphics/SceneGraph.h"
+
+#include "System/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace {
+    /// @brief Levels with fewer nodes than this are swept on the calling thread, since splitting them costs more
+    const lov::lov_uint parallelLevelSize = 1024;
+}
+
+lov::Graphics::Transform lov::Graphics::NodeTransform::toTransform() const {
+    Transform transform = Transform().translate(position);
+    if (rotationAngle != 0.0f) {
+        transform = transform.rotate(rotationAxis, rotationAngle);
+    }
+
+    return transform.scale(scale);
+}
+
+lov::Graphics::NodeTransform lov::Graphics::NodeTransform::interpolate(const NodeTransform& from, const NodeTransform& to, float alpha) {
+    NodeTransform blended;
+    blended.position = from.position + (to.position - from.position) * alpha;
+    blended.rotationAxis = to.rotationAxis;
+    blended.rotationAngle = from.rotationAngle + (to.rotationAngle - from.rotationAngle) * alpha;
+    blended.scale = from.scale + (to.scale - from.scale) * alpha;
+    return blended;
+}
+
+lov::Graphics::SceneGraph::SceneGraph():
+    m_levelStarts(1, 0),
+    m_sorted(true),
+    m_frame(0),
+    m_stats()
+{}
+
+lov::lov_uint lov::Graphics::SceneGraph::add(const NodeTransform& local, lov_uint parent) {
+    lov_uint id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else {
+        id = static_cast<lov_uint>(m_slots.size());
+        m_slots.push_back(None);
+    }
+
+    // Append it, which keeps each parent before its children, and leave sorting by depth to the next update
+    lov_uint slot = static_cast<lov_uint>(m_ids.size());
+    lov_uint parentSlot = parent == None ? None : m_slots[parent];
+    lov_uint depth = parent == None ? 0 : m_depths[parentSlot] + 1;
+
+    m_slots[id] = slot;
+    m_ids.push_back(id);
+    m_parents.push_back(parentSlot);
+    m_depths.push_back(depth);
+    m_locals.push_back(local);
+    m_worlds.push_back(Transform());
+    m_dirty.push_back(0);
+    m_updateFrames.push_back(0);
+
+    if (m_levelDirty.size() <= depth) {
+        m_levelDirty.resize(depth + 1, 0);
+    }
+
+    markDirty(slot);
+    m_sorted = false;
+    return id;
+}
+
+void lov::Graphics::SceneGraph::remove(lov_uint node) {
+    lov_uint first = m_slots[node];
+    lov_uint count = static_cast<lov_uint>(m_ids.size());
+
+    // Parents always come before their children, so one pass finds every descendant
+    std::vector<uint8_t> removed(count, 0);
+    removed[first] = 1;
+    for (lov_uint slot = first + 1; slot < count; slot++) {
+        removed[slot] = m_parents[slot] != None && removed[m_parents[slot]];
+    }
+
+    // Close the gaps, keeping the order
+    std::vector<lov_uint> moved(count, None);
+    lov_uint kept = first;
+    for (lov_uint slot = first; slot < count; slot++) {
+        if (removed[slot]) {
+            if (m_dirty[slot]) {
+                m_levelDirty[m_depths[slot]]--;
+            }
+
+            m_slots[m_ids[slot]] = None;
+            m_freeIds.push_back(m_ids[slot]);
+            continue;
+        }
+
+        moved[slot] = kept;
+        m_ids[kept] = m_ids[slot];
+        m_parents[kept] = m_parents[slot] != None && m_parents[slot] >= first ? moved[m_parents[slot]] : m_parents[slot];
+        m_depths[kept] = m_depths[slot];
+        m_locals[kept] = m_locals[slot];
+        m_worlds[kept] = m_worlds[slot];
+        m_dirty[kept] = m_dirty[slot];
+        m_updateFrames[kept] = m_updateFrames[slot];
+        m_slots[m_ids[kept]] = kept;
+        kept++;
+    }
+
+    m_ids.resize(kept);
+    m_parents.resize(kept);
+    m_depths.resize(kept);
+    m_locals.resize(kept);
+    m_worlds.resize(kept);
+    m_dirty.resize(kept);
+    m_updateFrames.resize(kept);
+    m_sorted = false;
+}
+
+void lov::Graphics::SceneGraph::setLocal(lov_uint node, const NodeTransform& local) {
+    lov_uint slot = m_slots[node];
+    m_locals[slot] = local;
+    markDirty(slot);
+}
+
+const lov::Graphics::NodeTransform& lov::Graphics::SceneGraph::getLocal(lov_uint node) const {
+    return m_locals[m_slots[node]];
+}
+
+const lov::Graphics::Transform& lov::Graphics::SceneGraph::getWorld(lov_uint node) const {
+    return m_worlds[m_slots[node]];
+}
+
+lov::lov_uint lov::Graphics::SceneGraph::getParent(lov_uint node) const {
+    lov_uint parent = m_parents[m_slots[node]];
+    return parent == None ? None : m_ids[parent];
+}
+
+void lov::Graphics::SceneGraph::update(System::JobSystem* jobs) {
+    if (!m_sorted) {
+        sort();
+    }
+
+    // Nodes recomputed this update are stamped with its number, so nothing needs clearing between updates
+    m_frame++;
+    m_stats.nodes = static_cast<lov_uint>(m_ids.size());
+    m_stats.levels = static_cast<lov_uint>(m_levelStarts.size()) - 1;
+    m_stats.updated = 0;
+
+    bool parentsChanged = false;
+    for (lov_uint level = 0; level < m_stats.levels; level++) {
+        // Nothing in this level changed, and nothing above it did either
+        if (!parentsChanged && m_levelDirty[level] == 0) {
+            continue;
+        }
+
+        lov_uint begin = m_levelStarts[level];
+        lov_uint end = m_levelStarts[level + 1];
+        lov_uint updated = 0;
+
+        if (jobs && end - begin >= parallelLevelSize) {
+            std::atomic<lov_uint> levelUpdated = 0;
+            jobs->parallelFor(static_cast<lov_size>(end - begin), [&](lov_size rangeBegin, lov_size rangeEnd) {
+                levelUpdated += sweep(begin + static_cast<lov_uint>(rangeBegin), begin + static_cast<lov_uint>(rangeEnd));
+            });
+            updated = levelUpdated;
+        }
+        else {
+            updated = sweep(begin, end);
+        }
+
+        m_levelDirty[level] = 0;
+        m_stats.updated += updated;
+        parentsChanged = updated > 0;
+    }
+}
+
+lov::Graphics::SceneGraphStats lov::Graphics::SceneGraph::getStats() const {
+    return m_stats;
+}
+
+void lov::Graphics::SceneGraph::sort() {
+    lov_uint count = static_cast<lov_uint>(m_ids.size());
+    lov_uint levels = 0;
+    for (lov_uint depth : m_depths) {
+        levels = std::max(levels, depth + 1);
+    }
+
+    // Count the nodes of each level, then place them stably, which keeps parents before children
+    m_levelStarts.assign(levels + 1, 0);
+    for (lov_uint depth : m_depths) {
+        m_levelStarts[depth + 1]++;
+    }
+
+    for (lov_uint level = 0; level < levels; level++) {
+        m_levelStarts[level + 1] += m_levelStarts[level];
+    }
+
+    std::vector<lov_uint> moved(count);
+    std::vector<lov_uint> next(m_levelStarts.begin(), m_levelStarts.end() - 1);
+    for (lov_uint slot = 0; slot < count; slot++) {
+        moved[slot] = next[m_depths[slot]]++;
+    }
+
+    std::vector<lov_uint> ids(count), parents(count), depths(count);
+    std::vector<NodeTransform> locals(count);
+    std::vector<Transform> worlds(count);
+    std::vector<uint8_t> dirty(count);
+    std::vector<uint32_t> updateFrames(count);
+
+    for (lov_uint slot = 0; slot < count; slot++) {
+        lov_uint to = moved[slot];
+        ids[to] = m_ids[slot];
+        parents[to] = m_parents[slot] == None ? None : moved[m_parents[slot]];
+        depths[to] = m_depths[slot];
+        locals[to] = m_locals[slot];
+        worlds[to] = m_worlds[slot];
+        dirty[to] = m_dirty[slot];
+        updateFrames[to] = m_updateFrames[slot];
+        m_slots[ids[to]] = to;
+    }
+
+    m_ids = std::move(ids);
+    m_parents = std::move(parents);
+    m_depths = std::move(depths);
+    m_locals = std::move(locals);
+    m_worlds = std::move(worlds);
+    m_dirty = std::move(dirty);
+    m_updateFrames = std::move(updateFrames);
+    m_levelDirty.resize(levels, 0);
+    m_sorted = true;
+}
+
+lov::lov_uint lov::Graphics::SceneGraph::sweep(lov_uint begin, lov_uint end) {
+    lov_uint updated = 0;
+
+    for (lov_uint slot = begin; slot < end; slot++) {
+        lov_uint parent = m_parents[slot];
+        bool parentChanged = parent != None && m_updateFrames[parent] == m_frame;
+
+        if (m_dirty[slot] || parentChanged) {
+            Transform local = m_locals[slot].toTransform();
+            m_worlds[slot] = parent == None ? local : m_worlds[parent] * local;
+            m_updateFrames[slot] = m_frame;
+            m_dirty[slot] = 0;
+            updated++;
+        }
+    }
+
+    return updated;
+}
+
+void lov::Graphics::SceneGraph::markDirty(lov_uint slot) {
+    if (!m_dirty[slot]) {
+        m_dirty[slot] = 1;
+        m_levelDirty[m_depths[slot]]++;
+    }
+}
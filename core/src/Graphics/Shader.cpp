@@ -5,8 +5,13 @@
 #include <sstream>
 #include <string>
 
+#include "Graphics/GLExtensions.h"
 #include "System/Exceptions.h"
 
+lov::Graphics::Shader::Shader():
+    m_id(0)
+{}
+
 lov::Graphics::Shader::~Shader() {
     // Delete the OpenGL shader program
     glDeleteProgram(m_id);
@@ -23,6 +28,10 @@ void lov::Graphics::Shader::unbind() const {
 }
 
 void lov::Graphics::Shader::compileFromText(const char* vertexShaderSource, const char* fragmentShaderSource) {
+    compile(vertexShaderSource, -1, fragmentShaderSource, -1);
+}
+
+void lov::Graphics::Shader::compile(const char* vertexShaderSource, int vertexShaderLength, const char* fragmentShaderSource, int fragmentShaderLength) {
     // Variables used to track compile status
     int compileSuccess;
     char compileInfoLog[512];
@@ -33,7 +42,7 @@ void lov::Graphics::Shader::compileFromText(const char* vertexShaderSource, cons
 
     // Compile the vertex shader
     unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
+    glShaderSource(vertexShader, 1, &vertexShaderSource, vertexShaderLength < 0 ? NULL : &vertexShaderLength);
     glCompileShader(vertexShader);
 
     // Check vertex shader status
@@ -45,7 +54,7 @@ void lov::Graphics::Shader::compileFromText(const char* vertexShaderSource, cons
 
     // Compile the fragment shader
     unsigned int fragShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragShader, 1, &fragmentShaderSource, NULL);
+    glShaderSource(fragShader, 1, &fragmentShaderSource, fragmentShaderLength < 0 ? NULL : &fragmentShaderLength);
     glCompileShader(fragShader);
 
     // Check fragment shader status
@@ -95,6 +104,61 @@ void lov::Graphics::Shader::compileFromFiles(const std::string& vertexShaderPath
     compileFromText(vertexShaderSource.c_str(), fragmentShaderSource.c_str());
 }
 
+void lov::Graphics::Shader::compileFromMemory(std::span<const std::byte> vertexShaderSource, std::span<const std::byte> fragmentShaderSource) {
+    // Pass the lengths, so the views are compiled in place without copying them to add terminators
+    compile(reinterpret_cast<const char*>(vertexShaderSource.data()), static_cast<int>(vertexShaderSource.size()),
+        reinterpret_cast<const char*>(fragmentShaderSource.data()), static_cast<int>(fragmentShaderSource.size()));
+}
+
+void lov::Graphics::Shader::compileComputeFromText(const char* computeShaderSource) {
+    // Variables used to track compile status
+    int compileSuccess;
+    char compileInfoLog[512];
+
+    // Variables used to track link status
+    int linkSuccess;
+    char linkInfoLog[512];
+
+    // Compile the compute shader
+    unsigned int computeShader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(computeShader, 1, &computeShaderSource, NULL);
+    glCompileShader(computeShader);
+
+    // Check compute shader status
+    glGetShaderiv(computeShader, GL_COMPILE_STATUS, &compileSuccess);
+    if (!compileSuccess) {
+        glGetShaderInfoLog(computeShader, 512, NULL, compileInfoLog);
+        throw lov::Exceptions::ShaderException("Exception while compiling compute shader: " + std::string(compileInfoLog));
+    }
+
+    // Link the shader program
+    m_id = glCreateProgram();
+    glAttachShader(m_id, computeShader);
+    glLinkProgram(m_id);
+
+    // Check link status
+    glGetProgramiv(m_id, GL_LINK_STATUS, &linkSuccess);
+    if (!linkSuccess) {
+        glGetProgramInfoLog(m_id, 512, NULL, linkInfoLog);
+        throw lov::Exceptions::ShaderException("Exception while linking compute program: " + std::string(linkInfoLog));
+    }
+
+    // Cleanup
+    glDeleteShader(computeShader);
+}
+
+void lov::Graphics::Shader::compileComputeFromFile(const std::string& computeShaderPath) {
+    // Read the contents of the file
+    std::ifstream computeShaderFile(computeShaderPath);
+    std::stringstream computeShaderStream;
+    computeShaderStream << computeShaderFile.rdbuf();
+    computeShaderFile.close();
+
+    // Compile the shader
+    std::string computeShaderSource = computeShaderStream.str();
+    compileComputeFromText(computeShaderSource.c_str());
+}
+
 void lov::Graphics::Shader::setUniform(const std::string& name, bool value) {
     glUniform1i(glGetUniformLocation(m_id, name.c_str()), value);
 }
@@ -111,6 +175,22 @@ void lov::Graphics::Shader::setUniform(const std::string& name, const Vector3f&
     glUniform3fv(glGetUniformLocation(m_id, name.c_str()), 1, &value[0]);
 }
 
+void lov::Graphics::Shader::setUniform(const std::string& name, const Vector4f& value) {
+    glUniform4fv(glGetUniformLocation(m_id, name.c_str()), 1, &value[0]);
+}
+
 void lov::Graphics::Shader::setUniform(const std::string& name, const Transform& value) {
     glUniformMatrix4fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE, &value[0][0]);
 }
+
+void lov::Graphics::Shader::bindUniformBlock(const std::string& name, lov_uint binding) {
+    lov_uint index = glGetUniformBlockIndex(m_id, name.c_str());
+
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_id, index, binding);
+    }
+}
+
+lov::lov_uint lov::Graphics::Shader::getID() const {
+    return m_id;
+}
@@ -0,0 +1,36 @@
+#include "Graphics/ShaderStorageBuffer.h"
+
+lov::Graphics::ShaderStorageBuffer::ShaderStorageBuffer():
+    m_size(0)
+{
+    // Generate the OpenGL buffer
+    glGenBuffers(1, &m_id);
+}
+
+lov::Graphics::ShaderStorageBuffer::~ShaderStorageBuffer() {
+    // Delete the OpenGL buffer
+    glDeleteBuffers(1, &m_id);
+}
+
+void lov::Graphics::ShaderStorageBuffer::bind() const {
+    // Bind this buffer
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+}
+
+void lov::Graphics::ShaderStorageBuffer::unbind() const {
+    // Unbind this buffer
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void lov::Graphics::ShaderStorageBuffer::bindBase(lov_uint index) const {
+    // Bind this buffer to an indexed binding point
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_id);
+}
+
+lov::lov_size lov::Graphics::ShaderStorageBuffer::getSize() const {
+    return m_size;
+}
+
+lov::lov_uint lov::Graphics::ShaderStorageBuffer::getID() const {
+    return m_id;
+}
@@ -0,0 +1,252 @@
+#include "Graphics/StaticBatcher.h"
+
+#include <glad/glad.h>
+
+#include <cmath>
+#include <cstddef>
+
+namespace {
+    /// @brief Get the per-vertex attributes of a material
+    lov::Graphics::MaterialVertex toMaterialVertex(const lov::Graphics::Material& material) {
+        return { material.diffuseLayer, material.specularLayer, material.shininess };
+    }
+
+    /// @brief Transform a model space normal into world space using the cofactor of the model's upper 3x3
+    lov::Vector3f transformNormal(const lov::Graphics::Transform& model, const lov::Vector3f& normal) {
+        lov::Vector3f a(model.x.x, model.x.y, model.x.z);
+        lov::Vector3f b(model.y.x, model.y.y, model.y.z);
+        lov::Vector3f c(model.z.x, model.z.y, model.z.z);
+
+        // The cofactor matrix equals the inverse transpose scaled by the determinant
+        lov::Vector3f bc = lov::Vector::cross(b, c);
+        lov::Vector3f ca = lov::Vector::cross(c, a);
+        lov::Vector3f ab = lov::Vector::cross(a, b);
+        float sign = lov::Vector::dot(a, bc) < 0.0f ? -1.0f : 1.0f;
+
+        lov::Vector3f result = (bc * normal.x + ca * normal.y + ab * normal.z) * sign;
+        float length = lov::Vector::length(result);
+        return length > 0.0f ? result / length : normal;
+    }
+}
+
+lov::lov_uint lov::Graphics::StaticBatcher::add(const MeshData& mesh, const Material& material, const Transform& model) {
+    m_instances.push_back({ &mesh, material, model });
+    return static_cast<lov_uint>(m_instances.size() - 1);
+}
+
+std::vector<lov::Graphics::StaticBatchData> lov::Graphics::StaticBatcher::bake() const {
+    std::vector<StaticBatchData> batches;
+
+    // Assign each object to the batch of its material's texture array. Layers and shininess vary per vertex instead
+    std::vector<size_t> batchOf(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        size_t batch = 0;
+        while (batch < batches.size() && batches[batch].textureArrayID != m_instances[i].material.textureArrayID) {
+            batch++;
+        }
+
+        if (batch == batches.size()) {
+            batches.push_back({});
+            batches.back().textureArrayID = m_instances[i].material.textureArrayID;
+        }
+
+        batchOf[i] = batch;
+    }
+
+    // Reserve exact storage so each batch allocates once
+    std::vector<size_t> vertexTotals(batches.size(), 0);
+    std::vector<size_t> indexTotals(batches.size(), 0);
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        vertexTotals[batchOf[i]] += m_instances[i].mesh->vertices.size();
+        indexTotals[batchOf[i]] += m_instances[i].mesh->indices.size();
+    }
+
+    for (size_t batch = 0; batch < batches.size(); batch++) {
+        batches[batch].vertices.reserve(vertexTotals[batch]);
+        batches[batch].materials.reserve(vertexTotals[batch]);
+        batches[batch].indices.reserve(indexTotals[batch]);
+    }
+
+    // Bake each object into its batch
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        const Instance& instance = m_instances[i];
+        StaticBatchData& batch = batches[batchOf[i]];
+
+        StaticBatchRange range;
+        range.objectID = static_cast<lov_uint>(i);
+        range.firstIndex = static_cast<lov_uint>(batch.indices.size());
+        range.indexCount = static_cast<lov_uint>(instance.mesh->indices.size());
+
+        lov_uint baseVertex = static_cast<lov_uint>(batch.vertices.size());
+        batch.materials.insert(batch.materials.end(), instance.mesh->vertices.size(), toMaterialVertex(instance.material));
+
+        for (const Vertex& vertex : instance.mesh->vertices) {
+            Vector4f position = instance.model * Vector4f(vertex.position.x, vertex.position.y, vertex.position.z, 1.0f);
+
+            Vertex baked;
+            baked.position = { position.x, position.y, position.z };
+            baked.normal = transformNormal(instance.model, vertex.normal);
+            baked.texCoords = vertex.texCoords;
+
+            range.bounds.expand(baked.position);
+            batch.vertices.push_back(baked);
+        }
+
+        for (lov_uint index : instance.mesh->indices) {
+            batch.indices.push_back(baseVertex + index);
+        }
+
+        batch.bounds.expand(range.bounds);
+        batch.ranges.push_back(range);
+    }
+
+    return batches;
+}
+
+void lov::Graphics::StaticBatcher::clear() {
+    m_instances.clear();
+}
+
+lov::lov_size lov::Graphics::StaticBatcher::getObjectCount() const {
+    return static_cast<lov_size>(m_instances.size());
+}
+
+lov::Graphics::StaticBatch::StaticBatch(const StaticBatchData& data):
+    m_textureArrayID(data.textureArrayID),
+    m_ranges(data.ranges),
+    m_bounds(data.bounds),
+    m_indexCount(static_cast<lov_size>(data.indices.size()))
+{
+    // Upload the baked geometry
+    m_vao.bind();
+
+    m_vbo.bind();
+    m_vbo.bufferData(data.vertices.data(), static_cast<lov_size>(data.vertices.size() * sizeof(Vertex)));
+
+    m_ebo.bind();
+    m_ebo.bufferIndices(data.indices.data(), static_cast<lov_size>(data.indices.size() * sizeof(lov_uint)));
+
+    m_vao.linkAttribute(0, 3, LOV_FLOAT, sizeof(Vertex), offsetof(Vertex, position));
+    m_vao.linkAttribute(1, 3, LOV_FLOAT, sizeof(Vertex), offsetof(Vertex, normal));
+    m_vao.linkAttribute(2, 2, LOV_FLOAT, sizeof(Vertex), offsetof(Vertex, texCoords));
+
+    // Materials come from a second buffer so the vertex layout stays the one every mesh uses
+    m_materialVbo.bind();
+    m_materialVbo.bufferData(data.materials.data(), static_cast<lov_size>(data.materials.size() * sizeof(MaterialVertex)));
+
+    m_vao.linkIntegerAttribute(4, 2, LOV_INT, sizeof(MaterialVertex), offsetof(MaterialVertex, diffuseLayer));
+    m_vao.linkAttribute(5, 1, LOV_FLOAT, sizeof(MaterialVertex), offsetof(MaterialVertex, shininess));
+
+    m_vao.unbind();
+
+    m_drawCounts.reserve(m_ranges.size());
+    m_drawOffsets.reserve(m_ranges.size());
+}
+
+void lov::Graphics::StaticBatch::draw() const {
+    m_vao.bind();
+    glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
+}
+
+lov::lov_size lov::Graphics::StaticBatch::draw(const Frustum& frustum) const {
+    if (!frustum.intersects(m_bounds)) {
+        return 0;
+    }
+
+    m_drawCounts.clear();
+    m_drawOffsets.clear();
+    lov_size drawn = 0;
+    lov_uint runEnd = 0;
+
+    // Merge visible objects that are adjacent in the index buffer into one range
+    for (const StaticBatchRange& range : m_ranges) {
+        if (!frustum.intersects(range.bounds)) {
+            continue;
+        }
+
+        if (!m_drawCounts.empty() && runEnd == range.firstIndex) {
+            m_drawCounts.back() += range.indexCount;
+        }
+        else {
+            m_drawCounts.push_back(range.indexCount);
+            m_drawOffsets.push_back(reinterpret_cast<const void*>(static_cast<size_t>(range.firstIndex) * sizeof(lov_uint)));
+        }
+
+        runEnd = range.firstIndex + range.indexCount;
+        drawn++;
+    }
+
+    if (m_drawCounts.empty()) {
+        return 0;
+    }
+
+    m_vao.bind();
+
+    if (m_drawCounts.size() == 1) {
+        glDrawElements(GL_TRIANGLES, m_drawCounts[0], GL_UNSIGNED_INT, m_drawOffsets[0]);
+    }
+    else {
+        glMultiDrawElements(GL_TRIANGLES, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(), static_cast<lov_size>(m_drawCounts.size()));
+    }
+
+    return drawn;
+}
+
+lov::lov_size lov::Graphics::StaticBatch::record(const Frustum& frustum, DrawIndirectBuffer& commands) const {
+    m_recorded.clear();
+    lov_size recorded = record(frustum, m_recorded);
+    commands.add(m_recorded);
+    return recorded;
+}
+
+lov::lov_size lov::Graphics::StaticBatch::record(const Frustum& frustum, std::vector<DrawElementsIndirectCommand>& commands) const {
+    if (!frustum.intersects(m_bounds)) {
+        return 0;
+    }
+
+    lov_size recorded = 0;
+    lov_uint runEnd = 0;
+    DrawElementsIndirectCommand run = { 0, 1, 0, 0, 0 };
+
+    // Merge visible objects that are adjacent in the index buffer into one command
+    for (const StaticBatchRange& range : m_ranges) {
+        if (!frustum.intersects(range.bounds)) {
+            continue;
+        }
+
+        if (run.count > 0 && runEnd != range.firstIndex) {
+            commands.push_back(run);
+            run.count = 0;
+        }
+
+        if (run.count == 0) {
+            run.firstIndex = range.firstIndex;
+        }
+
+        run.count += range.indexCount;
+        runEnd = range.firstIndex + range.indexCount;
+        recorded++;
+    }
+
+    if (run.count > 0) {
+        commands.push_back(run);
+    }
+
+    return recorded;
+}
+
+void lov::Graphics::StaticBatch::bind() const {
+    m_vao.bind();
+}
+
+lov::lov_uint lov::Graphics::StaticBatch::getTextureArrayID() const {
+    return m_textureArrayID;
+}
+
+const std::vector<lov::Graphics::StaticBatchRange>& lov::Graphics::StaticBatch::getRanges() const {
+    return m_ranges;
+}
+
+const lov::Graphics::BoundingBox& lov::Graphics::StaticBatch::getBounds() const {
+    return m_bounds;
+}
@@ -1,42 +1,175 @@
 #include "Graphics/Texture.h"
 
+#include "Graphics/GLExtensions.h"
+#include "Graphics/Ktx2Image.h"
+#include "System/Exceptions.h"
+
 #include <stb_image.h>
 
-lov::Graphics::Texture::Texture(const char* path) {
-    // Generate the texture
-    glGenTextures(1, &m_id);
-    glBindTexture(GL_TEXTURE_2D, m_id);
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
-    // Set texture wrapping and filtering options
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    stbi_set_flip_vertically_on_load(true);
+namespace {
+    /// @brief Get the pixel format uploads to an uncompressed internal format use
+    /// @param internalFormat The sized internal format
+    /// @return GL_RED, GL_RG or GL_RGBA
+    GLenum pixelFormatOf(lov::lov_uint internalFormat) {
+        switch (internalFormat) {
+        case GL_R8:
+            return GL_RED;
+        case GL_RG8:
+            return GL_RG;
+        default:
+            return GL_RGBA;
+        }
+    }
 
-    // Load the texture
-    int width, height, numChannels;
-    unsigned char* data = stbi_load(path, &width, &height, &numChannels, 0);
-    GLenum format = numChannels < 4 ? GL_RGB : GL_RGBA;
+    /// @brief Get the bytes per pixel of an uncompressed internal format
+    /// @param internalFormat The sized internal format
+    /// @return 1, 2 or 4
+    lov::lov_int bytesPerPixelOf(lov::lov_uint internalFormat) {
+        switch (internalFormat) {
+        case GL_R8:
+            return 1;
+        case GL_RG8:
+            return 2;
+        default:
+            return 4;
+        }
+    }
 
-    if (numChannels < 4) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    /// @brief Is an internal format one of the sized uncompressed formats of #lov::Graphics::TextureFormat?
+    /// @param internalFormat The internal format
+    /// @return Whether uploads take pixels rather than compressed blocks
+    bool isUncompressed(lov::lov_uint internalFormat) {
+        return internalFormat == GL_R8 || internalFormat == GL_RG8 || internalFormat == GL_RGBA8 || internalFormat == GL_SRGB8_ALPHA8;
     }
-    else {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+}
+
+lov::lov_int lov::Graphics::TextureDesc::getLevelCount() const {
+    if (levels > 0) {
+        return levels;
     }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // Count the halvings of the larger side down to 1
+    lov_int count = 1;
+    for (lov_int size = std::max(width, height); size > 1; size /= 2) {
+        count++;
+    }
 
-    // Free memory and unbind
-    stbi_image_free(data);
+    return count;
+}
+
+lov::lov_int lov::Graphics::TextureDesc::getChannels() const {
+    return bytesPerPixelOf(static_cast<lov_uint>(format));
+}
+
+lov::lov_uint lov::Graphics::TextureDesc::getPixelFormat() const {
+    return pixelFormatOf(static_cast<lov_uint>(format));
+}
+
+lov::Graphics::TextureDesc lov::Graphics::TextureDesc::forImage(lov_int width, lov_int height, lov_int channels, bool srgb) {
+    TextureDesc desc;
+    desc.width = width;
+    desc.height = height;
+
+    // Pad RGB to RGBA rather than uploading 3 byte pixels the driver would convert anyway
+    switch (channels) {
+    case 1:
+        desc.format = TextureFormat::R8;
+        break;
+    case 2:
+        desc.format = TextureFormat::RG8;
+        break;
+    default:
+        desc.format = srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8;
+        break;
+    }
+
+    return desc;
+}
+
+lov::Graphics::Texture::Texture(const char* path):
+    m_ready(true),
+    m_internalFormat(0),
+    m_width(0),
+    m_height(0),
+    m_levels(0),
+    m_sampler(SamplerCache::get(SamplerDesc()))
+{
+    // Read the file
+    std::ifstream file(path, std::ios::binary);
+    std::vector<unsigned char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    load(contents.data(), contents.size(), path);
+}
+
+lov::Graphics::Texture::Texture(std::span<const std::byte> contents):
+    m_ready(true),
+    m_internalFormat(0),
+    m_width(0),
+    m_height(0),
+    m_levels(0),
+    m_sampler(SamplerCache::get(SamplerDesc()))
+{
+    load(reinterpret_cast<const unsigned char*>(contents.data()), contents.size(), "from memory");
+}
+
+lov::Graphics::Texture::Texture(const TextureDesc& desc):
+    m_ready(true),
+    m_internalFormat(static_cast<lov_uint>(desc.format)),
+    m_width(desc.width),
+    m_height(desc.height),
+    m_levels(desc.getLevelCount()),
+    m_sampler(SamplerCache::get(desc.sampler))
+{
+    // Generate the texture and its storage, leaving the contents undefined until uploaded
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    allocate(m_internalFormat, m_width, m_height, m_levels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+lov::Graphics::Texture::Texture(lov_uint placeholderID):
+    m_id(placeholderID),
+    m_ready(false),
+    m_internalFormat(0),
+    m_width(0),
+    m_height(0),
+    m_levels(0),
+    m_sampler(SamplerCache::get(SamplerDesc()))
+{}
+
+lov::Graphics::Texture::~Texture() {
+    // Delete the OpenGL texture, which is only owned once loaded
+    if (m_ready) {
+        glDeleteTextures(1, &m_id);
+    }
+}
+
+void lov::Graphics::Texture::upload(lov_int level, const void* pixels) {
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    uploadLevel(m_internalFormat, level, std::max(m_width >> level, 1), std::max(m_height >> level, 1), pixels, 0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+void lov::Graphics::Texture::generateMipmaps() {
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void lov::Graphics::Texture::setSampler(const SamplerDesc& sampler) {
+    m_sampler = SamplerCache::get(sampler);
+}
+
 void lov::Graphics::Texture::bind(lov_uint unit) const {
-    // Bind this texture
+    // Bind this texture and the sampler that filters it
     glActiveTexture(GL_TEXTURE0 + unit);
     glBindTexture(GL_TEXTURE_2D, m_id);
+    glBindSampler(unit, m_sampler);
 }
 
 void lov::Graphics::Texture::unbind() const {
@@ -47,3 +180,143 @@ void lov::Graphics::Texture::unbind() const {
 lov::lov_uint lov::Graphics::Texture::getID() const {
     return m_id;
 }
+
+lov::lov_uint lov::Graphics::Texture::getInternalFormat() const {
+    return m_internalFormat;
+}
+
+lov::lov_int lov::Graphics::Texture::getWidth() const {
+    return m_width;
+}
+
+lov::lov_int lov::Graphics::Texture::getHeight() const {
+    return m_height;
+}
+
+lov::lov_int lov::Graphics::Texture::getLevelCount() const {
+    return m_levels;
+}
+
+bool lov::Graphics::Texture::isReady() const {
+    return m_ready;
+}
+
+void lov::Graphics::Texture::load(const unsigned char* data, size_t size, const std::string& name) {
+    // Generate the texture
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+
+    // Baked textures are already flipped and mipmapped, so upload their blocks as they are
+    if (Ktx2Image::isKtx2(data, size)) {
+        try {
+            uploadCompressed(Ktx2Image::read(data, size));
+        }
+        catch (const Exceptions::TextureException&) {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDeleteTextures(1, &m_id);
+            throw;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    // Load the texture, padding RGB to RGBA to match its storage
+    int width = 0, height = 0, numChannels = 0;
+    stbi_info_from_memory(data, static_cast<int>(size), &width, &height, &numChannels);
+    unsigned char* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &numChannels, numChannels == 3 ? 4 : 0);
+    if (!pixels) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &m_id);
+        throw Exceptions::TextureException(std::string("Failed to load texture ") + name + ": " + stbi_failure_reason());
+    }
+
+    TextureDesc desc = TextureDesc::forImage(width, height, numChannels);
+    m_internalFormat = static_cast<lov_uint>(desc.format);
+    m_width = width;
+    m_height = height;
+    m_levels = desc.getLevelCount();
+
+    allocate(m_internalFormat, m_width, m_height, m_levels);
+    swizzleGrey(numChannels);
+    uploadLevel(m_internalFormat, 0, m_width, m_height, pixels, 0);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    // Free memory and unbind
+    stbi_image_free(pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void lov::Graphics::Texture::uploadCompressed(const Ktx2Image& image) {
+    GLenum format = image.getGLFormat();
+    if (!GLExtensions::hasCompressedFormat(format)) {
+        throw Exceptions::TextureException("The OpenGL context can't sample KTX2 format " + std::to_string(image.getFormat()));
+    }
+
+    m_internalFormat = format;
+    m_width = image.getWidth();
+    m_height = image.getHeight();
+    m_levels = static_cast<lov_int>(image.getLevelCount());
+
+    // Upload every baked level of the bound texture
+    allocate(format, m_width, m_height, m_levels);
+    for (lov_int level = 0; level < m_levels; level++) {
+        const std::vector<unsigned char>& blocks = image.getLevel(level);
+        uploadLevel(format, level, std::max(m_width >> level, 1), std::max(m_height >> level, 1), blocks.data(), static_cast<lov_size>(blocks.size()));
+    }
+}
+
+void lov::Graphics::Texture::allocate(lov_uint internalFormat, lov_int width, lov_int height, lov_int levels) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+    if (GLExtensions::hasTextureStorage()) {
+        glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+        return;
+    }
+
+    // Without immutable storage, define uncompressed levels up front so every level exists. Compressed levels are defined as they're uploaded
+    if (isUncompressed(internalFormat)) {
+        GLenum format = pixelFormatOf(internalFormat);
+        for (lov_int level = 0; level < levels; level++) {
+            glTexImage2D(GL_TEXTURE_2D, level, internalFormat, std::max(width >> level, 1), std::max(height >> level, 1), 0, format, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+}
+
+void lov::Graphics::Texture::uploadLevel(lov_uint internalFormat, lov_int level, lov_int width, lov_int height, const void* data, lov_size compressedSize) {
+    if (!isUncompressed(internalFormat)) {
+        if (GLExtensions::hasTextureStorage()) {
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, internalFormat, compressedSize, data);
+        }
+        else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, compressedSize, data);
+        }
+
+        return;
+    }
+
+    // Rows are tightly packed, which only breaks the default 4 byte alignment for odd widths of one and two channel images
+    bool aligned = (width * bytesPerPixelOf(internalFormat)) % 4 == 0;
+    if (!aligned) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, pixelFormatOf(internalFormat), GL_UNSIGNED_BYTE, data);
+
+    if (!aligned) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+}
+
+void lov::Graphics::Texture::swizzleGrey(lov_int channels) {
+    if (channels == 1) {
+        const GLint swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    else if (channels == 2) {
+        const GLint swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_GREEN };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+}
@@ -0,0 +1,133 @@
+#include "Graphics/TextureArray.h"
+
+#include "Graphics/GLExtensions.h"
+#include "System/Exceptions.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <string>
+
+lov::Graphics::TextureArray::TextureArray(const TextureDesc& desc, lov_int layers):
+    m_desc(desc),
+    m_layers(layers),
+    m_sampler(SamplerCache::get(desc.sampler))
+{
+    m_desc.levels = desc.getLevelCount();
+
+    // Generate the texture and its storage, leaving the contents undefined until uploaded
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, m_desc.levels - 1);
+
+    lov_uint internalFormat = static_cast<lov_uint>(m_desc.format);
+    if (GLExtensions::hasTextureStorage()) {
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_desc.levels, internalFormat, m_desc.width, m_desc.height, m_layers);
+    }
+    else {
+        for (lov_int level = 0; level < m_desc.levels; level++) {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, std::max(m_desc.width >> level, 1), std::max(m_desc.height >> level, 1), m_layers, 0,
+                m_desc.getPixelFormat(), GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+lov::Graphics::TextureArray::~TextureArray() {
+    glDeleteTextures(1, &m_id);
+}
+
+void lov::Graphics::TextureArray::upload(lov_int layer, lov_int level, const void* pixels) {
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    uploadRect(layer, level, { 0, 0, std::max(m_desc.width >> level, 1), std::max(m_desc.height >> level, 1) }, pixels);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void lov::Graphics::TextureArray::upload(lov_int layer, const AtlasRect& rect, const void* pixels) {
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    uploadRect(layer, 0, rect, pixels);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void lov::Graphics::TextureArray::loadLayer(lov_int layer, const char* path) {
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    // Let stb_image convert to this array's channels, so any image of the right size fits
+    int width = 0, height = 0, channels = 0;
+    loadDecoded(layer, stbi_load(path, &width, &height, &channels, m_desc.getChannels()), width, height, path);
+}
+
+void lov::Graphics::TextureArray::loadLayer(lov_int layer, std::span<const std::byte> contents) {
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    // Decode straight from the caller's memory, converting to this array's channels
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load_from_memory(reinterpret_cast<const unsigned char*>(contents.data()), static_cast<int>(contents.size()),
+        &width, &height, &channels, m_desc.getChannels());
+    loadDecoded(layer, data, width, height, "from memory");
+}
+
+void lov::Graphics::TextureArray::generateMipmaps() {
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void lov::Graphics::TextureArray::setSampler(const SamplerDesc& sampler) {
+    m_desc.sampler = sampler;
+    m_sampler = SamplerCache::get(sampler);
+}
+
+void lov::Graphics::TextureArray::bind(lov_uint unit) const {
+    // Bind this texture and the sampler that filters it
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    glBindSampler(unit, m_sampler);
+}
+
+void lov::Graphics::TextureArray::unbind() const {
+    // Unbind this texture
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+lov::lov_uint lov::Graphics::TextureArray::getID() const {
+    return m_id;
+}
+
+const lov::Graphics::TextureDesc& lov::Graphics::TextureArray::getDesc() const {
+    return m_desc;
+}
+
+lov::lov_int lov::Graphics::TextureArray::getLayerCount() const {
+    return m_layers;
+}
+
+void lov::Graphics::TextureArray::loadDecoded(lov_int layer, unsigned char* data, int width, int height, const std::string& name) {
+    if (!data) {
+        throw Exceptions::TextureException("Failed to load texture " + name + ": " + stbi_failure_reason());
+    }
+
+    if (width != m_desc.width || height != m_desc.height) {
+        stbi_image_free(data);
+        throw Exceptions::TextureException("Texture " + name + " is " + std::to_string(width) + "x" + std::to_string(height) +
+            " but the array's layers are " + std::to_string(m_desc.width) + "x" + std::to_string(m_desc.height));
+    }
+
+    upload(layer, 0, data);
+    stbi_image_free(data);
+}
+
+void lov::Graphics::TextureArray::uploadRect(lov_int layer, lov_int level, const AtlasRect& rect, const void* pixels) {
+    // Rows are tightly packed, which only breaks the default 4 byte alignment for odd widths of one and two channel images
+    bool aligned = (rect.width * m_desc.getChannels()) % 4 == 0;
+    if (!aligned) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    }
+
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, rect.x, rect.y, layer, rect.width, rect.height, 1, m_desc.getPixelFormat(), GL_UNSIGNED_BYTE, pixels);
+
+    if (!aligned) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+}
@@ -0,0 +1,68 @@
+#include "Graphics/TextureAtlas.h"
+
+#include "System/Exceptions.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+lov::Graphics::TextureAtlas::TextureAtlas(const TextureDesc& pageDesc, lov_int pageCount, lov_int padding):
+    m_pages(pageDesc, pageCount),
+    m_packers(pageCount, AtlasPacker(pageDesc.width, pageDesc.height, padding))
+{}
+
+bool lov::Graphics::TextureAtlas::add(lov_int width, lov_int height, const void* pixels, AtlasRegion& region) {
+    // Use the first page with room
+    AtlasRect rect;
+    lov_int page = 0;
+    while (page < static_cast<lov_int>(m_packers.size()) && !m_packers[page].pack(width, height, rect)) {
+        page++;
+    }
+
+    if (page == static_cast<lov_int>(m_packers.size())) {
+        return false;
+    }
+
+    // Repeat the edge texels out into the padding so filtering at the border samples this image only
+    lov_int padding = m_packers[page].getPadding();
+    lov_int channels = m_pages.getDesc().getChannels();
+    lov_int paddedWidth = width + padding * 2;
+    lov_int paddedHeight = height + padding * 2;
+    const unsigned char* source = static_cast<const unsigned char*>(pixels);
+    std::vector<unsigned char> padded(static_cast<size_t>(paddedWidth) * paddedHeight * channels);
+    for (lov_int y = 0; y < paddedHeight; y++) {
+        lov_int sy = std::clamp(y - padding, 0, height - 1);
+        for (lov_int x = 0; x < paddedWidth; x++) {
+            lov_int sx = std::clamp(x - padding, 0, width - 1);
+            memcpy(&padded[(static_cast<size_t>(y) * paddedWidth + x) * channels], &source[(static_cast<size_t>(sy) * width + sx) * channels], channels);
+        }
+    }
+
+    m_pages.upload(page, { rect.x - padding, rect.y - padding, paddedWidth, paddedHeight }, padded.data());
+    region = AtlasRegion::fromRect(rect, m_pages.getDesc().width, m_pages.getDesc().height, page);
+    return true;
+}
+
+bool lov::Graphics::TextureAtlas::addFile(const char* path, AtlasRegion& region) {
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(path, &width, &height, &channels, m_pages.getDesc().getChannels());
+    if (!data) {
+        throw Exceptions::TextureException(std::string("Failed to load texture ") + path + ": " + stbi_failure_reason());
+    }
+
+    bool added = add(width, height, data, region);
+    stbi_image_free(data);
+    return added;
+}
+
+void lov::Graphics::TextureAtlas::generateMipmaps() {
+    m_pages.generateMipmaps();
+}
+
+const lov::Graphics::TextureArray& lov::Graphics::TextureAtlas::getTexture() const {
+    return m_pages;
+}
@@ -0,0 +1,298 @@
+#include "Graphics/TextureLoader.h"
+
+#include "Graphics/GLExtensions.h"
+#include "Graphics/Ktx2Image.h"
+#include "System/Exceptions.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    /// @brief Bytes copied into a pixel buffer between checks of the time budget
+    const lov::lov_size COPY_CHUNK_SIZE = 256 * 1024;
+}
+
+lov::Graphics::TextureLoader::TextureLoader(System::ThreadPool& pool, lov_size pixelBufferCount):
+    m_pool(pool),
+    m_pixelBuffers(std::max(pixelBufferCount, 1), 0),
+    m_nextPixelBuffer(0),
+    m_mapped(nullptr),
+    m_bytesCopied(0),
+    m_uploadTexture(0),
+    m_uploadLevel(0)
+{
+    // Create a grey placeholder that loading textures bind in the meantime
+    const unsigned char grey[4] = { 128, 128, 128, 255 };
+    glGenTextures(1, &m_placeholder);
+    glBindTexture(GL_TEXTURE_2D, m_placeholder);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenBuffers(static_cast<lov_size>(m_pixelBuffers.size()), m_pixelBuffers.data());
+}
+
+lov::Graphics::TextureLoader::~TextureLoader() {
+    // Workers write into this object, so let them finish first
+    for (std::future<void>& decoding : m_decoding) {
+        decoding.wait();
+    }
+
+    if (m_mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffers[m_nextPixelBuffer]);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    if (m_uploadTexture != 0) {
+        glDeleteTextures(1, &m_uploadTexture);
+    }
+
+    glDeleteBuffers(static_cast<lov_size>(m_pixelBuffers.size()), m_pixelBuffers.data());
+    glDeleteTextures(1, &m_placeholder);
+}
+
+std::shared_ptr<lov::Graphics::Texture> lov::Graphics::TextureLoader::load(const std::string& path) {
+    std::shared_ptr<Texture> texture = createPlaceholder();
+    m_decoding.push_back(m_pool.submit([this, texture, path]() {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<unsigned char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        decode(texture, path, contents);
+    }));
+    return texture;
+}
+
+std::shared_ptr<lov::Graphics::Texture> lov::Graphics::TextureLoader::load(const std::string& path, std::vector<unsigned char> contents) {
+    std::shared_ptr<Texture> texture = createPlaceholder();
+    m_decoding.push_back(m_pool.submit([this, texture, path, contents = std::move(contents)]() { decode(texture, path, contents); }));
+    return texture;
+}
+
+std::shared_ptr<lov::Graphics::Texture> lov::Graphics::TextureLoader::createPlaceholder() const {
+    return std::shared_ptr<Texture>(new Texture(m_placeholder));
+}
+
+void lov::Graphics::TextureLoader::update(double budgetMilliseconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMilliseconds);
+
+    // Forget decodes that have queued their images
+    m_decoding.erase(std::remove_if(m_decoding.begin(), m_decoding.end(), [](const std::future<void>& decoding) {
+        return decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), m_decoding.end());
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (!m_upload && !beginUpload()) {
+            return;
+        }
+
+        // Copy the pixels a chunk at a time so a large image spreads over several frames, then upload one level per step
+        lov_size size = static_cast<lov_size>(m_upload->pixels.size());
+        if (m_bytesCopied < size) {
+            lov_size chunk = std::min(COPY_CHUNK_SIZE, size - m_bytesCopied);
+            memcpy(m_mapped + m_bytesCopied, m_upload->pixels.data() + m_bytesCopied, chunk);
+            m_bytesCopied += chunk;
+        }
+        else {
+            uploadLevel();
+        }
+    }
+}
+
+lov::lov_size lov::Graphics::TextureLoader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<lov_size>(m_decoding.size() + m_decoded.size()) + (m_upload ? 1 : 0);
+}
+
+lov::lov_uint lov::Graphics::TextureLoader::getPlaceholderID() const {
+    return m_placeholder;
+}
+
+lov::System::ThreadPool& lov::Graphics::TextureLoader::getPool() const {
+    return m_pool;
+}
+
+void lov::Graphics::TextureLoader::buildMipChain(std::vector<unsigned char>& pixels, std::vector<lov_size>& levelOffsets, lov_int width, lov_int height, lov_int channels) {
+    lov_int levelWidth = width;
+    lov_int levelHeight = height;
+    while (levelWidth > 1 || levelHeight > 1) {
+        lov_int sourceWidth = levelWidth;
+        lov_int sourceHeight = levelHeight;
+        size_t source = levelOffsets.back();
+        levelWidth = std::max(levelWidth / 2, 1);
+        levelHeight = std::max(levelHeight / 2, 1);
+
+        levelOffsets.push_back(static_cast<lov_size>(pixels.size()));
+        for (lov_int y = 0; y < levelHeight; y++) {
+            lov_int y0 = std::min(y * 2, sourceHeight - 1);
+            lov_int y1 = std::min(y * 2 + 1, sourceHeight - 1);
+            for (lov_int x = 0; x < levelWidth; x++) {
+                lov_int x0 = std::min(x * 2, sourceWidth - 1);
+                lov_int x1 = std::min(x * 2 + 1, sourceWidth - 1);
+
+                // Average the 2x2 block under this texel
+                for (lov_int c = 0; c < channels; c++) {
+                    int sum = pixels[source + (y0 * sourceWidth + x0) * channels + c] +
+                        pixels[source + (y0 * sourceWidth + x1) * channels + c] +
+                        pixels[source + (y1 * sourceWidth + x0) * channels + c] +
+                        pixels[source + (y1 * sourceWidth + x1) * channels + c];
+                    pixels.push_back(static_cast<unsigned char>((sum + 2) / 4));
+                }
+            }
+        }
+    }
+}
+
+void lov::Graphics::TextureLoader::decode(std::shared_ptr<Texture> texture, const std::string& path, const std::vector<unsigned char>& contents) {
+    DecodedImage image = { std::move(texture), path, {}, {}, 0, 0, 0, 0 };
+
+    // Baked textures only need their levels laid out back to back
+    if (Ktx2Image::isKtx2(contents.data(), contents.size())) {
+        try {
+            Ktx2Image baked = Ktx2Image::read(contents.data(), contents.size());
+            image.pixels.reserve(baked.getByteSize());
+            for (lov_size level = 0; level < baked.getLevelCount(); level++) {
+                image.levelOffsets.push_back(static_cast<lov_size>(image.pixels.size()));
+                image.pixels.insert(image.pixels.end(), baked.getLevel(level).begin(), baked.getLevel(level).end());
+            }
+
+            image.width = baked.getWidth();
+            image.height = baked.getHeight();
+            image.compressedFormat = baked.getGLFormat();
+        }
+        catch (const Exceptions::TextureException&) {
+            image.pixels.clear();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.push_back(std::move(image));
+        return;
+    }
+
+    // Flip rows into OpenGL order on this thread only
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    // Pad RGB to RGBA, which is how Texture stores it
+    int width = 0, height = 0, channels = 0;
+    stbi_info_from_memory(contents.data(), static_cast<int>(contents.size()), &width, &height, &channels);
+    unsigned char* data = stbi_load_from_memory(contents.data(), static_cast<int>(contents.size()), &width, &height, &channels, channels == 3 ? 4 : 0);
+    if (channels == 3) {
+        channels = 4;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.channels = channels;
+
+    if (data) {
+        // Reserve every level of the chain, which adds at most a third to the base level
+        image.pixels.reserve(static_cast<size_t>(width) * height * channels * 4 / 3 + 4 * channels);
+        image.pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+        image.levelOffsets.push_back(0);
+        stbi_image_free(data);
+
+        // Build the mip chain here instead of calling glGenerateMipmap on the GL thread
+        buildMipChain(image.pixels, image.levelOffsets, width, height, channels);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_decoded.push_back(std::move(image));
+}
+
+bool lov::Graphics::TextureLoader::beginUpload() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_decoded.empty()) {
+            return false;
+        }
+
+        m_upload = std::make_unique<DecodedImage>(std::move(m_decoded.front()));
+        m_decoded.pop_front();
+    }
+
+    if (m_upload->pixels.empty()) {
+        std::string path = m_upload->path;
+        m_upload.reset();
+        throw Exceptions::TextureException("Failed to load texture " + path);
+    }
+
+    if (m_upload->compressedFormat != 0 && !GLExtensions::hasCompressedFormat(m_upload->compressedFormat)) {
+        std::string path = m_upload->path;
+        m_upload.reset();
+        throw Exceptions::TextureException("The OpenGL context can't sample the compressed format of " + path);
+    }
+
+    // Orphan the next pixel buffer so mapping it never waits on an upload still reading the old storage
+    lov_size size = static_cast<lov_size>(m_upload->pixels.size());
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffers[m_nextPixelBuffer]);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    m_mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_bytesCopied = 0;
+    m_uploadLevel = 0;
+    return true;
+}
+
+void lov::Graphics::TextureLoader::uploadLevel() {
+    lov_uint pixelBuffer = m_pixelBuffers[m_nextPixelBuffer];
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+
+    if (m_uploadLevel == 0) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        m_mapped = nullptr;
+
+        // Generate the texture with the same storage as Texture
+        glGenTextures(1, &m_uploadTexture);
+        glBindTexture(GL_TEXTURE_2D, m_uploadTexture);
+        Texture::allocate(internalFormatOf(*m_upload), m_upload->width, m_upload->height, static_cast<lov_int>(m_upload->levelOffsets.size()));
+        Texture::swizzleGrey(m_upload->channels);
+    }
+    else {
+        glBindTexture(GL_TEXTURE_2D, m_uploadTexture);
+    }
+
+    // Source the level from the bound pixel buffer. Rows are tightly packed
+    lov_size level = m_uploadLevel;
+    lov_int width = std::max(m_upload->width >> level, 1);
+    lov_int height = std::max(m_upload->height >> level, 1);
+    const void* offset = reinterpret_cast<const void*>(static_cast<size_t>(m_upload->levelOffsets[level]));
+
+    lov_size compressedSize = 0;
+    if (m_upload->compressedFormat != 0) {
+        lov_size end = level + 1 < static_cast<lov_size>(m_upload->levelOffsets.size()) ? m_upload->levelOffsets[level + 1] : static_cast<lov_size>(m_upload->pixels.size());
+        compressedSize = end - m_upload->levelOffsets[level];
+    }
+
+    Texture::uploadLevel(internalFormatOf(*m_upload), level, width, height, offset, compressedSize);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (++m_uploadLevel < static_cast<lov_size>(m_upload->levelOffsets.size())) {
+        return;
+    }
+
+    // Swap the placeholder out of the texture and move on to the next pixel buffer
+    Texture& texture = *m_upload->texture;
+    texture.m_id = m_uploadTexture;
+    texture.m_internalFormat = internalFormatOf(*m_upload);
+    texture.m_width = m_upload->width;
+    texture.m_height = m_upload->height;
+    texture.m_levels = static_cast<lov_int>(m_upload->levelOffsets.size());
+    texture.m_ready = true;
+    m_upload.reset();
+    m_uploadTexture = 0;
+    m_nextPixelBuffer = (m_nextPixelBuffer + 1) % m_pixelBuffers.size();
+}
+
+lov::lov_uint lov::Graphics::TextureLoader::internalFormatOf(const DecodedImage& image) {
+    if (image.compressedFormat != 0) {
+        return image.compressedFormat;
+    }
+
+    return static_cast<lov_uint>(TextureDesc::forImage(image.width, image.height, image.channels).format);
+}
@@ -0,0 +1,437 @@
+#include "Graphics/TextureManager.h"
+
+#include "Graphics/Ktx2Image.h"
+#include "System/Exceptions.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+
+lov::Graphics::TextureHandle::TextureHandle():
+    m_manager(nullptr),
+    m_entry(0)
+{}
+
+lov::Graphics::TextureHandle::TextureHandle(TextureManager* manager, lov_uint entry):
+    m_manager(manager),
+    m_entry(entry)
+{}
+
+lov::Graphics::TextureHandle::~TextureHandle() {
+    release();
+}
+
+lov::Graphics::TextureHandle::TextureHandle(const TextureHandle& other):
+    m_manager(other.m_manager),
+    m_entry(other.m_entry)
+{
+    if (m_manager) {
+        m_manager->addReference(m_entry);
+    }
+}
+
+lov::Graphics::TextureHandle::TextureHandle(TextureHandle&& other) noexcept:
+    m_manager(other.m_manager),
+    m_entry(other.m_entry)
+{
+    other.m_manager = nullptr;
+}
+
+lov::Graphics::TextureHandle& lov::Graphics::TextureHandle::operator=(const TextureHandle& other) {
+    // Count the new reference first in case both handles share a texture
+    if (other.m_manager) {
+        other.m_manager->addReference(other.m_entry);
+    }
+
+    release();
+    m_manager = other.m_manager;
+    m_entry = other.m_entry;
+    return *this;
+}
+
+lov::Graphics::TextureHandle& lov::Graphics::TextureHandle::operator=(TextureHandle&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_manager = other.m_manager;
+        m_entry = other.m_entry;
+        other.m_manager = nullptr;
+    }
+
+    return *this;
+}
+
+lov::Graphics::Texture* lov::Graphics::TextureHandle::get() const {
+    return m_manager ? m_manager->m_entries[m_entry].texture.get() : nullptr;
+}
+
+lov::Graphics::Texture* lov::Graphics::TextureHandle::operator->() const {
+    return get();
+}
+
+lov::Graphics::TextureHandle::operator bool() const {
+    return m_manager != nullptr;
+}
+
+void lov::Graphics::TextureHandle::release() {
+    if (m_manager) {
+        m_manager->removeReference(m_entry);
+        m_manager = nullptr;
+    }
+}
+
+lov::Graphics::TextureManager::TextureManager(TextureLoader* loader, size_t budgetBytes):
+    m_loader(loader),
+    m_budget(budgetBytes),
+    m_loads(0),
+    m_stats()
+{}
+
+lov::Graphics::TextureManager::~TextureManager() {
+    // Workers write into this object, so let them finish first
+    for (std::future<void>& reading : m_reading) {
+        reading.wait();
+    }
+}
+
+lov::Graphics::TextureHandle lov::Graphics::TextureManager::acquire(const std::string& path) {
+    return acquireEntry(normalizePath(path), {});
+}
+
+lov::Graphics::TextureHandle lov::Graphics::TextureManager::acquire(const std::string& name, std::span<const std::byte> contents) {
+    if (contents.empty()) {
+        throw Exceptions::TextureException("No contents given for texture " + name);
+    }
+
+    return acquireEntry(name, contents);
+}
+
+lov::Graphics::TextureHandle lov::Graphics::TextureManager::acquireEntry(const std::string& key, std::span<const std::byte> source) {
+    // The same file by any spelling of its path
+    auto byPath = m_byPath.find(key);
+    if (byPath != m_byPath.end()) {
+        // The size of a texture still being read isn't known yet, so update counts the bytes once it is
+        m_stats.pathHits++;
+        if (m_entries[byPath->second].pending) {
+            m_entries[byPath->second].pendingHits++;
+        } else {
+            m_stats.dedupedBytes += getTextureBytes(byPath->second);
+        }
+
+        addReference(byPath->second);
+        return TextureHandle(this, byPath->second);
+    }
+
+    Entry entry;
+    entry.paths.push_back(key);
+    entry.contentHash = 0;
+    entry.contentSize = 0;
+    entry.bytes = 0;
+    entry.references = 1;
+    entry.unreferenced = m_unreferenced.end();
+    entry.load = ++m_loads;
+    entry.pending = false;
+    entry.shared = NoEntry;
+    entry.pendingHits = 0;
+    entry.source = source;
+
+    // Read the file on the loader's pool, leaving the placeholder bound until update decides what it is
+    if (m_loader) {
+        entry.texture = m_loader->createPlaceholder();
+        entry.pending = true;
+
+        std::uint64_t load = entry.load;
+        lov_uint index = insert(std::move(entry));
+        m_stats.pendingCount++;
+
+        m_reading.push_back(m_loader->getPool().submit([this, key, source, index, load, candidates = getCandidates()]() {
+            ReadContents read = { index, load, {}, 0, 0, NoEntry, 0 };
+            readContents(key, source, candidates, read);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_read.push_back(std::move(read));
+        }));
+
+        return TextureHandle(this, index);
+    }
+
+    ReadContents read = { 0, 0, {}, 0, 0, NoEntry, 0 };
+    readContents(key, source, getCandidates(), read);
+
+    // A copy of a resident image under another name
+    if (read.duplicate != NoEntry) {
+        m_stats.contentHits++;
+        m_stats.dedupedBytes += m_entries[read.duplicate].bytes;
+        m_entries[read.duplicate].paths.push_back(key);
+        m_byPath[key] = read.duplicate;
+        addReference(read.duplicate);
+        return TextureHandle(this, read.duplicate);
+    }
+
+    // Decode the contents already read rather than opening the file again
+    entry.texture = std::make_shared<Texture>(std::as_bytes(std::span(read.contents)));
+    entry.contentHash = read.hash;
+    entry.contentSize = read.contents.size();
+    entry.bytes = read.bytes;
+
+    lov_uint index = insert(std::move(entry));
+    m_byContent.emplace(read.hash, index);
+    m_stats.textureCount++;
+    m_stats.residentBytes += read.bytes;
+
+    // Make room for the new texture
+    evict(m_budget);
+
+    return TextureHandle(this, index);
+}
+
+void lov::Graphics::TextureManager::update() {
+    std::deque<ReadContents> reads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        reads.swap(m_read);
+    }
+
+    // Forget reads that have queued their contents
+    m_reading.erase(std::remove_if(m_reading.begin(), m_reading.end(), [](const std::future<void>& reading) {
+        return reading.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), m_reading.end());
+
+    for (ReadContents& read : reads) {
+        m_stats.pendingCount--;
+
+        // The entry may have been released and freed while its file was read
+        Entry& entry = m_entries[read.entry];
+        if (!entry.texture || entry.load != read.load) {
+            continue;
+        }
+
+        entry.pending = false;
+        entry.contentHash = read.hash;
+        entry.contentSize = read.contents.size();
+
+        // Share a texture with the same bytes, holding a reference to it for as long as this entry is resident
+        if (read.duplicate != NoEntry && m_entries[read.duplicate].texture && m_entries[read.duplicate].load == read.duplicateLoad) {
+            m_stats.contentHits++;
+            m_stats.dedupedBytes += static_cast<size_t>(entry.pendingHits + 1) * m_entries[read.duplicate].bytes;
+            entry.texture = m_entries[read.duplicate].texture;
+            entry.shared = read.duplicate;
+            addReference(read.duplicate);
+            continue;
+        }
+
+        entry.texture = m_loader->load(entry.paths.front(), std::move(read.contents));
+        entry.bytes = read.bytes;
+        m_stats.dedupedBytes += static_cast<size_t>(entry.pendingHits) * read.bytes;
+        m_byContent.emplace(read.hash, read.entry);
+        m_stats.textureCount++;
+        m_stats.residentBytes += read.bytes;
+    }
+
+    // Make room for the new textures
+    evict(m_budget);
+}
+
+void lov::Graphics::TextureManager::setBudget(size_t budgetBytes) {
+    m_budget = budgetBytes;
+    evict(m_budget);
+}
+
+void lov::Graphics::TextureManager::trim() {
+    evict(0);
+}
+
+lov::Graphics::TextureManagerStats lov::Graphics::TextureManager::getStats() const {
+    TextureManagerStats stats = m_stats;
+    stats.unreferencedCount = static_cast<lov_size>(m_unreferenced.size());
+    return stats;
+}
+
+std::string lov::Graphics::TextureManager::normalizePath(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+
+    // Resolve symlinks in the part of the path that exists, then clean up whatever is left lexically
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(absolute, error);
+    if (error) {
+        canonical = absolute;
+    }
+
+    return canonical.lexically_normal().generic_string();
+}
+
+std::uint64_t lov::Graphics::TextureManager::hashContent(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+void lov::Graphics::TextureManager::readContents(const std::string& path, std::span<const std::byte> source, const std::vector<Candidate>& candidates, ReadContents& read) {
+    if (!source.empty()) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(source.data());
+        read.contents.assign(bytes, bytes + source.size());
+    } else {
+        std::ifstream file(path, std::ios::binary);
+        read.contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    read.hash = hashContent(read.contents.data(), read.contents.size());
+    read.bytes = estimateBytes(read.contents);
+    read.duplicate = NoEntry;
+
+    // Unreadable files never match each other
+    if (read.contents.empty()) {
+        return;
+    }
+
+    // Only read a candidate's file when its hash and size match, then compare every byte
+    for (const Candidate& candidate : candidates) {
+        if (candidate.hash != read.hash || candidate.size != read.contents.size()) {
+            continue;
+        }
+
+        bool equal;
+        if (!candidate.source.empty()) {
+            equal = std::equal(read.contents.begin(), read.contents.end(), reinterpret_cast<const unsigned char*>(candidate.source.data()));
+        } else {
+            std::ifstream other(candidate.path, std::ios::binary);
+            std::vector<unsigned char> otherContents((std::istreambuf_iterator<char>(other)), std::istreambuf_iterator<char>());
+            equal = otherContents == read.contents;
+        }
+
+        if (equal) {
+            read.duplicate = candidate.entry;
+            read.duplicateLoad = candidate.load;
+            return;
+        }
+    }
+}
+
+size_t lov::Graphics::TextureManager::estimateBytes(const std::vector<unsigned char>& contents) {
+    // Baked textures know their exact size. Otherwise estimate it from the image header, adding a third for the mip chain
+    int width = 0, height = 0, channels = 0;
+    if (Ktx2Image::isKtx2(contents.data(), contents.size())) {
+        try {
+            return Ktx2Image::read(contents.data(), contents.size()).getByteSize();
+        }
+        catch (const Exceptions::TextureException&) {
+            return 0;
+        }
+    }
+
+    if (stbi_info_from_memory(contents.data(), static_cast<int>(contents.size()), &width, &height, &channels)) {
+        // RGB is padded to RGBA on upload
+        return static_cast<size_t>(width) * height * (channels == 3 ? 4 : channels) * 4 / 3;
+    }
+
+    return 0;
+}
+
+size_t lov::Graphics::TextureManager::getTextureBytes(lov_uint entry) const {
+    const Entry& resident = m_entries[entry];
+    return resident.shared != NoEntry ? m_entries[resident.shared].bytes : resident.bytes;
+}
+
+std::vector<lov::Graphics::TextureManager::Candidate> lov::Graphics::TextureManager::getCandidates() const {
+    std::vector<Candidate> candidates;
+    candidates.reserve(m_byContent.size());
+
+    for (const auto& [hash, entry] : m_byContent) {
+        candidates.push_back({ entry, m_entries[entry].load, hash, m_entries[entry].contentSize, m_entries[entry].paths.front(), m_entries[entry].source });
+    }
+
+    return candidates;
+}
+
+lov::lov_uint lov::Graphics::TextureManager::insert(Entry&& entry) {
+    lov_uint index;
+    if (!m_freeEntries.empty()) {
+        index = m_freeEntries.back();
+        m_freeEntries.pop_back();
+        m_entries[index] = std::move(entry);
+    } else {
+        index = static_cast<lov_uint>(m_entries.size());
+        m_entries.push_back(std::move(entry));
+    }
+
+    m_byPath[m_entries[index].paths.front()] = index;
+    return index;
+}
+
+void lov::Graphics::TextureManager::addReference(lov_uint entry) {
+    Entry& resident = m_entries[entry];
+
+    // Reacquiring an unreferenced texture takes it off the eviction list
+    if (resident.references++ == 0) {
+        m_unreferenced.erase(resident.unreferenced);
+        resident.unreferenced = m_unreferenced.end();
+    }
+}
+
+void lov::Graphics::TextureManager::removeReference(lov_uint entry) {
+    dropReference(entry);
+    evict(m_budget);
+}
+
+void lov::Graphics::TextureManager::dropReference(lov_uint entry) {
+    Entry& resident = m_entries[entry];
+    if (--resident.references > 0) {
+        return;
+    }
+
+    resident.unreferenced = m_unreferenced.insert(m_unreferenced.end(), entry);
+}
+
+void lov::Graphics::TextureManager::evict(size_t budgetBytes) {
+    // A budget of zero keeps nothing unreferenced, even textures whose size couldn't be estimated
+    while (!m_unreferenced.empty() && (m_stats.residentBytes > budgetBytes || budgetBytes == 0)) {
+        free(m_unreferenced.front());
+        m_stats.evictions++;
+    }
+}
+
+void lov::Graphics::TextureManager::free(lov_uint entry) {
+    Entry& resident = m_entries[entry];
+
+    for (const std::string& path : resident.paths) {
+        m_byPath.erase(path);
+    }
+
+    // Only entries that loaded their own texture are counted and can be matched by contents
+    if (!resident.pending && resident.shared == NoEntry) {
+        auto matches = m_byContent.equal_range(resident.contentHash);
+        for (auto match = matches.first; match != matches.second; match++) {
+            if (match->second == entry) {
+                m_byContent.erase(match);
+                break;
+            }
+        }
+
+        m_stats.textureCount--;
+        m_stats.residentBytes -= resident.bytes;
+    }
+
+    m_unreferenced.erase(resident.unreferenced);
+
+    // The shared texture's entry may now be unreferenced too, which the caller's eviction goes on to consider
+    if (resident.shared != NoEntry) {
+        dropReference(resident.shared);
+        resident.shared = NoEntry;
+    }
+
+    resident.texture.reset();
+    resident.paths.clear();
+    resident.source = {};
+    resident.unreferenced = m_unreferenced.end();
+    m_freeEntries.push_back(entry);
+}
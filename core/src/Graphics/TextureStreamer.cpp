@@ -0,0 +1,366 @@
+#include "Graphics/TextureStreamer.h"
+
+#include "Graphics/Ktx2Image.h"
+#include "Graphics/TextureLoader.h"
+#include "System/Exceptions.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+lov::Graphics::TextureStreamer::TextureStreamer(System::ThreadPool& pool, size_t budgetBytes, lov_int tailSize):
+    m_pool(pool),
+    m_tailSize(std::max(tailSize, 1)),
+    m_residency(budgetBytes),
+    m_uploadedLevels(0),
+    m_stats()
+{
+    // Create a grey placeholder that textures bind until their tail arrives
+    const unsigned char grey[4] = { 128, 128, 128, 255 };
+    glGenTextures(1, &m_placeholder);
+    glBindTexture(GL_TEXTURE_2D, m_placeholder);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+lov::Graphics::TextureStreamer::~TextureStreamer() {
+    // Workers write into this object, so let them finish first. The textures own their OpenGL textures once handed over
+    for (std::future<void>& reading : m_reading) {
+        reading.wait();
+    }
+
+    glDeleteTextures(1, &m_placeholder);
+}
+
+lov::lov_uint lov::Graphics::TextureStreamer::add(const std::string& path) {
+    lov_uint index = m_residency.add();
+
+    Entry entry = {};
+    entry.texture.reset(new Texture(m_placeholder));
+    entry.path = path;
+    m_entries.push_back(std::move(entry));
+
+    // Read the tail levels in the background
+    m_reading.push_back(m_pool.submit([this, index, path]() { read(index, path, -1, -1); }));
+    return index;
+}
+
+const std::shared_ptr<lov::Graphics::Texture>& lov::Graphics::TextureStreamer::getTexture(lov_uint texture) const {
+    return m_entries[texture].texture;
+}
+
+void lov::Graphics::TextureStreamer::request(lov_uint texture, float screenSize, float uvDensity) {
+    // Requests before the tail arrives can't be resolved into a level, and the tail is all that's loading anyway
+    if (m_residency.hasLevels(texture)) {
+        const Entry& entry = m_entries[texture];
+        m_residency.request(texture, computeMipLevel(entry.width, entry.height, screenSize, std::max(uvDensity, 1e-6f)));
+    }
+}
+
+void lov::Graphics::TextureStreamer::update(double budgetMilliseconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMilliseconds);
+
+    // Forget reads that have queued their levels
+    m_reading.erase(std::remove_if(m_reading.begin(), m_reading.end(), [](const std::future<void>& reading) {
+        return reading.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), m_reading.end());
+
+    // Upload a level at a time, coarsest first so each one is usable as soon as it lands
+    std::vector<std::string> failures;
+    while (std::chrono::steady_clock::now() < deadline && uploadNext(failures)) {}
+
+    // Free and read levels to match this frame's requests
+    MipPlan plan = m_residency.update();
+    m_stats.wantedBytes = m_residency.getWantedBytes();
+
+    for (const MipEviction& eviction : plan.evictions) {
+        evictLevel(m_entries[eviction.texture], eviction.level);
+    }
+
+    for (const MipLoad& load : plan.loads) {
+        lov_uint index = load.texture;
+        lov_int firstLevel = load.firstLevel;
+        lov_int lastLevel = load.lastLevel;
+        std::string path = m_entries[index].path;
+        m_reading.push_back(m_pool.submit([this, index, path, firstLevel, lastLevel]() { read(index, path, firstLevel, lastLevel); }));
+    }
+
+    // Only report failed reads once the rest of the frame's streaming is under way
+    if (!failures.empty()) {
+        std::string paths = failures.front();
+        for (size_t i = 1; i < failures.size(); i++) {
+            paths += ", " + failures[i];
+        }
+
+        throw Exceptions::TextureException("Failed to stream texture " + paths);
+    }
+}
+
+void lov::Graphics::TextureStreamer::setBudget(size_t budgetBytes) {
+    m_residency.setBudget(budgetBytes);
+}
+
+lov::lov_int lov::Graphics::TextureStreamer::getResidentLevel(lov_uint texture) const {
+    // Nothing is resident until the tail has been handed over
+    return m_entries[texture].id != 0 ? m_residency.getResidentLevel(texture) : -1;
+}
+
+lov::Graphics::TextureStreamerStats lov::Graphics::TextureStreamer::getStats() const {
+    TextureStreamerStats stats = m_stats;
+    stats.textureCount = static_cast<lov_size>(m_entries.size());
+    stats.residentBytes = m_residency.getResidentBytes();
+    stats.pendingLoads = m_residency.getLoadingCount();
+    return stats;
+}
+
+lov::lov_int lov::Graphics::TextureStreamer::computeMipLevel(lov_int width, lov_int height, float screenSize, float uvDensity) {
+    lov_int size = std::max(width, height);
+    lov_int lastLevel = 0;
+    while ((size >> lastLevel) > 1) {
+        lastLevel++;
+    }
+
+    if (screenSize <= 0.0f) {
+        return lastLevel;
+    }
+
+    // Each level halves the texels across the object, so stop once there are no more texels than pixels
+    float texelsPerPixel = size * uvDensity / screenSize;
+    if (texelsPerPixel <= 1.0f) {
+        return 0;
+    }
+
+    return std::min(static_cast<lov_int>(std::floor(std::log2(texelsPerPixel))), lastLevel);
+}
+
+float lov::Graphics::TextureStreamer::projectedSize(const BoundingBox& bounds, const Vector3f& cameraPosition, float fovY, lov_int viewportHeight) {
+    float radius = Vector::length(bounds.getExtents());
+    float distance = Vector::length(bounds.getCenter() - cameraPosition);
+    if (distance <= radius) {
+        return static_cast<float>(viewportHeight);
+    }
+
+    // The diameter over the height of the view at that distance, scaled to pixels
+    return radius / (distance * std::tan(fovY * 0.5f)) * viewportHeight;
+}
+
+void lov::Graphics::TextureStreamer::read(lov_uint entry, const std::string& path, lov_int firstLevel, lov_int lastLevel) {
+    LoadedLevels loaded = {};
+    loaded.entry = entry;
+    loaded.tail = firstLevel < 0;
+
+    // Levels of an image decoded for its tail are copied from the chain kept then, without touching the file
+    std::shared_ptr<const DecodedImage> decoded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_decoded.find(entry);
+        if (found != m_decoded.end()) {
+            decoded = found->second;
+        }
+    }
+
+    std::vector<unsigned char> contents;
+    if (!decoded) {
+        std::ifstream file(path, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::optional<Ktx2Image> baked;
+    bool isBaked = !decoded && Ktx2Image::isKtx2(contents.data(), contents.size());
+
+    if (isBaked) {
+        // Baked levels are stored separately, so only the wanted ones are copied out
+        try {
+            baked = Ktx2Image::read(contents.data(), contents.size());
+            loaded.internalFormat = baked->getGLFormat();
+            loaded.width = baked->getWidth();
+            loaded.height = baked->getHeight();
+            for (lov_size level = 0; level < baked->getLevelCount(); level++) {
+                loaded.levelSizes.push_back(baked->getLevel(level).size());
+            }
+        }
+        catch (const Exceptions::TextureException&) {
+            loaded.failed = true;
+        }
+    }
+    else if (!decoded) {
+        // Other images have to be decoded and mipmapped whole, padding RGB to RGBA like Texture
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        int width = 0, height = 0, channels = 0;
+        stbi_info_from_memory(contents.data(), static_cast<int>(contents.size()), &width, &height, &channels);
+        unsigned char* data = stbi_load_from_memory(contents.data(), static_cast<int>(contents.size()), &width, &height, &channels, channels == 3 ? 4 : 0);
+        if (data) {
+            auto image = std::make_shared<DecodedImage>();
+            image->channels = channels == 3 ? 4 : channels;
+            image->internalFormat = static_cast<lov_uint>(TextureDesc::forImage(width, height, image->channels).format);
+            image->width = width;
+            image->height = height;
+            image->pixels.reserve(static_cast<size_t>(width) * height * image->channels * 4 / 3 + 4 * image->channels);
+            image->pixels.assign(data, data + static_cast<size_t>(width) * height * image->channels);
+            image->levelOffsets.push_back(0);
+            stbi_image_free(data);
+            TextureLoader::buildMipChain(image->pixels, image->levelOffsets, width, height, image->channels);
+
+            decoded = image;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decoded[entry] = decoded;
+        }
+        else {
+            loaded.failed = true;
+        }
+    }
+
+    if (decoded) {
+        loaded.internalFormat = decoded->internalFormat;
+        loaded.width = decoded->width;
+        loaded.height = decoded->height;
+        loaded.channels = decoded->channels;
+        for (size_t level = 0; level < decoded->levelOffsets.size(); level++) {
+            size_t end = level + 1 < decoded->levelOffsets.size() ? decoded->levelOffsets[level + 1] : decoded->pixels.size();
+            loaded.levelSizes.push_back(end - decoded->levelOffsets[level]);
+        }
+    }
+
+    if (!loaded.failed) {
+        // The tail is every level no larger than the tail size, or just the last level of a short chain
+        lov_int levelCount = static_cast<lov_int>(loaded.levelSizes.size());
+        if (loaded.tail) {
+            firstLevel = 0;
+            while (firstLevel < levelCount - 1 && std::max(loaded.width >> firstLevel, loaded.height >> firstLevel) > m_tailSize) {
+                firstLevel++;
+            }
+
+            lastLevel = levelCount - 1;
+        }
+
+        loaded.firstLevel = firstLevel;
+        for (lov_int level = firstLevel; level <= lastLevel; level++) {
+            if (isBaked) {
+                loaded.levels.push_back(baked->getLevel(level));
+            }
+            else {
+                const unsigned char* begin = decoded->pixels.data() + decoded->levelOffsets[level];
+                loaded.levels.emplace_back(begin, begin + loaded.levelSizes[level]);
+            }
+        }
+    }
+    else {
+        loaded.firstLevel = firstLevel;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loaded.push_back(std::move(loaded));
+}
+
+bool lov::Graphics::TextureStreamer::uploadNext(std::vector<std::string>& failures) {
+    LoadedLevels* loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_loaded.empty()) {
+            return false;
+        }
+
+        // Elements of a deque stay put while workers push behind them
+        loaded = &m_loaded.front();
+    }
+
+    Entry& entry = m_entries[loaded->entry];
+
+    if (loaded->failed) {
+        m_residency.loadFailed(loaded->entry, loaded->firstLevel, loaded->tail);
+        failures.push_back(entry.path);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_loaded.pop_front();
+        }
+
+        return true;
+    }
+
+    // Create the texture with the first tail level, then hand it over since it's complete from then on
+    if (loaded->tail && m_uploadedLevels == 0) {
+        entry.internalFormat = loaded->internalFormat;
+        entry.pixelFormat = loaded->channels == 0 ? 0 : TextureDesc::forImage(1, 1, loaded->channels).getPixelFormat();
+        entry.width = loaded->width;
+        entry.height = loaded->height;
+        entry.levelCount = static_cast<lov_int>(loaded->levelSizes.size());
+        m_residency.setLevels(loaded->entry, loaded->levelSizes, loaded->firstLevel);
+
+        glGenTextures(1, &entry.id);
+        glBindTexture(GL_TEXTURE_2D, entry.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, entry.levelCount - 1);
+        Texture::swizzleGrey(loaded->channels);
+    }
+    else {
+        glBindTexture(GL_TEXTURE_2D, entry.id);
+    }
+
+    // Define the next level up in mutable storage, so it can be freed on its own later
+    lov_size index = static_cast<lov_size>(loaded->levels.size()) - 1 - m_uploadedLevels;
+    lov_int level = loaded->firstLevel + static_cast<lov_int>(index);
+    lov_int width = std::max(entry.width >> level, 1);
+    lov_int height = std::max(entry.height >> level, 1);
+    const std::vector<unsigned char>& data = loaded->levels[index];
+
+    if (entry.pixelFormat == 0) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, entry.internalFormat, width, height, 0, static_cast<lov_size>(data.size()), data.data());
+    }
+    else {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, level, entry.internalFormat, width, height, 0, entry.pixelFormat, GL_UNSIGNED_BYTE, data.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_residency.levelUploaded(loaded->entry, level, loaded->tail);
+    m_stats.levelsLoaded++;
+    loaded->levels[index] = std::vector<unsigned char>();
+
+    if (loaded->tail && m_uploadedLevels == 0) {
+        Texture& texture = *entry.texture;
+        texture.m_id = entry.id;
+        texture.m_internalFormat = entry.internalFormat;
+        texture.m_width = entry.width;
+        texture.m_height = entry.height;
+        texture.m_levels = entry.levelCount;
+        texture.m_ready = true;
+    }
+
+    if (++m_uploadedLevels < static_cast<lov_size>(loaded->levels.size())) {
+        return true;
+    }
+
+    m_residency.loadFinished(loaded->entry);
+    m_uploadedLevels = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loaded.pop_front();
+    }
+
+    return true;
+}
+
+void lov::Graphics::TextureStreamer::evictLevel(Entry& entry, lov_int level) {
+    // Clamp sampling past the level first, then shrink it to nothing so the driver can release its memory
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+    if (entry.pixelFormat == 0) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, entry.internalFormat, 0, 0, 0, 0, nullptr);
+    }
+    else {
+        glTexImage2D(GL_TEXTURE_2D, level, entry.internalFormat, 0, 0, 0, entry.pixelFormat, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_stats.levelsEvicted++;
+}
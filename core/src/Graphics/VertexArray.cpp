@@ -15,6 +15,15 @@ void lov::Graphics::VertexArray::linkAttribute(lov_uint location, lov_uint compo
     glEnableVertexAttribArray(location);
 }
 
+void lov::Graphics::VertexArray::linkIntegerAttribute(lov_uint location, lov_uint componentCount, LovelyType type, lov_size stride, lov_size offset) const {
+    glVertexAttribIPointer(location, componentCount, type, stride, reinterpret_cast<void*>(offset));
+    glEnableVertexAttribArray(location);
+}
+
+void lov::Graphics::VertexArray::setAttributeDivisor(lov_uint location, lov_uint divisor) const {
+    glVertexAttribDivisor(location, divisor);
+}
+
 void lov::Graphics::VertexArray::bind() const {
     // Bind this VAO
     glBindVertexArray(m_id);
@@ -24,3 +33,7 @@ void lov::Graphics::VertexArray::unbind() const {
     // Unbind this VAO
     glBindVertexArray(0);
 }
+
+lov::lov_uint lov::Graphics::VertexArray::getID() const {
+    return m_id;
+}
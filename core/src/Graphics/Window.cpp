@@ -1,39 +1,119 @@
 #include "Graphics/Window.h"
 
+#include "Graphics/GLExtensions.h"
+#include "Graphics/Sampler.h"
 #include "System/Exceptions.h"
 
-lov::Graphics::Window::Window(unsigned int width, unsigned int height, const std::string& title):
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef LOV_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+lov::Graphics::Window::Window(unsigned int width, unsigned int height, const std::string& title, WindowMode mode):
+    m_window(nullptr),
+    m_mode(mode),
+    m_eglDisplay(nullptr),
+    m_eglContext(nullptr),
+    m_closed(false),
+    m_framebuffer(0),
+    m_colorBuffer(0),
+    m_depthBuffer(0),
     m_mousePos(0.0f, 0.0f),
     m_previousMousePos(0.0f, 0.0f),
     m_mouseOffset(0.0f, 0.0f),
     m_mouseMoved(false),
-    m_recentFrameTime(0.0f)
+    m_recentFrameTime(System::FrameClock::Clock::now()),
+    m_framebufferWidth(static_cast<int>(width)),
+    m_framebufferHeight(static_cast<int>(height)),
+    m_resized(false),
+    m_framePeriod(0),
+    m_maxFramesInFlight(2),
+    m_limiterMilliseconds(0.0),
+    m_fenceMilliseconds(0.0),
+    m_framesInFlight(0),
+    m_lowPower(false),
+    m_idleTimeout(1.0),
+    m_redraw(true),
+    m_idleStats{ 0, 0, std::chrono::nanoseconds(0), 0.0, 0.0, 0.0 },
+    m_idleMeasureStart(System::FrameClock::Clock::now()),
+    m_idleMeasureCpu(System::FrameClock::getProcessCpuTime()),
+    m_idleMeasureFrames(0),
+    m_idleMeasureWaited(0)
 {
-    // Initialize GLFW
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    GLADloadproc loader;
+
+#ifdef LOV_HAS_EGL
+    // Headless windows don't need a display server when EGL can make a context without a surface
+    if (mode == WindowMode::Headless) {
+        createSurfacelessContext();
+        loader = (GLADloadproc)eglGetProcAddress;
+    }
+    else
+#endif
+    {
+        // Initialize GLFW
+        glfwInit();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, mode == WindowMode::Headless ? GLFW_FALSE : GLFW_TRUE);
+
+        // Create GLFW Window
+        m_window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
 
-    // Create GLFW Window
-    m_window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
+        if (m_window == NULL) {
+            glfwTerminate();
+            throw Exceptions::WindowException("Failed to create lov::Graphics::Window");
+        }
 
-    if (m_window == NULL) {
-        glfwTerminate();
-        throw Exceptions::WindowException("Failed to create lov::Graphics::Window");
+        this->makeCurrent();
+        loader = (GLADloadproc)glfwGetProcAddress;
     }
 
-    this->makeCurrent();
+    // The destructor won't run if the rest of construction throws, so release the context before passing the error on
+    try {
+        // Load GLAD
+        if (!gladLoadGLLoader(loader)) {
+            throw Exceptions::WindowException("Failed to load OpenGL function pointers");
+        }
 
-    // Load GLAD
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        throw Exceptions::WindowException("Failed to load OpenGL function pointers");
+        // Load entry points beyond OpenGL 3.3 that the context provides
+        GLExtensions::load(loader);
+
+        if (mode == WindowMode::Headless) {
+            createOffscreenFramebuffer(width, height);
+        }
+    }
+    catch (...) {
+        destroyContext();
+        throw;
     }
 
-    // Set viewport
+    // Set viewport. Events arrive on this thread while the context may be current on a render thread, so resizes
+    // are applied by the next clear
     glViewport(0, 0, width, height);
+
+    // Enable depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    // A headless window has no events, and one that's never shown is never resized
+    if (mode == WindowMode::Headless) {
+        return;
+    }
+
     glfwSetFramebufferSizeCallback(m_window, [](GLFWwindow* window, int frameBufferWidth, int frameBufferHeight) {
-        glViewport(0, 0, frameBufferWidth, frameBufferHeight);
+        Window* handler = static_cast<Window*>(glfwGetWindowUserPointer(window));
+
+        if (handler) {
+            handler->m_framebufferWidth = frameBufferWidth;
+            handler->m_framebufferHeight = frameBufferHeight;
+            handler->m_resized = true;
+            handler->m_redraw = true;
+        }
     });
 
     // Set callback to get mouse position
@@ -49,23 +129,84 @@ lov::Graphics::Window::Window(unsigned int width, unsigned int height, const std
 
             handler->m_mouseMoved = true;
             handler->m_mousePos = { xpos, ypos };
+            handler->m_input.push({ Input::InputEventType::CursorMove, 0, { xpos, ypos }, System::FrameClock::Clock::now() });
+            handler->m_redraw = true;
         }
     });
 
-    // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
+    // Record keys, buttons and scrolling as they arrive, so presses shorter than a frame aren't missed. Key repeats
+    // don't change what's down, so they aren't recorded
+    glfwSetKeyCallback(m_window, [](GLFWwindow* window, int key, int, int action, int) {
+        Window* handler = static_cast<Window*>(glfwGetWindowUserPointer(window));
+
+        if (handler && action != GLFW_REPEAT) {
+            Input::InputEventType type = action == GLFW_PRESS ? Input::InputEventType::KeyPress : Input::InputEventType::KeyRelease;
+            handler->m_input.push({ type, key, { 0.0f, 0.0f }, System::FrameClock::Clock::now() });
+            handler->m_redraw = true;
+        }
+    });
+
+    glfwSetMouseButtonCallback(m_window, [](GLFWwindow* window, int button, int action, int) {
+        Window* handler = static_cast<Window*>(glfwGetWindowUserPointer(window));
+
+        if (handler) {
+            Input::InputEventType type = action == GLFW_PRESS ? Input::InputEventType::ButtonPress : Input::InputEventType::ButtonRelease;
+            handler->m_input.push({ type, button, { 0.0f, 0.0f }, System::FrameClock::Clock::now() });
+            handler->m_redraw = true;
+        }
+    });
+
+    glfwSetScrollCallback(m_window, [](GLFWwindow* window, double x, double y) {
+        Window* handler = static_cast<Window*>(glfwGetWindowUserPointer(window));
+
+        if (handler) {
+            handler->m_input.push({ Input::InputEventType::Scroll, 0, { static_cast<float>(x), static_cast<float>(y) }, System::FrameClock::Clock::now() });
+            handler->m_redraw = true;
+        }
+    });
+
+    // The window needs drawing again when it's uncovered
+    glfwSetWindowRefreshCallback(m_window, [](GLFWwindow* window) {
+        Window* handler = static_cast<Window*>(glfwGetWindowUserPointer(window));
+
+        if (handler) {
+            handler->m_redraw = true;
+        }
+    });
 }
 
 lov::Graphics::Window::~Window() {
-    glfwTerminate();
+    destroyContext();
 }
 
 void lov::Graphics::Window::makeCurrent() {
+#ifdef LOV_HAS_EGL
+    if (m_eglDisplay) {
+        eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, m_eglContext);
+        return;
+    }
+#endif
+
     glfwMakeContextCurrent(m_window);
     glfwSetWindowUserPointer(m_window, this);
 }
 
+void lov::Graphics::Window::releaseCurrent() {
+#ifdef LOV_HAS_EGL
+    if (m_eglDisplay) {
+        eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        return;
+    }
+#endif
+
+    glfwMakeContextCurrent(NULL);
+}
+
 void lov::Graphics::Window::hideCursor(bool hidden) {
+    if (m_mode == WindowMode::Headless) {
+        return;
+    }
+
     if (hidden) {
         glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     }
@@ -75,10 +216,19 @@ void lov::Graphics::Window::hideCursor(bool hidden) {
 }
 
 bool lov::Graphics::Window::isOpen() const {
+    if (!m_window) {
+        return !m_closed;
+    }
+
     return !glfwWindowShouldClose(m_window);
 }
 
 void lov::Graphics::Window::close() {
+    if (!m_window) {
+        m_closed = true;
+        return;
+    }
+
     glfwSetWindowShouldClose(m_window, true);
 }
 
@@ -87,27 +237,201 @@ void lov::Graphics::Window::setClearColor(float red, float green, float blue, fl
 }
 
 void lov::Graphics::Window::clear() {
+    if (m_resized.exchange(false)) {
+        glViewport(0, 0, m_framebufferWidth, m_framebufferHeight);
+    }
+
     // Clear buffers
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 void lov::Graphics::Window::update() {
-    // Swap buffers
-    glfwSwapBuffers(m_window);
+    swapBuffers();
+    waitForNextFrame();
+    pollEvents();
+}
+
+void lov::Graphics::Window::swapBuffers() {
+    // There's nothing to show offscreen, but the commands still need submitting, as a swap would
+    if (m_mode == WindowMode::Headless) {
+        glFlush();
+    }
+    else {
+        glfwSwapBuffers(m_window);
+    }
+
+    lov_uint maxFramesInFlight = m_maxFramesInFlight;
+    if (maxFramesInFlight == 0) {
+        for (GLsync fence : m_frameFences) {
+            glDeleteSync(fence);
+        }
+        m_frameFences.clear();
+        m_framesInFlight = 0;
+        return;
+    }
+
+    m_frameFences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    // Wait for the oldest frames until few enough are left, flushing so the fence is sure to be reached
+    auto start = std::chrono::steady_clock::now();
+    while (m_frameFences.size() > maxFramesInFlight) {
+        GLenum result;
+        do {
+            result = glClientWaitSync(m_frameFences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        glDeleteSync(m_frameFences.front());
+        m_frameFences.pop_front();
+    }
+
+    m_fenceMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_framesInFlight = static_cast<lov_uint>(m_frameFences.size());
+}
+
+void lov::Graphics::Window::waitForNextFrame() {
+    if (m_framePeriod.count() == 0) {
+        m_limiterMilliseconds = 0.0;
+        return;
+    }
+
+    // Start each frame a period after the last, unless this one is already late, so a slow frame isn't followed
+    // by a burst of fast ones
+    System::FrameClock::Clock::time_point now = System::FrameClock::Clock::now();
+    m_nextFrame = std::max(m_nextFrame + m_framePeriod, now);
+
+    System::FrameClock::sleepUntil(m_nextFrame);
+    m_limiterMilliseconds = std::chrono::duration<double, std::milli>(System::FrameClock::Clock::now() - now).count();
+}
+
+void lov::Graphics::Window::pollEvents() {
+    if (!m_lowPower || m_redraw) {
+        if (m_window) {
+            glfwPollEvents();
+        }
+        m_idleStats.lastWait = std::chrono::nanoseconds(0);
+    }
+    else {
+        System::FrameClock::Clock::time_point start = System::FrameClock::Clock::now();
+        if (m_window) {
+            glfwWaitEventsTimeout(m_idleTimeout);
+        }
+        else {
+            // Only #requestRedraw can end the wait without events, so it's left to the timeout
+            System::FrameClock::sleepUntil(start + std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(m_idleTimeout)));
+        }
+
+        m_idleStats.lastWait = System::FrameClock::Clock::now() - start;
+        m_idleStats.waits++;
+        m_idleMeasureWaited += m_idleStats.lastWait;
+    }
+
+    // Measure over whole seconds, so rates don't jump around from one frame to the next
+    System::FrameClock::Clock::time_point now = System::FrameClock::Clock::now();
+    std::chrono::duration<double> elapsed = now - m_idleMeasureStart;
+    if (elapsed.count() >= 1.0) {
+        std::chrono::nanoseconds cpu = System::FrameClock::getProcessCpuTime();
+        double busyMilliseconds = std::chrono::duration<double, std::milli>(elapsed).count()
+            - std::chrono::duration<double, std::milli>(m_idleMeasureWaited).count();
+
+        m_idleStats.framesPerSecond = m_idleMeasureFrames / elapsed.count();
+        m_idleStats.frameMilliseconds = m_idleMeasureFrames > 0 ? busyMilliseconds / m_idleMeasureFrames : 0.0;
+        m_idleStats.cpuUsage = std::chrono::duration<double>(cpu - m_idleMeasureCpu).count() / elapsed.count();
+
+        m_idleMeasureStart = now;
+        m_idleMeasureCpu = cpu;
+        m_idleMeasureFrames = 0;
+        m_idleMeasureWaited = std::chrono::nanoseconds(0);
+    }
+}
+
+void lov::Graphics::Window::setLowPowerMode(bool enabled, double timeoutSeconds) {
+    m_lowPower = enabled;
+    m_idleTimeout = std::max(timeoutSeconds, 0.0);
+    m_redraw = true;
+}
+
+void lov::Graphics::Window::requestRedraw() {
+    // Only wake the event loop when it might be waiting
+    if (!m_redraw.exchange(true) && m_window) {
+        glfwPostEmptyEvent();
+    }
+}
+
+bool lov::Graphics::Window::needsRedraw() {
+    if (m_lowPower && !m_redraw.exchange(false)) {
+        return false;
+    }
+
+    m_idleStats.framesDrawn++;
+    m_idleMeasureFrames++;
+    return true;
+}
+
+lov::Graphics::IdleStats lov::Graphics::Window::getIdleStats() const {
+    return m_idleStats;
+}
+
+void lov::Graphics::Window::setTitle(const std::string& title) {
+    if (!m_window) {
+        return;
+    }
+
+    glfwSetWindowTitle(m_window, title.c_str());
+}
+
+bool lov::Graphics::Window::setSwapInterval(int interval, bool adaptive) {
+    // Nothing offscreen waits for a vertical blank
+    if (m_mode == WindowMode::Headless) {
+        return false;
+    }
+
+    // A negative interval asks for adaptive sync, which needs one of the tear control extensions
+    adaptive = adaptive && interval > 0 && (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear"));
+    glfwSwapInterval(adaptive ? -interval : interval);
+    return adaptive;
+}
+
+void lov::Graphics::Window::setFrameRateLimit(double framesPerSecond) {
+    m_framePeriod = framesPerSecond > 0.0
+        ? std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / framesPerSecond))
+        : std::chrono::nanoseconds(0);
+    m_nextFrame = System::FrameClock::Clock::now();
+}
+
+void lov::Graphics::Window::setMaxFramesInFlight(lov_uint frames) {
+    m_maxFramesInFlight = frames;
+}
+
+lov::Input::InputQueue& lov::Graphics::Window::getInput() {
+    return m_input;
+}
 
-    // Poll events
-    glfwPollEvents();
+bool lov::Graphics::Window::setRawMouseMotion(bool raw) {
+    if (m_mode == WindowMode::Headless || !glfwRawMouseMotionSupported()) {
+        return false;
+    }
+
+    glfwSetInputMode(m_window, GLFW_RAW_MOUSE_MOTION, raw ? GLFW_TRUE : GLFW_FALSE);
+    return raw && glfwGetInputMode(m_window, GLFW_CURSOR) == GLFW_CURSOR_DISABLED;
+}
+
+lov::Graphics::FramePacingStats lov::Graphics::Window::getPacingStats() const {
+    return { m_limiterMilliseconds, m_fenceMilliseconds, m_framesInFlight };
 }
 
 float lov::Graphics::Window::getDeltaTime() {
     // Update delta time
-    float currentFrameTime = glfwGetTime();
-    float dt = currentFrameTime - m_recentFrameTime;
+    System::FrameClock::Clock::time_point currentFrameTime = System::FrameClock::Clock::now();
+    std::chrono::duration<double> dt = currentFrameTime - m_recentFrameTime;
     m_recentFrameTime = currentFrameTime;
-    return dt;
+    return static_cast<float>(dt.count());
 }
 
 lov::Input::KeyState lov::Graphics::Window::getKeyState(const Input::KeyCode& key) {
+    if (m_mode == WindowMode::Headless) {
+        return Input::KEY_RELEASE;
+    }
+
     int state = glfwGetKey(m_window, key);
 
     if (state == GLFW_PRESS) {
@@ -132,3 +456,115 @@ lov::Vector2f lov::Graphics::Window::getCursorOffset() {
 
     return mouseOffset;
 }
+
+bool lov::Graphics::Window::isHeadless() const {
+    return m_mode == WindowMode::Headless;
+}
+
+std::vector<uint8_t> lov::Graphics::Window::readPixels() const {
+    int width = m_framebufferWidth;
+    int height = m_framebufferHeight;
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+
+    // Rows are packed tightly, whatever the width
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return pixels;
+}
+
+void lov::Graphics::Window::destroyContext() {
+    // Cached sampler objects belong to the context rather than any texture, so they go with it
+    if (SamplerCache::getCount() > 0) {
+        makeCurrent();
+        SamplerCache::clear();
+    }
+
+#ifdef LOV_HAS_EGL
+    if (m_eglDisplay) {
+        // Deleting the context deletes the framebuffer with it
+        eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(m_eglDisplay, m_eglContext);
+        eglTerminate(m_eglDisplay);
+        m_eglDisplay = nullptr;
+        m_eglContext = nullptr;
+        return;
+    }
+#endif
+
+    glfwTerminate();
+    m_window = nullptr;
+}
+
+void lov::Graphics::Window::createSurfacelessContext() {
+#ifdef LOV_HAS_EGL
+    // Mesa's surfaceless platform needs no display server or GPU, so prefer it when the driver has it
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (clientExtensions && std::strstr(clientExtensions, "EGL_MESA_platform_surfaceless") && getPlatformDisplay) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        throw Exceptions::WindowException("Failed to initialize EGL for a headless lov::Graphics::Window");
+    }
+
+    const char* displayExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!displayExtensions || !std::strstr(displayExtensions, "EGL_KHR_surfaceless_context") || !eglBindAPI(EGL_OPENGL_API)) {
+        eglTerminate(display);
+        throw Exceptions::WindowException("EGL can't create a surfaceless OpenGL context for a headless lov::Graphics::Window");
+    }
+
+    // The context never draws to a surface, so any config that renders OpenGL will do, or none at all if that's allowed
+    const EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        config = nullptr;
+    }
+
+    // The same version and profile as a window's context
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+
+    if (context == EGL_NO_CONTEXT) {
+        eglTerminate(display);
+        throw Exceptions::WindowException("Failed to create a headless lov::Graphics::Window");
+    }
+
+    m_eglDisplay = display;
+    m_eglContext = context;
+    this->makeCurrent();
+#else
+    throw Exceptions::WindowException("Headless lov::Graphics::Window contexts need the engine built with EGL");
+#endif
+}
+
+void lov::Graphics::Window::createOffscreenFramebuffer(unsigned int width, unsigned int height) {
+    glGenRenderbuffers(1, &m_colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    // Nothing else binds a framebuffer, so this one stays bound for every draw, clear and read back
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw Exceptions::WindowException("Offscreen framebuffer of a headless lov::Graphics::Window isn't complete");
+    }
+}
@@ -0,0 +1,129 @@
+#include "Input/InputQueue.h"
+
+lov::Input::InputQueue::InputQueue(uint64_t capacity):
+    m_queue(capacity),
+    m_dropped(0),
+    m_cursorPosition(0.0f, 0.0f),
+    m_cursorDelta(0.0f, 0.0f),
+    m_scrollDelta(0.0f, 0.0f),
+    m_cursorKnown(false),
+    m_eventCount(0)
+{}
+
+void lov::Input::InputQueue::push(const InputEvent& event) {
+    if (!m_queue.push(event)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void lov::Input::InputQueue::update() {
+    m_keysPressed.reset();
+    m_keysReleased.reset();
+    m_buttonsPressed.reset();
+    m_buttonsReleased.reset();
+    m_cursorDelta = Vector2f(0.0f, 0.0f);
+    m_scrollDelta = Vector2f(0.0f, 0.0f);
+    m_events.clear();
+
+    InputEvent event;
+    while (m_queue.pop(event)) {
+        m_events.push_back(event);
+
+        switch (event.type) {
+        case InputEventType::KeyPress:
+            if (isKey(event.code)) {
+                m_keysDown.set(event.code);
+                m_keysPressed.set(event.code);
+            }
+            break;
+
+        case InputEventType::KeyRelease:
+            if (isKey(event.code)) {
+                m_keysDown.reset(event.code);
+                m_keysReleased.set(event.code);
+            }
+            break;
+
+        case InputEventType::ButtonPress:
+            if (isButton(event.code)) {
+                m_buttonsDown.set(event.code);
+                m_buttonsPressed.set(event.code);
+            }
+            break;
+
+        case InputEventType::ButtonRelease:
+            if (isButton(event.code)) {
+                m_buttonsDown.reset(event.code);
+                m_buttonsReleased.set(event.code);
+            }
+            break;
+
+        case InputEventType::CursorMove:
+            // The first position only sets where motion is measured from, so the cursor doesn't jump on entry
+            if (m_cursorKnown) {
+                m_cursorDelta += event.value - m_cursorPosition;
+            }
+            m_cursorPosition = event.value;
+            m_cursorKnown = true;
+            break;
+
+        case InputEventType::Scroll:
+            m_scrollDelta += event.value;
+            break;
+        }
+    }
+
+    m_eventCount += m_events.size();
+}
+
+bool lov::Input::InputQueue::isDown(KeyCode key) const {
+    return isKey(key) && m_keysDown.test(key);
+}
+
+bool lov::Input::InputQueue::wasPressed(KeyCode key) const {
+    return isKey(key) && m_keysPressed.test(key);
+}
+
+bool lov::Input::InputQueue::wasReleased(KeyCode key) const {
+    return isKey(key) && m_keysReleased.test(key);
+}
+
+bool lov::Input::InputQueue::isDown(MouseButton button) const {
+    return isButton(button) && m_buttonsDown.test(button);
+}
+
+bool lov::Input::InputQueue::wasPressed(MouseButton button) const {
+    return isButton(button) && m_buttonsPressed.test(button);
+}
+
+bool lov::Input::InputQueue::wasReleased(MouseButton button) const {
+    return isButton(button) && m_buttonsReleased.test(button);
+}
+
+lov::Vector2f lov::Input::InputQueue::getCursorPosition() const {
+    return m_cursorPosition;
+}
+
+lov::Vector2f lov::Input::InputQueue::getCursorDelta() const {
+    return m_cursorDelta;
+}
+
+lov::Vector2f lov::Input::InputQueue::getScrollDelta() const {
+    return m_scrollDelta;
+}
+
+std::span<const lov::Input::InputEvent> lov::Input::InputQueue::getEvents() const {
+    return m_events;
+}
+
+lov::Input::InputQueueStats lov::Input::InputQueue::getStats() const {
+    return { m_eventCount, m_dropped.load(std::memory_order_relaxed) };
+}
+
+bool lov::Input::InputQueue::isKey(int code) {
+    return code >= 0 && code <= KEY_LAST;
+}
+
+bool lov::Input::InputQueue::isButton(int code) {
+    return code >= 0 && code <= MOUSE_BUTTON_LAST;
+}
@@ -0,0 +1,348 @@
+#include "System/AssetPack.h"
+
+#include "System/Exceptions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    /// @brief The 8 bytes every pack starts with
+    const unsigned char IDENTIFIER[8] = { 'L', 'O', 'V', 'P', 'A', 'C', 'K', 0x1A };
+
+    /// @brief Version of the layout written by AssetPackWriter
+    const std::uint64_t VERSION = 1;
+
+    /// @brief Size of the identifier and header that precede the directory
+    const size_t HEADER_SIZE = 32;
+
+    /// @brief Size of each directory slot
+    const size_t SLOT_SIZE = 32;
+
+    /// @brief Append a little endian integer
+    /// @param out The buffer to append to
+    /// @param value The value
+    /// @param bytes The number of bytes to write
+    void put(std::vector<std::byte>& out, std::uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; i++) {
+            out.push_back(static_cast<std::byte>(value >> (i * 8)));
+        }
+    }
+
+    /// @brief Overwrite a little endian integer
+    /// @param out The buffer to write into
+    /// @param offset The byte offset of the integer
+    /// @param value The value
+    /// @param bytes The number of bytes to write
+    void putAt(std::vector<std::byte>& out, size_t offset, std::uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; i++) {
+            out[offset + i] = static_cast<std::byte>(value >> (i * 8));
+        }
+    }
+
+    /// @brief Read a little endian integer
+    /// @param data The buffer to read from
+    /// @param offset The byte offset of the integer
+    /// @param bytes The number of bytes to read
+    /// @return The value
+    std::uint64_t read(const std::byte* data, size_t offset, size_t bytes) {
+        std::uint64_t value = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            value |= static_cast<std::uint64_t>(data[offset + i]) << (i * 8);
+        }
+
+        return value;
+    }
+}
+
+lov::System::AssetPack::AssetPack(const std::string& path):
+    m_data(nullptr),
+    m_size(0),
+    m_assetCount(0),
+    m_slotCount(0),
+    m_file(nullptr),
+    m_mapping(nullptr)
+{
+#ifdef _WIN32
+    // Map the whole file read only
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw Exceptions::AssetException("Failed to open asset pack " + path);
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    HANDLE mapping = size.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+
+        CloseHandle(file);
+        throw Exceptions::AssetException("Failed to map asset pack " + path);
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const std::byte*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    // Map the whole file read only. The mapping keeps the file alive, so the descriptor can be closed straight away
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw Exceptions::AssetException("Failed to open asset pack " + path);
+    }
+
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+    }
+
+    close(file);
+    if (view == MAP_FAILED) {
+        throw Exceptions::AssetException("Failed to map asset pack " + path);
+    }
+
+    m_data = static_cast<const std::byte*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    try {
+        validate();
+    }
+    catch (const Exceptions::AssetException& e) {
+        unmap();
+        throw Exceptions::AssetException("Invalid asset pack " + path + ": " + e.what());
+    }
+}
+
+lov::System::AssetPack::~AssetPack() {
+    unmap();
+}
+
+std::span<const std::byte> lov::System::AssetPack::find(std::string_view name) const {
+    lov_uint slot = findSlot(name);
+    if (slot == m_slotCount) {
+        return {};
+    }
+
+    size_t entry = HEADER_SIZE + slot * SLOT_SIZE;
+    return { m_data + read(m_data, entry + 8, 8), static_cast<size_t>(read(m_data, entry + 16, 8)) };
+}
+
+std::span<const std::byte> lov::System::AssetPack::get(std::string_view name) const {
+    if (!contains(name)) {
+        throw Exceptions::AssetException("Asset pack has no asset " + std::string(name));
+    }
+
+    return find(name);
+}
+
+bool lov::System::AssetPack::contains(std::string_view name) const {
+    return findSlot(name) != m_slotCount;
+}
+
+lov::lov_size lov::System::AssetPack::getAssetCount() const {
+    return m_assetCount;
+}
+
+std::uint64_t lov::System::AssetPack::hashName(std::string_view name) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+lov::lov_uint lov::System::AssetPack::findSlot(std::string_view name) const {
+    if (m_slotCount == 0) {
+        return m_slotCount;
+    }
+
+    // Probe linearly from the hash's slot until the name or an empty slot turns up. There is always an empty slot
+    std::uint64_t hash = hashName(name);
+    for (lov_uint slot = static_cast<lov_uint>(hash & (m_slotCount - 1));; slot = (slot + 1) & (m_slotCount - 1)) {
+        size_t entry = HEADER_SIZE + slot * SLOT_SIZE;
+        size_t nameLength = static_cast<size_t>(read(m_data, entry + 28, 4));
+        if (nameLength == 0) {
+            return m_slotCount;
+        }
+
+        if (read(m_data, entry, 8) == hash && nameLength == name.size() &&
+            memcmp(m_data + read(m_data, entry + 24, 4), name.data(), nameLength) == 0) {
+            return slot;
+        }
+    }
+}
+
+void lov::System::AssetPack::validate() {
+    if (m_size < HEADER_SIZE || memcmp(m_data, IDENTIFIER, sizeof(IDENTIFIER)) != 0) {
+        throw Exceptions::AssetException("not an asset pack");
+    }
+
+    if (read(m_data, 8, 4) != VERSION) {
+        throw Exceptions::AssetException("unsupported version " + std::to_string(read(m_data, 8, 4)));
+    }
+
+    // The directory must fit and keep at least one empty slot so probing ends
+    std::uint64_t assetCount = read(m_data, 12, 4);
+    std::uint64_t slotCount = read(m_data, 16, 4);
+    if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || assetCount >= slotCount || slotCount > (m_size - HEADER_SIZE) / SLOT_SIZE) {
+        throw Exceptions::AssetException("malformed directory");
+    }
+
+    // Every name and asset must lie within the file, so lookups can trust them
+    std::uint64_t used = 0;
+    for (std::uint64_t slot = 0; slot < slotCount; slot++) {
+        size_t entry = HEADER_SIZE + slot * SLOT_SIZE;
+        std::uint64_t offset = read(m_data, entry + 8, 8);
+        std::uint64_t size = read(m_data, entry + 16, 8);
+        std::uint64_t nameOffset = read(m_data, entry + 24, 4);
+        std::uint64_t nameLength = read(m_data, entry + 28, 4);
+        if (nameLength == 0) {
+            continue;
+        }
+
+        if (nameOffset > m_size || nameLength > m_size - nameOffset || offset > m_size || size > m_size - offset) {
+            throw Exceptions::AssetException("asset out of bounds");
+        }
+
+        used++;
+    }
+
+    if (used != assetCount) {
+        throw Exceptions::AssetException("directory doesn't match its asset count");
+    }
+
+    // Only set once validated, since a malformed count would send lookups out of bounds
+    m_assetCount = static_cast<lov_uint>(assetCount);
+    m_slotCount = static_cast<lov_uint>(slotCount);
+}
+
+void lov::System::AssetPack::unmap() {
+    if (!m_data) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_file));
+#else
+    munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+void lov::System::AssetPackWriter::add(const std::string& name, std::vector<std::byte> contents) {
+    // Empty names mark empty slots, and duplicates could never be looked up
+    if (name.empty()) {
+        throw Exceptions::AssetException("Asset names can't be empty");
+    }
+
+    if (std::any_of(m_assets.begin(), m_assets.end(), [&](const Asset& asset) { return asset.name == name; })) {
+        throw Exceptions::AssetException("Asset " + name + " was already added");
+    }
+
+    m_assets.push_back({ name, std::move(contents) });
+}
+
+void lov::System::AssetPackWriter::addFile(const std::string& name, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw Exceptions::AssetException("Failed to open " + path);
+    }
+
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<std::byte> bytes(contents.size());
+    memcpy(bytes.data(), contents.data(), contents.size());
+    add(name, std::move(bytes));
+}
+
+std::vector<std::byte> lov::System::AssetPackWriter::write() const {
+    // Size the directory to at most half full, so probes stay short and always reach an empty slot
+    size_t slotCount = 1;
+    while (slotCount < m_assets.size() * 2) {
+        slotCount *= 2;
+    }
+
+    std::vector<std::byte> out;
+    for (unsigned char c : IDENTIFIER) {
+        out.push_back(static_cast<std::byte>(c));
+    }
+
+    // Header
+    put(out, VERSION, 4);
+    put(out, m_assets.size(), 4);
+    put(out, slotCount, 4);
+    put(out, AssetPack::ALIGNMENT, 4);
+    put(out, 0, 8);         // Reserved
+
+    // Directory, filled in once the offsets are known
+    out.resize(HEADER_SIZE + slotCount * SLOT_SIZE, std::byte(0));
+
+    // Names
+    std::vector<size_t> nameOffsets;
+    for (const Asset& asset : m_assets) {
+        nameOffsets.push_back(out.size());
+        for (char c : asset.name) {
+            out.push_back(static_cast<std::byte>(c));
+        }
+    }
+
+    for (size_t i = 0; i < m_assets.size(); i++) {
+        // Align each asset so views can be read as any type
+        out.resize((out.size() + AssetPack::ALIGNMENT - 1) / AssetPack::ALIGNMENT * AssetPack::ALIGNMENT, std::byte(0));
+        size_t offset = out.size();
+        out.insert(out.end(), m_assets[i].contents.begin(), m_assets[i].contents.end());
+
+        // Insert into the first free slot from the hash's slot
+        std::uint64_t hash = AssetPack::hashName(m_assets[i].name);
+        size_t slot = static_cast<size_t>(hash & (slotCount - 1));
+        while (read(out.data(), HEADER_SIZE + slot * SLOT_SIZE + 28, 4) != 0) {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+
+        size_t entry = HEADER_SIZE + slot * SLOT_SIZE;
+        putAt(out, entry, hash, 8);
+        putAt(out, entry + 8, offset, 8);
+        putAt(out, entry + 16, m_assets[i].contents.size(), 8);
+        putAt(out, entry + 24, nameOffsets[i], 4);
+        putAt(out, entry + 28, m_assets[i].name.size(), 4);
+    }
+
+    return out;
+}
+
+void lov::System::AssetPackWriter::writeFile(const std::string& path) const {
+    std::vector<std::byte> contents = write();
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(contents.data()), contents.size());
+    if (!file) {
+        throw Exceptions::AssetException("Failed to write " + path);
+    }
+}
+
+lov::lov_size lov::System::AssetPackWriter::getAssetCount() const {
+    return static_cast<lov_size>(m_assets.size());
+}
@@ -0,0 +1,352 @@
+#include "System/AssetStreamer.h"
+
+#include "System/Exceptions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+lov::System::AssetStreamer::AssetStreamer(AsyncIO& io, ThreadPool& pool, lov_size maxInFlight):
+    m_io(io),
+    m_pool(pool),
+    m_maxInFlight(std::max(maxInFlight, 1)),
+    m_frame(1),
+    m_inFlight(0),
+    m_stats()
+{
+    m_budgets.fill(std::numeric_limits<size_t>::max());
+}
+
+lov::System::AssetStreamer::~AssetStreamer() {
+    // Workers write into this object, so let them finish first. Destroying the entries destroys their read coroutines
+    for (std::future<void>& decoding : m_decoding) {
+        decoding.wait();
+    }
+}
+
+lov::lov_uint lov::System::AssetStreamer::add(const std::string& path, AssetType type, AssetCallbacks callbacks) {
+    Entry entry = {};
+    entry.path = path;
+    entry.type = type;
+    entry.callbacks = std::move(callbacks);
+    return addEntry(std::move(entry));
+}
+
+lov::lov_uint lov::System::AssetStreamer::add(std::span<const std::byte> bytes, AssetType type, AssetCallbacks callbacks) {
+    Entry entry = {};
+    entry.bytes = bytes;
+    entry.type = type;
+    entry.callbacks = std::move(callbacks);
+    return addEntry(std::move(entry));
+}
+
+void lov::System::AssetStreamer::remove(lov_uint asset) {
+    cancel(asset);
+
+    Entry& entry = m_entries[asset];
+    if (entry.state == State::Resident) {
+        evictEntry(entry);
+    }
+
+    entry = Entry();
+    m_freeEntries.push_back(asset);
+    m_stats.assetCount--;
+}
+
+void lov::System::AssetStreamer::request(lov_uint asset, float distance) {
+    Entry& entry = m_entries[asset];
+    entry.lastRequested = m_frame;
+
+    if (!entry.requested) {
+        entry.requested = true;
+        entry.distance = distance;
+        m_requested.push_back(asset);
+    }
+    else {
+        entry.distance = std::min(entry.distance, distance);
+    }
+}
+
+void lov::System::AssetStreamer::cancel(lov_uint asset) {
+    Entry& entry = m_entries[asset];
+    if (entry.requested) {
+        entry.requested = false;
+        m_requested.erase(std::find(m_requested.begin(), m_requested.end(), asset));
+    }
+
+    if (entry.state == State::Loading) {
+        stop(entry);
+        m_stats.cancellations++;
+    }
+}
+
+void lov::System::AssetStreamer::update(double budgetMilliseconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMilliseconds);
+
+    // Resume coroutines whose reads finished, which hand their bytes to a decode or straight to the queue
+    m_io.poll();
+
+    // Forget decodes that have queued their results
+    m_decoding.erase(std::remove_if(m_decoding.begin(), m_decoding.end(), [](const std::future<void>& decoding) {
+        return decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), m_decoding.end());
+
+    // Load one asset at a time until the budget runs out, carrying on past failures so one bad file can't stall the rest
+    std::string error;
+    while (std::chrono::steady_clock::now() < deadline && loadNext(error)) {}
+
+    for (size_t type = 0; type < m_budgets.size(); type++) {
+        evict(static_cast<AssetType>(type));
+    }
+
+    // Start the nearest requested assets whose type still has room
+    std::vector<lov_uint> waiting;
+    for (lov_uint asset : m_requested) {
+        const Entry& entry = m_entries[asset];
+        if (entry.requested && entry.state == State::Unloaded
+            && m_stats.residentBytes[static_cast<size_t>(entry.type)] < m_budgets[static_cast<size_t>(entry.type)]) {
+            waiting.push_back(asset);
+        }
+    }
+
+    std::sort(waiting.begin(), waiting.end(), [this](lov_uint left, lov_uint right) {
+        return m_entries[left].distance < m_entries[right].distance;
+    });
+
+    // Loads nobody asked for this frame give up their slots, least recently requested first
+    std::vector<lov_uint> preemptable;
+    if (m_inFlight + static_cast<lov_size>(waiting.size()) > m_maxInFlight) {
+        for (lov_uint i = 0; i < m_entries.size(); i++) {
+            if (m_entries[i].state == State::Loading && !m_entries[i].requested) {
+                preemptable.push_back(i);
+            }
+        }
+
+        std::sort(preemptable.begin(), preemptable.end(), [this](lov_uint left, lov_uint right) {
+            return m_entries[left].lastRequested < m_entries[right].lastRequested;
+        });
+    }
+
+    size_t preempted = 0;
+    size_t started = 0;
+    for (; started < waiting.size(); started++) {
+        if (m_inFlight >= m_maxInFlight) {
+            if (preempted == preemptable.size()) {
+                break;
+            }
+
+            stop(m_entries[preemptable[preempted++]]);
+            m_stats.cancellations++;
+        }
+
+        start(waiting[started]);
+    }
+
+    // Submit every read started this frame at once
+    m_io.flush();
+
+    m_stats.waitingCount = static_cast<lov_size>(waiting.size() - started);
+
+    // Begin the next frame
+    for (lov_uint asset : m_requested) {
+        m_entries[asset].requested = false;
+    }
+
+    m_requested.clear();
+    m_frame++;
+
+    if (!error.empty()) {
+        throw Exceptions::AssetException(error);
+    }
+}
+
+void lov::System::AssetStreamer::setBudget(AssetType type, size_t budgetBytes) {
+    m_budgets[static_cast<size_t>(type)] = budgetBytes;
+}
+
+void lov::System::AssetStreamer::setMaxInFlight(lov_size maxInFlight) {
+    m_maxInFlight = std::max(maxInFlight, 1);
+}
+
+bool lov::System::AssetStreamer::isResident(lov_uint asset) const {
+    return m_entries[asset].state == State::Resident;
+}
+
+lov::System::AssetStreamerStats lov::System::AssetStreamer::getStats() const {
+    AssetStreamerStats stats = m_stats;
+    stats.inFlightCount = m_inFlight;
+    return stats;
+}
+
+lov::lov_uint lov::System::AssetStreamer::addEntry(Entry entry) {
+    m_stats.assetCount++;
+
+    if (!m_freeEntries.empty()) {
+        lov_uint asset = m_freeEntries.back();
+        m_freeEntries.pop_back();
+        m_entries[asset] = std::move(entry);
+        return asset;
+    }
+
+    m_entries.push_back(std::move(entry));
+    return static_cast<lov_uint>(m_entries.size() - 1);
+}
+
+void lov::System::AssetStreamer::start(lov_uint asset) {
+    Entry& entry = m_entries[asset];
+    entry.state = State::Loading;
+    entry.load = std::make_shared<Load>();
+    entry.load->asset = asset;
+    m_inFlight++;
+
+    // Assets in memory skip the read, and without a decode go straight to their load callback
+    if (!entry.path.empty()) {
+        entry.task = read(entry.load, entry.path);
+    }
+    else if (entry.callbacks.decode) {
+        decode(entry.load, entry.bytes);
+    }
+    else {
+        finish(entry.load);
+    }
+}
+
+lov::System::Task lov::System::AssetStreamer::read(std::shared_ptr<Load> load, std::string path) {
+    try {
+        load->data = co_await m_io.read(path);
+    }
+    catch (const std::exception& exception) {
+        load->error = exception.what();
+        finish(load);
+        co_return;
+    }
+
+    // Resumed inside AsyncIO::poll, so the entry is still loading this read
+    if (m_entries[load->asset].callbacks.decode) {
+        decode(load, load->data);
+    }
+    else {
+        finish(load);
+    }
+}
+
+void lov::System::AssetStreamer::decode(std::shared_ptr<Load> load, std::span<const std::byte> bytes) {
+    // Copy the decoder, since the entry may be removed while the worker runs
+    auto decoder = m_entries[load->asset].callbacks.decode;
+
+    m_decoding.push_back(m_pool.submit([this, load, bytes, decoder]() {
+        if (!load->cancelled) {
+            try {
+                std::vector<std::byte> decoded = decoder(bytes);
+                load->data = std::move(decoded);
+            }
+            catch (const std::exception& exception) {
+                load->error = exception.what();
+            }
+        }
+
+        finish(load);
+    }));
+}
+
+void lov::System::AssetStreamer::finish(std::shared_ptr<Load> load) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished.push_back(std::move(load));
+}
+
+bool lov::System::AssetStreamer::loadNext(std::string& error) {
+    std::shared_ptr<Load> load;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_finished.empty()) {
+            return false;
+        }
+
+        load = std::move(m_finished.front());
+        m_finished.pop_front();
+    }
+
+    // Cancelled loads already gave up their slot
+    if (load->cancelled) {
+        return true;
+    }
+
+    Entry& entry = m_entries[load->asset];
+    entry.load.reset();
+    entry.task = Task();
+    m_inFlight--;
+
+    std::span<const std::byte> data = entry.path.empty() && !entry.callbacks.decode ? entry.bytes : std::span<const std::byte>(load->data);
+    if (load->error.empty()) {
+        try {
+            entry.residentBytes = entry.callbacks.load(data);
+        }
+        catch (const std::exception& exception) {
+            load->error = exception.what();
+        }
+    }
+
+    if (!load->error.empty()) {
+        entry.state = State::Failed;
+        m_stats.failures++;
+
+        if (error.empty()) {
+            error = "Failed to stream asset " + (entry.path.empty() ? std::to_string(load->asset) : entry.path) + ": " + load->error;
+        }
+
+        return true;
+    }
+
+    entry.state = State::Resident;
+    m_stats.residentCount++;
+    m_stats.residentBytes[static_cast<size_t>(entry.type)] += entry.residentBytes;
+    m_stats.loads++;
+    return true;
+}
+
+void lov::System::AssetStreamer::stop(Entry& entry) {
+    // A read is abandoned with its coroutine, while a decode runs on but its result is dropped
+    entry.load->cancelled = true;
+    entry.load.reset();
+    entry.task = Task();
+    entry.state = State::Unloaded;
+    m_inFlight--;
+}
+
+void lov::System::AssetStreamer::evict(AssetType type) {
+    size_t index = static_cast<size_t>(type);
+    if (m_stats.residentBytes[index] <= m_budgets[index]) {
+        return;
+    }
+
+    std::vector<lov_uint> candidates;
+    for (lov_uint i = 0; i < m_entries.size(); i++) {
+        if (m_entries[i].state == State::Resident && m_entries[i].type == type && !m_entries[i].requested) {
+            candidates.push_back(i);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [this](lov_uint left, lov_uint right) {
+        return m_entries[left].lastRequested < m_entries[right].lastRequested;
+    });
+
+    for (lov_uint asset : candidates) {
+        if (m_stats.residentBytes[index] <= m_budgets[index]) {
+            break;
+        }
+
+        evictEntry(m_entries[asset]);
+        m_stats.evictions++;
+    }
+}
+
+void lov::System::AssetStreamer::evictEntry(Entry& entry) {
+    if (entry.callbacks.evict) {
+        entry.callbacks.evict();
+    }
+
+    m_stats.residentBytes[static_cast<size_t>(entry.type)] -= entry.residentBytes;
+    m_stats.residentCount--;
+    entry.residentBytes = 0;
+    entry.state = State::Unloaded;
+}
@@ -0,0 +1,528 @@
+#include "System/AsyncIO.h"
+
+#include "System/Exceptions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+/// @brief The rings shared with the kernel, set up with raw system calls so there's no liburing dependency
+struct lov::System::AsyncIO::Ring {
+    int fd = -1;                        ///< The io_uring file descriptor
+    void* submissionMap = nullptr;      ///< Mapping of the submission ring
+    size_t submissionMapSize = 0;       ///< Size of the submission ring mapping
+    void* completionMap = nullptr;      ///< Mapping of the completion ring, which may be the submission mapping
+    size_t completionMapSize = 0;       ///< Size of the completion ring mapping
+    io_uring_sqe* entries = nullptr;    ///< Submission queue entries
+    size_t entriesSize = 0;             ///< Size of the entries mapping
+
+    unsigned* submissionHead = nullptr; ///< Advanced by the kernel as it consumes entries
+    unsigned* submissionTail = nullptr; ///< Advanced by us as we add entries
+    unsigned* submissionArray = nullptr; ///< Indices of the entries in submission order
+    unsigned submissionMask = 0;        ///< Slot count minus one
+    unsigned completionMask = 0;        ///< Slot count minus one
+    unsigned* completionHead = nullptr; ///< Advanced by us as we consume completions
+    unsigned* completionTail = nullptr; ///< Advanced by the kernel as it posts completions
+    io_uring_cqe* completions = nullptr; ///< Completion queue entries
+
+    unsigned capacity = 0;              ///< Most reads in flight at once
+    unsigned inFlight = 0;              ///< Reads submitted and not yet completed
+    unsigned unsubmitted = 0;           ///< Entries added since the last io_uring_enter
+
+    /// @brief Set up an io_uring that supports reads
+    /// @param queueDepth The submission queue size
+    /// @return Whether the ring is usable
+    bool setUp(unsigned queueDepth) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+        if (fd < 0) {
+            return false;
+        }
+
+        // Reads need kernel 5.6, so ask the kernel which operations it supports
+        size_t probeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+        std::vector<unsigned char> probeStorage(probeSize, 0);
+        io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeStorage.data());
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+            probe->ops_len <= IORING_OP_READ || !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+
+        // Map the rings, which newer kernels let share one mapping
+        submissionMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        completionMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            submissionMapSize = completionMapSize = std::max(submissionMapSize, completionMapSize);
+        }
+
+        void* map = mmap(nullptr, submissionMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+
+        submissionMap = map;
+        if (singleMap) {
+            completionMap = submissionMap;
+        }
+        else {
+            map = mmap(nullptr, completionMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (map == MAP_FAILED) {
+                return false;
+            }
+
+            completionMap = map;
+        }
+
+        entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+        map = mmap(nullptr, entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+
+        entries = static_cast<io_uring_sqe*>(map);
+
+        unsigned char* submission = static_cast<unsigned char*>(submissionMap);
+        submissionHead = reinterpret_cast<unsigned*>(submission + params.sq_off.head);
+        submissionTail = reinterpret_cast<unsigned*>(submission + params.sq_off.tail);
+        submissionMask = *reinterpret_cast<unsigned*>(submission + params.sq_off.ring_mask);
+        submissionArray = reinterpret_cast<unsigned*>(submission + params.sq_off.array);
+
+        unsigned char* completion = static_cast<unsigned char*>(completionMap);
+        completionHead = reinterpret_cast<unsigned*>(completion + params.cq_off.head);
+        completionTail = reinterpret_cast<unsigned*>(completion + params.cq_off.tail);
+        completionMask = *reinterpret_cast<unsigned*>(completion + params.cq_off.ring_mask);
+        completions = reinterpret_cast<io_uring_cqe*>(completion + params.cq_off.cqes);
+
+        capacity = std::min(params.sq_entries, params.cq_entries);
+        return true;
+    }
+
+    /// @brief Unmap the rings and close the descriptor
+    ~Ring() {
+        if (entries) {
+            munmap(entries, entriesSize);
+        }
+
+        if (completionMap && completionMap != submissionMap) {
+            munmap(completionMap, completionMapSize);
+        }
+
+        if (submissionMap) {
+            munmap(submissionMap, submissionMapSize);
+        }
+
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+namespace {
+    /// @brief Enter the ring to submit entries and optionally wait for completions
+    /// @param fd The io_uring descriptor
+    /// @param toSubmit Entries to submit
+    /// @param minComplete Completions to wait for
+    /// @return The number submitted, or -1 with errno set
+    int enterRing(int fd, unsigned toSubmit, unsigned minComplete) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, minComplete > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+    }
+}
+#else
+/// @brief Placeholder where io_uring doesn't exist
+struct lov::System::AsyncIO::Ring {};
+#endif
+
+lov::System::AsyncIO::ReadOperation::ReadOperation(AsyncIO& io, std::string path):
+    m_io(io),
+    m_request(makeRequest(std::move(path))),
+    m_waiter{ nullptr, 0 }
+{}
+
+bool lov::System::AsyncIO::ReadOperation::await_ready() const noexcept {
+    return false;
+}
+
+void lov::System::AsyncIO::ReadOperation::await_suspend(std::coroutine_handle<> handle) {
+    m_waiter = { handle, 1 };
+    m_request->waiter = &m_waiter;
+    m_io.submit(m_request);
+}
+
+std::vector<std::byte> lov::System::AsyncIO::ReadOperation::await_resume() {
+    m_waiter.handle = nullptr;
+    if (!m_request->error.empty()) {
+        throw Exceptions::IOException("Failed to read " + m_request->path + ": " + m_request->error);
+    }
+
+    return std::move(m_request->data);
+}
+
+lov::System::AsyncIO::ReadOperation::~ReadOperation() {
+    // The AsyncIO is only touched while the coroutine is queued to resume, which it can't be once the AsyncIO is gone
+    m_request->waiter = nullptr;
+    if (m_waiter.handle && m_waiter.remaining == 0) {
+        m_io.cancel(&m_waiter);
+    }
+}
+
+lov::System::AsyncIO::BatchReadOperation::BatchReadOperation(AsyncIO& io, const std::vector<std::string>& paths):
+    m_io(io),
+    m_waiter{ nullptr, 0 }
+{
+    for (const std::string& path : paths) {
+        m_requests.push_back(makeRequest(path));
+    }
+}
+
+bool lov::System::AsyncIO::BatchReadOperation::await_ready() const noexcept {
+    return m_requests.empty();
+}
+
+void lov::System::AsyncIO::BatchReadOperation::await_suspend(std::coroutine_handle<> handle) {
+    // Count every read before submitting any, so an early finish can't resume the coroutine too soon
+    m_waiter = { handle, m_requests.size() };
+    for (std::shared_ptr<Request>& request : m_requests) {
+        request->waiter = &m_waiter;
+    }
+
+    for (std::shared_ptr<Request>& request : m_requests) {
+        m_io.submit(request);
+    }
+
+    m_io.flush();
+}
+
+std::vector<std::vector<std::byte>> lov::System::AsyncIO::BatchReadOperation::await_resume() {
+    m_waiter.handle = nullptr;
+    std::vector<std::vector<std::byte>> contents;
+    contents.reserve(m_requests.size());
+    for (std::shared_ptr<Request>& request : m_requests) {
+        if (!request->error.empty()) {
+            throw Exceptions::IOException("Failed to read " + request->path + ": " + request->error);
+        }
+
+        contents.push_back(std::move(request->data));
+    }
+
+    return contents;
+}
+
+lov::System::AsyncIO::BatchReadOperation::~BatchReadOperation() {
+    for (std::shared_ptr<Request>& request : m_requests) {
+        request->waiter = nullptr;
+    }
+
+    if (m_waiter.handle && m_waiter.remaining == 0) {
+        m_io.cancel(&m_waiter);
+    }
+}
+
+lov::System::AsyncIO::AsyncIO(ThreadPool& pool, lov_uint queueDepth, Backend backend):
+    m_pool(pool),
+    m_pending(0),
+    m_submitCount(0)
+{
+#ifdef __linux__
+    // Fall back to the pool if the kernel is too old or io_uring is disabled, such as by a container's seccomp profile
+    if (backend == Backend::IoUring) {
+        m_ring = std::make_unique<Ring>();
+        if (!m_ring->setUp(std::max<lov_uint>(queueDepth, 1))) {
+            m_ring.reset();
+        }
+    }
+#else
+    (void)queueDepth;
+    (void)backend;
+#endif
+}
+
+lov::System::AsyncIO::~AsyncIO() {
+    // Coroutines queued to resume never will, so their operations mustn't look for themselves in the queue
+    for (Waiter* waiter : m_ready) {
+        waiter->handle = nullptr;
+    }
+
+#ifdef __linux__
+    // The kernel may still be writing into buffers owned by suspended coroutines
+    if (m_ring) {
+        for (Request* request : m_waiting) {
+            close(request->file);
+            request->self.reset();
+        }
+
+        m_waiting.clear();
+        while (m_ring->inFlight > 0) {
+            enterRing(m_ring->fd, m_ring->unsubmitted, 1);
+            m_ring->unsubmitted = 0;
+            unsigned head = *m_ring->completionHead;
+            unsigned tail = std::atomic_ref<unsigned>(*m_ring->completionTail).load(std::memory_order_acquire);
+            for (; head != tail; head++) {
+                Request* request = reinterpret_cast<Request*>(m_ring->completions[head & m_ring->completionMask].user_data);
+                close(request->file);
+                request->self.reset();
+                m_ring->inFlight--;
+            }
+
+
+            std::atomic_ref<unsigned>(*m_ring->completionHead).store(head, std::memory_order_release);
+        }
+    }
+#endif
+
+    // Workers write into their requests too, and every pending read is on a worker without a ring
+    if (!m_ring) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_finished.size() == static_cast<size_t>(m_pending); });
+        for (Request* request : m_finished) {
+            request->self.reset();
+        }
+    }
+}
+
+lov::System::AsyncIO::ReadOperation lov::System::AsyncIO::read(std::string path) {
+    return ReadOperation(*this, std::move(path));
+}
+
+lov::System::AsyncIO::BatchReadOperation lov::System::AsyncIO::readAll(const std::vector<std::string>& paths) {
+    return BatchReadOperation(*this, paths);
+}
+
+void lov::System::AsyncIO::flush() {
+    if (m_ring) {
+        submitToRing();
+    }
+}
+
+lov::lov_size lov::System::AsyncIO::poll() {
+    // Gather finished reads, then resume outside the loop, since resumed coroutines may start more reads
+    if (m_ring) {
+        reapRing();
+    }
+    else {
+        collectFinished();
+    }
+
+    // Pop each before resuming it, so a coroutine destroyed by an earlier one can take itself off the queue
+    lov_size resumed = 0;
+    while (!m_ready.empty()) {
+        std::coroutine_handle<> handle = m_ready.front()->handle;
+        m_ready.pop_front();
+        handle.resume();
+        resumed++;
+    }
+
+    // Submit retried and continued reads along with any the resumed coroutines started, all in one call
+    flush();
+
+    return resumed;
+}
+
+void lov::System::AsyncIO::wait() {
+    poll();
+    while (m_pending > 0 || !m_ready.empty()) {
+        // Block until something finishes, then resume whatever did
+#ifdef __linux__
+        if (m_ring && m_ring->inFlight > 0 && m_ready.empty()) {
+            if (m_ring->unsubmitted > 0) {
+                m_submitCount++;
+            }
+
+            enterRing(m_ring->fd, m_ring->unsubmitted, 1);
+            m_ring->unsubmitted = 0;
+        }
+#endif
+        if (!m_ring && m_ready.empty()) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return !m_finished.empty(); });
+        }
+
+        poll();
+    }
+}
+
+lov::lov_size lov::System::AsyncIO::getPendingCount() const {
+    return m_pending;
+}
+
+lov::lov_size lov::System::AsyncIO::getSubmitCount() const {
+    return m_submitCount;
+}
+
+lov::System::AsyncIO::Backend lov::System::AsyncIO::getBackend() const {
+    return m_ring ? Backend::IoUring : Backend::ThreadPool;
+}
+
+void lov::System::AsyncIO::submit(const std::shared_ptr<Request>& requestPointer) {
+    // Own the read until it finishes, in case its coroutine is destroyed first
+    Request* request = requestPointer.get();
+    request->self = requestPointer;
+    m_pending++;
+
+    if (!m_ring) {
+        m_pool.submit([this, request]() { readOnWorker(request); });
+        return;
+    }
+
+#ifdef __linux__
+    // Opening and sizing hit the inode cache and are cheap, so only the read itself goes through the ring
+    request->file = open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (request->file < 0 || fstat(request->file, &info) != 0) {
+        request->error = strerror(errno);
+        if (request->file >= 0) {
+            close(request->file);
+            request->file = -1;
+        }
+
+        finish(request);
+        return;
+    }
+
+    request->data.resize(static_cast<size_t>(info.st_size));
+    if (request->data.empty()) {
+        close(request->file);
+        request->file = -1;
+        finish(request);
+        return;
+    }
+
+    // Wait for the next flush, so reads started together go to the kernel together
+    m_waiting.push_back(request);
+#endif
+}
+
+void lov::System::AsyncIO::readOnWorker(Request* request) {
+    std::ifstream file(request->path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        request->error = "could not open file";
+    }
+    else {
+        // Size from the end position, then read everything at once
+        request->data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(request->data.data()), request->data.size());
+        if (!file) {
+            request->error = "could not read file";
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished.push_back(request);
+    m_condition.notify_all();
+}
+
+void lov::System::AsyncIO::submitToRing() {
+#ifdef __linux__
+    // Fill free submission slots from the waiting reads. Staying within capacity keeps the completion ring from overflowing
+    unsigned tail = *m_ring->submissionTail;
+    while (!m_waiting.empty() && m_ring->inFlight < m_ring->capacity) {
+        Request* request = m_waiting.front();
+        m_waiting.pop_front();
+
+        unsigned index = tail & m_ring->submissionMask;
+        io_uring_sqe& entry = m_ring->entries[index];
+        memset(&entry, 0, sizeof(entry));
+        entry.opcode = IORING_OP_READ;
+        entry.fd = request->file;
+        entry.addr = reinterpret_cast<std::uint64_t>(request->data.data() + request->offset);
+        entry.len = static_cast<std::uint32_t>(std::min<size_t>(request->data.size() - request->offset, 1u << 30));
+        entry.off = request->offset;
+        entry.user_data = reinterpret_cast<std::uint64_t>(request);
+        m_ring->submissionArray[index] = index;
+
+        tail++;
+        m_ring->inFlight++;
+        m_ring->unsubmitted++;
+    }
+
+    std::atomic_ref<unsigned>(*m_ring->submissionTail).store(tail, std::memory_order_release);
+    if (m_ring->unsubmitted > 0) {
+        m_submitCount++;
+        int submitted = enterRing(m_ring->fd, m_ring->unsubmitted, 0);
+        if (submitted > 0) {
+            m_ring->unsubmitted -= static_cast<unsigned>(submitted);
+        }
+    }
+#endif
+}
+
+void lov::System::AsyncIO::reapRing() {
+#ifdef __linux__
+    unsigned head = *m_ring->completionHead;
+    unsigned tail = std::atomic_ref<unsigned>(*m_ring->completionTail).load(std::memory_order_acquire);
+    for (; head != tail; head++) {
+        const io_uring_cqe& completion = m_ring->completions[head & m_ring->completionMask];
+        Request* request = reinterpret_cast<Request*>(completion.user_data);
+        m_ring->inFlight--;
+
+        // Retry interrupted reads, continue short reads, and finish on errors, the end of the data or the end of the file
+        if (completion.res == -EAGAIN || completion.res == -EINTR) {
+            m_waiting.push_back(request);
+            continue;
+        }
+
+        if (completion.res < 0) {
+            request->error = strerror(-completion.res);
+        }
+        else if (completion.res == 0) {
+            request->data.resize(request->offset);
+        }
+        else {
+            request->offset += static_cast<size_t>(completion.res);
+            if (request->offset < request->data.size()) {
+                m_waiting.push_back(request);
+                continue;
+            }
+        }
+
+        close(request->file);
+        request->file = -1;
+        finish(request);
+    }
+
+    std::atomic_ref<unsigned>(*m_ring->completionHead).store(head, std::memory_order_release);
+#endif
+}
+
+void lov::System::AsyncIO::finish(Request* request) {
+    m_pending--;
+    if (request->waiter && --request->waiter->remaining == 0) {
+        m_ready.push_back(request->waiter);
+    }
+
+    request->self.reset();
+}
+
+void lov::System::AsyncIO::cancel(Waiter* waiter) {
+    m_ready.erase(std::remove(m_ready.begin(), m_ready.end(), waiter), m_ready.end());
+}
+
+std::shared_ptr<lov::System::AsyncIO::Request> lov::System::AsyncIO::makeRequest(std::string path) {
+    return std::make_shared<Request>(Request{ std::move(path), {}, 0, -1, {}, nullptr, nullptr });
+}
+
+void lov::System::AsyncIO::collectFinished() {
+    std::vector<Request*> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        finished.swap(m_finished);
+    }
+
+    for (Request* request : finished) {
+        finish(request);
+    }
+}
@@ -13,3 +13,18 @@ lov::Exceptions::ShaderException::ShaderException(const std::string& message): E
 
 lov::Exceptions::WindowException::WindowException(const char* message): Exception(message) {}
 lov::Exceptions::WindowException::WindowException(const std::string& message): Exception(message) {}
+
+lov::Exceptions::TextureException::TextureException(const char* message): Exception(message) {}
+lov::Exceptions::TextureException::TextureException(const std::string& message): Exception(message) {}
+
+lov::Exceptions::AssetException::AssetException(const char* message): Exception(message) {}
+lov::Exceptions::AssetException::AssetException(const std::string& message): Exception(message) {}
+
+lov::Exceptions::IOException::IOException(const char* message): Exception(message) {}
+lov::Exceptions::IOException::IOException(const std::string& message): Exception(message) {}
+
+lov::Exceptions::MeshException::MeshException(const char* message): Exception(message) {}
+lov::Exceptions::MeshException::MeshException(const std::string& message): Exception(message) {}
+
+lov::Exceptions::EntityException::EntityException(const char* message): Exception(message) {}
+lov::Exceptions::EntityException::EntityException(const std::string& message): Exception(message) {}
@@ -0,0 +1,105 @@
+#include "System/FrameClock.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+lov::System::FrameClock::FrameClock(std::chrono::nanoseconds step, lov_uint maxSteps):
+    m_step(std::max(step, std::chrono::nanoseconds(1))),
+    m_maxSteps(std::max(maxSteps, 1u)),
+    m_frameStart(Clock::now()),
+    m_frameTime(0),
+    m_accumulator(0),
+    m_stats{ 0, 0, 0, 0 }
+{}
+
+lov::lov_uint lov::System::FrameClock::tick() {
+    Clock::time_point now = Clock::now();
+    std::chrono::nanoseconds elapsed = now - m_frameStart;
+    m_frameStart = now;
+    return advance(elapsed);
+}
+
+lov::lov_uint lov::System::FrameClock::advance(std::chrono::nanoseconds elapsed) {
+    m_frameTime = std::max(elapsed, std::chrono::nanoseconds(0));
+    m_accumulator += m_frameTime;
+
+    int64_t steps = m_accumulator / m_step;
+    m_accumulator -= m_step * steps;
+
+    // Drop what can't be caught up this frame, keeping the remainder so the interpolation doesn't jump
+    if (steps > m_maxSteps) {
+        m_stats.droppedSteps += static_cast<uint64_t>(steps - m_maxSteps);
+        steps = m_maxSteps;
+    }
+
+    m_stats.frames++;
+    m_stats.steps += static_cast<uint64_t>(steps);
+    m_stats.frameSteps = static_cast<lov_uint>(steps);
+    return m_stats.frameSteps;
+}
+
+void lov::System::FrameClock::skip(std::chrono::nanoseconds time) {
+    Clock::time_point now = Clock::now();
+    m_frameStart = std::min(m_frameStart + std::max(time, std::chrono::nanoseconds(0)), now);
+}
+
+double lov::System::FrameClock::getDeltaTime() const {
+    return std::chrono::duration<double>(m_frameTime).count();
+}
+
+float lov::System::FrameClock::getStep() const {
+    return std::chrono::duration<float>(m_step).count();
+}
+
+float lov::System::FrameClock::getAlpha() const {
+    return static_cast<float>(static_cast<double>(m_accumulator.count()) / static_cast<double>(m_step.count()));
+}
+
+double lov::System::FrameClock::getTime() const {
+    return std::chrono::duration<double>(m_step).count() * static_cast<double>(m_stats.steps);
+}
+
+lov::System::FrameClockStats lov::System::FrameClock::getStats() const {
+    return m_stats;
+}
+
+void lov::System::FrameClock::sleepUntil(Clock::time_point deadline) {
+    Clock::time_point now = Clock::now();
+    if (deadline - now > SpinMargin) {
+        std::this_thread::sleep_until(deadline - SpinMargin);
+    }
+
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+std::chrono::nanoseconds lov::System::FrameClock::getProcessCpuTime() {
+#ifdef _WIN32
+    // Kernel and user times are in 100 nanosecond ticks
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    uint64_t ticks = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32 | kernel.dwLowDateTime)
+        + (static_cast<uint64_t>(user.dwHighDateTime) << 32 | user.dwLowDateTime);
+    return std::chrono::nanoseconds(ticks * 100);
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
@@ -0,0 +1,299 @@
+#include "System/JobSystem.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+struct lov::System::JobCounter::Job {
+    std::function<void()> function; ///< The work
+    JobCounter* counter;            ///< Counts the job until it finishes, or null
+};
+
+namespace {
+    thread_local lov::System::JobSystem* t_system = nullptr;    ///< JobSystem the calling thread takes part in
+    thread_local lov::lov_int t_index = -1;                     ///< Index of the calling thread's deque in t_system
+    thread_local uint32_t t_random = 0;                         ///< Xorshift state used to pick who to steal from
+
+    /// @brief Pick a pseudo random number, cheaply, for spreading thieves over victims
+    /// @return The number
+    uint32_t nextRandom() {
+        if (t_random == 0) {
+            t_random = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+        }
+
+        t_random ^= t_random << 13;
+        t_random ^= t_random >> 17;
+        t_random ^= t_random << 5;
+        return t_random;
+    }
+}
+
+lov::System::JobCounter::JobCounter():
+    m_count(0)
+{}
+
+bool lov::System::JobCounter::isDone() const {
+    if (m_count.load(std::memory_order_acquire) != 0) {
+        return false;
+    }
+
+    // The last job decrements under the lock, so once it's free the counter is no longer in use
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return true;
+}
+
+lov::System::JobSystem::JobSystem(lov_size threadCount):
+    m_queued(0),
+    m_sleeping(0),
+    m_stopping(false)
+{
+    // Leave one hardware thread for the constructing thread by default
+    if (threadCount <= 0) {
+        threadCount = std::max(static_cast<lov_size>(std::thread::hardware_concurrency()) - 1, 1);
+    }
+
+    for (lov_size i = 0; i <= threadCount; i++) {
+        m_deques.push_back(std::make_unique<WorkStealingDeque<Job*>>());
+    }
+
+    // The constructing thread takes the first deque
+    m_previous = t_system;
+    t_system = this;
+    t_index = 0;
+
+    for (lov_size i = 1; i <= threadCount; i++) {
+        m_workers.emplace_back(&JobSystem::work, this, i);
+    }
+}
+
+lov::System::JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+
+    m_wake.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+
+    if (t_system == this) {
+        t_system = m_previous;
+        t_index = m_previous ? 0 : -1;
+    }
+}
+
+void lov::System::JobSystem::run(std::function<void()> job, JobCounter* counter) {
+    if (counter) {
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    push(new Job{ std::move(job), counter });
+}
+
+void lov::System::JobSystem::runAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter) {
+    if (counter) {
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job* waiting = new Job{ std::move(job), counter };
+    {
+        // The dependency's last job takes its continuations under the same lock it decrements under
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (dependency.m_count.load(std::memory_order_relaxed) != 0) {
+            dependency.m_continuations.push_back(waiting);
+            return;
+        }
+    }
+
+    push(waiting);
+}
+
+void lov::System::JobSystem::parallelFor(lov_size count, std::function<void(lov_size begin, lov_size end)> body, JobCounter& counter, lov_size grainSize) {
+    if (count <= 0) {
+        return;
+    }
+
+    // Aim for several ranges per thread, so thieves can even out ranges that take longer than others
+    if (grainSize <= 0) {
+        grainSize = std::max(count / (getThreadCount() * 8), 1);
+    }
+
+    // The caller may return before the ranges run, so every job shares the body instead of referring to the argument
+    auto shared = std::make_shared<const std::function<void(lov_size begin, lov_size end)>>(std::move(body));
+    run([this, count, shared, &counter, grainSize]() { split(0, count, shared, counter, grainSize); }, &counter);
+}
+
+void lov::System::JobSystem::parallelFor(lov_size count, const std::function<void(lov_size begin, lov_size end)>& body, lov_size grainSize) {
+    JobCounter counter;
+    parallelFor(count, body, counter, grainSize);
+    wait(counter);
+}
+
+void lov::System::JobSystem::wait(JobCounter& counter) {
+    lov_int index = getThreadIndex();
+
+    // Help out rather than block, which also keeps jobs that wait on other jobs from deadlocking
+    while (counter.m_count.load(std::memory_order_acquire) != 0) {
+        if (Job* job = take(index)) {
+            execute(job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        exception = std::exchange(counter.m_exception, nullptr);
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+lov::lov_size lov::System::JobSystem::getThreadCount() const {
+    return static_cast<lov_size>(m_deques.size());
+}
+
+void lov::System::JobSystem::push(Job* job) {
+    // Count the job first, so a worker can't take it and decrement before it's counted
+    m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+    lov_int index = getThreadIndex();
+    if (index >= 0) {
+        m_deques[index]->push(job);
+    }
+    else {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        m_shared.push_back(job);
+    }
+
+    if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+lov::System::JobSystem::Job* lov::System::JobSystem::take(lov_int index) {
+    if (index >= 0) {
+        if (Job* job = m_deques[index]->pop()) {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    if (m_queued.load(std::memory_order_relaxed) <= 0) {
+        return nullptr;
+    }
+
+    // Start at a random victim, so thieves don't all fight over the same deque
+    size_t dequeCount = m_deques.size();
+    size_t first = nextRandom() % dequeCount;
+    for (size_t i = 0; i < dequeCount; i++) {
+        size_t victim = (first + i) % dequeCount;
+        if (static_cast<lov_int>(victim) == index) {
+            continue;
+        }
+
+        if (Job* job = m_deques[victim]->steal()) {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_sharedMutex);
+    if (m_shared.empty()) {
+        return nullptr;
+    }
+
+    Job* job = m_shared.front();
+    m_shared.pop_front();
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+void lov::System::JobSystem::execute(Job* job) {
+    JobCounter* counter = job->counter;
+
+    try {
+        job->function();
+    }
+    catch (...) {
+        if (!counter) {
+            throw;
+        }
+
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (!counter->m_exception) {
+            counter->m_exception = std::current_exception();
+        }
+    }
+
+    // Release what the job captured before anyone waiting on it can return
+    delete job;
+
+    if (!counter) {
+        return;
+    }
+
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ready.swap(counter->m_continuations);
+        }
+    }
+
+    for (Job* continuation : ready) {
+        push(continuation);
+    }
+}
+
+void lov::System::JobSystem::split(lov_size begin, lov_size end, const std::shared_ptr<const std::function<void(lov_size begin, lov_size end)>>& body, JobCounter& counter, lov_size grainSize) {
+    // Hand the upper half to thieves and keep halving the lower one, so the biggest pieces are the ones stolen
+    while (end - begin > grainSize) {
+        lov_size middle = begin + (end - begin) / 2;
+        run([this, middle, end, body, &counter, grainSize]() { split(middle, end, body, counter, grainSize); }, &counter);
+        end = middle;
+    }
+
+    (*body)(begin, end);
+}
+
+void lov::System::JobSystem::work(lov_int index) {
+    t_system = this;
+    t_index = index;
+
+    while (true) {
+        // Spin briefly before sleeping, since more jobs usually follow soon after a frame's first
+        Job* job = nullptr;
+        for (int attempt = 0; attempt < 64 && !job; attempt++) {
+            job = take(index);
+            if (!job) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (job) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_wake.wait(lock, [this]() { return m_queued.load(std::memory_order_seq_cst) > 0 || m_stopping; });
+        m_sleeping.fetch_sub(1, std::memory_order_seq_cst);
+
+        if (m_stopping && m_queued.load(std::memory_order_seq_cst) <= 0) {
+            return;
+        }
+    }
+}
+
+lov::lov_int lov::System::JobSystem::getThreadIndex() const {
+    return t_system == this ? t_index : -1;
+}
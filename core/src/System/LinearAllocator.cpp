@@ -0,0 +1,58 @@
+#include "System/LinearAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+lov::System::LinearAllocator::LinearAllocator(size_t blockSize):
+    m_blockSize(std::max(blockSize, static_cast<size_t>(256))),
+    m_block(0),
+    m_offset(0),
+    m_used(0)
+{}
+
+void* lov::System::LinearAllocator::allocate(size_t size, size_t alignment) {
+    // Try the current block, then the ones after it kept from earlier frames, then a new one
+    while (m_block < m_blocks.size()) {
+        Block& block = m_blocks[m_block];
+        uintptr_t start = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t offset = ((start + m_offset + alignment - 1) & ~(alignment - 1)) - start;
+
+        if (offset + size <= block.size) {
+            m_offset = offset + size;
+            return block.data.get() + offset;
+        }
+
+        m_used += m_offset;
+        m_block++;
+        m_offset = 0;
+    }
+
+    // new[] only aligns to max_align_t, so leave room to align further
+    size_t blockSize = std::max(m_blockSize, size + alignment);
+    m_blocks.push_back({ std::make_unique<std::byte[]>(blockSize), blockSize });
+    m_block = m_blocks.size() - 1;
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(m_blocks.back().data.get());
+    size_t offset = ((start + alignment - 1) & ~(alignment - 1)) - start;
+    m_offset = offset + size;
+    return m_blocks.back().data.get() + offset;
+}
+
+void lov::System::LinearAllocator::reset() {
+    m_block = 0;
+    m_offset = 0;
+    m_used = 0;
+}
+
+size_t lov::System::LinearAllocator::getUsed() const {
+    return m_used + m_offset;
+}
+
+size_t lov::System::LinearAllocator::getCapacity() const {
+    size_t capacity = 0;
+    for (const Block& block : m_blocks) {
+        capacity += block.size;
+    }
+
+    return capacity;
+}
@@ -0,0 +1,85 @@
+#include "System/Task.h"
+
+#include <utility>
+
+bool lov::System::Task::promise_type::FinalAwaiter::await_ready() const noexcept {
+    return false;
+}
+
+std::coroutine_handle<> lov::System::Task::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    // Symmetric transfer, so long chains of awaiting tasks don't grow the stack
+    std::coroutine_handle<> continuation = handle.promise().continuation;
+    return continuation ? continuation : std::noop_coroutine();
+}
+
+void lov::System::Task::promise_type::FinalAwaiter::await_resume() const noexcept {}
+
+lov::System::Task lov::System::Task::promise_type::get_return_object() {
+    return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+std::suspend_never lov::System::Task::promise_type::initial_suspend() const noexcept {
+    return {};
+}
+
+lov::System::Task::promise_type::FinalAwaiter lov::System::Task::promise_type::final_suspend() const noexcept {
+    return {};
+}
+
+void lov::System::Task::promise_type::return_void() const noexcept {}
+
+void lov::System::Task::promise_type::unhandled_exception() {
+    exception = std::current_exception();
+}
+
+lov::System::Task::Task():
+    m_handle(nullptr)
+{}
+
+lov::System::Task::Task(Task&& other) noexcept:
+    m_handle(std::exchange(other.m_handle, nullptr))
+{}
+
+lov::System::Task& lov::System::Task::operator=(Task&& other) noexcept {
+    if (this != &other) {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+
+        m_handle = std::exchange(other.m_handle, nullptr);
+    }
+
+    return *this;
+}
+
+lov::System::Task::~Task() {
+    if (m_handle) {
+        m_handle.destroy();
+    }
+}
+
+bool lov::System::Task::isDone() const {
+    return !m_handle || m_handle.done();
+}
+
+void lov::System::Task::rethrow() const {
+    if (m_handle && m_handle.done() && m_handle.promise().exception) {
+        std::rethrow_exception(m_handle.promise().exception);
+    }
+}
+
+bool lov::System::Task::await_ready() const noexcept {
+    return isDone();
+}
+
+void lov::System::Task::await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    m_handle.promise().continuation = awaiting;
+}
+
+void lov::System::Task::await_resume() const {
+    rethrow();
+}
+
+lov::System::Task::Task(std::coroutine_handle<promise_type> handle):
+    m_handle(handle)
+{}
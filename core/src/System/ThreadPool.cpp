@@ -0,0 +1,108 @@
+#include "System/ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+lov::System::ThreadPool::ThreadPool(lov_size threadCount):
+    m_stopping(false)
+{
+    // Leave one hardware thread for the caller by default
+    if (threadCount <= 0) {
+        threadCount = std::max(static_cast<lov_size>(std::thread::hardware_concurrency()) - 1, 1);
+    }
+
+    for (lov_size i = 0; i < threadCount; i++) {
+        m_workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+lov::System::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::future<void> lov::System::ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> result = packaged.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(packaged));
+    }
+
+    m_condition.notify_one();
+    return result;
+}
+
+void lov::System::ThreadPool::parallelFor(lov_size count, const std::function<void(lov_size begin, lov_size end)>& body) {
+    if (count <= 0) {
+        return;
+    }
+
+    // One range per worker plus one for the calling thread
+    lov_size rangeCount = std::min(getThreadCount() + 1, count);
+    lov_size rangeSize = (count + rangeCount - 1) / rangeCount;
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(rangeCount);
+
+    for (lov_size begin = rangeSize; begin < count; begin += rangeSize) {
+        lov_size end = std::min(begin + rangeSize, count);
+        pending.push_back(submit([&body, begin, end]() { body(begin, end); }));
+    }
+
+    // Run the first range here while the workers run the rest. The queued ranges refer to the body, so every one of
+    // them is waited for before anything thrown is rethrown
+    std::exception_ptr error;
+    try {
+        body(0, std::min(rangeSize, count));
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    for (std::future<void>& range : pending) {
+        try {
+            range.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+lov::lov_size lov::System::ThreadPool::getThreadCount() const {
+    return static_cast<lov_size>(m_workers.size());
+}
+
+void lov::System::ThreadPool::work() {
+    while (true) {
+        std::packaged_task<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
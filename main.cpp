@@ -1,94 +1,115 @@
+#include "ECS/Components.h"
+#include "ECS/Systems.h"
+#include "ECS/World.h"
 #include "Graphics/Window.h"
 #include "Graphics/VertexArray.h"
 #include "Graphics/VertexBuffer.h"
 #include "Graphics/Shader.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureArray.h"
+#include "Graphics/TextureLoader.h"
+#include "Graphics/TextureManager.h"
 #include "Graphics/ElementBuffer.h"
 #include "System/Vector.h"
 #include "Graphics/Transform.h"
 #include "Graphics/Camera.h"
+#include "Graphics/CommandQueue.h"
+#include "Graphics/DrawIndirectBuffer.h"
 #include "Graphics/Material.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/MeshLoader.h"
+#include "Graphics/OcclusionQueries.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/SceneGraph.h"
+#include "Graphics/StaticBatcher.h"
+#include "System/AssetPack.h"
+#include "System/AssetStreamer.h"
+#include "System/AsyncIO.h"
+#include "System/ThreadPool.h"
 #include "System/Exceptions.h"
+#include "System/FrameClock.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <stb_image.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <fstream>
 
 int main(int argc, char *argv[]) {
-    std::string resPath = "";
-
     // Parse arguments
     if (argc < 2) {
-        std::cerr << "Absolute path to 'res' directory required - see README" << std::endl;
+        std::cerr << "Path to 'res.pack' required - see README" << std::endl;
         return -1;
     }
-    else {
-        resPath = argv[1];
+
+    bool useRenderThread = false;
+    int swapInterval = 1;
+    bool adaptiveSync = false;
+    double frameRateLimit = 0.0;
+    lov::lov_uint maxFramesInFlight = 2;
+    bool lowPower = false;
+    lov::Graphics::WindowMode windowMode = lov::Graphics::WindowMode::Windowed;
+    lov::lov_uint frameCount = 0;
+    for (int i = 2; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--render-thread") {
+            useRenderThread = true;
+        }
+        else if (argument == "--vsync" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            swapInterval = mode == "off" ? 0 : 1;
+            adaptiveSync = mode == "adaptive";
+        }
+        else if (argument == "--fps" && i + 1 < argc) {
+            frameRateLimit = std::max(std::stod(argv[++i]), 0.0);
+        }
+        else if (argument == "--frames-in-flight" && i + 1 < argc) {
+            maxFramesInFlight = static_cast<lov::lov_uint>(std::max(std::stoi(argv[++i]), 0));
+        }
+        else if (argument == "--idle") {
+            lowPower = true;
+        }
+        else if (argument == "--headless") {
+            windowMode = lov::Graphics::WindowMode::Headless;
+        }
+        else if (argument == "--frames" && i + 1 < argc) {
+            frameCount = static_cast<lov::lov_uint>(std::max(std::stoi(argv[++i]), 0));
+        }
     }
 
-    // Filepaths
-    std::string containerDiffusePath = resPath + "/Textures/container_diffuse.png";
-    std::string containerSpecularPath = resPath + "/Textures/container_specular.png";
-    std::string basicShaderVertexPath = resPath + "/Shaders/basic.vs";
-    std::string basicShaderFragPath = resPath + "/Shaders/basic.fs";
-    std::string lightShaderVertexPath = resPath + "/Shaders/light.vs";
-    std::string lightShaderFragPath = resPath + "/Shaders/light.fs";
+    // Map every resource at once. Assets are views into the mapping, so nothing is opened or copied per file
+    std::unique_ptr<lov::System::AssetPack> resources;
+    try {
+        resources = std::make_unique<lov::System::AssetPack>(argv[1]);
+    }
+    catch (const lov::Exceptions::AssetException& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
 
-    lov::Graphics::Window window(800, 600, "Lovely Engine");
+    lov::Graphics::Window window(800, 600, "Lovely Engine", windowMode);
+    window.setSwapInterval(swapInterval, adaptiveSync);
+    window.setFrameRateLimit(frameRateLimit);
+    window.setMaxFramesInFlight(maxFramesInFlight);
+    window.setLowPowerMode(lowPower);
     lov::Graphics::Camera cam({ 0.0f, 0.0f, 3.0f }, { 0.0f, 1.0f, 0.0f }, 0.0f, -90.0f);
     cam.clampPitch(true);
 
     window.setClearColor(0.1f, 0.1f, 0.1f);
     window.hideCursor(true);
-
-    float vertices[] = {
-        // positions          // normals           // texture coords
-        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-        0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f,
-        0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 0.0f,
-        0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f,
-        0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f,
-
-        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-        0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-        0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-        0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-        0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-        0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-        0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-        0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-        0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-        0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-
-        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-        0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-        0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
-    };
+    window.setRawMouseMotion(true);
 
     lov::Vector3f cubePositions[] = {
         lov::Vector3f( 0.0f,  0.0f,  0.0f),
@@ -114,39 +135,178 @@ int main(int argc, char *argv[]) {
     float attenuationLinear = 0.09f;
     float attenuationQuadratic = 0.032f;
 
-    lov::Graphics::Texture containerDiffuse(containerDiffusePath.c_str());
-    lov::Graphics::Texture containerSpecular(containerSpecularPath.c_str());
+    // Keep both container maps in one texture array, so every material samples the same bind. The first map's header
+    // sizes the array, and every other map has to match it
+    const char* materialMapNames[] = { "Textures/container_diffuse.png", "Textures/container_specular.png" };
+    int materialMapWidth = 0, materialMapHeight = 0;
+    for (const char* name : materialMapNames) {
+        std::span<const std::byte> contents = resources->get(name);
+        int width = 0, height = 0, channels = 0;
+        if (!stbi_info_from_memory(reinterpret_cast<const unsigned char*>(contents.data()), static_cast<int>(contents.size()), &width, &height, &channels)) {
+            std::cerr << "Failed to read material map " << name << ": " << stbi_failure_reason() << std::endl;
+            return -1;
+        }
+
+        if (materialMapWidth == 0) {
+            materialMapWidth = width;
+            materialMapHeight = height;
+        }
+        else if (width != materialMapWidth || height != materialMapHeight) {
+            std::cerr << "Material map " << name << " is " << width << "x" << height << ", but the others are "
+                << materialMapWidth << "x" << materialMapHeight << std::endl;
+            return -1;
+        }
+    }
+
+    // The maps start grey and stream in once a container is near
+    lov::Graphics::TextureArray materialMaps(lov::Graphics::TextureDesc::forImage(materialMapWidth, materialMapHeight, 4), 2);
+    const std::vector<unsigned char> greyLayer(static_cast<size_t>(materialMapWidth) * materialMapHeight * 4, 128);
+    for (lov::lov_int layer = 0; layer < 2; layer++) {
+        materialMaps.upload(layer, 0, greyLayer.data());
+    }
+    materialMaps.generateMipmaps();
 
-    lov::Graphics::Material containerMaterial;
-    containerMaterial.diffuseMapID = containerDiffuse.getID();
-    containerMaterial.specularMapID = containerSpecular.getID();
+    // Materials differing only in layers and shininess still share a batch
+    lov::Graphics::Material containerMaterial = { materialMaps.getID(), 0, 1, 64.0f };
+    lov::Graphics::Material dullContainerMaterial = { materialMaps.getID(), 0, 1, 8.0f };
 
     lov::Graphics::Shader mainShader;
     try {
-        mainShader.compileFromFiles(basicShaderVertexPath, basicShaderFragPath);
+        mainShader.compileFromMemory(resources->get("Shaders/basic.vs"), resources->get("Shaders/basic.fs"));
     }
-    catch (lov::Exceptions::ShaderException e) {
+    catch (const lov::Exceptions::Exception& e) {
         std::cout << "Failed to compile main shader: " << e.what() << std::endl;
     }
 
     lov::Graphics::Shader lightShader;
     try {
-        lightShader.compileFromFiles(lightShaderVertexPath, lightShaderFragPath);
+        lightShader.compileFromMemory(resources->get("Shaders/light.vs"), resources->get("Shaders/light.fs"));
     }
-    catch (lov::Exceptions::ShaderException e) {
+    catch (const lov::Exceptions::Exception& e) {
         std::cout << "Failed to compile light shader: " << e.what() << std::endl;
     }
 
+    // Parse the cube model straight into the engine's vertex layout
+    lov::System::ThreadPool pool;
+    lov::Graphics::MeshLoader meshLoader(pool);
+    lov::Graphics::MeshData cubeMesh;
+    try {
+        cubeMesh = meshLoader.loadObj(resources->get("Models/cube.obj"));
+    }
+    catch (const lov::Exceptions::Exception& e) {
+        std::cerr << "Failed to load cube model: " << e.what() << std::endl;
+        return -1;
+    }
+
+    // Decode the container maps on the pool and upload them between frames, swapping grey back in when evicted
+    // Decode the light cubes' map on the pool too, sharing it with anything else that acquires the same image
+    lov::Graphics::TextureLoader textureLoader(pool);
+    lov::Graphics::TextureManager textureManager(&textureLoader);
+    lov::Graphics::TextureHandle lightMap = textureManager.acquire("Textures/awesomeface.png", resources->get("Textures/awesomeface.png"));
+
+    lov::System::AsyncIO io(pool);
+    lov::System::AssetStreamer streamer(io, pool, 2);
+    streamer.setBudget(lov::System::AssetType::Texture, 4 * 1024 * 1024);
+
+    lov::lov_uint materialMapAssets[2];
+    for (lov::lov_int layer = 0; layer < 2; layer++) {
+        lov::System::AssetCallbacks callbacks;
+        callbacks.decode = [materialMapWidth, materialMapHeight](std::span<const std::byte> contents) {
+            stbi_set_flip_vertically_on_load_thread(true);
+
+            int width = 0, height = 0, channels = 0;
+            unsigned char* data = stbi_load_from_memory(reinterpret_cast<const unsigned char*>(contents.data()), static_cast<int>(contents.size()),
+                &width, &height, &channels, 4);
+            if (!data) {
+                throw lov::Exceptions::TextureException(stbi_failure_reason());
+            }
+
+            std::vector<std::byte> pixels;
+            if (width == materialMapWidth && height == materialMapHeight) {
+                pixels.assign(reinterpret_cast<const std::byte*>(data), reinterpret_cast<const std::byte*>(data) + width * height * 4);
+            }
+
+            stbi_image_free(data);
+            if (pixels.empty()) {
+                throw lov::Exceptions::TextureException("Material maps must be " + std::to_string(materialMapWidth) + "x" + std::to_string(materialMapHeight));
+            }
+
+            return pixels;
+        };
+        callbacks.load = [&materialMaps, layer](std::span<const std::byte> pixels) {
+            materialMaps.upload(layer, 0, pixels.data());
+            materialMaps.generateMipmaps();
+            return pixels.size() * 4 / 3;
+        };
+        callbacks.evict = [&materialMaps, &greyLayer, layer]() {
+            materialMaps.upload(layer, 0, greyLayer.data());
+            materialMaps.generateMipmaps();
+        };
+
+        materialMapAssets[layer] = streamer.add(resources->get(materialMapNames[layer]), lov::System::AssetType::Texture, callbacks);
+    }
+
     lov::Graphics::VertexArray vao;
     lov::Graphics::VertexBuffer vbo;
+    lov::Graphics::ElementBuffer ebo;
 
     vao.bind();
     vbo.bind();
-    vbo.bufferData(vertices, sizeof(vertices));
+    vbo.bufferData(cubeMesh.vertices.data(), static_cast<lov::lov_size>(cubeMesh.vertices.size() * sizeof(lov::Graphics::Vertex)));
+    ebo.bind();
+    ebo.bufferIndices(cubeMesh.indices.data(), static_cast<lov::lov_size>(cubeMesh.indices.size() * sizeof(lov::lov_uint)));
+
+    vao.linkAttribute(0, 3, lov::LOV_FLOAT, sizeof(lov::Graphics::Vertex), offsetof(lov::Graphics::Vertex, position));
+    vao.linkAttribute(1, 3, lov::LOV_FLOAT, sizeof(lov::Graphics::Vertex), offsetof(lov::Graphics::Vertex, normal));
+    vao.linkAttribute(2, 2, lov::LOV_FLOAT, sizeof(lov::Graphics::Vertex), offsetof(lov::Graphics::Vertex, texCoords));
+
+    // Place the containers in a scene, which only rebuilds world transforms of what moves
+    lov::Graphics::SceneGraph scene;
+    lov::lov_uint containerNodes[10];
+    for (int i = 0; i < 10; i++) {
+        lov::Graphics::NodeTransform local;
+        local.position = cubePositions[i];
+        local.rotationAxis = lov::Vector3f(1.0f, 0.3f, 0.5f);
+        local.rotationAngle = 20.0f * i;
+        containerNodes[i] = scene.add(local);
+    }
+
+    scene.update();
 
-    vao.linkAttribute(0, 3, lov::LOV_FLOAT, 8 * sizeof(float), 0);
-    vao.linkAttribute(1, 3, lov::LOV_FLOAT, 8 * sizeof(float), 3 * sizeof(float));
-    vao.linkAttribute(2, 2, lov::LOV_FLOAT, 8 * sizeof(float), 6 * sizeof(float));
+    // The light cubes are entities, which the ECS systems transform, cull and record each frame
+    lov::ECS::World world;
+    lov::Graphics::BoundingBox cubeBounds = cubeMesh.calculateBounds();
+    for (int i = 0; i < 4; i++) {
+        lov::ECS::LocalTransform local;
+        local.value.position = pointLightPositions[i];
+        local.value.scale = lov::Vector3f(0.2f, 0.2f, 0.2f);
+
+        world.create(local, lov::ECS::PreviousTransform{ local.value }, lov::ECS::WorldTransform{}, lov::ECS::RenderBounds{ cubeBounds }, lov::ECS::Visible{ true },
+            lov::ECS::RenderMesh{ lightShader.getID(), vao.getID(), static_cast<lov::lov_size>(cubeMesh.indices.size()), 0 });
+    }
+
+    // Bake the static containers into world space batches
+    lov::Graphics::StaticBatcher batcher;
+
+    for (int i = 0; i < 10; i++) {
+        batcher.add(cubeMesh, i % 2 == 0 ? containerMaterial : dullContainerMaterial, scene.getWorld(containerNodes[i]));
+    }
+
+    std::vector<std::unique_ptr<lov::Graphics::StaticBatch>> staticBatches;
+    for (const lov::Graphics::StaticBatchData& data : batcher.bake()) {
+        staticBatches.push_back(std::make_unique<lov::Graphics::StaticBatch>(data));
+    }
+
+    lov::Graphics::DrawIndirectBuffer staticCommands;
+
+    // Query each batch's bounds against the depth buffer every frame
+    lov::Graphics::OcclusionQueries occlusionQueries;
+    occlusionQueries.compile(resources->get("Shaders/bounds.vs"), resources->get("Shaders/bounds.fs"));
+
+    std::vector<lov::lov_uint> batchQueries;
+    for (const std::unique_ptr<lov::Graphics::StaticBatch>& batch : staticBatches) {
+        batchQueries.push_back(occlusionQueries.addObject(batch->getBounds()));
+    }
 
     lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(lov::Util::toRadians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
 
@@ -188,65 +348,233 @@ int main(int argc, char *argv[]) {
     mainShader.setUniform("flashlight.attenuationLinear", attenuationLinear);
     mainShader.setUniform("flashlight.attenuationQuadratic", attenuationQuadratic);
 
-    // Set material
-    mainShader.setUniform("material.diffuse", 0);
-    mainShader.setUniform("material.specular", 1);
-    mainShader.setUniform("material.shininess", 64.0f);
+    // Set material maps
+    mainShader.setUniform("materialMaps", 0);
 
     lightShader.bind();
     lightShader.setUniform("projection", projection);
+    lightShader.bindUniformBlock("Object", 0);
+    lightShader.setUniform("lightMap", 1);
 
-    while(window.isOpen()) {
-        float deltaTime = window.getDeltaTime();
+    // Replays the draws recorded into each packet
+    lov::Graphics::CommandQueue commandQueue;
 
-        if (window.getKeyState(lov::Input::KEY_ESCAPE)) {
-            window.close();
-        }
+    // Asset loads and evictions the latest frame drawn has shown
+    lov::lov_size shownAssetChanges = 0;
+
+    // Draw a frame from its packet. Only this touches OpenGL, so in render thread mode it runs there
+    auto renderFrame = [&](const lov::Graphics::FramePacket& packet) {
         window.clear();
 
-        float cameraSpeed = 2.5f * deltaTime;
-        if (window.getKeyState(lov::Input::KEY_W) == lov::Input::KEY_PRESS) cam.move(cam.getFront(), cameraSpeed);
-        if (window.getKeyState(lov::Input::KEY_S) == lov::Input::KEY_PRESS) cam.move(-cam.getFront(), cameraSpeed);
-        if (window.getKeyState(lov::Input::KEY_A) == lov::Input::KEY_PRESS) cam.move(-cam.getRight(), cameraSpeed);
-        if (window.getKeyState(lov::Input::KEY_D) == lov::Input::KEY_PRESS) cam.move(cam.getRight(), cameraSpeed);
+        // Stream the container maps in between frames, where uploads can't stall a draw
+        for (const lov::Graphics::FrameAssetRequest& request : packet.assetRequests) {
+            streamer.request(request.asset, request.distance);
+        }
 
-        float mouseSens = 0.1f;
-        lov::Vector2f c = window.getCursorOffset();
-        cam.rotate(c.x, c.y, mouseSens);
+        try {
+            streamer.update(2.0);
+        }
+        catch (const lov::Exceptions::AssetException& e) {
+            std::cout << e.what() << std::endl;
+        }
+
+        // Keep drawing while maps stream in, and once more after each one lands or is evicted
+        lov::System::AssetStreamerStats assetStats = streamer.getStats();
+        lov::lov_size assetChanges = assetStats.loads + assetStats.evictions + assetStats.failures;
+        if (assetStats.inFlightCount + assetStats.waitingCount > 0 || assetChanges != shownAssetChanges) {
+            shownAssetChanges = assetChanges;
+            window.requestRedraw();
+        }
 
-        containerDiffuse.bind(0);
-        containerSpecular.bind(1);
+        // Spend a little of each frame finishing the light map, which shows the placeholder until then
+        textureManager.update();
+        textureLoader.update(1.0);
+        if (textureManager.getStats().pendingCount > 0 || textureLoader.getPendingCount() > 0) {
+            window.requestRedraw();
+        }
+
+        materialMaps.bind(0);
+        lightMap->bind(1);
 
         mainShader.bind();
-        mainShader.setUniform("view", cam.getViewMatrix());
-        mainShader.setUniform("flashlight.position", cam.getPosition());
-        mainShader.setUniform("flashlight.direction", cam.getFront());
+        mainShader.setUniform("view", packet.view);
+        mainShader.setUniform("flashlight.position", packet.cameraPosition);
+        mainShader.setUniform("flashlight.direction", packet.cameraFront);
 
         lightShader.bind();
-        lightShader.setUniform("view", cam.getViewMatrix());
+        lightShader.setUniform("view", packet.view);
 
         mainShader.bind();
-        for (int i = 0; i < 10; i++) {
-            mainShader.setUniform("cameraPos", cam.getPosition());
+        mainShader.setUniform("cameraPos", packet.cameraPosition);
+        mainShader.setUniform("model", lov::Graphics::Transform::identity());
+
+        // Upload the draws the simulation culled, all batches at once
+        staticCommands.clear();
+        staticCommands.add(packet.commands);
+        staticCommands.upload();
+
+        // Draw the batches that were visible last frame, then query every batch against them
+        occlusionQueries.beginFrame();
+        for (size_t i = 0; i < staticBatches.size(); i++) {
+            if (occlusionQueries.wasVisible(batchQueries[i])) {
+                staticBatches[i]->bind();
+                staticCommands.draw(packet.batchStarts[i], packet.batchStarts[i + 1] - packet.batchStarts[i]);
+            }
+        }
 
-            lov::Graphics::Transform containerTransform;
-            containerTransform = containerTransform.translate(cubePositions[i]);
-            containerTransform = containerTransform.rotate(1.0f, 0.3f, 0.5f, 20.0f * i);
-            mainShader.setUniform("model", containerTransform);
+        occlusionQueries.issue(packet.projection * packet.view);
 
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+        // Let the GPU skip the rest if their new queries found them hidden
+        mainShader.bind();
+        for (size_t i = 0; i < staticBatches.size(); i++) {
+            if (!occlusionQueries.wasVisible(batchQueries[i])) {
+                occlusionQueries.beginConditionalDraw(batchQueries[i]);
+                staticBatches[i]->bind();
+                staticCommands.draw(packet.batchStarts[i], packet.batchStarts[i + 1] - packet.batchStarts[i]);
+                occlusionQueries.endConditionalDraw(batchQueries[i]);
+            }
         }
 
-        lightShader.bind();
-        for (int i = 0; i < 4; i++) {
-            lov::Graphics::Transform lightTransform;
-            lightTransform = lightTransform.translate(pointLightPositions[i]).scale(0.2f, 0.2f, 0.2f);
+        commandQueue.execute(std::span(&packet.draws, 1));
+    };
+
+    // With a render thread, frame N is drawn while frame N + 1 is simulated
+    std::unique_ptr<lov::Graphics::RenderThread> renderThread;
+    if (useRenderThread) {
+        renderThread = std::make_unique<lov::Graphics::RenderThread>(window, renderFrame);
+    }
+
+    lov::Graphics::FramePacket singleThreadedPacket;
+    lov::lov_uint frame = 0;
 
-            lightShader.setUniform("model", lightTransform);
+    // Simulate in fixed steps, drawing each frame between the last two
+    lov::System::FrameClock clock;
+    lov::Vector3f previousCameraPosition = cam.getPosition();
 
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+    // Input is recorded as it's polled and applied once a frame, so a key tapped between frames still counts as held
+    lov::Input::InputQueue& input = window.getInput();
+    auto held = [&input](lov::Input::KeyCode key) {
+        return input.isDown(key) || input.wasPressed(key);
+    };
+
+    lov::Graphics::IdleStats shownIdleStats = window.getIdleStats();
+
+    // Time the whole run, to report when it stops after a number of frames
+    lov::System::FrameClock::Clock::time_point runStart = lov::System::FrameClock::Clock::now();
+
+    while(window.isOpen()) {
+        // Nothing moved while waiting for events, so that time isn't simulated
+        clock.skip(window.getIdleStats().lastWait);
+
+        // Show how little an idle window costs in its title, whenever the stats are measured again
+        lov::Graphics::IdleStats idleStats = window.getIdleStats();
+        if (lowPower && (idleStats.framesPerSecond != shownIdleStats.framesPerSecond || idleStats.cpuUsage != shownIdleStats.cpuUsage)) {
+            std::ostringstream title;
+            title << std::fixed << std::setprecision(1) << "Lovely Engine - " << idleStats.framesPerSecond << " fps, "
+                << idleStats.frameMilliseconds << " ms per frame, " << idleStats.cpuUsage * 100.0 << "% CPU";
+            window.setTitle(title.str());
+            shownIdleStats = idleStats;
+        }
+
+        if (!window.needsRedraw()) {
+            window.pollEvents();
+            continue;
         }
 
-        window.update();
+        lov::lov_uint steps = clock.tick();
+        input.update();
+
+        if (input.wasPressed(lov::Input::KEY_ESCAPE)) {
+            window.close();
+        }
+
+        // Looking around follows every cursor move since the last frame, rather than waiting for a step
+        float mouseSens = 0.1f;
+        lov::Vector2f c = input.getCursorDelta();
+        cam.rotate(c.x, -c.y, mouseSens);
+
+        float cameraSpeed = 2.5f * clock.getStep();
+        for (lov::lov_uint step = 0; step < steps; step++) {
+            previousCameraPosition = cam.getPosition();
+            lov::ECS::storePreviousTransforms(world);
+
+            if (held(lov::Input::KEY_W)) cam.move(cam.getFront(), cameraSpeed);
+            if (held(lov::Input::KEY_S)) cam.move(-cam.getFront(), cameraSpeed);
+            if (held(lov::Input::KEY_A)) cam.move(-cam.getRight(), cameraSpeed);
+            if (held(lov::Input::KEY_D)) cam.move(cam.getRight(), cameraSpeed);
+        }
+
+        // The camera keeps moving while a key is held, so more frames are needed even without new events
+        if (held(lov::Input::KEY_W) || held(lov::Input::KEY_S) || held(lov::Input::KEY_A) || held(lov::Input::KEY_D)) {
+            window.requestRedraw();
+        }
+
+        // Draw the camera where it would be between its last two steps
+        lov::Graphics::Camera drawnCam = cam;
+        drawnCam.setPosition(previousCameraPosition + (cam.getPosition() - previousCameraPosition) * clock.getAlpha());
+
+        // Describe the frame in a packet the renderer only reads
+        lov::Graphics::FramePacket& packet = renderThread ? renderThread->acquire() : singleThreadedPacket;
+        if (!renderThread) {
+            packet.clear();
+            packet.frame = frame;
+        }
+
+        packet.view = drawnCam.getViewMatrix();
+        packet.projection = projection;
+        packet.cameraPosition = drawnCam.getPosition();
+        packet.cameraFront = drawnCam.getFront();
+
+        // Record every batch's visible ranges
+        lov::Graphics::Frustum frustum(projection * packet.view);
+        for (const std::unique_ptr<lov::Graphics::StaticBatch>& batch : staticBatches) {
+            packet.batchStarts.push_back(static_cast<lov::lov_size>(packet.commands.size()));
+            batch->record(frustum, packet.commands);
+        }
+        packet.batchStarts.push_back(static_cast<lov::lov_size>(packet.commands.size()));
+
+        // Nothing in the scene moves yet, so after the first frame this finds nothing to recompute
+        scene.update();
+
+        // Record the visible light cubes for the renderer to replay, with only their model transforms differing
+        lov::ECS::updateTransforms(world, nullptr, clock.getAlpha());
+        lov::ECS::cullEntities(world, frustum);
+        lov::ECS::extractDraws(world, std::span(&packet.draws, 1), 0);
+
+        // Keep the container maps while any container is close enough for their detail to show
+        float nearestContainer = std::numeric_limits<float>::max();
+        for (const lov::Vector3f& position : cubePositions) {
+            nearestContainer = std::min(nearestContainer, lov::Vector::length(position - drawnCam.getPosition()));
+        }
+
+        if (nearestContainer < 30.0f) {
+            for (lov::lov_uint asset : materialMapAssets) {
+                packet.assetRequests.push_back({ asset, nearestContainer });
+            }
+        }
+
+        if (renderThread) {
+            renderThread->submit();
+            window.waitForNextFrame();
+            window.pollEvents();
+        }
+        else {
+            renderFrame(packet);
+            window.update();
+        }
+
+        frame++;
+
+        if (frameCount > 0 && frame == frameCount) {
+            window.close();
+        }
+    }
+
+    renderThread.reset();
+
+    if (frameCount > 0) {
+        double runMilliseconds = std::chrono::duration<double, std::milli>(lov::System::FrameClock::Clock::now() - runStart).count();
+        std::cout << std::fixed << std::setprecision(3) << frame << " frames in " << runMilliseconds << " ms, "
+            << runMilliseconds / std::max(frame, 1u) << " ms per frame" << std::endl;
     }
 }
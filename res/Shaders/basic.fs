@@ -37,25 +37,29 @@ struct DirectionalLight {
     vec3 specular;
 };
 
-struct Material {
-    sampler2D diffuse;
-    sampler2D specular;
-    float shininess;
-};
-
 in vec3 fragPos;
 in vec3 normal;
 in vec2 texCoord;
+flat in ivec2 materialLayers;
+flat in float materialShininess;
 
 out vec4 fragColor;
 
 uniform vec3 cameraPos;
-uniform Material material;
+uniform sampler2DArray materialMaps;
 
 uniform PointLight pointLights[POINT_LIGHT_COUNT];
 uniform SpotLight flashlight;
 uniform DirectionalLight sun;
 
+vec3 diffuseMap() {
+    return texture(materialMaps, vec3(texCoord, materialLayers.x)).rgb;
+}
+
+vec3 specularMap() {
+    return texture(materialMaps, vec3(texCoord, materialLayers.y)).rgb;
+}
+
 float calculateAttenuation(float distance, float constant, float linear, float quadratic) {
     return 1.0 / (constant + linear * distance + quadratic * distance * distance);
 }
@@ -67,9 +71,9 @@ vec3 calculatePointLight(PointLight light, vec3 viewDir) {
     float distance = length(light.position - fragPos);
     float attenuation = calculateAttenuation(distance, light.attenuationConstant, light.attenuationLinear, light.attenuationQuadratic);
 
-    vec3 ambient = light.ambient * texture(material.diffuse, texCoord).rgb * attenuation;
-    vec3 diffuse = light.diffuse * max(dot(normal, lightDir), 0.0) * texture(material.diffuse, texCoord).rgb * attenuation;
-    vec3 specular = light.specular * pow(max(dot(viewDir, reflectDir), 0.0), material.shininess) * texture(material.specular, texCoord).rgb * attenuation;
+    vec3 ambient = light.ambient * diffuseMap() * attenuation;
+    vec3 diffuse = light.diffuse * max(dot(normal, lightDir), 0.0) * diffuseMap() * attenuation;
+    vec3 specular = light.specular * pow(max(dot(viewDir, reflectDir), 0.0), materialShininess) * specularMap() * attenuation;
 
     return (ambient + diffuse + specular);
 }
@@ -85,9 +89,9 @@ vec3 calculateSpotLight(SpotLight light, vec3 viewDir) {
     float epsilon = light.innerCutoff - light.outerCutoff;
     float intensity = clamp((theta - light.outerCutoff) / epsilon, 0.0, 1.0);
 
-    vec3 ambient = light.ambient * texture(material.diffuse, texCoord).rgb * attenuation;
-    vec3 diffuse = light.diffuse * max(dot(normal, lightDir), 0.0) * texture(material.diffuse, texCoord).rgb * attenuation * intensity;
-    vec3 specular = light.specular * pow(max(dot(viewDir, reflectDir), 0.0), material.shininess) * texture(material.specular, texCoord).rgb * attenuation * intensity;
+    vec3 ambient = light.ambient * diffuseMap() * attenuation;
+    vec3 diffuse = light.diffuse * max(dot(normal, lightDir), 0.0) * diffuseMap() * attenuation * intensity;
+    vec3 specular = light.specular * pow(max(dot(viewDir, reflectDir), 0.0), materialShininess) * specularMap() * attenuation * intensity;
 
     return (ambient + diffuse + specular);
 }
@@ -96,9 +100,9 @@ vec3 calculateDirectionalLight(DirectionalLight light, vec3 viewDir) {
     vec3 lightDir = normalize(-light.direction);
     vec3 reflectDir = reflect(-lightDir, normal);
 
-    vec3 ambient = light.ambient * texture(material.diffuse, texCoord).rgb;
-    vec3 diffuse = light.diffuse * max(dot(normal, lightDir), 0.0) * texture(material.diffuse, texCoord).rgb;
-    vec3 specular = light.specular * pow(max(dot(viewDir, reflectDir), 0.0), material.shininess) * texture(material.specular, texCoord).rgb;
+    vec3 ambient = light.ambient * diffuseMap();
+    vec3 diffuse = light.diffuse * max(dot(normal, lightDir), 0.0) * diffuseMap();
+    vec3 specular = light.specular * pow(max(dot(viewDir, reflectDir), 0.0), materialShininess) * specularMap();
 
     return (ambient + diffuse + specular);
 }
@@ -3,10 +3,14 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
+layout (location = 4) in ivec2 aMaterialLayers;
+layout (location = 5) in float aShininess;
 
 out vec3 fragPos;
 out vec3 normal;
 out vec2 texCoord;
+flat out ivec2 materialLayers;
+flat out float materialShininess;
 
 uniform mat4 model;
 uniform mat4 view;
@@ -16,6 +20,8 @@ void main()
 {
     fragPos = vec3(model * vec4(aPos, 1.0));
     texCoord = aTexCoord;
+    materialLayers = aMaterialLayers;
+    materialShininess = aShininess;
     normal = normalize(mat3(transpose(inverse(model))) * aNormal);
 
     gl_Position = projection * view * model * vec4(aPos, 1.0);
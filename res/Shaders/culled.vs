@@ -0,0 +1,44 @@
+#version 430 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in uint aInstance;
+layout (location = 4) in ivec2 aMaterialLayers;
+layout (location = 5) in float aShininess;
+
+struct CullInstance {
+    mat4 model;
+    vec4 center;
+    vec4 extents;
+    uint command;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+};
+
+layout (std430, binding = 0) readonly buffer Instances {
+    CullInstance instances[];
+};
+
+out vec3 fragPos;
+out vec3 normal;
+out vec2 texCoord;
+flat out ivec2 materialLayers;
+flat out float materialShininess;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    mat4 model = instances[aInstance].model;
+
+    fragPos = vec3(model * vec4(aPos, 1.0));
+    texCoord = aTexCoord;
+    materialLayers = aMaterialLayers;
+    materialShininess = aShininess;
+    normal = normalize(mat3(transpose(inverse(model))) * aNormal);
+
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
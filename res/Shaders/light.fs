@@ -1,8 +1,14 @@
 #version 330 core
 
+in vec2 texCoord;
+
 out vec4 fragColor;
 
+uniform sampler2D lightMap;
+
 void main()
 {
-    fragColor = vec4(1.0);
+    // Tint the light white wherever its map is transparent
+    vec4 map = texture(lightMap, texCoord);
+    fragColor = vec4(mix(vec3(1.0), map.rgb, map.a * 0.5), 1.0);
 }
@@ -1,12 +1,19 @@
 #version 330 core
 
 layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoord;
+
+out vec2 texCoord;
+
+layout (std140) uniform Object {
+    mat4 model;
+};
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
 void main()
 {
+    texCoord = aTexCoord;
     gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
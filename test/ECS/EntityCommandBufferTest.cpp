@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "ECS/EntityCommandBuffer.h"
+#include "ECS/World.h"
+
+/// @brief A component for tests
+struct Tag {
+    int value;
+};
+
+/// @brief Fixture used for EntityCommandBuffer tests
+class EntityCommandBufferFixture : public ::testing::Test {
+protected:
+    lov::ECS::World m_world;                    ///< The world to apply to
+    lov::ECS::EntityCommandBuffer m_commands;   ///< The buffer under test
+};
+
+/// @brief Test commands are only applied by apply, in the order they were recorded
+TEST_F(EntityCommandBufferFixture, DefersChanges) {
+    lov::ECS::Entity existing = m_world.create(Tag{ 1 });
+
+    lov::ECS::Entity created = m_commands.create();
+    m_commands.add(created, Tag{ 2 });
+    m_commands.add(existing, Tag{ 3 });
+    m_commands.remove<Tag>(existing);
+    m_commands.add(existing, Tag{ 4 });
+
+    // Nothing happens until the buffer is applied
+    ASSERT_FALSE(m_commands.isEmpty());
+    ASSERT_EQ(m_world.getEntityCount(), 1u);
+    ASSERT_EQ(m_world.get<Tag>(existing)->value, 1);
+
+    m_commands.apply(m_world);
+    ASSERT_TRUE(m_commands.isEmpty());
+    ASSERT_EQ(m_world.getEntityCount(), 2u);
+    ASSERT_EQ(m_world.get<Tag>(existing)->value, 4);
+
+    int sum = 0;
+    m_world.query<Tag>().forEach<Tag>([&sum](lov::ECS::Entity, Tag& tag) {
+        sum += tag.value;
+    });
+    ASSERT_EQ(sum, 6);
+}
+
+/// @brief Test commands on entities that are no longer alive are skipped
+TEST_F(EntityCommandBufferFixture, SkipsDeadEntities) {
+    lov::ECS::Entity entity = m_world.create(Tag{ 1 });
+
+    m_commands.destroy(entity);
+    m_commands.destroy(entity);
+    m_commands.add(entity, Tag{ 2 });
+
+    lov::ECS::Entity created = m_commands.create();
+    m_commands.destroy(created);
+    m_commands.add(created, Tag{ 3 });
+
+    ASSERT_NO_THROW(m_commands.apply(m_world));
+    ASSERT_FALSE(m_world.isAlive(entity));
+    ASSERT_EQ(m_world.getEntityCount(), 0u);
+}
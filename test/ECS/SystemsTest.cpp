@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "ECS/Components.h"
+#include "ECS/Systems.h"
+#include "ECS/World.h"
+#include "System/JobSystem.h"
+
+/// @brief Fixture used for ECS system tests
+class SystemsFixture : public ::testing::Test {
+protected:
+    /// @brief Create a unit cube entity
+    /// @param x Its x position
+    /// @param program Program it's drawn with
+    /// @return The entity
+    lov::ECS::Entity createCube(float x, lov::lov_uint program) {
+        lov::ECS::LocalTransform local;
+        local.value.position = lov::Vector3f(x, 0.0f, 0.0f);
+
+        return m_world.create(local, lov::ECS::WorldTransform{},
+            lov::ECS::RenderBounds{ lov::Graphics::BoundingBox(lov::Vector3f(-1.0f, -1.0f, -1.0f), lov::Vector3f(1.0f, 1.0f, 1.0f)) },
+            lov::ECS::Visible{ false }, lov::ECS::RenderMesh{ program, 1, 36, 0 });
+    }
+
+    lov::ECS::World m_world;    ///< The world under test
+};
+
+/// @brief Test the systems give the same results with and without a job system
+TEST_F(SystemsFixture, TransformsCullsAndExtracts) {
+    // Enough entities to fill several chunks; only those with x in [-10, 10] are inside the box frustum
+    std::vector<lov::ECS::Entity> entities;
+    for (int i = 0; i < 2000; i++) {
+        entities.push_back(createCube(static_cast<float>(i - 1000), i % 2 ? 2 : 1));
+    }
+    lov::Graphics::Frustum frustum(lov::Graphics::Transform::orthographic(-10.0f, 10.0f, -10.0f, 10.0f, -10.0f, 10.0f));
+
+    lov::System::JobSystem jobs(4);
+    for (lov::System::JobSystem* pool : { static_cast<lov::System::JobSystem*>(nullptr), &jobs }) {
+        std::vector<lov::Graphics::CommandBuffer> buffers(pool ? pool->getThreadCount() + 1 : 1);
+
+        lov::ECS::updateTransforms(m_world, pool);
+        lov::ECS::cullEntities(m_world, frustum, pool);
+        lov::ECS::extractDraws(m_world, buffers, 0, pool);
+
+        ASSERT_EQ(m_world.get<lov::ECS::WorldTransform>(entities[1500])->value.w.x, 500.0f);
+        ASSERT_TRUE(m_world.get<lov::ECS::Visible>(entities[1000])->value);
+        ASSERT_FALSE(m_world.get<lov::ECS::Visible>(entities[1500])->value);
+
+        // Cubes reaching into [-10, 10] are drawn, grouped by program once merged
+        std::vector<const lov::Graphics::RenderCommandGroup*> groups;
+        lov::Graphics::CommandBuffer::merge(buffers, groups);
+        ASSERT_EQ(groups.size(), 23u);
+        for (size_t i = 1; i < groups.size(); i++) {
+            ASSERT_LE(groups[i - 1]->key, groups[i]->key);
+        }
+        ASSERT_EQ(groups.front()->first->program, 1u);
+        ASSERT_EQ(groups.back()->first->program, 2u);
+    }
+}
+
+/// @brief Test that a thread outside the job system can extract draws, recording the chunks it runs into the last buffer
+TEST_F(SystemsFixture, ExtractsFromOutsideThread) {
+    for (int i = 0; i < 2000; i++) {
+        createCube(static_cast<float>(i), 1);
+    }
+
+    lov::Graphics::Frustum frustum(lov::Graphics::Transform::orthographic(-10.0f, 2010.0f, -10.0f, 10.0f, -10.0f, 10.0f));
+
+    lov::System::JobSystem jobs(2);
+    std::vector<lov::Graphics::CommandBuffer> buffers(jobs.getThreadCount() + 1);
+    std::thread outside([this, &jobs, &buffers, &frustum]() {
+        lov::ECS::updateTransforms(m_world, &jobs);
+        lov::ECS::cullEntities(m_world, frustum, &jobs);
+        lov::ECS::extractDraws(m_world, buffers, 0, &jobs);
+    });
+    outside.join();
+
+    // Every cube is inside the frustum, so each is drawn exactly once across the buffers
+    std::vector<const lov::Graphics::RenderCommandGroup*> groups;
+    lov::Graphics::CommandBuffer::merge(buffers, groups);
+    ASSERT_EQ(groups.size(), 2000u);
+}
+
+/// @brief Test entities with a previous transform are interpolated between it and their local transform
+TEST_F(SystemsFixture, InterpolatesTransforms) {
+    lov::ECS::Entity still = createCube(1.0f, 1);
+    lov::ECS::Entity moving = createCube(0.0f, 1);
+    m_world.add(moving, lov::ECS::PreviousTransform{});
+
+    // Step the moving cube from x = 0 to x = 4
+    lov::ECS::storePreviousTransforms(m_world);
+    m_world.get<lov::ECS::LocalTransform>(moving)->value.position = lov::Vector3f(4.0f, 0.0f, 0.0f);
+
+    lov::ECS::updateTransforms(m_world, nullptr, 0.25f);
+    ASSERT_FLOAT_EQ(m_world.get<lov::ECS::WorldTransform>(moving)->value.w.x, 1.0f);
+    ASSERT_FLOAT_EQ(m_world.get<lov::ECS::WorldTransform>(still)->value.w.x, 1.0f);
+
+    lov::ECS::updateTransforms(m_world);
+    ASSERT_FLOAT_EQ(m_world.get<lov::ECS::WorldTransform>(moving)->value.w.x, 4.0f);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "ECS/Archetype.h"
+#include "ECS/World.h"
+#include "System/Exceptions.h"
+
+/// @brief A component for tests
+struct Position {
+    float x, y, z;
+};
+
+/// @brief Another component for tests
+struct Velocity {
+    float x, y, z;
+};
+
+/// @brief A component for tests with a stricter alignment
+struct alignas(16) Health {
+    int value;
+};
+
+/// @brief A component for tests whose column pads the entity column before it
+struct alignas(16) Padded {
+    unsigned char value[16];
+};
+
+/// @brief A component for tests that nearly fills a chunk on its own
+struct Large {
+    unsigned char value[16356];
+};
+
+/// @brief A component for tests too big for any chunk
+struct Huge {
+    unsigned char value[lov::ECS::Archetype::ChunkSize];
+};
+
+/// @brief Fixture used for World tests
+class WorldFixture : public ::testing::Test {
+protected:
+    lov::ECS::World m_world;    ///< The world under test
+};
+
+/// @brief Test creating entities and getting their components
+TEST_F(WorldFixture, CreatesEntities) {
+    lov::ECS::Entity a = m_world.create(Position{ 1.0f, 2.0f, 3.0f });
+    lov::ECS::Entity b = m_world.create(Position{ 4.0f, 5.0f, 6.0f }, Velocity{ 1.0f, 0.0f, 0.0f });
+    lov::ECS::Entity c = m_world.create();
+
+    ASSERT_EQ(m_world.getEntityCount(), 3u);
+    ASSERT_TRUE(m_world.isAlive(a));
+    ASSERT_TRUE(m_world.isAlive(c));
+
+    ASSERT_EQ(m_world.get<Position>(a)->y, 2.0f);
+    ASSERT_EQ(m_world.get<Position>(b)->z, 6.0f);
+    ASSERT_EQ(m_world.get<Velocity>(b)->x, 1.0f);
+    ASSERT_FALSE(m_world.has<Velocity>(a));
+    ASSERT_FALSE(m_world.has<Position>(c));
+}
+
+/// @brief Test adding and removing components moves entities between archetypes and keeps their other components
+TEST_F(WorldFixture, AddsAndRemovesComponents) {
+    std::vector<lov::ECS::Entity> entities;
+    for (int i = 0; i < 10; i++) {
+        entities.push_back(m_world.create(Position{ static_cast<float>(i), 0.0f, 0.0f }));
+    }
+
+    // Move an entity from the middle, so the last row is swapped into its place
+    m_world.add(entities[3], Health{ 7 });
+    ASSERT_EQ(m_world.get<Health>(entities[3])->value, 7);
+    ASSERT_EQ(m_world.get<Position>(entities[3])->x, 3.0f);
+    ASSERT_EQ(m_world.get<Position>(entities[9])->x, 9.0f);
+
+    // Adding a component the entity already has replaces it
+    m_world.add(entities[3], Health{ 8 });
+    ASSERT_EQ(m_world.get<Health>(entities[3])->value, 8);
+
+    m_world.remove<Position>(entities[3]);
+    ASSERT_FALSE(m_world.has<Position>(entities[3]));
+    ASSERT_EQ(m_world.get<Health>(entities[3])->value, 8);
+
+    for (int i = 0; i < 10; i++) {
+        if (i != 3) {
+            ASSERT_EQ(m_world.get<Position>(entities[i])->x, static_cast<float>(i));
+        }
+    }
+
+    // {Position}, {Position, Health} and {Health}, plus the empty archetype
+    ASSERT_EQ(m_world.getArchetypeCount(), 4u);
+}
+
+/// @brief Test destroyed entities stop being alive and their indices are reused with a new generation
+TEST_F(WorldFixture, DestroysEntities) {
+    lov::ECS::Entity a = m_world.create(Position{ 1.0f, 0.0f, 0.0f });
+    lov::ECS::Entity b = m_world.create(Position{ 2.0f, 0.0f, 0.0f });
+
+    m_world.destroy(a);
+    ASSERT_FALSE(m_world.isAlive(a));
+    ASSERT_EQ(m_world.get<Position>(a), nullptr);
+    ASSERT_EQ(m_world.get<Position>(b)->x, 2.0f);
+    ASSERT_THROW(m_world.destroy(a), lov::Exceptions::EntityException);
+    ASSERT_THROW(m_world.add(a, Velocity{}), lov::Exceptions::EntityException);
+
+    lov::ECS::Entity c = m_world.create(Position{ 3.0f, 0.0f, 0.0f });
+    ASSERT_EQ(c.index, a.index);
+    ASSERT_NE(c.generation, a.generation);
+    ASSERT_FALSE(m_world.isAlive(a));
+    ASSERT_EQ(m_world.get<Position>(c)->x, 3.0f);
+    ASSERT_EQ(m_world.getEntityCount(), 2u);
+}
+
+/// @brief Test queries match archetypes created before and after them, and visit every entity once
+TEST_F(WorldFixture, QueriesMatchArchetypes) {
+    m_world.create(Position{ 1.0f, 0.0f, 0.0f });
+    lov::ECS::Query& query = m_world.query<Position>();
+
+    m_world.create(Position{ 2.0f, 0.0f, 0.0f }, Velocity{});
+    m_world.create(Velocity{});
+    m_world.create(Position{ 3.0f, 0.0f, 0.0f }, Health{ 1 });
+
+    lov::ECS::Query& again = m_world.query<Position>();
+    ASSERT_EQ(&again, &query);
+    ASSERT_EQ(query.getArchetypes().size(), 3u);
+    ASSERT_EQ(query.getEntityCount(), 3u);
+    lov::ECS::Query& moving = m_world.query<Position, Velocity>();
+    ASSERT_EQ(moving.getEntityCount(), 1u);
+
+    float sum = 0.0f;
+    query.forEach<Position>([&sum](lov::ECS::Entity, Position& position) {
+        sum += position.x;
+    });
+    ASSERT_EQ(sum, 6.0f);
+}
+
+/// @brief Test rows are split into chunks that fit the chunk size, with aligned columns
+TEST_F(WorldFixture, SplitsChunks) {
+    const lov::lov_uint count = 5000;
+    std::set<lov::lov_uint> indices;
+    for (lov::lov_uint i = 0; i < count; i++) {
+        indices.insert(m_world.create(Position{ static_cast<float>(i), 0.0f, 0.0f }, Health{ static_cast<int>(i) }).index);
+    }
+
+    lov::ECS::Query& query = m_world.query<Position, Health>();
+    ASSERT_EQ(query.getArchetypes().size(), 1u);
+
+    const lov::ECS::Archetype& archetype = *query.getArchetypes()[0];
+    lov::lov_uint capacity = archetype.getChunkCapacity();
+    ASSERT_GT(capacity, 0u);
+    ASSERT_LE(capacity * (sizeof(lov::ECS::Entity) + sizeof(Position) + sizeof(Health)), lov::ECS::Archetype::ChunkSize);
+    ASSERT_EQ(archetype.getChunks().size(), (count + capacity - 1) / capacity);
+
+    lov::lov_uint visited = 0;
+    query.forEachChunk([&](const lov::ECS::ChunkView& view) {
+        ASSERT_LE(view.getCount(), capacity);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(view.get<Health>().data()) % alignof(Health), 0u);
+
+        for (lov::lov_uint row = 0; row < view.getCount(); row++) {
+            ASSERT_EQ(view.get<Health>()[row].value, static_cast<int>(view.get<Position>()[row].x));
+            ASSERT_TRUE(indices.count(view.getEntities()[row].index));
+        }
+        visited += view.getCount();
+    });
+    ASSERT_EQ(visited, count);
+}
+
+/// @brief Test that components too big for a chunk, with or without their alignment padding, throw rather than fit no rows
+TEST_F(WorldFixture, RejectsRowsLargerThanAChunk) {
+    // Register the padded component first, so its column comes before the large one and pushes it past the chunk
+    lov::ECS::ComponentMask padded = lov::ECS::getComponentMask<Padded>();
+    lov::ECS::ComponentMask large = lov::ECS::getComponentMask<Large>();
+
+    ASSERT_EQ(lov::ECS::Archetype(large).getChunkCapacity(), 1u);
+    ASSERT_THROW(lov::ECS::Archetype(padded | large), lov::Exceptions::EntityException);
+    ASSERT_THROW(lov::ECS::Archetype(lov::ECS::getComponentMask<Huge>()), lov::Exceptions::EntityException);
+}
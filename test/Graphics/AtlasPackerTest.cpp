@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Graphics/AtlasPacker.h"
+
+/// @brief Fixture used for AtlasPacker tests
+class AtlasPackerFixture : public ::testing::Test {
+protected:
+    /// @brief Do two rectangles overlap, counting the padding around each?
+    static bool overlaps(const lov::Graphics::AtlasRect& a, const lov::Graphics::AtlasRect& b, lov::lov_int padding) {
+        return a.x - padding < b.x + b.width + padding && b.x - padding < a.x + a.width + padding &&
+            a.y - padding < b.y + b.height + padding && b.y - padding < a.y + a.height + padding;
+    }
+};
+
+/// @brief Test that rectangles fill the bottom row before stacking
+TEST_F(AtlasPackerFixture, PacksBottomLeft) {
+    lov::Graphics::AtlasPacker packer(64, 64);
+    lov::Graphics::AtlasRect a, b, c;
+
+    ASSERT_TRUE(packer.pack(32, 16, a));
+    ASSERT_TRUE(packer.pack(32, 8, b));
+    ASSERT_TRUE(packer.pack(32, 8, c));
+
+    ASSERT_EQ(a.x, 0);
+    ASSERT_EQ(a.y, 0);
+    ASSERT_EQ(b.x, 32);
+    ASSERT_EQ(b.y, 0);
+    ASSERT_EQ(c.x, 32);
+    ASSERT_EQ(c.y, 8);
+    ASSERT_FLOAT_EQ(packer.getOccupancy(), (32.0f * 16 * 2) / (64 * 64));
+}
+
+/// @brief Test that rectangles never overlap or leave the page, padding included
+TEST_F(AtlasPackerFixture, NoOverlap) {
+    const lov::lov_int padding = 2;
+    lov::Graphics::AtlasPacker packer(256, 256, padding);
+    std::vector<lov::Graphics::AtlasRect> rects;
+
+    for (lov::lov_int i = 0; i < 200; i++) {
+        lov::Graphics::AtlasRect rect;
+        if (packer.pack(4 + (i * 7) % 29, 4 + (i * 13) % 23, rect)) {
+            rects.push_back(rect);
+        }
+    }
+
+    ASSERT_GT(rects.size(), 50u);
+    ASSERT_GT(packer.getOccupancy(), 0.7f);
+    for (size_t i = 0; i < rects.size(); i++) {
+        ASSERT_GE(rects[i].x - padding, 0);
+        ASSERT_GE(rects[i].y - padding, 0);
+        ASSERT_LE(rects[i].x + rects[i].width + padding, 256);
+        ASSERT_LE(rects[i].y + rects[i].height + padding, 256);
+        for (size_t j = i + 1; j < rects.size(); j++) {
+            ASSERT_FALSE(overlaps(rects[i], rects[j], padding));
+        }
+    }
+}
+
+/// @brief Test that rectangles that don't fit are rejected and clearing frees the page
+TEST_F(AtlasPackerFixture, RejectsAndClears) {
+    lov::Graphics::AtlasPacker packer(32, 32);
+    lov::Graphics::AtlasRect rect;
+
+    ASSERT_FALSE(packer.pack(33, 1, rect));
+    ASSERT_TRUE(packer.pack(32, 32, rect));
+    ASSERT_FALSE(packer.pack(1, 1, rect));
+
+    packer.clear();
+    ASSERT_TRUE(packer.pack(1, 1, rect));
+}
+
+/// @brief Test that texture coordinates are mapped into the packed rectangle
+TEST_F(AtlasPackerFixture, RemapsTexCoords) {
+    lov::Graphics::AtlasRegion region = lov::Graphics::AtlasRegion::fromRect({ 64, 32, 32, 16 }, 128, 64, 3);
+
+    ASSERT_EQ(region.layer, 3);
+    ASSERT_EQ(region.remap(lov::Vector2f(0.0f, 0.0f)), lov::Vector2f(0.5f, 0.5f));
+    ASSERT_EQ(region.remap(lov::Vector2f(1.0f, 1.0f)), lov::Vector2f(0.75f, 0.75f));
+}
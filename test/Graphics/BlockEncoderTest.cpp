@@ -0,0 +1,383 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Graphics/BlockEncoder.h"
+
+/// @brief Fixture used for BlockEncoder tests, decoding each format the way the GPU does
+class BlockEncoderFixture : public ::testing::Test {
+protected:
+    /// @brief A block of 16 RGBA8 pixels in rows of 4
+    typedef std::vector<unsigned char> Block;
+
+    /// @brief Reads fields from a block from the least significant bit up
+    struct BitReader {
+        const unsigned char* in;    ///< The block
+        int position;               ///< The next bit to read
+
+        /// @brief Read a field
+        /// @param bits The width of the field
+        /// @return The value of the field
+        int read(int bits) {
+            int value = 0;
+            for (int i = 0; i < bits; i++, position++) {
+                value |= ((in[position / 8] >> (position % 8)) & 1) << i;
+            }
+            return value;
+        }
+    };
+
+    /// @brief Build a block from a function of each pixel's position
+    template <typename F>
+    static Block makeBlock(F pixel) {
+        Block block(64);
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                pixel(x, y, &block[(y * 4 + x) * 4]);
+            }
+        }
+        return block;
+    }
+
+    /// @brief A smooth gradient in every channel
+    static Block gradient() {
+        return makeBlock([](int x, int y, unsigned char* pixel) {
+            pixel[0] = static_cast<unsigned char>(40 + 16 * x);
+            pixel[1] = static_cast<unsigned char>(80 + 12 * y);
+            pixel[2] = static_cast<unsigned char>(200 - 10 * (x + y));
+            pixel[3] = static_cast<unsigned char>(255 - 8 * (x + y));
+        });
+    }
+
+    /// @brief Pixels with no pattern, from a fixed seed
+    static Block noise() {
+        std::uint32_t state = 12345;
+        return makeBlock([&state](int, int, unsigned char* pixel) {
+            for (int c = 0; c < 4; c++) {
+                state = state * 1664525u + 1013904223u;
+                pixel[c] = static_cast<unsigned char>(state >> 24);
+            }
+        });
+    }
+
+    /// @brief One colour everywhere
+    static Block solid(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha) {
+        return makeBlock([=](int, int, unsigned char* pixel) {
+            pixel[0] = red;
+            pixel[1] = green;
+            pixel[2] = blue;
+            pixel[3] = alpha;
+        });
+    }
+
+    /// @brief Opaque black on the left half and translucent white on the right
+    static Block twoColor() {
+        return makeBlock([](int x, int, unsigned char* pixel) {
+            unsigned char value = x < 2 ? 0 : 255;
+            pixel[0] = pixel[1] = pixel[2] = value;
+            pixel[3] = x < 2 ? 255 : 128;
+        });
+    }
+
+    /// @brief Expand an RGB565 colour
+    static void from565(int packed, int* color) {
+        int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    /// @brief Decode a BC1 colour block into the RGB of each pixel
+    static void decodeBC1(const unsigned char* in, Block& out, bool alwaysFourColor = false) {
+        int first = in[0] | (in[1] << 8), second = in[2] | (in[3] << 8);
+        int palette[4][3];
+        from565(first, palette[0]);
+        from565(second, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            if (first > second || alwaysFourColor) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+            else {
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                palette[3][c] = 0;
+            }
+        }
+
+        std::uint32_t bits = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<std::uint32_t>(in[7]) << 24);
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < 3; c++) {
+                out[i * 4 + c] = static_cast<unsigned char>(palette[(bits >> (i * 2)) & 3][c]);
+            }
+        }
+    }
+
+    /// @brief Decode a BC4 block into one channel of each pixel
+    static void decodeBC4(const unsigned char* in, Block& out, int channel) {
+        int first = in[0], second = in[1];
+        int palette[8] = { first, second };
+        if (first > second) {
+            for (int i = 2; i < 8; i++) {
+                palette[i] = ((8 - i) * first + (i - 1) * second) / 7;
+            }
+        }
+        else {
+            for (int i = 2; i < 6; i++) {
+                palette[i] = ((6 - i) * first + (i - 1) * second) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 6; i++) {
+            bits |= static_cast<std::uint64_t>(in[2 + i]) << (i * 8);
+        }
+
+        for (int i = 0; i < 16; i++) {
+            out[i * 4 + channel] = static_cast<unsigned char>(palette[(bits >> (i * 3)) & 7]);
+        }
+    }
+
+    /// @brief Decode a BC7 mode 6 block
+    static void decodeBC7(const unsigned char* in, Block& out) {
+        static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        BitReader reader = { in, 0 };
+        ASSERT_EQ(reader.read(7), 1 << 6);
+
+        int endpoints[2][4];
+        for (int c = 0; c < 4; c++) {
+            endpoints[0][c] = reader.read(7) << 1;
+            endpoints[1][c] = reader.read(7) << 1;
+        }
+
+        int parity[2] = { reader.read(1), reader.read(1) };
+        for (int c = 0; c < 4; c++) {
+            endpoints[0][c] |= parity[0];
+            endpoints[1][c] |= parity[1];
+        }
+
+        for (int i = 0; i < 16; i++) {
+            int index = reader.read(i == 0 ? 3 : 4);
+            for (int c = 0; c < 4; c++) {
+                out[i * 4 + c] = static_cast<unsigned char>(((64 - weights[index]) * endpoints[0][c] + weights[index] * endpoints[1][c] + 32) >> 6);
+            }
+        }
+    }
+
+    /// @brief Decode an ETC2 RGB8 block in its individual or differential mode
+    static void decodeETC2(const unsigned char* in, Block& out) {
+        static const int modifiers[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+        bool differential = (in[3] & 2) != 0;
+        bool flip = (in[3] & 1) != 0;
+        int tables[2] = { in[3] >> 5, (in[3] >> 2) & 7 };
+
+        int bases[2][3];
+        for (int c = 0; c < 3; c++) {
+            if (differential) {
+                int first = in[c] >> 3;
+                int offset = (in[c] & 7) >= 4 ? (in[c] & 7) - 8 : (in[c] & 7);
+
+                // Overflowing the 5 bits would select the T, H or planar modes instead
+                ASSERT_GE(first + offset, 0);
+                ASSERT_LE(first + offset, 31);
+                bases[0][c] = (first << 3) | (first >> 2);
+                bases[1][c] = ((first + offset) << 3) | ((first + offset) >> 2);
+            }
+            else {
+                bases[0][c] = (in[c] >> 4) * 17;
+                bases[1][c] = (in[c] & 15) * 17;
+            }
+        }
+
+        std::uint32_t bits = (static_cast<std::uint32_t>(in[4]) << 24) | (in[5] << 16) | (in[6] << 8) | in[7];
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                int subblock = flip ? (y >= 2) : (x >= 2);
+                int bit = x * 4 + y;
+                int index = (((bits >> (16 + bit)) & 1) << 1) | ((bits >> bit) & 1);
+                int modifier = modifiers[tables[subblock]][index & 1] * (index & 2 ? -1 : 1);
+                for (int c = 0; c < 3; c++) {
+                    out[(y * 4 + x) * 4 + c] = static_cast<unsigned char>(std::clamp(bases[subblock][c] + modifier, 0, 255));
+                }
+            }
+        }
+    }
+
+    /// @brief Decode an EAC block into the alpha of each pixel
+    static void decodeEAC(const unsigned char* in, Block& out) {
+        static const int modifiers[16][8] = {
+            { -3, -6, -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 },
+            { -2, -4, -6, -13, 1, 3, 5, 12 }, { -3, -6, -8, -12, 2, 5, 7, 11 }, { -3, -7, -9, -11, 2, 6, 8, 10 },
+            { -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 }, { -2, -6, -8, -10, 1, 5, 7, 9 },
+            { -2, -5, -8, -10, 1, 4, 7, 9 }, { -2, -4, -8, -10, 1, 3, 7, 9 }, { -2, -5, -7, -10, 1, 4, 6, 9 },
+            { -3, -4, -7, -10, 2, 3, 6, 9 }, { -1, -2, -3, -10, 0, 1, 2, 9 }, { -4, -6, -8, -9, 3, 5, 7, 8 },
+            { -3, -5, -7, -9, 2, 4, 6, 8 }
+        };
+
+        int base = in[0], multiplier = in[1] >> 4, table = in[1] & 15;
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 6; i++) {
+            bits = (bits << 8) | in[2 + i];
+        }
+
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                int index = (bits >> (45 - (x * 4 + y) * 3)) & 7;
+                out[(y * 4 + x) * 4 + 3] = static_cast<unsigned char>(std::clamp(base + modifiers[table][index] * multiplier, 0, 255));
+            }
+        }
+    }
+
+    /// @brief Measure how closely a decoded block matches the original
+    /// @param original The encoded pixels
+    /// @param decoded The decoded pixels
+    /// @param firstChannel The first channel the format stores
+    /// @param channels The number of channels the format stores
+    /// @return The peak signal to noise ratio in decibels, or 100 for an exact match
+    static double psnr(const Block& original, const Block& decoded, int firstChannel, int channels) {
+        double error = 0.0;
+        for (int i = 0; i < 16; i++) {
+            for (int c = firstChannel; c < firstChannel + channels; c++) {
+                double difference = static_cast<double>(original[i * 4 + c]) - decoded[i * 4 + c];
+                error += difference * difference;
+            }
+        }
+
+        if (error == 0.0) {
+            return 100.0;
+        }
+
+        return 10.0 * std::log10(255.0 * 255.0 / (error / (16 * channels)));
+    }
+
+    /// @brief Get the largest difference of any stored channel
+    static int maxError(const Block& original, const Block& decoded, int firstChannel, int channels) {
+        int largest = 0;
+        for (int i = 0; i < 16; i++) {
+            for (int c = firstChannel; c < firstChannel + channels; c++) {
+                largest = std::max(largest, std::abs(original[i * 4 + c] - decoded[i * 4 + c]));
+            }
+        }
+        return largest;
+    }
+
+    /// @brief Round trip a block through BC1
+    static Block roundTripBC1(const Block& block) {
+        unsigned char encoded[8];
+        Block decoded(64, 0);
+        lov::Graphics::BlockEncoder::encodeBC1(block.data(), encoded);
+        decodeBC1(encoded, decoded);
+        return decoded;
+    }
+
+    /// @brief Round trip a block through BC3
+    static Block roundTripBC3(const Block& block) {
+        unsigned char encoded[16];
+        Block decoded(64, 0);
+        lov::Graphics::BlockEncoder::encodeBC3(block.data(), encoded);
+        decodeBC4(encoded, decoded, 3);
+        decodeBC1(encoded + 8, decoded, true);
+        return decoded;
+    }
+
+    /// @brief Round trip a block through BC5
+    static Block roundTripBC5(const Block& block) {
+        unsigned char encoded[16];
+        Block decoded(64, 0);
+        lov::Graphics::BlockEncoder::encodeBC5(block.data(), encoded);
+        decodeBC4(encoded, decoded, 0);
+        decodeBC4(encoded + 8, decoded, 1);
+        return decoded;
+    }
+
+    /// @brief Round trip a block through BC7
+    static Block roundTripBC7(const Block& block) {
+        unsigned char encoded[16];
+        Block decoded(64, 0);
+        lov::Graphics::BlockEncoder::encodeBC7(block.data(), encoded);
+        decodeBC7(encoded, decoded);
+        return decoded;
+    }
+
+    /// @brief Round trip a block through ETC2 RGB8
+    static Block roundTripETC2(const Block& block) {
+        unsigned char encoded[8];
+        Block decoded(64, 0);
+        lov::Graphics::BlockEncoder::encodeETC2(block.data(), encoded);
+        decodeETC2(encoded, decoded);
+        return decoded;
+    }
+
+    /// @brief Round trip a block through ETC2 RGBA8
+    static Block roundTripETC2Alpha(const Block& block) {
+        unsigned char encoded[16];
+        Block decoded(64, 0);
+        lov::Graphics::BlockEncoder::encodeETC2Alpha(block.data(), encoded);
+        decodeEAC(encoded, decoded);
+        decodeETC2(encoded + 8, decoded);
+        return decoded;
+    }
+};
+
+/// @brief Test that a smooth gradient survives each format with little error
+TEST_F(BlockEncoderFixture, GradientRoundTrips) {
+    Block block = gradient();
+
+    ASSERT_GE(psnr(block, roundTripBC1(block), 0, 3), 26.0);
+    ASSERT_GE(psnr(block, roundTripBC3(block), 0, 3), 26.0);
+    ASSERT_GE(psnr(block, roundTripBC3(block), 3, 1), 40.0);
+    ASSERT_GE(psnr(block, roundTripBC5(block), 0, 2), 40.0);
+    ASSERT_GE(psnr(block, roundTripBC7(block), 0, 4), 28.0);
+    ASSERT_GE(psnr(block, roundTripETC2(block), 0, 3), 24.0);
+    ASSERT_GE(psnr(block, roundTripETC2Alpha(block), 0, 3), 24.0);
+    ASSERT_GE(psnr(block, roundTripETC2Alpha(block), 3, 1), 40.0);
+}
+
+/// @brief Test that a block with no pattern still decodes to the closest the format allows rather than garbage
+TEST_F(BlockEncoderFixture, NoiseRoundTrips) {
+    Block block = noise();
+
+    ASSERT_GE(psnr(block, roundTripBC1(block), 0, 3), 12.0);
+    ASSERT_GE(psnr(block, roundTripBC3(block), 3, 1), 26.0);
+    ASSERT_GE(psnr(block, roundTripBC5(block), 0, 2), 26.0);
+    ASSERT_GE(psnr(block, roundTripBC7(block), 0, 4), 11.0);
+    ASSERT_GE(psnr(block, roundTripETC2(block), 0, 3), 10.0);
+    ASSERT_GE(psnr(block, roundTripETC2Alpha(block), 3, 1), 26.0);
+}
+
+/// @brief Test that a solid block is only off by each format's quantization of its endpoints
+TEST_F(BlockEncoderFixture, SolidColor) {
+    Block block = solid(200, 100, 50, 180);
+
+    ASSERT_LE(maxError(block, roundTripBC1(block), 0, 3), 4);
+    ASSERT_LE(maxError(block, roundTripBC3(block), 0, 3), 4);
+    ASSERT_EQ(maxError(block, roundTripBC3(block), 3, 1), 0);
+    ASSERT_EQ(maxError(block, roundTripBC5(block), 0, 2), 0);
+    ASSERT_EQ(maxError(block, roundTripBC7(block), 0, 4), 0);
+    ASSERT_LE(maxError(block, roundTripETC2(block), 0, 3), 4);
+    ASSERT_EQ(maxError(block, roundTripETC2Alpha(block), 3, 1), 0);
+
+    // Equal BC1 endpoints would switch to three colour mode, which must not turn any pixel black
+    Block black = solid(0, 0, 0, 255);
+    ASSERT_EQ(maxError(black, roundTripBC1(black), 0, 3), 0);
+    Block white = solid(255, 255, 255, 255);
+    ASSERT_EQ(maxError(white, roundTripBC1(white), 0, 3), 0);
+}
+
+/// @brief Test that a block of two colours lying on each format's endpoints or subblocks round trips exactly
+TEST_F(BlockEncoderFixture, TwoColors) {
+    Block block = twoColor();
+
+    ASSERT_EQ(maxError(block, roundTripBC1(block), 0, 3), 0);
+    ASSERT_EQ(maxError(block, roundTripBC3(block), 0, 4), 0);
+    ASSERT_EQ(maxError(block, roundTripBC5(block), 0, 2), 0);
+    ASSERT_LE(maxError(block, roundTripBC7(block), 0, 4), 1);
+    ASSERT_EQ(maxError(block, roundTripETC2(block), 0, 3), 0);
+    ASSERT_EQ(maxError(block, roundTripETC2Alpha(block), 0, 4), 0);
+}
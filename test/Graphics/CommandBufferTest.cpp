@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "Graphics/CommandBuffer.h"
+#include "System/JobSystem.h"
+
+/// @brief Fixture used for CommandBuffer tests
+class CommandBufferFixture : public ::testing::Test {
+protected:
+    /// @brief Record a group that draws with a program, vertex array and uniform value
+    /// @param buffer The buffer to record into
+    /// @param key The group's key
+    /// @param value Stored in the uniform block and as the draw's first index, to identify the group
+    void record(lov::Graphics::CommandBuffer& buffer, uint64_t key, lov::lov_uint value) {
+        buffer.begin(key);
+        buffer.bindProgram(1);
+        buffer.bindVertexArray(2);
+        buffer.setUniformBlock(0, value);
+        buffer.drawElements(36, value);
+    }
+
+    /// @brief Get the value a group was recorded with
+    /// @param group The group
+    /// @return Its draw's first index
+    lov::lov_uint valueOf(const lov::Graphics::RenderCommandGroup& group) {
+        for (const lov::Graphics::RenderCommand* command = group.first; command; command = command->next) {
+            if (command->type == lov::Graphics::RenderCommandType::DrawElements) {
+                return command->draw.firstIndex;
+            }
+        }
+
+        return 0;
+    }
+};
+
+/// @brief Test that a group's commands are chained in order, with uniform data copied
+TEST_F(CommandBufferFixture, ChainsCommandsInOrder) {
+    lov::Graphics::CommandBuffer buffer(256);
+    record(buffer, 5, 7);
+
+    ASSERT_EQ(buffer.getGroups().size(), 1);
+    ASSERT_EQ(buffer.getGroups()[0].key, 5u);
+    ASSERT_EQ(buffer.getUniformSize(), sizeof(lov::lov_uint));
+
+    const lov::Graphics::RenderCommand* command = buffer.getGroups()[0].first;
+    ASSERT_EQ(command->type, lov::Graphics::RenderCommandType::BindProgram);
+    ASSERT_EQ(command->program, 1u);
+
+    command = command->next;
+    ASSERT_EQ(command->type, lov::Graphics::RenderCommandType::BindVertexArray);
+    ASSERT_EQ(command->vertexArray, 2u);
+
+    command = command->next;
+    ASSERT_EQ(command->type, lov::Graphics::RenderCommandType::SetUniformBlock);
+    lov::lov_uint value = 0;
+    std::memcpy(&value, command->uniformBlock.data, sizeof(value));
+    ASSERT_EQ(value, 7u);
+
+    command = command->next;
+    ASSERT_EQ(command->type, lov::Graphics::RenderCommandType::DrawElements);
+    ASSERT_EQ(command->draw.count, 36);
+    ASSERT_EQ(command->next, nullptr);
+
+    // Commands outside a group start one with key 0
+    buffer.clear();
+    ASSERT_TRUE(buffer.getGroups().empty());
+    buffer.drawElements(3);
+    ASSERT_EQ(buffer.getGroups().size(), 1);
+    ASSERT_EQ(buffer.getGroups()[0].key, 0u);
+}
+
+/// @brief Test that sorting and merging orders groups by key, keeping the recorded order of equal keys
+TEST_F(CommandBufferFixture, SortsAndMergesByKey) {
+    std::vector<lov::Graphics::CommandBuffer> buffers(3);
+    record(buffers[0], 3, 0);
+    record(buffers[0], 1, 1);
+    record(buffers[0], 2, 2);
+    record(buffers[1], 2, 3);
+    record(buffers[1], 0, 4);
+    record(buffers[2], 2, 5);
+    record(buffers[2], 2, 6);
+
+    for (lov::Graphics::CommandBuffer& buffer : buffers) {
+        buffer.sort();
+    }
+
+    std::vector<const lov::Graphics::RenderCommandGroup*> groups;
+    lov::Graphics::CommandBuffer::merge(buffers, groups);
+
+    std::vector<lov::lov_uint> values;
+    for (const lov::Graphics::RenderCommandGroup* group : groups) {
+        values.push_back(valueOf(*group));
+    }
+
+    ASSERT_EQ(values, std::vector<lov::lov_uint>({ 4, 1, 2, 3, 5, 6, 0 }));
+}
+
+/// @brief Test that jobs recording into per-thread buffers record every draw exactly once
+TEST_F(CommandBufferFixture, RecordsPerThread) {
+    lov::System::JobSystem jobs(3);
+    std::vector<lov::Graphics::CommandBuffer> buffers(jobs.getThreadCount());
+
+    const lov::lov_size drawCount = 10000;
+    jobs.parallelFor(drawCount, [&](lov::lov_size begin, lov::lov_size end) {
+        lov::Graphics::CommandBuffer& buffer = buffers[jobs.getThreadIndex()];
+        for (lov::lov_size i = begin; i < end; i++) {
+            record(buffer, static_cast<uint64_t>(drawCount - i), static_cast<lov::lov_uint>(i));
+        }
+    }, 64);
+
+    jobs.parallelFor(static_cast<lov::lov_size>(buffers.size()), [&](lov::lov_size begin, lov::lov_size end) {
+        for (lov::lov_size i = begin; i < end; i++) {
+            buffers[i].sort();
+        }
+    }, 1);
+
+    std::vector<const lov::Graphics::RenderCommandGroup*> groups;
+    lov::Graphics::CommandBuffer::merge(buffers, groups);
+    ASSERT_EQ(groups.size(), static_cast<size_t>(drawCount));
+
+    // Keys count down, so the merged draws count down too
+    for (lov::lov_size i = 0; i < drawCount; i++) {
+        ASSERT_EQ(valueOf(*groups[i]), static_cast<lov::lov_uint>(drawCount - 1 - i));
+    }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/ComputeCuller.h"
+#include "Graphics/Transform.h"
+#include "Graphics/Window.h"
+#include "System/Exceptions.h"
+#include "System/Utility.h"
+
+/// @brief Fixture used for ComputeCuller tests, culling in a headless window or skipping where compute isn't available
+class ComputeCullerFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        try {
+            window = std::make_unique<lov::Graphics::Window>(16, 16, "ComputeCullerTest", lov::Graphics::WindowMode::Headless);
+        }
+        catch (const lov::Exceptions::WindowException& e) {
+            GTEST_SKIP() << e.what();
+        }
+
+        if (!lov::Graphics::ComputeCuller::isSupported()) {
+            GTEST_SKIP() << "Compute shaders or indirect draws aren't supported";
+        }
+
+        lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(lov::Util::toRadians(60.0f), 1.0f, 0.1f, 100.0f);
+        lov::Graphics::Transform view = lov::Graphics::Transform::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f });
+        viewProjection = projection * view;
+    }
+
+    std::unique_ptr<lov::Graphics::Window> window;  ///< The headless window whose context culls
+    lov::Graphics::Transform viewProjection;        ///< The camera's view projection
+};
+
+/// @brief Test that the shader finds the same visible instances of each command as the CPU reference
+TEST_F(ComputeCullerFixture, MatchesReference) {
+    lov::Graphics::ComputeCuller culler;
+    culler.compile(std::string(LOV_TEST_RESOURCE_DIR) + "/Shaders/cull.comp");
+
+    lov::Graphics::BoundingBox bounds;
+    bounds.expand({ -0.5f, -0.5f, -0.5f });
+    bounds.expand({ 0.5f, 0.5f, 0.5f });
+
+    lov::lov_uint draws[] = { culler.addDraw(36, 0, 0), culler.addDraw(36, 36, 24) };
+    for (int x = -20; x <= 20; x += 2) {
+        for (int z = -60; z <= 20; z += 4) {
+            culler.addInstance(lov::Graphics::Transform().translate(static_cast<float>(x), 0.0f, static_cast<float>(z)), bounds, draws[((x + z) / 2) & 1]);
+        }
+    }
+
+    culler.upload();
+    culler.cull(viewProjection);
+
+    // Some of the grid is behind or beside the camera, so the comparison covers culled instances too
+    std::vector<lov::Graphics::DrawElementsIndirectCommand> commands;
+    std::vector<lov::lov_uint> visible;
+    culler.cullReference(viewProjection, commands, visible);
+
+    // Neighbouring columns alternate meshes, so both commands have visible instances to compact
+    ASSERT_GT(commands[0].instanceCount, 0u);
+    ASSERT_GT(commands[1].instanceCount, 0u);
+    ASSERT_LT(commands[0].instanceCount + commands[1].instanceCount, culler.getInstances().size());
+    ASSERT_EQ(culler.validate(viewProjection), 0);
+
+    // Moving an instance into view changes both results the same way
+    culler.setTransform(0, lov::Graphics::Transform().translate(0.0f, 0.0f, -5.0f));
+    culler.upload();
+    culler.cull(viewProjection);
+
+    ASSERT_EQ(culler.validate(viewProjection), 0);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/Transform.h"
+#include "System/Utility.h"
+
+/// @brief Fixture used for Frustum tests
+class FrustumFixture : public ::testing::Test {
+protected:
+    /// @brief Build a frustum for a camera at the origin looking down -z
+    /// @return The camera's frustum
+    static lov::Graphics::Frustum getCameraFrustum() {
+        lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(lov::Util::toRadians(90.0f), 1.0f, 0.1f, 100.0f);
+        lov::Graphics::Transform view = lov::Graphics::Transform::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f });
+        return lov::Graphics::Frustum(projection * view);
+    }
+
+    /// @brief Build a unit box centered on the given point
+    /// @param center The center of the box
+    /// @return The box
+    static lov::Graphics::BoundingBox unitBox(const lov::Vector3f& center) {
+        return { center - 0.5f, center + 0.5f };
+    }
+};
+
+/// @brief Test that an empty box grows to contain expanded points
+TEST_F(FrustumFixture, BoundingBoxExpand) {
+    lov::Graphics::BoundingBox box;
+    ASSERT_TRUE(box.isEmpty());
+
+    box.expand(lov::Vector3f(1.0f, -2.0f, 3.0f));
+    box.expand(lov::Vector3f(-1.0f, 2.0f, 0.0f));
+
+    ASSERT_FALSE(box.isEmpty());
+    ASSERT_EQ(box.min, lov::Vector3f(-1.0f, -2.0f, 0.0f));
+    ASSERT_EQ(box.max, lov::Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+/// @brief Test that a transformed box bounds the transformed corners
+TEST_F(FrustumFixture, BoundingBoxTransformed) {
+    lov::Graphics::BoundingBox box = unitBox({ 0.0f, 0.0f, 0.0f });
+    lov::Graphics::Transform model = lov::Graphics::Transform().translate(10.0f, 0.0f, 0.0f).scale(2.0f, 2.0f, 2.0f);
+
+    lov::Graphics::BoundingBox result = box.transformed(model);
+
+    ASSERT_FLOAT_EQ(result.min.x, 9.0f);
+    ASSERT_FLOAT_EQ(result.max.x, 11.0f);
+    ASSERT_FLOAT_EQ(result.min.y, -1.0f);
+    ASSERT_FLOAT_EQ(result.max.z, 1.0f);
+}
+
+/// @brief Test that boxes in front of the camera are visible
+TEST_F(FrustumFixture, BoxInside) {
+    lov::Graphics::Frustum frustum = getCameraFrustum();
+
+    ASSERT_TRUE(frustum.intersects(unitBox({ 0.0f, 0.0f, -5.0f })));
+    ASSERT_TRUE(frustum.intersects(unitBox({ 4.0f, 0.0f, -5.0f })));
+}
+
+/// @brief Test that boxes behind, beside, and beyond the camera are culled
+TEST_F(FrustumFixture, BoxOutside) {
+    lov::Graphics::Frustum frustum = getCameraFrustum();
+
+    ASSERT_FALSE(frustum.intersects(unitBox({ 0.0f, 0.0f, 5.0f })));
+    ASSERT_FALSE(frustum.intersects(unitBox({ 20.0f, 0.0f, -5.0f })));
+    ASSERT_FALSE(frustum.intersects(unitBox({ 0.0f, 0.0f, -200.0f })));
+}
+
+/// @brief Test that spheres are culled against the same planes
+TEST_F(FrustumFixture, Sphere) {
+    lov::Graphics::Frustum frustum = getCameraFrustum();
+
+    ASSERT_TRUE(frustum.intersects({ 0.0f, 0.0f, -5.0f }, 1.0f));
+    ASSERT_TRUE(frustum.intersects({ 0.0f, 0.0f, 0.5f }, 1.0f));
+    ASSERT_FALSE(frustum.intersects({ 0.0f, 0.0f, 5.0f }, 1.0f));
+}
+
+/// @brief Test that the default frustum accepts everything
+TEST_F(FrustumFixture, DefaultAcceptsAll) {
+    lov::Graphics::Frustum frustum;
+
+    ASSERT_TRUE(frustum.intersects(unitBox({ 0.0f, 0.0f, 1000.0f })));
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/InstanceCulling.h"
+#include "Graphics/Transform.h"
+#include "System/Utility.h"
+
+/// @brief Fixture used for InstanceCulling tests
+class InstanceCullingFixture : public ::testing::Test {
+protected:
+    /// @brief Build the view projection of a camera at the origin looking down -z
+    InstanceCullingFixture() {
+        lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(lov::Util::toRadians(60.0f), 1.0f, 0.1f, 100.0f);
+        lov::Graphics::Transform view = lov::Graphics::Transform::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f });
+        viewProjection = projection * view;
+    }
+
+    /// @brief Build an instance of a unit cube at the given position
+    /// @param position The position of the cube
+    /// @param command The draw command of the cube
+    /// @return The instance
+    static lov::Graphics::CullInstance cube(const lov::Vector3f& position, lov::lov_uint command) {
+        lov::Graphics::CullInstance instance = {};
+        instance.model = lov::Graphics::Transform().translate(position);
+        instance.center = { 0.0f, 0.0f, 0.0f, 0.0f };
+        instance.extents = { 0.5f, 0.5f, 0.5f, 0.0f };
+        instance.command = command;
+        return instance;
+    }
+
+    lov::Graphics::Transform viewProjection; ///< The camera's view projection
+};
+
+/// @brief Test that the pyramid halves each level and keeps the farthest depth
+TEST_F(InstanceCullingFixture, PyramidKeepsFarthest) {
+    std::vector<float> depth = {
+        0.1f, 0.2f, 0.3f,
+        0.4f, 0.9f, 0.1f,
+        0.1f, 0.1f, 0.5f
+    };
+
+    lov::Graphics::DepthPyramid pyramid;
+    pyramid.build(depth.data(), 3, 3);
+
+    ASSERT_EQ(pyramid.getLevelCount(), 2);
+    ASSERT_EQ(pyramid.getWidth(1), 1);
+    ASSERT_FLOAT_EQ(pyramid.getDepth(1, 0, 0), 0.9f);
+}
+
+/// @brief Test that the reference matches brute force frustum culling and fills each command's range
+TEST_F(InstanceCullingFixture, MatchesBruteForce) {
+    std::vector<lov::Graphics::CullInstance> instances;
+    for (int x = -10; x <= 10; x += 2) {
+        for (int z = -30; z <= 10; z += 4) {
+            instances.push_back(cube({ static_cast<float>(x), 0.0f, static_cast<float>(z) }, (x + z) & 1));
+        }
+    }
+
+    // Give each command room for every one of its instances
+    std::vector<lov::Graphics::DrawElementsIndirectCommand> draws = { { 36, 0, 0, 0, 0 }, { 36, 0, 0, 0, 0 } };
+    for (const lov::Graphics::CullInstance& instance : instances) {
+        if (instance.command == 0) {
+            draws[1].baseInstance++;
+        }
+    }
+
+    std::vector<lov::Graphics::DrawElementsIndirectCommand> commands;
+    std::vector<lov::lov_uint> visible;
+    lov::Graphics::InstanceCulling::cull(instances, draws, viewProjection, nullptr, commands, visible);
+
+    lov::Graphics::Frustum frustum(viewProjection);
+    lov::lov_uint expected[2] = { 0, 0 };
+    for (const lov::Graphics::CullInstance& instance : instances) {
+        lov::Graphics::BoundingBox box({ -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f });
+        if (frustum.intersects(box.transformed(instance.model))) {
+            expected[instance.command]++;
+        }
+    }
+
+    ASSERT_EQ(commands[0].instanceCount, expected[0]);
+    ASSERT_EQ(commands[1].instanceCount, expected[1]);
+    ASSERT_GT(expected[0] + expected[1], 0);
+    ASSERT_LT(expected[0] + expected[1], instances.size());
+
+    for (lov::lov_uint i = 0; i < commands[1].instanceCount; i++) {
+        ASSERT_EQ(instances[visible[commands[1].baseInstance + i]].command, 1);
+    }
+}
+
+/// @brief Test that an instance behind a full screen occluder is culled while one in front is kept
+TEST_F(InstanceCullingFixture, DepthPyramidOcclusion) {
+    // A wall at view depth 10 covering the whole screen
+    lov::Vector4f wall = viewProjection * lov::Vector4f(0.0f, 0.0f, -10.0f, 1.0f);
+    float wallDepth = wall.z / wall.w * 0.5f + 0.5f;
+    std::vector<float> depth(64 * 64, wallDepth);
+
+    lov::Graphics::DepthPyramid pyramid;
+    pyramid.build(depth.data(), 64, 64);
+
+    lov::Graphics::Frustum frustum(viewProjection);
+    ASSERT_FALSE(lov::Graphics::InstanceCulling::isVisible(cube({ 0.0f, 0.0f, -20.0f }, 0), frustum, viewProjection, &pyramid));
+    ASSERT_TRUE(lov::Graphics::InstanceCulling::isVisible(cube({ 0.0f, 0.0f, -5.0f }, 0), frustum, viewProjection, &pyramid));
+    ASSERT_TRUE(lov::Graphics::InstanceCulling::isVisible(cube({ 0.0f, 0.0f, -20.0f }, 0), frustum, viewProjection, nullptr));
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Graphics/Ktx2Image.h"
+#include "System/Exceptions.h"
+
+/// @brief Fixture used for Ktx2Image tests
+class Ktx2ImageFixture : public ::testing::Test {
+protected:
+    /// @brief Build an image whose blocks hold a recognizable byte pattern
+    /// @param format The format of the image
+    /// @param width The width of level 0
+    /// @param height The height of level 0
+    /// @return The image with every level down to 1x1
+    static lov::Graphics::Ktx2Image patternImage(lov::Graphics::Ktx2Image::Format format, lov::lov_int width, lov::lov_int height) {
+        lov::Graphics::Ktx2Image image(format, width, height);
+        for (lov::lov_int level = 0; (width >> level) > 0 || (height >> level) > 0; level++) {
+            size_t size = lov::Graphics::Ktx2Image::getLevelSize(format, std::max(width >> level, 1), std::max(height >> level, 1));
+            std::vector<unsigned char> blocks(size);
+            for (size_t i = 0; i < size; i++) {
+                blocks[i] = static_cast<unsigned char>(i * 7 + level);
+            }
+
+            image.addLevel(blocks);
+        }
+
+        return image;
+    }
+};
+
+/// @brief Test that partial blocks at the edges count as whole blocks
+TEST_F(Ktx2ImageFixture, LevelSize) {
+    ASSERT_EQ(lov::Graphics::Ktx2Image::getLevelSize(lov::Graphics::Ktx2Image::BC1_RGB_UNORM, 4, 4), 8u);
+    ASSERT_EQ(lov::Graphics::Ktx2Image::getLevelSize(lov::Graphics::Ktx2Image::BC1_RGB_UNORM, 1, 1), 8u);
+    ASSERT_EQ(lov::Graphics::Ktx2Image::getLevelSize(lov::Graphics::Ktx2Image::BC7_UNORM, 5, 9), 16u * 2 * 3);
+    ASSERT_EQ(lov::Graphics::Ktx2Image::getLevelSize(lov::Graphics::Ktx2Image::ETC2_RGBA_UNORM, 500, 500), 16u * 125 * 125);
+    ASSERT_EQ(lov::Graphics::Ktx2Image::getBlockSize(0), 0);
+}
+
+/// @brief Test that a written image reads back with the same format, size and levels
+TEST_F(Ktx2ImageFixture, RoundTrip) {
+    lov::Graphics::Ktx2Image image = patternImage(lov::Graphics::Ktx2Image::BC7_SRGB, 20, 12);
+    std::vector<unsigned char> file = image.write();
+
+    ASSERT_TRUE(lov::Graphics::Ktx2Image::isKtx2(file.data(), file.size()));
+
+    lov::Graphics::Ktx2Image read = lov::Graphics::Ktx2Image::read(file.data(), file.size());
+    ASSERT_EQ(read.getFormat(), lov::Graphics::Ktx2Image::BC7_SRGB);
+    ASSERT_EQ(read.getWidth(), 20);
+    ASSERT_EQ(read.getHeight(), 12);
+    ASSERT_EQ(read.getLevelCount(), 5);
+    ASSERT_EQ(read.getByteSize(), image.getByteSize());
+
+    for (lov::lov_size level = 0; level < read.getLevelCount(); level++) {
+        ASSERT_EQ(read.getLevel(level), image.getLevel(level));
+    }
+}
+
+/// @brief Test that levels are stored smallest first and aligned to whole blocks
+TEST_F(Ktx2ImageFixture, LevelLayout) {
+    lov::Graphics::Ktx2Image image = patternImage(lov::Graphics::Ktx2Image::BC1_RGB_UNORM, 16, 16);
+    std::vector<unsigned char> file = image.write();
+
+    auto offsetOf = [&](size_t level) {
+        size_t offset = 0;
+        for (size_t i = 0; i < 8; i++) {
+            offset |= static_cast<size_t>(file[80 + level * 24 + i]) << (i * 8);
+        }
+        return offset;
+    };
+
+    for (size_t level = 0; level < 5; level++) {
+        ASSERT_EQ(offsetOf(level) % 8, 0u);
+        if (level > 0) {
+            ASSERT_LT(offsetOf(level), offsetOf(level - 1));
+        }
+    }
+
+    ASSERT_EQ(offsetOf(0) + image.getLevel(0).size(), file.size());
+}
+
+/// @brief Test that malformed files are rejected instead of read out of bounds
+TEST_F(Ktx2ImageFixture, RejectMalformed) {
+    std::vector<unsigned char> file = patternImage(lov::Graphics::Ktx2Image::BC3_UNORM, 8, 8).write();
+
+    std::vector<unsigned char> truncated(file.begin(), file.end() - 1);
+    ASSERT_THROW(lov::Graphics::Ktx2Image::read(truncated.data(), truncated.size()), lov::Exceptions::TextureException);
+
+    std::vector<unsigned char> unsupported = file;
+    unsupported[12] = 37;
+    ASSERT_THROW(lov::Graphics::Ktx2Image::read(unsupported.data(), unsupported.size()), lov::Exceptions::TextureException);
+
+    std::vector<unsigned char> png = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A, 0, 0, 0, 0 };
+    ASSERT_FALSE(lov::Graphics::Ktx2Image::isKtx2(png.data(), png.size()));
+    ASSERT_THROW(lov::Graphics::Ktx2Image::read(png.data(), png.size()), lov::Exceptions::TextureException);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Graphics/MeshCache.h"
+#include "System/Exceptions.h"
+
+/// @brief Fixture used for MeshCache tests, with a small mesh to cache
+class MeshCacheFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 5; i++) {
+            float f = static_cast<float>(i);
+            m_mesh.vertices.push_back({ { f, f + 0.5f, -f }, { 0.0f, 1.0f, 0.0f }, { f * 0.25f, 1.0f - f * 0.25f } });
+        }
+
+        m_mesh.indices = { 0, 1, 2, 2, 3, 4 };
+    }
+
+    /// @brief Check a mesh matches the cached one
+    /// @param vertices The vertices
+    /// @param indices The indices
+    void expectMatches(std::span<const lov::Graphics::Vertex> vertices, std::span<const lov::lov_uint> indices) const {
+        ASSERT_EQ(vertices.size(), m_mesh.vertices.size());
+        ASSERT_EQ(indices.size(), m_mesh.indices.size());
+        ASSERT_EQ(memcmp(vertices.data(), m_mesh.vertices.data(), vertices.size_bytes()), 0);
+        ASSERT_EQ(memcmp(indices.data(), m_mesh.indices.data(), indices.size_bytes()), 0);
+    }
+
+    lov::Graphics::MeshData m_mesh; ///< The mesh to cache
+};
+
+/// @brief Test that a serialized mesh can be viewed in place and copied back out
+TEST_F(MeshCacheFixture, SerializeViewAndRead) {
+    std::vector<std::byte> cache = lov::Graphics::MeshCache::serialize(m_mesh);
+    ASSERT_EQ(cache.size(), lov::Graphics::MeshCache::HEADER_SIZE + 5 * sizeof(lov::Graphics::Vertex) + 6 * sizeof(lov::lov_uint));
+
+    lov::Graphics::MeshView view = lov::Graphics::MeshCache::view(cache);
+    expectMatches(view.vertices, view.indices);
+    ASSERT_EQ(static_cast<const void*>(view.vertices.data()), static_cast<const void*>(cache.data() + lov::Graphics::MeshCache::HEADER_SIZE));
+
+    lov::Graphics::MeshData read = lov::Graphics::MeshCache::read(cache);
+    expectMatches(read.vertices, read.indices);
+}
+
+/// @brief Test that a cache file loads back the mesh that was written
+TEST_F(MeshCacheFixture, WriteAndLoad) {
+    std::string path = (std::filesystem::temp_directory_path() / "lov_mesh_cache_test.mesh").string();
+    lov::Graphics::MeshCache::write(m_mesh, path);
+
+    lov::Graphics::MeshData loaded = lov::Graphics::MeshCache::load(path);
+    expectMatches(loaded.vertices, loaded.indices);
+
+    std::filesystem::remove(path);
+    ASSERT_THROW(lov::Graphics::MeshCache::load(path), lov::Exceptions::IOException);
+}
+
+/// @brief Test that truncated, mislabelled or misaligned caches throw
+TEST_F(MeshCacheFixture, RejectsInvalid) {
+    std::vector<std::byte> cache = lov::Graphics::MeshCache::serialize(m_mesh);
+
+    std::vector<std::byte> truncated(cache.begin(), cache.end() - 1);
+    ASSERT_THROW(lov::Graphics::MeshCache::read(truncated), lov::Exceptions::MeshException);
+
+    std::vector<std::byte> versioned = cache;
+    versioned[8] = std::byte{ 0x7F };
+    ASSERT_THROW(lov::Graphics::MeshCache::read(versioned), lov::Exceptions::MeshException);
+
+    std::vector<std::byte> shifted(cache.size() + 1);
+    memcpy(shifted.data() + 1, cache.data(), cache.size());
+    ASSERT_THROW(lov::Graphics::MeshCache::view(std::span<const std::byte>(shifted).subspan(1)), lov::Exceptions::MeshException);
+    ASSERT_NO_THROW(lov::Graphics::MeshCache::read(std::span<const std::byte>(shifted).subspan(1)));
+
+    ASSERT_THROW(lov::Graphics::MeshCache::read({}), lov::Exceptions::MeshException);
+}
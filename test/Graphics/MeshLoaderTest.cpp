@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Graphics/MeshLoader.h"
+#include "System/Exceptions.h"
+
+/// @brief Fixture used for MeshLoader tests
+class MeshLoaderFixture : public ::testing::Test {
+protected:
+    /// @brief Convert text to the bytes of a model
+    /// @param text The text
+    /// @return The bytes
+    static std::vector<std::byte> bytesOf(const std::string& text) {
+        std::vector<std::byte> bytes(text.size());
+        memcpy(bytes.data(), text.data(), text.size());
+        return bytes;
+    }
+
+    /// @brief Build a binary glTF file
+    /// @param json The JSON chunk
+    /// @param binary The binary chunk
+    /// @return The file bytes
+    static std::vector<std::byte> makeGlb(std::string json, const std::vector<std::byte>& binary) {
+        while (json.size() % 4 != 0) {
+            json.push_back(' ');
+        }
+
+        std::vector<std::byte> glb;
+        auto put = [&](std::uint32_t value) {
+            for (int i = 0; i < 4; i++) {
+                glb.push_back(static_cast<std::byte>(value >> (i * 8)));
+            }
+        };
+
+        put(0x46546C67);
+        put(2);
+        put(static_cast<std::uint32_t>(12 + 8 + json.size() + 8 + binary.size()));
+        put(static_cast<std::uint32_t>(json.size()));
+        put(0x4E4F534A);
+        for (char c : json) {
+            glb.push_back(static_cast<std::byte>(c));
+        }
+
+        put(static_cast<std::uint32_t>(binary.size()));
+        put(0x004E4942);
+        glb.insert(glb.end(), binary.begin(), binary.end());
+        return glb;
+    }
+
+    /// @brief Append values to a binary chunk
+    /// @param binary The chunk
+    /// @param values The values
+    template <typename T>
+    static void append(std::vector<std::byte>& binary, const std::vector<T>& values) {
+        size_t offset = binary.size();
+        binary.resize(offset + values.size() * sizeof(T));
+        memcpy(binary.data() + offset, values.data(), values.size() * sizeof(T));
+    }
+
+    lov::System::ThreadPool m_pool{ 3 };  ///< Parses models
+};
+
+/// @brief Test that corners are welded into shared vertices and polygons are triangulated as fans
+TEST_F(MeshLoaderFixture, ObjWeldsAndTriangulates) {
+    lov::Graphics::MeshLoader loader(m_pool);
+    lov::Graphics::MeshData mesh = loader.loadObj(bytesOf(
+        "# A unit quad\r\n"
+        "o quad\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 +0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 0 1\n"
+        "usemtl none\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        "f 1/1/1 3/3/1 -1/-1/-1\n"));
+
+    ASSERT_EQ(mesh.vertices.size(), 4u);
+    ASSERT_EQ(mesh.indices.size(), 9u);
+
+    std::vector<lov::lov_uint> expected = { 0, 1, 2, 0, 2, 3, 0, 2, 3 };
+    ASSERT_EQ(mesh.indices, expected);
+    ASSERT_EQ(mesh.vertices[2].position, lov::Vector3f(1.0f, 1.0f, 0.0f));
+    ASSERT_EQ(mesh.vertices[2].texCoords, lov::Vector2f(1.0f, 1.0f));
+    ASSERT_EQ(mesh.vertices[2].normal, lov::Vector3f(0.0f, 0.0f, 1.0f));
+}
+
+/// @brief Test that normals are calculated for faces without them, shared across texture seams
+TEST_F(MeshLoaderFixture, ObjCalculatesNormals) {
+    lov::Graphics::MeshLoader loader(m_pool);
+    lov::Graphics::MeshData mesh = loader.loadObj(bytesOf(
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n"
+        "vt 0 0\nvt 1 1\n"
+        "f 1/1 2/1 3/1\n"
+        "f 1/2 3/2 4/2\n"));
+
+    // The second triangle has its own texture coordinates, so the shared positions are split into separate vertices
+    ASSERT_EQ(mesh.vertices.size(), 6u);
+    float diagonal = std::sqrt(0.5f);
+    ASSERT_NEAR(mesh.vertices[1].normal.z, 1.0f, 1e-6f);
+    for (lov::lov_uint vertex : { 0u, 2u, 3u, 4u }) {
+        ASSERT_NEAR(mesh.vertices[vertex].normal.x, diagonal, 1e-6f);
+        ASSERT_NEAR(mesh.vertices[vertex].normal.y, 0.0f, 1e-6f);
+        ASSERT_NEAR(mesh.vertices[vertex].normal.z, diagonal, 1e-6f);
+    }
+
+    ASSERT_NEAR(mesh.vertices[5].normal.x, 1.0f, 1e-6f);
+}
+
+/// @brief Test that a model split across many chunks, with negative indices reaching into earlier chunks, matches one parsed whole
+TEST_F(MeshLoaderFixture, ObjParsesInChunks) {
+    // A grid of quads large enough to span many chunks, half using relative indices
+    const int size = 200;
+    std::string text;
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            text += "v " + std::to_string(x * 0.5f) + " " + std::to_string(y * 0.25f) + " 1.5e-1\n";
+        }
+    }
+
+    text += "vn 0 0 1\n";
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int a = y * (size + 1) + x + 1;
+            int b = a + 1;
+            int c = a + size + 2;
+            int d = a + size + 1;
+            if ((x + y) % 2 == 0) {
+                text += "f " + std::to_string(a) + "//1 " + std::to_string(b) + "//1 " + std::to_string(c) + "//1 " + std::to_string(d) + "//1\n";
+            }
+            else {
+                int count = (size + 1) * (size + 1);
+                text += "f " + std::to_string(a - count - 1) + "//-1 " + std::to_string(b - count - 1) + "//-1 " +
+                    std::to_string(c - count - 1) + "//-1 " + std::to_string(d - count - 1) + "//-1\n";
+            }
+        }
+    }
+
+    ASSERT_GT(text.size(), 1u << 20);
+
+    lov::Graphics::MeshLoader loader(m_pool);
+    lov::Graphics::MeshData mesh = loader.loadObj(bytesOf(text));
+
+    ASSERT_EQ(mesh.vertices.size(), static_cast<size_t>((size + 1) * (size + 1)));
+    ASSERT_EQ(mesh.indices.size(), static_cast<size_t>(size * size * 6));
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            size_t quad = (y * size + x) * 6;
+            const lov::Vector3f& first = mesh.vertices[mesh.indices[quad]].position;
+            const lov::Vector3f& third = mesh.vertices[mesh.indices[quad + 2]].position;
+            ASSERT_EQ(first, lov::Vector3f(x * 0.5f, y * 0.25f, 0.15f));
+            ASSERT_EQ(third, lov::Vector3f((x + 1) * 0.5f, (y + 1) * 0.25f, 0.15f));
+        }
+    }
+}
+
+/// @brief Test that malformed statements name their line and bad indices throw
+TEST_F(MeshLoaderFixture, ObjRejectsMalformed) {
+    lov::Graphics::MeshLoader loader(m_pool);
+
+    try {
+        loader.loadObj(bytesOf("v 0 0 0\nv 1 0 0\nv 0 x 0\n"));
+        FAIL() << "Expected a MeshException";
+    }
+    catch (const lov::Exceptions::MeshException& e) {
+        ASSERT_NE(std::string(e.what()).find("line 3"), std::string::npos);
+    }
+
+    ASSERT_THROW(loader.loadObj(bytesOf("v 0 0 0\nv 1 0 0\nf 1 2\n")), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadObj(bytesOf("v 0 0 0\nv 1 0 0\nf 1 2 3\n")), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadObj(bytesOf("v 0 0 0\nv 1 0 0\nf 0 1 2\n")), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadObj(bytesOf("v 0 0 0\nv 1 0 0\nf -1 -2 -3\n")), lov::Exceptions::MeshException);
+}
+
+/// @brief Test that glTF primitives are placed by their nodes, with texture coordinates flipped and normals calculated
+TEST_F(MeshLoaderFixture, GlbPlacesPrimitives) {
+    std::vector<std::byte> binary;
+    append(binary, std::vector<float>{ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+    append(binary, std::vector<float>{ 0, 0, 1, 0, 0, 1 });
+    append(binary, std::vector<std::uint16_t>{ 0, 1, 2, 0 });
+
+    std::string json = R"({
+        "asset": { "version": "2.0" },
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0 ] } ],
+        "nodes": [
+            { "translation": [ 10, 0, 0 ], "children": [ 1 ] },
+            { "mesh": 0, "scale": [ 1, 1, -1 ] }
+        ],
+        "meshes": [ { "name": "trié", "primitives": [ { "attributes": { "POSITION": 0, "TEXCOORD_0": 1 }, "indices": 2 } ] } ],
+        "accessors": [
+            { "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3" },
+            { "bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC2" },
+            { "bufferView": 2, "componentType": 5123, "count": 3, "type": "SCALAR" }
+        ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": 36 },
+            { "buffer": 0, "byteOffset": 36, "byteLength": 24 },
+            { "buffer": 0, "byteOffset": 60, "byteLength": 8 }
+        ],
+        "buffers": [ { "byteLength": 68 } ]
+    })";
+
+    lov::Graphics::MeshLoader loader(m_pool);
+    lov::Graphics::MeshData mesh = loader.loadGlb(makeGlb(json, binary));
+
+    ASSERT_EQ(mesh.vertices.size(), 3u);
+    ASSERT_EQ(mesh.vertices[1].position, lov::Vector3f(11.0f, 0.0f, 0.0f));
+    ASSERT_EQ(mesh.vertices[1].texCoords, lov::Vector2f(1.0f, 1.0f));
+    ASSERT_EQ(mesh.vertices[2].texCoords, lov::Vector2f(0.0f, 0.0f));
+
+    // The negative scale mirrors the triangle to face -z, so its winding is reversed to match
+    std::vector<lov::lov_uint> expected = { 0, 2, 1 };
+    ASSERT_EQ(mesh.indices, expected);
+    ASSERT_NEAR(mesh.vertices[0].normal.z, -1.0f, 1e-6f);
+}
+
+/// @brief Test that malformed or unsupported glTF files throw instead of reading out of bounds
+TEST_F(MeshLoaderFixture, GlbRejectsMalformed) {
+    lov::Graphics::MeshLoader loader(m_pool);
+    std::vector<std::byte> binary(36);
+
+    std::string outside = R"({ "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 } } ] } ],
+        "accessors": [ { "bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3" } ],
+        "bufferViews": [ { "buffer": 0, "byteLength": 36 } ] })";
+    std::string badIndex = R"({ "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 }, "indices": 0 } ] } ],
+        "accessors": [ { "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3" } ],
+        "bufferViews": [ { "buffer": 0, "byteLength": 36 } ] })";
+    std::string strips = R"({ "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 }, "mode": 5 } ] } ] })";
+    std::string cycle = R"({ "scenes": [ { "nodes": [ 0 ] } ], "nodes": [ { "children": [ 0 ] } ] })";
+
+    ASSERT_THROW(loader.loadGlb(makeGlb(outside, binary)), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadGlb(makeGlb(badIndex, binary)), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadGlb(makeGlb(strips, binary)), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadGlb(makeGlb(cycle, binary)), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadGlb(makeGlb("{ \"meshes\": [ ", binary)), lov::Exceptions::MeshException);
+    ASSERT_THROW(loader.loadGlb(bytesOf("glTF")), lov::Exceptions::MeshException);
+}
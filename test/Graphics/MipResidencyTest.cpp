@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Graphics/MipResidency.h"
+
+/// @brief Fixture used for MipResidency tests, with textures of a 128x128 RGBA chain whose tail starts at level 3
+class MipResidencyFixture : public ::testing::Test {
+protected:
+    /// @brief Add a texture and upload its tail, coarsest level first like TextureStreamer
+    /// @param residency The residency to add to
+    /// @return The index of the texture
+    lov::lov_uint addTexture(lov::Graphics::MipResidency& residency) const {
+        lov::lov_uint texture = residency.add();
+        residency.setLevels(texture, levelSizes, tailLevel);
+        for (lov::lov_int level = static_cast<lov::lov_int>(levelSizes.size()) - 1; level >= tailLevel; level--) {
+            residency.levelUploaded(texture, level, true);
+        }
+
+        residency.loadFinished(texture);
+        return texture;
+    }
+
+    /// @brief Upload every load of a plan, coarsest level first
+    /// @param residency The residency that made the plan
+    /// @param plan The plan
+    static void uploadLoads(lov::Graphics::MipResidency& residency, const lov::Graphics::MipPlan& plan) {
+        for (const lov::Graphics::MipLoad& load : plan.loads) {
+            for (lov::lov_int level = load.lastLevel; level >= load.firstLevel; level--) {
+                residency.levelUploaded(load.texture, level, false);
+            }
+
+            residency.loadFinished(load.texture);
+        }
+    }
+
+    const std::vector<size_t> levelSizes = { 65536, 16384, 4096, 1024, 256, 64, 16, 4 };   ///< Bytes of each level
+    const lov::lov_int tailLevel = 3;                                                       ///< Finest level of the tail
+    const size_t tailBytes = 1024 + 256 + 64 + 16 + 4;                                      ///< Bytes of the tail
+    const size_t fullBytes = 65536 + 16384 + 4096 + tailBytes;                              ///< Bytes of the whole chain
+};
+
+/// @brief Test that a request reads every missing level above the tail and counts them as pending until uploaded
+TEST_F(MipResidencyFixture, LoadsRequestedLevels) {
+    lov::Graphics::MipResidency residency(1024 * 1024);
+    lov::lov_uint texture = addTexture(residency);
+    ASSERT_EQ(residency.getResidentLevel(texture), tailLevel);
+    ASSERT_EQ(residency.getResidentBytes(), tailBytes);
+
+    residency.request(texture, 2);
+    residency.request(texture, 0);
+    lov::Graphics::MipPlan plan = residency.update();
+
+    ASSERT_TRUE(plan.evictions.empty());
+    ASSERT_EQ(plan.loads.size(), 1u);
+    ASSERT_EQ(plan.loads[0].texture, texture);
+    ASSERT_EQ(plan.loads[0].firstLevel, 0);
+    ASSERT_EQ(plan.loads[0].lastLevel, tailLevel - 1);
+    ASSERT_EQ(residency.getPendingBytes(), fullBytes - tailBytes);
+    ASSERT_EQ(residency.getWantedBytes(), fullBytes);
+    ASSERT_TRUE(residency.isLoading(texture));
+
+    // A texture that's loading isn't read again
+    residency.request(texture, 0);
+    ASSERT_TRUE(residency.update().loads.empty());
+
+    uploadLoads(residency, plan);
+    ASSERT_EQ(residency.getResidentLevel(texture), 0);
+    ASSERT_EQ(residency.getResidentBytes(), fullBytes);
+    ASSERT_EQ(residency.getPendingBytes(), 0u);
+    ASSERT_EQ(residency.getLoadingCount(), 0);
+}
+
+/// @brief Test that over budget, only unwanted levels are freed, finest first from the least recently wanted texture
+TEST_F(MipResidencyFixture, EvictsLeastRecentlyWanted) {
+    lov::Graphics::MipResidency residency(1024 * 1024);
+    lov::lov_uint first = addTexture(residency);
+    lov::lov_uint second = addTexture(residency);
+
+    residency.request(first, 0);
+    residency.request(second, 0);
+    uploadLoads(residency, residency.update());
+    ASSERT_EQ(residency.getResidentBytes(), 2 * fullBytes);
+
+    // Only the second is still wanted, so the first loses levels until both fit
+    residency.setBudget(100000);
+    residency.request(second, 0);
+    lov::Graphics::MipPlan plan = residency.update();
+
+    ASSERT_TRUE(plan.loads.empty());
+    ASSERT_EQ(plan.evictions.size(), 2u);
+    ASSERT_EQ(plan.evictions[0].texture, first);
+    ASSERT_EQ(plan.evictions[0].level, 0);
+    ASSERT_EQ(plan.evictions[1].texture, first);
+    ASSERT_EQ(plan.evictions[1].level, 1);
+    ASSERT_EQ(residency.getResidentLevel(first), 2);
+    ASSERT_EQ(residency.getResidentLevel(second), 0);
+    ASSERT_EQ(residency.getResidentBytes(), 2 * fullBytes - 65536 - 16384);
+
+    // Nothing is wanted any more, so the first, wanted less recently, goes down to its tail before the second loses anything
+    residency.update();
+    residency.setBudget(10000);
+    plan = residency.update();
+
+    ASSERT_EQ(plan.evictions.size(), 3u);
+    ASSERT_EQ(plan.evictions[0].texture, first);
+    ASSERT_EQ(plan.evictions[0].level, 2);
+    ASSERT_EQ(plan.evictions[1].texture, second);
+    ASSERT_EQ(plan.evictions[1].level, 0);
+    ASSERT_EQ(plan.evictions[2].texture, second);
+    ASSERT_EQ(plan.evictions[2].level, 1);
+    ASSERT_EQ(residency.getResidentLevel(first), tailLevel);
+    ASSERT_EQ(residency.getResidentLevel(second), 2);
+    ASSERT_LE(residency.getResidentBytes(), 10000u);
+}
+
+/// @brief Test that the base level never moves past the tail, however small the budget or coarse the request
+TEST_F(MipResidencyFixture, ClampsToTail) {
+    lov::Graphics::MipResidency residency(1024 * 1024);
+    lov::lov_uint texture = addTexture(residency);
+
+    residency.request(texture, 0);
+    uploadLoads(residency, residency.update());
+
+    residency.setBudget(0);
+    residency.request(texture, 7);
+    lov::Graphics::MipPlan plan = residency.update();
+    ASSERT_EQ(residency.getWantedLevel(texture), tailLevel);
+
+    // Each level freed moves the base level to the next, stopping at the tail even though it's over budget
+    ASSERT_EQ(plan.evictions.size(), static_cast<size_t>(tailLevel));
+    for (size_t i = 0; i < plan.evictions.size(); i++) {
+        ASSERT_EQ(plan.evictions[i].level, static_cast<lov::lov_int>(i));
+    }
+
+    ASSERT_EQ(residency.getResidentLevel(texture), tailLevel);
+    ASSERT_EQ(residency.getResidentBytes(), tailBytes);
+    ASSERT_TRUE(residency.update().evictions.empty());
+
+    // Nothing more fits, so asking for detail again reads nothing
+    residency.request(texture, 0);
+    ASSERT_TRUE(residency.update().loads.empty());
+}
+
+/// @brief Test that an evicted level is read again once it's wanted, settling for coarser levels while they don't all fit
+TEST_F(MipResidencyFixture, ReloadsEvictedLevels) {
+    lov::Graphics::MipResidency residency(1024 * 1024);
+    lov::lov_uint texture = addTexture(residency);
+
+    residency.request(texture, 0);
+    uploadLoads(residency, residency.update());
+
+    residency.setBudget(tailBytes);
+    ASSERT_EQ(residency.update().evictions.size(), static_cast<size_t>(tailLevel));
+
+    // Only levels 1 and 2 fit back in
+    residency.setBudget(tailBytes + 16384 + 4096);
+    residency.request(texture, 0);
+    lov::Graphics::MipPlan plan = residency.update();
+
+    ASSERT_EQ(plan.loads.size(), 1u);
+    ASSERT_EQ(plan.loads[0].firstLevel, 1);
+    ASSERT_EQ(plan.loads[0].lastLevel, 2);
+    uploadLoads(residency, plan);
+    ASSERT_EQ(residency.getResidentLevel(texture), 1);
+
+    residency.setBudget(1024 * 1024);
+    residency.request(texture, 0);
+    plan = residency.update();
+
+    ASSERT_EQ(plan.loads.size(), 1u);
+    ASSERT_EQ(plan.loads[0].firstLevel, 0);
+    ASSERT_EQ(plan.loads[0].lastLevel, 0);
+    uploadLoads(residency, plan);
+    ASSERT_EQ(residency.getResidentLevel(texture), 0);
+    ASSERT_EQ(residency.getResidentBytes(), fullBytes);
+}
+
+/// @brief Test that a failed read gives back the bytes it had reserved
+TEST_F(MipResidencyFixture, ForgetsFailedLoads) {
+    lov::Graphics::MipResidency residency(1024 * 1024);
+    lov::lov_uint texture = addTexture(residency);
+
+    residency.request(texture, 0);
+    lov::Graphics::MipPlan plan = residency.update();
+    ASSERT_EQ(plan.loads.size(), 1u);
+
+    residency.loadFailed(texture, plan.loads[0].firstLevel, false);
+    ASSERT_EQ(residency.getPendingBytes(), 0u);
+    ASSERT_FALSE(residency.isLoading(texture));
+    ASSERT_EQ(residency.getResidentLevel(texture), tailLevel);
+}
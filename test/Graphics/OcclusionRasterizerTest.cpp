@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/DepthPyramid.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/OcclusionRasterizer.h"
+#include "Graphics/Transform.h"
+#include "System/ThreadPool.h"
+#include "System/Utility.h"
+
+/// @brief Fixture used for OcclusionRasterizer tests
+class OcclusionRasterizerFixture : public ::testing::Test {
+protected:
+    static constexpr lov::lov_size WIDTH = 150;  ///< Width of the depth buffer, not a multiple of the tile size
+    static constexpr lov::lov_size HEIGHT = 70;  ///< Height of the depth buffer
+
+    /// @brief Build a camera above the origin looking down -z and a few occluders in front of it
+    OcclusionRasterizerFixture():
+        pool(3)
+    {
+        lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(lov::Util::toRadians(60.0f), 2.0f, 0.1f, 100.0f);
+        lov::Graphics::Transform view = lov::Graphics::Transform::lookAt({ 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, -1.0f }, { 0.0f, 1.0f, 0.0f });
+        viewProjection = projection * view;
+
+        // A unit cube with the corners indexed by their bits
+        for (int i = 0; i < 8; i++) {
+            cube.vertices.push_back({ { (i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f }, {}, {} });
+        }
+        cube.indices = {
+            0, 2, 1, 1, 2, 3,   4, 5, 6, 5, 7, 6,
+            0, 1, 4, 1, 5, 4,   2, 6, 3, 3, 6, 7,
+            0, 4, 2, 2, 4, 6,   1, 3, 5, 3, 7, 5
+        };
+
+        // A wide wall, a rotated pillar and a slab that crosses the near plane and must be skipped
+        occluders.push_back(lov::Graphics::Transform().translate({ -4.0f, 0.0f, -12.0f }).scale({ 10.0f, 4.0f, 0.5f }));
+        occluders.push_back(lov::Graphics::Transform().translate({ 3.0f, 0.0f, -8.0f }).rotate({ 0.0f, 1.0f, 0.0f }, 0.6f).scale({ 2.0f, 6.0f, 2.0f }));
+        occluders.push_back(lov::Graphics::Transform().translate({ 0.0f, -1.0f, -1.0f }).scale({ 1.0f, 0.2f, 4.0f }));
+    }
+
+    /// @brief Rasterize the occluders the slow way, one pixel at a time over the whole screen
+    /// @return The reference depth buffer
+    std::vector<float> referenceDepth() const {
+        std::vector<float> depth(WIDTH * HEIGHT, 1.0f);
+
+        for (const lov::Graphics::Transform& model : occluders) {
+            lov::Graphics::Transform modelViewProjection = viewProjection * model;
+
+            for (size_t t = 0; t < cube.indices.size(); t += 3) {
+                float x[3], y[3], z[3];
+                bool skip = false;
+                for (int i = 0; i < 3; i++) {
+                    const lov::Vector3f& p = cube.vertices[cube.indices[t + i]].position;
+                    lov::Vector4f clip = modelViewProjection * lov::Vector4f(p.x, p.y, p.z, 1.0f);
+                    skip = skip || clip.w <= 0.0f || clip.z < -clip.w;
+                    x[i] = (clip.x / clip.w * 0.5f + 0.5f) * WIDTH;
+                    y[i] = (clip.y / clip.w * 0.5f + 0.5f) * HEIGHT;
+                    z[i] = clip.z / clip.w * 0.5f + 0.5f;
+                }
+
+                float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+                if (skip || area == 0.0f) {
+                    continue;
+                }
+
+                float a[3], b[3], c[3];
+                for (int i = 0; i < 3; i++) {
+                    int j = (i + 1) % 3;
+                    a[i] = y[i] - y[j];
+                    b[i] = x[j] - x[i];
+                    c[i] = x[i] * y[j] - y[i] * x[j];
+                }
+                float depthA = (a[1] * z[0] + a[2] * z[1] + a[0] * z[2]) / area;
+                float depthB = (b[1] * z[0] + b[2] * z[1] + b[0] * z[2]) / area;
+                float depthC = (c[1] * z[0] + c[2] * z[1] + c[0] * z[2]) / area;
+                float sign = area < 0.0f ? -1.0f : 1.0f;
+
+                for (lov::lov_size py = 0; py < HEIGHT; py++) {
+                    for (lov::lov_size px = 0; px < WIDTH; px++) {
+                        float cx = px + 0.5f;
+                        float cy = py + 0.5f;
+                        bool inside = true;
+                        for (int i = 0; i < 3; i++) {
+                            inside = inside && (sign * a[i]) * cx + ((sign * b[i]) * cy + sign * c[i]) >= 0.0f;
+                        }
+
+                        float d = depthA * cx + (depthB * cy + depthC);
+                        if (inside && d < depth[py * WIDTH + px]) {
+                            depth[py * WIDTH + px] = d;
+                        }
+                    }
+                }
+            }
+        }
+
+        return depth;
+    }
+
+    /// @brief Decide whether a box is visible by testing every pixel it touches
+    /// @param depth The reference depth buffer
+    /// @param box The world space box
+    /// @return Whether any touched pixel is at or behind the box's nearest depth
+    bool referenceVisible(const std::vector<float>& depth, const lov::Graphics::BoundingBox& box) const {
+        float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, nearest = 1.0f;
+        for (int i = 0; i < 8; i++) {
+            lov::Vector4f clip = viewProjection * lov::Vector4f((i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 4) ? box.max.z : box.min.z, 1.0f);
+            if (clip.w <= 0.0f || clip.z < -clip.w) {
+                return true;
+            }
+
+            float x = (clip.x / clip.w * 0.5f + 0.5f) * WIDTH;
+            float y = (clip.y / clip.w * 0.5f + 0.5f) * HEIGHT;
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            nearest = std::min(nearest, clip.z / clip.w * 0.5f + 0.5f);
+        }
+
+        if (maxX < 0.0f || maxY < 0.0f || minX >= WIDTH || minY >= HEIGHT) {
+            return true;
+        }
+
+        int x0 = std::max(static_cast<int>(floorf(minX)), 0);
+        int y0 = std::max(static_cast<int>(floorf(minY)), 0);
+        int x1 = std::min(static_cast<int>(floorf(maxX)), static_cast<int>(WIDTH) - 1);
+        int y1 = std::min(static_cast<int>(floorf(maxY)), static_cast<int>(HEIGHT) - 1);
+
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                if (nearest <= depth[y * WIDTH + x]) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    lov::System::ThreadPool pool;                       ///< Workers shared by the tests
+    lov::Graphics::Transform viewProjection;            ///< The camera's view projection
+    lov::Graphics::MeshData cube;                       ///< The occluder mesh
+    std::vector<lov::Graphics::Transform> occluders;    ///< Model transforms of the occluders
+};
+
+/// @brief Test that the tiled, threaded rasterizer writes exactly the same depths as the per pixel reference
+TEST_F(OcclusionRasterizerFixture, MatchesReferenceDepth) {
+    lov::Graphics::OcclusionRasterizer rasterizer(WIDTH, HEIGHT, &pool);
+    rasterizer.beginFrame(viewProjection);
+    for (const lov::Graphics::Transform& model : occluders) {
+        rasterizer.addOccluder(cube, model);
+    }
+    rasterizer.rasterize();
+
+    std::vector<float> expected = referenceDepth();
+    const std::vector<float>& depth = rasterizer.getDepthBuffer();
+
+    ASSERT_EQ(depth.size(), expected.size());
+    for (size_t i = 0; i < depth.size(); i++) {
+        ASSERT_EQ(depth[i], expected[i]) << "pixel " << i % WIDTH << ", " << i / WIDTH;
+    }
+
+    // Both visible occluders drew something
+    ASSERT_GT(std::count_if(depth.begin(), depth.end(), [](float d) { return d < 1.0f; }), 0);
+}
+
+/// @brief Test that the hierarchical test agrees with testing every pixel on a random depth buffer
+TEST_F(OcclusionRasterizerFixture, HierarchyMatchesBruteForce) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<float> depth(37 * 23);
+    for (float& d : depth) {
+        d = 0.3f + 0.4f * unit(random);
+    }
+
+    lov::Graphics::DepthPyramid pyramid;
+    pyramid.build(depth.data(), 37, 23);
+    ASSERT_FLOAT_EQ(pyramid.getMinDepth(pyramid.getLevelCount() - 1, 0, 0), *std::min_element(depth.begin(), depth.end()));
+
+    for (int i = 0; i < 2000; i++) {
+        int x0 = random() % 37, x1 = random() % 37, y0 = random() % 23, y1 = random() % 23;
+        if (x0 > x1) std::swap(x0, x1);
+        if (y0 > y1) std::swap(y0, y1);
+        float nearest = 0.3f + 0.45f * unit(random);
+
+        bool expected = true;
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                expected = expected && nearest > depth[y * 37 + x];
+            }
+        }
+
+        ASSERT_EQ(pyramid.isOccludedExact(x0, y0, x1, y1, nearest), expected);
+    }
+}
+
+/// @brief Test that culling boxes scattered through the scene makes the same decisions as the brute force reference
+TEST_F(OcclusionRasterizerFixture, CullMatchesReference) {
+    lov::Graphics::OcclusionRasterizer rasterizer(WIDTH, HEIGHT, &pool);
+    rasterizer.beginFrame(viewProjection);
+    for (const lov::Graphics::Transform& model : occluders) {
+        rasterizer.addOccluder(cube, model);
+    }
+    rasterizer.rasterize();
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> distance(-30.0f, 2.0f);
+    std::uniform_real_distribution<float> size(0.1f, 1.5f);
+
+    std::vector<lov::Graphics::BoundingBox> boxes;
+    for (int i = 0; i < 3000; i++) {
+        lov::Vector3f center(position(random), position(random) * 0.3f, distance(random));
+        lov::Vector3f extents(size(random), size(random), size(random));
+        boxes.emplace_back(center - extents, center + extents);
+    }
+
+    std::vector<float> depth = referenceDepth();
+    std::vector<lov::lov_uint> expected;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        if (referenceVisible(depth, boxes[i])) {
+            expected.push_back(static_cast<lov::lov_uint>(i));
+        }
+    }
+
+    std::vector<lov::lov_uint> visible;
+    rasterizer.cull(boxes, visible);
+
+    ASSERT_EQ(visible, expected);
+    ASSERT_LT(visible.size(), boxes.size());
+
+    // A box right behind the middle of the wall is hidden, and the same box in front of it is not
+    ASSERT_FALSE(rasterizer.isVisible({ { -4.5f, -0.5f, -20.0f }, { -3.5f, 0.5f, -19.0f } }));
+    ASSERT_TRUE(rasterizer.isVisible({ { -4.5f, -0.5f, -11.0f }, { -3.5f, 0.5f, -10.0f } }));
+}
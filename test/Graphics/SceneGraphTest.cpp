@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Graphics/SceneGraph.h"
+#include "System/JobSystem.h"
+
+/// @brief Fixture used for SceneGraph tests
+class SceneGraphFixture : public ::testing::Test {
+protected:
+    /// @brief Make a transform that only translates
+    /// @param x The x component
+    /// @param y The y component
+    /// @param z The z component
+    /// @return The transform
+    lov::Graphics::NodeTransform at(float x, float y, float z) {
+        lov::Graphics::NodeTransform local;
+        local.position = lov::Vector3f(x, y, z);
+        return local;
+    }
+
+    /// @brief Get where a node's world transform puts its origin
+    /// @param node The node
+    /// @return The origin in world space
+    lov::Vector3f originOf(lov::lov_uint node) {
+        const lov::Graphics::Transform& world = m_scene.getWorld(node);
+        return lov::Vector3f(world.w.x, world.w.y, world.w.z);
+    }
+
+    lov::Graphics::SceneGraph m_scene;  ///< The graph under test
+};
+
+/// @brief Test that world transforms compose each node's local transform with its parent's
+TEST_F(SceneGraphFixture, ComposesWithParents) {
+    // Add a child before giving its parent a sibling, so the arrays have to be sorted by depth
+    lov::lov_uint root = m_scene.add(at(1.0f, 0.0f, 0.0f));
+    lov::lov_uint child = m_scene.add(at(0.0f, 2.0f, 0.0f), root);
+    lov::lov_uint otherRoot = m_scene.add(at(5.0f, 0.0f, 0.0f));
+
+    lov::Graphics::NodeTransform scaled = at(0.0f, 0.0f, 3.0f);
+    scaled.scale = lov::Vector3f(2.0f, 2.0f, 2.0f);
+    lov::lov_uint grandchild = m_scene.add(scaled, child);
+    lov::lov_uint greatGrandchild = m_scene.add(at(1.0f, 0.0f, 0.0f), grandchild);
+
+    m_scene.update();
+
+    ASSERT_EQ(originOf(root), lov::Vector3f(1.0f, 0.0f, 0.0f));
+    ASSERT_EQ(originOf(child), lov::Vector3f(1.0f, 2.0f, 0.0f));
+    ASSERT_EQ(originOf(otherRoot), lov::Vector3f(5.0f, 0.0f, 0.0f));
+    ASSERT_EQ(originOf(grandchild), lov::Vector3f(1.0f, 2.0f, 3.0f));
+    ASSERT_EQ(originOf(greatGrandchild), lov::Vector3f(3.0f, 2.0f, 3.0f));
+    ASSERT_EQ(m_scene.getParent(grandchild), child);
+    ASSERT_EQ(m_scene.getParent(root), lov::Graphics::SceneGraph::None);
+
+    lov::Graphics::SceneGraphStats stats = m_scene.getStats();
+    ASSERT_EQ(stats.nodes, 5u);
+    ASSERT_EQ(stats.levels, 4u);
+    ASSERT_EQ(stats.updated, 5u);
+}
+
+/// @brief Test that only changed nodes and their descendants are recomputed, and nothing once static
+TEST_F(SceneGraphFixture, UpdatesOnlyChangedSubtrees) {
+    lov::lov_uint left = m_scene.add(at(-1.0f, 0.0f, 0.0f));
+    lov::lov_uint right = m_scene.add(at(1.0f, 0.0f, 0.0f));
+    lov::lov_uint leftChild = m_scene.add(at(0.0f, 1.0f, 0.0f), left);
+    m_scene.add(at(0.0f, 1.0f, 0.0f), right);
+    m_scene.add(at(0.0f, 1.0f, 0.0f), leftChild);
+
+    m_scene.update();
+    ASSERT_EQ(m_scene.getStats().updated, 5u);
+
+    m_scene.update();
+    ASSERT_EQ(m_scene.getStats().updated, 0u);
+
+    // Moving the left root moves its two descendants with it, and nothing on the right
+    m_scene.setLocal(left, at(-2.0f, 0.0f, 0.0f));
+    m_scene.update();
+    ASSERT_EQ(m_scene.getStats().updated, 3u);
+    ASSERT_EQ(originOf(leftChild), lov::Vector3f(-2.0f, 1.0f, 0.0f));
+    ASSERT_EQ(originOf(right), lov::Vector3f(1.0f, 0.0f, 0.0f));
+
+    // A leaf changing alone doesn't touch its parent
+    m_scene.setLocal(leftChild, at(0.0f, 4.0f, 0.0f));
+    m_scene.update();
+    ASSERT_EQ(m_scene.getStats().updated, 2u);
+    ASSERT_EQ(originOf(leftChild), lov::Vector3f(-2.0f, 4.0f, 0.0f));
+}
+
+/// @brief Test that removing a node removes its subtree, leaving other IDs valid and freeing its own for reuse
+TEST_F(SceneGraphFixture, RemovesSubtrees) {
+    lov::lov_uint root = m_scene.add(at(1.0f, 0.0f, 0.0f));
+    lov::lov_uint doomed = m_scene.add(at(0.0f, 1.0f, 0.0f), root);
+    lov::lov_uint doomedChild = m_scene.add(at(0.0f, 1.0f, 0.0f), doomed);
+    lov::lov_uint survivor = m_scene.add(at(0.0f, 0.0f, 1.0f), root);
+    m_scene.update();
+
+    m_scene.remove(doomed);
+    lov::lov_uint reused = m_scene.add(at(0.0f, 0.0f, 2.0f), survivor);
+    ASSERT_TRUE(reused == doomed || reused == doomedChild);
+
+    m_scene.update();
+    ASSERT_EQ(m_scene.getStats().nodes, 3u);
+    ASSERT_EQ(m_scene.getStats().updated, 1u);
+    ASSERT_EQ(originOf(survivor), lov::Vector3f(1.0f, 0.0f, 1.0f));
+    ASSERT_EQ(originOf(reused), lov::Vector3f(1.0f, 0.0f, 3.0f));
+}
+
+/// @brief Test that splitting levels across a job system gives the same transforms
+TEST_F(SceneGraphFixture, UpdatesLevelsInParallel) {
+    lov::System::JobSystem jobs(3);
+
+    std::vector<lov::lov_uint> roots;
+    std::vector<lov::lov_uint> children;
+    for (int i = 0; i < 3000; i++) {
+        roots.push_back(m_scene.add(at(static_cast<float>(i), 0.0f, 0.0f)));
+        children.push_back(m_scene.add(at(0.0f, static_cast<float>(i), 0.0f), roots.back()));
+    }
+
+    m_scene.update(&jobs);
+    ASSERT_EQ(m_scene.getStats().updated, 6000u);
+
+    for (int i = 0; i < 3000; i += 2) {
+        m_scene.setLocal(roots[i], at(static_cast<float>(i), 0.0f, 1.0f));
+    }
+
+    m_scene.update(&jobs);
+    ASSERT_EQ(m_scene.getStats().updated, 3000u);
+
+    for (int i = 0; i < 3000; i++) {
+        float z = i % 2 == 0 ? 1.0f : 0.0f;
+        ASSERT_EQ(originOf(children[i]), lov::Vector3f(static_cast<float>(i), static_cast<float>(i), z));
+    }
+}
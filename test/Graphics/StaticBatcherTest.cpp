@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "Graphics/Material.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/StaticBatcher.h"
+#include "Graphics/Transform.h"
+
+/// @brief Fixture used for StaticBatcher tests
+class StaticBatcherFixture : public ::testing::Test {
+protected:
+    /// @brief Construct a single triangle facing +z
+    StaticBatcherFixture() {
+        float data[] = {
+            0.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 0.0f,
+            1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f,
+            0.0f, 1.0f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 1.0f
+        };
+
+        triangle = lov::Graphics::MeshData::fromInterleaved(data, 3);
+        materialA = { 1, 0, 1, 32.0f };
+        materialB = { 2, 0, 1, 32.0f };
+        materialC = { 1, 2, 3, 8.0f };
+    }
+
+    lov::Graphics::MeshData triangle;   ///< A single triangle
+    lov::Graphics::Material materialA;  ///< First test material
+    lov::Graphics::Material materialB;  ///< Material in a different texture array
+    lov::Graphics::Material materialC;  ///< Material in the same texture array as materialA, with other layers
+};
+
+/// @brief Test that objects are grouped into one batch per texture array
+TEST_F(StaticBatcherFixture, GroupsByMaterial) {
+    lov::Graphics::StaticBatcher batcher;
+    batcher.add(triangle, materialA, lov::Graphics::Transform());
+    batcher.add(triangle, materialB, lov::Graphics::Transform());
+    batcher.add(triangle, materialA, lov::Graphics::Transform());
+
+    std::vector<lov::Graphics::StaticBatchData> batches = batcher.bake();
+
+    ASSERT_EQ(batches.size(), 2);
+    ASSERT_EQ(batches[0].textureArrayID, materialA.textureArrayID);
+    ASSERT_EQ(batches[0].ranges.size(), 2);
+    ASSERT_EQ(batches[0].vertices.size(), 6);
+    ASSERT_EQ(batches[1].ranges.size(), 1);
+}
+
+/// @brief Test that materials sharing a texture array share a batch, with their layers baked per vertex
+TEST_F(StaticBatcherFixture, MergesMaterialsInOneArray) {
+    lov::Graphics::StaticBatcher batcher;
+    batcher.add(triangle, materialA, lov::Graphics::Transform());
+    batcher.add(triangle, materialC, lov::Graphics::Transform());
+
+    std::vector<lov::Graphics::StaticBatchData> batches = batcher.bake();
+
+    ASSERT_EQ(batches.size(), 1);
+    ASSERT_EQ(batches[0].materials.size(), batches[0].vertices.size());
+    ASSERT_EQ(batches[0].materials[0].diffuseLayer, 0);
+    ASSERT_EQ(batches[0].materials[2].specularLayer, 1);
+    ASSERT_EQ(batches[0].materials[3].diffuseLayer, 2);
+    ASSERT_EQ(batches[0].materials[5].specularLayer, 3);
+    ASSERT_FLOAT_EQ(batches[0].materials[5].shininess, 8.0f);
+}
+
+/// @brief Test that object ranges and indices are offset into the shared buffers
+TEST_F(StaticBatcherFixture, RecordsRanges) {
+    lov::Graphics::StaticBatcher batcher;
+    lov::lov_uint first = batcher.add(triangle, materialA, lov::Graphics::Transform());
+    lov::lov_uint second = batcher.add(triangle, materialA, lov::Graphics::Transform());
+
+    lov::Graphics::StaticBatchData batch = batcher.bake()[0];
+
+    ASSERT_EQ(batch.ranges[0].objectID, first);
+    ASSERT_EQ(batch.ranges[0].firstIndex, 0);
+    ASSERT_EQ(batch.ranges[0].indexCount, 3);
+    ASSERT_EQ(batch.ranges[1].objectID, second);
+    ASSERT_EQ(batch.ranges[1].firstIndex, 3);
+    ASSERT_EQ(batch.indices[3], 3);
+    ASSERT_EQ(batch.indices[5], 5);
+}
+
+/// @brief Test that positions, normals and bounds are baked into world space
+TEST_F(StaticBatcherFixture, BakesTransforms) {
+    lov::Graphics::StaticBatcher batcher;
+    lov::Graphics::Transform model = lov::Graphics::Transform().translate(5.0f, 0.0f, 0.0f).scale(1.0f, 1.0f, 4.0f);
+    batcher.add(triangle, materialA, model);
+
+    lov::Graphics::StaticBatchData batch = batcher.bake()[0];
+
+    ASSERT_EQ(batch.vertices[1].position, lov::Vector3f(6.0f, 0.0f, 0.0f));
+    ASSERT_EQ(batch.vertices[0].normal, lov::Vector3f(0.0f, 0.0f, 1.0f));
+    ASSERT_EQ(batch.vertices[2].texCoords, lov::Vector2f(0.0f, 1.0f));
+    ASSERT_FLOAT_EQ(batch.ranges[0].bounds.min.x, 5.0f);
+    ASSERT_FLOAT_EQ(batch.bounds.max.y, 1.0f);
+}
+
+/// @brief Test that rotated normals stay unit length
+TEST_F(StaticBatcherFixture, RotatesNormals) {
+    lov::Graphics::StaticBatcher batcher;
+    lov::Graphics::Transform model = lov::Graphics::Transform().rotate(0.0f, 1.0f, 0.0f, lov::Util::toRadians(90.0f)).scale(3.0f, 3.0f, 3.0f);
+    batcher.add(triangle, materialA, model);
+
+    lov::Vector3f normal = batcher.bake()[0].vertices[0].normal;
+
+    ASSERT_NEAR(normal.x, 1.0f, 1e-5f);
+    ASSERT_NEAR(normal.z, 0.0f, 1e-5f);
+    ASSERT_NEAR(lov::Vector::length(normal), 1.0f, 1e-5f);
+}
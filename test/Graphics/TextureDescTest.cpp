@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "Graphics/Texture.h"
+
+/// @brief Fixture used for TextureDesc tests
+class TextureDescFixture : public ::testing::Test {};
+
+/// @brief Test that each channel count gets a sized format, with RGB padded to RGBA
+TEST_F(TextureDescFixture, ForImage) {
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 1).format, lov::Graphics::TextureFormat::R8);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 2).format, lov::Graphics::TextureFormat::RG8);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 3).format, lov::Graphics::TextureFormat::RGBA8);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 4).format, lov::Graphics::TextureFormat::RGBA8);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 3, true).format, lov::Graphics::TextureFormat::SRGB8_ALPHA8);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 1, true).format, lov::Graphics::TextureFormat::R8);
+
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 1).getChannels(), 1);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 2).getChannels(), 2);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(4, 4, 3).getChannels(), 4);
+}
+
+/// @brief Test that a level count of 0 resolves to the full chain of the larger side
+TEST_F(TextureDescFixture, LevelCount) {
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(1, 1, 4).getLevelCount(), 1);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(256, 256, 4).getLevelCount(), 9);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(300, 17, 4).getLevelCount(), 9);
+    ASSERT_EQ(lov::Graphics::TextureDesc::forImage(1, 1024, 4).getLevelCount(), 11);
+
+    lov::Graphics::TextureDesc desc = lov::Graphics::TextureDesc::forImage(256, 256, 4);
+    desc.levels = 3;
+    ASSERT_EQ(desc.getLevelCount(), 3);
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Graphics/TextureManager.h"
+#include "Graphics/Window.h"
+#include "System/Exceptions.h"
+#include "System/ThreadPool.h"
+
+/// @brief Fixture used for TextureManager tests
+class TextureManagerFixture : public ::testing::Test {
+protected:
+    /// @brief Write 4x4 images of solid colors, two of them with the same bytes
+    void SetUp() override {
+        directory = (std::filesystem::temp_directory_path() / "TextureManagerTest").generic_string();
+        std::filesystem::create_directories(directory + "/other");
+
+        writeImage("red.ppm", 255, 0, 0);
+        writeImage("red copy.ppm", 255, 0, 0);
+        writeImage("green.ppm", 0, 255, 0);
+        writeImage("blue.ppm", 0, 0, 255);
+        writeImage("white.ppm", 255, 255, 255);
+    }
+
+    void TearDown() override {
+        window.reset();
+        std::filesystem::remove_all(directory);
+    }
+
+    /// @brief Create a headless window for tests that upload textures
+    /// @return Whether a context could be created
+    bool openWindow() {
+        try {
+            window = std::make_unique<lov::Graphics::Window>(4, 4, "TextureManagerTest", lov::Graphics::WindowMode::Headless);
+            return true;
+        }
+        catch (const lov::Exceptions::WindowException&) {
+            return false;
+        }
+    }
+
+    /// @brief Get the path of an image in the test directory
+    /// @param name The file name
+    /// @return The path
+    std::string path(const std::string& name) const {
+        return directory + "/" + name;
+    }
+
+    /// @brief Write a binary PPM of one color
+    void writeImage(const std::string& name, unsigned char red, unsigned char green, unsigned char blue) const {
+        std::ofstream file(path(name), std::ios::binary);
+        file << "P6\n4 4\n255\n";
+        for (int i = 0; i < 16; i++) {
+            file.put(static_cast<char>(red)).put(static_cast<char>(green)).put(static_cast<char>(blue));
+        }
+    }
+
+    /// @brief Get the absolute form of a path without touching the file system
+    /// @param path The relative path
+    /// @return The expected normalized path
+    static std::string absolute(const std::string& path) {
+        return (std::filesystem::current_path() / path).lexically_normal().generic_string();
+    }
+
+    std::string directory;                          ///< Where the test images are written
+    std::unique_ptr<lov::Graphics::Window> window;  ///< The headless window whose context textures upload to
+};
+
+/// @brief Test that different spellings of the same path normalize to one absolute path
+TEST_F(TextureManagerFixture, NormalizePath) {
+    std::string expected = absolute("textures/missing/wall.png");
+
+    ASSERT_EQ(lov::Graphics::TextureManager::normalizePath("textures/missing/wall.png"), expected);
+    ASSERT_EQ(lov::Graphics::TextureManager::normalizePath("./textures/missing/./wall.png"), expected);
+    ASSERT_EQ(lov::Graphics::TextureManager::normalizePath("textures//missing/other/../wall.png"), expected);
+    ASSERT_EQ(lov::Graphics::TextureManager::normalizePath(expected), expected);
+    ASSERT_NE(lov::Graphics::TextureManager::normalizePath("textures/missing/floor.png"), expected);
+}
+
+/// @brief Test that identical contents hash the same and different contents do not
+TEST_F(TextureManagerFixture, HashContent) {
+    const unsigned char a[] = { 1, 2, 3, 4 };
+    const unsigned char b[] = { 1, 2, 3, 4 };
+    const unsigned char c[] = { 1, 2, 4, 3 };
+
+    ASSERT_EQ(lov::Graphics::TextureManager::hashContent(a, sizeof(a)), lov::Graphics::TextureManager::hashContent(b, sizeof(b)));
+    ASSERT_NE(lov::Graphics::TextureManager::hashContent(a, sizeof(a)), lov::Graphics::TextureManager::hashContent(c, sizeof(c)));
+    ASSERT_NE(lov::Graphics::TextureManager::hashContent(a, sizeof(a)), lov::Graphics::TextureManager::hashContent(a, 3));
+
+    // The 64 bit FNV-1a offset basis for empty input
+    ASSERT_EQ(lov::Graphics::TextureManager::hashContent(nullptr, 0), 14695981039346656037ull);
+}
+
+/// @brief Test that handles count references and that released textures stay resident until reacquired or evicted
+TEST_F(TextureManagerFixture, CountsReferences) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    lov::Graphics::TextureManager manager;
+    lov::Graphics::TextureHandle first = manager.acquire(path("red.ppm"));
+    lov::Graphics::TextureHandle second = manager.acquire(directory + "/./other/../red.ppm");
+    lov::Graphics::TextureHandle copy = second;
+
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ(manager.getStats().textureCount, 1);
+    ASSERT_EQ(manager.getStats().pathHits, 1);
+
+    // Releasing every handle keeps the texture for free reacquisition
+    first = lov::Graphics::TextureHandle();
+    second = lov::Graphics::TextureHandle();
+    ASSERT_EQ(manager.getStats().unreferencedCount, 0);
+    copy = lov::Graphics::TextureHandle();
+    ASSERT_EQ(manager.getStats().unreferencedCount, 1);
+    ASSERT_EQ(manager.getStats().textureCount, 1);
+
+    first = manager.acquire(path("red.ppm"));
+    ASSERT_EQ(manager.getStats().pathHits, 2);
+    ASSERT_EQ(manager.getStats().unreferencedCount, 0);
+
+    // A texture with a handle is never evicted, even with no budget
+    manager.setBudget(0);
+    ASSERT_EQ(manager.getStats().textureCount, 1);
+    first = lov::Graphics::TextureHandle();
+    ASSERT_EQ(manager.getStats().textureCount, 0);
+    ASSERT_EQ(manager.getStats().residentBytes, 0u);
+    ASSERT_EQ(manager.getStats().evictions, 1);
+}
+
+/// @brief Test that going over budget evicts the least recently released textures first
+TEST_F(TextureManagerFixture, EvictsLeastRecentlyReleased) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    // Each 4x4 image pads to RGBA with a third more for mips
+    const size_t bytes = 4 * 4 * 4 * 4 / 3;
+    lov::Graphics::TextureManager manager(nullptr, 2 * bytes);
+
+    lov::Graphics::TextureHandle red = manager.acquire(path("red.ppm"));
+    lov::Graphics::TextureHandle green = manager.acquire(path("green.ppm"));
+    lov::Graphics::TextureHandle blue = manager.acquire(path("blue.ppm"));
+    ASSERT_EQ(manager.getStats().residentBytes, 3 * bytes);
+
+    // Over budget, so the first release frees its texture right away and the rest fit
+    red = lov::Graphics::TextureHandle();
+    green = lov::Graphics::TextureHandle();
+    blue = lov::Graphics::TextureHandle();
+    ASSERT_EQ(manager.getStats().evictions, 1);
+    ASSERT_EQ(manager.getStats().textureCount, 2);
+
+    // Loading another evicts green, released before blue
+    lov::Graphics::TextureHandle white = manager.acquire(path("white.ppm"));
+    ASSERT_EQ(manager.getStats().evictions, 2);
+
+    blue = manager.acquire(path("blue.ppm"));
+    ASSERT_EQ(manager.getStats().pathHits, 1);
+    green = manager.acquire(path("green.ppm"));
+    ASSERT_EQ(manager.getStats().pathHits, 1);
+    ASSERT_EQ(manager.getStats().textureCount, 3);
+}
+
+/// @brief Test that a copy of a file under another name shares the texture, and different bytes of the same size don't
+TEST_F(TextureManagerFixture, SharesEqualContents) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    lov::Graphics::TextureManager manager;
+    lov::Graphics::TextureHandle red = manager.acquire(path("red.ppm"));
+    lov::Graphics::TextureHandle copy = manager.acquire(path("red copy.ppm"));
+    lov::Graphics::TextureHandle green = manager.acquire(path("green.ppm"));
+
+    ASSERT_EQ(red.get(), copy.get());
+    ASSERT_NE(red.get(), green.get());
+    ASSERT_EQ(manager.getStats().contentHits, 1);
+    ASSERT_EQ(manager.getStats().textureCount, 2);
+
+    // The copy's path now leads straight to the shared texture
+    lov::Graphics::TextureHandle again = manager.acquire(path("red copy.ppm"));
+    ASSERT_EQ(manager.getStats().pathHits, 1);
+}
+
+/// @brief Test that with a loader, files are read on its pool and a copy shares the texture once both are read
+TEST_F(TextureManagerFixture, SharesEqualContentsAsynchronously) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    lov::System::ThreadPool pool(2);
+    lov::Graphics::TextureLoader loader(pool);
+    lov::Graphics::TextureManager manager(&loader);
+
+    auto finish = [&]() {
+        while (manager.getStats().pendingCount > 0 || loader.getPendingCount() > 0) {
+            manager.update();
+            loader.update(10.0);
+        }
+    };
+
+    lov::Graphics::TextureHandle red = manager.acquire(path("red.ppm"));
+    ASSERT_EQ(red->getID(), loader.getPlaceholderID());
+    finish();
+    ASSERT_TRUE(red->isReady());
+
+    lov::Graphics::TextureHandle copy = manager.acquire(path("red copy.ppm"));
+    finish();
+
+    ASSERT_EQ(red.get(), copy.get());
+    ASSERT_EQ(manager.getStats().contentHits, 1);
+    ASSERT_EQ(manager.getStats().textureCount, 1);
+}
+
+/// @brief Test that loads sharing a texture still being read count its bytes as deduped once they're known
+TEST_F(TextureManagerFixture, CountsDedupedBytesOfPendingLoads) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    lov::System::ThreadPool pool(2);
+    lov::Graphics::TextureLoader loader(pool);
+    lov::Graphics::TextureManager manager(&loader);
+
+    auto finish = [&]() {
+        while (manager.getStats().pendingCount > 0 || loader.getPendingCount() > 0) {
+            manager.update();
+            loader.update(10.0);
+        }
+    };
+
+    // The second acquire hits the path before the first read finishes
+    lov::Graphics::TextureHandle red = manager.acquire(path("red.ppm"));
+    lov::Graphics::TextureHandle again = manager.acquire(path("red.ppm"));
+    ASSERT_EQ(manager.getStats().pathHits, 1);
+    ASSERT_EQ(manager.getStats().dedupedBytes, 0u);
+    finish();
+
+    size_t bytes = manager.getStats().residentBytes;
+    ASSERT_GT(bytes, 0u);
+    ASSERT_EQ(manager.getStats().dedupedBytes, bytes);
+
+    // Both acquires of the copy share red, the second through the copy's pending path
+    lov::Graphics::TextureHandle copy = manager.acquire(path("red copy.ppm"));
+    lov::Graphics::TextureHandle copyAgain = manager.acquire(path("red copy.ppm"));
+    finish();
+    ASSERT_EQ(manager.getStats().dedupedBytes, 3 * bytes);
+
+    // A path hit on the copy, which shares red, counts red's bytes
+    lov::Graphics::TextureHandle copyLater = manager.acquire(path("red copy.ppm"));
+    ASSERT_EQ(copyLater.get(), red.get());
+    ASSERT_EQ(manager.getStats().dedupedBytes, 4 * bytes);
+    ASSERT_EQ(manager.getStats().residentBytes, bytes);
+}
+
+/// @brief Test that contents held in memory are shared by name and by bytes, including with a file of the same bytes
+TEST_F(TextureManagerFixture, SharesContentsInMemory) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    std::ifstream file(path("red.ppm"), std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::span<const std::byte> contents = std::as_bytes(std::span(bytes));
+
+    lov::Graphics::TextureManager manager;
+    lov::Graphics::TextureHandle packed = manager.acquire("Textures/red.ppm", contents);
+    lov::Graphics::TextureHandle again = manager.acquire("Textures/red.ppm", contents);
+    lov::Graphics::TextureHandle red = manager.acquire(path("red copy.ppm"));
+
+    ASSERT_EQ(packed.get(), again.get());
+    ASSERT_EQ(packed.get(), red.get());
+    ASSERT_EQ(manager.getStats().pathHits, 1);
+    ASSERT_EQ(manager.getStats().contentHits, 1);
+    ASSERT_EQ(manager.getStats().textureCount, 1);
+
+    ASSERT_THROW(manager.acquire("Textures/empty.ppm", {}), lov::Exceptions::TextureException);
+}
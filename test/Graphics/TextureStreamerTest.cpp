@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/TextureStreamer.h"
+#include "Graphics/Window.h"
+#include "System/Exceptions.h"
+#include "System/ThreadPool.h"
+#include "System/Utility.h"
+
+/// @brief Fixture used for TextureStreamer tests
+class TextureStreamerFixture : public ::testing::Test {
+protected:
+    void TearDown() override {
+        window.reset();
+        if (!directory.empty()) {
+            std::filesystem::remove_all(directory);
+        }
+    }
+
+    /// @brief Create a headless window and a directory for tests that stream textures
+    /// @return Whether a context could be created
+    bool openWindow() {
+        try {
+            window = std::make_unique<lov::Graphics::Window>(4, 4, "TextureStreamerTest", lov::Graphics::WindowMode::Headless);
+        }
+        catch (const lov::Exceptions::WindowException&) {
+            return false;
+        }
+
+        directory = (std::filesystem::temp_directory_path() / "TextureStreamerTest").generic_string();
+        std::filesystem::create_directories(directory);
+        return true;
+    }
+
+    /// @brief Write a binary PPM of one grey level
+    /// @param name The file name
+    /// @param size The width and height
+    /// @return The path of the file
+    std::string writeImage(const std::string& name, int size) const {
+        std::string path = directory + "/" + name;
+        std::ofstream file(path, std::ios::binary);
+        file << "P6\n" << size << " " << size << "\n255\n";
+        for (int i = 0; i < size * size * 3; i++) {
+            file.put(static_cast<char>(200));
+        }
+
+        return path;
+    }
+
+    std::string directory;                          ///< Where the test images are written
+    std::unique_ptr<lov::Graphics::Window> window;  ///< The headless window whose context textures upload to
+};
+
+/// @brief Test that the wanted level drops by one each time the object's size on screen halves
+TEST_F(TextureStreamerFixture, ComputeMipLevel) {
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 1024.0f, 1.0f), 0);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 2048.0f, 1.0f), 0);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 512.0f, 1.0f), 1);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 300.0f, 1.0f), 1);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 512, 64.0f, 1.0f), 4);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 0.5f, 1.0f), 10);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 0.0f, 1.0f), 10);
+}
+
+/// @brief Test that repeating a texture across an object needs finer levels
+TEST_F(TextureStreamerFixture, UVDensity) {
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 256.0f, 1.0f), 2);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 256.0f, 0.25f), 0);
+    ASSERT_EQ(lov::Graphics::TextureStreamer::computeMipLevel(1024, 1024, 256.0f, 4.0f), 4);
+}
+
+/// @brief Test that the projected size falls off with distance and fills the viewport from inside
+TEST_F(TextureStreamerFixture, ProjectedSize) {
+    lov::Graphics::BoundingBox bounds(lov::Vector3f(-1.0f, -1.0f, -1.0f), lov::Vector3f(1.0f, 1.0f, 1.0f));
+    float fovY = lov::Util::toRadians(90.0f);
+
+    float near = lov::Graphics::TextureStreamer::projectedSize(bounds, lov::Vector3f(0.0f, 0.0f, 10.0f), fovY, 600);
+    float far = lov::Graphics::TextureStreamer::projectedSize(bounds, lov::Vector3f(0.0f, 0.0f, 20.0f), fovY, 600);
+
+    ASSERT_NEAR(near, std::sqrt(3.0f) / 10.0f * 600.0f, 1e-3f);
+    ASSERT_NEAR(far, near * 0.5f, 1e-3f);
+    ASSERT_FLOAT_EQ(lov::Graphics::TextureStreamer::projectedSize(bounds, lov::Vector3f(0.0f, 0.0f, 1.0f), fovY, 600), 600.0f);
+}
+
+/// @brief Test that finer levels of a decoded image come from its kept chain, and a failed read is only reported after
+/// the frame's levels have been freed and read
+TEST_F(TextureStreamerFixture, StreamsDecodedLevelsAndReportsFailures) {
+    if (!openWindow()) {
+        GTEST_SKIP() << "No OpenGL context";
+    }
+
+    // One worker runs reads in the order they're queued
+    lov::System::ThreadPool pool(1);
+    lov::Graphics::TextureStreamer streamer(pool, 1024 * 1024, 4);
+
+    // A 32x32 image has 6 levels, of which 4x4 and smaller are the tail
+    std::string path = writeImage("grey.ppm", 32);
+    lov::lov_uint grey = streamer.add(path);
+    while (streamer.getStats().pendingLoads > 0) {
+        streamer.update(10.0);
+    }
+    ASSERT_EQ(streamer.getResidentLevel(grey), 3);
+
+    // Finer levels are copied from the chain decoded for the tail, so the file isn't needed any more
+    std::filesystem::remove(path);
+    lov::lov_uint missing = streamer.add(directory + "/missing.ppm");
+    pool.submit([]() {}).wait();
+
+    streamer.request(grey, 32.0f);
+    ASSERT_THROW(streamer.update(10.0), lov::Exceptions::TextureException);
+    ASSERT_EQ(streamer.getResidentLevel(missing), -1);
+    ASSERT_EQ(streamer.getStats().pendingLoads, 1);
+
+    while (streamer.getStats().pendingLoads > 0) {
+        streamer.request(grey, 32.0f);
+        streamer.update(10.0);
+    }
+    ASSERT_EQ(streamer.getResidentLevel(grey), 0);
+}
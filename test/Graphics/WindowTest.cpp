@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "Graphics/Sampler.h"
+#include "Graphics/Window.h"
+#include "System/Exceptions.h"
+
+/// @brief Fixture used for Window tests, creating a headless window or skipping where no context can be made
+class WindowFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        try {
+            window = std::make_unique<lov::Graphics::Window>(32, 16, "WindowTest", lov::Graphics::WindowMode::Headless);
+        }
+        catch (const lov::Exceptions::WindowException& e) {
+            GTEST_SKIP() << e.what();
+        }
+    }
+
+    std::unique_ptr<lov::Graphics::Window> window;
+};
+
+/// @brief Test that clearing a headless window fills its offscreen framebuffer
+TEST_F(WindowFixture, ClearsOffscreen) {
+    window->setClearColor(1.0f, 0.0f, 1.0f);
+    window->clear();
+    std::vector<uint8_t> pixels = window->readPixels();
+
+    ASSERT_TRUE(window->isHeadless());
+    ASSERT_EQ(pixels.size(), 32u * 16u * 4u);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        ASSERT_EQ(pixels[i], 255);
+        ASSERT_EQ(pixels[i + 1], 0);
+        ASSERT_EQ(pixels[i + 2], 255);
+        ASSERT_EQ(pixels[i + 3], 255);
+    }
+}
+
+/// @brief Test that a headless window runs frames until it's closed
+TEST_F(WindowFixture, RunsUntilClosed) {
+    ASSERT_TRUE(window->isOpen());
+
+    for (int frame = 0; frame < 4; frame++) {
+        window->clear();
+        window->update();
+    }
+
+    ASSERT_LE(window->getPacingStats().framesInFlight, 2u);
+    ASSERT_EQ(window->getKeyState(lov::Input::KEY_ESCAPE), lov::Input::KEY_RELEASE);
+    ASSERT_TRUE(window->isOpen());
+
+    window->close();
+    ASSERT_FALSE(window->isOpen());
+}
+
+/// @brief Test that destroying a window deletes the sampler objects cached for its context
+TEST_F(WindowFixture, ClearsSamplersWithContext) {
+    lov::Graphics::SamplerDesc desc;
+    lov::lov_uint sampler = lov::Graphics::SamplerCache::get(desc);
+    ASSERT_TRUE(glIsSampler(sampler));
+    ASSERT_EQ(lov::Graphics::SamplerCache::getCount(), 1);
+
+    window.reset();
+    ASSERT_EQ(lov::Graphics::SamplerCache::getCount(), 0);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "Input/InputQueue.h"
+
+/// @brief Fixture used for InputQueue tests
+class InputQueueFixture : public ::testing::Test {
+protected:
+    /// @brief Push an event stamped now
+    /// @param type What happened
+    /// @param code The key or button
+    /// @param value The cursor position or scroll offset
+    void push(lov::Input::InputEventType type, int code = 0, lov::Vector2f value = lov::Vector2f(0.0f, 0.0f)) {
+        m_input.push({ type, code, value, lov::System::FrameClock::Clock::now() });
+    }
+
+    lov::Input::InputQueue m_input{ 8 };    ///< The queue under test
+};
+
+/// @brief Test key presses and releases set the down state and edges of the frame they arrive in
+TEST_F(InputQueueFixture, TracksKeyEdges) {
+    push(lov::Input::InputEventType::KeyPress, lov::Input::KEY_W);
+    m_input.update();
+    ASSERT_TRUE(m_input.isDown(lov::Input::KEY_W));
+    ASSERT_TRUE(m_input.wasPressed(lov::Input::KEY_W));
+    ASSERT_FALSE(m_input.wasReleased(lov::Input::KEY_W));
+
+    // Edges only last one update
+    m_input.update();
+    ASSERT_TRUE(m_input.isDown(lov::Input::KEY_W));
+    ASSERT_FALSE(m_input.wasPressed(lov::Input::KEY_W));
+
+    push(lov::Input::InputEventType::KeyRelease, lov::Input::KEY_W);
+    m_input.update();
+    ASSERT_FALSE(m_input.isDown(lov::Input::KEY_W));
+    ASSERT_TRUE(m_input.wasReleased(lov::Input::KEY_W));
+
+    // A tap within one frame still reads as pressed, and unknown keys are ignored
+    push(lov::Input::InputEventType::KeyPress, lov::Input::KEY_SPACE);
+    push(lov::Input::InputEventType::KeyRelease, lov::Input::KEY_SPACE);
+    push(lov::Input::InputEventType::KeyPress, lov::Input::KEY_UNKNOWN);
+    push(lov::Input::InputEventType::ButtonPress, lov::Input::MOUSE_BUTTON_RIGHT);
+    m_input.update();
+    ASSERT_FALSE(m_input.isDown(lov::Input::KEY_SPACE));
+    ASSERT_TRUE(m_input.wasPressed(lov::Input::KEY_SPACE));
+    ASSERT_TRUE(m_input.wasReleased(lov::Input::KEY_SPACE));
+    ASSERT_FALSE(m_input.isDown(lov::Input::KEY_UNKNOWN));
+    ASSERT_TRUE(m_input.isDown(lov::Input::MOUSE_BUTTON_RIGHT));
+    ASSERT_TRUE(m_input.wasPressed(lov::Input::MOUSE_BUTTON_RIGHT));
+    ASSERT_EQ(m_input.getEvents().size(), 4u);
+}
+
+/// @brief Test every cursor move of a frame adds to its motion, measured from the first position seen
+TEST_F(InputQueueFixture, AccumulatesCursorMotion) {
+    push(lov::Input::InputEventType::CursorMove, 0, lov::Vector2f(100.0f, 100.0f));
+    push(lov::Input::InputEventType::CursorMove, 0, lov::Vector2f(103.0f, 98.0f));
+    push(lov::Input::InputEventType::CursorMove, 0, lov::Vector2f(110.0f, 90.0f));
+    push(lov::Input::InputEventType::Scroll, 0, lov::Vector2f(0.0f, 1.0f));
+    push(lov::Input::InputEventType::Scroll, 0, lov::Vector2f(0.0f, 2.0f));
+    m_input.update();
+
+    ASSERT_EQ(m_input.getCursorDelta(), lov::Vector2f(10.0f, -10.0f));
+    ASSERT_EQ(m_input.getCursorPosition(), lov::Vector2f(110.0f, 90.0f));
+    ASSERT_EQ(m_input.getScrollDelta(), lov::Vector2f(0.0f, 3.0f));
+
+    // Timestamps of a frame's events never go backwards
+    std::span<const lov::Input::InputEvent> events = m_input.getEvents();
+    for (size_t i = 1; i < events.size(); i++) {
+        ASSERT_LE(events[i - 1].time, events[i].time);
+    }
+
+    m_input.update();
+    ASSERT_EQ(m_input.getCursorDelta(), lov::Vector2f(0.0f, 0.0f));
+    ASSERT_TRUE(m_input.getEvents().empty());
+}
+
+/// @brief Test events past the capacity are dropped and counted
+TEST_F(InputQueueFixture, CountsDroppedEvents) {
+    for (int i = 0; i < 10; i++) {
+        push(lov::Input::InputEventType::Scroll, 0, lov::Vector2f(1.0f, 0.0f));
+    }
+    m_input.update();
+
+    lov::Input::InputQueueStats stats = m_input.getStats();
+    ASSERT_EQ(stats.events, 8u);
+    ASSERT_EQ(stats.dropped, 2u);
+    ASSERT_EQ(m_input.getScrollDelta(), lov::Vector2f(8.0f, 0.0f));
+}
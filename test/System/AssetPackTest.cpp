@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "System/AssetPack.h"
+#include "System/Exceptions.h"
+
+/// @brief Fixture used for AssetPack tests
+class AssetPackFixture : public ::testing::Test {
+protected:
+    /// @brief Get a path in the temporary directory for a pack
+    /// @param name The file name
+    /// @return The path
+    static std::string tempPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    /// @brief Convert text to the bytes of an asset
+    /// @param text The text
+    /// @return The bytes
+    static std::vector<std::byte> bytesOf(const std::string& text) {
+        std::vector<std::byte> bytes(text.size());
+        memcpy(bytes.data(), text.data(), text.size());
+        return bytes;
+    }
+
+    /// @brief Compare a view with text
+    /// @param view The view
+    /// @param text The text
+    /// @return Whether they hold the same bytes
+    static bool equals(std::span<const std::byte> view, const std::string& text) {
+        return view.size() == text.size() && memcmp(view.data(), text.data(), text.size()) == 0;
+    }
+};
+
+/// @brief Test that written assets are found by name, aligned, and missing names aren't
+TEST_F(AssetPackFixture, WriteAndFind) {
+    std::string path = tempPath("lov_asset_pack_test.pack");
+
+    lov::System::AssetPackWriter writer;
+    writer.add("Shaders/basic.vs", bytesOf("#version 330 core"));
+    writer.add("Textures/odd.bin", bytesOf("abc"));
+    writer.add("Empty", {});
+    for (int i = 0; i < 50; i++) {
+        writer.add("Generated/" + std::to_string(i), bytesOf(std::string(i, 'x')));
+    }
+
+    writer.writeFile(path);
+
+    {
+        lov::System::AssetPack pack(path);
+        ASSERT_EQ(pack.getAssetCount(), 53);
+        ASSERT_TRUE(equals(pack.get("Shaders/basic.vs"), "#version 330 core"));
+        ASSERT_TRUE(equals(pack.get("Textures/odd.bin"), "abc"));
+        ASSERT_TRUE(pack.contains("Empty"));
+        ASSERT_EQ(pack.get("Empty").size(), 0u);
+
+        for (int i = 0; i < 50; i++) {
+            std::span<const std::byte> view = pack.get("Generated/" + std::to_string(i));
+            ASSERT_TRUE(equals(view, std::string(i, 'x')));
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(view.data()) % lov::System::AssetPack::ALIGNMENT, 0u);
+        }
+
+        ASSERT_FALSE(pack.contains("Shaders/basic.fs"));
+        ASSERT_FALSE(pack.contains("shaders/basic.vs"));
+        ASSERT_TRUE(pack.find("Missing").empty());
+        ASSERT_THROW(pack.get("Missing"), lov::Exceptions::AssetException);
+    }
+
+    std::filesystem::remove(path);
+}
+
+/// @brief Test that names must be unique and non empty
+TEST_F(AssetPackFixture, RejectsBadNames) {
+    lov::System::AssetPackWriter writer;
+    writer.add("a", bytesOf("1"));
+    ASSERT_THROW(writer.add("a", bytesOf("2")), lov::Exceptions::AssetException);
+    ASSERT_THROW(writer.add("", bytesOf("3")), lov::Exceptions::AssetException);
+    ASSERT_EQ(writer.getAssetCount(), 1);
+}
+
+/// @brief Test that files that aren't packs, or whose directory points outside the file, are rejected
+TEST_F(AssetPackFixture, RejectsMalformedFiles) {
+    std::string path = tempPath("lov_asset_pack_bad.pack");
+    ASSERT_THROW(lov::System::AssetPack("/nonexistent/lov.pack"), lov::Exceptions::AssetException);
+
+    // Not a pack at all
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "definitely not a pack, but long enough to hold a header";
+    }
+
+    ASSERT_THROW(lov::System::AssetPack pack(path), lov::Exceptions::AssetException);
+
+    // A valid pack cut short, so its asset lies past the end
+    lov::System::AssetPackWriter writer;
+    writer.add("big", std::vector<std::byte>(1000, std::byte(7)));
+    std::vector<std::byte> contents = writer.write();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(contents.data()), contents.size() - 10);
+    }
+
+    ASSERT_THROW(lov::System::AssetPack pack(path), lov::Exceptions::AssetException);
+    std::filesystem::remove(path);
+}
+
+/// @brief Test the name hash against known FNV-1a values
+TEST_F(AssetPackFixture, HashName) {
+    ASSERT_EQ(lov::System::AssetPack::hashName(""), 14695981039346656037ull);
+    ASSERT_EQ(lov::System::AssetPack::hashName("a"), 0xaf63dc4c8601ec8cull);
+    ASSERT_NE(lov::System::AssetPack::hashName("Shaders/basic.vs"), lov::System::AssetPack::hashName("Shaders/basic.fs"));
+}
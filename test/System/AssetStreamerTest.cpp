@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "System/AssetStreamer.h"
+#include "System/Exceptions.h"
+
+/// @brief Fixture used for AssetStreamer tests, with assets in memory that record when they're loaded and evicted
+class AssetStreamerFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_directory = std::filesystem::temp_directory_path() / "lov_asset_streamer_test";
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    /// @brief Make callbacks that record the asset's name when it's loaded and evicted
+    /// @param name The name recorded
+    /// @param bytes The size the load callback returns
+    /// @return The callbacks
+    lov::System::AssetCallbacks record(const std::string& name, size_t bytes) {
+        lov::System::AssetCallbacks callbacks;
+        callbacks.load = [this, name, bytes](std::span<const std::byte> data) {
+            m_loaded.push_back(name);
+            m_data.assign(reinterpret_cast<const char*>(data.data()), data.size());
+            return bytes;
+        };
+        callbacks.evict = [this, name]() { m_evicted.push_back(name); };
+        return callbacks;
+    }
+
+    /// @brief Update until a condition holds, or give up after a second
+    /// @param streamer The streamer
+    /// @param condition The condition
+    template<typename Condition>
+    static void updateUntil(lov::System::AssetStreamer& streamer, Condition condition) {
+        for (int i = 0; i < 1000 && !condition(); i++) {
+            streamer.update(100.0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /// @brief View text as bytes
+    /// @param text The text
+    /// @return The bytes
+    static std::span<const std::byte> bytes(const std::string& text) {
+        return std::as_bytes(std::span<const char>(text.data(), text.size()));
+    }
+
+    lov::System::ThreadPool m_pool{ 2 };    ///< Runs decodes and fallback reads
+    lov::System::AsyncIO m_io{ m_pool };    ///< Reads asset files
+    std::filesystem::path m_directory;      ///< Holds the files to read
+    std::vector<std::string> m_loaded;      ///< Names of assets loaded, in order
+    std::vector<std::string> m_evicted;     ///< Names of assets evicted, in order
+    std::string m_data;                     ///< Data handed to the last load callback
+};
+
+/// @brief Test that adding reads nothing, and that requested assets load nearest first
+TEST_F(AssetStreamerFixture, LoadsNearestFirst) {
+    const std::string far = "far", near = "near", middle = "middle";
+    lov::System::AssetStreamer streamer(m_io, m_pool, 1);
+    lov::lov_uint farAsset = streamer.add(bytes(far), lov::System::AssetType::Texture, record(far, 1));
+    lov::lov_uint nearAsset = streamer.add(bytes(near), lov::System::AssetType::Texture, record(near, 1));
+    lov::lov_uint middleAsset = streamer.add(bytes(middle), lov::System::AssetType::Texture, record(middle, 1));
+
+    streamer.update(100.0);
+    ASSERT_EQ(streamer.getStats().assetCount, 3);
+    ASSERT_EQ(streamer.getStats().inFlightCount, 0);
+
+    for (int frame = 0; frame < 4; frame++) {
+        streamer.request(farAsset, 5.0f);
+        streamer.request(nearAsset, 9.0f);
+        streamer.request(nearAsset, 1.0f);
+        streamer.request(middleAsset, 3.0f);
+        streamer.update(100.0);
+        ASSERT_LE(streamer.getStats().inFlightCount, 1);
+    }
+
+    ASSERT_EQ(m_loaded, std::vector<std::string>({ near, middle, far }));
+    ASSERT_EQ(m_data, far);
+    ASSERT_TRUE(streamer.isResident(farAsset));
+    ASSERT_EQ(streamer.getStats().residentCount, 3);
+    ASSERT_EQ(streamer.getStats().residentBytes[0], 3);
+}
+
+/// @brief Test that files are read and decoded before their load callback gets the decoded bytes
+TEST_F(AssetStreamerFixture, ReadsAndDecodesFiles) {
+    std::string path = (m_directory / "asset.txt").string();
+    std::ofstream(path, std::ios::binary) << "streamed";
+
+    lov::System::AssetCallbacks callbacks = record("asset", 8);
+    callbacks.decode = [](std::span<const std::byte> bytes) {
+        std::vector<std::byte> decoded(bytes.begin(), bytes.end());
+        for (std::byte& byte : decoded) {
+            byte = static_cast<std::byte>(toupper(static_cast<int>(byte)));
+        }
+
+        return decoded;
+    };
+
+    lov::System::AssetStreamer streamer(m_io, m_pool);
+    lov::lov_uint asset = streamer.add(path, lov::System::AssetType::Mesh, callbacks);
+    updateUntil(streamer, [&]() {
+        streamer.request(asset, 0.0f);
+        return streamer.isResident(asset);
+    });
+
+    ASSERT_TRUE(streamer.isResident(asset));
+    ASSERT_EQ(m_data, "STREAMED");
+    ASSERT_EQ(streamer.getStats().residentBytes[static_cast<size_t>(lov::System::AssetType::Mesh)], 8);
+    ASSERT_EQ(streamer.getStats().loads, 1);
+}
+
+/// @brief Test that a load nobody requests any more gives up its slot to a waiting request, and cancelled loads never load
+TEST_F(AssetStreamerFixture, PreemptsAndCancels) {
+    std::atomic<bool> open = false;
+    const std::string stale = "stale", fresh = "fresh";
+
+    lov::System::AssetCallbacks gated = record(stale, 1);
+    gated.decode = [&open](std::span<const std::byte> bytes) {
+        while (!open) {
+            std::this_thread::yield();
+        }
+
+        return std::vector<std::byte>(bytes.begin(), bytes.end());
+    };
+
+    lov::System::AssetStreamer streamer(m_io, m_pool, 1);
+    lov::lov_uint staleAsset = streamer.add(bytes(stale), lov::System::AssetType::Texture, gated);
+    lov::lov_uint freshAsset = streamer.add(bytes(fresh), lov::System::AssetType::Texture, record(fresh, 1));
+
+    streamer.request(staleAsset, 0.0f);
+    streamer.update(100.0);
+    ASSERT_EQ(streamer.getStats().inFlightCount, 1);
+
+    streamer.request(freshAsset, 10.0f);
+    streamer.update(100.0);
+    ASSERT_EQ(streamer.getStats().cancellations, 1);
+
+    open = true;
+    updateUntil(streamer, [&]() { return streamer.isResident(freshAsset); });
+    for (int i = 0; i < 5; i++) {
+        streamer.update(100.0);
+    }
+
+    ASSERT_EQ(m_loaded, std::vector<std::string>({ fresh }));
+    ASSERT_FALSE(streamer.isResident(staleAsset));
+
+    // Cancelling a requested load stops it starting this frame too
+    open = false;
+    streamer.request(staleAsset, 0.0f);
+    streamer.update(100.0);
+    streamer.cancel(staleAsset);
+    ASSERT_EQ(streamer.getStats().inFlightCount, 0);
+    ASSERT_EQ(streamer.getStats().cancellations, 2);
+
+    streamer.request(staleAsset, 0.0f);
+    streamer.cancel(staleAsset);
+    streamer.update(100.0);
+    ASSERT_EQ(streamer.getStats().inFlightCount, 0);
+    open = true;
+}
+
+/// @brief Test that a type over budget evicts its least recently requested assets, and that removing evicts too
+TEST_F(AssetStreamerFixture, EvictsOverBudget) {
+    const std::string first = "first", second = "second", third = "third", mesh = "mesh";
+    lov::System::AssetStreamer streamer(m_io, m_pool);
+    streamer.setBudget(lov::System::AssetType::Texture, 250);
+    lov::lov_uint firstAsset = streamer.add(bytes(first), lov::System::AssetType::Texture, record(first, 100));
+    lov::lov_uint secondAsset = streamer.add(bytes(second), lov::System::AssetType::Texture, record(second, 100));
+    lov::lov_uint thirdAsset = streamer.add(bytes(third), lov::System::AssetType::Texture, record(third, 100));
+    lov::lov_uint meshAsset = streamer.add(bytes(mesh), lov::System::AssetType::Mesh, record(mesh, 1000));
+
+    // Assets requested this frame stay even over budget
+    streamer.request(firstAsset, 0.0f);
+    streamer.request(meshAsset, 0.0f);
+    streamer.update(100.0);
+    streamer.request(secondAsset, 0.0f);
+    streamer.request(thirdAsset, 0.0f);
+    streamer.update(100.0);
+    streamer.request(secondAsset, 0.0f);
+    streamer.request(thirdAsset, 0.0f);
+    streamer.update(100.0);
+    ASSERT_EQ(m_loaded.size(), 4);
+    ASSERT_EQ(m_evicted, std::vector<std::string>({ first }));
+    ASSERT_EQ(streamer.getStats().residentBytes[0], 200);
+    ASSERT_EQ(streamer.getStats().evictions, 1);
+    ASSERT_TRUE(streamer.isResident(meshAsset));
+
+    // Lowering the budget evicts on the next update, and nothing more of a type starts while it's full
+    streamer.setBudget(lov::System::AssetType::Texture, 100);
+    streamer.request(firstAsset, 0.0f);
+    streamer.request(thirdAsset, 0.0f);
+    streamer.update(100.0);
+    ASSERT_EQ(m_evicted, std::vector<std::string>({ first, second }));
+    ASSERT_EQ(streamer.getStats().inFlightCount, 0);
+
+    streamer.remove(thirdAsset);
+    ASSERT_EQ(m_evicted, std::vector<std::string>({ first, second, third }));
+    ASSERT_EQ(streamer.getStats().assetCount, 3);
+    ASSERT_EQ(streamer.add(bytes(third), lov::System::AssetType::Texture, record(third, 100)), thirdAsset);
+}
+
+/// @brief Test that failed reads and decodes throw once after the other assets are handled, and aren't retried
+TEST_F(AssetStreamerFixture, ThrowsOnFailure) {
+    const std::string good = "good";
+    lov::System::AssetCallbacks failing = record("bad", 1);
+    failing.decode = [](std::span<const std::byte>) -> std::vector<std::byte> {
+        throw lov::Exceptions::AssetException("Corrupt");
+    };
+
+    lov::System::AssetStreamer streamer(m_io, m_pool);
+    lov::lov_uint missingAsset = streamer.add((m_directory / "missing").string(), lov::System::AssetType::Texture, record("missing", 1));
+    lov::lov_uint badAsset = streamer.add(bytes(good), lov::System::AssetType::Texture, failing);
+    lov::lov_uint goodAsset = streamer.add(bytes(good), lov::System::AssetType::Texture, record(good, 1));
+
+    int throws = 0;
+    for (int i = 0; i < 1000 && streamer.getStats().failures + streamer.getStats().loads < 3; i++) {
+        streamer.request(missingAsset, 0.0f);
+        streamer.request(badAsset, 0.0f);
+        streamer.request(goodAsset, 0.0f);
+        try {
+            streamer.update(100.0);
+        }
+        catch (const lov::Exceptions::AssetException&) {
+            throws++;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_GE(throws, 1);
+    ASSERT_EQ(streamer.getStats().failures, 2);
+    ASSERT_EQ(m_loaded, std::vector<std::string>({ good }));
+
+    streamer.request(missingAsset, 0.0f);
+    streamer.request(badAsset, 0.0f);
+    ASSERT_NO_THROW(streamer.update(100.0));
+    ASSERT_EQ(streamer.getStats().inFlightCount, 0);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "System/AsyncIO.h"
+#include "System/Exceptions.h"
+#include "System/Task.h"
+
+/// @brief Fixture used for AsyncIO tests, which writes files to read into a temporary directory
+class AsyncIOFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_directory = std::filesystem::temp_directory_path() / "lov_async_io_test";
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    /// @brief Write a file in the temporary directory
+    /// @param name The file name
+    /// @param contents The contents
+    /// @return The path
+    std::string writeFile(const std::string& name, const std::string& contents) {
+        std::string path = (m_directory / name).string();
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+        return path;
+    }
+
+    /// @brief Compare read bytes with text
+    /// @param bytes The bytes
+    /// @param text The text
+    /// @return Whether they match
+    static bool equals(const std::vector<std::byte>& bytes, const std::string& text) {
+        return bytes.size() == text.size() && memcmp(bytes.data(), text.data(), text.size()) == 0;
+    }
+
+    /// @brief Both backends, so each test covers the thread pool fallback even where io_uring works
+    const std::vector<lov::System::AsyncIO::Backend> m_backends = { lov::System::AsyncIO::Backend::IoUring, lov::System::AsyncIO::Backend::ThreadPool };
+
+    lov::System::ThreadPool m_pool{ 2 };    ///< Runs fallback reads
+    std::filesystem::path m_directory;      ///< Holds the files to read
+};
+
+/// @brief Test that a coroutine awaiting a read gets the whole file, and only resumes inside poll or wait
+TEST_F(AsyncIOFixture, ReadsFile) {
+    std::string contents(300000, 'a');
+    for (size_t i = 0; i < contents.size(); i++) {
+        contents[i] = static_cast<char>('a' + i % 26);
+    }
+
+    std::string path = writeFile("big.bin", contents);
+    for (lov::System::AsyncIO::Backend backend : m_backends) {
+        lov::System::AsyncIO io(m_pool, 8, backend);
+        std::vector<std::byte> read;
+        auto load = [&]() -> lov::System::Task { read = co_await io.read(path); };
+
+        lov::System::Task task = load();
+        ASSERT_FALSE(task.isDone());
+        ASSERT_EQ(io.getPendingCount(), 1);
+
+        io.wait();
+        ASSERT_TRUE(task.isDone());
+        ASSERT_EQ(io.getPendingCount(), 0);
+        ASSERT_TRUE(equals(read, contents));
+    }
+}
+
+/// @brief Test that a batch larger than the queue depth reads every file in order
+TEST_F(AsyncIOFixture, ReadsBatch) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 200; i++) {
+        paths.push_back(writeFile("file" + std::to_string(i), std::string(i, static_cast<char>('0' + i % 10))));
+    }
+
+    for (lov::System::AsyncIO::Backend backend : m_backends) {
+        lov::System::AsyncIO io(m_pool, 16, backend);
+        std::vector<std::vector<std::byte>> read;
+        auto load = [&]() -> lov::System::Task { read = co_await io.readAll(paths); };
+
+        lov::System::Task task = load();
+        while (!task.isDone()) {
+            io.poll();
+        }
+
+        task.rethrow();
+        ASSERT_EQ(read.size(), 200u);
+        for (int i = 0; i < 200; i++) {
+            ASSERT_TRUE(equals(read[i], std::string(i, static_cast<char>('0' + i % 10))));
+        }
+    }
+}
+
+/// @brief Test that missing files throw into the coroutine, and that awaiting a task resumes its awaiter
+TEST_F(AsyncIOFixture, MissingFileThrows) {
+    std::string path = writeFile("present.txt", "present");
+    std::string missing = (m_directory / "missing.txt").string();
+    std::vector<std::string> batchPaths = { path, missing };
+
+    for (lov::System::AsyncIO::Backend backend : m_backends) {
+        lov::System::AsyncIO io(m_pool, 8, backend);
+        bool caught = false;
+        auto loadMissing = [&]() -> lov::System::Task { co_await io.read(missing); };
+        auto loadBatch = [&]() -> lov::System::Task { co_await io.readAll(batchPaths); };
+        auto loadBoth = [&]() -> lov::System::Task {
+            try {
+                co_await loadMissing();
+            }
+            catch (const lov::Exceptions::IOException&) {
+                caught = true;
+            }
+        };
+
+        lov::System::Task both = loadBoth();
+        lov::System::Task batch = loadBatch();
+        io.wait();
+
+        ASSERT_TRUE(both.isDone());
+        ASSERT_TRUE(caught);
+        ASSERT_TRUE(batch.isDone());
+        ASSERT_THROW(batch.rethrow(), lov::Exceptions::IOException);
+    }
+}
+
+/// @brief Test that empty files and empty batches complete
+TEST_F(AsyncIOFixture, EmptyReads) {
+    std::string path = writeFile("empty.txt", "");
+    std::vector<std::string> noPaths;
+
+    for (lov::System::AsyncIO::Backend backend : m_backends) {
+        lov::System::AsyncIO io(m_pool, 8, backend);
+        size_t size = 1;
+        size_t batchSize = 1;
+        auto load = [&]() -> lov::System::Task {
+            size = (co_await io.read(path)).size();
+            batchSize = (co_await io.readAll(noPaths)).size();
+        };
+
+        lov::System::Task task = load();
+        io.wait();
+        task.rethrow();
+        ASSERT_TRUE(task.isDone());
+        ASSERT_EQ(size, 0u);
+        ASSERT_EQ(batchSize, 0u);
+    }
+}
+
+/// @brief Test that reads awaited one at a time are queued and submitted to the kernel together
+TEST_F(AsyncIOFixture, SubmitsQueuedReadsTogether) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 32; i++) {
+        paths.push_back(writeFile("queued" + std::to_string(i), std::string(100 + i, static_cast<char>('a' + i % 26))));
+    }
+
+    lov::System::AsyncIO io(m_pool, 64);
+    if (io.getBackend() != lov::System::AsyncIO::Backend::IoUring) {
+        GTEST_SKIP() << "io_uring unavailable";
+    }
+
+    std::vector<std::vector<std::byte>> read(paths.size());
+    auto load = [&](size_t i) -> lov::System::Task { read[i] = co_await io.read(paths[i]); };
+
+    std::vector<lov::System::Task> tasks;
+    for (size_t i = 0; i < paths.size(); i++) {
+        tasks.push_back(load(i));
+    }
+
+    ASSERT_EQ(io.getSubmitCount(), 0);
+    io.flush();
+    ASSERT_EQ(io.getSubmitCount(), 1);
+
+    io.wait();
+    for (size_t i = 0; i < paths.size(); i++) {
+        ASSERT_TRUE(tasks[i].isDone());
+        ASSERT_TRUE(equals(read[i], std::string(100 + i, static_cast<char>('a' + i % 26))));
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "System/FrameClock.h"
+
+using namespace std::chrono_literals;
+
+/// @brief Fixture used for FrameClock tests
+class FrameClockFixture : public ::testing::Test {
+protected:
+    lov::System::FrameClock m_clock{ 10ms, 4 };    ///< The clock under test, stepping every 10ms up to 4 times a frame
+};
+
+/// @brief Test frames shorter and longer than a step run whole steps and carry the remainder
+TEST_F(FrameClockFixture, AccumulatesSteps) {
+    ASSERT_EQ(m_clock.advance(4ms), 0u);
+    ASSERT_FLOAT_EQ(m_clock.getAlpha(), 0.4f);
+
+    ASSERT_EQ(m_clock.advance(7ms), 1u);
+    ASSERT_FLOAT_EQ(m_clock.getAlpha(), 0.1f);
+
+    ASSERT_EQ(m_clock.advance(25ms), 2u);
+    ASSERT_FLOAT_EQ(m_clock.getAlpha(), 0.6f);
+    ASSERT_DOUBLE_EQ(m_clock.getDeltaTime(), 0.025);
+    ASSERT_FLOAT_EQ(m_clock.getStep(), 0.01f);
+    ASSERT_DOUBLE_EQ(m_clock.getTime(), 0.03);
+
+    lov::System::FrameClockStats stats = m_clock.getStats();
+    ASSERT_EQ(stats.frames, 3u);
+    ASSERT_EQ(stats.steps, 3u);
+    ASSERT_EQ(stats.frameSteps, 2u);
+    ASSERT_EQ(stats.droppedSteps, 0u);
+}
+
+/// @brief Test a frame that falls far behind runs at most the maximum steps and drops the rest
+TEST_F(FrameClockFixture, ClampsSlowFrames) {
+    ASSERT_EQ(m_clock.advance(1s + 3ms), 4u);
+    ASSERT_EQ(m_clock.getStats().droppedSteps, 96u);
+    ASSERT_FLOAT_EQ(m_clock.getAlpha(), 0.3f);
+
+    // The next frame is back to normal rather than catching up
+    ASSERT_EQ(m_clock.advance(10ms), 1u);
+    ASSERT_EQ(m_clock.getStats().steps, 5u);
+}
+
+/// @brief Test the time stays exact after a very long run, where a float of seconds couldn't resolve a step
+TEST_F(FrameClockFixture, StaysPreciseOverTime) {
+    for (int i = 0; i < 1000; i++) {
+        m_clock.advance(24h);
+    }
+
+    ASSERT_EQ(m_clock.advance(3ms), 0u);
+    ASSERT_FLOAT_EQ(m_clock.getAlpha(), 0.3f);
+    ASSERT_EQ(m_clock.advance(7ms), 1u);
+    ASSERT_FLOAT_EQ(m_clock.getAlpha(), 0.0f);
+}
+
+/// @brief Test sleeping until a deadline never returns before it
+TEST_F(FrameClockFixture, SleepsUntilDeadline) {
+    for (std::chrono::nanoseconds wait : { std::chrono::nanoseconds(0ns), std::chrono::nanoseconds(500us), std::chrono::nanoseconds(5ms) }) {
+        lov::System::FrameClock::Clock::time_point deadline = lov::System::FrameClock::Clock::now() + wait;
+        lov::System::FrameClock::sleepUntil(deadline);
+        ASSERT_GE(lov::System::FrameClock::Clock::now(), deadline);
+    }
+}
+
+/// @brief Test skipped time isn't simulated, and can't skip past the present
+TEST_F(FrameClockFixture, SkipsIdleTime) {
+    std::this_thread::sleep_for(30ms);
+    m_clock.skip(1h);
+    ASSERT_EQ(m_clock.tick(), 0u);
+    ASSERT_LT(m_clock.getDeltaTime(), 0.01);
+}
+
+/// @brief Test process CPU time grows while a thread is busy
+TEST_F(FrameClockFixture, MeasuresCpuTime) {
+    std::chrono::nanoseconds start = lov::System::FrameClock::getProcessCpuTime();
+
+    lov::System::FrameClock::Clock::time_point end = lov::System::FrameClock::Clock::now() + 50ms;
+    volatile uint64_t work = 0;
+    while (lov::System::FrameClock::Clock::now() < end) {
+        work = work + 1;
+    }
+
+    ASSERT_GT(lov::System::FrameClock::getProcessCpuTime() - start, 10ms);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "System/JobSystem.h"
+
+/// @brief Fixture used for JobSystem tests, with more workers than the machine may have cores to shake out races
+class JobSystemFixture : public ::testing::Test {
+protected:
+    lov::System::JobSystem m_jobs{ 3 };    ///< Runs the jobs
+};
+
+/// @brief Test that parallel loops cover every item exactly once, whatever the grain size
+TEST_F(JobSystemFixture, ParallelForCoversRange) {
+    ASSERT_EQ(m_jobs.getThreadCount(), 4);
+
+    for (lov::lov_size grainSize : { 0, 1, 7, 1000000 }) {
+        std::vector<std::atomic<int>> hits(100000);
+        m_jobs.parallelFor(static_cast<lov::lov_size>(hits.size()), [&](lov::lov_size begin, lov::lov_size end) {
+            ASSERT_LT(begin, end);
+            for (lov::lov_size i = begin; i < end; i++) {
+                hits[i]++;
+            }
+        }, grainSize);
+
+        for (size_t i = 0; i < hits.size(); i++) {
+            ASSERT_EQ(hits[i], 1) << "Item " << i << " with grain size " << grainSize;
+        }
+    }
+
+    int calls = 0;
+    m_jobs.parallelFor(0, [&](lov::lov_size, lov::lov_size) { calls++; });
+    m_jobs.parallelFor(1, [&](lov::lov_size begin, lov::lov_size end) { calls += end - begin; });
+    ASSERT_EQ(calls, 1);
+}
+
+/// @brief Test that a loop started with a counter keeps its body alive after the call returns, until its ranges have run
+TEST_F(JobSystemFixture, ParallelForOwnsBody) {
+    std::atomic<bool> released = false;
+    std::atomic<int> total = 0;
+    lov::System::JobCounter counter;
+
+    // The lambda, and the weights it holds, are temporaries gone by the time any range may start
+    {
+        std::vector<int> weights(1000, 2);
+        m_jobs.parallelFor(static_cast<lov::lov_size>(weights.size()), [&released, &total, weights](lov::lov_size begin, lov::lov_size end) {
+            while (!released) {
+                std::this_thread::yield();
+            }
+
+            for (lov::lov_size i = begin; i < end; i++) {
+                total += weights[i];
+            }
+        }, counter, 10);
+    }
+
+    released = true;
+    m_jobs.wait(counter);
+    ASSERT_EQ(total, 2000);
+}
+
+/// @brief Test that counters track their jobs and that dependent jobs run only after them
+TEST_F(JobSystemFixture, CountersAndDependencies) {
+    lov::System::JobCounter first;
+    lov::System::JobCounter second;
+    std::atomic<int> sum = 0;
+    int seen = -1;
+
+    for (int i = 0; i < 100; i++) {
+        m_jobs.run([&sum]() {
+            std::this_thread::yield();
+            sum++;
+        }, &first);
+    }
+
+    m_jobs.runAfter(first, [&]() { seen = sum; }, &second);
+    m_jobs.wait(second);
+    ASSERT_TRUE(first.isDone());
+    ASSERT_TRUE(second.isDone());
+    ASSERT_EQ(seen, 100);
+
+    // A dependency that's already done doesn't hold anything up
+    m_jobs.runAfter(first, [&]() { seen = 0; }, &second);
+    m_jobs.wait(second);
+    ASSERT_EQ(seen, 0);
+}
+
+/// @brief Test that jobs waiting on jobs of their own run them rather than deadlocking
+TEST_F(JobSystemFixture, NestedWaits) {
+    std::atomic<int> total = 0;
+    m_jobs.parallelFor(64, [&](lov::lov_size begin, lov::lov_size end) {
+        for (lov::lov_size i = begin; i < end; i++) {
+            m_jobs.parallelFor(100, [&](lov::lov_size innerBegin, lov::lov_size innerEnd) { total += innerEnd - innerBegin; }, 10);
+        }
+    }, 1);
+
+    ASSERT_EQ(total, 6400);
+}
+
+/// @brief Test that jobs queued from other threads run, and that waiting rethrows what a job threw once
+TEST_F(JobSystemFixture, ForeignThreadsAndExceptions) {
+    lov::System::JobCounter counter;
+    std::atomic<int> ran = 0;
+
+    std::thread foreign([&]() {
+        for (int i = 0; i < 50; i++) {
+            m_jobs.run([&ran]() { ran++; }, &counter);
+        }
+
+        m_jobs.run([]() { throw std::runtime_error("Job failed"); }, &counter);
+    });
+
+    foreign.join();
+    ASSERT_THROW(m_jobs.wait(counter), std::runtime_error);
+    ASSERT_EQ(ran, 50);
+    ASSERT_NO_THROW(m_jobs.wait(counter));
+
+    ASSERT_THROW(m_jobs.parallelFor(10, [](lov::lov_size begin, lov::lov_size) {
+        if (begin == 0) {
+            throw std::runtime_error("Range failed");
+        }
+    }, 1), std::runtime_error);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "System/LinearAllocator.h"
+
+/// @brief Fixture used for LinearAllocator tests
+class LinearAllocatorFixture : public ::testing::Test {
+protected:
+    lov::System::LinearAllocator m_allocator{ 1024 };   ///< Allocator with small blocks, to fill them quickly
+};
+
+/// @brief Test that allocations are aligned, don't overlap, and spill into new blocks
+TEST_F(LinearAllocatorFixture, AllocatesAlignedWithoutOverlap) {
+    char* previous = nullptr;
+    for (int i = 0; i < 100; i++) {
+        char* memory = static_cast<char*>(m_allocator.allocate(24, 16));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(memory) % 16, 0u);
+
+        // Write it all, so overlaps show up as corrupted values below
+        for (int j = 0; j < 24; j++) {
+            memory[j] = static_cast<char>(i);
+        }
+
+        if (previous) {
+            ASSERT_EQ(previous[23], static_cast<char>(i - 1));
+        }
+
+        previous = memory;
+    }
+
+    ASSERT_GE(m_allocator.getUsed(), 2400u);
+    ASSERT_GT(m_allocator.getCapacity(), 1024u);
+
+    // Allocations bigger than a block get one of their own
+    void* large = m_allocator.allocate(4096, 64);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(large) % 64, 0u);
+    ASSERT_GE(m_allocator.getCapacity(), 4096u);
+}
+
+/// @brief Test that resetting reuses the same blocks instead of growing
+TEST_F(LinearAllocatorFixture, ResetReusesBlocks) {
+    void* first = m_allocator.allocate(100);
+    for (int i = 0; i < 50; i++) {
+        m_allocator.allocate(100);
+    }
+
+    size_t capacity = m_allocator.getCapacity();
+    m_allocator.reset();
+    ASSERT_EQ(m_allocator.getUsed(), 0u);
+    ASSERT_EQ(m_allocator.allocate(100), first);
+
+    for (int i = 0; i < 50; i++) {
+        m_allocator.allocate(100);
+    }
+
+    ASSERT_EQ(m_allocator.getCapacity(), capacity);
+
+    int* value = m_allocator.create<int>(42);
+    ASSERT_EQ(*value, 42);
+}
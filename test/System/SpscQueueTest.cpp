@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "System/SpscQueue.h"
+
+/// @brief Fixture used for SpscQueue tests
+class SpscQueueFixture : public ::testing::Test {
+};
+
+/// @brief Test items come out in the order they went in, and pushing to a full queue fails
+TEST_F(SpscQueueFixture, PopsInOrder) {
+    lov::System::SpscQueue<int> queue(3);
+    ASSERT_EQ(queue.getCapacity(), 4u);
+
+    int item;
+    ASSERT_FALSE(queue.pop(item));
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    ASSERT_FALSE(queue.push(4));
+
+    // Wrap around the ring a few times
+    for (int i = 0; i < 20; i++) {
+        ASSERT_TRUE(queue.pop(item));
+        ASSERT_EQ(item, i);
+        ASSERT_TRUE(queue.push(i + 4));
+    }
+}
+
+/// @brief Test a producer and consumer thread pass every item across without losing or reordering any
+TEST_F(SpscQueueFixture, PassesBetweenThreads) {
+    const uint64_t count = 200000;
+    lov::System::SpscQueue<uint64_t> queue(64);
+
+    std::thread producer([&queue, count]() {
+        for (uint64_t i = 0; i < count; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < count) {
+        uint64_t item;
+        if (queue.pop(item)) {
+            ASSERT_EQ(item, expected);
+            expected++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "System/ThreadPool.h"
+
+using namespace std::chrono_literals;
+
+/// @brief Fixture used for ThreadPool tests
+class ThreadPoolFixture : public ::testing::Test {
+protected:
+    lov::System::ThreadPool m_pool{ 2 };    ///< The pool under test, with two workers
+};
+
+/// @brief Test that parallelFor covers every item exactly once
+TEST_F(ThreadPoolFixture, ParallelForCoversEveryItem) {
+    std::atomic<lov::lov_int> visits[100] = {};
+    m_pool.parallelFor(100, [&visits](lov::lov_size begin, lov::lov_size end) {
+        for (lov::lov_size i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    for (const std::atomic<lov::lov_int>& visit : visits) {
+        ASSERT_EQ(visit.load(), 1);
+    }
+}
+
+/// @brief Test that when the calling thread's range throws, parallelFor still waits for the workers' ranges
+TEST_F(ThreadPoolFixture, ParallelForWaitsBeforeRethrowing) {
+    std::atomic<lov::lov_int> finished = 0;
+    ASSERT_THROW(m_pool.parallelFor(3, [&finished](lov::lov_size begin, lov::lov_size) {
+        if (begin == 0) {
+            throw std::runtime_error("First range failed");
+        }
+
+        std::this_thread::sleep_for(20ms);
+        finished++;
+    }), std::runtime_error);
+
+    ASSERT_EQ(finished.load(), 2);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "System/WorkStealingDeque.h"
+
+/// @brief Fixture used for WorkStealingDeque tests, with items to point at
+class WorkStealingDequeFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_items.resize(100000);
+        for (size_t i = 0; i < m_items.size(); i++) {
+            m_items[i] = static_cast<int>(i);
+        }
+    }
+
+    std::vector<int> m_items;   ///< Items whose addresses are pushed
+};
+
+/// @brief Test that the owner pops newest first, thieves steal oldest first, and the ring grows past its capacity
+TEST_F(WorkStealingDequeFixture, PopsNewestAndStealsOldest) {
+    lov::System::WorkStealingDeque<int*> deque(4);
+    ASSERT_TRUE(deque.isEmpty());
+    ASSERT_EQ(deque.pop(), nullptr);
+    ASSERT_EQ(deque.steal(), nullptr);
+
+    for (int i = 0; i < 100; i++) {
+        deque.push(&m_items[i]);
+    }
+
+    ASSERT_EQ(deque.steal(), &m_items[0]);
+    ASSERT_EQ(deque.steal(), &m_items[1]);
+    ASSERT_EQ(deque.pop(), &m_items[99]);
+
+    for (int i = 98; i >= 2; i--) {
+        ASSERT_EQ(deque.pop(), &m_items[i]);
+    }
+
+    ASSERT_EQ(deque.pop(), nullptr);
+    ASSERT_TRUE(deque.isEmpty());
+}
+
+/// @brief Test that every item is taken exactly once while thieves race the owner
+TEST_F(WorkStealingDequeFixture, TakesEachItemOnce) {
+    lov::System::WorkStealingDeque<int*> deque(16);
+    std::vector<std::atomic<int>> taken(m_items.size());
+    std::atomic<bool> pushing = true;
+
+    auto thief = [&]() {
+        while (pushing || !deque.isEmpty()) {
+            if (int* item = deque.steal()) {
+                taken[*item]++;
+            }
+        }
+    };
+
+    std::thread first(thief);
+    std::thread second(thief);
+
+    for (size_t i = 0; i < m_items.size(); i++) {
+        deque.push(&m_items[i]);
+        if (i % 3 == 0) {
+            if (int* item = deque.pop()) {
+                taken[*item]++;
+            }
+        }
+    }
+
+    while (int* item = deque.pop()) {
+        taken[*item]++;
+    }
+
+    pushing = false;
+    first.join();
+    second.join();
+
+    for (size_t i = 0; i < taken.size(); i++) {
+        ASSERT_EQ(taken[i], 1) << "Item " << i;
+    }
+}
@@ -0,0 +1,79 @@
+#include "System/AssetPack.h"
+#include "System/Exceptions.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief Print how to use the packer
+    void printUsage() {
+        std::cout << "Usage: AssetPacker [options] <resource directory> <output.pack>\n"
+            "Every file under the directory is packed under its path relative to it, such as Shaders/basic.vs\n"
+            "Options:\n"
+            "  --exclude <extension>  Skip files with this extension, such as .psd. May be repeated\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> excluded;
+    std::vector<std::string> paths;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--exclude" && i + 1 < argc) {
+            excluded.push_back(argv[++i]);
+        }
+        else if (argument == "--help" || argument == "-h") {
+            printUsage();
+            return 0;
+        }
+        else {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.size() != 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::filesystem::path root = paths[0];
+    if (!std::filesystem::is_directory(root)) {
+        std::cerr << paths[0] << " is not a directory" << std::endl;
+        return 1;
+    }
+
+    // Sort the files so the same directory always produces the same pack
+    std::vector<std::filesystem::path> files;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(root)) {
+        std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && std::find(excluded.begin(), excluded.end(), extension) == excluded.end()) {
+            files.push_back(entry.path());
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+
+    lov::System::AssetPackWriter writer;
+    size_t bytes = 0;
+    try {
+        for (const std::filesystem::path& file : files) {
+            // Names use forward slashes on every platform
+            writer.addFile(std::filesystem::relative(file, root).generic_string(), file.string());
+            bytes += std::filesystem::file_size(file);
+        }
+
+        writer.writeFile(paths[1]);
+    }
+    catch (const lov::Exceptions::AssetException& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << paths[0] << " -> " << paths[1] << ": " << writer.getAssetCount() << " assets, " << bytes / 1024 << " KB" << std::endl;
+    return 0;
+}
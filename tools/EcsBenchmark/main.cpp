@@ -0,0 +1,170 @@
+#include "ECS/Components.h"
+#include "ECS/EntityCommandBuffer.h"
+#include "ECS/Systems.h"
+#include "ECS/World.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/Transform.h"
+#include "System/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// @brief A component only some entities have, so queries span several archetypes
+    struct Spin {
+        float speed;    ///< Radians per second
+    };
+
+    /// @brief Print how to use the benchmark
+    void printUsage() {
+        std::cout << "Usage: EcsBenchmark [options]\n"
+            "Times creating entities, reading one component of each, and running the transform and culling systems over\n"
+            "them, on 1 thread up to every hardware thread\n"
+            "Options:\n"
+            "  --entities <count>  Entities to create, 1000000 by default\n"
+            "  --frames <count>    Frames timed per thread count, 20 by default\n"
+            "  --threads <count>   Most threads to try, the number of hardware threads by default\n";
+    }
+
+    /// @brief Time a function, keeping the best of several runs
+    /// @param frames Runs to time
+    /// @param function The function
+    /// @return The best time in milliseconds
+    template <typename Function>
+    double timeBest(lov::lov_size frames, Function&& function) {
+        double best = 0.0;
+        for (lov::lov_size frame = 0; frame < frames; frame++) {
+            auto start = std::chrono::steady_clock::now();
+            function(frame);
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            best = frame == 0 ? milliseconds : std::min(best, milliseconds);
+        }
+
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    lov::lov_size entityCount = 1000000;
+    lov::lov_size frameCount = 20;
+    lov::lov_size maxThreads = std::max(static_cast<lov::lov_size>(std::thread::hardware_concurrency()), 1);
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--entities" && i + 1 < argc) {
+            entityCount = std::max(std::stoi(argv[++i]), 1);
+        }
+        else if (argument == "--frames" && i + 1 < argc) {
+            frameCount = std::max(std::stoi(argv[++i]), 1);
+        }
+        else if (argument == "--threads" && i + 1 < argc) {
+            maxThreads = std::max(std::stoi(argv[++i]), 1);
+        }
+        else {
+            printUsage();
+            return argument == "--help" || argument == "-h" ? 0 : -1;
+        }
+    }
+
+    // Scatter entities through a cube around a camera that sees about a quarter of them, giving every fourth a spin
+    lov::ECS::World world;
+    const lov::Graphics::BoundingBox unitBox({ -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f });
+
+    auto start = std::chrono::steady_clock::now();
+    for (lov::lov_size i = 0; i < entityCount; i++) {
+        float t = static_cast<float>(i);
+        lov::ECS::LocalTransform local;
+        local.value.position = lov::Vector3f(std::fmod(t * 0.618f, 200.0f) - 100.0f, std::fmod(t * 0.414f, 200.0f) - 100.0f, std::fmod(t * 0.732f, 200.0f) - 100.0f);
+        local.value.scale = lov::Vector3f(0.5f, 0.5f, 0.5f);
+
+        lov::ECS::Entity entity = world.create(local, lov::ECS::WorldTransform{}, lov::ECS::RenderBounds{ unitBox }, lov::ECS::Visible{ false });
+        if (i % 4 == 0) {
+            world.add(entity, Spin{ 0.5f + std::fmod(t * 0.1f, 1.0f) });
+        }
+    }
+    double createMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Destroying through a command buffer, then creating again, reuses the freed indices and rows
+    lov::ECS::EntityCommandBuffer commands;
+    start = std::chrono::steady_clock::now();
+    world.query<Spin>().forEach<Spin>([&commands](lov::ECS::Entity entity, Spin& spin) {
+        commands.destroy(entity);
+        lov::ECS::Entity replacement = commands.create();
+        commands.add(replacement, lov::ECS::LocalTransform{});
+        commands.add(replacement, spin);
+    });
+    commands.apply(world);
+    double churnMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Created " << entityCount << " entities in " << std::fixed << std::setprecision(2) << createMilliseconds
+        << " ms, replaced " << world.query<Spin>().getEntityCount() << " through a command buffer in " << churnMilliseconds << " ms\n";
+    std::cout << world.getArchetypeCount() << " archetypes, " << lov::ECS::Archetype::ChunkSize / 1024 << "KB chunks\n\n";
+
+    lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(1.57f, 16.0f / 9.0f, 0.1f, 150.0f);
+    lov::Graphics::Transform view = lov::Graphics::Transform::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f });
+    lov::Graphics::Frustum frustum(projection * view);
+
+    lov::ECS::Query& locals = world.query<lov::ECS::LocalTransform>();
+    lov::ECS::Query& visible = world.query<lov::ECS::Visible>();
+
+    std::cout << "Iterating " << locals.getEntityCount() << " entities, best of " << frameCount << " frames\n";
+    std::cout << "threads  read ms  ns/entity  systems ms  speedup  visible\n";
+
+    double singleThreaded = 0.0;
+    for (lov::lov_size threads = 1; threads <= maxThreads; threads++) {
+        // The main thread takes part, so it's one fewer worker than threads. One thread runs the systems directly
+        std::optional<lov::System::JobSystem> jobs;
+        if (threads > 1) {
+            jobs.emplace(threads - 1);
+        }
+        lov::System::JobSystem* pool = jobs ? &*jobs : nullptr;
+
+        // Read one component of every entity, summing per chunk so threads don't share a counter per entity
+        std::atomic<double> sum = 0.0;
+        auto readChunk = [&sum](const lov::ECS::ChunkView& chunk) {
+            double chunkSum = 0.0;
+            for (const lov::ECS::LocalTransform& local : chunk.get<lov::ECS::LocalTransform>()) {
+                chunkSum += local.value.position.x;
+            }
+            sum += chunkSum;
+        };
+
+        double read = timeBest(frameCount, [&](lov::lov_size) {
+            if (pool) {
+                locals.parallelForEachChunk(*pool, readChunk);
+            }
+            else {
+                locals.forEachChunk(readChunk);
+            }
+        });
+
+        double systems = timeBest(frameCount, [&](lov::lov_size) {
+            lov::ECS::updateTransforms(world, pool);
+            lov::ECS::cullEntities(world, frustum, pool);
+        });
+
+        if (threads == 1) {
+            singleThreaded = systems;
+        }
+
+        lov::lov_uint visibleCount = 0;
+        visible.forEach<lov::ECS::Visible>([&visibleCount](lov::ECS::Entity, const lov::ECS::Visible& entityVisible) {
+            visibleCount += entityVisible.value;
+        });
+
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2) << std::setw(9) << read
+            << std::setw(11) << read * 1e6 / locals.getEntityCount() << std::setw(12) << systems
+            << std::setw(8) << singleThreaded / systems << "x" << std::setw(9) << visibleCount << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "Graphics/BoundingBox.h"
+#include "Graphics/CommandBuffer.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/Transform.h"
+#include "System/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// @brief An object moved and culled each frame
+    struct Object {
+        lov::Vector3f position;             ///< Where it orbits around
+        float spin;                         ///< How fast it turns
+        lov::Graphics::Transform model;     ///< Its model transform this frame
+        bool visible;                       ///< Was it in the frustum this frame?
+    };
+
+    /// @brief The uniform block recorded with each draw
+    struct ObjectBlock {
+        lov::Graphics::Transform model;     ///< The object's model transform
+        lov::Vector4f tint;                 ///< A colour to multiply it by
+    };
+
+    /// @brief Print how to use the benchmark
+    void printUsage() {
+        std::cout << "Usage: JobBenchmark [options]\n"
+            "Times a frame of transform updates and frustum culling, then of recording draws into command buffers, on 1\n"
+            "thread up to every hardware thread\n"
+            "Options:\n"
+            "  --objects <count>  Objects per frame, 1000000 by default\n"
+            "  --draws <count>    Draws recorded per frame, 50000 by default\n"
+            "  --frames <count>   Frames timed per thread count, 20 by default\n"
+            "  --threads <count>  Most threads to try, the number of hardware threads by default\n";
+    }
+
+    /// @brief Move and cull a range of objects
+    /// @param objects The objects
+    /// @param begin The first object
+    /// @param end One past the last object
+    /// @param time The frame's time in seconds
+    /// @param frustum The camera's frustum
+    /// @return The number visible
+    lov::lov_size update(std::vector<Object>& objects, lov::lov_size begin, lov::lov_size end, float time, const lov::Graphics::Frustum& frustum) {
+        const lov::Graphics::BoundingBox unitBox({ -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f });
+        lov::lov_size visible = 0;
+
+        for (lov::lov_size i = begin; i < end; i++) {
+            Object& object = objects[i];
+            object.model = lov::Graphics::Transform().translate(object.position).rotate(0.0f, 1.0f, 0.0f, time * object.spin).scale(0.5f, 0.5f, 0.5f);
+            object.visible = frustum.intersects(unitBox.transformed(object.model));
+            visible += object.visible;
+        }
+
+        return visible;
+    }
+
+    /// @brief Record a range of objects' draws, as a renderer preparing them for the render thread would
+    /// @param objects The objects
+    /// @param begin The first object
+    /// @param end One past the last object
+    /// @param buffer The calling thread's buffer
+    void record(const std::vector<Object>& objects, lov::lov_size begin, lov::lov_size end, lov::Graphics::CommandBuffer& buffer) {
+        for (lov::lov_size i = begin; i < end; i++) {
+            const Object& object = objects[i];
+            lov::lov_uint program = 1 + i % 2;
+            lov::lov_uint vertexArray = 1 + i % 4;
+
+            // Sort by program, then vertex array, then front to back
+            float depth = std::min(lov::Vector::length(object.position), 65535.0f);
+            buffer.begin(static_cast<uint64_t>(program) << 48 | static_cast<uint64_t>(vertexArray) << 32 | static_cast<uint32_t>(depth * 65536.0f));
+            buffer.bindProgram(program);
+            buffer.bindVertexArray(vertexArray);
+            buffer.setUniformBlock(0, ObjectBlock{ object.model, lov::Vector4f(1.0f, 1.0f, 1.0f, 1.0f) });
+            buffer.drawElements(36);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    lov::lov_size objectCount = 1000000;
+    lov::lov_size drawCount = 50000;
+    lov::lov_size frameCount = 20;
+    lov::lov_size maxThreads = std::max(static_cast<lov::lov_size>(std::thread::hardware_concurrency()), 1);
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--objects" && i + 1 < argc) {
+            objectCount = std::max(std::stoi(argv[++i]), 1);
+        }
+        else if (argument == "--draws" && i + 1 < argc) {
+            drawCount = std::max(std::stoi(argv[++i]), 1);
+        }
+        else if (argument == "--frames" && i + 1 < argc) {
+            frameCount = std::max(std::stoi(argv[++i]), 1);
+        }
+        else if (argument == "--threads" && i + 1 < argc) {
+            maxThreads = std::max(std::stoi(argv[++i]), 1);
+        }
+        else {
+            printUsage();
+            return argument == "--help" || argument == "-h" ? 0 : -1;
+        }
+    }
+
+    // Scatter objects through a cube around a camera that sees about a quarter of them
+    std::vector<Object> objects(objectCount);
+    for (lov::lov_size i = 0; i < objectCount; i++) {
+        float t = static_cast<float>(i);
+        objects[i].position = lov::Vector3f(std::fmod(t * 0.618f, 200.0f) - 100.0f, std::fmod(t * 0.414f, 200.0f) - 100.0f, std::fmod(t * 0.732f, 200.0f) - 100.0f);
+        objects[i].spin = 0.5f + std::fmod(t * 0.1f, 1.0f);
+    }
+
+    lov::Graphics::Transform projection = lov::Graphics::Transform::perspective(1.57f, 16.0f / 9.0f, 0.1f, 150.0f);
+    lov::Graphics::Transform view = lov::Graphics::Transform::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f });
+    lov::Graphics::Frustum frustum(projection * view);
+
+    std::cout << "Updating and culling " << objectCount << " objects, best of " << frameCount << " frames\n";
+    std::cout << "threads      ms  speedup  visible\n";
+
+    double singleThreaded = 0.0;
+    for (lov::lov_size threads = 1; threads <= maxThreads; threads++) {
+        // The main thread takes part, so it's one fewer worker than threads. One thread runs the loop directly as the baseline
+        std::optional<lov::System::JobSystem> jobs;
+        if (threads > 1) {
+            jobs.emplace(threads - 1);
+        }
+
+        double best = 0.0;
+        lov::lov_size visible = 0;
+        for (lov::lov_size frame = 0; frame < frameCount; frame++) {
+            std::atomic<lov::lov_size> frameVisible = 0;
+            auto start = std::chrono::steady_clock::now();
+
+            if (!jobs) {
+                frameVisible = update(objects, 0, objectCount, static_cast<float>(frame), frustum);
+            }
+            else {
+                jobs->parallelFor(objectCount, [&](lov::lov_size begin, lov::lov_size end) {
+                    frameVisible += update(objects, begin, end, static_cast<float>(frame), frustum);
+                });
+            }
+
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            best = frame == 0 ? milliseconds : std::min(best, milliseconds);
+            visible = frameVisible;
+        }
+
+        if (threads == 1) {
+            singleThreaded = best;
+        }
+
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2) << std::setw(8) << best
+            << std::setw(8) << singleThreaded / best << "x" << std::setw(9) << visible << "\n";
+    }
+
+    // Record draws of the objects just updated into a command buffer per thread, sorting each on its thread, then
+    // merge them as the render thread would before replaying
+    drawCount = std::min(drawCount, objectCount);
+    std::cout << "\nRecording " << drawCount << " draws into per thread command buffers, best of " << frameCount << " frames\n";
+    std::cout << "threads      ms  speedup  merge ms\n";
+
+    for (lov::lov_size threads = 1; threads <= maxThreads; threads++) {
+        std::optional<lov::System::JobSystem> jobs;
+        if (threads > 1) {
+            jobs.emplace(threads - 1);
+        }
+
+        std::vector<lov::Graphics::CommandBuffer> buffers(threads);
+        std::vector<const lov::Graphics::RenderCommandGroup*> groups;
+
+        double best = 0.0;
+        double bestMerge = 0.0;
+        for (lov::lov_size frame = 0; frame < frameCount; frame++) {
+            for (lov::Graphics::CommandBuffer& buffer : buffers) {
+                buffer.clear();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+
+            if (!jobs) {
+                record(objects, 0, drawCount, buffers[0]);
+                buffers[0].sort();
+            }
+            else {
+                jobs->parallelFor(drawCount, [&](lov::lov_size begin, lov::lov_size end) {
+                    record(objects, begin, end, buffers[jobs->getThreadIndex()]);
+                });
+
+                jobs->parallelFor(threads, [&](lov::lov_size begin, lov::lov_size end) {
+                    for (lov::lov_size i = begin; i < end; i++) {
+                        buffers[i].sort();
+                    }
+                }, 1);
+            }
+
+            auto recorded = std::chrono::steady_clock::now();
+            lov::Graphics::CommandBuffer::merge(buffers, groups);
+
+            double milliseconds = std::chrono::duration<double, std::milli>(recorded - start).count();
+            double mergeMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recorded).count();
+            best = frame == 0 ? milliseconds : std::min(best, milliseconds);
+            bestMerge = frame == 0 ? mergeMilliseconds : std::min(bestMerge, mergeMilliseconds);
+        }
+
+        if (threads == 1) {
+            singleThreaded = best;
+        }
+
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2) << std::setw(8) << best
+            << std::setw(8) << singleThreaded / best << "x" << std::setw(10) << bestMerge << "\n";
+    }
+
+    return 0;
+}
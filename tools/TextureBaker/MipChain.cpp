@@ -0,0 +1,138 @@
+#include "MipChain.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /// @brief Decode an sRGB value
+    /// @param value The encoded value from 0 to 1
+    /// @return The linear value
+    float toLinear(float value) {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    /// @brief Encode a linear value as sRGB
+    /// @param value The linear value from 0 to 1
+    /// @return The encoded value
+    float toSRGB(float value) {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    /// @brief Quantize a value from 0 to 1
+    /// @param value The value
+    /// @return The value from 0 to 255
+    unsigned char toByte(float value) {
+        return static_cast<unsigned char>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    /// @brief Shrink one axis of an image by half with an area filter
+    /// @param source The RGBA pixels of the image
+    /// @param sourceSize The size of the axis being shrunk
+    /// @param otherSize The size of the other axis
+    /// @param stride Distance in floats between neighbours along the shrinking axis
+    /// @param otherStride Distance in floats between neighbours along the other axis
+    /// @param destination The shrunk pixels, laid out like the source
+    /// @param destinationStride Distance in floats between neighbours along the shrunk axis of the destination
+    /// @param destinationOtherStride Distance in floats between neighbours along the other axis of the destination
+    void shrink(const std::vector<float>& source, lov::lov_int sourceSize, lov::lov_int otherSize, size_t stride, size_t otherStride,
+                std::vector<float>& destination, size_t destinationStride, size_t destinationOtherStride) {
+        lov::lov_int size = std::max(sourceSize / 2, 1);
+        float ratio = static_cast<float>(sourceSize) / size;
+
+        for (lov::lov_int other = 0; other < otherSize; other++) {
+            for (lov::lov_int i = 0; i < size; i++) {
+                // Weight every source texel by how much of it the destination texel covers
+                float begin = i * ratio;
+                float end = begin + ratio;
+                float sum[4] = {};
+                for (lov::lov_int s = static_cast<lov::lov_int>(begin); s < sourceSize && s < end; s++) {
+                    float weight = std::min(end, s + 1.0f) - std::max(begin, static_cast<float>(s));
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += source[s * stride + other * otherStride + c] * weight;
+                    }
+                }
+
+                for (int c = 0; c < 4; c++) {
+                    destination[i * destinationStride + other * destinationOtherStride + c] = sum[c] / ratio;
+                }
+            }
+        }
+    }
+
+    /// @brief Convert a filtered level back to RGBA8
+    /// @param values The filtered pixels
+    /// @param width The width of the level
+    /// @param height The height of the level
+    /// @param options How the pixels were filtered
+    /// @return The level
+    lov::Tools::MipLevel toLevel(const std::vector<float>& values, lov::lov_int width, lov::lov_int height, const lov::Tools::MipOptions& options) {
+        lov::Tools::MipLevel level = { width, height, std::vector<unsigned char>(static_cast<size_t>(width) * height * 4) };
+
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+            const float* pixel = &values[i * 4];
+            unsigned char* out = &level.pixels[i * 4];
+
+            if (options.normalMap) {
+                float length = std::sqrt(pixel[0] * pixel[0] + pixel[1] * pixel[1] + pixel[2] * pixel[2]);
+                for (int c = 0; c < 3; c++) {
+                    out[c] = toByte(length > 0.0f ? pixel[c] / length * 0.5f + 0.5f : 0.5f);
+                }
+            }
+            else {
+                for (int c = 0; c < 3; c++) {
+                    float value = pixel[3] > 0.0f ? pixel[c] / pixel[3] : 0.0f;
+                    out[c] = toByte(options.srgb ? toSRGB(value) : value);
+                }
+            }
+
+            out[3] = toByte(pixel[3]);
+        }
+
+        return level;
+    }
+}
+
+std::vector<lov::Tools::MipLevel> lov::Tools::MipChain::build(const unsigned char* pixels, lov_int width, lov_int height, const MipOptions& options) {
+    std::vector<MipLevel> levels;
+    levels.push_back({ width, height, std::vector<unsigned char>(pixels, pixels + static_cast<size_t>(width) * height * 4) });
+
+    if (!options.mipmaps) {
+        return levels;
+    }
+
+    // Convert to the space the filter should average in
+    std::vector<float> values(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+        float alpha = pixels[i * 4 + 3] / 255.0f;
+        for (int c = 0; c < 3; c++) {
+            float value = pixels[i * 4 + c] / 255.0f;
+            if (options.normalMap) {
+                values[i * 4 + c] = value * 2.0f - 1.0f;
+            }
+            else {
+                values[i * 4 + c] = (options.srgb ? toLinear(value) : value) * alpha;
+            }
+        }
+
+        values[i * 4 + 3] = alpha;
+    }
+
+    // Shrink horizontally then vertically, keeping each level in floats for the next
+    while (width > 1 || height > 1) {
+        lov_int nextWidth = std::max(width / 2, 1);
+        lov_int nextHeight = std::max(height / 2, 1);
+
+        std::vector<float> columns(static_cast<size_t>(nextWidth) * height * 4);
+        shrink(values, width, height, 4, static_cast<size_t>(width) * 4, columns, 4, static_cast<size_t>(nextWidth) * 4);
+
+        std::vector<float> rows(static_cast<size_t>(nextWidth) * nextHeight * 4);
+        shrink(columns, height, nextWidth, static_cast<size_t>(nextWidth) * 4, 4, rows, static_cast<size_t>(nextWidth) * 4, 4);
+
+        width = nextWidth;
+        height = nextHeight;
+        values.swap(rows);
+        levels.push_back(toLevel(values, width, height, options));
+    }
+
+    return levels;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "System/Types.h"
+
+/// @file MipChain.h
+/// @brief Declares the offline mip chain filter used by the TextureBaker
+
+namespace lov {
+    namespace Tools {
+        /// @brief One level of a mip chain
+        struct MipLevel {
+            lov_int width;                      ///< Width in pixels
+            lov_int height;                     ///< Height in pixels
+            std::vector<unsigned char> pixels;  ///< RGBA8 pixels in rows
+        };
+
+        /// @brief How the pixels of an image should be filtered
+        struct MipOptions {
+            bool srgb;      ///< Colour is sRGB encoded, so average it in linear light
+            bool normalMap; ///< RGB holds a tangent space normal, so renormalize each level instead of weighting by alpha
+            bool mipmaps;   ///< Build every level down to 1x1 rather than only level 0
+        };
+
+        /// @brief Builds mip chains in floating point so rounding errors don't accumulate down the chain
+        namespace MipChain {
+            /// @brief Build the mip chain of an image
+            ///
+            /// Each level is an area weighted average of the one above, which also handles odd sizes without dropping
+            /// texels. Colour is premultiplied by alpha while filtering so transparent texels don't bleed into their
+            /// neighbours
+            /// @param pixels The RGBA8 pixels of level 0
+            /// @param width The width of level 0
+            /// @param height The height of level 0
+            /// @param options How to filter the pixels
+            /// @return Every level, starting with an exact copy of level 0
+            std::vector<MipLevel> build(const unsigned char* pixels, lov_int width, lov_int height, const MipOptions& options);
+        }
+    }
+}
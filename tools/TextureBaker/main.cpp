@@ -0,0 +1,172 @@
+#include "MipChain.h"
+
+#include "Graphics/BlockEncoder.h"
+#include "Graphics/Ktx2Image.h"
+#include "System/Exceptions.h"
+#include "System/ThreadPool.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+    /// @brief Encodes one block of RGBA8 pixels
+    typedef void (*BlockFunction)(const unsigned char* pixels, unsigned char* out);
+
+    /// @brief A format that can be selected on the command line
+    struct FormatOption {
+        const char* name;                           ///< Name passed to --format
+        lov::Graphics::Ktx2Image::Format linear;    ///< Format written without --srgb
+        lov::Graphics::Ktx2Image::Format srgb;      ///< Format written with --srgb
+        BlockFunction encode;                       ///< Encoder of each block
+    };
+
+    /// @brief Every format the baker can write
+    const FormatOption FORMATS[] = {
+        { "bc1", lov::Graphics::Ktx2Image::BC1_RGB_UNORM, lov::Graphics::Ktx2Image::BC1_RGB_SRGB, lov::Graphics::BlockEncoder::encodeBC1 },
+        { "bc3", lov::Graphics::Ktx2Image::BC3_UNORM, lov::Graphics::Ktx2Image::BC3_SRGB, lov::Graphics::BlockEncoder::encodeBC3 },
+        { "bc5", lov::Graphics::Ktx2Image::BC5_UNORM, lov::Graphics::Ktx2Image::BC5_UNORM, lov::Graphics::BlockEncoder::encodeBC5 },
+        { "bc7", lov::Graphics::Ktx2Image::BC7_UNORM, lov::Graphics::Ktx2Image::BC7_SRGB, lov::Graphics::BlockEncoder::encodeBC7 },
+        { "etc2", lov::Graphics::Ktx2Image::ETC2_RGB_UNORM, lov::Graphics::Ktx2Image::ETC2_RGB_SRGB, lov::Graphics::BlockEncoder::encodeETC2 },
+        { "etc2a", lov::Graphics::Ktx2Image::ETC2_RGBA_UNORM, lov::Graphics::Ktx2Image::ETC2_RGBA_SRGB, lov::Graphics::BlockEncoder::encodeETC2Alpha }
+    };
+
+    /// @brief Print how to use the baker
+    void printUsage() {
+        std::cout << "Usage: TextureBaker [options] <input image> <output.ktx2>\n"
+            "Options:\n"
+            "  --format <bc1|bc3|bc5|bc7|etc2|etc2a>  Block compressed format. Default is bc7\n"
+            "  --srgb                                  Store colour as sRGB and filter mips in linear light\n"
+            "  --normal                                Treat RGB as a tangent space normal map and renormalize each mip\n"
+            "  --no-mips                               Only store the full size level\n"
+            "  --no-flip                               Keep rows in file order instead of flipping them for OpenGL\n"
+            "  --threads <count>                       Worker threads. Default is one less than the hardware threads\n";
+    }
+
+    /// @brief Compress one mip level block by block across the pool
+    /// @param level The level
+    /// @param format The format to encode
+    /// @param written The format recorded in the file, which decides the block size
+    /// @param pool The pool that encodes rows of blocks
+    /// @return The compressed blocks
+    std::vector<unsigned char> encodeLevel(const lov::Tools::MipLevel& level, const FormatOption& format, lov::Graphics::Ktx2Image::Format written, lov::System::ThreadPool& pool) {
+        lov::lov_int blocksWide = (level.width + 3) / 4;
+        lov::lov_int blocksHigh = (level.height + 3) / 4;
+        lov::lov_size blockSize = lov::Graphics::Ktx2Image::getBlockSize(written);
+        std::vector<unsigned char> blocks(lov::Graphics::Ktx2Image::getLevelSize(written, level.width, level.height));
+
+        pool.parallelFor(blocksHigh, [&](lov::lov_size begin, lov::lov_size end) {
+            unsigned char pixels[16 * 4];
+            for (lov::lov_int by = begin; by < end; by++) {
+                for (lov::lov_int bx = 0; bx < blocksWide; bx++) {
+                    // Gather the block, repeating the last row and column of levels that aren't a multiple of 4
+                    for (lov::lov_int y = 0; y < 4; y++) {
+                        for (lov::lov_int x = 0; x < 4; x++) {
+                            lov::lov_int sx = std::min(bx * 4 + x, level.width - 1);
+                            lov::lov_int sy = std::min(by * 4 + y, level.height - 1);
+                            memcpy(pixels + (y * 4 + x) * 4, &level.pixels[(static_cast<size_t>(sy) * level.width + sx) * 4], 4);
+                        }
+                    }
+
+                    format.encode(pixels, &blocks[(static_cast<size_t>(by) * blocksWide + bx) * blockSize]);
+                }
+            }
+        });
+
+        return blocks;
+    }
+}
+
+int main(int argc, char** argv) {
+    const FormatOption* format = &FORMATS[3];
+    lov::Tools::MipOptions options = { false, false, true };
+    bool flip = true;
+    lov::lov_size threads = 0;
+    std::vector<std::string> paths;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--format" && i + 1 < argc) {
+            std::string name = argv[++i];
+            auto match = std::find_if(std::begin(FORMATS), std::end(FORMATS), [&](const FormatOption& option) { return name == option.name; });
+            if (match == std::end(FORMATS)) {
+                std::cerr << "Unknown format " << name << std::endl;
+                return 1;
+            }
+
+            format = match;
+        }
+        else if (argument == "--srgb") {
+            options.srgb = true;
+        }
+        else if (argument == "--normal") {
+            options.normalMap = true;
+        }
+        else if (argument == "--no-mips") {
+            options.mipmaps = false;
+        }
+        else if (argument == "--no-flip") {
+            flip = false;
+        }
+        else if (argument == "--threads" && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (argument == "--help" || argument == "-h") {
+            printUsage();
+            return 0;
+        }
+        else {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.size() != 2) {
+        printUsage();
+        return 1;
+    }
+
+    if (options.srgb && format->srgb == format->linear) {
+        std::cerr << format->name << " has no sRGB variant" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Decode the source as RGBA, flipped into OpenGL's bottom first row order so the runtime never has to
+    stbi_set_flip_vertically_on_load(flip);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(paths[0].c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        std::cerr << "Failed to load " << paths[0] << ": " << stbi_failure_reason() << std::endl;
+        return 1;
+    }
+
+    std::vector<lov::Tools::MipLevel> levels = lov::Tools::MipChain::build(data, width, height, options);
+    stbi_image_free(data);
+
+    // Compress every level
+    lov::Graphics::Ktx2Image::Format written = options.srgb ? format->srgb : format->linear;
+    lov::Graphics::Ktx2Image image(written, width, height);
+    lov::System::ThreadPool pool(threads);
+    for (const lov::Tools::MipLevel& level : levels) {
+        image.addLevel(encodeLevel(level, *format, written, pool));
+    }
+
+    try {
+        image.writeFile(paths[1]);
+    }
+    catch (const lov::Exceptions::TextureException& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << paths[0] << " -> " << paths[1] << ": " << format->name << (options.srgb ? " sRGB " : " ") << width << "x" << height << ", "
+        << levels.size() << " levels, " << image.getByteSize() / 1024 << " KB in " << seconds << "s" << std::endl;
+    return 0;
+}